@@ -0,0 +1,72 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Commandlets/RESTBenchmarkCommandlet.h"
+#include "Utils/BenchmarkContent.h"
+#include "Engine/World.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/Parse.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+URESTBenchmarkCommandlet::URESTBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 URESTBenchmarkCommandlet::Main(const FString& Params)
+{
+	FBenchmarkContentOptions Options = FBenchmarkContentOptions::FromString(Params);
+	Options.bSave = true;
+
+	FString MapPackage = FString::Printf(TEXT("%s/Maps/L_Bench_%d"), *Options.RootPath, Options.Actors);
+	FParse::Value(*Params, TEXT("map="), MapPackage);
+
+	if (!FPackageName::IsValidLongPackageName(MapPackage))
+	{
+		UE_LOG(LogTemp, Error, TEXT("RESTBenchmarkCommandlet: Invalid map path: %s"), *MapPackage);
+		return 1;
+	}
+
+	// A fresh world every run, so the level only ever holds the generated actors
+	UPackage* Package = CreatePackage(*MapPackage);
+	Package->FullyLoad();
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, FName(*FPackageName::GetShortName(MapPackage)), Package);
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("RESTBenchmarkCommandlet: Failed to create world %s"), *MapPackage);
+		return 1;
+	}
+	World->SetFlags(RF_Public | RF_Standalone);
+	FAssetRegistryModule::AssetCreated(World);
+
+	FBenchmarkContentResult Result;
+	FString Error;
+	const bool bGenerated = FBenchmarkContent::Generate(World, Options, Result, Error);
+
+	if (bGenerated)
+	{
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Standalone;
+		const FString Filename = FPackageName::LongPackageNameToFilename(MapPackage, FPackageName::GetMapPackageExtension());
+		if (!UPackage::Save(Package, World, *Filename, SaveArgs))
+		{
+			Error = FString::Printf(TEXT("Failed to save %s"), *Filename);
+		}
+	}
+
+	World->DestroyWorld(false);
+
+	if (!Error.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("RESTBenchmarkCommandlet: %s"), *Error);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("RESTBenchmarkCommandlet: Wrote %s (%d actors, %d new assets) in %.2fs"),
+		*MapPackage, Result.ActorsSpawned, Result.AssetsCreated, Result.Seconds);
+	return 0;
+}
@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "RESTBenchmarkCommandlet.generated.h"
+
+/**
+ * Generates a saved benchmark map and asset set for the REST load tests.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd <Project>.uproject -run=RESTBenchmark -actors=10000
+ *     [-map=/Game/RESTBenchmark/Maps/L_Bench_10000] [-asset_folders=10]
+ *     [-assets_per_folder=100] [-material_nodes=500] [-blueprint_nodes=500]
+ *     [-seed=1] [-root=/Game/RESTBenchmark]
+ *
+ * The map is rebuilt from scratch on every run, so the same arguments give
+ * the same level. Open it in the editor and run scripts/benchmark_rest.py.
+ */
+UCLASS()
+class URESTBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	URESTBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
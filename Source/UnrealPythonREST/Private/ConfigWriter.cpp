@@ -6,6 +6,11 @@
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "HAL/PlatformProcess.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/FileManager.h"
+#include "Misc/App.h"
+#include "Misc/EngineVersion.h"
+#include "RESTMetrics.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
 
@@ -23,8 +28,12 @@ bool FConfigWriter::WriteConfig(const FRESTRouter& Router)
 
 	// Server connection info
 	Json->SetNumberField(TEXT("port"), Router.GetPort());
+	Json->SetNumberField(TEXT("requested_port"), Router.GetStartupInfo().RequestedPort);
+	Json->SetBoolField(TEXT("ready"), Router.IsReady());
 	Json->SetNumberField(TEXT("pid"), FPlatformProcess::GetCurrentProcessId());
 
+	Json->SetStringField(TEXT("instance_id"), GetInstanceId());
+
 	// Project info
 	Json->SetStringField(TEXT("project"), FApp::GetProjectName());
 	Json->SetStringField(TEXT("started_at"), FDateTime::UtcNow().ToIso8601());
@@ -57,6 +66,88 @@ bool FConfigWriter::WriteConfig(const FRESTRouter& Router)
 	return false;
 }
 
+FString FConfigWriter::GetRegistryDir()
+{
+	const FString Override = FPlatformMisc::GetEnvironmentVariable(TEXT("UNREALPYTHONREST_REGISTRY"));
+	if (!Override.IsEmpty())
+	{
+		return Override;
+	}
+	return FPaths::Combine(FPlatformProcess::UserSettingsDir(), TEXT("UnrealPythonREST"), TEXT("Instances"));
+}
+
+FString FConfigWriter::GetInstanceId()
+{
+	return FApp::GetInstanceId().ToString(EGuidFormats::DigitsWithHyphens).ToLower();
+}
+
+bool FConfigWriter::WriteRegistryEntry(const FRESTRouter& Router)
+{
+	// Written once at startup and then by the heartbeat, so started_at stays fixed
+	static const FString StartedAt = FDateTime::UtcNow().ToIso8601();
+
+	TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+	Json->SetNumberField(TEXT("version"), 1);
+	Json->SetStringField(TEXT("instance_id"), GetInstanceId());
+	Json->SetStringField(TEXT("host"), FPlatformProcess::ComputerName());
+	Json->SetNumberField(TEXT("port"), Router.GetPort());
+	Json->SetNumberField(TEXT("pid"), FPlatformProcess::GetCurrentProcessId());
+	Json->SetStringField(TEXT("project"), FApp::GetProjectName());
+	Json->SetStringField(TEXT("project_dir"), FPaths::ConvertRelativePathToFull(FPaths::ProjectDir()));
+	Json->SetStringField(TEXT("engine_version"), FEngineVersion::Current().ToString());
+	Json->SetBoolField(TEXT("ready"), Router.IsReady());
+	Json->SetStringField(TEXT("started_at"), StartedAt);
+	Json->SetStringField(TEXT("updated_at"), FDateTime::UtcNow().ToIso8601());
+
+	// What clients may route here: handler names, plus whether frames can be rendered
+	TSharedPtr<FJsonObject> Capabilities = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> HandlerArray;
+	for (const auto& Handler : Router.GetHandlers())
+	{
+		if (Handler.IsValid())
+		{
+			HandlerArray.Add(MakeShared<FJsonValueString>(Handler->GetHandlerName()));
+		}
+	}
+	Capabilities->SetArrayField(TEXT("handlers"), HandlerArray);
+	Capabilities->SetBoolField(TEXT("rendering"), FApp::CanEverRender());
+	Capabilities->SetBoolField(TEXT("unattended"), FApp::IsUnattended());
+	Json->SetObjectField(TEXT("capabilities"), Capabilities);
+
+	// Load at the last heartbeat; clients prefer the least loaded instance
+	const FRESTLatencyHistogram& FrameTime = Router.GetMetrics().GetFrameTime();
+	TSharedPtr<FJsonObject> Load = MakeShared<FJsonObject>();
+	Load->SetNumberField(TEXT("queued_requests"), Router.GetQueuedRequests());
+	Load->SetNumberField(TEXT("frame_ms_p50"), FrameTime.GetQuantile(0.5) * 1000.0);
+	Json->SetObjectField(TEXT("load"), Load);
+
+	FString JsonString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+	FJsonSerializer::Serialize(Json.ToSharedRef(), Writer);
+
+	// Write beside the entry and move it over, so readers never see a partial file
+	const FString EntryPath = FPaths::Combine(GetRegistryDir(), GetInstanceId() + TEXT(".json"));
+	const FString TempPath = EntryPath + TEXT(".tmp");
+	if (FFileHelper::SaveStringToFile(JsonString, *TempPath) && IFileManager::Get().Move(*EntryPath, *TempPath, true, true))
+	{
+		return true;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("ConfigWriter: Failed to write registry entry %s"), *EntryPath);
+	return false;
+}
+
+bool FConfigWriter::DeleteRegistryEntry()
+{
+	const FString EntryPath = FPaths::Combine(GetRegistryDir(), GetInstanceId() + TEXT(".json"));
+	if (FPaths::FileExists(EntryPath) && !IFileManager::Get().Delete(*EntryPath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ConfigWriter: Failed to delete registry entry %s"), *EntryPath);
+		return false;
+	}
+	return true;
+}
+
 bool FConfigWriter::DeleteConfig()
 {
 	FString ConfigPath = GetConfigPath();
@@ -14,6 +14,12 @@ class FRESTRouter;
  * - Project name
  * - List of registered handlers
  * - Server start time
+ *
+ * Every instance also registers in a registry shared by all editors of the
+ * current user on this machine, one {InstanceId}.json per process, so fleet
+ * clients can find and load-balance across several editors. Entries carry
+ * port, pid, project, capabilities and load, and are refreshed by a
+ * heartbeat; clients drop entries whose heartbeat has gone stale.
  */
 class FConfigWriter
 {
@@ -26,4 +32,16 @@ public:
 
 	/** Get config file path */
 	static FString GetConfigPath();
+
+	/** Write or refresh this instance's registry entry */
+	static bool WriteRegistryEntry(const FRESTRouter& Router);
+
+	/** Delete this instance's registry entry (called on shutdown) */
+	static bool DeleteRegistryEntry();
+
+	/** UNREALPYTHONREST_REGISTRY if set, else {UserSettingsDir}/UnrealPythonREST/Instances */
+	static FString GetRegistryDir();
+
+	/** This editor process's FApp instance ID, lowercase with hyphens */
+	static FString GetInstanceId();
 };
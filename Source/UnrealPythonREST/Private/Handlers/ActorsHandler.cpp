@@ -3,38 +3,148 @@
 #include "Handlers/ActorsHandler.h"
 #include "Utils/JsonHelpers.h"
 #include "Utils/ActorUtils.h"
+#include "Utils/EditorChangeTracker.h"
+#include "Utils/ActorSpatialIndex.h"
+#include "Utils/EditCoalescer.h"
+#include "Utils/EditorEventFeed.h"
+#include "RESTJsonWriter.h"
+#include "RESTListQuery.h"
 #include "Editor.h"
 #include "EngineUtils.h"
 #include "LevelEditorViewport.h"
 #include "EditorViewportClient.h"
 
+namespace
+{
+	/** Failures listed individually in bulk responses; the rest are only counted */
+	constexpr int32 MaxReportedFailures = 100;
+
+	/**
+	 * Read an optional flat number column: Stride values per row for Rows rows.
+	 * @return false (with OutError set) if present but not an array of Rows * Stride numbers
+	 */
+	bool ReadNumberColumn(const TSharedPtr<FJsonObject>& Json, const TCHAR* Field, int32 Rows, int32 Stride, TArray<double>& OutValues, FString& OutError)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Array = nullptr;
+		if (!Json->TryGetArrayField(Field, Array))
+		{
+			if (Json->HasField(Field))
+			{
+				OutError = FString::Printf(TEXT("%s must be an array of numbers"), Field);
+				return false;
+			}
+			return true;
+		}
+
+		if (Array->Num() != Rows * Stride)
+		{
+			OutError = FString::Printf(TEXT("%s has %d values; expected %d (%d per actor for %d actors)"), Field, Array->Num(), Rows * Stride, Stride, Rows);
+			return false;
+		}
+
+		OutValues.SetNumUninitialized(Array->Num());
+		for (int32 Index = 0; Index < Array->Num(); ++Index)
+		{
+			if (!(*Array)[Index].IsValid() || !(*Array)[Index]->TryGetNumber(OutValues[Index]))
+			{
+				OutError = FString::Printf(TEXT("%s[%d] is not a number"), Field, Index);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Read a string column; Rows < 0 accepts any length */
+	bool ReadStringColumn(const TSharedPtr<FJsonObject>& Json, const TCHAR* Field, int32 Rows, TArray<FString>& OutValues, FString& OutError)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Array = nullptr;
+		if (!Json->TryGetArrayField(Field, Array))
+		{
+			if (Json->HasField(Field))
+			{
+				OutError = FString::Printf(TEXT("%s must be an array of strings"), Field);
+				return false;
+			}
+			return true;
+		}
+
+		if (Rows >= 0 && Array->Num() != Rows)
+		{
+			OutError = FString::Printf(TEXT("%s has %d entries; expected %d"), Field, Array->Num(), Rows);
+			return false;
+		}
+
+		OutValues.Reserve(Array->Num());
+		for (int32 Index = 0; Index < Array->Num(); ++Index)
+		{
+			FString& Value = OutValues.AddDefaulted_GetRef();
+			if (!(*Array)[Index].IsValid() || !(*Array)[Index]->TryGetString(Value))
+			{
+				OutError = FString::Printf(TEXT("%s[%d] is not a string"), Field, Index);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	FVector ColumnVector(const TArray<double>& Column, int32 Row)
+	{
+		return FVector(Column[Row * 3], Column[Row * 3 + 1], Column[Row * 3 + 2]);
+	}
+
+	FRotator ColumnRotator(const TArray<double>& Column, int32 Row)
+	{
+		return FRotator(Column[Row * 3], Column[Row * 3 + 1], Column[Row * 3 + 2]);
+	}
+}
+
 void FActorsHandler::RegisterRoutes(FRESTRouter& Router)
 {
+	// Recorded after every mutation so /actors/list and /actors/details revalidate
+	constexpr EEditorChange ActorEdits = EEditorChange::World | EEditorChange::Objects;
+
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/actors/list"),
-		FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleList));
+		FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleList),
+		FRESTRouteOptions::Versioned(FEditorChangeTracker::MakeRouteVersion(EEditorChange::World | EEditorChange::Objects)));
 
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/actors/details"),
-		FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleDetails));
+		FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleDetails),
+		FRESTRouteOptions::Versioned(FEditorChangeTracker::MakeRouteVersion(EEditorChange::World | EEditorChange::Objects)).Cached());
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/actors/spawn"),
-		FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleSpawn));
+		FEditorChangeTracker::BumpAfter(ActorEdits, FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleSpawn)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/actors/spawn_raycast"),
-		FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleSpawnRaycast));
+		FEditorChangeTracker::BumpAfter(ActorEdits, FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleSpawnRaycast)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/actors/duplicate"),
-		FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleDuplicate));
+		FEditorChangeTracker::BumpAfter(ActorEdits, FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleDuplicate)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/actors/transform"),
-		FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleTransform));
+		FEditorChangeTracker::BumpAfter(ActorEdits, FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleTransform)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/actors/delete"),
-		FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleDelete));
+		FEditorChangeTracker::BumpAfter(ActorEdits, FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleDelete)));
+
+	Router.RegisterRoute(ERESTMethod::POST, TEXT("/actors/spawn/bulk"),
+		FEditorChangeTracker::BumpAfter(ActorEdits, FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleSpawnBulk)),
+		FRESTRouteOptions().Bulk());
+
+	Router.RegisterRoute(ERESTMethod::POST, TEXT("/actors/transform/bulk"),
+		FEditorChangeTracker::BumpAfter(ActorEdits, FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleTransformBulk)),
+		FRESTRouteOptions().Bulk());
+
+	Router.RegisterRoute(ERESTMethod::POST, TEXT("/actors/delete/bulk"),
+		FEditorChangeTracker::BumpAfter(ActorEdits, FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleDeleteBulk)),
+		FRESTRouteOptions().Bulk());
 
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/actors/in_view"),
 		FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleInView));
 
-	UE_LOG(LogTemp, Log, TEXT("ActorsHandler: Registered 8 routes at /actors"));
+	Router.RegisterRoute(ERESTMethod::POST, TEXT("/actors/query"),
+		FRESTRouteHandler::CreateRaw(this, &FActorsHandler::HandleQuery));
+
+	UE_LOG(LogTemp, Log, TEXT("ActorsHandler: Registered 12 routes at /actors"));
 }
 
 FRESTResponse FActorsHandler::HandleList(const FRESTRequest& Request)
@@ -45,28 +155,64 @@ FRESTResponse FActorsHandler::HandleList(const FRESTRequest& Request)
 		return FRESTResponse::Error(400, TEXT("NO_LEVEL_LOADED"), TEXT("No level currently open"));
 	}
 
-	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
-	Response->SetBoolField(TEXT("success"), true);
+	FRESTListQuery Query;
+	FString Error;
+	if (!FRESTListQuery::Parse(Request, MAX_int32, MAX_int32, Query, Error))
+	{
+		return FRESTResponse::BadRequest(Error);
+	}
 
-	TArray<TSharedPtr<FJsonValue>> ActorsArray;
+	const bool bWantLabel = Query.Wants(TEXT("label"));
+	const bool bWantClass = Query.Wants(TEXT("class"));
+	const bool bWantLocation = Query.Wants(TEXT("location"));
 
+	// Streamed: one actor entry costs a few appends instead of four FJsonObject allocations
+	FRESTJsonWriter Writer;
+	Query.BeginList(Writer, TEXT("actors"));
+
+	int32 Index = 0;
+	int32 Count = 0;
+	bool bHasMore = false;
 	for (TActorIterator<AActor> It(World); It; ++It)
 	{
 		AActor* Actor = *It;
-		if (Actor)
+		if (!Actor)
 		{
-			TSharedPtr<FJsonObject> ActorJson = MakeShared<FJsonObject>();
-			ActorJson->SetStringField(TEXT("label"), Actor->GetActorLabel());
-			ActorJson->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
-			ActorJson->SetObjectField(TEXT("location"), JsonHelpers::VectorToJson(Actor->GetActorLocation()));
-			ActorsArray.Add(MakeShared<FJsonValueObject>(ActorJson));
+			continue;
 		}
-	}
 
-	Response->SetArrayField(TEXT("actors"), ActorsArray);
-	Response->SetNumberField(TEXT("count"), ActorsArray.Num());
+		const int32 ActorIndex = Index++;
+		if (Query.IsBeforePage(ActorIndex))
+		{
+			continue;
+		}
+		if (Query.IsAfterPage(ActorIndex))
+		{
+			bHasMore = true;
+			break;
+		}
 
-	return FRESTResponse::Ok(Response);
+		Query.BeginItem(Writer);
+		if (bWantLabel)
+		{
+			Writer.WriteValue(TEXT("label"), Actor->GetActorLabel());
+		}
+		if (bWantClass)
+		{
+			Writer.WriteValue(TEXT("class"), Actor->GetClass()->GetFName());
+		}
+		if (bWantLocation)
+		{
+			JsonHelpers::WriteVector(Writer, TEXT("location"), Actor->GetActorLocation());
+		}
+		Query.EndItem(Writer);
+		Count++;
+	}
+
+	return Query.Finish(Writer, bHasMore, [Count](FRESTJsonWriter& Trailer)
+	{
+		Trailer.WriteValue(TEXT("count"), Count);
+	});
 }
 
 FRESTResponse FActorsHandler::HandleDetails(const FRESTRequest& Request)
@@ -80,8 +226,7 @@ FRESTResponse FActorsHandler::HandleDetails(const FRESTRequest& Request)
 	AActor* Actor = ActorUtils::FindActorByLabel(*LabelPtr);
 	if (!Actor)
 	{
-		TArray<FString> AllLabels = ActorUtils::GetAllActorLabels();
-		TArray<FString> Similar = JsonHelpers::FindSimilarStrings(*LabelPtr, AllLabels);
+		TArray<FString> Similar = ActorUtils::FindSimilarActorLabels(*LabelPtr);
 		TSharedPtr<FJsonObject> Details = JsonHelpers::CreateErrorDetails(
 			*LabelPtr,
 			TEXT("Use GET /actors/list to see available actors"),
@@ -91,9 +236,12 @@ FRESTResponse FActorsHandler::HandleDetails(const FRESTRequest& Request)
 			FString::Printf(TEXT("Actor with label '%s' not found"), **LabelPtr));
 	}
 
+	const FString* FieldsPtr = Request.QueryParams.Find(TEXT("fields"));
+	const FRESTFieldFilter Fields(FieldsPtr ? FStringView(*FieldsPtr) : FStringView());
+
 	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
 	Response->SetBoolField(TEXT("success"), true);
-	Response->SetObjectField(TEXT("actor"), ActorUtils::ActorToDetailedJson(Actor));
+	Response->SetObjectField(TEXT("actor"), ActorUtils::ActorToDetailedJson(Actor, Fields));
 
 	return FRESTResponse::Ok(Response);
 }
@@ -197,8 +345,7 @@ FRESTResponse FActorsHandler::HandleDuplicate(const FRESTRequest& Request)
 	AActor* SourceActor = ActorUtils::FindActorByLabel(Label);
 	if (!SourceActor)
 	{
-		TArray<FString> AllLabels = ActorUtils::GetAllActorLabels();
-		TArray<FString> Similar = JsonHelpers::FindSimilarStrings(Label, AllLabels);
+		TArray<FString> Similar = ActorUtils::FindSimilarActorLabels(Label);
 		return FRESTResponse::Error(404, TEXT("ACTOR_NOT_FOUND"),
 			FString::Printf(TEXT("Actor with label '%s' not found"), *Label));
 	}
@@ -248,14 +395,14 @@ FRESTResponse FActorsHandler::HandleTransform(const FRESTRequest& Request)
 	AActor* Actor = ActorUtils::FindActorByLabel(Label);
 	if (!Actor)
 	{
-		TArray<FString> AllLabels = ActorUtils::GetAllActorLabels();
-		TArray<FString> Similar = JsonHelpers::FindSimilarStrings(Label, AllLabels);
+		TArray<FString> Similar = ActorUtils::FindSimilarActorLabels(Label);
 		return FRESTResponse::Error(404, TEXT("ACTOR_NOT_FOUND"),
 			FString::Printf(TEXT("Actor with label '%s' not found"), *Label));
 	}
 
 	// Apply transforms
 	bool bModified = false;
+	Actor->Modify();
 
 	if (Request.JsonBody->HasField(TEXT("location")))
 	{
@@ -281,6 +428,12 @@ FRESTResponse FActorsHandler::HandleTransform(const FRESTRequest& Request)
 		bModified = true;
 	}
 
+	// Broadcasts OnActorMoved, as a move in the viewport does
+	if (bModified)
+	{
+		Actor->PostEditMove(true);
+	}
+
 	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetStringField(TEXT("label"), Label);
@@ -302,8 +455,7 @@ FRESTResponse FActorsHandler::HandleDelete(const FRESTRequest& Request)
 	AActor* Actor = ActorUtils::FindActorByLabel(Label);
 	if (!Actor)
 	{
-		TArray<FString> AllLabels = ActorUtils::GetAllActorLabels();
-		TArray<FString> Similar = JsonHelpers::FindSimilarStrings(Label, AllLabels);
+		TArray<FString> Similar = ActorUtils::FindSimilarActorLabels(Label);
 		return FRESTResponse::Error(404, TEXT("ACTOR_NOT_FOUND"),
 			FString::Printf(TEXT("Actor with label '%s' not found"), *Label));
 	}
@@ -322,21 +474,326 @@ FRESTResponse FActorsHandler::HandleDelete(const FRESTRequest& Request)
 	return FRESTResponse::Ok(Response);
 }
 
-FRESTResponse FActorsHandler::HandleInView(const FRESTRequest& Request)
+FRESTResponse FActorsHandler::HandleSpawnBulk(const FRESTRequest& Request)
 {
+	if (!Request.JsonBody.IsValid())
+	{
+		return FRESTResponse::BadRequest(TEXT("Request body must be a JSON object"));
+	}
+
 	UWorld* World = ActorUtils::GetEditorWorld();
 	if (!World)
 	{
 		return FRESTResponse::Error(400, TEXT("NO_LEVEL_LOADED"), TEXT("No level currently open"));
 	}
 
-	// Get the active viewport
-	FEditorViewportClient* ViewportClient = nullptr;
-	if (GEditor && GEditor->GetActiveViewport())
+	// Row count comes from the locations column
+	const TArray<TSharedPtr<FJsonValue>>* LocationArray = nullptr;
+	if (!Request.JsonBody->TryGetArrayField(TEXT("locations"), LocationArray) || LocationArray->Num() == 0 || LocationArray->Num() % 3 != 0)
+	{
+		return FRESTResponse::BadRequest(TEXT("locations must be a flat array of x, y, z triples"));
+	}
+	const int32 Rows = LocationArray->Num() / 3;
+
+	FString Error;
+	TArray<double> Locations;
+	TArray<double> Rotations;
+	TArray<double> Scales;
+	TArray<FString> ClassPaths;
+	TArray<FString> Labels;
+	if (!ReadNumberColumn(Request.JsonBody, TEXT("locations"), Rows, 3, Locations, Error) ||
+		!ReadNumberColumn(Request.JsonBody, TEXT("rotations"), Rows, 3, Rotations, Error) ||
+		!ReadNumberColumn(Request.JsonBody, TEXT("scales"), Rows, 3, Scales, Error) ||
+		!ReadStringColumn(Request.JsonBody, TEXT("class_paths"), Rows, ClassPaths, Error) ||
+		!ReadStringColumn(Request.JsonBody, TEXT("labels"), Rows, Labels, Error))
+	{
+		return FRESTResponse::BadRequest(Error);
+	}
+
+	const FString SharedClassPath = JsonHelpers::GetOptionalString(Request.JsonBody, TEXT("class_path"));
+	if (ClassPaths.Num() == 0 && SharedClassPath.IsEmpty())
+	{
+		return FRESTResponse::BadRequest(TEXT("Missing class_path (one class for every actor) or class_paths (one per actor)"));
+	}
+
+	// Each distinct class is loaded once; nullptr remembers a class that failed to load
+	TMap<FString, UClass*> Classes;
+	auto ResolveClass = [&Classes](const FString& ClassPath) -> UClass*
+	{
+		if (UClass** Found = Classes.Find(ClassPath))
+		{
+			return *Found;
+		}
+		return Classes.Add(ClassPath, LoadClass<AActor>(nullptr, *ClassPath));
+	};
+
+	// Placement tools pass exact transforms, so no collision adjustment
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	TArray<AActor*> Spawned;
+	Spawned.Reserve(Rows);
+	TArray<TPair<int32, FString>> Failures;
+	int32 FailedCount = 0;
+
+	{
+		FEditCoalescer::FScope Scope(FText::FromString(FString::Printf(TEXT("REST Bulk Spawn (%d actors)"), Rows)));
+
+		for (int32 Row = 0; Row < Rows; ++Row)
+		{
+			const FString& ClassPath = ClassPaths.Num() > 0 ? ClassPaths[Row] : SharedClassPath;
+			UClass* ActorClass = ResolveClass(ClassPath);
+
+			AActor* Actor = nullptr;
+			if (ActorClass)
+			{
+				const FTransform Transform(
+					Rotations.Num() > 0 ? ColumnRotator(Rotations, Row) : FRotator::ZeroRotator,
+					ColumnVector(Locations, Row),
+					Scales.Num() > 0 ? ColumnVector(Scales, Row) : FVector::OneVector);
+				Actor = World->SpawnActor<AActor>(ActorClass, Transform, SpawnParams);
+			}
+
+			if (!Actor)
+			{
+				Spawned.Add(nullptr);
+				if (FailedCount++ < MaxReportedFailures)
+				{
+					Failures.Emplace(Row, ActorClass
+						? FString::Printf(TEXT("Failed to spawn actor of class: %s"), *ClassPath)
+						: FString::Printf(TEXT("Class not found: %s"), *ClassPath));
+				}
+				continue;
+			}
+
+			if (Labels.Num() > 0 && !Labels[Row].IsEmpty())
+			{
+				Actor->SetActorLabel(Labels[Row]);
+			}
+			Spawned.Add(Actor);
+		}
+	}
+
+	// One viewport redraw for the whole batch; render state updates are already deferred to end of frame
+	if (GEditor)
+	{
+		GEditor->RedrawLevelEditingViewports();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ActorsHandler: Bulk spawned %d of %d actors"), Rows - FailedCount, Rows);
+
+	FRESTJsonWriter Writer;
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("success"), true);
+	Writer.WriteValue(TEXT("spawned"), Rows - FailedCount);
+	Writer.WriteValue(TEXT("failed_count"), FailedCount);
+	Writer.WriteArrayStart(TEXT("labels"));
+	for (AActor* Actor : Spawned)
+	{
+		if (Actor)
+		{
+			Writer.WriteValue(Actor->GetActorLabel());
+		}
+		else
+		{
+			Writer.WriteNull();
+		}
+	}
+	Writer.WriteArrayEnd();
+	Writer.WriteArrayStart(TEXT("failed"));
+	for (const TPair<int32, FString>& Failure : Failures)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("index"), Failure.Key);
+		Writer.WriteValue(TEXT("error"), Failure.Value);
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteArrayEnd();
+	Writer.WriteObjectEnd();
+
+	return FRESTResponse::Stream(Writer);
+}
+
+FRESTResponse FActorsHandler::HandleTransformBulk(const FRESTRequest& Request)
+{
+	if (!Request.JsonBody.IsValid())
+	{
+		return FRESTResponse::BadRequest(TEXT("Request body must be a JSON object"));
+	}
+
+	FString Error;
+	TArray<FString> Labels;
+	if (!ReadStringColumn(Request.JsonBody, TEXT("labels"), -1, Labels, Error))
 	{
-		ViewportClient = static_cast<FEditorViewportClient*>(GEditor->GetActiveViewport()->GetClient());
+		return FRESTResponse::BadRequest(Error);
+	}
+	if (Labels.Num() == 0)
+	{
+		return FRESTResponse::BadRequest(TEXT("Missing required field: labels"));
+	}
+
+	const int32 Rows = Labels.Num();
+	TArray<double> Locations;
+	TArray<double> Rotations;
+	TArray<double> Scales;
+	if (!ReadNumberColumn(Request.JsonBody, TEXT("locations"), Rows, 3, Locations, Error) ||
+		!ReadNumberColumn(Request.JsonBody, TEXT("rotations"), Rows, 3, Rotations, Error) ||
+		!ReadNumberColumn(Request.JsonBody, TEXT("scales"), Rows, 3, Scales, Error))
+	{
+		return FRESTResponse::BadRequest(Error);
+	}
+	if (Locations.Num() == 0 && Rotations.Num() == 0 && Scales.Num() == 0)
+	{
+		return FRESTResponse::BadRequest(TEXT("Nothing to apply: pass locations, rotations and/or scales"));
+	}
+
+	TArray<FString> Missing;
+	int32 Updated = 0;
+
+	{
+		FEditCoalescer::FScope Scope(FText::FromString(FString::Printf(TEXT("REST Bulk Transform (%d actors)"), Rows)));
+
+		for (int32 Row = 0; Row < Rows; ++Row)
+		{
+			AActor* Actor = ActorUtils::FindActorByLabel(Labels[Row]);
+			if (!Actor)
+			{
+				Missing.Add(Labels[Row]);
+				continue;
+			}
+
+			// Merge the given columns into the current transform so each actor is moved once
+			FTransform Transform = Actor->GetActorTransform();
+			if (Locations.Num() > 0)
+			{
+				Transform.SetLocation(ColumnVector(Locations, Row));
+			}
+			if (Rotations.Num() > 0)
+			{
+				Transform.SetRotation(ColumnRotator(Rotations, Row).Quaternion());
+			}
+			if (Scales.Num() > 0)
+			{
+				Transform.SetScale3D(ColumnVector(Scales, Row));
+			}
+
+			Actor->Modify();
+			Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+			Updated++;
+		}
+	}
+
+	if (GEditor)
+	{
+		GEditor->RedrawLevelEditingViewports();
+	}
+
+	// SetActorTransform does not broadcast OnActorMoved, so report the batch as one event
+	if (Updated > 0)
+	{
+		TSharedPtr<FJsonObject> EventData = MakeShared<FJsonObject>();
+		EventData->SetNumberField(TEXT("count"), Updated);
+		FEditorEventFeed::Post(EEditorEventTopic::Actors, TEXT("bulk_moved"), FString(), EventData);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ActorsHandler: Bulk transformed %d of %d actors"), Updated, Rows);
+
+	FRESTJsonWriter Writer;
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("success"), true);
+	Writer.WriteValue(TEXT("updated"), Updated);
+	Writer.WriteArrayStart(TEXT("missing"));
+	for (const FString& Label : Missing)
+	{
+		Writer.WriteValue(Label);
 	}
+	Writer.WriteArrayEnd();
+	Writer.WriteObjectEnd();
 
+	return FRESTResponse::Stream(Writer);
+}
+
+FRESTResponse FActorsHandler::HandleDeleteBulk(const FRESTRequest& Request)
+{
+	if (!Request.JsonBody.IsValid())
+	{
+		return FRESTResponse::BadRequest(TEXT("Request body must be a JSON object"));
+	}
+
+	FString Error;
+	TArray<FString> Labels;
+	if (!ReadStringColumn(Request.JsonBody, TEXT("labels"), -1, Labels, Error))
+	{
+		return FRESTResponse::BadRequest(Error);
+	}
+	if (Labels.Num() == 0)
+	{
+		return FRESTResponse::BadRequest(TEXT("Missing required field: labels"));
+	}
+
+	// Resolve everything before destroying anything, so lookups never race the deletes
+	TArray<AActor*> Actors;
+	TSet<AActor*> Seen;
+	TArray<FString> Missing;
+	Actors.Reserve(Labels.Num());
+	for (const FString& Label : Labels)
+	{
+		AActor* Actor = ActorUtils::FindActorByLabel(Label);
+		if (!Actor)
+		{
+			Missing.Add(Label);
+		}
+		else if (!Seen.Contains(Actor))
+		{
+			Seen.Add(Actor);
+			Actors.Add(Actor);
+		}
+	}
+
+	int32 Deleted = 0;
+	{
+		FEditCoalescer::FScope Scope(FText::FromString(FString::Printf(TEXT("REST Bulk Delete (%d actors)"), Actors.Num())));
+
+		for (AActor* Actor : Actors)
+		{
+			if (Actor->Destroy())
+			{
+				Deleted++;
+			}
+		}
+	}
+
+	if (GEditor)
+	{
+		GEditor->RedrawLevelEditingViewports();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ActorsHandler: Bulk deleted %d actors (%d labels not found)"), Deleted, Missing.Num());
+
+	FRESTJsonWriter Writer;
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("success"), true);
+	Writer.WriteValue(TEXT("deleted"), Deleted);
+	Writer.WriteArrayStart(TEXT("missing"));
+	for (const FString& Label : Missing)
+	{
+		Writer.WriteValue(Label);
+	}
+	Writer.WriteArrayEnd();
+	Writer.WriteObjectEnd();
+
+	return FRESTResponse::Stream(Writer);
+}
+
+FRESTResponse FActorsHandler::HandleInView(const FRESTRequest& Request)
+{
+	UWorld* World = ActorUtils::GetEditorWorld();
+	if (!World)
+	{
+		return FRESTResponse::Error(400, TEXT("NO_LEVEL_LOADED"), TEXT("No level currently open"));
+	}
+
+	FEditorViewportClient* ViewportClient = GetActiveViewportClient();
 	if (!ViewportClient)
 	{
 		return FRESTResponse::Error(400, TEXT("NO_VIEWPORT"), TEXT("No active editor viewport"));
@@ -352,35 +809,251 @@ FRESTResponse FActorsHandler::HandleInView(const FRESTRequest& Request)
 		MaxDistance = FCString::Atof(**DistancePtr);
 	}
 
+	// The viewport frustum, cut off at max_distance
+	FActorSpatialQuery Query;
+	Query.Shape = EActorSpatialShape::Frustum;
+	Query.Frustum = MakeViewportFrustum(ViewportClient, MaxDistance);
+
+	TArray<FActorSpatialHit> Hits = FActorSpatialIndex::Query(Query);
+
 	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetObjectField(TEXT("camera_location"), JsonHelpers::VectorToJson(CameraLocation));
 
 	TArray<TSharedPtr<FJsonValue>> ActorsArray;
+	ActorsArray.Reserve(Hits.Num());
 
-	for (TActorIterator<AActor> It(World); It; ++It)
+	for (const FActorSpatialHit& Hit : Hits)
 	{
-		AActor* Actor = *It;
-		if (Actor)
+		AActor* Actor = Hit.Actor;
+		float Distance = FVector::Dist(CameraLocation, Actor->GetActorLocation());
+
+		TSharedPtr<FJsonObject> ActorJson = MakeShared<FJsonObject>();
+		ActorJson->SetStringField(TEXT("label"), Actor->GetActorLabel());
+		ActorJson->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
+		ActorJson->SetObjectField(TEXT("location"), JsonHelpers::VectorToJson(Actor->GetActorLocation()));
+		ActorJson->SetNumberField(TEXT("distance"), Distance);
+		ActorsArray.Add(MakeShared<FJsonValueObject>(ActorJson));
+	}
+
+	Response->SetArrayField(TEXT("actors"), ActorsArray);
+	Response->SetNumberField(TEXT("count"), ActorsArray.Num());
+
+	return FRESTResponse::Ok(Response);
+}
+
+FRESTResponse FActorsHandler::HandleQuery(const FRESTRequest& Request)
+{
+	if (!Request.JsonBody.IsValid())
+	{
+		return FRESTResponse::BadRequest(TEXT("Request body must be valid JSON"));
+	}
+
+	if (!ActorUtils::GetEditorWorld())
+	{
+		return FRESTResponse::Error(400, TEXT("NO_LEVEL_LOADED"), TEXT("No level currently open"));
+	}
+
+	const TSharedPtr<FJsonObject>& Body = Request.JsonBody;
+	const FString Shape = JsonHelpers::GetOptionalString(Body, TEXT("shape"), TEXT("frustum"));
+
+	FActorSpatialQuery Query;
+
+	// Point that results are sorted by distance from
+	FVector Origin = FVector::ZeroVector;
+
+	if (Shape == TEXT("box"))
+	{
+		FVector Min;
+		FVector Max;
+		const TSharedPtr<FJsonObject>* MinJson = nullptr;
+		const TSharedPtr<FJsonObject>* MaxJson = nullptr;
+		if (!Body->TryGetObjectField(TEXT("min"), MinJson) || !Body->TryGetObjectField(TEXT("max"), MaxJson)
+			|| !JsonHelpers::JsonToVector(*MinJson, Min) || !JsonHelpers::JsonToVector(*MaxJson, Max))
+		{
+			return FRESTResponse::Error(400, TEXT("MISSING_FIELD"), TEXT("Box query requires min and max {x, y, z}"));
+		}
+
+		Query.Shape = EActorSpatialShape::Box;
+		Query.Box = FBox(Min.ComponentMin(Max), Min.ComponentMax(Max));
+		Origin = Query.Box.GetCenter();
+	}
+	else if (Shape == TEXT("sphere"))
+	{
+		const TSharedPtr<FJsonObject>* CenterJson = nullptr;
+		if (!Body->TryGetObjectField(TEXT("center"), CenterJson) || !JsonHelpers::JsonToVector(*CenterJson, Query.Center) || !Body->HasField(TEXT("radius")))
+		{
+			return FRESTResponse::Error(400, TEXT("MISSING_FIELD"), TEXT("Sphere query requires center {x, y, z} and radius"));
+		}
+
+		Query.Shape = EActorSpatialShape::Sphere;
+		Query.Radius = FMath::Max(0.0, Body->GetNumberField(TEXT("radius")));
+		Origin = Query.Center;
+	}
+	else if (Shape == TEXT("ray"))
+	{
+		const TSharedPtr<FJsonObject>* StartJson = nullptr;
+		if (!Body->TryGetObjectField(TEXT("start"), StartJson) || !JsonHelpers::JsonToVector(*StartJson, Query.RayStart))
+		{
+			return FRESTResponse::Error(400, TEXT("MISSING_FIELD"), TEXT("Ray query requires start {x, y, z} and end or direction"));
+		}
+
+		const TSharedPtr<FJsonObject>* EndJson = nullptr;
+		const TSharedPtr<FJsonObject>* DirectionJson = nullptr;
+		FVector Direction;
+		if (Body->TryGetObjectField(TEXT("end"), EndJson) && JsonHelpers::JsonToVector(*EndJson, Query.RayEnd))
+		{
+			// Segment given directly
+		}
+		else if (Body->TryGetObjectField(TEXT("direction"), DirectionJson) && JsonHelpers::JsonToVector(*DirectionJson, Direction) && !Direction.IsNearlyZero())
 		{
-			// Distance-based visibility check
-			float Distance = FVector::Dist(CameraLocation, Actor->GetActorLocation());
-			if (Distance <= MaxDistance)
+			const double Length = JsonHelpers::GetOptionalDouble(Body, TEXT("length"), 100000.0);
+			Query.RayEnd = Query.RayStart + Direction.GetSafeNormal() * Length;
+		}
+		else
+		{
+			return FRESTResponse::Error(400, TEXT("MISSING_FIELD"), TEXT("Ray query requires start {x, y, z} and end or direction"));
+		}
+
+		Query.Shape = EActorSpatialShape::Ray;
+		Origin = Query.RayStart;
+	}
+	else if (Shape == TEXT("frustum"))
+	{
+		const float FarClip = static_cast<float>(JsonHelpers::GetOptionalDouble(Body, TEXT("max_distance"), 50000.0));
+
+		const TSharedPtr<FJsonObject>* LocationJson = nullptr;
+		if (Body->TryGetObjectField(TEXT("location"), LocationJson))
+		{
+			// Explicit camera
+			FRotator Rotation = FRotator::ZeroRotator;
+			const TSharedPtr<FJsonObject>* RotationJson = nullptr;
+			if (Body->TryGetObjectField(TEXT("rotation"), RotationJson))
 			{
-				TSharedPtr<FJsonObject> ActorJson = MakeShared<FJsonObject>();
-				ActorJson->SetStringField(TEXT("label"), Actor->GetActorLabel());
-				ActorJson->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
-				ActorJson->SetObjectField(TEXT("location"), JsonHelpers::VectorToJson(Actor->GetActorLocation()));
-				ActorJson->SetNumberField(TEXT("distance"), Distance);
-				ActorsArray.Add(MakeShared<FJsonValueObject>(ActorJson));
+				JsonHelpers::JsonToRotator(*RotationJson, Rotation);
 			}
+			JsonHelpers::JsonToVector(*LocationJson, Origin);
+
+			const float Fov = static_cast<float>(JsonHelpers::GetOptionalDouble(Body, TEXT("fov"), 90.0));
+			const float Aspect = static_cast<float>(JsonHelpers::GetOptionalDouble(Body, TEXT("aspect_ratio"), 16.0 / 9.0));
+			Query.Frustum = FActorSpatialIndex::MakeFrustum(Origin, Rotation, Fov, Aspect, 10.0f, FarClip);
 		}
+		else
+		{
+			// Active editor viewport
+			FEditorViewportClient* ViewportClient = GetActiveViewportClient();
+			if (!ViewportClient)
+			{
+				return FRESTResponse::Error(400, TEXT("NO_VIEWPORT"), TEXT("No active editor viewport; pass location/rotation for an explicit camera"));
+			}
+			Origin = ViewportClient->GetViewLocation();
+			Query.Frustum = MakeViewportFrustum(ViewportClient, FarClip);
+		}
+
+		Query.Shape = EActorSpatialShape::Frustum;
+	}
+	else
+	{
+		return FRESTResponse::Error(400, TEXT("INVALID_SHAPE"),
+			FString::Printf(TEXT("Unknown shape '%s'. Use frustum, box, sphere or ray."), *Shape));
 	}
 
-	Response->SetArrayField(TEXT("actors"), ActorsArray);
-	Response->SetNumberField(TEXT("count"), ActorsArray.Num());
+	const int32 Limit = FMath::Max(1, JsonHelpers::GetOptionalInt(Body, TEXT("limit"), 1000));
+	const FString Sort = JsonHelpers::GetOptionalString(Body, TEXT("sort"), TEXT("distance"));
+	const FString ClassFilter = JsonHelpers::GetOptionalString(Body, TEXT("class"));
 
-	return FRESTResponse::Ok(Response);
+	TArray<FActorSpatialHit> Hits = FActorSpatialIndex::Query(Query);
+
+	if (!ClassFilter.IsEmpty())
+	{
+		Hits.RemoveAll([&ClassFilter](const FActorSpatialHit& Hit)
+		{
+			return Hit.Actor->GetClass()->GetName() != ClassFilter;
+		});
+	}
+
+	const int32 Total = Hits.Num();
+
+	// Ray hits sort by where the ray enters the bounds; everything else by distance from the origin
+	auto DistanceOf = [&Query, &Origin](const FActorSpatialHit& Hit) -> double
+	{
+		return Query.Shape == EActorSpatialShape::Ray ? Hit.RayDistance : FVector::Dist(Origin, Hit.Actor->GetActorLocation());
+	};
+
+	const bool bSortByDistance = Sort == TEXT("distance");
+	if (bSortByDistance)
+	{
+		Hits.Sort([&DistanceOf](const FActorSpatialHit& A, const FActorSpatialHit& B)
+		{
+			return DistanceOf(A) < DistanceOf(B);
+		});
+	}
+
+	if (Hits.Num() > Limit)
+	{
+		Hits.SetNum(Limit);
+	}
+
+	// Streamed like /actors/list
+	FRESTJsonWriter Writer;
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("success"), true);
+	Writer.WriteValue(TEXT("shape"), Shape);
+	JsonHelpers::WriteVector(Writer, TEXT("origin"), Origin);
+	Writer.WriteArrayStart(TEXT("actors"));
+
+	for (const FActorSpatialHit& Hit : Hits)
+	{
+		AActor* Actor = Hit.Actor;
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("label"), Actor->GetActorLabel());
+		Writer.WriteValue(TEXT("class"), Actor->GetClass()->GetFName());
+		JsonHelpers::WriteVector(Writer, TEXT("location"), Actor->GetActorLocation());
+		Writer.WriteValue(TEXT("distance"), DistanceOf(Hit));
+		Writer.WriteObjectStart(TEXT("bounds"));
+		JsonHelpers::WriteVector(Writer, TEXT("min"), Hit.Bounds.Min);
+		JsonHelpers::WriteVector(Writer, TEXT("max"), Hit.Bounds.Max);
+		Writer.WriteObjectEnd();
+		Writer.WriteObjectEnd();
+	}
+
+	Writer.WriteArrayEnd();
+	Writer.WriteValue(TEXT("count"), Hits.Num());
+	Writer.WriteValue(TEXT("total"), Total);
+	Writer.WriteValue(TEXT("truncated"), Total > Hits.Num());
+	Writer.WriteObjectEnd();
+
+	return FRESTResponse::Stream(Writer);
+}
+
+FEditorViewportClient* FActorsHandler::GetActiveViewportClient()
+{
+	if (GEditor && GEditor->GetActiveViewport())
+	{
+		return static_cast<FEditorViewportClient*>(GEditor->GetActiveViewport()->GetClient());
+	}
+	return nullptr;
+}
+
+FConvexVolume FActorsHandler::MakeViewportFrustum(FEditorViewportClient* ViewportClient, float MaxDistance)
+{
+	float AspectRatio = 16.0f / 9.0f;
+	if (FViewport* Viewport = ViewportClient->Viewport)
+	{
+		const FIntPoint Size = Viewport->GetSizeXY();
+		if (Size.X > 0 && Size.Y > 0)
+		{
+			AspectRatio = static_cast<float>(Size.X) / static_cast<float>(Size.Y);
+		}
+	}
+
+	return FActorSpatialIndex::MakeFrustum(
+		ViewportClient->GetViewLocation(),
+		ViewportClient->GetViewRotation(),
+		ViewportClient->ViewFOV,
+		AspectRatio,
+		ViewportClient->GetNearClipPlane(),
+		MaxDistance);
 }
 
 TArray<TSharedPtr<FJsonObject>> FActorsHandler::GetEndpointSchemas() const
@@ -504,24 +1177,129 @@ TArray<TSharedPtr<FJsonObject>> FActorsHandler::GetEndpointSchemas() const
 		Schemas.Add(Endpoint);
 	}
 
+	// POST /actors/spawn/bulk
+	{
+		TSharedPtr<FJsonObject> Endpoint = MakeShared<FJsonObject>();
+		Endpoint->SetStringField(TEXT("method"), TEXT("POST"));
+		Endpoint->SetStringField(TEXT("path"), TEXT("/actors/spawn/bulk"));
+		Endpoint->SetStringField(TEXT("description"), TEXT("Spawn many actors from columnar arrays in one transaction"));
+
+		TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+		TSharedPtr<FJsonObject> LocationsParam = MakeShared<FJsonObject>();
+		LocationsParam->SetStringField(TEXT("type"), TEXT("array"));
+		LocationsParam->SetBoolField(TEXT("required"), true);
+		LocationsParam->SetStringField(TEXT("description"), TEXT("Flat [x0, y0, z0, x1, ...]; one triple per actor"));
+		Params->SetObjectField(TEXT("locations"), LocationsParam);
+
+		TSharedPtr<FJsonObject> ClassParam = MakeShared<FJsonObject>();
+		ClassParam->SetStringField(TEXT("type"), TEXT("string"));
+		ClassParam->SetBoolField(TEXT("required"), false);
+		ClassParam->SetStringField(TEXT("description"), TEXT("Class for every actor; or class_paths with one entry per actor"));
+		Params->SetObjectField(TEXT("class_path"), ClassParam);
+
+		TSharedPtr<FJsonObject> ColumnsParam = MakeShared<FJsonObject>();
+		ColumnsParam->SetStringField(TEXT("type"), TEXT("array"));
+		ColumnsParam->SetBoolField(TEXT("required"), false);
+		ColumnsParam->SetStringField(TEXT("description"), TEXT("Optional flat [pitch, yaw, roll, ...] rotations; scales and labels columns work the same way"));
+		Params->SetObjectField(TEXT("rotations"), ColumnsParam);
+		Endpoint->SetObjectField(TEXT("parameters"), Params);
+
+		Schemas.Add(Endpoint);
+	}
+
+	// POST /actors/transform/bulk
+	{
+		TSharedPtr<FJsonObject> Endpoint = MakeShared<FJsonObject>();
+		Endpoint->SetStringField(TEXT("method"), TEXT("POST"));
+		Endpoint->SetStringField(TEXT("path"), TEXT("/actors/transform/bulk"));
+		Endpoint->SetStringField(TEXT("description"), TEXT("Move many actors from columnar arrays in one transaction"));
+
+		TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+		TSharedPtr<FJsonObject> LabelsParam = MakeShared<FJsonObject>();
+		LabelsParam->SetStringField(TEXT("type"), TEXT("array"));
+		LabelsParam->SetBoolField(TEXT("required"), true);
+		LabelsParam->SetStringField(TEXT("description"), TEXT("Actor labels, one row each"));
+		Params->SetObjectField(TEXT("labels"), LabelsParam);
+
+		TSharedPtr<FJsonObject> ColumnsParam = MakeShared<FJsonObject>();
+		ColumnsParam->SetStringField(TEXT("type"), TEXT("array"));
+		ColumnsParam->SetBoolField(TEXT("required"), false);
+		ColumnsParam->SetStringField(TEXT("description"), TEXT("Flat [x0, y0, z0, ...]; rotations and scales work the same way. Omitted columns stay unchanged."));
+		Params->SetObjectField(TEXT("locations"), ColumnsParam);
+		Endpoint->SetObjectField(TEXT("parameters"), Params);
+
+		Schemas.Add(Endpoint);
+	}
+
+	// POST /actors/delete/bulk
+	{
+		TSharedPtr<FJsonObject> Endpoint = MakeShared<FJsonObject>();
+		Endpoint->SetStringField(TEXT("method"), TEXT("POST"));
+		Endpoint->SetStringField(TEXT("path"), TEXT("/actors/delete/bulk"));
+		Endpoint->SetStringField(TEXT("description"), TEXT("Remove many actors in one transaction"));
+
+		TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+		TSharedPtr<FJsonObject> LabelsParam = MakeShared<FJsonObject>();
+		LabelsParam->SetStringField(TEXT("type"), TEXT("array"));
+		LabelsParam->SetBoolField(TEXT("required"), true);
+		LabelsParam->SetStringField(TEXT("description"), TEXT("Labels of actors to delete"));
+		Params->SetObjectField(TEXT("labels"), LabelsParam);
+		Endpoint->SetObjectField(TEXT("parameters"), Params);
+
+		Schemas.Add(Endpoint);
+	}
+
 	// GET /actors/in_view
 	{
 		TSharedPtr<FJsonObject> Endpoint = MakeShared<FJsonObject>();
 		Endpoint->SetStringField(TEXT("method"), TEXT("GET"));
 		Endpoint->SetStringField(TEXT("path"), TEXT("/actors/in_view"));
-		Endpoint->SetStringField(TEXT("description"), TEXT("List actors visible in editor viewport"));
+		Endpoint->SetStringField(TEXT("description"), TEXT("List actors inside the editor viewport frustum"));
 
 		TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
 		TSharedPtr<FJsonObject> DistParam = MakeShared<FJsonObject>();
 		DistParam->SetStringField(TEXT("type"), TEXT("number"));
 		DistParam->SetBoolField(TEXT("required"), false);
 		DistParam->SetStringField(TEXT("default"), TEXT("50000"));
-		DistParam->SetStringField(TEXT("description"), TEXT("Maximum distance from camera"));
+		DistParam->SetStringField(TEXT("description"), TEXT("Far plane distance from camera"));
 		Params->SetObjectField(TEXT("max_distance"), DistParam);
 		Endpoint->SetObjectField(TEXT("parameters"), Params);
 
 		Schemas.Add(Endpoint);
 	}
 
+	// POST /actors/query
+	{
+		TSharedPtr<FJsonObject> Endpoint = MakeShared<FJsonObject>();
+		Endpoint->SetStringField(TEXT("method"), TEXT("POST"));
+		Endpoint->SetStringField(TEXT("path"), TEXT("/actors/query"));
+		Endpoint->SetStringField(TEXT("description"), TEXT("Spatial actor query (frustum, box, sphere, ray) served from an octree of actor bounds"));
+
+		TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+		TSharedPtr<FJsonObject> ShapeParam = MakeShared<FJsonObject>();
+		ShapeParam->SetStringField(TEXT("type"), TEXT("string"));
+		ShapeParam->SetBoolField(TEXT("required"), false);
+		ShapeParam->SetStringField(TEXT("default"), TEXT("frustum"));
+		ShapeParam->SetStringField(TEXT("description"), TEXT("frustum (location/rotation/fov or active viewport, max_distance), box (min, max), sphere (center, radius), ray (start, end or direction/length)"));
+		Params->SetObjectField(TEXT("shape"), ShapeParam);
+
+		TSharedPtr<FJsonObject> LimitParam = MakeShared<FJsonObject>();
+		LimitParam->SetStringField(TEXT("type"), TEXT("number"));
+		LimitParam->SetBoolField(TEXT("required"), false);
+		LimitParam->SetStringField(TEXT("default"), TEXT("1000"));
+		LimitParam->SetStringField(TEXT("description"), TEXT("Maximum actors returned"));
+		Params->SetObjectField(TEXT("limit"), LimitParam);
+
+		TSharedPtr<FJsonObject> SortParam = MakeShared<FJsonObject>();
+		SortParam->SetStringField(TEXT("type"), TEXT("string"));
+		SortParam->SetBoolField(TEXT("required"), false);
+		SortParam->SetStringField(TEXT("default"), TEXT("distance"));
+		SortParam->SetStringField(TEXT("description"), TEXT("distance or none"));
+		Params->SetObjectField(TEXT("sort"), SortParam);
+		Endpoint->SetObjectField(TEXT("parameters"), Params);
+
+		Schemas.Add(Endpoint);
+	}
+
 	return Schemas;
 }
@@ -2,46 +2,98 @@
 
 #include "Handlers/AssetsHandler.h"
 #include "Utils/JsonHelpers.h"
+#include "Utils/EditorChangeTracker.h"
+#include "Utils/AssetSearchIndex.h"
+#include "Utils/AssetBulkInspector.h"
+#include "RESTJsonWriter.h"
+#include "RESTListQuery.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "String/Find.h"
 #include "Engine/StaticMesh.h"
 #include "UObject/UObjectIterator.h"
-#include "Exporters/Exporter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+
+namespace
+{
+	/** "Material" (Engine module) or a full class path like "/Script/Engine.Material" */
+	FTopLevelAssetPath ParseAssetClassPath(const FString& Type)
+	{
+		return FTopLevelAssetPath(Type.StartsWith(TEXT("/")) ? Type : FString::Printf(TEXT("/Script/Engine.%s"), *Type));
+	}
+
+	/** Largest page GET /assets/bulk/{id} returns */
+	constexpr int32 MaxBulkResultsPerPage = 10000;
+}
 
 void FAssetsHandler::RegisterRoutes(FRESTRouter& Router)
 {
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/assets/list"),
-		FRESTRouteHandler::CreateRaw(this, &FAssetsHandler::HandleList));
+		FRESTRouteHandler::CreateRaw(this, &FAssetsHandler::HandleList),
+		FRESTRouteOptions::Versioned(FEditorChangeTracker::MakeRouteVersion(EEditorChange::Assets)));
 
+	// Registry reads stay on the game thread: only there do they include unsaved in-memory assets
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/assets/search"),
 		FRESTRouteHandler::CreateRaw(this, &FAssetsHandler::HandleSearch));
 
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/assets/info"),
-		FRESTRouteHandler::CreateRaw(this, &FAssetsHandler::HandleInfo));
+		FRESTRouteHandler::CreateRaw(this, &FAssetsHandler::HandleInfo),
+		FRESTRouteOptions::Versioned(FEditorChangeTracker::MakeRouteVersion(EEditorChange::Assets)).Cached());
 
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/assets/refs"),
 		FRESTRouteHandler::CreateRaw(this, &FAssetsHandler::HandleRefs));
 
+	Router.RegisterRoute(ERESTMethod::POST, TEXT("/assets/refs/graph"),
+		FRESTRouteHandler::CreateRaw(this, &FAssetsHandler::HandleRefsGraph));
+
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/assets/export"),
-		FRESTRouteHandler::CreateRaw(this, &FAssetsHandler::HandleExport));
+		FRESTRouteHandler::CreateRaw(this, &FAssetsHandler::HandleExport),
+		FRESTRouteOptions().Bulk());
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/assets/validate"),
-		FRESTRouteHandler::CreateRaw(this, &FAssetsHandler::HandleValidate));
+		FRESTRouteHandler::CreateRaw(this, &FAssetsHandler::HandleValidate),
+		FRESTRouteOptions().Bulk());
 
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/assets/mesh_details"),
 		FRESTRouteHandler::CreateRaw(this, &FAssetsHandler::HandleMeshDetails));
 
-	UE_LOG(LogTemp, Log, TEXT("AssetsHandler: Registered 7 routes at /assets"));
+	// Bulk variants of mesh_details, validate, export and /materials/recompile
+	Router.RegisterRoute(ERESTMethod::POST, TEXT("/assets/bulk"),
+		FRESTRouteHandler::CreateRaw(this, &FAssetsHandler::HandleBulk));
+
+	Router.RegisterRoute(ERESTMethod::GET, TEXT("/assets/bulk/{id}"),
+		FRESTRouteHandler::CreateLambda([this](const FRESTRequest& Request) -> FRESTResponse
+		{
+			return HandleGetBulkJob(Request, Request.PathParams.FindRef(TEXT("id")));
+		}));
+
+	Router.RegisterRoute(ERESTMethod::DELETE, TEXT("/assets/bulk/{id}"),
+		FRESTRouteHandler::CreateLambda([this](const FRESTRequest& Request) -> FRESTResponse
+		{
+			return HandleCancelBulkJob(Request, Request.PathParams.FindRef(TEXT("id")));
+		}));
+
+	UE_LOG(LogTemp, Log, TEXT("AssetsHandler: Registered 11 routes at /assets"));
 }
 
 FRESTResponse FAssetsHandler::HandleList(const FRESTRequest& Request)
 {
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+	// Safe from any thread, unlike FModuleManager lookups
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	// Pages default to 1000 assets; 10000 at most per request to keep responses bounded
+	FRESTListQuery Query;
+	FString Error;
+	if (!FRESTListQuery::Parse(Request, 1000, 10000, Query, Error))
+	{
+		return FRESTResponse::BadRequest(Error);
+	}
 
 	// Get optional filters from query params
 	FString Path = TEXT("/Game");
 	FString Type = TEXT("");
-	int32 Limit = 1000;
 
 	const FString* PathPtr = Request.QueryParams.Find(TEXT("path"));
 	if (PathPtr)
@@ -55,12 +107,6 @@ FRESTResponse FAssetsHandler::HandleList(const FRESTRequest& Request)
 		Type = *TypePtr;
 	}
 
-	const FString* LimitPtr = Request.QueryParams.Find(TEXT("limit"));
-	if (LimitPtr)
-	{
-		Limit = FCString::Atoi(**LimitPtr);
-	}
-
 	// Build filter
 	FARFilter Filter;
 	Filter.PackagePaths.Add(FName(*Path));
@@ -69,18 +115,7 @@ FRESTResponse FAssetsHandler::HandleList(const FRESTRequest& Request)
 	if (!Type.IsEmpty())
 	{
 		// Type can be simple name ("Material") or full path ("/Script/Engine.Material")
-		FTopLevelAssetPath ClassPath;
-		if (Type.StartsWith(TEXT("/")))
-		{
-			// Full path provided
-			ClassPath = FTopLevelAssetPath(Type);
-		}
-		else
-		{
-			// Simple name - assume Engine module
-			FString FullPath = FString::Printf(TEXT("/Script/Engine.%s"), *Type);
-			ClassPath = FTopLevelAssetPath(FullPath);
-		}
+		const FTopLevelAssetPath ClassPath = ParseAssetClassPath(Type);
 
 		if (ClassPath.IsValid())
 		{
@@ -100,41 +135,29 @@ FRESTResponse FAssetsHandler::HandleList(const FRESTRequest& Request)
 	UE_LOG(LogTemp, Log, TEXT("AssetsHandler: Found %d assets matching filter (path=%s, type=%s)"),
 		Assets.Num(), *Path, Type.IsEmpty() ? TEXT("any") : *Type);
 
-	// Hard safety limit to prevent server hangs
-	const int32 HardLimit = FMath::Min(Limit, 10000);
-	if (Limit > 10000)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("AssetsHandler: Requested limit %d exceeds hard limit 10000, capping"), Limit);
-	}
-
 	// Build response
-	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
-	Response->SetBoolField(TEXT("success"), true);
-	Response->SetNumberField(TEXT("total"), Assets.Num());
-
-	TArray<TSharedPtr<FJsonValue>> AssetsArray;
-	int32 Count = 0;
-	for (const FAssetData& Asset : Assets)
+	FRESTJsonWriter Writer;
+	Query.BeginList(Writer, TEXT("assets"), [&Assets](FRESTJsonWriter& Header)
 	{
-		if (Count >= HardLimit)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("AssetsHandler: Hit limit %d, stopping enumeration (total available: %d)"),
-				HardLimit, Assets.Num());
-			break;
-		}
+		Header.WriteValue(TEXT("total"), Assets.Num());
+	});
 
+	const int32 End = FMath::Min(Assets.Num(), Query.GetOffset() + Query.GetLimit());
+	for (int32 Index = Query.GetOffset(); Index < End; ++Index)
+	{
 		// Progress logging every 100 assets
+		const int32 Count = Index - Query.GetOffset();
 		if (Count > 0 && Count % 100 == 0)
 		{
-			UE_LOG(LogTemp, Verbose, TEXT("AssetsHandler: Processing asset %d/%d"), Count, FMath::Min(Assets.Num(), HardLimit));
+			UE_LOG(LogTemp, Verbose, TEXT("AssetsHandler: Processing asset %d/%d"), Count, End - Query.GetOffset());
 		}
 
-		AssetsArray.Add(MakeShared<FJsonValueObject>(AssetDataToJson(Asset)));
-		Count++;
+		Query.BeginItem(Writer);
+		WriteAssetData(Writer, Assets[Index], Query.GetFields());
+		Query.EndItem(Writer);
 	}
-	Response->SetArrayField(TEXT("assets"), AssetsArray);
 
-	return FRESTResponse::Ok(Response);
+	return Query.Finish(Writer, End < Assets.Num());
 }
 
 FRESTResponse FAssetsHandler::HandleSearch(const FRESTRequest& Request)
@@ -146,44 +169,126 @@ FRESTResponse FAssetsHandler::HandleSearch(const FRESTRequest& Request)
 		return FRESTResponse::BadRequest(Error);
 	}
 
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	FRESTListQuery ListQuery;
+	if (!FRESTListQuery::Parse(Request, 100, 10000, ListQuery, Error))
+	{
+		return FRESTResponse::BadRequest(Error);
+	}
+
+	FAssetSearchQuery Search;
+	Search.Text = Query;
+	Search.PathPrefix = JsonHelpers::GetOptionalString(Request.JsonBody, TEXT("path"), TEXT(""));
+	Search.Offset = ListQuery.GetOffset();
+	Search.Limit = ListQuery.GetLimit();
+
+	const FString Mode = JsonHelpers::GetOptionalString(Request.JsonBody, TEXT("mode"), TEXT("substring"));
+	if (Mode == TEXT("prefix"))
+	{
+		Search.Mode = EAssetSearchMode::Prefix;
+	}
+	else if (Mode == TEXT("fuzzy"))
+	{
+		Search.Mode = EAssetSearchMode::Fuzzy;
+	}
+	else if (Mode != TEXT("substring"))
+	{
+		return FRESTResponse::BadRequest(FString::Printf(TEXT("Unknown mode: %s. Use substring, prefix or fuzzy."), *Mode));
+	}
 
-	FString Type = JsonHelpers::GetOptionalString(Request.JsonBody, TEXT("type"), TEXT(""));
-	int32 Limit = JsonHelpers::GetOptionalInt(Request.JsonBody, TEXT("limit"), 100);
+	// Simple class names match the class asset name; full class paths go through a compiled FARFilter
+	FARFilter Filter;
+	const FString Type = JsonHelpers::GetOptionalString(Request.JsonBody, TEXT("type"), TEXT(""));
+	if (Type.StartsWith(TEXT("/")))
+	{
+		const FTopLevelAssetPath ClassPath(Type);
+		if (!ClassPath.IsValid())
+		{
+			return FRESTResponse::BadRequest(FString::Printf(TEXT("Invalid asset type: %s"), *Type));
+		}
+		Filter.ClassPaths.Add(ClassPath);
+		Filter.bRecursiveClasses = JsonHelpers::GetOptionalBool(Request.JsonBody, TEXT("recursive_classes"), false);
 
-	// Search by name pattern
-	TArray<FAssetData> AllAssets;
-	AssetRegistry.GetAllAssets(AllAssets);
+		FARCompiledFilter CompiledFilter;
+		AssetRegistry.CompileFilter(Filter, CompiledFilter);
+		Search.ClassPaths = MoveTemp(CompiledFilter.ClassPaths);
+	}
+	else if (!Type.IsEmpty())
+	{
+		Search.ClassName = FName(*Type);
+	}
 
-	TArray<FAssetData> Matches;
-	for (const FAssetData& Asset : AllAssets)
+	FAssetSearchResult Result;
+	const bool bIndexed = FAssetSearchIndex::Search(Search, Result);
+	if (!bIndexed)
 	{
-		if (Asset.AssetName.ToString().Contains(Query))
+		// Index still building: scan the registry once, with the class and path filters applied by the registry
+		if (!Search.PathPrefix.IsEmpty())
+		{
+			Filter.PackagePaths.Add(FName(*Search.PathPrefix));
+			Filter.bRecursivePaths = true;
+		}
+
+		const bool bPrefix = Search.Mode == EAssetSearchMode::Prefix;
+		int32 MatchIndex = 0;
+		auto Visit = [&](const FAssetData& Asset)
 		{
-			if (Type.IsEmpty() || Asset.AssetClassPath.GetAssetName().ToString() == Type)
+			if (!Search.ClassName.IsNone() && Asset.AssetClassPath.GetAssetName() != Search.ClassName)
 			{
-				Matches.Add(Asset);
-				if (Matches.Num() >= Limit)
-				{
-					break;
-				}
+				return true;
 			}
+
+			TStringBuilder<FName::StringBufferSize> Name;
+			Asset.AssetName.AppendString(Name);
+			const bool bMatches = bPrefix
+				? Name.ToView().StartsWith(Query, ESearchCase::IgnoreCase)
+				: UE::String::FindFirst(Name.ToView(), Query, ESearchCase::IgnoreCase) != INDEX_NONE;
+			if (!bMatches)
+			{
+				return true;
+			}
+
+			const int32 Index = MatchIndex++;
+			if (ListQuery.IsAfterPage(Index))
+			{
+				// One match past the page is enough to know there is another
+				Result.bHasMore = true;
+				return false;
+			}
+			if (!ListQuery.IsBeforePage(Index))
+			{
+				Result.Assets.Add(Asset);
+			}
+			return true;
+		};
+
+		if (Filter.IsEmpty())
+		{
+			AssetRegistry.EnumerateAllAssets(Visit, Filter.bIncludeOnlyOnDiskAssets);
+		}
+		else
+		{
+			AssetRegistry.EnumerateAssets(Filter, Visit);
 		}
 	}
 
-	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
-	Response->SetBoolField(TEXT("success"), true);
-	Response->SetNumberField(TEXT("count"), Matches.Num());
+	FRESTJsonWriter Writer;
+	ListQuery.BeginList(Writer, TEXT("assets"));
 
-	TArray<TSharedPtr<FJsonValue>> AssetsArray;
-	for (const FAssetData& Asset : Matches)
+	for (const FAssetData& Asset : Result.Assets)
 	{
-		AssetsArray.Add(MakeShared<FJsonValueObject>(AssetDataToJson(Asset)));
+		ListQuery.BeginItem(Writer);
+		WriteAssetData(Writer, Asset, ListQuery.GetFields());
+		ListQuery.EndItem(Writer);
 	}
-	Response->SetArrayField(TEXT("assets"), AssetsArray);
 
-	return FRESTResponse::Ok(Response);
+	const int32 Count = Result.Assets.Num();
+	return ListQuery.Finish(Writer, Result.bHasMore, [Count, bIndexed](FRESTJsonWriter& Trailer)
+	{
+		Trailer.WriteValue(TEXT("count"), Count);
+		Trailer.WriteValue(TEXT("indexed"), bIndexed);
+	});
 }
 
 FRESTResponse FAssetsHandler::HandleInfo(const FRESTRequest& Request)
@@ -194,8 +299,7 @@ FRESTResponse FAssetsHandler::HandleInfo(const FRESTRequest& Request)
 		return FRESTResponse::BadRequest(TEXT("Missing required query parameter: path"));
 	}
 
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
 
 	FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(*PathPtr));
 
@@ -224,8 +328,7 @@ FRESTResponse FAssetsHandler::HandleRefs(const FRESTRequest& Request)
 		return FRESTResponse::BadRequest(TEXT("Missing required query parameter: path"));
 	}
 
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
 
 	// Use FName-based API which is more stable across UE versions
 	FName PackageName(**PathPtr);
@@ -256,6 +359,302 @@ FRESTResponse FAssetsHandler::HandleRefs(const FRESTRequest& Request)
 	return FRESTResponse::Ok(Response);
 }
 
+FRESTResponse FAssetsHandler::HandleRefsGraph(const FRESTRequest& Request)
+{
+	const TArray<TSharedPtr<FJsonValue>>* RootsArray = nullptr;
+	if (!Request.JsonBody.IsValid() || !Request.JsonBody->TryGetArrayField(TEXT("roots"), RootsArray) || RootsArray->Num() == 0)
+	{
+		return FRESTResponse::BadRequest(TEXT("Missing required field: roots (array of package or object paths)"));
+	}
+
+	// 0 = unlimited
+	const int32 MaxDepth = JsonHelpers::GetOptionalInt(Request.JsonBody, TEXT("depth"), 1);
+	const int32 MaxNodes = FMath::Max(1, JsonHelpers::GetOptionalInt(Request.JsonBody, TEXT("max_nodes"), 100000));
+	const bool bIncludeScript = JsonHelpers::GetOptionalBool(Request.JsonBody, TEXT("include_script"), false);
+	const bool bOutputFile = JsonHelpers::GetOptionalBool(Request.JsonBody, TEXT("output_file"), false);
+
+	const FString Direction = JsonHelpers::GetOptionalString(Request.JsonBody, TEXT("direction"), TEXT("dependencies"));
+	const bool bDependencies = Direction == TEXT("dependencies") || Direction == TEXT("both");
+	const bool bReferencers = Direction == TEXT("referencers") || Direction == TEXT("both");
+	if (!bDependencies && !bReferencers)
+	{
+		return FRESTResponse::BadRequest(FString::Printf(TEXT("Unknown direction: %s. Use dependencies, referencers or both."), *Direction));
+	}
+
+	// Dependency categories (package, manage, searchable) and query flags (hard, soft, game, editor_only)
+	UE::AssetRegistry::EDependencyCategory Categories = UE::AssetRegistry::EDependencyCategory::None;
+	const TArray<TSharedPtr<FJsonValue>>* CategoriesArray = nullptr;
+	if (Request.JsonBody->TryGetArrayField(TEXT("categories"), CategoriesArray))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *CategoriesArray)
+		{
+			const FString Category = Value->AsString();
+			if (Category == TEXT("package"))
+			{
+				Categories |= UE::AssetRegistry::EDependencyCategory::Package;
+			}
+			else if (Category == TEXT("manage"))
+			{
+				Categories |= UE::AssetRegistry::EDependencyCategory::Manage;
+			}
+			else if (Category == TEXT("searchable"))
+			{
+				Categories |= UE::AssetRegistry::EDependencyCategory::SearchableName;
+			}
+			else
+			{
+				return FRESTResponse::BadRequest(FString::Printf(TEXT("Unknown category: %s. Use package, manage or searchable."), *Category));
+			}
+		}
+	}
+	if (Categories == UE::AssetRegistry::EDependencyCategory::None)
+	{
+		Categories = UE::AssetRegistry::EDependencyCategory::Package;
+	}
+
+	UE::AssetRegistry::EDependencyQuery QueryFlags = UE::AssetRegistry::EDependencyQuery::NoRequirements;
+	const TArray<TSharedPtr<FJsonValue>>* FlagsArray = nullptr;
+	if (Request.JsonBody->TryGetArrayField(TEXT("flags"), FlagsArray))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *FlagsArray)
+		{
+			const FString Flag = Value->AsString();
+			if (Flag == TEXT("hard"))
+			{
+				QueryFlags |= UE::AssetRegistry::EDependencyQuery::Hard;
+			}
+			else if (Flag == TEXT("soft"))
+			{
+				QueryFlags |= UE::AssetRegistry::EDependencyQuery::Soft;
+			}
+			else if (Flag == TEXT("game"))
+			{
+				QueryFlags |= UE::AssetRegistry::EDependencyQuery::Game;
+			}
+			else if (Flag == TEXT("editor_only"))
+			{
+				QueryFlags |= UE::AssetRegistry::EDependencyQuery::EditorOnly;
+			}
+			else
+			{
+				return FRESTResponse::BadRequest(FString::Printf(TEXT("Unknown flag: %s. Use hard, soft, game or editor_only."), *Flag));
+			}
+		}
+	}
+	const UE::AssetRegistry::FDependencyQuery DependencyQuery(QueryFlags);
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	// Package names interned to ids; per-node adjacency lists hold ids, so every name is written once
+	TArray<FName> Nodes;
+	TMap<FName, int32> NodeIds;
+	TArray<int32> NodeDepths;
+	TArray<TArray<int32>> DependencyEdges;
+	TArray<TArray<int32>> ReferencerEdges;
+	TArray<int32> RootIds;
+	TArray<FString> MissingRoots;
+	bool bTruncated = false;
+
+	auto AddNode = [&](FName PackageName, int32 Depth) -> int32
+	{
+		if (const int32* Existing = NodeIds.Find(PackageName))
+		{
+			return *Existing;
+		}
+		if (Nodes.Num() >= MaxNodes)
+		{
+			bTruncated = true;
+			return INDEX_NONE;
+		}
+
+		const int32 Id = Nodes.Add(PackageName);
+		NodeIds.Add(PackageName, Id);
+		NodeDepths.Add(Depth);
+		DependencyEdges.AddDefaulted();
+		ReferencerEdges.AddDefaulted();
+		return Id;
+	};
+
+	for (const TSharedPtr<FJsonValue>& Value : *RootsArray)
+	{
+		FString Root = Value->AsString();
+		if (Root.Contains(TEXT(".")))
+		{
+			Root = FPackageName::ObjectPathToPackageName(Root);
+		}
+
+		const FName PackageName(*Root);
+		TArray<FAssetData> PackageAssets;
+		if (Root.IsEmpty() || !AssetRegistry.GetAssetsByPackageName(PackageName, PackageAssets) || PackageAssets.Num() == 0)
+		{
+			MissingRoots.Add(Value->AsString());
+			continue;
+		}
+
+		const int32 Id = AddNode(PackageName, 0);
+		if (Id != INDEX_NONE)
+		{
+			RootIds.AddUnique(Id);
+		}
+	}
+
+	// Breadth-first: ids are assigned in discovery order, so the node array doubles as the queue
+	TArray<FName> Neighbors;
+	TArray<int32> Unexpanded;
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		const int32 Depth = NodeDepths[NodeIndex];
+		if (MaxDepth > 0 && Depth >= MaxDepth)
+		{
+			Unexpanded.Add(NodeIndex);
+			continue;
+		}
+
+		auto Expand = [&](bool bDependencyDirection)
+		{
+			Neighbors.Reset();
+			if (bDependencyDirection)
+			{
+				AssetRegistry.GetDependencies(Nodes[NodeIndex], Neighbors, Categories, DependencyQuery);
+			}
+			else
+			{
+				AssetRegistry.GetReferencers(Nodes[NodeIndex], Neighbors, Categories, DependencyQuery);
+			}
+
+			for (const FName Neighbor : Neighbors)
+			{
+				if (!bIncludeScript)
+				{
+					TStringBuilder<FName::StringBufferSize> NeighborName;
+					Neighbor.AppendString(NeighborName);
+					if (FPackageName::IsScriptPackage(NeighborName.ToView()))
+					{
+						continue;
+					}
+				}
+
+				const int32 NeighborId = AddNode(Neighbor, Depth + 1);
+				if (NeighborId != INDEX_NONE)
+				{
+					// Nodes may grow inside AddNode, so index the edge arrays afresh each time
+					(bDependencyDirection ? DependencyEdges : ReferencerEdges)[NodeIndex].Add(NeighborId);
+				}
+			}
+		};
+
+		if (bDependencies)
+		{
+			Expand(true);
+		}
+		if (bReferencers)
+		{
+			Expand(false);
+		}
+	}
+
+	int32 EdgeCount = 0;
+	auto WriteAdjacency = [&EdgeCount](FRESTJsonWriter& Writer, const TCHAR* Name, const TArray<TArray<int32>>& Edges)
+	{
+		Writer.WriteArrayStart(Name);
+		for (const TArray<int32>& List : Edges)
+		{
+			Writer.WriteArrayStart();
+			for (const int32 Id : List)
+			{
+				Writer.WriteValue(Id);
+			}
+			Writer.WriteArrayEnd();
+			EdgeCount += List.Num();
+		}
+		Writer.WriteArrayEnd();
+	};
+
+	auto WriteIds = [](FRESTJsonWriter& Writer, const TCHAR* Name, const TArray<int32>& Ids)
+	{
+		Writer.WriteArrayStart(Name);
+		for (const int32 Id : Ids)
+		{
+			Writer.WriteValue(Id);
+		}
+		Writer.WriteArrayEnd();
+	};
+
+	auto WriteMissingRoots = [&MissingRoots](FRESTJsonWriter& Writer)
+	{
+		Writer.WriteArrayStart(TEXT("missing_roots"));
+		for (const FString& Root : MissingRoots)
+		{
+			Writer.WriteValue(Root);
+		}
+		Writer.WriteArrayEnd();
+	};
+
+	FRESTJsonWriter Graph;
+	if (bOutputFile)
+	{
+		// The saved file is always JSON, whatever the client negotiated for the response
+		Graph.SetFormat(ERESTWireFormat::Json);
+	}
+	Graph.WriteObjectStart();
+	Graph.WriteValue(TEXT("success"), true);
+	Graph.WriteValue(TEXT("direction"), Direction);
+	Graph.WriteValue(TEXT("depth"), MaxDepth);
+	Graph.WriteArrayStart(TEXT("nodes"));
+	for (const FName Node : Nodes)
+	{
+		Graph.WriteValue(Node);
+	}
+	Graph.WriteArrayEnd();
+	WriteIds(Graph, TEXT("roots"), RootIds);
+	if (bDependencies)
+	{
+		WriteAdjacency(Graph, TEXT("dependencies"), DependencyEdges);
+	}
+	if (bReferencers)
+	{
+		WriteAdjacency(Graph, TEXT("referencers"), ReferencerEdges);
+	}
+	WriteIds(Graph, TEXT("unexpanded"), Unexpanded);
+	WriteMissingRoots(Graph);
+	Graph.WriteValue(TEXT("node_count"), Nodes.Num());
+	Graph.WriteValue(TEXT("edge_count"), EdgeCount);
+	Graph.WriteValue(TEXT("truncated"), bTruncated);
+	Graph.WriteObjectEnd();
+
+	UE_LOG(LogTemp, Log, TEXT("AssetsHandler: Reference graph from %d roots: %d nodes, %d edges%s"),
+		RootIds.Num(), Nodes.Num(), EdgeCount, bTruncated ? TEXT(" (truncated)") : TEXT(""));
+
+	if (!bOutputFile)
+	{
+		return FRESTResponse::Stream(Graph);
+	}
+
+	// Large graphs: write the full document to disk and return only the summary
+	const FString Dir = FPaths::ProjectSavedDir() / TEXT("UnrealPythonREST") / TEXT("RefGraphs");
+	const FString FilePath = FPaths::ConvertRelativePathToFull(Dir / FString::Printf(TEXT("refs_%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S_%s"))));
+
+	IFileManager::Get().MakeDirectory(*Dir, true);
+	if (!FFileHelper::SaveArrayToFile(Graph.GetBuffer()->Bytes, *FilePath))
+	{
+		return FRESTResponse::Error(500, TEXT("WRITE_FAILED"), FString::Printf(TEXT("Failed to write reference graph to %s"), *FilePath));
+	}
+
+	FRESTJsonWriter Summary;
+	Summary.WriteObjectStart();
+	Summary.WriteValue(TEXT("success"), true);
+	Summary.WriteValue(TEXT("output_file"), FilePath);
+	Summary.WriteValue(TEXT("bytes"), Graph.GetSize());
+	WriteIds(Summary, TEXT("roots"), RootIds);
+	WriteMissingRoots(Summary);
+	Summary.WriteValue(TEXT("node_count"), Nodes.Num());
+	Summary.WriteValue(TEXT("edge_count"), EdgeCount);
+	Summary.WriteValue(TEXT("truncated"), bTruncated);
+	Summary.WriteObjectEnd();
+
+	return FRESTResponse::Stream(Summary);
+}
+
 FRESTResponse FAssetsHandler::HandleExport(const FRESTRequest& Request)
 {
 	FString Path;
@@ -273,14 +672,9 @@ FRESTResponse FAssetsHandler::HandleExport(const FRESTRequest& Request)
 			FString::Printf(TEXT("Asset not found: %s"), *Path));
 	}
 
-	// Export to text using ExportToOutputDevice
-	FStringOutputDevice Output;
-	UExporter::ExportToOutputDevice(nullptr, Asset, nullptr, Output, TEXT("copy"), 0, PPF_ExportsNotFullyQualified);
-
-	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+	TSharedPtr<FJsonObject> Response = FAssetBulkInspector::ExportToJson(Asset);
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetStringField(TEXT("path"), Path);
-	Response->SetStringField(TEXT("exported_text"), *Output);
 
 	return FRESTResponse::Ok(Response);
 }
@@ -302,21 +696,10 @@ FRESTResponse FAssetsHandler::HandleValidate(const FRESTRequest& Request)
 			FString::Printf(TEXT("Asset not found: %s"), *Path));
 	}
 
-	TArray<FString> Errors;
-	bool bValid = Asset->IsAsset(); // Basic validation
-
-	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+	TSharedPtr<FJsonObject> Response = FAssetBulkInspector::ValidateToJson(Asset);
 	Response->SetBoolField(TEXT("success"), true);
-	Response->SetBoolField(TEXT("valid"), bValid && Errors.Num() == 0);
 	Response->SetStringField(TEXT("path"), Path);
 
-	TArray<TSharedPtr<FJsonValue>> ErrorsArray;
-	for (const FString& Err : Errors)
-	{
-		ErrorsArray.Add(MakeShared<FJsonValueString>(Err));
-	}
-	Response->SetArrayField(TEXT("errors"), ErrorsArray);
-
 	return FRESTResponse::Ok(Response);
 }
 
@@ -339,38 +722,175 @@ FRESTResponse FAssetsHandler::HandleMeshDetails(const FRESTRequest& Request)
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetStringField(TEXT("path"), *PathPtr);
 
-	// Mesh info
-	TSharedPtr<FJsonObject> MeshInfo = MakeShared<FJsonObject>();
-	MeshInfo->SetNumberField(TEXT("lod_count"), Mesh->GetNumLODs());
+	Response->SetObjectField(TEXT("mesh"), FAssetBulkInspector::MeshDetailsToJson(Mesh));
+
+	return FRESTResponse::Ok(Response);
+}
+
+FRESTResponse FAssetsHandler::HandleBulk(const FRESTRequest& Request)
+{
+	if (!Request.JsonBody.IsValid())
+	{
+		return FRESTResponse::BadRequest(TEXT("Missing JSON body"));
+	}
+
+	FString OperationName;
+	FString Error;
+	if (!JsonHelpers::GetRequiredString(Request.JsonBody, TEXT("operation"), OperationName, Error))
+	{
+		return FRESTResponse::BadRequest(Error);
+	}
+
+	FAssetBulkInspector::FOptions Options;
+	if (!FAssetBulkInspector::ParseOperation(OperationName, Options.Operation))
+	{
+		return FRESTResponse::BadRequest(FString::Printf(TEXT("Unknown operation: %s. Use mesh_details, validate, export or recompile_material."), *OperationName));
+	}
+
+	const FString LoadName = JsonHelpers::GetOptionalString(Request.JsonBody, TEXT("load"), TEXT("auto"));
+	if (!FAssetBulkInspector::ParseLoadPolicy(LoadName, Options.Load))
+	{
+		return FRESTResponse::BadRequest(FString::Printf(TEXT("Unknown load policy: %s. Use auto, never or always."), *LoadName));
+	}
+	Options.MaxInFlight = JsonHelpers::GetOptionalInt(Request.JsonBody, TEXT("max_in_flight"), Options.MaxInFlight);
+	Options.GCBatchSize = FMath::Max(0, JsonHelpers::GetOptionalInt(Request.JsonBody, TEXT("gc_batch_size"), Options.GCBatchSize));
 
-	// Bounds (in centimeters)
-	FBoxSphereBounds Bounds = Mesh->GetBounds();
-	MeshInfo->SetObjectField(TEXT("bounds_origin"), JsonHelpers::VectorToJson(Bounds.Origin));
-	MeshInfo->SetObjectField(TEXT("bounds_extent"), JsonHelpers::VectorToJson(Bounds.BoxExtent));
-	MeshInfo->SetNumberField(TEXT("bounds_radius"), Bounds.SphereRadius);
+	// Explicit paths, then whatever the filter matches
+	TArray<FSoftObjectPath> Paths;
+	const TArray<TSharedPtr<FJsonValue>>* PathsArray = nullptr;
+	if (Request.JsonBody->TryGetArrayField(TEXT("paths"), PathsArray))
+	{
+		Paths.Reserve(PathsArray->Num());
+		for (const TSharedPtr<FJsonValue>& Value : *PathsArray)
+		{
+			Paths.Emplace(Value.IsValid() ? Value->AsString() : FString());
+		}
+	}
 
-	// LOD details
-	TArray<TSharedPtr<FJsonValue>> LODArray;
-	for (int32 LODIndex = 0; LODIndex < Mesh->GetNumLODs(); ++LODIndex)
+	const TSharedPtr<FJsonObject>* FilterJson = nullptr;
+	if (Request.JsonBody->TryGetObjectField(TEXT("filter"), FilterJson))
 	{
-		TSharedPtr<FJsonObject> LODInfo = MakeShared<FJsonObject>();
-		LODInfo->SetNumberField(TEXT("index"), LODIndex);
+		FARFilter Filter;
+		Filter.bRecursivePaths = JsonHelpers::GetOptionalBool(*FilterJson, TEXT("recursive_paths"), true);
+		Filter.bRecursiveClasses = JsonHelpers::GetOptionalBool(*FilterJson, TEXT("recursive_classes"), false);
+
+		const TArray<TSharedPtr<FJsonValue>>* PackagePaths = nullptr;
+		if ((*FilterJson)->TryGetArrayField(TEXT("package_paths"), PackagePaths))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *PackagePaths)
+			{
+				Filter.PackagePaths.Add(FName(*Value->AsString()));
+			}
+		}
 
-		if (Mesh->GetRenderData() && Mesh->GetRenderData()->LODResources.IsValidIndex(LODIndex))
+		const TArray<TSharedPtr<FJsonValue>>* Classes = nullptr;
+		if ((*FilterJson)->TryGetArrayField(TEXT("classes"), Classes))
 		{
-			const FStaticMeshLODResources& LODResources = Mesh->GetRenderData()->LODResources[LODIndex];
-			LODInfo->SetNumberField(TEXT("vertices"), LODResources.GetNumVertices());
-			LODInfo->SetNumberField(TEXT("triangles"), LODResources.GetNumTriangles());
-			LODInfo->SetNumberField(TEXT("sections"), LODResources.Sections.Num());
+			for (const TSharedPtr<FJsonValue>& Value : *Classes)
+			{
+				const FTopLevelAssetPath ClassPath = ParseAssetClassPath(Value->AsString());
+				if (!ClassPath.IsValid())
+				{
+					return FRESTResponse::BadRequest(FString::Printf(TEXT("Invalid asset class: %s"), *Value->AsString()));
+				}
+				Filter.ClassPaths.Add(ClassPath);
+			}
 		}
 
-		LODArray.Add(MakeShared<FJsonValueObject>(LODInfo));
+		if (Filter.IsEmpty())
+		{
+			return FRESTResponse::BadRequest(TEXT("filter needs package_paths or classes"));
+		}
+
+		TArray<FAssetData> Assets;
+		IAssetRegistry::GetChecked().GetAssets(Filter, Assets);
+		Paths.Reserve(Paths.Num() + Assets.Num());
+		for (const FAssetData& AssetData : Assets)
+		{
+			Paths.Emplace(AssetData.GetObjectPathString());
+		}
 	}
-	MeshInfo->SetArrayField(TEXT("lods"), LODArray);
 
-	Response->SetObjectField(TEXT("mesh"), MeshInfo);
+	if (!PathsArray && !FilterJson)
+	{
+		return FRESTResponse::BadRequest(TEXT("Missing required field: paths (array of object paths) or filter"));
+	}
+	if (Paths.Num() > FAssetBulkInspector::MaxPathsPerJob)
+	{
+		return FRESTResponse::Error(400, TEXT("TOO_MANY_ASSETS"),
+			FString::Printf(TEXT("%d assets requested; one job takes at most %d"), Paths.Num(), FAssetBulkInspector::MaxPathsPerJob));
+	}
 
-	return FRESTResponse::Ok(Response);
+	TSharedPtr<const FAssetBulkInspector::FJob> Job = FAssetBulkInspector::Start(Paths, Options, Error);
+	if (!Job.IsValid())
+	{
+		FRESTResponse Response = FRESTResponse::Error(503, TEXT("TOO_MANY_JOBS"), Error);
+		Response.Headers.Add(TEXT("Retry-After"), TEXT("1"));
+		return Response;
+	}
+
+	const bool bRunning = Job->Status == FAssetBulkInspector::EJobStatus::Running;
+
+	FRESTJsonWriter Writer;
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("success"), true);
+	Job->WriteSummary(Writer);
+	Writer.WriteObjectEnd();
+	return FRESTResponse::Stream(Writer, bRunning ? 202 : 200);
+}
+
+// GET /assets/bulk/{id} - Job status and results from ?since=<n>, in completion order
+FRESTResponse FAssetsHandler::HandleGetBulkJob(const FRESTRequest& Request, const FString& JobId)
+{
+	TSharedPtr<const FAssetBulkInspector::FJob> Job = FAssetBulkInspector::FindJob(JobId);
+	if (!Job.IsValid())
+	{
+		return FRESTResponse::Error(404, TEXT("JOB_NOT_FOUND"),
+			FString::Printf(TEXT("Bulk job not found: %s"), *JobId));
+	}
+
+	const FString* SincePtr = Request.QueryParams.Find(TEXT("since"));
+	const FString* LimitPtr = Request.QueryParams.Find(TEXT("limit"));
+	const int32 Since = FMath::Clamp(SincePtr ? FCString::Atoi(**SincePtr) : 0, 0, Job->Results.Num());
+	const int32 Limit = FMath::Clamp(LimitPtr ? FCString::Atoi(**LimitPtr) : 1000, 1, MaxBulkResultsPerPage);
+	const int32 End = FMath::Min(Job->Results.Num(), Since + Limit);
+
+	FRESTJsonWriter Writer;
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("success"), true);
+	Job->WriteSummary(Writer);
+
+	Writer.WriteArrayStart(TEXT("results"));
+	for (int32 Index = Since; Index < End; ++Index)
+	{
+		FAssetBulkInspector::FJob::WriteResult(Writer, Job->Results[Index]);
+	}
+	Writer.WriteArrayEnd();
+
+	// Poll again from "next" until "complete" is true
+	Writer.WriteValue(TEXT("next"), End);
+	Writer.WriteValue(TEXT("complete"), Job->Status != FAssetBulkInspector::EJobStatus::Running && End == Job->Results.Num());
+	Writer.WriteObjectEnd();
+	return FRESTResponse::Stream(Writer);
+}
+
+// DELETE /assets/bulk/{id} - Cancel a running job, keeping its results so far
+FRESTResponse FAssetsHandler::HandleCancelBulkJob(const FRESTRequest& Request, const FString& JobId)
+{
+	if (!FAssetBulkInspector::Cancel(JobId))
+	{
+		return FRESTResponse::Error(404, TEXT("JOB_NOT_FOUND"),
+			FString::Printf(TEXT("No running bulk job: %s"), *JobId));
+	}
+
+	TSharedPtr<const FAssetBulkInspector::FJob> Job = FAssetBulkInspector::FindJob(JobId);
+
+	FRESTJsonWriter Writer;
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("success"), true);
+	Job->WriteSummary(Writer);
+	Writer.WriteObjectEnd();
+	return FRESTResponse::Stream(Writer);
 }
 
 TSharedPtr<FJsonObject> FAssetsHandler::AssetDataToJson(const FAssetData& AssetData)
@@ -383,6 +903,29 @@ TSharedPtr<FJsonObject> FAssetsHandler::AssetDataToJson(const FAssetData& AssetD
 	return Json;
 }
 
+void FAssetsHandler::WriteAssetData(FRESTJsonWriter& Writer, const FAssetData& AssetData, const FRESTFieldFilter& Fields)
+{
+	// Same fields as AssetDataToJson, written without the intermediate strings
+	if (Fields.Wants(TEXT("name")))
+	{
+		Writer.WriteValue(TEXT("name"), AssetData.AssetName);
+	}
+	if (Fields.Wants(TEXT("path")))
+	{
+		TStringBuilder<FName::StringBufferSize> ObjectPath;
+		AssetData.AppendObjectPath(ObjectPath);
+		Writer.WriteValue(TEXT("path"), ObjectPath.ToView());
+	}
+	if (Fields.Wants(TEXT("class")))
+	{
+		Writer.WriteValue(TEXT("class"), AssetData.AssetClassPath.GetAssetName());
+	}
+	if (Fields.Wants(TEXT("package")))
+	{
+		Writer.WriteValue(TEXT("package"), AssetData.PackageName);
+	}
+}
+
 TArray<TSharedPtr<FJsonObject>> FAssetsHandler::GetEndpointSchemas() const
 {
 	TArray<TSharedPtr<FJsonObject>> Schemas;
@@ -414,9 +957,11 @@ TArray<TSharedPtr<FJsonObject>> FAssetsHandler::GetEndpointSchemas() const
 		LimitParam->SetStringField(TEXT("type"), TEXT("integer"));
 		LimitParam->SetBoolField(TEXT("required"), false);
 		LimitParam->SetStringField(TEXT("default"), TEXT("1000"));
-		LimitParam->SetStringField(TEXT("description"), TEXT("Maximum number of assets to return (hard limit: 10000)"));
+		LimitParam->SetStringField(TEXT("description"), TEXT("Assets per page (max: 10000)"));
 		Params->SetObjectField(TEXT("limit"), LimitParam);
 
+		FRESTListQuery::DescribeParameters(Params);
+
 		Endpoint->SetObjectField(TEXT("parameters"), Params);
 
 		TArray<TSharedPtr<FJsonValue>> Errors;
@@ -438,23 +983,39 @@ TArray<TSharedPtr<FJsonObject>> FAssetsHandler::GetEndpointSchemas() const
 		TSharedPtr<FJsonObject> QueryParam = MakeShared<FJsonObject>();
 		QueryParam->SetStringField(TEXT("type"), TEXT("string"));
 		QueryParam->SetBoolField(TEXT("required"), true);
-		QueryParam->SetStringField(TEXT("description"), TEXT("Search string to match against asset names (case-sensitive contains)"));
+		QueryParam->SetStringField(TEXT("description"), TEXT("Search string to match against asset names (case-insensitive)"));
 		Params->SetObjectField(TEXT("query"), QueryParam);
 
+		TSharedPtr<FJsonObject> ModeParam = MakeShared<FJsonObject>();
+		ModeParam->SetStringField(TEXT("type"), TEXT("string"));
+		ModeParam->SetBoolField(TEXT("required"), false);
+		ModeParam->SetStringField(TEXT("default"), TEXT("substring"));
+		ModeParam->SetStringField(TEXT("description"), TEXT("substring, prefix, or fuzzy (ranked by similarity)"));
+		Params->SetObjectField(TEXT("mode"), ModeParam);
+
+		TSharedPtr<FJsonObject> PathParam = MakeShared<FJsonObject>();
+		PathParam->SetStringField(TEXT("type"), TEXT("string"));
+		PathParam->SetBoolField(TEXT("required"), false);
+		PathParam->SetStringField(TEXT("default"), TEXT(""));
+		PathParam->SetStringField(TEXT("description"), TEXT("Only assets under this content path (e.g., /Game/Props)"));
+		Params->SetObjectField(TEXT("path"), PathParam);
+
 		TSharedPtr<FJsonObject> TypeParam = MakeShared<FJsonObject>();
 		TypeParam->SetStringField(TEXT("type"), TEXT("string"));
 		TypeParam->SetBoolField(TEXT("required"), false);
 		TypeParam->SetStringField(TEXT("default"), TEXT(""));
-		TypeParam->SetStringField(TEXT("description"), TEXT("Filter by asset class name"));
+		TypeParam->SetStringField(TEXT("description"), TEXT("Filter by asset class name (e.g., Material) or full class path (e.g., /Script/Engine.MaterialInterface)"));
 		Params->SetObjectField(TEXT("type"), TypeParam);
 
 		TSharedPtr<FJsonObject> LimitParam = MakeShared<FJsonObject>();
 		LimitParam->SetStringField(TEXT("type"), TEXT("integer"));
 		LimitParam->SetBoolField(TEXT("required"), false);
 		LimitParam->SetStringField(TEXT("default"), TEXT("100"));
-		LimitParam->SetStringField(TEXT("description"), TEXT("Maximum number of results to return"));
+		LimitParam->SetStringField(TEXT("description"), TEXT("Results per page (max: 10000)"));
 		Params->SetObjectField(TEXT("limit"), LimitParam);
 
+		FRESTListQuery::DescribeParameters(Params);
+
 		Endpoint->SetObjectField(TEXT("parameters"), Params);
 
 		TArray<TSharedPtr<FJsonValue>> Errors;
@@ -513,6 +1074,46 @@ TArray<TSharedPtr<FJsonObject>> FAssetsHandler::GetEndpointSchemas() const
 		Schemas.Add(Endpoint);
 	}
 
+	// POST /assets/refs/graph
+	{
+		TSharedPtr<FJsonObject> Endpoint = MakeShared<FJsonObject>();
+		Endpoint->SetStringField(TEXT("method"), TEXT("POST"));
+		Endpoint->SetStringField(TEXT("path"), TEXT("/assets/refs/graph"));
+		Endpoint->SetStringField(TEXT("description"), TEXT("Walk dependencies and/or referencers from many roots; returns interned node names and adjacency lists"));
+
+		TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+		auto AddParam = [&Params](const TCHAR* Name, const TCHAR* Type, bool bRequired, const TCHAR* Default, const TCHAR* Description)
+		{
+			TSharedPtr<FJsonObject> Param = MakeShared<FJsonObject>();
+			Param->SetStringField(TEXT("type"), Type);
+			Param->SetBoolField(TEXT("required"), bRequired);
+			if (Default)
+			{
+				Param->SetStringField(TEXT("default"), Default);
+			}
+			Param->SetStringField(TEXT("description"), Description);
+			Params->SetObjectField(Name, Param);
+		};
+
+		AddParam(TEXT("roots"), TEXT("array"), true, nullptr, TEXT("Package or object paths to start from"));
+		AddParam(TEXT("depth"), TEXT("integer"), false, TEXT("1"), TEXT("Hops from the roots; 0 for unlimited"));
+		AddParam(TEXT("direction"), TEXT("string"), false, TEXT("dependencies"), TEXT("dependencies, referencers or both"));
+		AddParam(TEXT("categories"), TEXT("array"), false, TEXT("[\"package\"]"), TEXT("Dependency categories: package, manage, searchable"));
+		AddParam(TEXT("flags"), TEXT("array"), false, TEXT("[]"), TEXT("Dependency query flags: hard, soft, game, editor_only"));
+		AddParam(TEXT("include_script"), TEXT("boolean"), false, TEXT("false"), TEXT("Include /Script/ native packages"));
+		AddParam(TEXT("max_nodes"), TEXT("integer"), false, TEXT("100000"), TEXT("Stop adding nodes past this count (sets truncated)"));
+		AddParam(TEXT("output_file"), TEXT("boolean"), false, TEXT("false"), TEXT("Write the graph to Saved/UnrealPythonREST/RefGraphs and return only a summary"));
+
+		Endpoint->SetObjectField(TEXT("parameters"), Params);
+
+		TArray<TSharedPtr<FJsonValue>> Errors;
+		Errors.Add(MakeShared<FJsonValueString>(TEXT("INVALID_PARAMS")));
+		Errors.Add(MakeShared<FJsonValueString>(TEXT("WRITE_FAILED")));
+		Endpoint->SetArrayField(TEXT("errors"), Errors);
+
+		Schemas.Add(Endpoint);
+	}
+
 	// POST /assets/export
 	{
 		TSharedPtr<FJsonObject> Endpoint = MakeShared<FJsonObject>();
@@ -588,5 +1189,80 @@ TArray<TSharedPtr<FJsonObject>> FAssetsHandler::GetEndpointSchemas() const
 		Schemas.Add(Endpoint);
 	}
 
+	// POST /assets/bulk
+	{
+		TSharedPtr<FJsonObject> Endpoint = MakeShared<FJsonObject>();
+		Endpoint->SetStringField(TEXT("method"), TEXT("POST"));
+		Endpoint->SetStringField(TEXT("path"), TEXT("/assets/bulk"));
+		Endpoint->SetStringField(TEXT("description"), TEXT("Start a bulk mesh_details, validate, export or recompile_material job over many assets; answers from registry tags where possible and async-loads the rest"));
+
+		TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+		auto AddParam = [&Params](const TCHAR* Name, const TCHAR* Type, bool bRequired, const TCHAR* Description)
+		{
+			TSharedPtr<FJsonObject> Param = MakeShared<FJsonObject>();
+			Param->SetStringField(TEXT("type"), Type);
+			Param->SetBoolField(TEXT("required"), bRequired);
+			Param->SetStringField(TEXT("description"), Description);
+			Params->SetObjectField(Name, Param);
+		};
+		AddParam(TEXT("operation"), TEXT("string"), true, TEXT("mesh_details, validate, export or recompile_material"));
+		AddParam(TEXT("paths"), TEXT("array"), false, TEXT("Object paths to process"));
+		AddParam(TEXT("filter"), TEXT("object"), false, TEXT("Asset registry filter: package_paths, classes, recursive_paths (default true), recursive_classes"));
+		AddParam(TEXT("load"), TEXT("string"), false, TEXT("auto (default): registry tags when they suffice; never: registry only; always: load every asset"));
+		AddParam(TEXT("max_in_flight"), TEXT("integer"), false, TEXT("Async loads outstanding at once, 1-64 (default 16)"));
+		AddParam(TEXT("gc_batch_size"), TEXT("integer"), false, TEXT("Loads between garbage collection requests (default 256, 0 = never)"));
+		Endpoint->SetObjectField(TEXT("parameters"), Params);
+
+		TArray<TSharedPtr<FJsonValue>> Errors;
+		Errors.Add(MakeShared<FJsonValueString>(TEXT("INVALID_PARAMS")));
+		Errors.Add(MakeShared<FJsonValueString>(TEXT("TOO_MANY_ASSETS")));
+		Errors.Add(MakeShared<FJsonValueString>(TEXT("TOO_MANY_JOBS")));
+		Endpoint->SetArrayField(TEXT("errors"), Errors);
+
+		Schemas.Add(Endpoint);
+	}
+
+	// GET /assets/bulk/{id}
+	{
+		TSharedPtr<FJsonObject> Endpoint = MakeShared<FJsonObject>();
+		Endpoint->SetStringField(TEXT("method"), TEXT("GET"));
+		Endpoint->SetStringField(TEXT("path"), TEXT("/assets/bulk/{id}"));
+		Endpoint->SetStringField(TEXT("description"), TEXT("Bulk job status and results in completion order; poll with since=next until complete"));
+
+		TSharedPtr<FJsonObject> Params = MakeShared<FJsonObject>();
+		TSharedPtr<FJsonObject> SinceParam = MakeShared<FJsonObject>();
+		SinceParam->SetStringField(TEXT("type"), TEXT("integer"));
+		SinceParam->SetBoolField(TEXT("required"), false);
+		SinceParam->SetStringField(TEXT("description"), TEXT("First result to return (the previous response's next; default 0)"));
+		Params->SetObjectField(TEXT("since"), SinceParam);
+
+		TSharedPtr<FJsonObject> LimitParam = MakeShared<FJsonObject>();
+		LimitParam->SetStringField(TEXT("type"), TEXT("integer"));
+		LimitParam->SetBoolField(TEXT("required"), false);
+		LimitParam->SetStringField(TEXT("description"), TEXT("Results per response (default 1000, max 10000)"));
+		Params->SetObjectField(TEXT("limit"), LimitParam);
+		Endpoint->SetObjectField(TEXT("parameters"), Params);
+
+		TArray<TSharedPtr<FJsonValue>> Errors;
+		Errors.Add(MakeShared<FJsonValueString>(TEXT("JOB_NOT_FOUND")));
+		Endpoint->SetArrayField(TEXT("errors"), Errors);
+
+		Schemas.Add(Endpoint);
+	}
+
+	// DELETE /assets/bulk/{id}
+	{
+		TSharedPtr<FJsonObject> Endpoint = MakeShared<FJsonObject>();
+		Endpoint->SetStringField(TEXT("method"), TEXT("DELETE"));
+		Endpoint->SetStringField(TEXT("path"), TEXT("/assets/bulk/{id}"));
+		Endpoint->SetStringField(TEXT("description"), TEXT("Cancel a running bulk job; results so far are kept"));
+
+		TArray<TSharedPtr<FJsonValue>> Errors;
+		Errors.Add(MakeShared<FJsonValueString>(TEXT("JOB_NOT_FOUND")));
+		Endpoint->SetArrayField(TEXT("errors"), Errors);
+
+		Schemas.Add(Endpoint);
+	}
+
 	return Schemas;
 }
@@ -2,6 +2,11 @@
 
 #include "Handlers/BlueprintsHandler.h"
 #include "Utils/JsonHelpers.h"
+#include "Utils/EditCoalescer.h"
+#include "Utils/BlueprintSessionCache.h"
+#include "Utils/BlueprintCompileQueue.h"
+#include "Utils/EditorChangeTracker.h"
+#include "RESTJsonWriter.h"
 #include "Editor.h"
 #include "Subsystems/AssetEditorSubsystem.h"
 #include "Kismet2/BlueprintEditorUtils.h"
@@ -24,100 +29,126 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/KismetSystemLibrary.h"
 
+/**
+ * Notify the graph, mark the Blueprint modified and queue it for the next compile pass
+ * (once per graph/Blueprint inside a coalesced batch). Never compiles here.
+ */
+static void NotifyBlueprintChanged(UBlueprint* Blueprint, UEdGraph* Graph)
+{
+	FEditCoalescer::Run(Graph, TEXT("NotifyGraphChanged"), FEditCoalescer::EPhase::Refresh, [Graph]()
+	{
+		Graph->NotifyGraphChanged();
+	});
+	FEditCoalescer::Run(Blueprint, TEXT("MarkBlueprintAsModified"), FEditCoalescer::EPhase::Update, [Blueprint]()
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+		FBlueprintCompileQueue::MarkDirty(Blueprint);
+	});
+}
+
+/** Optional "blueprint_path" target from the query string or the JSON body; empty means the first open Blueprint editor */
+static FString GetBlueprintPath(const FRESTRequest& Request)
+{
+	if (const FString* PathPtr = Request.QueryParams.Find(TEXT("blueprint_path")))
+	{
+		return *PathPtr;
+	}
+	return JsonHelpers::GetOptionalString(Request.JsonBody, TEXT("blueprint_path"), TEXT(""));
+}
+
+/** Error response for a FindActiveBlueprintEditor failure */
+static FRESTResponse BlueprintEditorError(const FString& ErrorCode, const FString& BlueprintPath)
+{
+	if (ErrorCode == TEXT("NO_EDITOR"))
+	{
+		return FRESTResponse::Error(400, TEXT("NO_EDITOR"), TEXT("Editor not available"));
+	}
+	if (ErrorCode == TEXT("NO_SUBSYSTEM"))
+	{
+		return FRESTResponse::Error(400, TEXT("NO_SUBSYSTEM"), TEXT("AssetEditorSubsystem not available"));
+	}
+	if (!BlueprintPath.IsEmpty())
+	{
+		return FRESTResponse::Error(400, TEXT("NO_BLUEPRINT_EDITOR"),
+			FString::Printf(TEXT("Blueprint is not open in an editor: %s"), *BlueprintPath));
+	}
+	return FRESTResponse::Error(400, TEXT("NO_BLUEPRINT_EDITOR"),
+		TEXT("No Blueprint Editor is open. Open a Blueprint asset to use this endpoint."));
+}
+
 void FBlueprintsHandler::RegisterRoutes(FRESTRouter& Router)
 {
+	// Recorded after every graph edit so a memoized /blueprints/node_info is not replayed
+	constexpr EEditorChange BlueprintEdits = EEditorChange::Objects;
+
 	// Read endpoints
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/blueprints/selection"),
 		FRESTRouteHandler::CreateRaw(this, &FBlueprintsHandler::HandleSelection));
 
+	// Only cacheable when it names the blueprint; without blueprint_path it reads whichever editor is focused
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/blueprints/node_info"),
-		FRESTRouteHandler::CreateRaw(this, &FBlueprintsHandler::HandleNodeInfo));
+		FRESTRouteHandler::CreateRaw(this, &FBlueprintsHandler::HandleNodeInfo),
+		FRESTRouteOptions::Versioned(FRESTRouteVersion::CreateLambda([](const FRESTRequest& Request) -> uint64
+		{
+			return Request.QueryParams.Contains(TEXT("blueprint_path"))
+				? FEditorChangeTracker::GetGeneration(EEditorChange::Objects) + 1
+				: 0;
+		})).Cached());
 
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/blueprints/nodes"),
 		FRESTRouteHandler::CreateRaw(this, &FBlueprintsHandler::HandleListNodes));
 
 	// Write endpoints
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/blueprints/node/position"),
-		FRESTRouteHandler::CreateRaw(this, &FBlueprintsHandler::HandleSetNodePosition));
+		FEditorChangeTracker::BumpAfter(BlueprintEdits, FRESTRouteHandler::CreateRaw(this, &FBlueprintsHandler::HandleSetNodePosition)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/blueprints/node/create"),
-		FRESTRouteHandler::CreateRaw(this, &FBlueprintsHandler::HandleCreateNode));
+		FEditorChangeTracker::BumpAfter(BlueprintEdits, FRESTRouteHandler::CreateRaw(this, &FBlueprintsHandler::HandleCreateNode)));
 
 	Router.RegisterRoute(ERESTMethod::DELETE, TEXT("/blueprints/node"),
-		FRESTRouteHandler::CreateRaw(this, &FBlueprintsHandler::HandleDeleteNode));
+		FEditorChangeTracker::BumpAfter(BlueprintEdits, FRESTRouteHandler::CreateRaw(this, &FBlueprintsHandler::HandleDeleteNode)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/blueprints/connect"),
-		FRESTRouteHandler::CreateRaw(this, &FBlueprintsHandler::HandleConnect));
+		FEditorChangeTracker::BumpAfter(BlueprintEdits, FRESTRouteHandler::CreateRaw(this, &FBlueprintsHandler::HandleConnect)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/blueprints/disconnect"),
-		FRESTRouteHandler::CreateRaw(this, &FBlueprintsHandler::HandleDisconnect));
+		FEditorChangeTracker::BumpAfter(BlueprintEdits, FRESTRouteHandler::CreateRaw(this, &FBlueprintsHandler::HandleDisconnect)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/blueprints/pin/default"),
-		FRESTRouteHandler::CreateRaw(this, &FBlueprintsHandler::HandleSetPinDefault));
+		FEditorChangeTracker::BumpAfter(BlueprintEdits, FRESTRouteHandler::CreateRaw(this, &FBlueprintsHandler::HandleSetPinDefault)));
 
-	UE_LOG(LogTemp, Log, TEXT("BlueprintsHandler: Registered 9 routes at /blueprints"));
-}
+	// Compile queue
+	Router.RegisterRoute(ERESTMethod::POST, TEXT("/blueprints/compile"),
+		FEditorChangeTracker::BumpAfter(BlueprintEdits, FRESTRouteHandler::CreateRaw(this, &FBlueprintsHandler::HandleCompile)),
+		FRESTRouteOptions().Bulk());
 
-FBlueprintEditor* FBlueprintsHandler::FindActiveBlueprintEditor(UBlueprint*& OutBlueprint, FString& OutError)
-{
-	OutBlueprint = nullptr;
+	Router.RegisterRoute(ERESTMethod::GET, TEXT("/blueprints/compile"),
+		FRESTRouteHandler::CreateRaw(this, &FBlueprintsHandler::HandleCompileStatus));
 
-	if (!GEditor)
-	{
-		OutError = TEXT("NO_EDITOR");
-		return nullptr;
-	}
-
-	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-	if (!AssetEditorSubsystem)
-	{
-		OutError = TEXT("NO_SUBSYSTEM");
-		return nullptr;
-	}
-
-	// Find open Blueprint editors
-	TArray<UObject*> EditedAssets = AssetEditorSubsystem->GetAllEditedAssets();
-
-	for (UObject* Asset : EditedAssets)
-	{
-		UBlueprint* Blueprint = Cast<UBlueprint>(Asset);
-		if (Blueprint)
+	Router.RegisterRoute(ERESTMethod::GET, TEXT("/blueprints/compile/{id}"),
+		FRESTRouteHandler::CreateLambda([this](const FRESTRequest& Request) -> FRESTResponse
 		{
-			IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false);
-			// Note: Blueprint assets are only opened by FBlueprintEditor in standard configurations
-			if (EditorInstance && EditorInstance->GetEditorName() == TEXT("BlueprintEditor"))
-			{
-				OutBlueprint = Blueprint;
-				return static_cast<FBlueprintEditor*>(EditorInstance);
-			}
-		}
-	}
+			return HandleGetCompileJob(Request, Request.PathParams.FindRef(TEXT("id")));
+		}));
 
-	OutError = TEXT("NO_BLUEPRINT_EDITOR");
-	return nullptr;
+	UE_LOG(LogTemp, Log, TEXT("BlueprintsHandler: Registered 12 routes at /blueprints"));
+}
+
+FBlueprintEditor* FBlueprintsHandler::FindActiveBlueprintEditor(UBlueprint*& OutBlueprint, FString& OutError, const FString& BlueprintPath)
+{
+	return FBlueprintSessionCache::FindEditor(BlueprintPath, OutBlueprint, OutError);
 }
 
 FRESTResponse FBlueprintsHandler::HandleSelection(const FRESTRequest& Request)
 {
 	UBlueprint* EditedBlueprint = nullptr;
+	const FString BlueprintPath = GetBlueprintPath(Request);
 	FString ErrorCode;
-	FBlueprintEditor* BlueprintEditor = FindActiveBlueprintEditor(EditedBlueprint, ErrorCode);
+	FBlueprintEditor* BlueprintEditor = FindActiveBlueprintEditor(EditedBlueprint, ErrorCode, BlueprintPath);
 
 	if (!BlueprintEditor)
 	{
-		if (ErrorCode == TEXT("NO_EDITOR"))
-		{
-			return FRESTResponse::Error(400, TEXT("NO_EDITOR"), TEXT("Editor not available"));
-		}
-		else if (ErrorCode == TEXT("NO_SUBSYSTEM"))
-		{
-			return FRESTResponse::Error(400, TEXT("NO_SUBSYSTEM"), TEXT("AssetEditorSubsystem not available"));
-		}
-		else
-		{
-			return FRESTResponse::Error(400, TEXT("NO_BLUEPRINT_EDITOR"),
-				TEXT("No Blueprint Editor is open. Open a Blueprint asset to use this endpoint."));
-		}
+		return BlueprintEditorError(ErrorCode, BlueprintPath);
 	}
 
 	// Get selected nodes from the Blueprint Editor
@@ -157,64 +188,35 @@ FRESTResponse FBlueprintsHandler::HandleNodeInfo(const FRESTRequest& Request)
 	}
 
 	UBlueprint* EditedBlueprint = nullptr;
+	const FString BlueprintPath = GetBlueprintPath(Request);
 	FString ErrorCode;
-	FBlueprintEditor* BlueprintEditor = FindActiveBlueprintEditor(EditedBlueprint, ErrorCode);
+	FBlueprintEditor* BlueprintEditor = FindActiveBlueprintEditor(EditedBlueprint, ErrorCode, BlueprintPath);
 
 	if (!BlueprintEditor)
 	{
-		if (ErrorCode == TEXT("NO_EDITOR"))
-		{
-			return FRESTResponse::Error(400, TEXT("NO_EDITOR"), TEXT("Editor not available"));
-		}
-		else if (ErrorCode == TEXT("NO_SUBSYSTEM"))
-		{
-			return FRESTResponse::Error(400, TEXT("NO_SUBSYSTEM"), TEXT("AssetEditorSubsystem not available"));
-		}
-		else
-		{
-			return FRESTResponse::Error(400, TEXT("NO_BLUEPRINT_EDITOR"),
-				TEXT("No Blueprint Editor is open. Open a Blueprint asset to use this endpoint."));
-		}
+		return BlueprintEditorError(ErrorCode, BlueprintPath);
 	}
 
-	// Search for the node in all graphs
+	// Try the GUID index first
 	UEdGraphNode* FoundNode = nullptr;
 	FGuid SearchGuid;
-
-	// Try to parse as GUID first
-	if (NodeIdPtr && !NodeIdPtr->IsEmpty())
+	if (NodeIdPtr && !NodeIdPtr->IsEmpty() && FGuid::Parse(*NodeIdPtr, SearchGuid))
 	{
-		FGuid::Parse(*NodeIdPtr, SearchGuid);
+		FoundNode = FindNodeByGuid(EditedBlueprint, SearchGuid);
 	}
 
-	// Search through all graphs
-	TArray<UEdGraph*> Graphs;
-	EditedBlueprint->GetAllGraphs(Graphs);
-
-	for (UEdGraph* Graph : Graphs)
+	// Fall back to searching all graphs by name (node title or class name)
+	if (!FoundNode && NodeNamePtr && !NodeNamePtr->IsEmpty())
 	{
-		if (!Graph)
+		for (UEdGraph* Graph : FBlueprintSessionCache::GetGraphs(EditedBlueprint))
 		{
-			continue;
-		}
-
-		for (UEdGraphNode* Node : Graph->Nodes)
-		{
-			if (!Node)
+			for (UEdGraphNode* Node : Graph->Nodes)
 			{
-				continue;
-			}
-
-			// Match by GUID
-			if (SearchGuid.IsValid() && Node->NodeGuid == SearchGuid)
-			{
-				FoundNode = Node;
-				break;
-			}
+				if (!Node)
+				{
+					continue;
+				}
 
-			// Match by name (node title or class name)
-			if (NodeNamePtr && !NodeNamePtr->IsEmpty())
-			{
 				FString NodeTitle = Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString();
 				FString NodeClassName = Node->GetClass()->GetName();
 
@@ -224,11 +226,11 @@ FRESTResponse FBlueprintsHandler::HandleNodeInfo(const FRESTRequest& Request)
 					break;
 				}
 			}
-		}
 
-		if (FoundNode)
-		{
-			break;
+			if (FoundNode)
+			{
+				break;
+			}
 		}
 	}
 
@@ -273,7 +275,7 @@ FRESTResponse FBlueprintsHandler::HandleNodeInfo(const FRESTRequest& Request)
 	return FRESTResponse::Ok(Response);
 }
 
-TSharedPtr<FJsonObject> FBlueprintsHandler::NodeToJson(UEdGraphNode* Node)
+TSharedPtr<FJsonObject> FBlueprintsHandler::NodeToJson(UEdGraphNode* Node, const FRESTFieldFilter& Fields)
 {
 	TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
 
@@ -283,19 +285,36 @@ TSharedPtr<FJsonObject> FBlueprintsHandler::NodeToJson(UEdGraphNode* Node)
 	}
 
 	// Basic node info
-	Json->SetStringField(TEXT("id"), Node->NodeGuid.ToString());
-	Json->SetStringField(TEXT("class"), Node->GetClass()->GetName());
-	Json->SetStringField(TEXT("title"), Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
-	Json->SetStringField(TEXT("compact_title"), Node->GetNodeTitle(ENodeTitleType::MenuTitle).ToString());
+	if (Fields.Wants(TEXT("id")))
+	{
+		Json->SetStringField(TEXT("id"), Node->NodeGuid.ToString());
+	}
+	if (Fields.Wants(TEXT("class")))
+	{
+		Json->SetStringField(TEXT("class"), Node->GetClass()->GetName());
+	}
+
+	// Titles are rebuilt from the node's pins and schema on every call, so skip them unless asked for
+	if (Fields.Wants(TEXT("title")))
+	{
+		Json->SetStringField(TEXT("title"), Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
+	}
+	if (Fields.Wants(TEXT("compact_title")))
+	{
+		Json->SetStringField(TEXT("compact_title"), Node->GetNodeTitle(ENodeTitleType::MenuTitle).ToString());
+	}
 
 	// Position
-	TSharedPtr<FJsonObject> Position = MakeShared<FJsonObject>();
-	Position->SetNumberField(TEXT("x"), Node->NodePosX);
-	Position->SetNumberField(TEXT("y"), Node->NodePosY);
-	Json->SetObjectField(TEXT("position"), Position);
+	if (Fields.Wants(TEXT("position")))
+	{
+		TSharedPtr<FJsonObject> Position = MakeShared<FJsonObject>();
+		Position->SetNumberField(TEXT("x"), Node->NodePosX);
+		Position->SetNumberField(TEXT("y"), Node->NodePosY);
+		Json->SetObjectField(TEXT("position"), Position);
+	}
 
 	// Node comment
-	if (!Node->NodeComment.IsEmpty())
+	if (!Node->NodeComment.IsEmpty() && Fields.Wants(TEXT("comment")))
 	{
 		Json->SetStringField(TEXT("comment"), Node->NodeComment);
 	}
@@ -304,18 +323,32 @@ TSharedPtr<FJsonObject> FBlueprintsHandler::NodeToJson(UEdGraphNode* Node)
 	UK2Node* K2Node = Cast<UK2Node>(Node);
 	if (K2Node)
 	{
-		Json->SetBoolField(TEXT("is_pure"), K2Node->IsNodePure());
+		if (Fields.Wants(TEXT("is_pure")))
+		{
+			Json->SetBoolField(TEXT("is_pure"), K2Node->IsNodePure());
+		}
+
+		const bool bWantNodeType = Fields.Wants(TEXT("node_type"));
 
 		// Function call specifics
 		UK2Node_CallFunction* FunctionNode = Cast<UK2Node_CallFunction>(Node);
 		if (FunctionNode)
 		{
-			Json->SetStringField(TEXT("node_type"), TEXT("FunctionCall"));
+			if (bWantNodeType)
+			{
+				Json->SetStringField(TEXT("node_type"), TEXT("FunctionCall"));
+			}
 			UFunction* Function = FunctionNode->GetTargetFunction();
 			if (Function)
 			{
-				Json->SetStringField(TEXT("function_name"), Function->GetName());
-				Json->SetStringField(TEXT("function_owner"), Function->GetOwnerClass() ? Function->GetOwnerClass()->GetName() : TEXT("None"));
+				if (Fields.Wants(TEXT("function_name")))
+				{
+					Json->SetStringField(TEXT("function_name"), Function->GetName());
+				}
+				if (Fields.Wants(TEXT("function_owner")))
+				{
+					Json->SetStringField(TEXT("function_owner"), Function->GetOwnerClass() ? Function->GetOwnerClass()->GetName() : TEXT("None"));
+				}
 			}
 		}
 
@@ -323,37 +356,54 @@ TSharedPtr<FJsonObject> FBlueprintsHandler::NodeToJson(UEdGraphNode* Node)
 		UK2Node_Variable* VariableNode = Cast<UK2Node_Variable>(Node);
 		if (VariableNode)
 		{
-			Json->SetStringField(TEXT("node_type"), TEXT("Variable"));
-			Json->SetStringField(TEXT("variable_name"), VariableNode->GetVarName().ToString());
+			if (bWantNodeType)
+			{
+				Json->SetStringField(TEXT("node_type"), TEXT("Variable"));
+			}
+			if (Fields.Wants(TEXT("variable_name")))
+			{
+				Json->SetStringField(TEXT("variable_name"), VariableNode->GetVarName().ToString());
+			}
 		}
 
 		// Event node specifics
 		UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
-		if (EventNode)
+		if (EventNode && bWantNodeType)
 		{
 			Json->SetStringField(TEXT("node_type"), TEXT("Event"));
 		}
 	}
 
 	// Add pin count summary
-	int32 InputCount = 0;
-	int32 OutputCount = 0;
-	for (UEdGraphPin* Pin : Node->Pins)
+	const bool bWantInputs = Fields.Wants(TEXT("input_pin_count"));
+	const bool bWantOutputs = Fields.Wants(TEXT("output_pin_count"));
+	if (bWantInputs || bWantOutputs)
 	{
-		if (Pin)
+		int32 InputCount = 0;
+		int32 OutputCount = 0;
+		for (UEdGraphPin* Pin : Node->Pins)
 		{
-			if (Pin->Direction == EGPD_Input)
+			if (Pin)
 			{
-				InputCount++;
-			}
-			else
-			{
-				OutputCount++;
+				if (Pin->Direction == EGPD_Input)
+				{
+					InputCount++;
+				}
+				else
+				{
+					OutputCount++;
+				}
 			}
 		}
+		if (bWantInputs)
+		{
+			Json->SetNumberField(TEXT("input_pin_count"), InputCount);
+		}
+		if (bWantOutputs)
+		{
+			Json->SetNumberField(TEXT("output_pin_count"), OutputCount);
+		}
 	}
-	Json->SetNumberField(TEXT("input_pin_count"), InputCount);
-	Json->SetNumberField(TEXT("output_pin_count"), OutputCount);
 
 	return Json;
 }
@@ -421,21 +471,7 @@ UEdGraphNode* FBlueprintsHandler::FindNodeByGuid(UBlueprint* Blueprint, const FG
 		return nullptr;
 	}
 
-	TArray<UEdGraph*> Graphs;
-	Blueprint->GetAllGraphs(Graphs);
-
-	for (UEdGraph* Graph : Graphs)
-	{
-		if (!Graph) continue;
-		for (UEdGraphNode* Node : Graph->Nodes)
-		{
-			if (Node && Node->NodeGuid == NodeGuid)
-			{
-				return Node;
-			}
-		}
-	}
-	return nullptr;
+	return FBlueprintSessionCache::FindNode(Blueprint, NodeGuid);
 }
 
 // Helper: Find pin by name
@@ -446,9 +482,17 @@ UEdGraphPin* FBlueprintsHandler::FindPinByName(UEdGraphNode* Node, const FString
 		return nullptr;
 	}
 
+	// Pins are rebuilt whenever a node is reconstructed, so they are matched by name rather than cached.
+	// No FName entry means no pin can have this name.
+	const FName Key(*PinName, FNAME_Find);
+	if (Key.IsNone())
+	{
+		return nullptr;
+	}
+
 	for (UEdGraphPin* Pin : Node->Pins)
 	{
-		if (Pin && Pin->PinName.ToString() == PinName)
+		if (Pin && Pin->PinName == Key)
 		{
 			if (Direction == EGPD_MAX || Pin->Direction == Direction)
 			{
@@ -462,71 +506,35 @@ UEdGraphPin* FBlueprintsHandler::FindPinByName(UEdGraphNode* Node, const FString
 // Helper: Find graph by name
 UEdGraph* FBlueprintsHandler::FindGraphByName(UBlueprint* Blueprint, const FString& GraphName)
 {
-	if (!Blueprint)
-	{
-		return nullptr;
-	}
-
-	TArray<UEdGraph*> Graphs;
-	Blueprint->GetAllGraphs(Graphs);
-
-	for (UEdGraph* Graph : Graphs)
-	{
-		if (Graph && Graph->GetName() == GraphName)
-		{
-			return Graph;
-		}
-	}
-
-	// Default to EventGraph if not found
-	if (GraphName.IsEmpty() || GraphName == TEXT("EventGraph"))
-	{
-		for (UEdGraph* Graph : Blueprint->UbergraphPages)
-		{
-			if (Graph)
-			{
-				return Graph;
-			}
-		}
-	}
-
-	return nullptr;
+	return FBlueprintSessionCache::FindGraph(Blueprint, GraphName);
 }
 
 // GET /blueprints/nodes - List all nodes in a graph
 FRESTResponse FBlueprintsHandler::HandleListNodes(const FRESTRequest& Request)
 {
 	UBlueprint* Blueprint = nullptr;
+	const FString BlueprintPath = GetBlueprintPath(Request);
 	FString ErrorCode;
-	FBlueprintEditor* Editor = FindActiveBlueprintEditor(Blueprint, ErrorCode);
+	FBlueprintEditor* Editor = FindActiveBlueprintEditor(Blueprint, ErrorCode, BlueprintPath);
 
 	if (!Editor)
 	{
-		return FRESTResponse::Error(400, ErrorCode, TEXT("No Blueprint Editor open"));
+		return BlueprintEditorError(ErrorCode, BlueprintPath);
+	}
+
+	FRESTListQuery Query;
+	FString Error;
+	if (!FRESTListQuery::Parse(Request, MAX_int32, MAX_int32, Query, Error))
+	{
+		return FRESTResponse::BadRequest(Error);
 	}
 
 	// Get optional graph name
 	const FString* GraphNamePtr = Request.QueryParams.Find(TEXT("graph"));
 	FString GraphName = GraphNamePtr ? *GraphNamePtr : TEXT("");
 
-	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
-	Response->SetBoolField(TEXT("success"), true);
-	Response->SetStringField(TEXT("blueprint"), Blueprint->GetName());
-
 	// Get all graphs
-	TArray<UEdGraph*> Graphs;
-	Blueprint->GetAllGraphs(Graphs);
-
-	// List available graphs
-	TArray<TSharedPtr<FJsonValue>> GraphsArray;
-	for (UEdGraph* Graph : Graphs)
-	{
-		if (Graph)
-		{
-			GraphsArray.Add(MakeShared<FJsonValueString>(Graph->GetName()));
-		}
-	}
-	Response->SetArrayField(TEXT("available_graphs"), GraphsArray);
+	const TArray<UEdGraph*> Graphs = FBlueprintSessionCache::GetGraphs(Blueprint);
 
 	// Find the requested graph
 	UEdGraph* TargetGraph = FindGraphByName(Blueprint, GraphName);
@@ -535,23 +543,60 @@ FRESTResponse FBlueprintsHandler::HandleListNodes(const FRESTRequest& Request)
 		TargetGraph = Graphs[0];
 	}
 
-	if (TargetGraph)
+	FRESTJsonWriter Writer;
+	Query.BeginList(Writer, TEXT("nodes"), [Blueprint, &Graphs, TargetGraph](FRESTJsonWriter& Header)
 	{
-		Response->SetStringField(TEXT("current_graph"), TargetGraph->GetName());
+		Header.WriteValue(TEXT("blueprint"), Blueprint->GetName());
 
-		TArray<TSharedPtr<FJsonValue>> NodesArray;
+		// List available graphs
+		Header.WriteArrayStart(TEXT("available_graphs"));
+		for (UEdGraph* Graph : Graphs)
+		{
+			if (Graph)
+			{
+				Header.WriteValue(Graph->GetFName());
+			}
+		}
+		Header.WriteArrayEnd();
+
+		if (TargetGraph)
+		{
+			Header.WriteValue(TEXT("current_graph"), TargetGraph->GetFName());
+		}
+	});
+
+	int32 Index = 0;
+	int32 Count = 0;
+	bool bHasMore = false;
+	if (TargetGraph)
+	{
 		for (UEdGraphNode* Node : TargetGraph->Nodes)
 		{
-			if (Node)
+			if (!Node)
+			{
+				continue;
+			}
+
+			const int32 NodeIndex = Index++;
+			if (Query.IsBeforePage(NodeIndex))
+			{
+				continue;
+			}
+			if (Query.IsAfterPage(NodeIndex))
 			{
-				NodesArray.Add(MakeShared<FJsonValueObject>(NodeToJson(Node)));
+				bHasMore = true;
+				break;
 			}
+
+			Query.WriteItem(Writer, NodeToJson(Node, Query.GetFields()));
+			Count++;
 		}
-		Response->SetArrayField(TEXT("nodes"), NodesArray);
-		Response->SetNumberField(TEXT("node_count"), NodesArray.Num());
 	}
 
-	return FRESTResponse::Ok(Response);
+	return Query.Finish(Writer, bHasMore, [Count](FRESTJsonWriter& Trailer)
+	{
+		Trailer.WriteValue(TEXT("node_count"), Count);
+	});
 }
 
 // POST /blueprints/node/position - Move node
@@ -570,12 +615,13 @@ FRESTResponse FBlueprintsHandler::HandleSetNodePosition(const FRESTRequest& Requ
 	}
 
 	UBlueprint* Blueprint = nullptr;
+	const FString BlueprintPath = GetBlueprintPath(Request);
 	FString ErrorCode;
-	FBlueprintEditor* Editor = FindActiveBlueprintEditor(Blueprint, ErrorCode);
+	FBlueprintEditor* Editor = FindActiveBlueprintEditor(Blueprint, ErrorCode, BlueprintPath);
 
 	if (!Editor)
 	{
-		return FRESTResponse::Error(400, ErrorCode, TEXT("No Blueprint Editor open"));
+		return BlueprintEditorError(ErrorCode, BlueprintPath);
 	}
 
 	FGuid SearchGuid;
@@ -601,8 +647,7 @@ FRESTResponse FBlueprintsHandler::HandleSetNodePosition(const FRESTRequest& Requ
 	Node->NodePosY = NewY;
 
 	// Mark as modified
-	Node->GetGraph()->NotifyGraphChanged();
-	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+	NotifyBlueprintChanged(Blueprint, Node->GetGraph());
 
 	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
 	Response->SetBoolField(TEXT("success"), true);
@@ -633,12 +678,13 @@ FRESTResponse FBlueprintsHandler::HandleCreateNode(const FRESTRequest& Request)
 	}
 
 	UBlueprint* Blueprint = nullptr;
+	const FString BlueprintPath = GetBlueprintPath(Request);
 	FString ErrorCode;
-	FBlueprintEditor* Editor = FindActiveBlueprintEditor(Blueprint, ErrorCode);
+	FBlueprintEditor* Editor = FindActiveBlueprintEditor(Blueprint, ErrorCode, BlueprintPath);
 
 	if (!Editor)
 	{
-		return FRESTResponse::Error(400, ErrorCode, TEXT("No Blueprint Editor open"));
+		return BlueprintEditorError(ErrorCode, BlueprintPath);
 	}
 
 	// Find graph
@@ -755,8 +801,7 @@ FRESTResponse FBlueprintsHandler::HandleCreateNode(const FRESTRequest& Request)
 
 	if (NewNode)
 	{
-		Graph->NotifyGraphChanged();
-		FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+		NotifyBlueprintChanged(Blueprint, Graph);
 
 		TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
 		Response->SetBoolField(TEXT("success"), true);
@@ -777,12 +822,13 @@ FRESTResponse FBlueprintsHandler::HandleDeleteNode(const FRESTRequest& Request)
 	}
 
 	UBlueprint* Blueprint = nullptr;
+	const FString BlueprintPath = GetBlueprintPath(Request);
 	FString ErrorCode;
-	FBlueprintEditor* Editor = FindActiveBlueprintEditor(Blueprint, ErrorCode);
+	FBlueprintEditor* Editor = FindActiveBlueprintEditor(Blueprint, ErrorCode, BlueprintPath);
 
 	if (!Editor)
 	{
-		return FRESTResponse::Error(400, ErrorCode, TEXT("No Blueprint Editor open"));
+		return BlueprintEditorError(ErrorCode, BlueprintPath);
 	}
 
 	FGuid SearchGuid;
@@ -797,8 +843,9 @@ FRESTResponse FBlueprintsHandler::HandleDeleteNode(const FRESTRequest& Request)
 
 	FString NodeTitle = Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString();
 
-	// Remove the node
+	// Remove the node; compiling is left to the compile queue
 	FBlueprintEditorUtils::RemoveNode(Blueprint, Node, true);
+	FBlueprintCompileQueue::MarkDirty(Blueprint);
 
 	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
 	Response->SetBoolField(TEXT("success"), true);
@@ -832,12 +879,13 @@ FRESTResponse FBlueprintsHandler::HandleConnect(const FRESTRequest& Request)
 	}
 
 	UBlueprint* Blueprint = nullptr;
+	const FString BlueprintPath = GetBlueprintPath(Request);
 	FString ErrorCode;
-	FBlueprintEditor* Editor = FindActiveBlueprintEditor(Blueprint, ErrorCode);
+	FBlueprintEditor* Editor = FindActiveBlueprintEditor(Blueprint, ErrorCode, BlueprintPath);
 
 	if (!Editor)
 	{
-		return FRESTResponse::Error(400, ErrorCode, TEXT("No Blueprint Editor open"));
+		return BlueprintEditorError(ErrorCode, BlueprintPath);
 	}
 
 	// Find nodes
@@ -885,8 +933,7 @@ FRESTResponse FBlueprintsHandler::HandleConnect(const FRESTRequest& Request)
 	const UEdGraphSchema* Schema = SourceNode->GetGraph()->GetSchema();
 	if (Schema->TryCreateConnection(SourcePin, TargetPin))
 	{
-		SourceNode->GetGraph()->NotifyGraphChanged();
-		FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+		NotifyBlueprintChanged(Blueprint, SourceNode->GetGraph());
 
 		TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
 		Response->SetBoolField(TEXT("success"), true);
@@ -919,12 +966,13 @@ FRESTResponse FBlueprintsHandler::HandleDisconnect(const FRESTRequest& Request)
 	}
 
 	UBlueprint* Blueprint = nullptr;
+	const FString BlueprintPath = GetBlueprintPath(Request);
 	FString ErrorCode;
-	FBlueprintEditor* Editor = FindActiveBlueprintEditor(Blueprint, ErrorCode);
+	FBlueprintEditor* Editor = FindActiveBlueprintEditor(Blueprint, ErrorCode, BlueprintPath);
 
 	if (!Editor)
 	{
-		return FRESTResponse::Error(400, ErrorCode, TEXT("No Blueprint Editor open"));
+		return BlueprintEditorError(ErrorCode, BlueprintPath);
 	}
 
 	FGuid SearchGuid;
@@ -948,8 +996,7 @@ FRESTResponse FBlueprintsHandler::HandleDisconnect(const FRESTRequest& Request)
 	// Break all links
 	Pin->BreakAllPinLinks();
 
-	Node->GetGraph()->NotifyGraphChanged();
-	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+	NotifyBlueprintChanged(Blueprint, Node->GetGraph());
 
 	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
 	Response->SetBoolField(TEXT("success"), true);
@@ -980,12 +1027,13 @@ FRESTResponse FBlueprintsHandler::HandleSetPinDefault(const FRESTRequest& Reques
 	}
 
 	UBlueprint* Blueprint = nullptr;
+	const FString BlueprintPath = GetBlueprintPath(Request);
 	FString ErrorCode;
-	FBlueprintEditor* Editor = FindActiveBlueprintEditor(Blueprint, ErrorCode);
+	FBlueprintEditor* Editor = FindActiveBlueprintEditor(Blueprint, ErrorCode, BlueprintPath);
 
 	if (!Editor)
 	{
-		return FRESTResponse::Error(400, ErrorCode, TEXT("No Blueprint Editor open"));
+		return BlueprintEditorError(ErrorCode, BlueprintPath);
 	}
 
 	FGuid SearchGuid;
@@ -1010,8 +1058,7 @@ FRESTResponse FBlueprintsHandler::HandleSetPinDefault(const FRESTRequest& Reques
 	const UEdGraphSchema* Schema = Node->GetGraph()->GetSchema();
 	Schema->TrySetDefaultValue(*Pin, Value);
 
-	Node->GetGraph()->NotifyGraphChanged();
-	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+	NotifyBlueprintChanged(Blueprint, Node->GetGraph());
 
 	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
 	Response->SetBoolField(TEXT("success"), true);
@@ -1023,6 +1070,139 @@ FRESTResponse FBlueprintsHandler::HandleSetPinDefault(const FRESTRequest& Reques
 	return FRESTResponse::Ok(Response);
 }
 
+// POST /blueprints/compile - Queue a compile pass
+FRESTResponse FBlueprintsHandler::HandleCompile(const FRESTRequest& Request)
+{
+	TArray<FString> Paths;
+	const TArray<TSharedPtr<FJsonValue>>* PathValues = nullptr;
+	if (Request.JsonBody.IsValid() && Request.JsonBody->TryGetArrayField(TEXT("blueprint_paths"), PathValues))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *PathValues)
+		{
+			FString Path;
+			if (!Value.IsValid() || !Value->TryGetString(Path) || Path.IsEmpty())
+			{
+				return FRESTResponse::BadRequest(TEXT("blueprint_paths must be an array of Blueprint paths"));
+			}
+			Paths.Add(Path);
+		}
+	}
+	const FString BlueprintPath = GetBlueprintPath(Request);
+	if (!BlueprintPath.IsEmpty())
+	{
+		Paths.Add(BlueprintPath);
+	}
+
+	TArray<UBlueprint*> Blueprints;
+	for (const FString& Path : Paths)
+	{
+		UBlueprint* Blueprint = Cast<UBlueprint>(StaticLoadObject(UBlueprint::StaticClass(), nullptr, *Path));
+		if (!Blueprint)
+		{
+			return FRESTResponse::Error(404, TEXT("BLUEPRINT_NOT_FOUND"),
+				FString::Printf(TEXT("Blueprint not found: %s"), *Path));
+		}
+		Blueprints.Add(Blueprint);
+	}
+
+	// Nothing named and nothing dirty: compile the Blueprint being edited
+	if (Blueprints.Num() == 0 && FBlueprintCompileQueue::GetDirtyPaths().Num() == 0)
+	{
+		UBlueprint* EditedBlueprint = nullptr;
+		FString ErrorCode;
+		if (!FindActiveBlueprintEditor(EditedBlueprint, ErrorCode))
+		{
+			return FRESTResponse::Error(400, TEXT("NOTHING_TO_COMPILE"),
+				TEXT("No Blueprint is dirty, none was named in blueprint_paths, and no Blueprint Editor is open"));
+		}
+		Blueprints.Add(EditedBlueprint);
+	}
+
+	const FString JobId = FBlueprintCompileQueue::Enqueue(Blueprints);
+
+	// "wait": compile before answering instead of on the next tick
+	const bool bWait = JsonHelpers::GetOptionalBool(Request.JsonBody, TEXT("wait"), false);
+	if (bWait)
+	{
+		FBlueprintCompileQueue::Flush();
+	}
+
+	TSharedPtr<const FBlueprintCompileQueue::FJob> Job = FBlueprintCompileQueue::FindJob(JobId);
+	if (!Job.IsValid())
+	{
+		return FRESTResponse::ServerError(TEXT("Compile job was dropped before it could be reported"));
+	}
+
+	FRESTJsonWriter Writer;
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("success"), true);
+	Job->WriteJson(Writer);
+	Writer.WriteObjectEnd();
+	return FRESTResponse::Stream(Writer, bWait ? 200 : 202);
+}
+
+// GET /blueprints/compile - Dirty Blueprints and recent compile jobs
+FRESTResponse FBlueprintsHandler::HandleCompileStatus(const FRESTRequest& Request)
+{
+	const TArray<FString> DirtyPaths = FBlueprintCompileQueue::GetDirtyPaths();
+	const TArray<TSharedRef<const FBlueprintCompileQueue::FJob>> Jobs = FBlueprintCompileQueue::GetJobs();
+
+	FRESTJsonWriter Writer;
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("success"), true);
+
+	Writer.WriteArrayStart(TEXT("dirty"));
+	for (const FString& Path : DirtyPaths)
+	{
+		Writer.WriteValue(Path);
+	}
+	Writer.WriteArrayEnd();
+
+	Writer.WriteArrayStart(TEXT("jobs"));
+	for (const TSharedRef<const FBlueprintCompileQueue::FJob>& Job : Jobs)
+	{
+		int32 Errors = 0;
+		int32 Warnings = 0;
+		for (const FBlueprintCompileQueue::FBlueprintResult& Result : Job->Results)
+		{
+			Errors += Result.Errors;
+			Warnings += Result.Warnings;
+		}
+
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("job_id"), Job->JobId);
+		Writer.WriteValue(TEXT("status"), Job->Status == FBlueprintCompileQueue::EJobStatus::Pending ? TEXT("pending") : TEXT("completed"));
+		Writer.WriteValue(TEXT("automatic"), Job->bAutomatic);
+		Writer.WriteValue(TEXT("submitted_at"), Job->SubmitTime.ToIso8601());
+		Writer.WriteValue(TEXT("blueprints"), Job->Results.Num());
+		Writer.WriteValue(TEXT("errors"), Errors);
+		Writer.WriteValue(TEXT("warnings"), Warnings);
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteArrayEnd();
+
+	Writer.WriteObjectEnd();
+	return FRESTResponse::Stream(Writer);
+}
+
+// GET /blueprints/compile/{id} - One compile job with per-node messages
+FRESTResponse FBlueprintsHandler::HandleGetCompileJob(const FRESTRequest& Request, const FString& JobId)
+{
+	TSharedPtr<const FBlueprintCompileQueue::FJob> Job = FBlueprintCompileQueue::FindJob(JobId);
+	if (!Job.IsValid())
+	{
+		return FRESTResponse::Error(404, TEXT("JOB_NOT_FOUND"),
+			FString::Printf(TEXT("Compile job not found: %s"), *JobId));
+	}
+
+	FRESTJsonWriter Writer;
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("success"), true);
+	Job->WriteJson(Writer);
+	Writer.WriteObjectEnd();
+	return FRESTResponse::Stream(Writer);
+}
+
 TArray<TSharedPtr<FJsonObject>> FBlueprintsHandler::GetEndpointSchemas() const
 {
 	TArray<TSharedPtr<FJsonObject>> Schemas;
@@ -1045,5 +1225,11 @@ TArray<TSharedPtr<FJsonObject>> FBlueprintsHandler::GetEndpointSchemas() const
 	
 	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("POST")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/blueprints/pin/default")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Set pin default value"));
 
+	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("POST")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/blueprints/compile")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Compile dirty and named Blueprints in one pass (body: blueprint_paths, wait); returns a job"));
+
+	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("GET")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/blueprints/compile")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Dirty Blueprints waiting for a compile and recent compile jobs"));
+
+	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("GET")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/blueprints/compile/{id}")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Compile job result with per-node errors and warnings"));
+
 	return Schemas;
 }
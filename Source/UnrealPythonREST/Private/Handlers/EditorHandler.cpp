@@ -1,13 +1,17 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Handlers/EditorHandler.h"
+#include "Utils/EditorChangeTracker.h"
 #include "Utils/JsonHelpers.h"
 #include "Utils/ActorUtils.h"
+#include "Utils/EditorEventFeed.h"
+#include "RESTJsonWriter.h"
 #include "Editor.h"
 #include "LevelEditor.h"
 #include "EditorViewportClient.h"
 #include "LevelEditorViewport.h"
 #include "Misc/App.h"
+#include "Misc/Base64.h"
 #include "Misc/EngineVersion.h"
 #include "Misc/Paths.h"
 #include "HighResScreenshot.h"
@@ -34,57 +38,104 @@ FEditorHandler::~FEditorHandler()
 		CameraAnim.bIsActive = false;
 		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
 	}
-}
 
-float FEditorHandler::EaseInOut(float T)
-{
-	// Smooth step: 3t^2 - 2t^3
-	return T * T * (3.0f - 2.0f * T);
+	if (LiveCodingTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(LiveCodingTickHandle);
+	}
+
+	// Shutdown answered unfinished runs; capture callbacks hold weak references, so late results are dropped
+	if (CaptureTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(CaptureTickHandle);
+	}
 }
 
-bool FEditorHandler::TickCameraAnimation(float DeltaTime)
+void FEditorHandler::Shutdown()
 {
-	if (!CameraAnim.bIsActive)
+	if (CaptureTickHandle.IsValid())
 	{
-		return false; // Stop ticking
+		FTSTicker::GetCoreTicker().RemoveTicker(CaptureTickHandle);
+		CaptureTickHandle.Reset();
 	}
 
-	CameraAnim.ElapsedTime += DeltaTime;
-	float Alpha = FMath::Clamp(CameraAnim.ElapsedTime / CameraAnim.Duration, 0.0f, 1.0f);
-	float EasedAlpha = EaseInOut(Alpha);
+	// FinishCaptureRun removes inline and binary runs from CaptureRuns
+	const TArray<TSharedRef<FCaptureRun>> Runs = CaptureRuns;
+	for (const TSharedRef<FCaptureRun>& Run : Runs)
+	{
+		if (!Run->IsFinished())
+		{
+			FinishCaptureRun(Run, TEXT("SHUTTING_DOWN: Server stopped before the capture finished"), 503);
+		}
+	}
+}
 
-	FVector CurrentLocation;
-	FRotator CurrentRotation;
+float FEditorHandler::EaseInOut(float T)
+{
+	// Smooth step: 3t^2 - 2t^3
+	return T * T * (3.0f - 2.0f * T);
+}
 
-	if (CameraAnim.bOrbitMode)
+void FEditorHandler::EvaluateCameraAnimation(const FCameraAnimation& Anim, float EasedAlpha, FVector& OutLocation, FRotator& OutRotation)
+{
+	if (Anim.bOrbitMode)
 	{
 		// Orbit mode: SLERP the angle around the target, interpolate distance
-		FQuat StartQuat = CameraAnim.StartAngle.Quaternion();
-		FQuat EndQuat = CameraAnim.EndAngle.Quaternion();
+		FQuat StartQuat = Anim.StartAngle.Quaternion();
+		FQuat EndQuat = Anim.EndAngle.Quaternion();
 		FQuat CurrentQuat = FQuat::Slerp(StartQuat, EndQuat, EasedAlpha);
 		FRotator CurrentAngle = CurrentQuat.Rotator();
 
 		// Interpolate distance
-		float CurrentDistance = FMath::Lerp(CameraAnim.StartDistance, CameraAnim.EndDistance, EasedAlpha);
+		float CurrentDistance = FMath::Lerp(Anim.StartDistance, Anim.EndDistance, EasedAlpha);
 
 		// Calculate camera position from interpolated angle and distance
 		FVector OffsetDirection = CurrentAngle.Vector();
-		CurrentLocation = CameraAnim.OrbitTarget + (OffsetDirection * CurrentDistance);
+		OutLocation = Anim.OrbitTarget + (OffsetDirection * CurrentDistance);
 
 		// Camera always looks at target
-		FVector LookDirection = CameraAnim.OrbitTarget - CurrentLocation;
-		CurrentRotation = LookDirection.Rotation();
+		FVector LookDirection = Anim.OrbitTarget - OutLocation;
+		OutRotation = LookDirection.Rotation();
 	}
 	else
 	{
 		// Linear mode: interpolate location directly, SLERP rotation
-		CurrentLocation = FMath::Lerp(CameraAnim.StartLocation, CameraAnim.EndLocation, EasedAlpha);
+		OutLocation = FMath::Lerp(Anim.StartLocation, Anim.EndLocation, EasedAlpha);
 
-		FQuat StartQuat = CameraAnim.StartRotation.Quaternion();
-		FQuat EndQuat = CameraAnim.EndRotation.Quaternion();
+		FQuat StartQuat = Anim.StartRotation.Quaternion();
+		FQuat EndQuat = Anim.EndRotation.Quaternion();
 		FQuat CurrentQuat = FQuat::Slerp(StartQuat, EndQuat, EasedAlpha);
-		CurrentRotation = CurrentQuat.Rotator();
+		OutRotation = CurrentQuat.Rotator();
 	}
+}
+
+void FEditorHandler::StopCameraAnimation()
+{
+	// Use bIsActive flag instead of TickHandle.IsValid() because Live Coding
+	// can invalidate the weak pointer in TickHandle
+	if (CameraAnim.bIsActive)
+	{
+		CameraAnim.bIsActive = false;
+		// Try to remove the ticker, but don't crash if the handle is stale
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+}
+
+bool FEditorHandler::TickCameraAnimation(float DeltaTime)
+{
+	if (!CameraAnim.bIsActive)
+	{
+		return false; // Stop ticking
+	}
+
+	CameraAnim.ElapsedTime += DeltaTime;
+	float Alpha = FMath::Clamp(CameraAnim.ElapsedTime / CameraAnim.Duration, 0.0f, 1.0f);
+	float EasedAlpha = EaseInOut(Alpha);
+
+	FVector CurrentLocation;
+	FRotator CurrentRotation;
+	EvaluateCameraAnimation(CameraAnim, EasedAlpha, CurrentLocation, CurrentRotation);
 
 	// Apply to viewport
 	FEditorViewportClient* ViewportClient = nullptr;
@@ -103,6 +154,7 @@ bool FEditorHandler::TickCameraAnimation(float DeltaTime)
 	if (Alpha >= 1.0f)
 	{
 		CameraAnim.bIsActive = false;
+		FEditorEventFeed::Post(EEditorEventTopic::Camera, TEXT("animation_finished"), TEXT("viewport"));
 		return false; // Stop ticking
 	}
 
@@ -117,6 +169,21 @@ void FEditorHandler::RegisterRoutes(FRESTRouter& Router)
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/editor/screenshot"),
 		FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleScreenshot));
 
+	Router.RegisterRoute(ERESTMethod::POST, TEXT("/editor/capture"),
+		FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleCapture));
+
+	Router.RegisterRoute(ERESTMethod::GET, TEXT("/editor/capture/{id}"),
+		FRESTRouteHandler::CreateLambda([this](const FRESTRequest& Request) -> FRESTResponse
+		{
+			return HandleGetCaptureJob(Request, Request.PathParams.FindRef(TEXT("id")));
+		}));
+
+	Router.RegisterRoute(ERESTMethod::GET, TEXT("/editor/capture/{id}/frame/{index}"),
+		FRESTRouteHandler::CreateLambda([this](const FRESTRequest& Request) -> FRESTResponse
+		{
+			return HandleGetCaptureFrame(Request, Request.PathParams.FindRef(TEXT("id")), Request.PathParams.FindRef(TEXT("index")));
+		}));
+
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/editor/camera"),
 		FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleCamera));
 
@@ -127,30 +194,30 @@ void FEditorHandler::RegisterRoutes(FRESTRouter& Router)
 		FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleGetSelection));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/editor/selection"),
-		FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleSetSelection));
+		FEditorChangeTracker::BumpAfter(EEditorChange::Selection, FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleSetSelection)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/editor/console"),
-		FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleConsole));
+		FEditorChangeTracker::BumpAfter(EEditorChange::All, FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleConsole)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/editor/replace_mesh"),
-		FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleReplaceMesh));
+		FEditorChangeTracker::BumpAfter(EEditorChange::World | EEditorChange::Objects, FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleReplaceMesh)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/editor/replace_with_bp"),
-		FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleReplaceWithBP));
+		FEditorChangeTracker::BumpAfter(EEditorChange::World | EEditorChange::Objects, FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleReplaceWithBP)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/editor/live_coding"),
-		FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleLiveCoding));
+		FEditorChangeTracker::BumpAfter(EEditorChange::All, FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleLiveCoding)));
 
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/editor/live_coding"),
 		FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleLiveCodingStatus));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/editor/open"),
-		FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleOpenAsset));
+		FEditorChangeTracker::BumpAfter(EEditorChange::Objects, FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleOpenAsset)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/editor/close"),
-		FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleCloseAsset));
+		FEditorChangeTracker::BumpAfter(EEditorChange::Objects, FRESTRouteHandler::CreateRaw(this, &FEditorHandler::HandleCloseAsset)));
 
-	UE_LOG(LogTemp, Log, TEXT("EditorHandler: Registered 13 routes at /editor"));
+	UE_LOG(LogTemp, Log, TEXT("EditorHandler: Registered 16 routes at /editor"));
 }
 
 FRESTResponse FEditorHandler::HandleProject(const FRESTRequest& Request)
@@ -205,94 +272,487 @@ FRESTResponse FEditorHandler::HandleScreenshot(const FRESTRequest& Request)
 	return FRESTResponse::Ok(Response);
 }
 
-FRESTResponse FEditorHandler::HandleCamera(const FRESTRequest& Request)
+namespace
 {
-	FEditorViewportClient* ViewportClient = nullptr;
-	if (GEditor && GEditor->GetActiveViewport())
+	/** Longest sequence one request may capture */
+	constexpr int32 MaxSequenceFrames = 120;
+
+	/** Unfinished capture runs accepted at once; more get 503 */
+	constexpr int32 MaxActiveCaptureRuns = 8;
+
+	/** Finished capture jobs kept for polling, newest kept */
+	constexpr int32 MaxCaptureJobs = 16;
+
+	const TCHAR* GetCaptureStatus(const FCaptureRun& Run)
 	{
-		ViewportClient = static_cast<FEditorViewportClient*>(GEditor->GetActiveViewport()->GetClient());
+		return Run.IsFinished() ? *Run.Status : TEXT("running");
+	}
+
+	/** Raw image response for one frame */
+	FRESTResponse MakeFrameResponse(const FViewportCapture::FFrame& Frame)
+	{
+		TSharedRef<FRESTOutputBuffer> Buffer = FRESTOutputBuffer::Acquire();
+		Buffer->Bytes.Append(Frame.Bytes.GetData(), static_cast<int32>(Frame.Bytes.Num()));
+
+		FRESTResponse Response;
+		Response.StreamBody = Buffer;
+		Response.ContentType = FViewportCapture::GetMimeType(Frame.Format);
+		Response.Headers.Add(TEXT("X-Capture-Width"), FString::FromInt(Frame.Width));
+		Response.Headers.Add(TEXT("X-Capture-Height"), FString::FromInt(Frame.Height));
+		return Response;
+	}
+
+	/** job_id/status (jobs only), format, timing and "frames" with optional base64 "data" */
+	void WriteCaptureRun(FRESTJsonWriter& Writer, const FCaptureRun& Run, bool bIncludeData)
+	{
+		if (!Run.JobId.IsEmpty())
+		{
+			Writer.WriteValue(TEXT("job_id"), Run.JobId);
+			Writer.WriteValue(TEXT("status"), GetCaptureStatus(Run));
+			Writer.WriteValue(TEXT("submitted_at"), Run.SubmitTime.ToIso8601());
+			if (Run.IsFinished())
+			{
+				Writer.WriteValue(TEXT("completed_at"), Run.EndTime.ToIso8601());
+			}
+			if (!Run.Error.IsEmpty())
+			{
+				Writer.WriteValue(TEXT("error"), Run.Error);
+			}
+		}
+
+		Writer.WriteValue(TEXT("mime"), FViewportCapture::GetMimeType(Run.Settings.Format));
+		Writer.WriteValue(TEXT("sequence"), Run.bSequence);
+		Writer.WriteValue(TEXT("frame_count"), Run.NumFrames);
+		Writer.WriteValue(TEXT("frames_captured"), Run.Frames.Num());
+
+		Writer.WriteArrayStart(TEXT("frames"));
+		for (int32 Index = 0; Index < Run.Frames.Num(); ++Index)
+		{
+			const FViewportCapture::FFrame& Frame = *Run.Frames[Index];
+			Writer.WriteObjectStart();
+			Writer.WriteValue(TEXT("index"), Index);
+			Writer.WriteValue(TEXT("width"), Frame.Width);
+			Writer.WriteValue(TEXT("height"), Frame.Height);
+			Writer.WriteValue(TEXT("bytes"), Frame.Bytes.Num());
+			Writer.WriteValue(TEXT("readback_ms"), Frame.ReadbackMs);
+			Writer.WriteValue(TEXT("encode_ms"), Frame.EncodeMs);
+			JsonHelpers::WriteVector(Writer, TEXT("location"), Frame.Location);
+			JsonHelpers::WriteRotator(Writer, TEXT("rotation"), Frame.Rotation);
+			if (bIncludeData)
+			{
+				Writer.WriteValue(TEXT("data"), FBase64::Encode(Frame.Bytes.GetData(), static_cast<uint32>(Frame.Bytes.Num())));
+			}
+			Writer.WriteObjectEnd();
+		}
+		Writer.WriteArrayEnd();
 	}
+}
 
+FRESTResponse FEditorHandler::HandleCapture(const FRESTRequest& Request)
+{
+	FViewport* Viewport = GEditor ? GEditor->GetActiveViewport() : nullptr;
+	FEditorViewportClient* ViewportClient = Viewport ? static_cast<FEditorViewportClient*>(Viewport->GetClient()) : nullptr;
 	if (!ViewportClient)
 	{
 		return FRESTResponse::Error(400, TEXT("NO_VIEWPORT"), TEXT("No active editor viewport"));
 	}
 
-	// Validate JSON body
-	if (!Request.JsonBody.IsValid())
+	TSharedRef<FCaptureRun> Run = MakeShared<FCaptureRun>();
+
+	const FString FormatName = JsonHelpers::GetOptionalString(Request.JsonBody, TEXT("format"), TEXT("jpeg"));
+	if (!FViewportCapture::ParseFormat(FormatName, Run->Settings.Format))
 	{
-		return FRESTResponse::BadRequest(TEXT("Invalid or missing JSON body"));
+		return FRESTResponse::Error(400, TEXT("UNSUPPORTED_FORMAT"),
+			FString::Printf(TEXT("Unsupported capture format '%s' (jpeg or png)"), *FormatName));
 	}
 
-	// Check for animation duration (in seconds)
-	float Duration = static_cast<float>(JsonHelpers::GetOptionalDouble(Request.JsonBody, TEXT("duration"), 0.0));
-	bool bAnimate = Duration > 0.0f;
+	Run->Settings.Quality = JsonHelpers::GetOptionalInt(Request.JsonBody, TEXT("quality"), 85);
+	if (Run->Settings.Quality < 1 || Run->Settings.Quality > 100)
+	{
+		return FRESTResponse::BadRequest(TEXT("quality must be between 1 and 100"));
+	}
+
+	Run->Settings.Width = JsonHelpers::GetOptionalInt(Request.JsonBody, TEXT("width"), 0);
+	Run->Settings.Height = JsonHelpers::GetOptionalInt(Request.JsonBody, TEXT("height"), 0);
+	if (Run->Settings.Width < 0 || Run->Settings.Width > 8192 || Run->Settings.Height < 0 || Run->Settings.Height > 8192)
+	{
+		return FRESTResponse::BadRequest(TEXT("width and height must be between 0 (viewport size) and 8192"));
+	}
+
+	Run->SettleFrames = FMath::Clamp(JsonHelpers::GetOptionalInt(Request.JsonBody, TEXT("settle_frames"), 1), 0, 60);
+
+	const FString Delivery = JsonHelpers::GetOptionalString(Request.JsonBody, TEXT("delivery"), TEXT("inline"));
+	if (Delivery == TEXT("inline"))
+	{
+		Run->Delivery = FCaptureRun::EDelivery::Inline;
+	}
+	else if (Delivery == TEXT("binary"))
+	{
+		Run->Delivery = FCaptureRun::EDelivery::Binary;
+	}
+	else if (Delivery == TEXT("job"))
+	{
+		Run->Delivery = FCaptureRun::EDelivery::Job;
+	}
+	else
+	{
+		return FRESTResponse::BadRequest(FString::Printf(TEXT("Unknown delivery '%s' (inline, binary or job)"), *Delivery));
+	}
+
+	// Sequence: sample a camera path like /editor/camera would animate it, one frame per step
+	const TSharedPtr<FJsonObject>* SequenceObj = nullptr;
+	if (Request.JsonBody.IsValid() && Request.JsonBody->TryGetObjectField(TEXT("sequence"), SequenceObj))
+	{
+		Run->bSequence = true;
+		Run->NumFrames = JsonHelpers::GetOptionalInt(*SequenceObj, TEXT("frames"), 0);
+		if (Run->NumFrames < 2 || Run->NumFrames > MaxSequenceFrames)
+		{
+			return FRESTResponse::BadRequest(FString::Printf(TEXT("sequence.frames must be between 2 and %d"), MaxSequenceFrames));
+		}
+		if (Run->Delivery == FCaptureRun::EDelivery::Binary)
+		{
+			return FRESTResponse::BadRequest(TEXT("Binary delivery returns a single frame; use inline or job for sequences"));
+		}
+
+		AActor* InstantFocusActor = nullptr;
+		FString FocusWarning;
+		BuildCameraAnimation(*SequenceObj, *ViewportClient, true, Run->Path, InstantFocusActor, FocusWarning);
+		if (!FocusWarning.IsEmpty())
+		{
+			return FRESTResponse::Error(404, TEXT("ACTOR_NOT_FOUND"), FocusWarning);
+		}
+
+		// Every pose has to be drawn before it is read back
+		Run->SettleFrames = FMath::Max(Run->SettleFrames, 1);
+	}
+
+	int32 ActiveRuns = 0;
+	for (const TSharedRef<FCaptureRun>& Existing : CaptureRuns)
+	{
+		ActiveRuns += Existing->IsFinished() ? 0 : 1;
+	}
+	if (ActiveRuns >= MaxActiveCaptureRuns)
+	{
+		return FRESTResponse::Error(503, TEXT("CAPTURE_BUSY"),
+			FString::Printf(TEXT("%d captures are already queued"), ActiveRuns));
+	}
+
+	if (Run->Delivery == FCaptureRun::EDelivery::Job)
+	{
+		Run->JobId = FGuid::NewGuid().ToString(EGuidFormats::Digits).ToLower();
+		Run->SubmitTime = FDateTime::UtcNow();
+		StartCaptureRun(Run);
+
+		FRESTJsonWriter Writer;
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("success"), true);
+		WriteCaptureRun(Writer, *Run, false);
+		Writer.WriteObjectEnd();
+		return FRESTResponse::Stream(Writer, 202);
+	}
+
+	// Inline and binary answer once the frames are encoded
+	return FRESTResponse::Defer([this, Run](FRESTResponder Responder)
+	{
+		Run->Responder = MoveTemp(Responder);
+		Run->SubmitTime = FDateTime::UtcNow();
+		StartCaptureRun(Run);
+	});
+}
+
+void FEditorHandler::StartCaptureRun(const TSharedRef<FCaptureRun>& Run)
+{
+	CaptureRuns.Add(Run);
+	if (!CaptureTickHandle.IsValid())
+	{
+		CaptureTickHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FEditorHandler::TickCapture));
+	}
+}
+
+bool FEditorHandler::TickCapture(float DeltaTime)
+{
+	TSharedPtr<FCaptureRun> Active;
+	for (const TSharedRef<FCaptureRun>& Run : CaptureRuns)
+	{
+		if (!Run->IsFinished())
+		{
+			Active = Run;
+			break;
+		}
+	}
+
+	if (!Active.IsValid())
+	{
+		CaptureTickHandle.Reset();
+		return false; // Stop ticking
+	}
+
+	// Waiting for the GPU readback and encoder
+	if (Active->bCapturing)
+	{
+		return true;
+	}
+
+	FViewport* Viewport = GEditor ? GEditor->GetActiveViewport() : nullptr;
+	FEditorViewportClient* ViewportClient = Viewport ? static_cast<FEditorViewportClient*>(Viewport->GetClient()) : nullptr;
+	if (!ViewportClient)
+	{
+		FinishCaptureRun(Active.ToSharedRef(), TEXT("NO_VIEWPORT: No active editor viewport"), 400);
+		return true;
+	}
+
+	// Move to the next pose and let the viewport draw it
+	if (!Active->bPosed)
+	{
+		if (Active->bSequence)
+		{
+			if (Active->Frames.Num() == 0)
+			{
+				StopCameraAnimation();
+			}
+
+			const float Alpha = static_cast<float>(Active->Frames.Num()) / static_cast<float>(Active->NumFrames - 1);
+			FVector Location;
+			FRotator Rotation;
+			EvaluateCameraAnimation(Active->Path, EaseInOut(Alpha), Location, Rotation);
+			ViewportClient->SetViewLocation(Location);
+			ViewportClient->SetViewRotation(Rotation);
+		}
+
+		ViewportClient->Invalidate();
+		Active->SettleUntilFrame = GFrameCounter + Active->SettleFrames;
+		Active->bPosed = true;
+	}
+
+	if (GFrameCounter < Active->SettleUntilFrame)
+	{
+		return true;
+	}
+
+	TWeakPtr<FCaptureRun> WeakRun = Active;
+	FString Error;
+	const bool bStarted = FViewportCapture::Capture(Viewport, Active->Settings, ViewportClient->GetViewLocation(), ViewportClient->GetViewRotation(),
+		[this, WeakRun](TSharedPtr<const FViewportCapture::FFrame> Frame, const FString& CaptureError)
+		{
+			TSharedPtr<FCaptureRun> Pinned = WeakRun.Pin();
+			if (!Pinned.IsValid() || Pinned->IsFinished())
+			{
+				return;
+			}
+
+			Pinned->bCapturing = false;
+			if (!Frame.IsValid())
+			{
+				FinishCaptureRun(Pinned.ToSharedRef(), CaptureError);
+				return;
+			}
+
+			Pinned->Frames.Add(Frame);
+			Pinned->bPosed = false;
+			if (Pinned->Frames.Num() >= Pinned->NumFrames)
+			{
+				FinishCaptureRun(Pinned.ToSharedRef());
+			}
+		}, Error);
+
+	if (!bStarted)
+	{
+		FinishCaptureRun(Active.ToSharedRef(), FString::Printf(TEXT("CAPTURE_UNAVAILABLE: %s"), *Error), 503);
+		return true;
+	}
+
+	Active->bCapturing = true;
+	return true;
+}
+
+void FEditorHandler::FinishCaptureRun(const TSharedRef<FCaptureRun>& Run, const FString& Error, int32 ErrorStatusCode)
+{
+	Run->Status = Error.IsEmpty() ? TEXT("completed") : TEXT("failed");
+	Run->Error = Error;
+	Run->ErrorStatusCode = ErrorStatusCode;
+	Run->EndTime = FDateTime::UtcNow();
+	Run->bCapturing = false;
+
+	if (Run->Responder)
+	{
+		FRESTResponder Responder = MoveTemp(Run->Responder);
+		Run->Responder = nullptr;
+		Responder(MakeCaptureResponse(*Run));
+	}
+
+	if (Run->JobId.IsEmpty())
+	{
+		CaptureRuns.Remove(Run);
+		return;
+	}
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetStringField(TEXT("kind"), TEXT("viewport_capture"));
+	Data->SetStringField(TEXT("status"), Run->Status);
+	Data->SetNumberField(TEXT("frames"), Run->Frames.Num());
+	FEditorEventFeed::Post(EEditorEventTopic::Jobs, TEXT("finished"), Run->JobId, Data);
+
+	// Keep the newest finished jobs
+	int32 FinishedJobs = 0;
+	for (int32 Index = CaptureRuns.Num() - 1; Index >= 0; --Index)
+	{
+		if (CaptureRuns[Index]->IsFinished() && ++FinishedJobs > MaxCaptureJobs)
+		{
+			CaptureRuns.RemoveAt(Index);
+		}
+	}
+}
+
+FRESTResponse FEditorHandler::MakeCaptureResponse(const FCaptureRun& Run)
+{
+	if (!Run.Error.IsEmpty())
+	{
+		FString Code;
+		FString Message;
+		if (!Run.Error.Split(TEXT(": "), &Code, &Message))
+		{
+			Code = TEXT("CAPTURE_FAILED");
+			Message = Run.Error;
+		}
+		return FRESTResponse::Error(Run.ErrorStatusCode, Code, Message);
+	}
+
+	if (Run.Delivery == FCaptureRun::EDelivery::Binary && Run.Frames.Num() > 0)
+	{
+		FRESTResponse Response = MakeFrameResponse(*Run.Frames[0]);
+		Response.Headers.Add(TEXT("Cache-Control"), TEXT("no-store"));
+		return Response;
+	}
+
+	FRESTJsonWriter Writer;
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("success"), true);
+	WriteCaptureRun(Writer, Run, true);
+	Writer.WriteObjectEnd();
+	return FRESTResponse::Stream(Writer);
+}
+
+TSharedPtr<FCaptureRun> FEditorHandler::FindCaptureJob(const FString& JobId) const
+{
+	for (const TSharedRef<FCaptureRun>& Run : CaptureRuns)
+	{
+		if (!Run->JobId.IsEmpty() && Run->JobId == JobId)
+		{
+			return Run;
+		}
+	}
+	return nullptr;
+}
+
+FRESTResponse FEditorHandler::HandleGetCaptureJob(const FRESTRequest& Request, const FString& JobId)
+{
+	TSharedPtr<FCaptureRun> Run = FindCaptureJob(JobId);
+	if (!Run.IsValid())
+	{
+		return FRESTResponse::Error(404, TEXT("JOB_NOT_FOUND"),
+			FString::Printf(TEXT("Capture job not found: %s"), *JobId));
+	}
+
+	// ?data=false lists frames without their bytes; fetch them from /frame/{index}
+	const FString* DataParam = Request.QueryParams.Find(TEXT("data"));
+	const bool bIncludeData = !DataParam || !DataParam->Equals(TEXT("false"), ESearchCase::IgnoreCase);
+
+	FRESTJsonWriter Writer;
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("success"), true);
+	WriteCaptureRun(Writer, *Run, bIncludeData);
+	Writer.WriteObjectEnd();
+	return FRESTResponse::Stream(Writer);
+}
+
+FRESTResponse FEditorHandler::HandleGetCaptureFrame(const FRESTRequest& Request, const FString& JobId, const FString& FrameIndex)
+{
+	TSharedPtr<FCaptureRun> Run = FindCaptureJob(JobId);
+	if (!Run.IsValid())
+	{
+		return FRESTResponse::Error(404, TEXT("JOB_NOT_FOUND"),
+			FString::Printf(TEXT("Capture job not found: %s"), *JobId));
+	}
+
+	const int32 Index = FrameIndex.IsNumeric() ? FCString::Atoi(*FrameIndex) : INDEX_NONE;
+	if (!Run->Frames.IsValidIndex(Index))
+	{
+		return FRESTResponse::Error(404, TEXT("FRAME_NOT_FOUND"),
+			FString::Printf(TEXT("Frame %s has not been captured (%d of %d so far)"), *FrameIndex, Run->Frames.Num(), Run->NumFrames));
+	}
+
+	return MakeFrameResponse(*Run->Frames[Index]);
+}
+
+void FEditorHandler::BuildCameraAnimation(const TSharedPtr<FJsonObject>& Body, const FEditorViewportClient& ViewportClient, bool bAnimate,
+	FCameraAnimation& OutAnim, AActor*& OutInstantFocusActor, FString& OutFocusWarning)
+{
+	OutInstantFocusActor = nullptr;
 
 	// Get current camera state as start
-	FVector StartLocation = ViewportClient->GetViewLocation();
-	FRotator StartRotation = ViewportClient->GetViewRotation();
+	const FVector StartLocation = ViewportClient.GetViewLocation();
+	const FRotator StartRotation = ViewportClient.GetViewRotation();
+	OutAnim.StartLocation = StartLocation;
+	OutAnim.StartRotation = StartRotation;
 
 	// Parse target location
 	FVector TargetLocation = StartLocation;
-	if (Request.JsonBody->HasField(TEXT("location")))
+	if (Body->HasField(TEXT("location")))
 	{
-		JsonHelpers::JsonToVector(Request.JsonBody->GetObjectField(TEXT("location")), TargetLocation);
+		JsonHelpers::JsonToVector(Body->GetObjectField(TEXT("location")), TargetLocation);
 	}
 
 	// Parse target rotation
 	FRotator TargetRotation = StartRotation;
-	if (Request.JsonBody->HasField(TEXT("rotation")))
+	if (Body->HasField(TEXT("rotation")))
 	{
-		JsonHelpers::JsonToRotator(Request.JsonBody->GetObjectField(TEXT("rotation")), TargetRotation);
+		JsonHelpers::JsonToRotator(Body->GetObjectField(TEXT("rotation")), TargetRotation);
 	}
 
 	// Orbit mode: specify target point, angle (direction from target to camera), and distance
-	bool bOrbitMode = Request.JsonBody->HasField(TEXT("orbit"));
-	FVector OrbitTarget = FVector::ZeroVector;
-	FRotator StartAngle = FRotator::ZeroRotator;
-	FRotator EndAngle = FRotator::ZeroRotator;
-	float StartDistance = 1000.0f;
-	float EndDistance = 1000.0f;
-
-	if (bOrbitMode)
+	OutAnim.bOrbitMode = Body->HasField(TEXT("orbit"));
+	if (OutAnim.bOrbitMode)
 	{
-		TSharedPtr<FJsonObject> OrbitObj = Request.JsonBody->GetObjectField(TEXT("orbit"));
+		TSharedPtr<FJsonObject> OrbitObj = Body->GetObjectField(TEXT("orbit"));
 
 		// Get orbit target - the point camera will look at (defaults to origin)
+		OutAnim.OrbitTarget = FVector::ZeroVector;
 		if (OrbitObj->HasField(TEXT("target")))
 		{
-			JsonHelpers::JsonToVector(OrbitObj->GetObjectField(TEXT("target")), OrbitTarget);
+			JsonHelpers::JsonToVector(OrbitObj->GetObjectField(TEXT("target")), OutAnim.OrbitTarget);
 		}
 
 		// Get end distance from target (defaults to 1000 units)
-		EndDistance = static_cast<float>(JsonHelpers::GetOptionalDouble(OrbitObj, TEXT("distance"), 1000.0));
+		OutAnim.EndDistance = static_cast<float>(JsonHelpers::GetOptionalDouble(OrbitObj, TEXT("distance"), 1000.0));
 
 		// Get end angle - direction FROM target TO camera (pitch/yaw)
+		OutAnim.EndAngle = FRotator::ZeroRotator;
 		if (OrbitObj->HasField(TEXT("angle")))
 		{
-			JsonHelpers::JsonToRotator(OrbitObj->GetObjectField(TEXT("angle")), EndAngle);
+			JsonHelpers::JsonToRotator(OrbitObj->GetObjectField(TEXT("angle")), OutAnim.EndAngle);
 		}
 
 		// Calculate start angle and distance from current camera position
-		FVector ToCamera = StartLocation - OrbitTarget;
-		StartDistance = ToCamera.Size();
-		if (StartDistance > KINDA_SMALL_NUMBER)
+		FVector ToCamera = StartLocation - OutAnim.OrbitTarget;
+		OutAnim.StartDistance = ToCamera.Size();
+		OutAnim.StartAngle = FRotator::ZeroRotator;
+		if (OutAnim.StartDistance > KINDA_SMALL_NUMBER)
 		{
-			StartAngle = ToCamera.Rotation();
+			OutAnim.StartAngle = ToCamera.Rotation();
 		}
 
 		// Calculate final camera position for response
-		FVector OffsetDirection = EndAngle.Vector();
-		TargetLocation = OrbitTarget + (OffsetDirection * EndDistance);
+		FVector OffsetDirection = OutAnim.EndAngle.Vector();
+		TargetLocation = OutAnim.OrbitTarget + (OffsetDirection * OutAnim.EndDistance);
 
 		// Camera rotation: look back at target
-		FVector LookDirection = OrbitTarget - TargetLocation;
+		FVector LookDirection = OutAnim.OrbitTarget - TargetLocation;
 		TargetRotation = LookDirection.Rotation();
 	}
 
 	// Focus on actor if specified (overrides location/rotation target)
-	FString FocusLabel = JsonHelpers::GetOptionalString(Request.JsonBody, TEXT("focus_actor"), TEXT(""));
-	FString FocusWarning;
+	FString FocusLabel = JsonHelpers::GetOptionalString(Body, TEXT("focus_actor"), TEXT(""));
 	if (!FocusLabel.IsEmpty())
 	{
 		AActor* FocusActor = ActorUtils::FindActorByLabel(FocusLabel);
@@ -307,57 +767,79 @@ FRESTResponse FEditorHandler::HandleCamera(const FRESTRequest& Request)
 			}
 			else
 			{
-				// Instant focus
-				ViewportClient->FocusViewportOnBox(FocusActor->GetComponentsBoundingBox());
+				// Instant focus is applied by the caller
+				OutInstantFocusActor = FocusActor;
 			}
 		}
 		else
 		{
-			FocusWarning = FString::Printf(TEXT("Focus actor '%s' not found"), *FocusLabel);
+			OutFocusWarning = FString::Printf(TEXT("Focus actor '%s' not found"), *FocusLabel);
 		}
 	}
 
+	OutAnim.EndLocation = TargetLocation;
+	OutAnim.EndRotation = TargetRotation;
+}
+
+FRESTResponse FEditorHandler::HandleCamera(const FRESTRequest& Request)
+{
+	FEditorViewportClient* ViewportClient = nullptr;
+	if (GEditor && GEditor->GetActiveViewport())
+	{
+		ViewportClient = static_cast<FEditorViewportClient*>(GEditor->GetActiveViewport()->GetClient());
+	}
+
+	if (!ViewportClient)
+	{
+		return FRESTResponse::Error(400, TEXT("NO_VIEWPORT"), TEXT("No active editor viewport"));
+	}
+
+	// Validate JSON body
+	if (!Request.JsonBody.IsValid())
+	{
+		return FRESTResponse::BadRequest(TEXT("Invalid or missing JSON body"));
+	}
+
+	// Check for animation duration (in seconds)
+	float Duration = static_cast<float>(JsonHelpers::GetOptionalDouble(Request.JsonBody, TEXT("duration"), 0.0));
+	bool bAnimate = Duration > 0.0f;
+
+	FCameraAnimation Anim;
+	AActor* InstantFocusActor = nullptr;
+	FString FocusWarning;
+	BuildCameraAnimation(Request.JsonBody, *ViewportClient, bAnimate, Anim, InstantFocusActor, FocusWarning);
+
+	if (InstantFocusActor)
+	{
+		ViewportClient->FocusViewportOnBox(InstantFocusActor->GetComponentsBoundingBox());
+	}
+
+	const bool bOrbitMode = Anim.bOrbitMode;
+	const FVector& StartLocation = Anim.StartLocation;
+	const FRotator& StartRotation = Anim.StartRotation;
+	const FVector& TargetLocation = Anim.EndLocation;
+	const FRotator& TargetRotation = Anim.EndRotation;
+
 	// Apply camera change
 	if (bAnimate)
 	{
-		// Stop any existing animation - use bIsActive flag instead of TickHandle.IsValid()
-		// because Live Coding can invalidate the weak pointer in TickHandle
-		if (CameraAnim.bIsActive)
-		{
-			CameraAnim.bIsActive = false;
-			// Try to remove the ticker, but don't crash if the handle is stale
-			FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
-			TickHandle.Reset();
-		}
+		// Stop any existing animation
+		StopCameraAnimation();
 
 		// Set up animation state
-		CameraAnim.bOrbitMode = bOrbitMode;
+		CameraAnim = Anim;
 		CameraAnim.Duration = Duration;
 		CameraAnim.ElapsedTime = 0.0f;
 		CameraAnim.bIsActive = true;
 
-		if (bOrbitMode)
-		{
-			// Orbit animation: SLERP the angle around target
-			CameraAnim.OrbitTarget = OrbitTarget;
-			CameraAnim.StartAngle = StartAngle;
-			CameraAnim.EndAngle = EndAngle;
-			CameraAnim.StartDistance = StartDistance;
-			CameraAnim.EndDistance = EndDistance;
-		}
-		else
-		{
-			// Linear animation: interpolate position directly
-			CameraAnim.StartLocation = StartLocation;
-			CameraAnim.EndLocation = TargetLocation;
-			CameraAnim.StartRotation = StartRotation;
-			CameraAnim.EndRotation = TargetRotation;
-		}
-
 		// Register tick handler
 		TickHandle = FTSTicker::GetCoreTicker().AddTicker(
 			FTickerDelegate::CreateRaw(this, &FEditorHandler::TickCameraAnimation));
 
+		TSharedPtr<FJsonObject> EventData = MakeShared<FJsonObject>();
+		EventData->SetNumberField(TEXT("duration"), Duration);
+		FEditorEventFeed::Post(EEditorEventTopic::Camera, TEXT("animation_started"), TEXT("viewport"), EventData);
+
 		TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
 		Response->SetBoolField(TEXT("success"), true);
 		Response->SetBoolField(TEXT("animating"), true);
@@ -369,9 +851,9 @@ FRESTResponse FEditorHandler::HandleCamera(const FRESTRequest& Request)
 		Response->SetObjectField(TEXT("end_rotation"), JsonHelpers::RotatorToJson(TargetRotation));
 		if (bOrbitMode)
 		{
-			Response->SetObjectField(TEXT("orbit_target"), JsonHelpers::VectorToJson(OrbitTarget));
-			Response->SetObjectField(TEXT("start_angle"), JsonHelpers::RotatorToJson(StartAngle));
-			Response->SetObjectField(TEXT("end_angle"), JsonHelpers::RotatorToJson(EndAngle));
+			Response->SetObjectField(TEXT("orbit_target"), JsonHelpers::VectorToJson(CameraAnim.OrbitTarget));
+			Response->SetObjectField(TEXT("start_angle"), JsonHelpers::RotatorToJson(CameraAnim.StartAngle));
+			Response->SetObjectField(TEXT("end_angle"), JsonHelpers::RotatorToJson(CameraAnim.EndAngle));
 		}
 		if (!FocusWarning.IsEmpty())
 		{
@@ -756,6 +1238,23 @@ FRESTResponse FEditorHandler::HandleLiveCoding(const FRESTRequest& Request)
 	Response->SetStringField(TEXT("message"), Message);
 	Response->SetBoolField(TEXT("waited"), bWaitForCompletion);
 
+	if (Result == ELiveCodingCompileResult::InProgress)
+	{
+		// Report the outcome to /events once the compile ends
+		FEditorEventFeed::Post(EEditorEventTopic::LiveCoding, TEXT("compile_started"), TEXT("live_coding"));
+		if (!LiveCodingTickHandle.IsValid())
+		{
+			LiveCodingTickHandle = FTSTicker::GetCoreTicker().AddTicker(
+				FTickerDelegate::CreateRaw(this, &FEditorHandler::TickLiveCodingWatch), 0.25f);
+		}
+	}
+	else if (bStarted || bWaitForCompletion)
+	{
+		TSharedPtr<FJsonObject> EventData = MakeShared<FJsonObject>();
+		EventData->SetStringField(TEXT("result"), ResultStr);
+		FEditorEventFeed::Post(EEditorEventTopic::LiveCoding, TEXT("compile_finished"), TEXT("live_coding"), EventData);
+	}
+
 	// If failed and waited, indicate that errors are in the Output Log
 	if (!bSuccess && bWaitForCompletion && Result == ELiveCodingCompileResult::Failure)
 	{
@@ -765,6 +1264,20 @@ FRESTResponse FEditorHandler::HandleLiveCoding(const FRESTRequest& Request)
 	return FRESTResponse::Ok(Response);
 }
 
+bool FEditorHandler::TickLiveCodingWatch(float DeltaTime)
+{
+	ILiveCodingModule* LiveCoding = FModuleManager::GetModulePtr<ILiveCodingModule>(LIVE_CODING_MODULE_NAME);
+	if (LiveCoding && LiveCoding->IsCompiling())
+	{
+		return true;
+	}
+
+	// The module does not report the result of a compile it ran in the background
+	FEditorEventFeed::Post(EEditorEventTopic::LiveCoding, TEXT("compile_finished"), TEXT("live_coding"));
+	LiveCodingTickHandle.Reset();
+	return false;
+}
+
 FRESTResponse FEditorHandler::HandleLiveCodingStatus(const FRESTRequest& Request)
 {
 	ILiveCodingModule* LiveCoding = FModuleManager::GetModulePtr<ILiveCodingModule>(LIVE_CODING_MODULE_NAME);
@@ -890,7 +1403,13 @@ TArray<TSharedPtr<FJsonObject>> FEditorHandler::GetEndpointSchemas() const
 
 	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("GET")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/editor/project")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Get project metadata (name, path, engine version)"));
 	
-	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("POST")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/editor/screenshot")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Capture viewport screenshot (body: path)"));
+	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("POST")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/editor/screenshot")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Capture viewport screenshot to a file (body: path); see /editor/capture for in-memory frames"));
+
+	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("POST")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/editor/capture")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Capture viewport frames in memory (body: format=jpeg|png, quality, width, height, settle_frames, delivery=inline|binary|job, sequence{frames, location, rotation, orbit, focus_actor})"));
+
+	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("GET")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/editor/capture/{id}")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Capture job status and frames (query: data=false omits base64 bytes)"));
+
+	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("GET")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/editor/capture/{id}/frame/{index}")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("One captured frame as raw image bytes"));
 	
 	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("POST")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/editor/camera")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Move viewport camera (body: location, rotation, duration, orbit, focus_actor)"));
 	
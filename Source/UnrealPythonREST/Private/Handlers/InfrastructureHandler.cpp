@@ -1,36 +1,89 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Handlers/InfrastructureHandler.h"
+#include "Utils/EditCoalescer.h"
+#include "Utils/EditorEventFeed.h"
+#include "RESTMetrics.h"
+#include "RESTResponseCache.h"
+#include "RESTJsonWriter.h"
+#include "ConfigWriter.h"
 #include "Misc/App.h"
 #include "Misc/EngineVersion.h"
-#include "Internationalization/Regex.h"
+#include "Async/ParallelFor.h"
 
 void FInfrastructureHandler::RegisterRoutes(FRESTRouter& Router)
 {
 	RouterRef = &Router;
 
+	// Health output changes once, when startup completes
+	const FRESTRouteVersion HealthVersion = FRESTRouteVersion::CreateLambda([this](const FRESTRequest&) -> uint64
+	{
+		return RouterRef->IsReady() ? 2 : 1;
+	});
+
+	// Health, schema and metrics answer while the remaining startup work is deferred
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/health"),
-		FRESTRouteHandler::CreateRaw(this, &FInfrastructureHandler::HandleHealth));
+		FRESTRouteHandler::CreateRaw(this, &FInfrastructureHandler::HandleHealth),
+		FRESTRouteOptions::Versioned(HealthVersion).ThreadSafe().DuringStartup());
 
+	// Schema changes only with the route set; its content hash is the version
+	SchemaCache = MakeUnique<FRESTSchemaCache>(Router);
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/schema"),
-		FRESTRouteHandler::CreateRaw(this, &FInfrastructureHandler::HandleSchema));
+		FRESTRouteHandler::CreateRaw(this, &FInfrastructureHandler::HandleSchema),
+		FRESTRouteOptions::Versioned(FRESTRouteVersion::CreateLambda([this](const FRESTRequest&) -> uint64
+		{
+			return SchemaCache->Get()->Hash;
+		})).ThreadSafe().DuringStartup());
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/batch"),
 		FRESTRouteHandler::CreateRaw(this, &FInfrastructureHandler::HandleBatch));
 
-	UE_LOG(LogTemp, Log, TEXT("InfrastructureHandler: Registered /health, /schema, and /batch"));
+	Router.RegisterRoute(ERESTMethod::GET, TEXT("/events"),
+		FRESTRouteHandler::CreateRaw(this, &FInfrastructureHandler::HandleEvents));
+
+	// Counters are atomics; scraping must not wait for the game thread
+	Router.RegisterRoute(ERESTMethod::GET, TEXT("/metrics"),
+		FRESTRouteHandler::CreateRaw(this, &FInfrastructureHandler::HandleMetrics),
+		FRESTRouteOptions().ThreadSafe().DuringStartup());
+
+	Router.RegisterRoute(ERESTMethod::DELETE, TEXT("/metrics"),
+		FRESTRouteHandler::CreateRaw(this, &FInfrastructureHandler::HandleResetMetrics),
+		FRESTRouteOptions().ThreadSafe());
+
+	UE_LOG(LogTemp, Log, TEXT("InfrastructureHandler: Registered /health, /schema, /batch, /events, and /metrics"));
 }
 
 FRESTResponse FInfrastructureHandler::HandleHealth(const FRESTRequest& Request)
 {
+	// Ready first: ReadySeconds is written before the flag is set
+	const bool bReady = RouterRef->IsReady();
+	const FRESTRouter::FStartupInfo& Startup = RouterRef->GetStartupInfo();
+
 	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
 	Response->SetBoolField(TEXT("healthy"), true);
-	Response->SetStringField(TEXT("status"), TEXT("running"));
+	Response->SetStringField(TEXT("status"), bReady ? TEXT("running") : TEXT("starting"));
+	Response->SetBoolField(TEXT("ready"), bReady);
+	Response->SetNumberField(TEXT("port"), RouterRef->GetPort());
+	Response->SetNumberField(TEXT("requested_port"), Startup.RequestedPort);
+
+	// Module startup to listening, and to fully initialized (null until ready)
+	TSharedPtr<FJsonObject> StartupMs = MakeShared<FJsonObject>();
+	StartupMs->SetNumberField(TEXT("listen"), Startup.ListenSeconds * 1000.0);
+	if (bReady)
+	{
+		StartupMs->SetNumberField(TEXT("ready"), Startup.ReadySeconds * 1000.0);
+	}
+	else
+	{
+		StartupMs->SetField(TEXT("ready"), MakeShared<FJsonValueNull>());
+	}
+	Response->SetObjectField(TEXT("startup_ms"), StartupMs);
 
 	// Server info
 	TSharedPtr<FJsonObject> Server = MakeShared<FJsonObject>();
 	Server->SetStringField(TEXT("name"), TEXT("UnrealPythonREST"));
 	Server->SetStringField(TEXT("version"), TEXT("2.0.0"));
+	Server->SetStringField(TEXT("instance_id"), FConfigWriter::GetInstanceId());
 	Response->SetObjectField(TEXT("server"), Server);
 
 	// Engine info
@@ -57,249 +110,157 @@ FRESTResponse FInfrastructureHandler::HandleHealth(const FRESTRequest& Request)
 	return FRESTResponse::Ok(Response);
 }
 
+void FInfrastructureHandler::PrewarmSchema()
+{
+	if (SchemaCache.IsValid())
+	{
+		SchemaCache->Get();
+	}
+}
+
 FRESTResponse FInfrastructureHandler::HandleSchema(const FRESTRequest& Request)
 {
-	if (!RouterRef)
+	if (!SchemaCache.IsValid())
 	{
 		return FRESTResponse::ServerError(TEXT("Router not available"));
 	}
 
+	const FRESTSchemaCache::FSnapshotRef Snapshot = SchemaCache->Get();
+	const ERESTWireFormat Format = FRESTJsonWriter::GetThreadFormat();
+
 	// Check for handler filter first
 	const FString* HandlerParam = Request.QueryParams.Find(TEXT("handler"));
 	if (HandlerParam && !HandlerParam->IsEmpty())
 	{
-		TSharedPtr<FJsonObject> Schema = BuildHandlerSchema(*HandlerParam);
-		return FRESTResponse::Ok(Schema);
+		const FRESTSchemaCache::FBody* Body = Snapshot->FindHandler(*HandlerParam);
+		if (!Body)
+		{
+			return SchemaNotFound(FString::Printf(TEXT("Handler '%s' not found"), **HandlerParam),
+				TEXT("available_handlers"), Snapshot->HandlerNames);
+		}
+		return Body->ToResponse(Format);
 	}
 
 	// Check for endpoint filter
 	const FString* EndpointParam = Request.QueryParams.Find(TEXT("endpoint"));
 	if (EndpointParam && !EndpointParam->IsEmpty())
 	{
-		TSharedPtr<FJsonObject> Schema = BuildEndpointSchema(*EndpointParam);
-		return FRESTResponse::Ok(Schema);
-	}
-
-	// Default: full schema
-	TSharedPtr<FJsonObject> Schema = BuildFullSchema();
-	return FRESTResponse::Ok(Schema);
-}
-
-TSharedPtr<FJsonObject> FInfrastructureHandler::BuildSchema(const TArray<TSharedPtr<IRESTHandler>>& Handlers)
-{
-	TSharedPtr<FJsonObject> Schema = MakeShared<FJsonObject>();
-	Schema->SetStringField(TEXT("api_version"), TEXT("v1"));
-	Schema->SetStringField(TEXT("base_path"), TEXT("/api/v1"));
-
-	// Document units
-	TSharedPtr<FJsonObject> Units = MakeShared<FJsonObject>();
-	Units->SetStringField(TEXT("distance"), TEXT("centimeters (100 = 1 meter)"));
-	Units->SetStringField(TEXT("rotation"), TEXT("degrees (90 = quarter turn)"));
-	Units->SetStringField(TEXT("scale"), TEXT("multiplier (1.0 = normal size)"));
-	Schema->SetObjectField(TEXT("units"), Units);
-
-	// Error codes
-	TSharedPtr<FJsonObject> ErrorCodes = MakeShared<FJsonObject>();
-	ErrorCodes->SetStringField(TEXT("INVALID_PARAMS"), TEXT("400 - Missing or malformed parameters"));
-	ErrorCodes->SetStringField(TEXT("ASSET_NOT_FOUND"), TEXT("404 - Asset path doesn't exist"));
-	ErrorCodes->SetStringField(TEXT("ACTOR_NOT_FOUND"), TEXT("404 - Actor label not in level"));
-	ErrorCodes->SetStringField(TEXT("CLASS_NOT_FOUND"), TEXT("404 - Class path invalid"));
-	ErrorCodes->SetStringField(TEXT("NO_LEVEL_LOADED"), TEXT("400 - No level currently open"));
-	ErrorCodes->SetStringField(TEXT("EXECUTION_ERROR"), TEXT("500 - Runtime error"));
-	Schema->SetObjectField(TEXT("error_codes"), ErrorCodes);
-
-	// List handlers
-	TArray<TSharedPtr<FJsonValue>> HandlersArray;
-	for (const TSharedPtr<IRESTHandler>& Handler : Handlers)
-	{
-		if (Handler.IsValid())
+		const FRESTSchemaCache::FBody* Body = Snapshot->FindEndpoint(*EndpointParam);
+		if (!Body)
 		{
-			TSharedPtr<FJsonObject> HandlerJson = MakeShared<FJsonObject>();
-			HandlerJson->SetStringField(TEXT("name"), Handler->GetHandlerName());
-			HandlerJson->SetStringField(TEXT("base_path"), Handler->GetBasePath());
-			HandlerJson->SetStringField(TEXT("description"), Handler->GetDescription());
-			HandlersArray.Add(MakeShared<FJsonValueObject>(HandlerJson));
+			return SchemaNotFound(FString::Printf(TEXT("Endpoint '%s' not found"), **EndpointParam),
+				TEXT("available_endpoints"), Snapshot->EndpointPaths);
 		}
+		return Body->ToResponse(Format);
 	}
-	Schema->SetArrayField(TEXT("handlers"), HandlersArray);
 
-	return Schema;
+	// Default: full schema
+	return Snapshot->Full.ToResponse(Format);
 }
 
-TSharedPtr<FJsonObject> FInfrastructureHandler::BuildFullSchema()
+FRESTResponse FInfrastructureHandler::HandleEvents(const FRESTRequest& Request)
 {
-	TSharedPtr<FJsonObject> Schema = BuildSchema(RouterRef->GetHandlers());
-
-	// Add endpoint details for each handler
-	TArray<TSharedPtr<FJsonValue>> HandlersArray;
-	for (const TSharedPtr<IRESTHandler>& Handler : RouterRef->GetHandlers())
+	EEditorEventTopic Topics = EEditorEventTopic::All;
+	if (const FString* TopicsPtr = Request.QueryParams.Find(TEXT("topics")))
 	{
-		if (Handler.IsValid())
+		FString Error;
+		if (!FEditorEventFeed::ParseTopics(*TopicsPtr, Topics, Error))
 		{
-			TSharedPtr<FJsonObject> HandlerJson = MakeShared<FJsonObject>();
-			HandlerJson->SetStringField(TEXT("name"), Handler->GetHandlerName());
-			HandlerJson->SetStringField(TEXT("base_path"), Handler->GetBasePath());
-			HandlerJson->SetStringField(TEXT("description"), Handler->GetDescription());
-
-			// Add endpoint schemas
-			TArray<TSharedPtr<FJsonObject>> EndpointSchemas = Handler->GetEndpointSchemas();
-			TArray<TSharedPtr<FJsonValue>> EndpointsArray;
-			for (const TSharedPtr<FJsonObject>& Endpoint : EndpointSchemas)
-			{
-				EndpointsArray.Add(MakeShared<FJsonValueObject>(Endpoint));
-			}
-			HandlerJson->SetArrayField(TEXT("endpoints"), EndpointsArray);
-
-			HandlersArray.Add(MakeShared<FJsonValueObject>(HandlerJson));
+			return FRESTResponse::BadRequest(Error);
 		}
 	}
-	Schema->SetArrayField(TEXT("handlers"), HandlersArray);
 
-	return Schema;
-}
-
-TSharedPtr<FJsonObject> FInfrastructureHandler::BuildHandlerSchema(const FString& HandlerName)
-{
-	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
-
-	TSharedPtr<IRESTHandler> Handler = FindHandlerByName(HandlerName);
-	if (!Handler.IsValid())
+	// Without a cursor the client starts from now and only sees what happens next
+	uint64 Since = FEditorEventFeed::GetSequence();
+	if (const FString* SincePtr = Request.QueryParams.Find(TEXT("since")))
 	{
-		Response->SetBoolField(TEXT("success"), false);
-		Response->SetStringField(TEXT("error"), FString::Printf(TEXT("Handler '%s' not found"), *HandlerName));
-
-		// List available handlers
-		TArray<TSharedPtr<FJsonValue>> AvailableHandlers;
-		for (const TSharedPtr<IRESTHandler>& H : RouterRef->GetHandlers())
-		{
-			if (H.IsValid())
-			{
-				AvailableHandlers.Add(MakeShared<FJsonValueString>(H->GetHandlerName()));
-			}
-		}
-		Response->SetArrayField(TEXT("available_handlers"), AvailableHandlers);
-		return Response;
+		Since = FCString::Strtoui64(**SincePtr, nullptr, 10);
 	}
 
-	Response->SetBoolField(TEXT("success"), true);
-	Response->SetStringField(TEXT("name"), Handler->GetHandlerName());
-	Response->SetStringField(TEXT("base_path"), Handler->GetBasePath());
-	Response->SetStringField(TEXT("description"), Handler->GetDescription());
+	// Stay under the 60s idle timeout common to HTTP clients and proxies
+	double TimeoutSeconds = 25.0;
+	if (const FString* TimeoutPtr = Request.QueryParams.Find(TEXT("timeout")))
+	{
+		TimeoutSeconds = FMath::Clamp(FCString::Atod(**TimeoutPtr), 0.0, 55.0);
+	}
 
-	// Add endpoint schemas
-	TArray<TSharedPtr<FJsonObject>> EndpointSchemas = Handler->GetEndpointSchemas();
-	TArray<TSharedPtr<FJsonValue>> EndpointsArray;
-	for (const TSharedPtr<FJsonObject>& Endpoint : EndpointSchemas)
+	int32 Limit = 500;
+	if (const FString* LimitPtr = Request.QueryParams.Find(TEXT("limit")))
 	{
-		EndpointsArray.Add(MakeShared<FJsonValueObject>(Endpoint));
+		Limit = FMath::Clamp(FCString::Atoi(**LimitPtr), 1, 5000);
 	}
-	Response->SetArrayField(TEXT("endpoints"), EndpointsArray);
 
-	return Response;
+	return FRESTResponse::Defer([Topics, Since, TimeoutSeconds, Limit](FRESTResponder Responder)
+	{
+		FEditorEventFeed::Wait(Topics, Since, TimeoutSeconds, Limit, MoveTemp(Responder));
+	});
 }
 
-TSharedPtr<FJsonObject> FInfrastructureHandler::BuildEndpointSchema(const FString& EndpointPath)
+FRESTResponse FInfrastructureHandler::HandleMetrics(const FRESTRequest& Request)
 {
-	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
-
-	// Search all handlers for matching endpoint
-	for (const TSharedPtr<IRESTHandler>& Handler : RouterRef->GetHandlers())
+	if (!RouterRef)
 	{
-		if (!Handler.IsValid())
-		{
-			continue;
-		}
-
-		TArray<TSharedPtr<FJsonObject>> EndpointSchemas = Handler->GetEndpointSchemas();
-		for (const TSharedPtr<FJsonObject>& Endpoint : EndpointSchemas)
-		{
-			FString Path;
-			if (Endpoint->TryGetStringField(TEXT("path"), Path))
-			{
-				// Match exact path or with leading slash normalization
-				if (Path.Equals(EndpointPath, ESearchCase::IgnoreCase) ||
-					(TEXT("/") + Path).Equals(EndpointPath, ESearchCase::IgnoreCase) ||
-					Path.Equals(TEXT("/") + EndpointPath, ESearchCase::IgnoreCase))
-				{
-					Response->SetBoolField(TEXT("success"), true);
-					Response->SetStringField(TEXT("handler"), Handler->GetHandlerName());
-
-					// Copy all fields from the endpoint schema
-					for (const auto& Field : Endpoint->Values)
-					{
-						Response->SetField(Field.Key, Field.Value);
-					}
-					return Response;
-				}
-			}
-		}
+		return FRESTResponse::ServerError(TEXT("Router not available"));
 	}
 
-	// Endpoint not found
-	Response->SetBoolField(TEXT("success"), false);
-	Response->SetStringField(TEXT("error"), FString::Printf(TEXT("Endpoint '%s' not found"), *EndpointPath));
+	const FRESTMetrics& Metrics = RouterRef->GetMetrics();
+	const int32 Queued = RouterRef->GetQueuedRequests();
 
-	// List all available endpoints
-	TArray<TSharedPtr<FJsonValue>> AvailableEndpoints;
-	for (const TSharedPtr<IRESTHandler>& Handler : RouterRef->GetHandlers())
+	FRESTResponse Response;
+	const FString* FormatPtr = Request.QueryParams.Find(TEXT("format"));
+	if (FormatPtr && FormatPtr->Equals(TEXT("json"), ESearchCase::IgnoreCase))
 	{
-		if (!Handler.IsValid())
-		{
-			continue;
-		}
-
-		TArray<TSharedPtr<FJsonObject>> EndpointSchemas = Handler->GetEndpointSchemas();
-		for (const TSharedPtr<FJsonObject>& Endpoint : EndpointSchemas)
-		{
-			FString Path;
-			if (Endpoint->TryGetStringField(TEXT("path"), Path))
-			{
-				AvailableEndpoints.Add(MakeShared<FJsonValueString>(Path));
-			}
-		}
+		FRESTJsonWriter Writer;
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("success"), true);
+		Metrics.WriteJson(Writer, Queued);
+		Writer.WriteObjectStart(TEXT("response_cache"));
+		RouterRef->GetResponseCache().WriteJson(Writer);
+		Writer.WriteObjectEnd();
+		Writer.WriteObjectEnd();
+		Response = FRESTResponse::Stream(Writer);
+	}
+	else
+	{
+		// Prometheus text exposition format
+		Response.RawBody = Metrics.ToPrometheus(Queued) + RouterRef->GetResponseCache().ToPrometheus();
+		Response.ContentType = TEXT("text/plain; version=0.0.4; charset=utf-8");
 	}
-	Response->SetArrayField(TEXT("available_endpoints"), AvailableEndpoints);
 
+	Response.Headers.Add(TEXT("Cache-Control"), TEXT("no-store"));
 	return Response;
 }
 
-TSharedPtr<IRESTHandler> FInfrastructureHandler::FindHandlerByName(const FString& Name)
+FRESTResponse FInfrastructureHandler::HandleResetMetrics(const FRESTRequest& Request)
 {
-	for (const TSharedPtr<IRESTHandler>& Handler : RouterRef->GetHandlers())
+	if (!RouterRef)
 	{
-		if (Handler.IsValid() && Handler->GetHandlerName().Equals(Name, ESearchCase::IgnoreCase))
-		{
-			return Handler;
-		}
+		return FRESTResponse::ServerError(TEXT("Router not available"));
 	}
-	return nullptr;
+
+	RouterRef->GetMetrics().Reset();
+
+	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+	Response->SetBoolField(TEXT("success"), true);
+	Response->SetStringField(TEXT("message"), TEXT("Metrics reset"));
+	return FRESTResponse::Ok(Response);
 }
 
-TSharedPtr<IRESTHandler> FInfrastructureHandler::FindHandlerByEndpoint(const FString& EndpointPath)
+FRESTResponse FInfrastructureHandler::SchemaNotFound(const FString& Error, const TCHAR* ListField, const TArray<FString>& Available)
 {
-	TSharedPtr<IRESTHandler> BestMatch = nullptr;
-	int32 BestMatchLength = 0;
+	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+	Response->SetBoolField(TEXT("success"), false);
+	Response->SetStringField(TEXT("error"), Error);
 
-	for (const TSharedPtr<IRESTHandler>& Handler : RouterRef->GetHandlers())
+	TArray<TSharedPtr<FJsonValue>> AvailableArray;
+	AvailableArray.Reserve(Available.Num());
+	for (const FString& Name : Available)
 	{
-		if (!Handler.IsValid())
-		{
-			continue;
-		}
-
-		FString BasePath = Handler->GetBasePath();
-		if (EndpointPath.StartsWith(BasePath, ESearchCase::IgnoreCase))
-		{
-			// Prefer longer (more specific) base paths
-			if (BasePath.Len() > BestMatchLength)
-			{
-				BestMatch = Handler;
-				BestMatchLength = BasePath.Len();
-			}
-		}
+		AvailableArray.Add(MakeShared<FJsonValueString>(Name));
 	}
+	Response->SetArrayField(ListField, AvailableArray);
 
-	return BestMatch;
+	return FRESTResponse::Ok(Response);
 }
 
 FRESTResponse FInfrastructureHandler::HandleBatch(const FRESTRequest& Request)
@@ -318,6 +279,8 @@ FRESTResponse FInfrastructureHandler::HandleBatch(const FRESTRequest& Request)
 
 	// Get options
 	bool bStopOnError = true;
+	bool bParallel = true;
+	bool bCoalesce = false;
 	if (Request.JsonBody->HasField(TEXT("options")))
 	{
 		TSharedPtr<FJsonObject> Options = Request.JsonBody->GetObjectField(TEXT("options"));
@@ -325,196 +288,394 @@ FRESTResponse FInfrastructureHandler::HandleBatch(const FRESTRequest& Request)
 		{
 			bStopOnError = Options->GetBoolField(TEXT("stop_on_error"));
 		}
+		if (Options.IsValid() && Options->HasField(TEXT("parallel")))
+		{
+			bParallel = Options->GetBoolField(TEXT("parallel"));
+		}
+		if (Options.IsValid() && Options->HasField(TEXT("coalesce")))
+		{
+			bCoalesce = Options->GetBoolField(TEXT("coalesce"));
+		}
+	}
+
+	// Parse every sub-request and its $N references up front
+	TArray<FBatchEntry> Entries;
+	Entries.SetNum(RequestsArray->Num());
+	for (int32 Index = 0; Index < RequestsArray->Num(); Index++)
+	{
+		ParseBatchEntry((*RequestsArray)[Index], Index, Entries[Index]);
 	}
 
-	// Store results for variable resolution
+	// Results are indexed like the requests so $N always finds request N
 	TArray<TSharedPtr<FJsonObject>> Results;
-	int32 Completed = 0;
-	int32 Failed = 0;
+	Results.SetNum(Entries.Num());
+	TArray<bool> Succeeded;
+	Succeeded.SetNumZeroed(Entries.Num());
 
-	for (int32 Index = 0; Index < RequestsArray->Num(); Index++)
+	// With stop_on_error, nothing at or after the first failure + 1 is reported
+	int32 EndIndex = Entries.Num();
+
+	// Coalesce: one undo entry, and recompiles/refreshes/saves run once per asset at the end
+	TOptional<FEditCoalescer::FScope> CoalesceScope;
+	if (bCoalesce)
 	{
-		TSharedPtr<FJsonObject> ReqObj = (*RequestsArray)[Index]->AsObject();
-		if (!ReqObj.IsValid())
-		{
-			TSharedPtr<FJsonObject> ErrorResult = MakeShared<FJsonObject>();
-			ErrorResult->SetNumberField(TEXT("index"), Index);
-			ErrorResult->SetBoolField(TEXT("success"), false);
-			ErrorResult->SetStringField(TEXT("error"), TEXT("Invalid request object"));
-			Results.Add(ErrorResult);
-			Failed++;
+		CoalesceScope.Emplace(FText::FromString(FString::Printf(TEXT("REST Batch (%d requests)"), Entries.Num())));
+	}
 
-			if (bStopOnError)
+	int32 Index = 0;
+	while (Index < EndIndex)
+	{
+		if (!bParallel || !Entries[Index].bThreadSafe)
+		{
+			// Game-thread work runs in request order and is a barrier for everything after it
+			RunBatchEntry(Entries[Index], Results, Succeeded);
+			if (bStopOnError && !Succeeded[Index])
 			{
-				break;
+				EndIndex = Index + 1;
 			}
+			Index++;
 			continue;
 		}
 
-		// Parse method
-		FString MethodStr = ReqObj->GetStringField(TEXT("method")).ToUpper();
-		ERESTMethod Method = ERESTMethod::GET;
-		if (MethodStr == TEXT("POST"))
-		{
-			Method = ERESTMethod::POST;
-		}
-		else if (MethodStr == TEXT("PUT"))
-		{
-			Method = ERESTMethod::PUT;
-		}
-		else if (MethodStr == TEXT("DELETE"))
+		// Consecutive thread-safe reads run in dependency waves on worker threads
+		int32 RunEnd = Index;
+		while (RunEnd < EndIndex && Entries[RunEnd].bThreadSafe)
 		{
-			Method = ERESTMethod::DELETE;
+			RunEnd++;
 		}
 
-		FString Path = ReqObj->GetStringField(TEXT("path"));
-
-		// Get and resolve body with variable references
-		TSharedPtr<FJsonObject> Body;
-		if (ReqObj->HasField(TEXT("body")))
+		TArray<int32> Levels;
+		Levels.SetNumZeroed(RunEnd - Index);
+		TArray<TArray<int32>> Waves;
+		for (int32 EntryIndex = Index; EntryIndex < RunEnd; EntryIndex++)
 		{
-			Body = ReqObj->GetObjectField(TEXT("body"));
-			Body = ResolveVariableReferences(Body, Results);
+			int32 Level = 0;
+			for (int32 Dependency : Entries[EntryIndex].Dependencies)
+			{
+				if (Dependency >= Index)
+				{
+					Level = FMath::Max(Level, Levels[Dependency - Index] + 1);
+				}
+			}
+			Levels[EntryIndex - Index] = Level;
+
+			if (Waves.Num() <= Level)
+			{
+				Waves.SetNum(Level + 1);
+			}
+			Waves[Level].Add(EntryIndex);
 		}
 
-		// Build internal request
-		FRESTRequest InternalRequest;
-		InternalRequest.Method = Method;
-		InternalRequest.Path = Path;
-		InternalRequest.JsonBody = Body;
-
-		// Dispatch to router
-		FRESTResponse InternalResponse = RouterRef->DispatchInternal(InternalRequest);
-
-		// Build result
-		TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
-		Result->SetNumberField(TEXT("index"), Index);
-		Result->SetStringField(TEXT("method"), MethodStr);
-		Result->SetStringField(TEXT("path"), Path);
-		Result->SetNumberField(TEXT("status"), InternalResponse.StatusCode);
-		Result->SetBoolField(TEXT("success"), InternalResponse.StatusCode >= 200 && InternalResponse.StatusCode < 300);
-
-		// Include response body
-		if (InternalResponse.JsonBody.IsValid())
+		for (TArray<int32>& Wave : Waves)
 		{
-			Result->SetObjectField(TEXT("data"), InternalResponse.JsonBody);
+			// A failure in an earlier wave cancels anything after it in request order
+			Wave.RemoveAll([EndIndex](int32 EntryIndex) { return EntryIndex >= EndIndex; });
+			if (Wave.Num() == 1)
+			{
+				RunBatchEntry(Entries[Wave[0]], Results, Succeeded);
+			}
+			else if (Wave.Num() > 1)
+			{
+				ParallelFor(Wave.Num(), [this, &Wave, &Entries, &Results, &Succeeded](int32 WaveIndex)
+				{
+					RunBatchEntry(Entries[Wave[WaveIndex]], Results, Succeeded);
+				});
+			}
+
+			if (bStopOnError)
+			{
+				for (int32 EntryIndex : Wave)
+				{
+					if (!Succeeded[EntryIndex] && EntryIndex < EndIndex)
+					{
+						EndIndex = EntryIndex + 1;
+					}
+				}
+			}
 		}
 
-		Results.Add(Result);
+		Index = RunEnd;
+	}
+
+	int32 CoalescedEdits = 0;
+	if (CoalesceScope.IsSet())
+	{
+		CoalescedEdits = CoalesceScope->Close();
+		CoalesceScope.Reset();
+	}
 
-		if (InternalResponse.StatusCode >= 200 && InternalResponse.StatusCode < 300)
+	// Build response
+	int32 Completed = 0;
+	int32 Failed = 0;
+	TArray<TSharedPtr<FJsonValue>> ResultsJsonArray;
+	ResultsJsonArray.Reserve(EndIndex);
+	for (int32 ResultIndex = 0; ResultIndex < EndIndex; ResultIndex++)
+	{
+		ResultsJsonArray.Add(MakeShared<FJsonValueObject>(Results[ResultIndex]));
+		if (Succeeded[ResultIndex])
 		{
 			Completed++;
 		}
 		else
 		{
 			Failed++;
-			if (bStopOnError)
-			{
-				break;
-			}
 		}
 	}
 
-	// Build response
 	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
 	Response->SetBoolField(TEXT("success"), Failed == 0);
-
-	TArray<TSharedPtr<FJsonValue>> ResultsJsonArray;
-	for (const TSharedPtr<FJsonObject>& Result : Results)
-	{
-		ResultsJsonArray.Add(MakeShared<FJsonValueObject>(Result));
-	}
 	Response->SetArrayField(TEXT("results"), ResultsJsonArray);
 	Response->SetNumberField(TEXT("completed"), Completed);
 	Response->SetNumberField(TEXT("failed"), Failed);
+	if (bCoalesce)
+	{
+		Response->SetNumberField(TEXT("coalesced_edits"), CoalescedEdits);
+	}
 
 	return FRESTResponse::Ok(Response);
 }
 
-TSharedPtr<FJsonObject> FInfrastructureHandler::ResolveVariableReferences(
-	TSharedPtr<FJsonObject> Body,
-	const TArray<TSharedPtr<FJsonObject>>& PreviousResults)
+void FInfrastructureHandler::ParseBatchEntry(const TSharedPtr<FJsonValue>& Value, int32 Index, FBatchEntry& OutEntry) const
 {
-	if (!Body.IsValid())
+	OutEntry.Index = Index;
+
+	TSharedPtr<FJsonObject> ReqObj = Value.IsValid() ? Value->AsObject() : nullptr;
+	if (!ReqObj.IsValid())
 	{
-		return Body;
+		return;
 	}
+	OutEntry.bValid = true;
 
-	TSharedPtr<FJsonObject> Resolved = MakeShared<FJsonObject>();
+	// Parse method
+	OutEntry.MethodStr = ReqObj->GetStringField(TEXT("method")).ToUpper();
+	OutEntry.Method = ERESTMethod::GET;
+	if (OutEntry.MethodStr == TEXT("POST"))
+	{
+		OutEntry.Method = ERESTMethod::POST;
+	}
+	else if (OutEntry.MethodStr == TEXT("PUT"))
+	{
+		OutEntry.Method = ERESTMethod::PUT;
+	}
+	else if (OutEntry.MethodStr == TEXT("DELETE"))
+	{
+		OutEntry.Method = ERESTMethod::DELETE;
+	}
+
+	OutEntry.Path = ReqObj->GetStringField(TEXT("path"));
+
+	if (ReqObj->HasField(TEXT("body")))
+	{
+		OutEntry.Body = ReqObj->GetObjectField(TEXT("body"));
+		ParseBodyReferences(OutEntry.Body, Index, OutEntry.BodyTemplate, OutEntry.Dependencies);
+	}
+
+	OutEntry.bThreadSafe = RouterRef->IsThreadSafeRoute(OutEntry.Method, OutEntry.Path);
+}
+
+void FInfrastructureHandler::RunBatchEntry(
+	const FBatchEntry& Entry,
+	TArray<TSharedPtr<FJsonObject>>& Results,
+	TArray<bool>& Succeeded) const
+{
+	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetNumberField(TEXT("index"), Entry.Index);
+
+	if (!Entry.bValid)
+	{
+		Result->SetBoolField(TEXT("success"), false);
+		Result->SetStringField(TEXT("error"), TEXT("Invalid request object"));
+		Results[Entry.Index] = Result;
+		Succeeded[Entry.Index] = false;
+		return;
+	}
+
+	// Build internal request; only bodies that reference earlier results are copied
+	FRESTRequest InternalRequest;
+	InternalRequest.Method = Entry.Method;
+	InternalRequest.Path = Entry.Path;
+	InternalRequest.JsonBody = ResolveVariableReferences(Entry.Body, Entry.BodyTemplate, Results);
+
+	// Dispatch to router
+	FRESTResponse InternalResponse = RouterRef->DispatchInternal(InternalRequest);
+	const bool bSuccess = InternalResponse.StatusCode >= 200 && InternalResponse.StatusCode < 300;
+
+	// Build result
+	Result->SetStringField(TEXT("method"), Entry.MethodStr);
+	Result->SetStringField(TEXT("path"), Entry.Path);
+	Result->SetNumberField(TEXT("status"), InternalResponse.StatusCode);
+	Result->SetBoolField(TEXT("success"), bSuccess);
+
+	// Include response body (streamed responses are parsed back into a DOM here)
+	if (TSharedPtr<FJsonObject> ResponseJson = InternalResponse.GetJson())
+	{
+		Result->SetObjectField(TEXT("data"), ResponseJson);
+	}
+
+	Results[Entry.Index] = Result;
+	Succeeded[Entry.Index] = bSuccess;
+}
+
+void FInfrastructureHandler::ParseBodyReferences(
+	const TSharedPtr<FJsonObject>& Body,
+	int32 EntryIndex,
+	FBatchBodyTemplate& OutTemplate,
+	TArray<int32>& OutDependencies)
+{
+	if (!Body.IsValid())
+	{
+		return;
+	}
 
 	for (const auto& Field : Body->Values)
 	{
 		if (Field.Value->Type == EJson::String)
 		{
-			FString Value = Field.Value->AsString();
-			FString ResolvedValue = ResolveStringVariables(Value, PreviousResults);
-			Resolved->SetStringField(Field.Key, ResolvedValue);
+			FBatchStringTemplate StringTemplate;
+			StringTemplate.Original = Field.Value->AsString();
+			ParseStringReferences(StringTemplate.Original, EntryIndex, StringTemplate.References);
+			if (StringTemplate.References.Num() > 0)
+			{
+				for (const FBatchReference& Reference : StringTemplate.References)
+				{
+					OutDependencies.AddUnique(Reference.ResultIndex);
+				}
+				OutTemplate.Strings.Emplace(Field.Key, MoveTemp(StringTemplate));
+			}
 		}
 		else if (Field.Value->Type == EJson::Object)
 		{
-			TSharedPtr<FJsonObject> NestedObj = Field.Value->AsObject();
-			Resolved->SetObjectField(Field.Key, ResolveVariableReferences(NestedObj, PreviousResults));
+			TSharedRef<FBatchBodyTemplate> Nested = MakeShared<FBatchBodyTemplate>();
+			ParseBodyReferences(Field.Value->AsObject(), EntryIndex, *Nested, OutDependencies);
+			if (!Nested->IsEmpty())
+			{
+				OutTemplate.Objects.Emplace(Field.Key, Nested);
+			}
 		}
-		else
+	}
+}
+
+void FInfrastructureHandler::ParseStringReferences(const FString& Value, int32 EntryIndex, TArray<FBatchReference>& OutReferences)
+{
+	// Pattern: $0 or $0.path.to.value (same grammar as the old \$(\d+)(\.([\w\.]+))? regex)
+	const TCHAR* Chars = *Value;
+	const int32 Len = Value.Len();
+
+	int32 Pos = 0;
+	while (Pos < Len)
+	{
+		if (Chars[Pos] != TEXT('$') || Pos + 1 >= Len || !FChar::IsDigit(Chars[Pos + 1]))
+		{
+			Pos++;
+			continue;
+		}
+
+		const int32 Start = Pos;
+		int32 DigitsEnd = Pos + 1;
+		while (DigitsEnd < Len && FChar::IsDigit(Chars[DigitsEnd]))
+		{
+			DigitsEnd++;
+		}
+
+		int32 PathEnd = DigitsEnd;
+		if (DigitsEnd + 1 < Len && Chars[DigitsEnd] == TEXT('.'))
+		{
+			int32 Scan = DigitsEnd + 1;
+			while (Scan < Len && (FChar::IsAlnum(Chars[Scan]) || Chars[Scan] == TEXT('_') || Chars[Scan] == TEXT('.')))
+			{
+				Scan++;
+			}
+			if (Scan > DigitsEnd + 1)
+			{
+				PathEnd = Scan;
+			}
+		}
+
+		const int32 ResultIndex = FCString::Atoi(Chars + Start + 1);
+
+		// Only earlier requests can be referenced; bare $N can't be substituted into a string
+		if (ResultIndex < EntryIndex && PathEnd > DigitsEnd)
 		{
-			Resolved->SetField(Field.Key, Field.Value);
+			FBatchReference& Reference = OutReferences.AddDefaulted_GetRef();
+			Reference.Start = Start;
+			Reference.Length = PathEnd - Start;
+			Reference.ResultIndex = ResultIndex;
+			FString(PathEnd - DigitsEnd - 1, Chars + DigitsEnd + 1).ParseIntoArray(Reference.JsonPath, TEXT("."));
 		}
+
+		Pos = PathEnd;
+	}
+}
+
+TSharedPtr<FJsonObject> FInfrastructureHandler::ResolveVariableReferences(
+	const TSharedPtr<FJsonObject>& Body,
+	const FBatchBodyTemplate& Template,
+	const TArray<TSharedPtr<FJsonObject>>& PreviousResults)
+{
+	if (!Body.IsValid() || Template.IsEmpty())
+	{
+		return Body;
+	}
+
+	// Shallow copy; only fields holding references are replaced
+	TSharedPtr<FJsonObject> Resolved = MakeShared<FJsonObject>();
+	Resolved->Values = Body->Values;
+
+	for (const TPair<FString, FBatchStringTemplate>& Field : Template.Strings)
+	{
+		Resolved->SetStringField(Field.Key, ResolveStringVariables(Field.Value, PreviousResults));
+	}
+
+	for (const TPair<FString, TSharedRef<FBatchBodyTemplate>>& Field : Template.Objects)
+	{
+		Resolved->SetObjectField(Field.Key, ResolveVariableReferences(Body->GetObjectField(Field.Key), *Field.Value, PreviousResults));
 	}
 
 	return Resolved;
 }
 
 FString FInfrastructureHandler::ResolveStringVariables(
-	const FString& Value,
+	const FBatchStringTemplate& Template,
 	const TArray<TSharedPtr<FJsonObject>>& PreviousResults)
 {
-	FString Result = Value;
-
-	// Pattern: $0 or $0.path.to.value
-	FRegexPattern Pattern(TEXT("\\$(\\d+)(\\.([\\w\\.]+))?"));
-	FRegexMatcher Matcher(Pattern, Value);
+	FString Result;
+	Result.Reserve(Template.Original.Len());
 
-	while (Matcher.FindNext())
+	int32 Copied = 0;
+	for (const FBatchReference& Reference : Template.References)
 	{
-		FString FullMatch = Matcher.GetCaptureGroup(0);
-		int32 Index = FCString::Atoi(*Matcher.GetCaptureGroup(1));
-		FString JsonPath = Matcher.GetCaptureGroup(3);
+		const TSharedPtr<FJsonObject>& ResultData = PreviousResults[Reference.ResultIndex];
+		if (!ResultData.IsValid())
+		{
+			continue;
+		}
 
-		if (Index >= 0 && Index < PreviousResults.Num())
+		TSharedPtr<FJsonValue> Extracted = ExtractJsonPath(ResultData, Reference.JsonPath);
+		if (!Extracted.IsValid() || (Extracted->Type != EJson::String && Extracted->Type != EJson::Number))
 		{
-			TSharedPtr<FJsonObject> ResultData = PreviousResults[Index];
-			if (ResultData.IsValid())
-			{
-				if (JsonPath.IsEmpty())
-				{
-					// Just $N - can't substitute entire object into string
-					continue;
-				}
+			continue;
+		}
 
-				TSharedPtr<FJsonValue> Extracted = ExtractJsonPath(ResultData, JsonPath);
-				if (Extracted.IsValid() && Extracted->Type == EJson::String)
-				{
-					Result = Result.Replace(*FullMatch, *Extracted->AsString());
-				}
-				else if (Extracted.IsValid() && Extracted->Type == EJson::Number)
-				{
-					Result = Result.Replace(*FullMatch, *FString::Printf(TEXT("%g"), Extracted->AsNumber()));
-				}
-			}
+		Result.AppendChars(*Template.Original + Copied, Reference.Start - Copied);
+		if (Extracted->Type == EJson::String)
+		{
+			Result += Extracted->AsString();
 		}
+		else
+		{
+			Result += FString::Printf(TEXT("%g"), Extracted->AsNumber());
+		}
+		Copied = Reference.Start + Reference.Length;
 	}
 
+	Result.AppendChars(*Template.Original + Copied, Template.Original.Len() - Copied);
 	return Result;
 }
 
 TSharedPtr<FJsonValue> FInfrastructureHandler::ExtractJsonPath(
-	TSharedPtr<FJsonObject> Root,
-	const FString& Path)
+	const TSharedPtr<FJsonObject>& Root,
+	const TArray<FString>& Parts)
 {
-	TArray<FString> Parts;
-	Path.ParseIntoArray(Parts, TEXT("."));
-
 	TSharedPtr<FJsonObject> Current = Root;
 	for (int32 i = 0; i < Parts.Num() - 1; i++)
 	{
@@ -2,6 +2,9 @@
 
 #include "Handlers/LevelHandler.h"
 #include "Utils/JsonHelpers.h"
+#include "Utils/EditorChangeTracker.h"
+#include "RESTJsonWriter.h"
+#include "RESTListQuery.h"
 #include "Engine/World.h"
 #include "Engine/Level.h"
 #include "EngineUtils.h"
@@ -14,10 +17,12 @@ void FLevelHandler::RegisterRoutes(FRESTRouter& Router)
 		FRESTRouteHandler::CreateRaw(this, &FLevelHandler::HandleInfo));
 
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/level/outliner"),
-		FRESTRouteHandler::CreateRaw(this, &FLevelHandler::HandleOutliner));
+		FRESTRouteHandler::CreateRaw(this, &FLevelHandler::HandleOutliner),
+		FRESTRouteOptions::Versioned(FEditorChangeTracker::MakeRouteVersion(EEditorChange::World | EEditorChange::Objects)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/level/load"),
-		FRESTRouteHandler::CreateRaw(this, &FLevelHandler::HandleLoad));
+		FEditorChangeTracker::BumpAfter(EEditorChange::All, FRESTRouteHandler::CreateRaw(this, &FLevelHandler::HandleLoad)),
+		FRESTRouteOptions().Bulk());
 
 	UE_LOG(LogTemp, Log, TEXT("LevelHandler: Registered 3 routes at /level"));
 }
@@ -73,40 +78,49 @@ FRESTResponse FLevelHandler::HandleOutliner(const FRESTRequest& Request)
 		bHierarchical = false;
 	}
 
-	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
-	Response->SetBoolField(TEXT("success"), true);
+	FRESTListQuery Query;
+	FString Error;
+	if (!FRESTListQuery::Parse(Request, MAX_int32, MAX_int32, Query, Error))
+	{
+		return FRESTResponse::BadRequest(Error);
+	}
 
-	TArray<TSharedPtr<FJsonValue>> ActorsArray;
+	FRESTJsonWriter Writer;
+	Query.BeginList(Writer, TEXT("actors"));
 
-	if (bHierarchical)
+	// Pages count top-level entries: root actors (with their subtrees) when hierarchical, every actor when flat
+	int32 Index = 0;
+	int32 Count = 0;
+	bool bHasMore = false;
+	for (TActorIterator<AActor> It(World); It; ++It)
 	{
-		// Build tree: only root actors (no parent)
-		for (TActorIterator<AActor> It(World); It; ++It)
+		AActor* Actor = *It;
+		if (!Actor || (bHierarchical && Actor->GetAttachParentActor()))
 		{
-			AActor* Actor = *It;
-			if (Actor && !Actor->GetAttachParentActor())
-			{
-				ActorsArray.Add(MakeShared<FJsonValueObject>(ActorToOutlinerJson(Actor, true)));
-			}
+			continue;
 		}
-	}
-	else
-	{
-		// Flat list
-		for (TActorIterator<AActor> It(World); It; ++It)
+
+		const int32 EntryIndex = Index++;
+		if (Query.IsBeforePage(EntryIndex))
 		{
-			AActor* Actor = *It;
-			if (Actor)
-			{
-				ActorsArray.Add(MakeShared<FJsonValueObject>(ActorToOutlinerJson(Actor, false)));
-			}
+			continue;
+		}
+		if (Query.IsAfterPage(EntryIndex))
+		{
+			bHasMore = true;
+			break;
 		}
-	}
 
-	Response->SetArrayField(TEXT("actors"), ActorsArray);
-	Response->SetNumberField(TEXT("count"), ActorsArray.Num());
+		Query.BeginItem(Writer);
+		WriteOutlinerActor(Writer, Actor, bHierarchical, Query.GetFields());
+		Query.EndItem(Writer);
+		Count++;
+	}
 
-	return FRESTResponse::Ok(Response);
+	return Query.Finish(Writer, bHasMore, [Count](FRESTJsonWriter& Trailer)
+	{
+		Trailer.WriteValue(TEXT("count"), Count);
+	});
 }
 
 FRESTResponse FLevelHandler::HandleLoad(const FRESTRequest& Request)
@@ -134,30 +148,38 @@ FRESTResponse FLevelHandler::HandleLoad(const FRESTRequest& Request)
 	return FRESTResponse::Ok(Response);
 }
 
-TSharedPtr<FJsonObject> FLevelHandler::ActorToOutlinerJson(AActor* Actor, bool bIncludeChildren)
+void FLevelHandler::WriteOutlinerActor(FRESTJsonWriter& Writer, AActor* Actor, bool bIncludeChildren, const FRESTFieldFilter& Fields)
 {
-	TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
-	Json->SetStringField(TEXT("label"), Actor->GetActorLabel());
-	Json->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
-	Json->SetObjectField(TEXT("location"), JsonHelpers::VectorToJson(Actor->GetActorLocation()));
+	if (Fields.Wants(TEXT("label")))
+	{
+		Writer.WriteValue(TEXT("label"), Actor->GetActorLabel());
+	}
+	if (Fields.Wants(TEXT("class")))
+	{
+		Writer.WriteValue(TEXT("class"), Actor->GetClass()->GetFName());
+	}
+	if (Fields.Wants(TEXT("location")))
+	{
+		JsonHelpers::WriteVector(Writer, TEXT("location"), Actor->GetActorLocation());
+	}
 
-	if (bIncludeChildren)
+	if (bIncludeChildren && Fields.Wants(TEXT("children")))
 	{
 		TArray<AActor*> Children;
 		Actor->GetAttachedActors(Children);
 
 		if (Children.Num() > 0)
 		{
-			TArray<TSharedPtr<FJsonValue>> ChildrenArray;
+			Writer.WriteArrayStart(TEXT("children"));
 			for (AActor* Child : Children)
 			{
-				ChildrenArray.Add(MakeShared<FJsonValueObject>(ActorToOutlinerJson(Child, true)));
+				Writer.WriteObjectStart();
+				WriteOutlinerActor(Writer, Child, true, Fields);
+				Writer.WriteObjectEnd();
 			}
-			Json->SetArrayField(TEXT("children"), ChildrenArray);
+			Writer.WriteArrayEnd();
 		}
 	}
-
-	return Json;
 }
 
 TArray<TSharedPtr<FJsonObject>> FLevelHandler::GetEndpointSchemas() const
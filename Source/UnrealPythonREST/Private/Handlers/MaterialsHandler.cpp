@@ -3,6 +3,11 @@
 #include "Handlers/MaterialsHandler.h"
 #include "Utils/JsonHelpers.h"
 #include "Utils/ActorUtils.h"
+#include "Utils/EditorChangeTracker.h"
+#include "Utils/EditCoalescer.h"
+#include "Utils/MaterialGraphDiff.h"
+#include "Utils/MaterialGraphIndex.h"
+#include "RESTJsonWriter.h"
 #include "Materials/Material.h"
 #include "Materials/MaterialInstance.h"
 #include "Materials/MaterialInstanceDynamic.h"
@@ -54,111 +59,142 @@ static void SaveAssetIfRequested(UObject* Asset, bool bShouldSave);
 
 void FMaterialsHandler::RegisterRoutes(FRESTRouter& Router)
 {
+	// Recorded after every graph or parameter edit so /materials/editor/connections and the export/diff tags revalidate
+	constexpr EEditorChange MaterialEdits = EEditorChange::Objects;
+
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/materials/param"),
 		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleGetParam));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/param"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleSetParam));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleSetParam)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/recompile"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleRecompile));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleRecompile)),
+		FRESTRouteOptions().Bulk());
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/replace"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleReplace));
+		FEditorChangeTracker::BumpAfter(EEditorChange::World | EEditorChange::Objects, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleReplace)));
 
 	// Material asset creation
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/create"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleCreateMaterial));
+		FEditorChangeTracker::BumpAfter(EEditorChange::Assets | EEditorChange::Objects, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleCreateMaterial)));
 
 	// Material Instance creation
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/instance/create"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleCreateMaterialInstance));
+		FEditorChangeTracker::BumpAfter(EEditorChange::Assets | EEditorChange::Objects, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleCreateMaterialInstance)));
 
 	// Dynamic Material Instance creation (runtime)
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/instance/dynamic"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleCreateDynamicMaterialInstance));
+		FEditorChangeTracker::BumpAfter(EEditorChange::World | EEditorChange::Objects, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleCreateDynamicMaterialInstance)));
 
 	// Material Editor open
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/editor/open"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleOpenMaterialEditor));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleOpenMaterialEditor)));
 
 	// Material Editor node manipulation
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/materials/editor/nodes"),
 		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleListMaterialNodes));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/editor/node/position"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleSetMaterialNodePosition));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleSetMaterialNodePosition)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/editor/node/create"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleCreateMaterialNode));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleCreateMaterialNode)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/editor/connect"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleConnectMaterialNodes));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleConnectMaterialNodes)));
 
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/materials/editor/status"),
 		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleMaterialStatus));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/editor/refresh"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleRefreshEditor));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleRefreshEditor)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/editor/expression/set"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleSetExpressionProperty));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleSetExpressionProperty)));
 
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/materials/editor/validate"),
 		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleValidateGraph));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/editor/disconnect"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleDisconnect));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleDisconnect)));
 
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/materials/editor/connections"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleGetConnections));
+		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleGetConnections),
+		FRESTRouteOptions::Versioned(FEditorChangeTracker::MakeRouteVersion(EEditorChange::Objects)).Cached());
 
 	Router.RegisterRoute(ERESTMethod::DELETE, TEXT("/materials/editor/node"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleDeleteExpression));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleDeleteExpression)));
 
 	// Material Graph XML Serialization
+	// Only cacheable when it names the material; without material_path it exports whatever editor is focused
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/materials/editor/export"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleExportGraph));
+		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleExportGraph),
+		FRESTRouteOptions::Versioned(FRESTRouteVersion::CreateLambda([](const FRESTRequest& Request) -> uint64
+		{
+			return Request.QueryParams.Contains(TEXT("material_path"))
+				? FEditorChangeTracker::GetGeneration(EEditorChange::Objects) + 1
+				: 0;
+		})));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/editor/import"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleImportGraph));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleImportGraph)));
+
+	// Incremental graph sync: diff against a revision the client already has, patch in place
+	Router.RegisterRoute(ERESTMethod::GET, TEXT("/materials/editor/diff"),
+		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleGraphDiff),
+		FRESTRouteOptions::Versioned(FRESTRouteVersion::CreateLambda([](const FRESTRequest& Request) -> uint64
+		{
+			return Request.QueryParams.Contains(TEXT("material_path"))
+				? FEditorChangeTracker::GetGeneration(EEditorChange::Objects) + 1
+				: 0;
+		})));
+
+	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/editor/patch"),
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleGraphPatch)));
 
 	// Material Function endpoints
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/function/create"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleCreateMaterialFunction));
+		FEditorChangeTracker::BumpAfter(EEditorChange::Assets | EEditorChange::Objects, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleCreateMaterialFunction)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/function/editor/open"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleOpenMaterialFunctionEditor));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleOpenMaterialFunctionEditor)));
 
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/materials/function/editor/nodes"),
 		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleListMaterialFunctionNodes));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/function/editor/node/create"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleCreateMaterialFunctionNode));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleCreateMaterialFunctionNode)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/function/editor/node/position"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleSetMaterialFunctionNodePosition));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleSetMaterialFunctionNodePosition)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/function/editor/connect"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleConnectMaterialFunctionNodes));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleConnectMaterialFunctionNodes)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/function/editor/disconnect"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleDisconnectMaterialFunction));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleDisconnectMaterialFunction)));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/function/editor/expression/set"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleSetMaterialFunctionExpressionProperty));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleSetMaterialFunctionExpressionProperty)));
 
 	Router.RegisterRoute(ERESTMethod::DELETE, TEXT("/materials/function/editor/node"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleDeleteMaterialFunctionExpression));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleDeleteMaterialFunctionExpression)));
 
 	// Material Function Graph XML Serialization
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/materials/function/editor/export"),
 		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleExportMaterialFunctionGraph));
 
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/function/editor/import"),
-		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleImportMaterialFunctionGraph));
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleImportMaterialFunctionGraph)));
+
+	Router.RegisterRoute(ERESTMethod::GET, TEXT("/materials/function/editor/diff"),
+		FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleMaterialFunctionGraphDiff));
 
-	UE_LOG(LogTemp, Log, TEXT("MaterialsHandler: Registered 32 routes at /materials (v4)"));
+	Router.RegisterRoute(ERESTMethod::POST, TEXT("/materials/function/editor/patch"),
+		FEditorChangeTracker::BumpAfter(MaterialEdits, FRESTRouteHandler::CreateRaw(this, &FMaterialsHandler::HandleMaterialFunctionGraphPatch)));
+
+	UE_LOG(LogTemp, Log, TEXT("MaterialsHandler: Registered 36 routes at /materials (v4)"));
 }
 
 FRESTResponse FMaterialsHandler::HandleGetParam(const FRESTRequest& Request)
@@ -706,8 +742,7 @@ FRESTResponse FMaterialsHandler::HandleReplace(const FRESTRequest& Request)
 		Response->SetArrayField(TEXT("not_found"), NotFoundArray);
 
 		// Add suggestions for not found actors
-		TArray<FString> AllLabels = ActorUtils::GetAllActorLabels();
-		TArray<FString> Similar = JsonHelpers::FindSimilarStrings(NotFoundLabels[0], AllLabels);
+		TArray<FString> Similar = ActorUtils::FindSimilarActorLabels(NotFoundLabels[0]);
 		if (Similar.Num() > 0)
 		{
 			TArray<TSharedPtr<FJsonValue>> SuggestionsArray;
@@ -1102,18 +1137,21 @@ FRESTResponse FMaterialsHandler::HandleOpenMaterialEditor(const FRESTRequest& Re
 // Asset Save Helper
 // ============================================================================
 
-/** Save asset package to disk if requested */
+/** Save asset package to disk if requested (once per asset, after all other work, inside a coalesced batch) */
 static void SaveAssetIfRequested(UObject* Asset, bool bShouldSave)
 {
 	if (!bShouldSave || !Asset) return;
 
-	UPackage* Package = Asset->GetOutermost();
-	if (Package)
+	FEditCoalescer::Run(Asset, TEXT("Save"), FEditCoalescer::EPhase::Save, [Asset]()
 	{
-		FSavePackageArgs SaveArgs;
-		SaveArgs.TopLevelFlags = RF_Standalone;
-		UPackage::Save(Package, Asset, *FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension()), SaveArgs);
-	}
+		UPackage* Package = Asset->GetOutermost();
+		if (Package)
+		{
+			FSavePackageArgs SaveArgs;
+			SaveArgs.TopLevelFlags = RF_Standalone;
+			UPackage::Save(Package, Asset, *FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension()), SaveArgs);
+		}
+	});
 }
 
 // ============================================================================
@@ -1307,16 +1345,7 @@ bool FMaterialsHandler::FindActiveMaterialFunctionEditor(UMaterialFunction*& Out
 
 UMaterialExpression* FMaterialsHandler::FindExpressionInFunctionByName(UMaterialFunction* Function, const FString& Name)
 {
-	if (!Function) return nullptr;
-
-	for (UMaterialExpression* Expression : Function->GetExpressions())
-	{
-		if (Expression && Expression->GetName() == Name)
-		{
-			return Expression;
-		}
-	}
-	return nullptr;
+	return FMaterialGraphIndex::FindExpression(Function, Name);
 }
 
 FRESTResponse FMaterialsHandler::HandleCreateMaterialFunction(const FRESTRequest& Request)
@@ -1529,12 +1558,7 @@ FRESTResponse FMaterialsHandler::HandleCreateMaterialFunctionNode(const FRESTReq
 		{
 			bCreatedViaEditor = true;
 
-			bool bFoundInFunction = false;
-			for (UMaterialExpression* Expr : Function->GetExpressions())
-			{
-				if (Expr == NewExpression) { bFoundInFunction = true; break; }
-			}
-			if (!bFoundInFunction)
+			if (FMaterialGraphIndex::FindExpression(Function, NewExpression->GetName()) != NewExpression)
 			{
 				Function->GetExpressionCollection().AddExpression(NewExpression);
 			}
@@ -1855,6 +1879,7 @@ FRESTResponse FMaterialsHandler::HandleConnectMaterialFunctionNodes(const FRESTR
 	bool bConnectionMade = Schema->TryCreateConnection(OutputPin, InputPin);
 
 	MaterialGraph->LinkMaterialExpressionsFromGraph();
+	FMaterialGraphIndex::Invalidate(Function);
 
 	Function->MarkPackageDirty();
 
@@ -1938,6 +1963,7 @@ FRESTResponse FMaterialsHandler::HandleDisconnectMaterialFunction(const FRESTReq
 		Schema->BreakPinLinks(*InputPin, true);
 
 		MaterialGraph->LinkMaterialExpressionsFromGraph();
+		FMaterialGraphIndex::Invalidate(Function);
 
 		Function->MarkPackageDirty();
 
@@ -2504,10 +2530,23 @@ void FMaterialsHandler::RefreshMaterialEditorGraph(UMaterial* Material)
 		return;
 	}
 
+	// Every graph edit ends here; relinks below do not go through Modify()
+	FMaterialGraphIndex::Invalidate(Material);
+
 	// TODO: Visual graph refresh not yet working - nodes are created in data but don't appear
 	// visually until the material is closed and reopened. See research prompt:
 	// docs/prompts/material-editor-graph-refresh-research.md
 
+	// Coalesced batches refresh each material once, after all edits
+	if (FEditCoalescer::IsCoalescing())
+	{
+		FEditCoalescer::Run(Material, TEXT("RefreshGraph"), FEditCoalescer::EPhase::Refresh, [this, Material]()
+		{
+			RefreshMaterialEditorGraph(Material);
+		});
+		return;
+	}
+
 	// Ensure we're on the game thread for UI updates
 	if (!IsInGameThread())
 	{
@@ -2614,20 +2653,7 @@ TSharedPtr<FJsonObject> FMaterialsHandler::ExpressionToJson(UMaterialExpression*
 
 UMaterialExpression* FMaterialsHandler::FindExpressionByName(UMaterial* Material, const FString& Name)
 {
-	if (!Material)
-	{
-		return nullptr;
-	}
-
-	for (UMaterialExpression* Expression : Material->GetExpressions())
-	{
-		if (Expression && Expression->GetName() == Name)
-		{
-			return Expression;
-		}
-	}
-
-	return nullptr;
+	return FMaterialGraphIndex::FindExpression(Material, Name);
 }
 
 // ============================================================================
@@ -2954,8 +2980,8 @@ FRESTResponse FMaterialsHandler::HandleSetMaterialNodePosition(const FRESTReques
 	bool bSave = JsonHelpers::GetOptionalBool(Request.JsonBody, TEXT("save"), true);
 	SaveAssetIfRequested(Material, bSave);
 
-	Material->PreEditChange(nullptr);
-	Material->PostEditChange();
+	FEditCoalescer::PreEditChange(Material);
+	FEditCoalescer::PostEditChange(Material);
 
 	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
 	Response->SetBoolField(TEXT("success"), true);
@@ -3053,16 +3079,7 @@ FRESTResponse FMaterialsHandler::HandleCreateMaterialNode(const FRESTRequest& Re
 
 			// Ensure expression is also in Material's expression collection
 			// Editor API creates in graph but may not add to Material->GetExpressions()
-			bool bFoundInMaterial = false;
-			for (UMaterialExpression* Expr : Material->GetExpressions())
-			{
-				if (Expr == NewExpression)
-				{
-					bFoundInMaterial = true;
-					break;
-				}
-			}
-			if (!bFoundInMaterial)
+			if (FMaterialGraphIndex::FindExpression(Material, NewExpression->GetName()) != NewExpression)
 			{
 				Material->GetExpressionCollection().AddExpression(NewExpression);
 			}
@@ -3081,7 +3098,8 @@ FRESTResponse FMaterialsHandler::HandleCreateMaterialNode(const FRESTRequest& Re
 			static_cast<int32>(PosY)
 		);
 
-		if (NewExpression)
+		// Coalesced batches leave this to the deferred RefreshMaterialEditorGraph below
+		if (NewExpression && !FEditCoalescer::IsCoalescing())
 		{
 			// Try to refresh the editor using the newly created expression
 			TSharedPtr<IMaterialEditor> MatEditor = FMaterialEditorUtilities::GetIMaterialEditorForObject(NewExpression);
@@ -3171,7 +3189,10 @@ FRESTResponse FMaterialsHandler::HandleCreateMaterialNode(const FRESTRequest& Re
 	// Only manually recompile if not created via editor API (editor handles its own updates)
 	if (!bCreatedViaEditor)
 	{
-		UMaterialEditingLibrary::RecompileMaterial(Material);
+		FEditCoalescer::Run(Material, TEXT("PostEditChange"), FEditCoalescer::EPhase::Update, [Material]()
+		{
+			UMaterialEditingLibrary::RecompileMaterial(Material);
+		});
 	}
 	RefreshMaterialEditorGraph(Material);
 
@@ -3377,16 +3398,17 @@ FRESTResponse FMaterialsHandler::HandleConnectMaterialNodes(const FRESTRequest&
 		TEXT("Connect %s to %s"), *SourceName,
 		bHasTargetProperty ? *TargetProperty : *TargetExpression)));
 
-	Material->PreEditChange(nullptr);
+	FEditCoalescer::PreEditChange(Material);
 
 	// Write through editor graph only (graph-first architecture)
 	bool bConnectionMade = Schema->TryCreateConnection(OutputPin, InputPin);
 
 	// Sync graph → data model (equivalent to Apply in editor)
 	MaterialGraph->LinkMaterialExpressionsFromGraph();
+	FMaterialGraphIndex::Invalidate(Material);
 
 	// Trigger recompile
-	Material->PostEditChange();
+	FEditCoalescer::PostEditChange(Material);
 	Material->MarkPackageDirty();
 
 	bool bSave = JsonHelpers::GetOptionalBool(Request.JsonBody, TEXT("save"), true);
@@ -3719,7 +3741,10 @@ FRESTResponse FMaterialsHandler::HandleSetExpressionProperty(const FRESTRequest&
 
 	// Recompile material using proper API
 	Material->MarkPackageDirty();
-	UMaterialEditingLibrary::RecompileMaterial(Material);
+	FEditCoalescer::Run(Material, TEXT("PostEditChange"), FEditCoalescer::EPhase::Update, [Material]()
+	{
+		UMaterialEditingLibrary::RecompileMaterial(Material);
+	});
 	RefreshMaterialEditorGraph(Material);
 
 	bool bSave = JsonHelpers::GetOptionalBool(Request.JsonBody, TEXT("save"), true);
@@ -3762,59 +3787,38 @@ FRESTResponse FMaterialsHandler::HandleValidateGraph(const FRESTRequest& Request
 	int32 DisconnectedCount = 0;
 	int32 ConnectionCount = 0;
 
-	// Build a set of expressions that are used as inputs somewhere
-	TSet<UMaterialExpression*> UsedExpressions;
+	const TSharedRef<const FMaterialGraphIndex::FConnections> Connections = FMaterialGraphIndex::GetConnections(Material);
 
-	// Check material property connections
-	auto CheckPropertyConnection = [&](FExpressionInput& Input, const FString& PropertyName)
+	// Check main material properties
+	static const EMaterialProperty CheckedProperties[] = {
+		MP_BaseColor, MP_Metallic, MP_Specular, MP_Roughness, MP_EmissiveColor,
+		MP_Normal, MP_Opacity, MP_OpacityMask, MP_AmbientOcclusion
+	};
+	for (EMaterialProperty Property : CheckedProperties)
 	{
-		if (Input.Expression)
+		if (const FMaterialGraphIndex::FLink* Link = Connections->FindPropertyLink(Property))
 		{
-			UsedExpressions.Add(Input.Expression);
 			ConnectionCount++;
 
 			TSharedPtr<FJsonObject> ConnJson = MakeShared<FJsonObject>();
-			ConnJson->SetStringField(TEXT("source"), Input.Expression->GetName());
-			ConnJson->SetStringField(TEXT("target_property"), PropertyName);
+			ConnJson->SetStringField(TEXT("source"), Link->Source->GetName());
+			ConnJson->SetStringField(TEXT("target_property"), GetMaterialPropertyName(Property));
 			ConnectionsArray.Add(MakeShared<FJsonValueObject>(ConnJson));
 		}
-	};
-
-	// Check main material properties
-	CheckPropertyConnection(Material->GetEditorOnlyData()->BaseColor, TEXT("BaseColor"));
-	CheckPropertyConnection(Material->GetEditorOnlyData()->Metallic, TEXT("Metallic"));
-	CheckPropertyConnection(Material->GetEditorOnlyData()->Specular, TEXT("Specular"));
-	CheckPropertyConnection(Material->GetEditorOnlyData()->Roughness, TEXT("Roughness"));
-	CheckPropertyConnection(Material->GetEditorOnlyData()->EmissiveColor, TEXT("EmissiveColor"));
-	CheckPropertyConnection(Material->GetEditorOnlyData()->Normal, TEXT("Normal"));
-	CheckPropertyConnection(Material->GetEditorOnlyData()->Opacity, TEXT("Opacity"));
-	CheckPropertyConnection(Material->GetEditorOnlyData()->OpacityMask, TEXT("OpacityMask"));
-	CheckPropertyConnection(Material->GetEditorOnlyData()->AmbientOcclusion, TEXT("AmbientOcclusion"));
+	}
 
 	// Check expression-to-expression connections
-	for (UMaterialExpression* Expression : Expressions)
+	for (const FMaterialGraphIndex::FLink& Link : Connections->GetLinks())
 	{
-		if (!Expression)
+		if (!Link.IsProperty())
 		{
-			continue;
-		}
+			ConnectionCount++;
 
-		// Iterate through all inputs of this expression
-		int32 InputIndex = 0;
-		while (FExpressionInput* Input = Expression->GetInput(InputIndex))
-		{
-			if (Input->Expression)
-			{
-				UsedExpressions.Add(Input->Expression);
-				ConnectionCount++;
-
-				TSharedPtr<FJsonObject> ConnJson = MakeShared<FJsonObject>();
-				ConnJson->SetStringField(TEXT("source"), Input->Expression->GetName());
-				ConnJson->SetStringField(TEXT("target_expression"), Expression->GetName());
-				ConnJson->SetNumberField(TEXT("target_input"), InputIndex);
-				ConnectionsArray.Add(MakeShared<FJsonValueObject>(ConnJson));
-			}
-			InputIndex++;
+			TSharedPtr<FJsonObject> ConnJson = MakeShared<FJsonObject>();
+			ConnJson->SetStringField(TEXT("source"), Link.Source->GetName());
+			ConnJson->SetStringField(TEXT("target_expression"), Link.Target->GetName());
+			ConnJson->SetNumberField(TEXT("target_input"), Link.InputIndex);
+			ConnectionsArray.Add(MakeShared<FJsonValueObject>(ConnJson));
 		}
 	}
 
@@ -3838,7 +3842,7 @@ FRESTResponse FMaterialsHandler::HandleValidateGraph(const FRESTRequest& Request
 		}
 
 		// Check if this expression is used anywhere
-		if (!UsedExpressions.Contains(Expression))
+		if (!Connections->HasConsumers(Expression))
 		{
 			DisconnectedCount++;
 
@@ -4056,16 +4060,17 @@ FRESTResponse FMaterialsHandler::HandleDisconnect(const FRESTRequest& Request)
 		FScopedTransaction Transaction(FText::FromString(FString::Printf(
 			TEXT("Disconnect %s"), bHasTargetProperty ? *TargetProperty : *TargetExpressionName)));
 
-		Material->PreEditChange(nullptr);
+		FEditCoalescer::PreEditChange(Material);
 
 		// Write through editor graph only
 		InputPin->BreakAllPinLinks();
 
 		// Sync graph → data model (equivalent to Apply in editor)
 		MaterialGraph->LinkMaterialExpressionsFromGraph();
+		FMaterialGraphIndex::Invalidate(Material);
 
 		// Trigger recompile
-		Material->PostEditChange();
+		FEditCoalescer::PostEditChange(Material);
 		Material->MarkPackageDirty();
 
 		bool bSave = JsonHelpers::GetOptionalBool(Request.JsonBody, TEXT("save"), true);
@@ -4291,46 +4296,21 @@ FRESTResponse FMaterialsHandler::HandleDeleteExpression(const FRESTRequest& Requ
 	// Store expression info before deletion
 	FString ExpressionClass = ExpressionToDelete->GetClass()->GetName();
 
-	// Disconnect all connections TO this expression (from material properties)
-	auto DisconnectProperty = [ExpressionToDelete](FExpressionInput& Input)
-	{
-		if (Input.Expression == ExpressionToDelete)
-		{
-			Input.Expression = nullptr;
-			Input.OutputIndex = 0;
-		}
-	};
-
-	DisconnectProperty(Material->GetEditorOnlyData()->BaseColor);
-	DisconnectProperty(Material->GetEditorOnlyData()->Metallic);
-	DisconnectProperty(Material->GetEditorOnlyData()->Specular);
-	DisconnectProperty(Material->GetEditorOnlyData()->Roughness);
-	DisconnectProperty(Material->GetEditorOnlyData()->EmissiveColor);
-	DisconnectProperty(Material->GetEditorOnlyData()->Normal);
-	DisconnectProperty(Material->GetEditorOnlyData()->Opacity);
-	DisconnectProperty(Material->GetEditorOnlyData()->OpacityMask);
-	DisconnectProperty(Material->GetEditorOnlyData()->AmbientOcclusion);
-
-	// Disconnect all connections TO this expression (from other expressions' inputs)
-	for (UMaterialExpression* Expression : Material->GetExpressions())
+	// Disconnect all connections TO this expression (material properties and other expressions' inputs)
+	TArray<const FMaterialGraphIndex::FLink*> Consumers;
+	FMaterialGraphIndex::GetConnections(Material)->GetConsumers(ExpressionToDelete, Consumers);
+	for (const FMaterialGraphIndex::FLink* Link : Consumers)
 	{
-		if (!Expression || Expression == ExpressionToDelete)
-		{
-			continue;
-		}
-
-		// Iterate through all inputs of this expression and disconnect if pointing to our target
-		int32 InputIndex = 0;
-		while (FExpressionInput* Input = Expression->GetInput(InputIndex))
+		FExpressionInput* Input = Link->IsProperty()
+			? Material->GetExpressionInputForProperty(Link->Property)
+			: Link->Target->GetInput(Link->InputIndex);
+		if (Input && Input->Expression == ExpressionToDelete && Link->Target != ExpressionToDelete)
 		{
-			if (Input->Expression == ExpressionToDelete)
-			{
-				Input->Expression = nullptr;
-				Input->OutputIndex = 0;
-			}
-			InputIndex++;
+			Input->Expression = nullptr;
+			Input->OutputIndex = 0;
 		}
 	}
+	FMaterialGraphIndex::Invalidate(Material);
 
 	// Get the MaterialGraph from the expression's GraphNode (more reliable)
 	UMaterialGraph* MaterialGraph = nullptr;
@@ -4377,7 +4357,11 @@ FRESTResponse FMaterialsHandler::HandleDeleteExpression(const FRESTRequest& Requ
 	}
 
 	// Notify editor and recompile
-	if (MaterialEditor.IsValid())
+	if (FEditCoalescer::IsCoalescing())
+	{
+		RefreshMaterialEditorGraph(Material);
+	}
+	else if (MaterialEditor.IsValid())
 	{
 		MaterialEditor->UpdateMaterialAfterGraphChange();
 	}
@@ -4741,16 +4725,7 @@ FRESTResponse FMaterialsHandler::HandleImportGraph(const FRESTRequest& Request)
 				// (Editor API creates in graph but may not add to Material->GetExpressions())
 				if (NewExpression)
 				{
-					bool bFoundInMaterial = false;
-					for (UMaterialExpression* Expr : Material->GetExpressions())
-					{
-						if (Expr == NewExpression)
-						{
-							bFoundInMaterial = true;
-							break;
-						}
-					}
-					if (!bFoundInMaterial)
+					if (FMaterialGraphIndex::FindExpression(Material, NewExpression->GetName()) != NewExpression)
 					{
 						Material->GetExpressionCollection().AddExpression(NewExpression);
 					}
@@ -5335,16 +5310,7 @@ FRESTResponse FMaterialsHandler::HandleImportMaterialFunctionGraph(const FRESTRe
 
 				if (NewExpression)
 				{
-					bool bFoundInFunction = false;
-					for (UMaterialExpression* Expr : Function->GetExpressions())
-					{
-						if (Expr == NewExpression)
-						{
-							bFoundInFunction = true;
-							break;
-						}
-					}
-					if (!bFoundInFunction)
+					if (FMaterialGraphIndex::FindExpression(Function, NewExpression->GetName()) != NewExpression)
 					{
 						Function->GetExpressionCollection().AddExpression(NewExpression);
 					}
@@ -5641,6 +5607,235 @@ FRESTResponse FMaterialsHandler::HandleImportMaterialFunctionGraph(const FRESTRe
 	return FRESTResponse::Ok(Response);
 }
 
+/** Graph at Current, as changes since the client's revision when that one is still remembered */
+static FRESTResponse GraphDiffResponse(const TCHAR* PathField, const FString& AssetPath, const FMaterialGraphSnapshot& Current, const FString& Since)
+{
+	const TSharedPtr<const FMaterialGraphSnapshot> Base = Since.IsEmpty() ? nullptr : FMaterialGraphDiff::Find(AssetPath, Since);
+
+	FRESTJsonWriter Writer;
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("success"), true);
+	Writer.WriteValue(PathField, AssetPath);
+	Writer.WriteValue(TEXT("revision"), Current.Revision);
+	if (Since.IsEmpty())
+	{
+		Writer.WriteNull(TEXT("base_revision"));
+	}
+	else
+	{
+		Writer.WriteValue(TEXT("base_revision"), Since);
+	}
+	Writer.WriteValue(TEXT("full"), !Base.IsValid());
+	Writer.WriteValue(TEXT("node_count"), Current.Nodes.Num());
+	if (Base.IsValid())
+	{
+		Writer.WriteValue(TEXT("change_count"), Current.CountChanges(*Base));
+		Current.WriteDiffJson(Writer, *Base);
+	}
+	else
+	{
+		Current.WriteJson(Writer);
+	}
+	Writer.WriteObjectEnd();
+
+	return FRESTResponse::Stream(Writer);
+}
+
+/** Validates "ops" and the optional "base_revision" of a patch request against the graph as it is now */
+static bool ValidatePatchRequest(const FRESTRequest& Request, UMaterial* Material, UMaterialFunction* Function,
+	const TArray<TSharedPtr<FJsonValue>>*& OutOperations, FRESTResponse& OutError)
+{
+	if (!Request.JsonBody.IsValid() || !Request.JsonBody->TryGetArrayField(TEXT("ops"), OutOperations))
+	{
+		OutError = FRESTResponse::BadRequest(TEXT("Missing required field: ops (array of patch operations)"));
+		return false;
+	}
+
+	const FString BaseRevision = JsonHelpers::GetOptionalString(Request.JsonBody, TEXT("base_revision"));
+	if (!BaseRevision.IsEmpty())
+	{
+		const FString CurrentRevision = FMaterialGraphSnapshot::Capture(Material, Function)->Revision;
+		if (CurrentRevision != BaseRevision)
+		{
+			OutError = FRESTResponse::Error(409, TEXT("REVISION_CONFLICT"),
+				FString::Printf(TEXT("Graph changed since revision %s (now %s); fetch a diff and retry"), *BaseRevision, *CurrentRevision));
+			OutError.JsonBody->SetStringField(TEXT("revision"), CurrentRevision);
+			return false;
+		}
+	}
+	return true;
+}
+
+static FRESTResponse PatchResponse(const FMaterialGraphDiff::FPatchResult& Result, const FString& Revision)
+{
+	if (Result.FailedIndex != INDEX_NONE)
+	{
+		FRESTResponse Response = FRESTResponse::Error(400, TEXT("PATCH_FAILED"),
+			FString::Printf(TEXT("Operation %d failed: %s"), Result.FailedIndex, *Result.Error));
+		Response.JsonBody->SetNumberField(TEXT("failed_index"), Result.FailedIndex);
+		Response.JsonBody->SetNumberField(TEXT("applied"), Result.Applied);
+		Response.JsonBody->SetStringField(TEXT("revision"), Revision);
+		return Response;
+	}
+
+	FRESTJsonWriter Writer;
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("success"), true);
+	Writer.WriteValue(TEXT("revision"), Revision);
+	Writer.WriteValue(TEXT("applied"), Result.Applied);
+	Writer.WriteObjectStart(TEXT("created"));
+	for (const TPair<FString, FString>& Created : Result.CreatedNames)
+	{
+		Writer.WriteValue(Created.Key, Created.Value);
+	}
+	Writer.WriteObjectEnd();
+	Writer.WriteObjectEnd();
+
+	return FRESTResponse::Stream(Writer);
+}
+
+FRESTResponse FMaterialsHandler::HandleGraphDiff(const FRESTRequest& Request)
+{
+	const FString* MaterialPathPtr = Request.QueryParams.Find(TEXT("material_path"));
+	if (!MaterialPathPtr || MaterialPathPtr->IsEmpty())
+	{
+		return FRESTResponse::BadRequest(TEXT("Missing required parameter: material_path"));
+	}
+
+	UMaterial* Material = nullptr;
+	FString Error;
+	if (!FindActiveMaterialEditor(Material, Error, *MaterialPathPtr))
+	{
+		return FRESTResponse::Error(400, TEXT("NO_MATERIAL_EDITOR"), Error);
+	}
+
+	const FString AssetPath = Material->GetPathName();
+	const FString* Since = Request.QueryParams.Find(TEXT("since"));
+	return GraphDiffResponse(TEXT("material_path"), AssetPath, *FMaterialGraphDiff::Capture(AssetPath, Material, nullptr), Since ? *Since : FString());
+}
+
+FRESTResponse FMaterialsHandler::HandleGraphPatch(const FRESTRequest& Request)
+{
+	FString MaterialPath;
+	FString Error;
+	if (!JsonHelpers::GetRequiredString(Request.JsonBody, TEXT("material_path"), MaterialPath, Error))
+	{
+		return FRESTResponse::BadRequest(Error);
+	}
+
+	UMaterial* Material = nullptr;
+	if (!FindActiveMaterialEditor(Material, Error, MaterialPath))
+	{
+		return FRESTResponse::Error(400, TEXT("NO_MATERIAL_EDITOR"), Error);
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Operations = nullptr;
+	FRESTResponse ErrorResponse;
+	if (!ValidatePatchRequest(Request, Material, nullptr, Operations, ErrorResponse))
+	{
+		return ErrorResponse;
+	}
+
+	FMaterialGraphDiff::FPatchResult Result;
+	{
+		// One undo step and one recompile for the whole patch
+		FEditCoalescer::FScope Scope(FText::FromString(FString::Printf(TEXT("REST Patch Material Graph (%d ops)"), Operations->Num())));
+
+		Material->Modify();
+		FEditCoalescer::PreEditChange(Material);
+		Result = FMaterialGraphDiff::Apply(Material, nullptr, *Operations);
+
+		Material->MarkPackageDirty();
+		FEditCoalescer::Run(Material, TEXT("PostEditChange"), FEditCoalescer::EPhase::Update, [Material]()
+		{
+			UMaterialEditingLibrary::RecompileMaterial(Material);
+		});
+		RefreshMaterialEditorGraph(Material);
+		SaveAssetIfRequested(Material, JsonHelpers::GetOptionalBool(Request.JsonBody, TEXT("save"), true));
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("MaterialsHandler: Patched %s (%d of %d ops)"), *Material->GetName(), Result.Applied, Operations->Num());
+
+	return PatchResponse(Result, FMaterialGraphDiff::Capture(Material->GetPathName(), Material, nullptr)->Revision);
+}
+
+FRESTResponse FMaterialsHandler::HandleMaterialFunctionGraphDiff(const FRESTRequest& Request)
+{
+	const FString* FunctionPathPtr = Request.QueryParams.Find(TEXT("function_path"));
+	if (!FunctionPathPtr || FunctionPathPtr->IsEmpty())
+	{
+		return FRESTResponse::BadRequest(TEXT("Missing required parameter: function_path"));
+	}
+
+	UMaterialFunction* Function = nullptr;
+	FString Error;
+	if (!FindActiveMaterialFunctionEditor(Function, Error, *FunctionPathPtr))
+	{
+		return FRESTResponse::Error(400, TEXT("NO_FUNCTION_EDITOR"), Error);
+	}
+
+	const FString AssetPath = Function->GetPathName();
+	const FString* Since = Request.QueryParams.Find(TEXT("since"));
+	return GraphDiffResponse(TEXT("function_path"), AssetPath, *FMaterialGraphDiff::Capture(AssetPath, nullptr, Function), Since ? *Since : FString());
+}
+
+FRESTResponse FMaterialsHandler::HandleMaterialFunctionGraphPatch(const FRESTRequest& Request)
+{
+	FString FunctionPath;
+	FString Error;
+	if (!JsonHelpers::GetRequiredString(Request.JsonBody, TEXT("function_path"), FunctionPath, Error))
+	{
+		return FRESTResponse::BadRequest(Error);
+	}
+
+	UMaterialFunction* Function = nullptr;
+	if (!FindActiveMaterialFunctionEditor(Function, Error, FunctionPath))
+	{
+		return FRESTResponse::Error(400, TEXT("NO_FUNCTION_EDITOR"), Error);
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Operations = nullptr;
+	FRESTResponse ErrorResponse;
+	if (!ValidatePatchRequest(Request, nullptr, Function, Operations, ErrorResponse))
+	{
+		return ErrorResponse;
+	}
+
+	FMaterialGraphDiff::FPatchResult Result;
+	{
+		FEditCoalescer::FScope Scope(FText::FromString(FString::Printf(TEXT("REST Patch Material Function Graph (%d ops)"), Operations->Num())));
+
+		Function->Modify();
+		FEditCoalescer::PreEditChange(Function);
+		Result = FMaterialGraphDiff::Apply(nullptr, Function, *Operations);
+
+		Function->MarkPackageDirty();
+		FEditCoalescer::Run(Function, TEXT("UpdateFunction"), FEditCoalescer::EPhase::Update, [Function]()
+		{
+			UMaterialEditingLibrary::UpdateMaterialFunction(Function, nullptr);
+		});
+		FEditCoalescer::Run(Function, TEXT("RefreshGraph"), FEditCoalescer::EPhase::Refresh, [Function]()
+		{
+			if (Function->MaterialGraph)
+			{
+				Function->MaterialGraph->RebuildGraph();
+			}
+			TSharedPtr<IToolkit> EditorFound = FToolkitManager::Get().FindEditorForAsset(Function);
+			if (EditorFound.IsValid())
+			{
+				TSharedPtr<IMaterialEditor> MaterialEditor = StaticCastSharedPtr<IMaterialEditor>(EditorFound);
+				MaterialEditor->UpdateMaterialAfterGraphChange();
+				MaterialEditor->ForceRefreshExpressionPreviews();
+			}
+		});
+		SaveAssetIfRequested(Function, JsonHelpers::GetOptionalBool(Request.JsonBody, TEXT("save"), true));
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("MaterialsHandler: Patched function %s (%d of %d ops)"), *Function->GetName(), Result.Applied, Operations->Num());
+
+	return PatchResponse(Result, FMaterialGraphDiff::Capture(Function->GetPathName(), nullptr, Function)->Revision);
+}
+
 TArray<TSharedPtr<FJsonObject>> FMaterialsHandler::GetEndpointSchemas() const
 {
 	TArray<TSharedPtr<FJsonObject>> Schemas;
@@ -5687,9 +5882,17 @@ TArray<TSharedPtr<FJsonObject>> FMaterialsHandler::GetEndpointSchemas() const
 
 	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("POST")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/materials/editor/import")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Import material from XML definition (body: xml, path?, name?)"));
 
+	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("GET")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/materials/editor/diff")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Graph changes since a revision, or the full graph (query: material_path, since?)"));
+
+	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("POST")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/materials/editor/patch")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Apply add/remove/move/set/connect/disconnect ops in place with one recompile (body: material_path, ops, base_revision?, save?)"));
+
 	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("GET")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/materials/function/editor/export")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Export material function graph to XML format (query: function_path)"));
 
 	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("POST")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/materials/function/editor/import")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Import material function from XML definition (body: xml, path?, name?)"));
 
+	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("GET")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/materials/function/editor/diff")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Function graph changes since a revision, or the full graph (query: function_path, since?)"));
+
+	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("POST")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/materials/function/editor/patch")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Apply patch ops to a material function in place (body: function_path, ops, base_revision?, save?)"));
+
 	return Schemas;
 }
@@ -2,6 +2,8 @@
 
 #include "Handlers/PythonHandler.h"
 #include "RESTRouter.h"
+#include "Utils/EditorEventFeed.h"
+#include "Utils/EditorChangeTracker.h"
 #include "IPythonScriptPlugin.h"
 #include "Misc/Guid.h"
 #include "Misc/DateTime.h"
@@ -9,19 +11,420 @@
 #include "Dom/JsonValue.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Parse.h"
+#include "Misc/StringBuilder.h"
+#include "Misc/SecureHash.h"
+#include "Algo/Sort.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+static TAutoConsoleVariable<float> CVarPythonJobBudgetMs(
+	TEXT("UnrealPythonREST.PythonJobBudgetMs"),
+	8.0f,
+	TEXT("Game-thread time per tick for running queued async Python jobs. At least one job starts each tick."));
+
+static TAutoConsoleVariable<int32> CVarPythonMaxOutputKB(
+	TEXT("UnrealPythonREST.PythonMaxOutputKB"),
+	1024,
+	TEXT("Captured Python output kept in memory per job. Longer output is truncated and the full capture written to Saved/UnrealPythonREST/JobOutput. 0 = unlimited."));
+
+namespace
+{
+	/**
+	 * Arms a watchdog that raises TimeoutError in the game thread's running script.
+	 * State lives in a throwaway module so it survives the private scope each command runs in.
+	 */
+	const TCHAR WatchdogArmScript[] = TEXT(
+		"import ctypes, sys, threading, types\n"
+		"_state = sys.modules.setdefault('_unreal_rest_watchdog', types.ModuleType('_unreal_rest_watchdog'))\n"
+		"_tid = threading.get_ident()\n"
+		"def _fire():\n"
+		"    ctypes.pythonapi.PyThreadState_SetAsyncExc(ctypes.c_ulong(_tid), ctypes.py_object(TimeoutError))\n"
+		"_state.timer = threading.Timer(%d, _fire)\n"
+		"_state.timer.daemon = True\n"
+		"_state.timer.start()\n");
+
+	const TCHAR WatchdogDisarmScript[] = TEXT(
+		"import sys\n"
+		"_state = sys.modules.get('_unreal_rest_watchdog')\n"
+		"if _state is not None and getattr(_state, 'timer', None) is not None:\n"
+		"    _state.timer.cancel()\n"
+		"    _state.timer = None\n");
+
+	/**
+	 * Snippet runtime: compiled code objects keyed by name, plus the call shim.
+	 * A snippet reads its arguments from `args` and may set `result`, which is
+	 * printed as JSON on one marker line and lifted into the response.
+	 */
+	const TCHAR SnippetRuntimeScript[] = TEXT(
+		"import json, sys, types\n"
+		"if '_unreal_rest_snippets' not in sys.modules:\n"
+		"    _m = types.ModuleType('_unreal_rest_snippets')\n"
+		"    _m.snippets = {}\n"
+		"    def _register(name, digest, source):\n"
+		"        _m.snippets[name] = (digest, compile(source, '<snippet:' + name + '>', 'exec'))\n"
+		"    def _call(name, digest, args_json):\n"
+		"        entry = _m.snippets.get(name)\n"
+		"        if entry is None or entry[0] != digest:\n"
+		"            raise KeyError('Snippet is not compiled in this Python session: ' + name)\n"
+		"        scope = {'__name__': '__snippet__', 'args': json.loads(args_json), 'result': None}\n"
+		"        exec(entry[1], scope)\n"
+		"        print('__unreal_rest_result__:' + json.dumps(scope.get('result'), default=str))\n"
+		"    _m.register = _register\n"
+		"    _m.call = _call\n"
+		"    sys.modules['_unreal_rest_snippets'] = _m\n");
+
+	const TCHAR SnippetResultMarker[] = TEXT("__unreal_rest_result__:");
+
+	/** Printed instead of running when this Python session has no code object for the snippet */
+	const TCHAR SnippetMissingMarker[] = TEXT("__unreal_rest_snippet_missing__");
+
+	/** True if a call reported that the snippet is not compiled on the Python side */
+	bool IsSnippetMissing(const FPythonExecutionResult& Result)
+	{
+		return Result.LogEntries.ContainsByPredicate([](const FPythonJobLogEntry& Entry)
+		{
+			return Entry.Level == EPythonJobLogLevel::Info && Entry.Text.Equals(SnippetMissingMarker, ESearchCase::CaseSensitive);
+		});
+	}
+
+	/** Quote text as a Python string literal */
+	FString ToPythonLiteral(FStringView Text)
+	{
+		FString Literal;
+		Literal.Reserve(Text.Len() + 16);
+		Literal.AppendChar(TEXT('"'));
+		for (TCHAR Char : Text)
+		{
+			switch (Char)
+			{
+			case TEXT('\\'): Literal.Append(TEXT("\\\\")); break;
+			case TEXT('"'): Literal.Append(TEXT("\\\"")); break;
+			case TEXT('\n'): Literal.Append(TEXT("\\n")); break;
+			case TEXT('\r'): Literal.Append(TEXT("\\r")); break;
+			case TEXT('\t'): Literal.Append(TEXT("\\t")); break;
+			default:
+				if (Char < 0x20)
+				{
+					Literal.Appendf(TEXT("\\x%02x"), static_cast<uint32>(Char));
+				}
+				else
+				{
+					Literal.AppendChar(Char);
+				}
+				break;
+			}
+		}
+		Literal.AppendChar(TEXT('"'));
+		return Literal;
+	}
+
+	/** SHA-1 of the UTF-8 source, as hex */
+	FString HashSnippetSource(const FString& Code)
+	{
+		FTCHARToUTF8 Utf8(*Code);
+		FSHAHash Hash;
+		FSHA1::HashBuffer(Utf8.Get(), Utf8.Length(), Hash.Hash);
+		return Hash.ToString().ToLower();
+	}
+
+	const TCHAR* JobStatusToString(EPythonJobStatus Status)
+	{
+		switch (Status)
+		{
+		case EPythonJobStatus::Pending:
+			return TEXT("pending");
+		case EPythonJobStatus::Running:
+			return TEXT("running");
+		case EPythonJobStatus::Completed:
+			return TEXT("completed");
+		case EPythonJobStatus::Failed:
+			return TEXT("failed");
+		case EPythonJobStatus::Cancelled:
+			return TEXT("cancelled");
+		}
+		return TEXT("unknown");
+	}
+
+	/** Tell /events pollers a job reached a final state */
+	void PostJobFinished(const FString& JobId, EPythonJobStatus Status)
+	{
+		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+		Data->SetStringField(TEXT("status"), JobStatusToString(Status));
+		FEditorEventFeed::Post(EEditorEventTopic::Jobs, TEXT("finished"), JobId, Data);
+	}
+
+	const TCHAR* LogLevelToString(EPythonJobLogLevel Level)
+	{
+		switch (Level)
+		{
+		case EPythonJobLogLevel::Warning:
+			return TEXT("warning");
+		case EPythonJobLogLevel::Error:
+			return TEXT("error");
+		default:
+			return TEXT("info");
+		}
+	}
+
+	EPythonJobLogLevel ToLogLevel(EPythonLogOutputType Type)
+	{
+		switch (Type)
+		{
+		case EPythonLogOutputType::Warning:
+			return EPythonJobLogLevel::Warning;
+		case EPythonLogOutputType::Error:
+			return EPythonJobLogLevel::Error;
+		default:
+			return EPythonJobLogLevel::Info;
+		}
+	}
+
+	/** Number of slots ExpireSome looks at per call */
+	constexpr int32 ExpireSlotsPerCall = 4;
+
+	/**
+	 * Truncate LogEntries past UnrealPythonREST.PythonMaxOutputKB, spilling the full
+	 * capture to Saved/UnrealPythonREST/JobOutput first. Touches the disk, so it runs
+	 * before JobsLock is taken. OutOutputFile is empty if nothing was spilled.
+	 */
+	void TruncateOutput(TArray<FPythonJobLogEntry>& LogEntries, FString& OutOutputFile)
+	{
+		const int64 MaxChars = static_cast<int64>(CVarPythonMaxOutputKB.GetValueOnAnyThread()) * 1024;
+
+		int64 TotalChars = 0;
+		int32 KeepCount = LogEntries.Num();
+		for (int32 Index = 0; Index < LogEntries.Num(); ++Index)
+		{
+			TotalChars += LogEntries[Index].Text.Len();
+			if (MaxChars > 0 && TotalChars > MaxChars && KeepCount == LogEntries.Num())
+			{
+				KeepCount = Index;
+			}
+		}
+
+		if (KeepCount == LogEntries.Num())
+		{
+			return;
+		}
+
+		// Spill the full capture, then keep only the head in memory. The job ID is not
+		// known until the record is created under the lock, so the file gets its own name.
+		const FString Dir = FPaths::ProjectSavedDir() / TEXT("UnrealPythonREST") / TEXT("JobOutput");
+		const FString FilePath = FPaths::ConvertRelativePathToFull(Dir / (FGuid::NewGuid().ToString(EGuidFormats::Digits).ToLower() + TEXT(".log")));
+
+		TStringBuilder<4096> Builder;
+		for (const FPythonJobLogEntry& Entry : LogEntries)
+		{
+			Builder.Appendf(TEXT("[%s] "), LogLevelToString(Entry.Level));
+			Builder.Append(Entry.Text);
+			Builder.AppendChar(TEXT('\n'));
+		}
+
+		IFileManager::Get().MakeDirectory(*Dir, true);
+		if (FFileHelper::SaveStringToFile(Builder.ToView(), *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			OutOutputFile = FilePath;
+		}
+
+		const int32 Dropped = LogEntries.Num() - KeepCount;
+		LogEntries.SetNum(KeepCount);
+		LogEntries.Add({ EPythonJobLogLevel::Warning, FString::Printf(TEXT("Output truncated: %d more lines (%lld chars total)%s%s"),
+			Dropped, TotalChars, OutOutputFile.IsEmpty() ? TEXT("") : TEXT(", full output in "), *OutOutputFile) });
+	}
+}
+
+// ============================================================================
+// Job Store
+// ============================================================================
+
+FString FPythonJob::GetOutput() const
+{
+	TStringBuilder<1024> Builder;
+	for (const FPythonJobLogEntry& Entry : LogEntries)
+	{
+		if (Entry.Level == EPythonJobLogLevel::Info)
+		{
+			if (Builder.Len() > 0)
+			{
+				Builder.AppendChar(TEXT('\n'));
+			}
+			Builder.Append(Entry.Text);
+		}
+	}
+	return FString(Builder.ToView());
+}
+
+FPythonJobStore::FPythonJobStore(int32 InCapacity)
+{
+	check(InCapacity > 0 && InCapacity <= 0xFFFF);
+	Slots.SetNum(InCapacity);
+	SessionTag = static_cast<uint32>(FGuid::NewGuid().A);
+}
+
+FPythonJob* FPythonJobStore::Add()
+{
+	const int32 Capacity = Slots.Num();
+
+	// The slot at Head is the oldest; skip past the few that are still pending or running
+	for (int32 Attempt = 0; Attempt < Capacity; ++Attempt)
+	{
+		const int32 SlotIndex = Head;
+		FSlot& Slot = Slots[SlotIndex];
+		Head = (Head + 1) % Capacity;
+
+		if (Slot.bOccupied && !Slot.Job.IsFinished())
+		{
+			continue;
+		}
+
+		if (Slot.bOccupied)
+		{
+			ReleaseSlot(Slot);
+		}
+
+		Slot.Generation++;
+		Slot.bOccupied = true;
+		Count++;
+
+		Slot.Job.JobId = FString::Printf(TEXT("%08x-%04x-%08x"), SessionTag, SlotIndex, Slot.Generation);
+		return &Slot.Job;
+	}
+
+	return nullptr;
+}
+
+FPythonJob* FPythonJobStore::Find(const FString& JobId)
+{
+	// <session:8>-<slot:4>-<generation:8>
+	if (JobId.Len() != 22 || JobId[8] != TEXT('-') || JobId[13] != TEXT('-'))
+	{
+		return nullptr;
+	}
+
+	const uint32 Session = FParse::HexNumber(*JobId.Left(8));
+	const int32 SlotIndex = static_cast<int32>(FParse::HexNumber(*JobId.Mid(9, 4)));
+	const uint32 Generation = FParse::HexNumber(*JobId.Right(8));
+
+	if (Session != SessionTag || !Slots.IsValidIndex(SlotIndex))
+	{
+		return nullptr;
+	}
+
+	FSlot& Slot = Slots[SlotIndex];
+	return Slot.bOccupied && Slot.Generation == Generation ? &Slot.Job : nullptr;
+}
+
+void FPythonJobStore::ExpireSome(FTimespan MaxAge)
+{
+	const FDateTime Now = FDateTime::UtcNow();
+	for (int32 Step = 0; Step < ExpireSlotsPerCall; ++Step)
+	{
+		FSlot& Slot = Slots[ExpireCursor];
+		ExpireCursor = (ExpireCursor + 1) % Slots.Num();
+
+		if (Slot.bOccupied && Slot.Job.IsFinished() && Now - Slot.Job.EndTime > MaxAge)
+		{
+			ReleaseSlot(Slot);
+		}
+	}
+}
+
+int32 FPythonJobStore::ListNewestFirst(int32 Offset, int32 Limit, TFunctionRef<void(const FPythonJob&)> Visitor) const
+{
+	// Ring order is not submit order: Add skips slots still running, and a synchronous
+	// execute takes its slot only after it finishes. Sort the live jobs by submit time.
+	TArray<const FPythonJob*> Live;
+	Live.Reserve(Count);
+	for (const FSlot& Slot : Slots)
+	{
+		if (Slot.bOccupied)
+		{
+			Live.Add(&Slot.Job);
+		}
+	}
+	Algo::Sort(Live, [](const FPythonJob* A, const FPythonJob* B) { return A->SubmitTime > B->SubmitTime; });
+
+	const int32 End = FMath::Min(Live.Num(), Offset + Limit);
+	for (int32 Index = FMath::Max(Offset, 0); Index < End; ++Index)
+	{
+		Visitor(*Live[Index]);
+	}
+
+	return Count;
+}
+
+void FPythonJobStore::Empty()
+{
+	for (FSlot& Slot : Slots)
+	{
+		if (Slot.bOccupied)
+		{
+			ReleaseSlot(Slot);
+		}
+	}
+	Head = 0;
+	ExpireCursor = 0;
+}
+
+void FPythonJobStore::ReleaseSlot(FSlot& Slot)
+{
+	// Large buffers go back to the allocator; small ones are reused by the next job in this slot
+	FPythonJob& Job = Slot.Job;
+	Job.Code.Empty();
+	Job.LogEntries.Empty(Job.LogEntries.Max() > 256 ? 0 : Job.LogEntries.Max());
+	Job.OutputFile.Empty();
+	Job.Error.Empty();
+	Job.Status = EPythonJobStatus::Pending;
+	Job.TimeoutSeconds = 0;
+	Job.bTimedOut = false;
+
+	Slot.bOccupied = false;
+	Count--;
+}
+
+// ============================================================================
+// Handler
+// ============================================================================
+
+FPythonHandler::FPythonHandler()
+	: Jobs(MaxJobs)
+{
+}
 
 void FPythonHandler::RegisterRoutes(FRESTRouter& Router)
 {
-	// POST /python/execute - Synchronous Python execution
+	// POST /python/execute - Synchronous Python execution (or queued, with "async": true)
 	Router.RegisterRoute(ERESTMethod::POST, TEXT("/python/execute"),
 		FRESTRouteHandler::CreateRaw(this, &FPythonHandler::HandleExecute));
 
+	// POST /python/jobs - Queue Python code and return immediately
+	Router.RegisterRoute(ERESTMethod::POST, TEXT("/python/jobs"),
+		FRESTRouteHandler::CreateRaw(this, &FPythonHandler::HandleSubmitJob));
+
 	// GET /python/jobs - List all jobs
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/python/jobs"),
 		FRESTRouteHandler::CreateRaw(this, &FPythonHandler::HandleListJobs));
 
-	// GET /python/jobs/{id} - Get specific job (handled via query param for now)
-	// Note: Path parameters require custom parsing; use query param ?id=xxx
+	// GET /python/jobs/{id} - Get specific job
+	Router.RegisterRoute(ERESTMethod::GET, TEXT("/python/jobs/{id}"),
+		FRESTRouteHandler::CreateLambda([this](const FRESTRequest& Request) -> FRESTResponse
+		{
+			return HandleGetJob(Request, Request.PathParams.FindRef(TEXT("id")));
+		}));
+
+	// DELETE /python/jobs/{id} - Cancel a job
+	Router.RegisterRoute(ERESTMethod::DELETE, TEXT("/python/jobs/{id}"),
+		FRESTRouteHandler::CreateLambda([this](const FRESTRequest& Request) -> FRESTResponse
+		{
+			return HandleCancelJob(Request, Request.PathParams.FindRef(TEXT("id")));
+		}));
+
+	// GET /python/job?id={id} - Older query-parameter form, kept for existing clients
 	Router.RegisterRoute(ERESTMethod::GET, TEXT("/python/job"),
 		FRESTRouteHandler::CreateLambda([this](const FRESTRequest& Request) -> FRESTResponse
 		{
@@ -33,7 +436,7 @@ void FPythonHandler::RegisterRoutes(FRESTRouter& Router)
 			return HandleGetJob(Request, *JobIdPtr);
 		}));
 
-	// DELETE /python/job?id={id} - Cancel a job
+	// DELETE /python/job?id={id} - Older query-parameter form, kept for existing clients
 	Router.RegisterRoute(ERESTMethod::DELETE, TEXT("/python/job"),
 		FRESTRouteHandler::CreateLambda([this](const FRESTRequest& Request) -> FRESTResponse
 		{
@@ -45,156 +448,577 @@ void FPythonHandler::RegisterRoutes(FRESTRouter& Router)
 			return HandleCancelJob(Request, *JobIdPtr);
 		}));
 
+	// POST /python/register - Compile a named snippet once
+	Router.RegisterRoute(ERESTMethod::POST, TEXT("/python/register"),
+		FRESTRouteHandler::CreateRaw(this, &FPythonHandler::HandleRegisterSnippet));
+
+	// POST /python/call - Run a registered snippet with JSON arguments
+	Router.RegisterRoute(ERESTMethod::POST, TEXT("/python/call"),
+		FRESTRouteHandler::CreateRaw(this, &FPythonHandler::HandleCallSnippet));
+
+	// GET /python/snippets - List registered snippets
+	Router.RegisterRoute(ERESTMethod::GET, TEXT("/python/snippets"),
+		FRESTRouteHandler::CreateRaw(this, &FPythonHandler::HandleListSnippets));
+
+	// Drain the async job queue on the game thread
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FPythonHandler::TickJobQueue));
+
 	UE_LOG(LogTemp, Log, TEXT("PythonHandler: Registered routes at /python"));
 }
 
-FRESTResponse FPythonHandler::HandleExecute(const FRESTRequest& Request)
+bool FPythonHandler::ParseCodeRequest(const FRESTRequest& Request, FString& OutCode, int32& OutTimeoutSeconds, FString& OutError) const
 {
 	// Validate JSON body exists
 	if (!Request.JsonBody.IsValid())
 	{
-		return FRESTResponse::BadRequest(TEXT("Request body must be valid JSON"));
+		OutError = TEXT("Request body must be valid JSON");
+		return false;
 	}
 
 	// Get required "code" field
-	FString Code;
-	if (!Request.JsonBody->TryGetStringField(TEXT("code"), Code) || Code.IsEmpty())
+	if (!Request.JsonBody->TryGetStringField(TEXT("code"), OutCode) || OutCode.IsEmpty())
 	{
-		return FRESTResponse::BadRequest(TEXT("Missing required field: code"));
+		OutError = TEXT("Missing required field: code");
+		return false;
 	}
 
 	// Get optional timeout (default 30 seconds)
-	int32 TimeoutSeconds = 30;
+	OutTimeoutSeconds = 30;
 	if (Request.JsonBody->HasField(TEXT("timeout")))
 	{
-		TimeoutSeconds = static_cast<int32>(Request.JsonBody->GetNumberField(TEXT("timeout")));
-		if (TimeoutSeconds <= 0)
+		OutTimeoutSeconds = static_cast<int32>(Request.JsonBody->GetNumberField(TEXT("timeout")));
+		if (OutTimeoutSeconds <= 0)
 		{
-			TimeoutSeconds = 30;
+			OutTimeoutSeconds = 30;
 		}
 	}
 
-	// Get optional async flag (for future use, currently always sync)
+	return true;
+}
+
+FRESTResponse FPythonHandler::HandleExecute(const FRESTRequest& Request)
+{
+	FString Code;
+	int32 TimeoutSeconds = 0;
+	FString Error;
+	if (!ParseCodeRequest(Request, Code, TimeoutSeconds, Error))
+	{
+		return FRESTResponse::BadRequest(Error);
+	}
+
+	// Optional async flag - same as POST /python/jobs
 	bool bAsync = false;
 	if (Request.JsonBody->HasField(TEXT("async")))
 	{
 		bAsync = Request.JsonBody->GetBoolField(TEXT("async"));
 	}
 
+	if (bAsync)
+	{
+		return HandleSubmitJob(Request);
+	}
+
 	// Record start time
 	FDateTime StartTime = FDateTime::UtcNow();
 
 	// Execute the Python code
-	FString Output = ExecutePythonCode(Code);
+	FPythonExecutionResult Result = ExecutePythonCode(Code, TimeoutSeconds);
 
 	// Calculate duration
 	FDateTime EndTime = FDateTime::UtcNow();
 	double DurationMs = (EndTime - StartTime).GetTotalMilliseconds();
 
+	// Build the response first so the captured output can be moved into the job record
+	TSharedPtr<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+	ResponseJson->SetBoolField(TEXT("success"), Result.bSuccess);
+
+	FString OutputFile;
+	TruncateOutput(Result.LogEntries, OutputFile);
+
 	// Create a job record for tracking
-	FPythonJob Job;
-	Job.JobId = GenerateJobId();
-	Job.Code = Code;
-	Job.Status = EPythonJobStatus::Completed;
-	Job.Output = Output;
-	Job.StartTime = StartTime;
-	Job.EndTime = EndTime;
-	Job.TimeoutSeconds = TimeoutSeconds;
+	FScopeLock Lock(&JobsLock);
+	Jobs.ExpireSome(FTimespan::FromHours(JobExpirationHours));
 
-	// Store job for later retrieval
+	FPythonJob* Job = Jobs.Add();
+	if (!Job)
 	{
-		FScopeLock Lock(&JobsLock);
-		Jobs.Add(Job.JobId, Job);
-		CleanupOldJobs();
+		// Every slot is pending or running; the result is still returned, just not kept
+		ResponseJson->SetField(TEXT("job_id"), MakeShared<FJsonValueNull>());
+		FPythonJob Untracked;
+		Untracked.Error = Result.Error;
+		Untracked.bTimedOut = Result.bTimedOut;
+		Untracked.LogEntries = MoveTemp(Result.LogEntries);
+		Untracked.OutputFile = MoveTemp(OutputFile);
+		WriteJobOutput(Untracked, ResponseJson);
+	}
+	else
+	{
+		Job->Status = Result.bSuccess ? EPythonJobStatus::Completed : EPythonJobStatus::Failed;
+		Job->Error = Result.Error;
+		Job->SubmitTime = StartTime;
+		Job->StartTime = StartTime;
+		Job->EndTime = EndTime;
+		Job->TimeoutSeconds = TimeoutSeconds;
+		Job->bTimedOut = Result.bTimedOut;
+		Job->LogEntries = MoveTemp(Result.LogEntries);
+		Job->OutputFile = MoveTemp(OutputFile);
+
+		ResponseJson->SetStringField(TEXT("job_id"), Job->JobId);
+		WriteJobOutput(*Job, ResponseJson);
 	}
 
-	// Build success response
+	ResponseJson->SetNumberField(TEXT("duration_ms"), DurationMs);
+
+	return FRESTResponse::Ok(ResponseJson);
+}
+
+FRESTResponse FPythonHandler::HandleRegisterSnippet(const FRESTRequest& Request)
+{
+	if (!Request.JsonBody.IsValid())
+	{
+		return FRESTResponse::BadRequest(TEXT("Request body must be valid JSON"));
+	}
+
+	FString Name;
+	FString Code;
+	if (!Request.JsonBody->TryGetStringField(TEXT("name"), Name) || Name.IsEmpty())
+	{
+		return FRESTResponse::Error(400, TEXT("MISSING_FIELD"), TEXT("Missing required field: name"));
+	}
+	if (!Request.JsonBody->TryGetStringField(TEXT("code"), Code) || Code.IsEmpty())
+	{
+		return FRESTResponse::Error(400, TEXT("MISSING_FIELD"), TEXT("Missing required field: code"));
+	}
+
+	const FString Hash = HashSnippetSource(Code);
+
 	TSharedPtr<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+	ResponseJson->SetStringField(TEXT("name"), Name);
+	ResponseJson->SetStringField(TEXT("hash"), Hash);
+
+	// Same source as last time: skip the compile. If Python has since lost the code
+	// object (a Python reload), the next call recompiles it from the kept source.
+	if (const FPythonSnippet* Existing = Snippets.Find(Name))
+	{
+		if (Existing->Hash == Hash)
+		{
+			ResponseJson->SetBoolField(TEXT("success"), true);
+			ResponseJson->SetBoolField(TEXT("cached"), true);
+			return FRESTResponse::Ok(ResponseJson);
+		}
+	}
+
+	FString CompileError;
+	if (!CompileSnippet(Name, Hash, Code, CompileError))
+	{
+		// Compile failed; drop any older version so calls don't run stale code
+		Snippets.Remove(Name);
+		return FRESTResponse::Error(400, TEXT("COMPILE_FAILED"), CompileError);
+	}
+
+	FPythonSnippet& Snippet = Snippets.FindOrAdd(Name);
+	Snippet.Hash = Hash;
+	Snippet.Source = MoveTemp(Code);
+	Snippet.RegisteredAt = FDateTime::UtcNow();
+	Snippet.CallCount = 0;
+
+	UE_LOG(LogTemp, Log, TEXT("PythonHandler: Compiled snippet '%s' (%s)"), *Name, *Hash);
+
 	ResponseJson->SetBoolField(TEXT("success"), true);
-	ResponseJson->SetStringField(TEXT("job_id"), Job.JobId);
-	ResponseJson->SetStringField(TEXT("output"), Output);
+	ResponseJson->SetBoolField(TEXT("cached"), false);
+	return FRESTResponse::Ok(ResponseJson);
+}
 
-	// Empty logs array (Python output goes to UE log, not captured directly)
-	TArray<TSharedPtr<FJsonValue>> LogsArray;
-	ResponseJson->SetArrayField(TEXT("logs"), LogsArray);
+bool FPythonHandler::CompileSnippet(const FString& Name, const FString& Hash, const FString& Code, FString& OutError)
+{
+	const FString Command = FString::Printf(TEXT("%s\nsys.modules['_unreal_rest_snippets'].register(%s, %s, %s)\n"),
+		SnippetRuntimeScript, *ToPythonLiteral(Name), *ToPythonLiteral(Hash), *ToPythonLiteral(Code));
+
+	FPythonExecutionResult Result = ExecutePythonCode(Command, 0);
+	if (!Result.bSuccess)
+	{
+		OutError = MoveTemp(Result.Error);
+		return false;
+	}
+	return true;
+}
+
+FRESTResponse FPythonHandler::HandleCallSnippet(const FRESTRequest& Request)
+{
+	if (!Request.JsonBody.IsValid())
+	{
+		return FRESTResponse::BadRequest(TEXT("Request body must be valid JSON"));
+	}
+
+	FString Name;
+	if (!Request.JsonBody->TryGetStringField(TEXT("name"), Name) || Name.IsEmpty())
+	{
+		return FRESTResponse::Error(400, TEXT("MISSING_FIELD"), TEXT("Missing required field: name"));
+	}
+
+	FPythonSnippet* Snippet = Snippets.Find(Name);
+	if (!Snippet)
+	{
+		return FRESTResponse::Error(404, TEXT("SNIPPET_NOT_FOUND"),
+			FString::Printf(TEXT("Snippet '%s' is not registered. POST /python/register first."), *Name));
+	}
+
+	// A client holding an older version gets told to re-register instead of running the wrong code
+	FString ExpectedHash;
+	if (Request.JsonBody->TryGetStringField(TEXT("hash"), ExpectedHash) && !ExpectedHash.IsEmpty() && ExpectedHash != Snippet->Hash)
+	{
+		return FRESTResponse::Error(409, TEXT("SNIPPET_CHANGED"),
+			FString::Printf(TEXT("Snippet '%s' is registered with hash %s"), *Name, *Snippet->Hash));
+	}
+
+	FString ArgsJson = TEXT("{}");
+	const TSharedPtr<FJsonObject>* ArgsObject = nullptr;
+	if (Request.JsonBody->TryGetObjectField(TEXT("args"), ArgsObject))
+	{
+		ArgsJson.Reset();
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&ArgsJson);
+		FJsonSerializer::Serialize((*ArgsObject).ToSharedRef(), Writer);
+	}
+
+	int32 TimeoutSeconds = 30;
+	if (Request.JsonBody->HasField(TEXT("timeout")))
+	{
+		TimeoutSeconds = static_cast<int32>(Request.JsonBody->GetNumberField(TEXT("timeout")));
+		if (TimeoutSeconds <= 0)
+		{
+			TimeoutSeconds = 30;
+		}
+	}
+
+	// Only the name, hash and arguments cross into Python; the source was compiled at register time
+	const FString NameLiteral = ToPythonLiteral(Name);
+	const FString HashLiteral = ToPythonLiteral(Snippet->Hash);
+	const FString Command = FString::Printf(
+		TEXT("import sys\n")
+		TEXT("_m = sys.modules.get('_unreal_rest_snippets')\n")
+		TEXT("if _m is None or _m.snippets.get(%s, (None,))[0] != %s:\n")
+		TEXT("    print('%s')\n")
+		TEXT("else:\n")
+		TEXT("    _m.call(%s, %s, %s)\n"),
+		*NameLiteral, *HashLiteral, SnippetMissingMarker, *NameLiteral, *HashLiteral, *ToPythonLiteral(ArgsJson));
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	FPythonExecutionResult Result = ExecutePythonCode(Command, TimeoutSeconds);
+	if (IsSnippetMissing(Result))
+	{
+		// The Python side lost its code objects (e.g. a Python reload); recompile from the kept source and retry once
+		FString CompileError;
+		if (!CompileSnippet(Name, Snippet->Hash, Snippet->Source, CompileError))
+		{
+			Snippets.Remove(Name);
+			return FRESTResponse::Error(400, TEXT("COMPILE_FAILED"), CompileError);
+		}
+		UE_LOG(LogTemp, Log, TEXT("PythonHandler: Recompiled snippet '%s' missing from the Python session"), *Name);
+		Result = ExecutePythonCode(Command, TimeoutSeconds);
+	}
+	const double DurationMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+
+	Snippet->CallCount++;
+
+	// Lift the result line out of the captured output
+	TSharedPtr<FJsonValue> ResultValue;
+	for (int32 Index = Result.LogEntries.Num() - 1; Index >= 0; --Index)
+	{
+		const FPythonJobLogEntry& Entry = Result.LogEntries[Index];
+		if (Entry.Level == EPythonJobLogLevel::Info && Entry.Text.StartsWith(SnippetResultMarker, ESearchCase::CaseSensitive))
+		{
+			const FString Wrapped = FString::Printf(TEXT("{\"result\":%s}"), *Entry.Text.RightChop(UE_ARRAY_COUNT(SnippetResultMarker) - 1));
+			TSharedPtr<FJsonObject> Parsed;
+			if (FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Wrapped), Parsed) && Parsed.IsValid())
+			{
+				ResultValue = Parsed->TryGetField(TEXT("result"));
+			}
+			Result.LogEntries.RemoveAt(Index);
+			break;
+		}
+	}
+
+	TSharedPtr<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+	ResponseJson->SetBoolField(TEXT("success"), Result.bSuccess);
+	ResponseJson->SetStringField(TEXT("name"), Name);
+	ResponseJson->SetField(TEXT("result"), ResultValue.IsValid() ? ResultValue : MakeShared<FJsonValueNull>());
+
+	FPythonJob Untracked;
+	Untracked.Error = MoveTemp(Result.Error);
+	Untracked.bTimedOut = Result.bTimedOut;
+	Untracked.LogEntries = MoveTemp(Result.LogEntries);
+	WriteJobOutput(Untracked, ResponseJson);
 
 	ResponseJson->SetNumberField(TEXT("duration_ms"), DurationMs);
 
 	return FRESTResponse::Ok(ResponseJson);
 }
 
-FString FPythonHandler::ExecutePythonCode(const FString& Code)
+FRESTResponse FPythonHandler::HandleListSnippets(const FRESTRequest& Request)
+{
+	TArray<TSharedPtr<FJsonValue>> SnippetsArray;
+	SnippetsArray.Reserve(Snippets.Num());
+	for (const TPair<FString, FPythonSnippet>& Pair : Snippets)
+	{
+		TSharedPtr<FJsonObject> SnippetJson = MakeShared<FJsonObject>();
+		SnippetJson->SetStringField(TEXT("name"), Pair.Key);
+		SnippetJson->SetStringField(TEXT("hash"), Pair.Value.Hash);
+		SnippetJson->SetNumberField(TEXT("calls"), Pair.Value.CallCount);
+		SnippetJson->SetStringField(TEXT("registered_at"), Pair.Value.RegisteredAt.ToIso8601());
+		SnippetsArray.Add(MakeShared<FJsonValueObject>(SnippetJson));
+	}
+
+	TSharedPtr<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+	ResponseJson->SetBoolField(TEXT("success"), true);
+	ResponseJson->SetArrayField(TEXT("snippets"), SnippetsArray);
+	ResponseJson->SetNumberField(TEXT("count"), SnippetsArray.Num());
+
+	return FRESTResponse::Ok(ResponseJson);
+}
+
+FRESTResponse FPythonHandler::HandleSubmitJob(const FRESTRequest& Request)
+{
+	FString Code;
+	int32 TimeoutSeconds = 0;
+	FString Error;
+	if (!ParseCodeRequest(Request, Code, TimeoutSeconds, Error))
+	{
+		return FRESTResponse::BadRequest(Error);
+	}
+
+	FString JobId;
+	if (!EnqueueJob(Code, TimeoutSeconds, JobId))
+	{
+		return FRESTResponse::Error(503, TEXT("QUEUE_FULL"),
+			FString::Printf(TEXT("Python job queue is full (%d pending). Poll /python/jobs and retry."), MaxQueuedJobs));
+	}
+
+	TSharedPtr<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+	ResponseJson->SetBoolField(TEXT("success"), true);
+	ResponseJson->SetStringField(TEXT("job_id"), JobId);
+	ResponseJson->SetStringField(TEXT("status"), JobStatusToString(EPythonJobStatus::Pending));
+
+	FRESTResponse Response = FRESTResponse::Ok(ResponseJson);
+	Response.StatusCode = 202;
+	return Response;
+}
+
+bool FPythonHandler::EnqueueJob(const FString& Code, int32 TimeoutSeconds, FString& OutJobId)
+{
+	FScopeLock Lock(&JobsLock);
+
+	if (PendingJobs.Num() >= MaxQueuedJobs)
+	{
+		return false;
+	}
+
+	Jobs.ExpireSome(FTimespan::FromHours(JobExpirationHours));
+
+	FPythonJob* Job = Jobs.Add();
+	if (!Job)
+	{
+		return false;
+	}
+
+	Job->Code = Code;
+	Job->Status = EPythonJobStatus::Pending;
+	Job->SubmitTime = FDateTime::UtcNow();
+	Job->StartTime = Job->SubmitTime;
+	Job->TimeoutSeconds = TimeoutSeconds;
+
+	OutJobId = Job->JobId;
+	PendingJobs.Add(Job->JobId);
+
+	return true;
+}
+
+bool FPythonHandler::TickJobQueue(float DeltaTime)
+{
+	if (bRunningJob)
+	{
+		return true;
+	}
+
+	const double BudgetSeconds = CVarPythonJobBudgetMs.GetValueOnGameThread() / 1000.0;
+	const double TickStart = FPlatformTime::Seconds();
+
+	// Always start at least one job so a tiny budget can't starve the queue
+	do
+	{
+		FString JobId;
+		{
+			FScopeLock Lock(&JobsLock);
+			if (PendingJobs.Num() == 0)
+			{
+				break;
+			}
+			JobId = PendingJobs[0];
+			PendingJobs.RemoveAt(0);
+		}
+
+		RunJob(JobId);
+	}
+	while (FPlatformTime::Seconds() - TickStart < BudgetSeconds);
+
+	return true;
+}
+
+void FPythonHandler::RunJob(const FString& JobId)
 {
+	FString Code;
+	int32 TimeoutSeconds = 0;
+	{
+		FScopeLock Lock(&JobsLock);
+
+		FPythonJob* JobPtr = Jobs.Find(JobId);
+		if (!JobPtr || JobPtr->Status != EPythonJobStatus::Pending)
+		{
+			return;
+		}
+
+		JobPtr->Status = EPythonJobStatus::Running;
+		JobPtr->StartTime = FDateTime::UtcNow();
+		Code = MoveTemp(JobPtr->Code);
+		TimeoutSeconds = JobPtr->TimeoutSeconds;
+	}
+
+	FEditorEventFeed::Post(EEditorEventTopic::Jobs, TEXT("started"), JobId);
+
+	TGuardValue<bool> RunningGuard(bRunningJob, true);
+	FPythonExecutionResult Result = ExecutePythonCode(Code, TimeoutSeconds);
+
+	const EPythonJobStatus FinalStatus = Result.bSuccess ? EPythonJobStatus::Completed : EPythonJobStatus::Failed;
+	FString OutputFile;
+	TruncateOutput(Result.LogEntries, OutputFile);
+	{
+		FScopeLock Lock(&JobsLock);
+
+		// The job may have been dropped by Shutdown while it ran
+		FPythonJob* JobPtr = Jobs.Find(JobId);
+		if (!JobPtr)
+		{
+			return;
+		}
+
+		JobPtr->Status = FinalStatus;
+		JobPtr->Error = MoveTemp(Result.Error);
+		JobPtr->bTimedOut = Result.bTimedOut;
+		JobPtr->LogEntries = MoveTemp(Result.LogEntries);
+		JobPtr->OutputFile = MoveTemp(OutputFile);
+		JobPtr->EndTime = FDateTime::UtcNow();
+	}
+
+	PostJobFinished(JobId, FinalStatus);
+}
+
+FPythonExecutionResult FPythonHandler::ExecutePythonCode(const FString& Code, int32 TimeoutSeconds)
+{
+	FPythonExecutionResult Result;
+
 	// Get the Python script plugin
 	IPythonScriptPlugin* PythonPlugin = IPythonScriptPlugin::Get();
-	if (!PythonPlugin)
+	if (!PythonPlugin || !PythonPlugin->IsPythonAvailable())
 	{
 		UE_LOG(LogTemp, Error, TEXT("PythonHandler: IPythonScriptPlugin not available"));
-		return TEXT("");
+		Result.Error = TEXT("Python is not available in this editor");
+		return Result;
 	}
 
-	// Execute the Python command
-	// Note: ExecPythonCommand returns bool but output goes to log
-	// We cannot capture stdout directly with the sync API
-	bool bSuccess = PythonPlugin->ExecPythonCommand(*Code);
+	// Script code can't be interrupted from C++, so a Python timer raises TimeoutError into it instead
+	if (TimeoutSeconds > 0)
+	{
+		FPythonCommandEx ArmCommand;
+		ArmCommand.Command = FString::Printf(WatchdogArmScript, TimeoutSeconds);
+		ArmCommand.Flags |= EPythonCommandFlags::Unattended;
+		if (!PythonPlugin->ExecPythonCommandEx(ArmCommand))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("PythonHandler: Could not arm timeout watchdog: %s"), *ArmCommand.CommandResult);
+		}
+	}
+
+	// Same execution mode and scope as ExecPythonCommand, plus captured output
+	FPythonCommandEx Command;
+	Command.Command = Code;
+	const double ExecStart = FPlatformTime::Seconds();
+	Result.bSuccess = PythonPlugin->ExecPythonCommandEx(Command);
+	const double ExecSeconds = FPlatformTime::Seconds() - ExecStart;
 
-	if (!bSuccess)
+	// Scripts can change anything, mostly through calls no editor delegate reports (set_actor_location, ...)
+	FEditorChangeTracker::Bump(EEditorChange::All);
+
+	if (TimeoutSeconds > 0)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("PythonHandler: Python execution returned false"));
+		FPythonCommandEx DisarmCommand;
+		DisarmCommand.Command = WatchdogDisarmScript;
+		DisarmCommand.Flags |= EPythonCommandFlags::Unattended;
+		PythonPlugin->ExecPythonCommandEx(DisarmCommand);
 	}
 
-	// Output is captured via log - return empty string as limitation of sync execution
-	// Future async implementation could capture output via custom log handler
-	return TEXT("");
+	Result.LogEntries.Reserve(Command.LogOutput.Num());
+	for (FPythonLogOutputEntry& Entry : Command.LogOutput)
+	{
+		Result.LogEntries.Add({ ToLogLevel(Entry.Type), MoveTemp(Entry.Output) });
+	}
+
+	if (!Result.bSuccess)
+	{
+		Result.Error = Command.CommandResult;
+		Result.bTimedOut = TimeoutSeconds > 0 && ExecSeconds >= TimeoutSeconds && Result.Error.Contains(TEXT("TimeoutError"));
+		if (Result.bTimedOut)
+		{
+			Result.Error = FString::Printf(TEXT("Execution timed out after %d seconds\n%s"), TimeoutSeconds, *Result.Error);
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("PythonHandler: Python execution failed%s"), Result.bTimedOut ? TEXT(" (timeout)") : TEXT(""));
+	}
+
+	return Result;
 }
 
 FRESTResponse FPythonHandler::HandleListJobs(const FRESTRequest& Request)
 {
+	int32 Offset = 0;
+	int32 Limit = 50;
+	if (const FString* OffsetPtr = Request.QueryParams.Find(TEXT("offset")))
+	{
+		Offset = FMath::Max(0, FCString::Atoi(**OffsetPtr));
+	}
+	if (const FString* LimitPtr = Request.QueryParams.Find(TEXT("limit")))
+	{
+		Limit = FMath::Clamp(FCString::Atoi(**LimitPtr), 1, MaxJobs);
+	}
+
 	TSharedPtr<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
 	ResponseJson->SetBoolField(TEXT("success"), true);
 
 	TArray<TSharedPtr<FJsonValue>> JobsArray;
+	int32 Total = 0;
 
 	{
 		FScopeLock Lock(&JobsLock);
 
-		for (const auto& Pair : Jobs)
+		Total = Jobs.ListNewestFirst(Offset, Limit, [&JobsArray](const FPythonJob& Job)
 		{
-			const FPythonJob& Job = Pair.Value;
-
 			TSharedPtr<FJsonObject> JobJson = MakeShared<FJsonObject>();
 			JobJson->SetStringField(TEXT("id"), Job.JobId);
-
-			// Convert status enum to string
-			FString StatusString;
-			switch (Job.Status)
-			{
-			case EPythonJobStatus::Pending:
-				StatusString = TEXT("pending");
-				break;
-			case EPythonJobStatus::Running:
-				StatusString = TEXT("running");
-				break;
-			case EPythonJobStatus::Completed:
-				StatusString = TEXT("completed");
-				break;
-			case EPythonJobStatus::Failed:
-				StatusString = TEXT("failed");
-				break;
-			case EPythonJobStatus::Cancelled:
-				StatusString = TEXT("cancelled");
-				break;
-			}
-			JobJson->SetStringField(TEXT("status"), StatusString);
+			JobJson->SetStringField(TEXT("status"), JobStatusToString(Job.Status));
 
 			// Format start time as ISO 8601
 			JobJson->SetStringField(TEXT("started_at"), Job.StartTime.ToIso8601());
 
 			JobsArray.Add(MakeShared<FJsonValueObject>(JobJson));
-		}
+		});
 	}
 
 	ResponseJson->SetArrayField(TEXT("jobs"), JobsArray);
+	ResponseJson->SetNumberField(TEXT("total"), Total);
+	ResponseJson->SetNumberField(TEXT("offset"), Offset);
+	ResponseJson->SetNumberField(TEXT("limit"), Limit);
+	if (Offset + JobsArray.Num() < Total)
+	{
+		ResponseJson->SetNumberField(TEXT("next_offset"), Offset + JobsArray.Num());
+	}
 
 	return FRESTResponse::Ok(ResponseJson);
 }
@@ -206,6 +1030,7 @@ FRESTResponse FPythonHandler::HandleGetJob(const FRESTRequest& Request, const FS
 	const FPythonJob* JobPtr = Jobs.Find(JobId);
 	if (!JobPtr)
 	{
+		// Also reached when the job has been evicted from the ring
 		return FRESTResponse::Error(404, TEXT("JOB_NOT_FOUND"),
 			FString::Printf(TEXT("Job with ID '%s' not found"), *JobId));
 	}
@@ -241,26 +1066,14 @@ FRESTResponse FPythonHandler::HandleGetJob(const FRESTRequest& Request, const FS
 	}
 	JobJson->SetStringField(TEXT("status"), StatusString);
 
-	JobJson->SetStringField(TEXT("output"), Job.Output);
-
-	if (!Job.Error.IsEmpty())
-	{
-		JobJson->SetStringField(TEXT("error"), Job.Error);
-	}
-
-	// Logs array
-	TArray<TSharedPtr<FJsonValue>> LogsArray;
-	for (const FString& LogEntry : Job.Logs)
-	{
-		LogsArray.Add(MakeShared<FJsonValueString>(LogEntry));
-	}
-	JobJson->SetArrayField(TEXT("logs"), LogsArray);
+	WriteJobOutput(Job, JobJson);
 
 	// Duration in milliseconds
 	double DurationMs = Job.GetDurationSeconds() * 1000.0;
 	JobJson->SetNumberField(TEXT("duration_ms"), DurationMs);
 
 	// Timestamps
+	JobJson->SetStringField(TEXT("submitted_at"), Job.SubmitTime.ToIso8601());
 	JobJson->SetStringField(TEXT("started_at"), Job.StartTime.ToIso8601());
 	if (Job.IsFinished())
 	{
@@ -309,9 +1122,19 @@ FRESTResponse FPythonHandler::HandleCancelJob(const FRESTRequest& Request, const
 			FString::Printf(TEXT("Job '%s' is already %s and cannot be cancelled"), *JobId, *StatusString));
 	}
 
-	// Cancel the job
+	// Running code can only be stopped by its own timeout
+	if (Job.Status == EPythonJobStatus::Running)
+	{
+		return FRESTResponse::Error(409, TEXT("JOB_RUNNING"),
+			FString::Printf(TEXT("Job '%s' is already running and will stop at its %d second timeout"), *JobId, Job.TimeoutSeconds));
+	}
+
+	// Cancel the job and take it out of the queue
+	PendingJobs.Remove(JobId);
+	Job.Code.Empty();
 	Job.Status = EPythonJobStatus::Cancelled;
 	Job.EndTime = FDateTime::UtcNow();
+	PostJobFinished(JobId, EPythonJobStatus::Cancelled);
 
 	// Build success response
 	TSharedPtr<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
@@ -322,73 +1145,48 @@ FRESTResponse FPythonHandler::HandleCancelJob(const FRESTRequest& Request, const
 	return FRESTResponse::Ok(ResponseJson);
 }
 
-FString FPythonHandler::GenerateJobId()
+void FPythonHandler::WriteJobOutput(const FPythonJob& Job, TSharedPtr<FJsonObject>& JobJson)
 {
-	return FGuid::NewGuid().ToString();
-}
+	JobJson->SetStringField(TEXT("output"), Job.GetOutput());
 
-void FPythonHandler::CleanupOldJobs()
-{
-	// Called with JobsLock already held
-
-	FDateTime Now = FDateTime::UtcNow();
-	FTimespan ExpirationTime = FTimespan::FromHours(JobExpirationHours);
-
-	// Collect keys to remove
-	TArray<FString> KeysToRemove;
-
-	for (const auto& Pair : Jobs)
+	if (!Job.Error.IsEmpty())
 	{
-		const FPythonJob& Job = Pair.Value;
-
-		// Only clean up finished jobs
-		if (Job.IsFinished())
-		{
-			FTimespan Age = Now - Job.EndTime;
-			if (Age > ExpirationTime)
-			{
-				KeysToRemove.Add(Pair.Key);
-			}
-		}
+		JobJson->SetStringField(TEXT("error"), Job.Error);
 	}
 
-	// Remove expired jobs
-	for (const FString& Key : KeysToRemove)
+	if (Job.bTimedOut)
 	{
-		Jobs.Remove(Key);
+		JobJson->SetBoolField(TEXT("timed_out"), true);
 	}
 
-	// If still over MaxJobs, remove oldest finished jobs
-	while (Jobs.Num() > MaxJobs)
+	// Logs array
+	TArray<TSharedPtr<FJsonValue>> LogsArray;
+	LogsArray.Reserve(Job.LogEntries.Num());
+	for (const FPythonJobLogEntry& Entry : Job.LogEntries)
 	{
-		// Find oldest finished job
-		FString OldestKey;
-		FDateTime OldestTime = FDateTime::MaxValue();
-
-		for (const auto& Pair : Jobs)
-		{
-			const FPythonJob& Job = Pair.Value;
-			if (Job.IsFinished() && Job.EndTime < OldestTime)
-			{
-				OldestTime = Job.EndTime;
-				OldestKey = Pair.Key;
-			}
-		}
-
-		if (OldestKey.IsEmpty())
-		{
-			// No more finished jobs to remove
-			break;
-		}
+		LogsArray.Add(MakeShared<FJsonValueString>(FString::Printf(TEXT("[%s] %s"), LogLevelToString(Entry.Level), *Entry.Text)));
+	}
+	JobJson->SetArrayField(TEXT("logs"), LogsArray);
 
-		Jobs.Remove(OldestKey);
+	if (!Job.OutputFile.IsEmpty())
+	{
+		JobJson->SetBoolField(TEXT("output_truncated"), true);
+		JobJson->SetStringField(TEXT("output_file"), Job.OutputFile);
 	}
 }
 
 void FPythonHandler::Shutdown()
 {
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+
 	FScopeLock Lock(&JobsLock);
+	PendingJobs.Empty();
 	Jobs.Empty();
+	Snippets.Empty();
 	UE_LOG(LogTemp, Log, TEXT("PythonHandler: Shutdown complete"));
 }
 
@@ -396,13 +1194,21 @@ TArray<TSharedPtr<FJsonObject>> FPythonHandler::GetEndpointSchemas() const
 {
 	TArray<TSharedPtr<FJsonObject>> Schemas;
 
-	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("POST")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/python/execute")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Execute Python code synchronously (body: code, timeout, async)"));
+	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("POST")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/python/execute")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Execute Python code synchronously and return its output (body: code, timeout, async - async queues like POST /python/jobs)"));
+
+	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("POST")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/python/jobs")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Queue Python code and return a job ID immediately (body: code, timeout)"));
 	
 	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("GET")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/python/jobs")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("List all Python execution jobs"));
 	
-	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("GET")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/python/job")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Get job status and result (query: id)"));
+	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("GET")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/python/jobs/{id}")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Get job status and result (also available as /python/job?id=)"));
 	
-	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("DELETE")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/python/job")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Cancel a Python job (query: id)"));
+	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("DELETE")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/python/jobs/{id}")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Cancel a Python job (also available as /python/job?id=)"));
+
+	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("POST")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/python/register")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Compile a named Python snippet once; recompiled only when its source hash changes (body: name, code)"));
+
+	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("POST")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/python/call")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("Run a registered snippet with JSON arguments and return its result (body: name, args, hash, timeout)"));
+
+	Schemas.Add(MakeShared<FJsonObject>()); Schemas.Last()->SetStringField(TEXT("method"), TEXT("GET")); Schemas.Last()->SetStringField(TEXT("path"), TEXT("/python/snippets")); Schemas.Last()->SetStringField(TEXT("description"), TEXT("List registered Python snippets"));
 
 	return Schemas;
 }
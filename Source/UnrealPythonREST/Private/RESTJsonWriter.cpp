@@ -0,0 +1,735 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RESTJsonWriter.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/StringBuilder.h"
+
+namespace
+{
+	/** Buffers kept for reuse */
+	constexpr int32 MaxPooledBuffers = 8;
+
+	/** Buffers that grew beyond this are freed instead of pooled */
+	constexpr int32 MaxPooledCapacity = 32 * 1024 * 1024;
+
+	/** Capacity reserved for a freshly allocated buffer */
+	constexpr int32 InitialCapacity = 16 * 1024;
+
+	FCriticalSection PoolLock;
+	TArray<FRESTOutputBuffer*> FreeBuffers;
+
+	/** Format for default-constructed writers; set by FScopedWireFormat */
+	thread_local ERESTWireFormat ThreadWireFormat = ERESTWireFormat::Json;
+
+	/**
+	 * MessagePack containers are opened with a 5-byte header (count unknown)
+	 * and shrunk to the 1-byte fix form on close when they hold fewer than 16
+	 * entries and moving their contents is cheap.
+	 */
+	constexpr int32 MaxCompactedContainerBytes = 256;
+
+	/** Code point at Index, combining a UTF-16 surrogate pair (Index then points at the low half); a lone surrogate becomes U+FFFD */
+	uint32 NextCodePoint(FStringView Text, int32& Index)
+	{
+		uint32 CodePoint = static_cast<uint32>(Text[Index]);
+		if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF)
+		{
+			const uint32 Low = Index + 1 < Text.Len() ? static_cast<uint32>(Text[Index + 1]) : 0;
+			if (Low >= 0xDC00 && Low <= 0xDFFF)
+			{
+				++Index;
+				return 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+			}
+			return 0xFFFD;
+		}
+		if (CodePoint >= 0xDC00 && CodePoint <= 0xDFFF)
+		{
+			return 0xFFFD;
+		}
+		return CodePoint;
+	}
+
+	int32 Utf8Length(uint32 CodePoint)
+	{
+		return CodePoint < 0x80 ? 1 : CodePoint < 0x800 ? 2 : CodePoint < 0x10000 ? 3 : 4;
+	}
+
+	void AppendUtf8(TArray<uint8>& Bytes, uint32 CodePoint)
+	{
+		if (CodePoint < 0x80)
+		{
+			Bytes.Add(static_cast<uint8>(CodePoint));
+		}
+		else if (CodePoint < 0x800)
+		{
+			Bytes.Add(static_cast<uint8>(0xC0 | (CodePoint >> 6)));
+			Bytes.Add(static_cast<uint8>(0x80 | (CodePoint & 0x3F)));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			Bytes.Add(static_cast<uint8>(0xE0 | (CodePoint >> 12)));
+			Bytes.Add(static_cast<uint8>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Bytes.Add(static_cast<uint8>(0x80 | (CodePoint & 0x3F)));
+		}
+		else
+		{
+			Bytes.Add(static_cast<uint8>(0xF0 | (CodePoint >> 18)));
+			Bytes.Add(static_cast<uint8>(0x80 | ((CodePoint >> 12) & 0x3F)));
+			Bytes.Add(static_cast<uint8>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Bytes.Add(static_cast<uint8>(0x80 | (CodePoint & 0x3F)));
+		}
+	}
+}
+
+// FRESTOutputBuffer
+
+TSharedRef<FRESTOutputBuffer> FRESTOutputBuffer::Acquire()
+{
+	FRESTOutputBuffer* Buffer = nullptr;
+	{
+		FScopeLock Lock(&PoolLock);
+		if (FreeBuffers.Num() > 0)
+		{
+			Buffer = FreeBuffers.Pop();
+		}
+	}
+
+	if (!Buffer)
+	{
+		Buffer = new FRESTOutputBuffer();
+		Buffer->Bytes.Reserve(InitialCapacity);
+	}
+
+	return MakeShareable(Buffer, &FRESTOutputBuffer::Release);
+}
+
+void FRESTOutputBuffer::Release(FRESTOutputBuffer* Buffer)
+{
+	if (Buffer->Bytes.Max() <= MaxPooledCapacity)
+	{
+		Buffer->Bytes.Reset();
+
+		FScopeLock Lock(&PoolLock);
+		if (FreeBuffers.Num() < MaxPooledBuffers)
+		{
+			FreeBuffers.Add(Buffer);
+			return;
+		}
+	}
+
+	delete Buffer;
+}
+
+// FRESTJsonWriter
+
+FRESTJsonWriter::FScopedWireFormat::FScopedWireFormat(ERESTWireFormat Format)
+	: Previous(ThreadWireFormat)
+{
+	ThreadWireFormat = Format;
+}
+
+FRESTJsonWriter::FScopedWireFormat::~FScopedWireFormat()
+{
+	ThreadWireFormat = Previous;
+}
+
+ERESTWireFormat FRESTJsonWriter::GetThreadFormat()
+{
+	return ThreadWireFormat;
+}
+
+FRESTJsonWriter::FRESTJsonWriter()
+	: Buffer(FRESTOutputBuffer::Acquire())
+	, Format(ThreadWireFormat)
+{
+}
+
+FRESTJsonWriter::FRESTJsonWriter(ERESTWireFormat InFormat)
+	: Buffer(FRESTOutputBuffer::Acquire())
+	, Format(InFormat)
+{
+}
+
+void FRESTJsonWriter::SetFormat(ERESTWireFormat InFormat)
+{
+	check(GetSize() == 0 && Scopes.Num() == 0 && !bRootWritten);
+	Format = InFormat;
+}
+
+void FRESTJsonWriter::BeginValue()
+{
+	if (Scopes.Num() == 0)
+	{
+		check(!bRootWritten);
+		bRootWritten = true;
+		return;
+	}
+
+	FScope& Scope = Scopes.Last();
+	if (Scope.Count > 0 && !IsBinary())
+	{
+		AppendByte(',');
+	}
+	++Scope.Count;
+}
+
+void FRESTJsonWriter::EndRecord()
+{
+	check(IsComplete());
+	if (!IsBinary())
+	{
+		AppendByte('\n');
+	}
+	bRootWritten = false;
+}
+
+void FRESTJsonWriter::BeginMember(FStringView Identifier)
+{
+	BeginValue();
+	if (IsBinary())
+	{
+		PackString(Identifier);
+		return;
+	}
+	AppendQuoted(Identifier);
+	AppendByte(':');
+}
+
+void FRESTJsonWriter::BeginContainer(bool bObject)
+{
+	FScope& Scope = Scopes.AddDefaulted_GetRef();
+	if (!IsBinary())
+	{
+		AppendByte(bObject ? '{' : '[');
+		return;
+	}
+
+	// map32 / array32 with the count patched in EndContainer
+	Scope.HeaderOffset = GetSize();
+	AppendByte(bObject ? 0xdf : 0xdd);
+	PackBigEndian(0, 4);
+}
+
+void FRESTJsonWriter::EndContainer(bool bObject)
+{
+	check(Scopes.Num() > 0);
+	const FScope Scope = Scopes.Pop();
+	if (!IsBinary())
+	{
+		AppendByte(bObject ? '}' : ']');
+		return;
+	}
+
+	TArray<uint8>& Bytes = Buffer->Bytes;
+	const int32 ContentOffset = Scope.HeaderOffset + 5;
+	if (Scope.Count < 16 && Bytes.Num() - ContentOffset <= MaxCompactedContainerBytes)
+	{
+		Bytes[Scope.HeaderOffset] = static_cast<uint8>((bObject ? 0x80 : 0x90) | Scope.Count);
+		Bytes.RemoveAt(Scope.HeaderOffset + 1, 4);
+		return;
+	}
+
+	for (int32 Byte = 0; Byte < 4; ++Byte)
+	{
+		Bytes[Scope.HeaderOffset + 1 + Byte] = static_cast<uint8>(Scope.Count >> (24 - Byte * 8));
+	}
+}
+
+void FRESTJsonWriter::WriteObjectStart()
+{
+	BeginValue();
+	BeginContainer(true);
+}
+
+void FRESTJsonWriter::WriteObjectStart(FStringView Identifier)
+{
+	BeginMember(Identifier);
+	BeginContainer(true);
+}
+
+void FRESTJsonWriter::WriteObjectEnd()
+{
+	EndContainer(true);
+}
+
+void FRESTJsonWriter::WriteArrayStart()
+{
+	BeginValue();
+	BeginContainer(false);
+}
+
+void FRESTJsonWriter::WriteArrayStart(FStringView Identifier)
+{
+	BeginMember(Identifier);
+	BeginContainer(false);
+}
+
+void FRESTJsonWriter::WriteArrayEnd()
+{
+	EndContainer(false);
+}
+
+void FRESTJsonWriter::WriteValue(FStringView Identifier, FStringView Value)
+{
+	BeginMember(Identifier);
+	AppendString(Value);
+}
+
+void FRESTJsonWriter::WriteValue(FStringView Identifier, FName Value)
+{
+	BeginMember(Identifier);
+	AppendName(Value);
+}
+
+void FRESTJsonWriter::WriteValue(FStringView Identifier, bool Value)
+{
+	BeginMember(Identifier);
+	AppendBool(Value);
+}
+
+void FRESTJsonWriter::WriteValue(FStringView Identifier, int64 Value)
+{
+	BeginMember(Identifier);
+	AppendNumber(Value);
+}
+
+void FRESTJsonWriter::WriteValue(FStringView Identifier, double Value)
+{
+	BeginMember(Identifier);
+	AppendNumber(Value);
+}
+
+void FRESTJsonWriter::WriteNull(FStringView Identifier)
+{
+	BeginMember(Identifier);
+	AppendNull();
+}
+
+void FRESTJsonWriter::WriteValue(FStringView Value)
+{
+	BeginValue();
+	AppendString(Value);
+}
+
+void FRESTJsonWriter::WriteValue(FName Value)
+{
+	BeginValue();
+	AppendName(Value);
+}
+
+void FRESTJsonWriter::WriteValue(bool Value)
+{
+	BeginValue();
+	AppendBool(Value);
+}
+
+void FRESTJsonWriter::WriteValue(int64 Value)
+{
+	BeginValue();
+	AppendNumber(Value);
+}
+
+void FRESTJsonWriter::WriteValue(double Value)
+{
+	BeginValue();
+	AppendNumber(Value);
+}
+
+void FRESTJsonWriter::WriteNull()
+{
+	BeginValue();
+	AppendNull();
+}
+
+void FRESTJsonWriter::WriteFloatArray(FStringView Identifier, TConstArrayView<double> Values)
+{
+	WriteArrayStart(Identifier);
+	for (double Value : Values)
+	{
+		BeginValue();
+		IsBinary() ? PackFloat(static_cast<float>(Value)) : AppendNumber(Value);
+	}
+	WriteArrayEnd();
+}
+
+void FRESTJsonWriter::WriteFloatArray(TConstArrayView<double> Values)
+{
+	WriteArrayStart();
+	for (double Value : Values)
+	{
+		BeginValue();
+		IsBinary() ? PackFloat(static_cast<float>(Value)) : AppendNumber(Value);
+	}
+	WriteArrayEnd();
+}
+
+void FRESTJsonWriter::WriteJsonValue(FStringView Identifier, const TSharedPtr<FJsonValue>& Value)
+{
+	if (!Value.IsValid())
+	{
+		WriteNull(Identifier);
+		return;
+	}
+
+	switch (Value->Type)
+	{
+	case EJson::String:
+		WriteValue(Identifier, Value->AsString());
+		break;
+	case EJson::Number:
+		WriteValue(Identifier, Value->AsNumber());
+		break;
+	case EJson::Boolean:
+		WriteValue(Identifier, Value->AsBool());
+		break;
+	case EJson::Array:
+		WriteArrayStart(Identifier);
+		for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+		{
+			WriteJsonValue(Element);
+		}
+		WriteArrayEnd();
+		break;
+	case EJson::Object:
+		WriteJsonObject(Identifier, Value->AsObject());
+		break;
+	default:
+		WriteNull(Identifier);
+		break;
+	}
+}
+
+void FRESTJsonWriter::WriteJsonValue(const TSharedPtr<FJsonValue>& Value)
+{
+	if (!Value.IsValid())
+	{
+		WriteNull();
+		return;
+	}
+
+	switch (Value->Type)
+	{
+	case EJson::String:
+		WriteValue(Value->AsString());
+		break;
+	case EJson::Number:
+		WriteValue(Value->AsNumber());
+		break;
+	case EJson::Boolean:
+		WriteValue(Value->AsBool());
+		break;
+	case EJson::Array:
+		WriteArrayStart();
+		for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+		{
+			WriteJsonValue(Element);
+		}
+		WriteArrayEnd();
+		break;
+	case EJson::Object:
+		WriteJsonObject(Value->AsObject());
+		break;
+	default:
+		WriteNull();
+		break;
+	}
+}
+
+void FRESTJsonWriter::WriteJsonObject(FStringView Identifier, const TSharedPtr<FJsonObject>& Object)
+{
+	if (!Object.IsValid())
+	{
+		WriteNull(Identifier);
+		return;
+	}
+
+	WriteObjectStart(Identifier);
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object->Values)
+	{
+		WriteJsonValue(Field.Key, Field.Value);
+	}
+	WriteObjectEnd();
+}
+
+void FRESTJsonWriter::WriteJsonObject(const TSharedPtr<FJsonObject>& Object)
+{
+	if (!Object.IsValid())
+	{
+		WriteNull();
+		return;
+	}
+
+	WriteObjectStart();
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object->Values)
+	{
+		WriteJsonValue(Field.Key, Field.Value);
+	}
+	WriteObjectEnd();
+}
+
+void FRESTJsonWriter::AppendRaw(const ANSICHAR* Text, int32 Length)
+{
+	Buffer->Bytes.Append(reinterpret_cast<const uint8*>(Text), Length);
+}
+
+void FRESTJsonWriter::AppendQuoted(FStringView Text)
+{
+	static const ANSICHAR HexDigits[] = "0123456789abcdef";
+
+	TArray<uint8>& Bytes = Buffer->Bytes;
+	Bytes.Add('"');
+
+	const int32 Len = Text.Len();
+	for (int32 Index = 0; Index < Len; ++Index)
+	{
+		const uint32 CodePoint = NextCodePoint(Text, Index);
+
+		if (CodePoint < 0x80)
+		{
+			switch (CodePoint)
+			{
+			case '"':  Bytes.Add('\\'); Bytes.Add('"'); break;
+			case '\\': Bytes.Add('\\'); Bytes.Add('\\'); break;
+			case '\n': Bytes.Add('\\'); Bytes.Add('n'); break;
+			case '\r': Bytes.Add('\\'); Bytes.Add('r'); break;
+			case '\t': Bytes.Add('\\'); Bytes.Add('t'); break;
+			case '\b': Bytes.Add('\\'); Bytes.Add('b'); break;
+			case '\f': Bytes.Add('\\'); Bytes.Add('f'); break;
+			default:
+				if (CodePoint < 0x20)
+				{
+					const uint8 Escape[6] = { '\\', 'u', '0', '0', static_cast<uint8>(HexDigits[CodePoint >> 4]), static_cast<uint8>(HexDigits[CodePoint & 0xF]) };
+					Bytes.Append(Escape, 6);
+				}
+				else
+				{
+					Bytes.Add(static_cast<uint8>(CodePoint));
+				}
+				break;
+			}
+			continue;
+		}
+
+		AppendUtf8(Bytes, CodePoint);
+	}
+
+	Bytes.Add('"');
+}
+
+void FRESTJsonWriter::AppendString(FStringView Text)
+{
+	IsBinary() ? PackString(Text) : AppendQuoted(Text);
+}
+
+void FRESTJsonWriter::AppendBool(bool Value)
+{
+	if (IsBinary())
+	{
+		AppendByte(Value ? 0xc3 : 0xc2);
+		return;
+	}
+	Value ? AppendRaw("true", 4) : AppendRaw("false", 5);
+}
+
+void FRESTJsonWriter::AppendNull()
+{
+	IsBinary() ? AppendByte(0xc0) : AppendRaw("null", 4);
+}
+
+void FRESTJsonWriter::AppendNumber(int64 Value)
+{
+	if (IsBinary())
+	{
+		PackInteger(Value);
+		return;
+	}
+
+	ANSICHAR Digits[24];
+	int32 Pos = UE_ARRAY_COUNT(Digits);
+
+	// Work in unsigned space so INT64_MIN does not overflow
+	uint64 Magnitude = Value < 0 ? static_cast<uint64>(-(Value + 1)) + 1 : static_cast<uint64>(Value);
+	do
+	{
+		Digits[--Pos] = static_cast<ANSICHAR>('0' + (Magnitude % 10));
+		Magnitude /= 10;
+	}
+	while (Magnitude != 0);
+
+	if (Value < 0)
+	{
+		Digits[--Pos] = '-';
+	}
+
+	AppendRaw(Digits + Pos, UE_ARRAY_COUNT(Digits) - Pos);
+}
+
+void FRESTJsonWriter::AppendNumber(double Value)
+{
+	if (!FMath::IsFinite(Value))
+	{
+		// Neither JSON nor the JSON view of a MessagePack body can hold NaN or infinity
+		AppendNull();
+		return;
+	}
+
+	// Whole numbers in the exactly representable range go through the integer path
+	if (FMath::Abs(Value) < 9007199254740992.0 && Value == FMath::FloorToDouble(Value))
+	{
+		AppendNumber(static_cast<int64>(Value));
+		return;
+	}
+
+	if (IsBinary())
+	{
+		PackDouble(Value);
+		return;
+	}
+
+	// Same precision as TJsonWriter so streamed output matches DOM-serialized output
+	ANSICHAR Text[40];
+	const int32 Length = FCStringAnsi::Snprintf(Text, UE_ARRAY_COUNT(Text), "%.17g", Value);
+	AppendRaw(Text, FMath::Clamp(Length, 0, static_cast<int32>(UE_ARRAY_COUNT(Text)) - 1));
+}
+
+void FRESTJsonWriter::AppendName(FName Value)
+{
+	TStringBuilder<FName::StringBufferSize> NameString;
+	Value.AppendString(NameString);
+	AppendString(NameString.ToView());
+}
+
+// MessagePack encoding
+
+void FRESTJsonWriter::PackBigEndian(uint64 Value, int32 NumBytes)
+{
+	for (int32 Shift = (NumBytes - 1) * 8; Shift >= 0; Shift -= 8)
+	{
+		AppendByte(static_cast<uint8>(Value >> Shift));
+	}
+}
+
+void FRESTJsonWriter::PackString(FStringView Text)
+{
+	// Length pre-pass so the header is written once in its smallest form
+	uint32 Utf8Bytes = 0;
+	for (int32 Index = 0; Index < Text.Len(); ++Index)
+	{
+		Utf8Bytes += Utf8Length(NextCodePoint(Text, Index));
+	}
+
+	if (Utf8Bytes < 32)
+	{
+		AppendByte(static_cast<uint8>(0xa0 | Utf8Bytes));
+	}
+	else if (Utf8Bytes <= MAX_uint8)
+	{
+		AppendByte(0xd9);
+		PackBigEndian(Utf8Bytes, 1);
+	}
+	else if (Utf8Bytes <= MAX_uint16)
+	{
+		AppendByte(0xda);
+		PackBigEndian(Utf8Bytes, 2);
+	}
+	else
+	{
+		AppendByte(0xdb);
+		PackBigEndian(Utf8Bytes, 4);
+	}
+
+	TArray<uint8>& Bytes = Buffer->Bytes;
+	Bytes.Reserve(Bytes.Num() + Utf8Bytes);
+	for (int32 Index = 0; Index < Text.Len(); ++Index)
+	{
+		AppendUtf8(Bytes, NextCodePoint(Text, Index));
+	}
+}
+
+void FRESTJsonWriter::PackInteger(int64 Value)
+{
+	if (Value >= 0)
+	{
+		if (Value < 128)
+		{
+			AppendByte(static_cast<uint8>(Value));
+		}
+		else if (Value <= MAX_uint8)
+		{
+			AppendByte(0xcc);
+			PackBigEndian(Value, 1);
+		}
+		else if (Value <= MAX_uint16)
+		{
+			AppendByte(0xcd);
+			PackBigEndian(Value, 2);
+		}
+		else if (Value <= MAX_uint32)
+		{
+			AppendByte(0xce);
+			PackBigEndian(Value, 4);
+		}
+		else
+		{
+			AppendByte(0xcf);
+			PackBigEndian(Value, 8);
+		}
+		return;
+	}
+
+	if (Value >= -32)
+	{
+		// Negative fixint: the low byte of the two's complement value
+		AppendByte(static_cast<uint8>(Value));
+	}
+	else if (Value >= MIN_int8)
+	{
+		AppendByte(0xd0);
+		PackBigEndian(static_cast<uint64>(Value), 1);
+	}
+	else if (Value >= MIN_int16)
+	{
+		AppendByte(0xd1);
+		PackBigEndian(static_cast<uint64>(Value), 2);
+	}
+	else if (Value >= MIN_int32)
+	{
+		AppendByte(0xd2);
+		PackBigEndian(static_cast<uint64>(Value), 4);
+	}
+	else
+	{
+		AppendByte(0xd3);
+		PackBigEndian(static_cast<uint64>(Value), 8);
+	}
+}
+
+void FRESTJsonWriter::PackDouble(double Value)
+{
+	// float32 when that loses nothing (0.5, 0.25 ...), float64 otherwise
+	if (static_cast<double>(static_cast<float>(Value)) == Value)
+	{
+		PackFloat(static_cast<float>(Value));
+		return;
+	}
+
+	uint64 Bits;
+	FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+	AppendByte(0xcb);
+	PackBigEndian(Bits, 8);
+}
+
+void FRESTJsonWriter::PackFloat(float Value)
+{
+	if (!FMath::IsFinite(Value))
+	{
+		AppendNull();
+		return;
+	}
+
+	uint32 Bits;
+	FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+	AppendByte(0xca);
+	PackBigEndian(Bits, 4);
+}
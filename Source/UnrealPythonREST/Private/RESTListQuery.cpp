@@ -0,0 +1,241 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RESTListQuery.h"
+#include "RESTJsonWriter.h"
+#include "Dom/JsonObject.h"
+#include "Misc/Parse.h"
+
+namespace
+{
+	/** Query parameter, or for POST requests the JSON body field of the same name */
+	bool FindOption(const FRESTRequest& Request, const TCHAR* Name, FString& OutValue)
+	{
+		if (const FString* Value = Request.QueryParams.Find(Name))
+		{
+			OutValue = *Value;
+			return true;
+		}
+
+		if (Request.Method != ERESTMethod::GET && Request.JsonBody.IsValid())
+		{
+			const TSharedPtr<FJsonValue> Field = Request.JsonBody->TryGetField(Name);
+			if (Field.IsValid() && !Field->IsNull())
+			{
+				// Numbers come back as their string form; arrays of names are joined for "fields"
+				const TArray<TSharedPtr<FJsonValue>>* Array = nullptr;
+				if (Field->TryGetArray(Array))
+				{
+					TArray<FString> Parts;
+					for (const TSharedPtr<FJsonValue>& Item : *Array)
+					{
+						Parts.Add(Item->AsString());
+					}
+					OutValue = FString::Join(Parts, TEXT(","));
+				}
+				else
+				{
+					OutValue = Field->AsString();
+				}
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/** Cursor tokens are "c" + hex offset; opaque to clients */
+	constexpr TCHAR CursorPrefix = TEXT('c');
+}
+
+// FRESTFieldFilter
+
+FRESTFieldFilter::FRESTFieldFilter(FStringView FieldList)
+{
+	while (!FieldList.IsEmpty())
+	{
+		int32 Comma = INDEX_NONE;
+		FieldList.FindChar(TEXT(','), Comma);
+
+		FStringView Field = Comma == INDEX_NONE ? FieldList : FieldList.Left(Comma);
+		FieldList = Comma == INDEX_NONE ? FStringView() : FieldList.RightChop(Comma + 1);
+
+		Field = Field.TrimStartAndEnd();
+		if (!Field.IsEmpty())
+		{
+			Fields.Emplace(Field);
+		}
+	}
+}
+
+bool FRESTFieldFilter::Wants(FStringView Field) const
+{
+	if (Fields.Num() == 0)
+	{
+		return true;
+	}
+
+	for (const FString& Wanted : Fields)
+	{
+		if (Field.Equals(Wanted, ESearchCase::IgnoreCase))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// FRESTListQuery
+
+bool FRESTListQuery::Parse(const FRESTRequest& Request, int32 DefaultLimit, int32 MaxLimit, FRESTListQuery& OutQuery, FString& OutError)
+{
+	OutQuery = FRESTListQuery();
+	OutQuery.Limit = FMath::Clamp(DefaultLimit, 1, MaxLimit);
+
+	FString Value;
+	if (FindOption(Request, TEXT("fields"), Value))
+	{
+		OutQuery.Fields = FRESTFieldFilter(Value);
+	}
+
+	if (FindOption(Request, TEXT("limit"), Value) && !Value.IsEmpty())
+	{
+		if (!Value.IsNumeric())
+		{
+			OutError = FString::Printf(TEXT("Invalid limit: %s"), *Value);
+			return false;
+		}
+		OutQuery.Limit = FMath::Clamp(FCString::Atoi(*Value), 1, MaxLimit);
+	}
+
+	if (FindOption(Request, TEXT("cursor"), Value) && !Value.IsEmpty())
+	{
+		const int32 Offset = Value.Len() > 1 && Value[0] == CursorPrefix ? static_cast<int32>(FParse::HexNumber(*Value + 1)) : -1;
+		if (Offset < 0 || MakeCursor(Offset) != Value)
+		{
+			OutError = FString::Printf(TEXT("Invalid cursor: %s. Pass next_cursor from the previous page unchanged."), *Value);
+			return false;
+		}
+		OutQuery.Offset = Offset;
+	}
+
+	if (FindOption(Request, TEXT("format"), Value) && !Value.IsEmpty())
+	{
+		if (Value.Equals(TEXT("ndjson"), ESearchCase::IgnoreCase))
+		{
+			OutQuery.bNdjson = true;
+		}
+		else if (!Value.Equals(TEXT("json"), ESearchCase::IgnoreCase))
+		{
+			OutError = FString::Printf(TEXT("Unknown format: %s. Use json or ndjson."), *Value);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FRESTListQuery::BeginList(FRESTJsonWriter& Writer, FStringView ArrayName, TFunctionRef<void(FRESTJsonWriter&)> WriteHeader) const
+{
+	if (bNdjson)
+	{
+		// NDJSON is a text format even for clients that negotiated MessagePack
+		if (Writer.IsBinary())
+		{
+			Writer.SetFormat(ERESTWireFormat::Json);
+		}
+		return;
+	}
+
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("success"), true);
+	WriteHeader(Writer);
+	Writer.WriteArrayStart(ArrayName);
+}
+
+void FRESTListQuery::BeginList(FRESTJsonWriter& Writer, FStringView ArrayName) const
+{
+	BeginList(Writer, ArrayName, [](FRESTJsonWriter&) {});
+}
+
+void FRESTListQuery::BeginItem(FRESTJsonWriter& Writer) const
+{
+	Writer.WriteObjectStart();
+}
+
+void FRESTListQuery::EndItem(FRESTJsonWriter& Writer) const
+{
+	Writer.WriteObjectEnd();
+	if (bNdjson)
+	{
+		Writer.EndRecord();
+	}
+}
+
+void FRESTListQuery::WriteItem(FRESTJsonWriter& Writer, const TSharedPtr<FJsonObject>& Item) const
+{
+	Writer.WriteJsonObject(Item);
+	if (bNdjson)
+	{
+		Writer.EndRecord();
+	}
+}
+
+FRESTResponse FRESTListQuery::Finish(FRESTJsonWriter& Writer, bool bHasMore, TFunctionRef<void(FRESTJsonWriter&)> WriteTrailer) const
+{
+	// One page holds at most Limit items, so the next page starts right after it
+	const FString NextCursor = bHasMore ? MakeCursor(Offset + Limit) : FString();
+
+	if (bNdjson)
+	{
+		// Built directly rather than through Stream(): the body is a sequence of root values
+		FRESTResponse Response;
+		Response.StreamBody = Writer.GetBuffer();
+		Response.StreamFormat = Writer.GetFormat();
+		Response.ContentType = TEXT("application/x-ndjson");
+		if (bHasMore)
+		{
+			Response.Headers.Add(TEXT("X-Next-Cursor"), NextCursor);
+		}
+		return Response;
+	}
+
+	Writer.WriteArrayEnd();
+	WriteTrailer(Writer);
+	if (bHasMore)
+	{
+		Writer.WriteValue(TEXT("next_cursor"), NextCursor);
+	}
+	else
+	{
+		Writer.WriteNull(TEXT("next_cursor"));
+	}
+	Writer.WriteObjectEnd();
+
+	return FRESTResponse::Stream(Writer);
+}
+
+FRESTResponse FRESTListQuery::Finish(FRESTJsonWriter& Writer, bool bHasMore) const
+{
+	return Finish(Writer, bHasMore, [](FRESTJsonWriter&) {});
+}
+
+FString FRESTListQuery::MakeCursor(int32 InOffset)
+{
+	return FString::Printf(TEXT("%c%x"), CursorPrefix, InOffset);
+}
+
+void FRESTListQuery::DescribeParameters(const TSharedPtr<FJsonObject>& Params)
+{
+	auto AddParam = [&Params](const TCHAR* Name, const TCHAR* Description)
+	{
+		TSharedPtr<FJsonObject> Param = MakeShared<FJsonObject>();
+		Param->SetStringField(TEXT("type"), TEXT("string"));
+		Param->SetBoolField(TEXT("required"), false);
+		Param->SetStringField(TEXT("description"), Description);
+		Params->SetObjectField(Name, Param);
+	};
+
+	AddParam(TEXT("fields"), TEXT("Comma-separated item fields to return (default: all)"));
+	AddParam(TEXT("cursor"), TEXT("next_cursor from the previous page"));
+	AddParam(TEXT("format"), TEXT("json (default) or ndjson - one item per line, cursor in X-Next-Cursor header"));
+}
@@ -0,0 +1,373 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RESTMetrics.h"
+#include "RESTJsonWriter.h"
+#include "Misc/ScopeRWLock.h"
+#include "HAL/PlatformMemory.h"
+
+namespace
+{
+	const TCHAR* const PhaseNames[] = { TEXT("total"), TEXT("parse"), TEXT("queue"), TEXT("dispatch"), TEXT("serialize") };
+	static_assert(UE_ARRAY_COUNT(PhaseNames) == static_cast<int32>(ERESTPhase::Num), "One name per phase");
+
+	const TCHAR* const StatusClassNames[] = { TEXT("2xx"), TEXT("3xx"), TEXT("4xx"), TEXT("5xx") };
+
+	const double Quantiles[] = { 0.5, 0.9, 0.99 };
+
+	int32 StatusClass(int32 StatusCode)
+	{
+		return StatusCode >= 500 ? 3 : StatusCode >= 400 ? 2 : StatusCode >= 300 ? 1 : 0;
+	}
+
+	/** Prometheus label value: backslash, quote and newline are escaped */
+	FString EscapeLabel(const FString& Value)
+	{
+		return Value.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\"")).Replace(TEXT("\n"), TEXT("\\n"));
+	}
+
+	void AppendSample(FString& Out, const TCHAR* Name, const FString& Labels, double Value)
+	{
+		Out += FString::Printf(TEXT("%s{%s} %.9g\n"), Name, *Labels, Value);
+	}
+
+	void AppendHeader(FString& Out, const TCHAR* Name, const TCHAR* Type, const TCHAR* Help)
+	{
+		Out += FString::Printf(TEXT("# HELP %s %s\n# TYPE %s %s\n"), Name, Help, Name, Type);
+	}
+}
+
+FRESTLatencyHistogram::FRESTLatencyHistogram()
+{
+	Reset();
+}
+
+int32 FRESTLatencyHistogram::BucketIndex(uint64 Micros)
+{
+	if (Micros < SubBuckets)
+	{
+		return static_cast<int32>(Micros);
+	}
+
+	Micros = FMath::Min<uint64>(Micros, MAX_uint32);
+	const int32 Exponent = static_cast<int32>(FMath::FloorLog2_64(Micros));
+	const int32 SubBucket = static_cast<int32>(Micros >> (Exponent - SubBucketBits)) & (SubBuckets - 1);
+	return (Exponent - SubBucketBits + 1) * SubBuckets + SubBucket;
+}
+
+uint64 FRESTLatencyHistogram::BucketValue(int32 Index)
+{
+	if (Index < SubBuckets)
+	{
+		return static_cast<uint64>(Index);
+	}
+
+	const int32 Exponent = Index / SubBuckets + SubBucketBits - 1;
+	const uint64 Width = 1ull << (Exponent - SubBucketBits);
+	const uint64 Low = static_cast<uint64>(SubBuckets + Index % SubBuckets) * Width;
+	return Low + Width / 2;
+}
+
+void FRESTLatencyHistogram::Reset()
+{
+	for (std::atomic<uint64>& Bucket : Buckets)
+	{
+		Bucket.store(0, std::memory_order_relaxed);
+	}
+	Count.store(0, std::memory_order_relaxed);
+	SumMicros.store(0, std::memory_order_relaxed);
+	MaxMicros.store(0, std::memory_order_relaxed);
+}
+
+void FRESTLatencyHistogram::Record(double Seconds)
+{
+	const uint64 Micros = static_cast<uint64>(FMath::Max(Seconds, 0.0) * 1e6);
+
+	Buckets[BucketIndex(Micros)].fetch_add(1, std::memory_order_relaxed);
+	Count.fetch_add(1, std::memory_order_relaxed);
+	SumMicros.fetch_add(Micros, std::memory_order_relaxed);
+
+	uint64 Max = MaxMicros.load(std::memory_order_relaxed);
+	while (Micros > Max && !MaxMicros.compare_exchange_weak(Max, Micros, std::memory_order_relaxed))
+	{
+	}
+}
+
+double FRESTLatencyHistogram::GetQuantile(double Q) const
+{
+	const uint64 Total = GetCount();
+	if (Total == 0)
+	{
+		return 0.0;
+	}
+
+	const uint64 Rank = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(FMath::Clamp(Q, 0.0, 1.0) * static_cast<double>(Total))));
+	uint64 Seen = 0;
+	for (int32 Index = 0; Index < NumBuckets; ++Index)
+	{
+		Seen += Buckets[Index].load(std::memory_order_relaxed);
+		if (Seen >= Rank)
+		{
+			// A bucket's middle can lie above the largest value actually seen
+			return static_cast<double>(FMath::Min(BucketValue(Index), MaxMicros.load(std::memory_order_relaxed))) / 1e6;
+		}
+	}
+	return GetMaxSeconds();
+}
+
+uint64 FRESTMetrics::FRouteMetrics::GetRequests() const
+{
+	uint64 Sum = 0;
+	for (const std::atomic<uint64>& Counter : Status)
+	{
+		Sum += Counter.load(std::memory_order_relaxed);
+	}
+	return Sum;
+}
+
+void FRESTMetrics::Record(ERESTMethod Method, const FString& Route, int32 StatusCode, int64 RequestBytes, int64 ResponseBytes, const FRESTRequestTiming& Timing)
+{
+	const FString Key = FString::Printf(TEXT("%s %s"), LexToString(Method), *Route);
+
+	auto Apply = [&](FRouteMetrics& Entry)
+	{
+		Entry.Status[StatusClass(StatusCode)].fetch_add(1, std::memory_order_relaxed);
+		Entry.RequestBytes.fetch_add(static_cast<uint64>(FMath::Max<int64>(RequestBytes, 0)), std::memory_order_relaxed);
+		Entry.ResponseBytes.fetch_add(static_cast<uint64>(FMath::Max<int64>(ResponseBytes, 0)), std::memory_order_relaxed);
+		for (int32 Phase = 0; Phase < static_cast<int32>(ERESTPhase::Num); ++Phase)
+		{
+			if (Timing.Seconds[Phase] >= 0.0)
+			{
+				Entry.Latency[Phase].Record(Timing.Seconds[Phase]);
+			}
+		}
+	};
+
+	// The lock is held while recording so Reset() cannot free the entry underneath
+	{
+		FReadScopeLock ReadLock(Lock);
+		if (const TUniquePtr<FRouteMetrics>* Found = Routes.Find(Key))
+		{
+			Apply(**Found);
+			return;
+		}
+	}
+
+	// First request to this route
+	FWriteScopeLock WriteLock(Lock);
+	TUniquePtr<FRouteMetrics>& Entry = Routes.FindOrAdd(Key);
+	if (!Entry.IsValid())
+	{
+		Entry = MakeUnique<FRouteMetrics>();
+		Entry->Method = Method;
+		Entry->Route = Route;
+	}
+	Apply(*Entry);
+}
+
+TArray<const FRESTMetrics::FRouteMetrics*> FRESTMetrics::GetSortedRoutes() const
+{
+	TArray<const FRouteMetrics*> Sorted;
+	Sorted.Reserve(Routes.Num());
+	for (const TPair<FString, TUniquePtr<FRouteMetrics>>& Pair : Routes)
+	{
+		Sorted.Add(Pair.Value.Get());
+	}
+	Sorted.Sort([](const FRouteMetrics& A, const FRouteMetrics& B)
+	{
+		const int32 Compare = A.Route.Compare(B.Route);
+		return Compare != 0 ? Compare < 0 : A.Method < B.Method;
+	});
+	return Sorted;
+}
+
+FString FRESTMetrics::ToPrometheus(int32 QueuedRequests) const
+{
+	FReadScopeLock ReadLock(Lock);
+	const TArray<const FRouteMetrics*> Sorted = GetSortedRoutes();
+
+	TArray<FString> RouteLabels;
+	RouteLabels.Reserve(Sorted.Num());
+	for (const FRouteMetrics* Entry : Sorted)
+	{
+		RouteLabels.Add(FString::Printf(TEXT("method=\"%s\",route=\"%s\""), LexToString(Entry->Method), *EscapeLabel(Entry->Route)));
+	}
+
+	FString Out;
+	Out.Reserve(256 + Sorted.Num() * 2048);
+
+	AppendHeader(Out, TEXT("unrealpythonrest_requests_total"), TEXT("counter"), TEXT("Requests answered, by route and status class"));
+	for (int32 Index = 0; Index < Sorted.Num(); ++Index)
+	{
+		for (int32 Class = 0; Class < NumStatusClasses; ++Class)
+		{
+			const uint64 Value = Sorted[Index]->Status[Class].load(std::memory_order_relaxed);
+			if (Value > 0)
+			{
+				AppendSample(Out, TEXT("unrealpythonrest_requests_total"), FString::Printf(TEXT("%s,status=\"%s\""), *RouteLabels[Index], StatusClassNames[Class]), static_cast<double>(Value));
+			}
+		}
+	}
+
+	AppendHeader(Out, TEXT("unrealpythonrest_request_bytes_total"), TEXT("counter"), TEXT("Request body bytes received"));
+	for (int32 Index = 0; Index < Sorted.Num(); ++Index)
+	{
+		AppendSample(Out, TEXT("unrealpythonrest_request_bytes_total"), RouteLabels[Index], static_cast<double>(Sorted[Index]->RequestBytes.load(std::memory_order_relaxed)));
+	}
+
+	AppendHeader(Out, TEXT("unrealpythonrest_response_bytes_total"), TEXT("counter"), TEXT("Response body bytes sent, after compression"));
+	for (int32 Index = 0; Index < Sorted.Num(); ++Index)
+	{
+		AppendSample(Out, TEXT("unrealpythonrest_response_bytes_total"), RouteLabels[Index], static_cast<double>(Sorted[Index]->ResponseBytes.load(std::memory_order_relaxed)));
+	}
+
+	AppendHeader(Out, TEXT("unrealpythonrest_request_duration_seconds"), TEXT("summary"), TEXT("Request latency by phase (total, parse, queue, dispatch, serialize)"));
+	for (int32 Index = 0; Index < Sorted.Num(); ++Index)
+	{
+		for (int32 Phase = 0; Phase < static_cast<int32>(ERESTPhase::Num); ++Phase)
+		{
+			const FRESTLatencyHistogram& Histogram = Sorted[Index]->Latency[Phase];
+			if (Histogram.GetCount() == 0)
+			{
+				continue;
+			}
+
+			const FString Labels = FString::Printf(TEXT("%s,phase=\"%s\""), *RouteLabels[Index], PhaseNames[Phase]);
+			for (const double Q : Quantiles)
+			{
+				AppendSample(Out, TEXT("unrealpythonrest_request_duration_seconds"), FString::Printf(TEXT("%s,quantile=\"%g\""), *Labels, Q), Histogram.GetQuantile(Q));
+			}
+			AppendSample(Out, TEXT("unrealpythonrest_request_duration_seconds_sum"), Labels, Histogram.GetSumSeconds());
+			AppendSample(Out, TEXT("unrealpythonrest_request_duration_seconds_count"), Labels, static_cast<double>(Histogram.GetCount()));
+		}
+	}
+
+	AppendHeader(Out, TEXT("unrealpythonrest_request_duration_max_seconds"), TEXT("gauge"), TEXT("Slowest request by phase since start or reset"));
+	for (int32 Index = 0; Index < Sorted.Num(); ++Index)
+	{
+		for (int32 Phase = 0; Phase < static_cast<int32>(ERESTPhase::Num); ++Phase)
+		{
+			const FRESTLatencyHistogram& Histogram = Sorted[Index]->Latency[Phase];
+			if (Histogram.GetCount() > 0)
+			{
+				AppendSample(Out, TEXT("unrealpythonrest_request_duration_max_seconds"), FString::Printf(TEXT("%s,phase=\"%s\""), *RouteLabels[Index], PhaseNames[Phase]), Histogram.GetMaxSeconds());
+			}
+		}
+	}
+
+	AppendHeader(Out, TEXT("unrealpythonrest_scheduler_queued_requests"), TEXT("gauge"), TEXT("Requests waiting for the game thread"));
+	Out += FString::Printf(TEXT("unrealpythonrest_scheduler_queued_requests %d\n"), QueuedRequests);
+
+	if (FrameTime.GetCount() > 0)
+	{
+		AppendHeader(Out, TEXT("unrealpythonrest_editor_frame_seconds"), TEXT("summary"), TEXT("Editor frame time while the server runs"));
+		for (const double Q : Quantiles)
+		{
+			Out += FString::Printf(TEXT("unrealpythonrest_editor_frame_seconds{quantile=\"%g\"} %.9g\n"), Q, FrameTime.GetQuantile(Q));
+		}
+		Out += FString::Printf(TEXT("unrealpythonrest_editor_frame_seconds_sum %.9g\n"), FrameTime.GetSumSeconds());
+		Out += FString::Printf(TEXT("unrealpythonrest_editor_frame_seconds_count %llu\n"), FrameTime.GetCount());
+
+		AppendHeader(Out, TEXT("unrealpythonrest_editor_frame_max_seconds"), TEXT("gauge"), TEXT("Longest editor frame since start or reset"));
+		Out += FString::Printf(TEXT("unrealpythonrest_editor_frame_max_seconds %.9g\n"), FrameTime.GetMaxSeconds());
+	}
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	AppendHeader(Out, TEXT("unrealpythonrest_process_used_physical_bytes"), TEXT("gauge"), TEXT("Physical memory used by the editor process"));
+	Out += FString::Printf(TEXT("unrealpythonrest_process_used_physical_bytes %llu\n"), static_cast<uint64>(MemoryStats.UsedPhysical));
+
+	AppendHeader(Out, TEXT("unrealpythonrest_process_peak_used_physical_bytes"), TEXT("gauge"), TEXT("Highest physical memory used since metrics were reset"));
+	Out += FString::Printf(TEXT("unrealpythonrest_process_peak_used_physical_bytes %llu\n"), FMath::Max<uint64>(PeakUsedPhysical.load(std::memory_order_relaxed), MemoryStats.UsedPhysical));
+
+	return Out;
+}
+
+void FRESTMetrics::WriteJson(FRESTJsonWriter& Writer, int32 QueuedRequests) const
+{
+	FReadScopeLock ReadLock(Lock);
+
+	Writer.WriteValue(TEXT("queued_requests"), QueuedRequests);
+
+	const uint64 Frames = FrameTime.GetCount();
+	Writer.WriteObjectStart(TEXT("frame_ms"));
+	Writer.WriteValue(TEXT("count"), static_cast<int64>(Frames));
+	Writer.WriteValue(TEXT("mean"), Frames > 0 ? FrameTime.GetSumSeconds() * 1000.0 / static_cast<double>(Frames) : 0.0);
+	Writer.WriteValue(TEXT("p50"), FrameTime.GetQuantile(0.5) * 1000.0);
+	Writer.WriteValue(TEXT("p90"), FrameTime.GetQuantile(0.9) * 1000.0);
+	Writer.WriteValue(TEXT("p99"), FrameTime.GetQuantile(0.99) * 1000.0);
+	Writer.WriteValue(TEXT("max"), FrameTime.GetMaxSeconds() * 1000.0);
+	Writer.WriteObjectEnd();
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	Writer.WriteObjectStart(TEXT("memory"));
+	Writer.WriteValue(TEXT("used_physical_bytes"), static_cast<int64>(MemoryStats.UsedPhysical));
+	Writer.WriteValue(TEXT("peak_used_physical_bytes"), static_cast<int64>(FMath::Max<uint64>(PeakUsedPhysical.load(std::memory_order_relaxed), MemoryStats.UsedPhysical)));
+	Writer.WriteValue(TEXT("process_peak_used_physical_bytes"), static_cast<int64>(MemoryStats.PeakUsedPhysical));
+	Writer.WriteObjectEnd();
+	Writer.WriteArrayStart(TEXT("routes"));
+	for (const FRouteMetrics* Entry : GetSortedRoutes())
+	{
+		const uint64 Requests = Entry->GetRequests();
+		const uint64 Errors = Entry->Status[2].load(std::memory_order_relaxed) + Entry->Status[3].load(std::memory_order_relaxed);
+
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("method"), LexToString(Entry->Method));
+		Writer.WriteValue(TEXT("route"), Entry->Route);
+		Writer.WriteValue(TEXT("requests"), static_cast<int64>(Requests));
+
+		Writer.WriteObjectStart(TEXT("status"));
+		for (int32 Class = 0; Class < NumStatusClasses; ++Class)
+		{
+			Writer.WriteValue(StatusClassNames[Class], static_cast<int64>(Entry->Status[Class].load(std::memory_order_relaxed)));
+		}
+		Writer.WriteObjectEnd();
+
+		Writer.WriteValue(TEXT("error_rate"), Requests > 0 ? static_cast<double>(Errors) / static_cast<double>(Requests) : 0.0);
+		Writer.WriteValue(TEXT("request_bytes"), static_cast<int64>(Entry->RequestBytes.load(std::memory_order_relaxed)));
+		Writer.WriteValue(TEXT("response_bytes"), static_cast<int64>(Entry->ResponseBytes.load(std::memory_order_relaxed)));
+
+		Writer.WriteObjectStart(TEXT("latency_ms"));
+		for (int32 Phase = 0; Phase < static_cast<int32>(ERESTPhase::Num); ++Phase)
+		{
+			const FRESTLatencyHistogram& Histogram = Entry->Latency[Phase];
+			const uint64 Count = Histogram.GetCount();
+			if (Count == 0)
+			{
+				continue;
+			}
+
+			Writer.WriteObjectStart(PhaseNames[Phase]);
+			Writer.WriteValue(TEXT("count"), static_cast<int64>(Count));
+			Writer.WriteValue(TEXT("mean"), Histogram.GetSumSeconds() * 1000.0 / static_cast<double>(Count));
+			Writer.WriteValue(TEXT("p50"), Histogram.GetQuantile(0.5) * 1000.0);
+			Writer.WriteValue(TEXT("p90"), Histogram.GetQuantile(0.9) * 1000.0);
+			Writer.WriteValue(TEXT("p99"), Histogram.GetQuantile(0.99) * 1000.0);
+			Writer.WriteValue(TEXT("max"), Histogram.GetMaxSeconds() * 1000.0);
+			Writer.WriteObjectEnd();
+		}
+		Writer.WriteObjectEnd();
+
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteArrayEnd();
+}
+
+void FRESTMetrics::RecordFrame(double DeltaSeconds)
+{
+	FrameTime.Record(DeltaSeconds);
+
+	// Sampled once a frame: GetStats is cheap, and the process-lifetime peak in
+	// FPlatformMemoryStats cannot be reset between benchmark runs
+	const uint64 Used = FPlatformMemory::GetStats().UsedPhysical;
+	uint64 Peak = PeakUsedPhysical.load(std::memory_order_relaxed);
+	while (Used > Peak && !PeakUsedPhysical.compare_exchange_weak(Peak, Used, std::memory_order_relaxed))
+	{
+	}
+}
+
+void FRESTMetrics::Reset()
+{
+	FWriteScopeLock WriteLock(Lock);
+	Routes.Empty();
+	FrameTime.Reset();
+	PeakUsedPhysical.store(0, std::memory_order_relaxed);
+}
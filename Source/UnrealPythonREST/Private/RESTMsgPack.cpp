@@ -0,0 +1,318 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RESTMsgPack.h"
+#include "Misc/Base64.h"
+
+namespace
+{
+	/** Nesting deeper than this is rejected rather than risking the stack */
+	constexpr int32 MaxDepth = 128;
+
+	/** Cursor over the input; every read is bounds-checked */
+	struct FMsgPackReader
+	{
+		TConstArrayView<uint8> Bytes;
+		int32 Pos = 0;
+		FString Error;
+
+		bool Fail(const TCHAR* Message)
+		{
+			if (Error.IsEmpty())
+			{
+				Error = FString::Printf(TEXT("%s at byte %d"), Message, Pos);
+			}
+			return false;
+		}
+
+		bool ReadBigEndian(int32 NumBytes, uint64& OutValue)
+		{
+			if (Bytes.Num() - Pos < NumBytes)
+			{
+				return Fail(TEXT("Truncated MessagePack data"));
+			}
+			OutValue = 0;
+			for (int32 Index = 0; Index < NumBytes; ++Index)
+			{
+				OutValue = (OutValue << 8) | Bytes[Pos++];
+			}
+			return true;
+		}
+
+		bool ReadString(uint32 Length, FString& OutString)
+		{
+			if (static_cast<uint32>(Bytes.Num() - Pos) < Length)
+			{
+				return Fail(TEXT("Truncated MessagePack string"));
+			}
+			const FUTF8ToTCHAR Converted(reinterpret_cast<const UTF8CHAR*>(Bytes.GetData() + Pos), Length);
+			OutString = FString(Converted.Length(), Converted.Get());
+			Pos += Length;
+			return true;
+		}
+
+		TSharedPtr<FJsonValue> ReadValue(int32 Depth);
+		TSharedPtr<FJsonValue> ReadArray(uint32 Count, int32 Depth);
+		TSharedPtr<FJsonValue> ReadMap(uint32 Count, int32 Depth);
+	};
+
+	TSharedPtr<FJsonValue> FMsgPackReader::ReadValue(int32 Depth)
+	{
+		if (Depth > MaxDepth)
+		{
+			Fail(TEXT("MessagePack data nested too deeply"));
+			return nullptr;
+		}
+		if (Pos >= Bytes.Num())
+		{
+			Fail(TEXT("Truncated MessagePack data"));
+			return nullptr;
+		}
+
+		const uint8 Type = Bytes[Pos++];
+		uint64 Raw = 0;
+
+		// Fixed-width forms
+		if (Type <= 0x7f)
+		{
+			return MakeShared<FJsonValueNumber>(Type);
+		}
+		if (Type >= 0xe0)
+		{
+			return MakeShared<FJsonValueNumber>(static_cast<int8>(Type));
+		}
+		if ((Type & 0xf0) == 0x80)
+		{
+			return ReadMap(Type & 0x0f, Depth);
+		}
+		if ((Type & 0xf0) == 0x90)
+		{
+			return ReadArray(Type & 0x0f, Depth);
+		}
+		if ((Type & 0xe0) == 0xa0)
+		{
+			FString String;
+			if (!ReadString(Type & 0x1f, String))
+			{
+				return nullptr;
+			}
+			return MakeShared<FJsonValueString>(String);
+		}
+
+		switch (Type)
+		{
+		case 0xc0:
+			return MakeShared<FJsonValueNull>();
+		case 0xc2:
+			return MakeShared<FJsonValueBoolean>(false);
+		case 0xc3:
+			return MakeShared<FJsonValueBoolean>(true);
+
+		case 0xc4: case 0xc5: case 0xc6:
+		{
+			if (!ReadBigEndian(1 << (Type - 0xc4), Raw))
+			{
+				return nullptr;
+			}
+			if (static_cast<uint64>(Bytes.Num() - Pos) < Raw)
+			{
+				Fail(TEXT("Truncated MessagePack binary"));
+				return nullptr;
+			}
+			const FString Encoded = FBase64::Encode(Bytes.GetData() + Pos, static_cast<uint32>(Raw));
+			Pos += static_cast<int32>(Raw);
+			return MakeShared<FJsonValueString>(Encoded);
+		}
+
+		case 0xca:
+		{
+			if (!ReadBigEndian(4, Raw))
+			{
+				return nullptr;
+			}
+			const uint32 Bits = static_cast<uint32>(Raw);
+			float Value;
+			FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+			return MakeShared<FJsonValueNumber>(Value);
+		}
+		case 0xcb:
+		{
+			if (!ReadBigEndian(8, Raw))
+			{
+				return nullptr;
+			}
+			double Value;
+			FMemory::Memcpy(&Value, &Raw, sizeof(Value));
+			return MakeShared<FJsonValueNumber>(Value);
+		}
+
+		case 0xcc: case 0xcd: case 0xce: case 0xcf:
+			if (!ReadBigEndian(1 << (Type - 0xcc), Raw))
+			{
+				return nullptr;
+			}
+			return MakeShared<FJsonValueNumber>(static_cast<double>(Raw));
+
+		case 0xd0: case 0xd1: case 0xd2: case 0xd3:
+		{
+			const int32 NumBytes = 1 << (Type - 0xd0);
+			if (!ReadBigEndian(NumBytes, Raw))
+			{
+				return nullptr;
+			}
+			// Sign-extend from NumBytes
+			const int32 Shift = 64 - NumBytes * 8;
+			const int64 Value = static_cast<int64>(Raw << Shift) >> Shift;
+			return MakeShared<FJsonValueNumber>(static_cast<double>(Value));
+		}
+
+		case 0xd9: case 0xda: case 0xdb:
+		{
+			FString String;
+			if (!ReadBigEndian(1 << (Type - 0xd9), Raw) || !ReadString(static_cast<uint32>(Raw), String))
+			{
+				return nullptr;
+			}
+			return MakeShared<FJsonValueString>(String);
+		}
+
+		case 0xdc: case 0xdd:
+			if (!ReadBigEndian(Type == 0xdc ? 2 : 4, Raw))
+			{
+				return nullptr;
+			}
+			return ReadArray(static_cast<uint32>(Raw), Depth);
+
+		case 0xde: case 0xdf:
+			if (!ReadBigEndian(Type == 0xde ? 2 : 4, Raw))
+			{
+				return nullptr;
+			}
+			return ReadMap(static_cast<uint32>(Raw), Depth);
+
+		default:
+			// 0xc1 is never used; 0xc7-0xc9 and 0xd4-0xd8 are extension types
+			--Pos;
+			Fail(TEXT("Unsupported MessagePack type"));
+			return nullptr;
+		}
+	}
+
+	TSharedPtr<FJsonValue> FMsgPackReader::ReadArray(uint32 Count, int32 Depth)
+	{
+		// Every element takes at least one byte, so a larger count is corrupt
+		if (Count > static_cast<uint32>(Bytes.Num() - Pos))
+		{
+			Fail(TEXT("Truncated MessagePack array"));
+			return nullptr;
+		}
+
+		TArray<TSharedPtr<FJsonValue>> Elements;
+		Elements.Reserve(Count);
+		for (uint32 Index = 0; Index < Count; ++Index)
+		{
+			TSharedPtr<FJsonValue> Element = ReadValue(Depth + 1);
+			if (!Element.IsValid())
+			{
+				return nullptr;
+			}
+			Elements.Add(MoveTemp(Element));
+		}
+		return MakeShared<FJsonValueArray>(Elements);
+	}
+
+	TSharedPtr<FJsonValue> FMsgPackReader::ReadMap(uint32 Count, int32 Depth)
+	{
+		if (Count > static_cast<uint32>(Bytes.Num() - Pos) / 2)
+		{
+			Fail(TEXT("Truncated MessagePack map"));
+			return nullptr;
+		}
+
+		TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+		for (uint32 Index = 0; Index < Count; ++Index)
+		{
+			const int32 KeyPos = Pos;
+			const TSharedPtr<FJsonValue> Key = ReadValue(Depth + 1);
+			if (!Key.IsValid())
+			{
+				return nullptr;
+			}
+
+			FString KeyString;
+			if (Key->Type == EJson::String)
+			{
+				KeyString = Key->AsString();
+			}
+			else if (Key->Type == EJson::Number)
+			{
+				KeyString = LexToString(static_cast<int64>(Key->AsNumber()));
+			}
+			else
+			{
+				Pos = KeyPos;
+				Fail(TEXT("MessagePack map key must be a string or integer"));
+				return nullptr;
+			}
+
+			TSharedPtr<FJsonValue> Value = ReadValue(Depth + 1);
+			if (!Value.IsValid())
+			{
+				return nullptr;
+			}
+			Object->SetField(KeyString, Value);
+		}
+		return MakeShared<FJsonValueObject>(Object);
+	}
+}
+
+namespace RESTMsgPack
+{
+	const TCHAR* const ContentType = TEXT("application/msgpack");
+
+	bool IsMediaType(FStringView MediaType)
+	{
+		int32 Semicolon = INDEX_NONE;
+		if (MediaType.FindChar(TEXT(';'), Semicolon))
+		{
+			MediaType = MediaType.Left(Semicolon);
+		}
+		MediaType = MediaType.TrimStartAndEnd();
+
+		return MediaType.Equals(TEXT("application/msgpack"), ESearchCase::IgnoreCase)
+			|| MediaType.Equals(TEXT("application/x-msgpack"), ESearchCase::IgnoreCase);
+	}
+
+	TSharedPtr<FJsonValue> Decode(TConstArrayView<uint8> Bytes, FString& OutError)
+	{
+		FMsgPackReader Reader;
+		Reader.Bytes = Bytes;
+
+		TSharedPtr<FJsonValue> Value = Reader.ReadValue(0);
+		if (Value.IsValid() && Reader.Pos != Bytes.Num())
+		{
+			Reader.Fail(TEXT("Trailing data after MessagePack value"));
+			Value.Reset();
+		}
+
+		if (!Value.IsValid())
+		{
+			OutError = Reader.Error;
+		}
+		return Value;
+	}
+
+	TSharedPtr<FJsonObject> DecodeObject(TConstArrayView<uint8> Bytes, FString& OutError)
+	{
+		const TSharedPtr<FJsonValue> Value = Decode(Bytes, OutError);
+		if (!Value.IsValid())
+		{
+			return nullptr;
+		}
+		if (Value->Type != EJson::Object)
+		{
+			OutError = TEXT("MessagePack body must be a map");
+			return nullptr;
+		}
+		return Value->AsObject();
+	}
+}
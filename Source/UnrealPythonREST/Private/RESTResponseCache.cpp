@@ -0,0 +1,310 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RESTResponseCache.h"
+#include "RESTJsonWriter.h"
+#include "Hash/xxhash.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+static TAutoConsoleVariable<int32> CVarResponseCacheMB(
+	TEXT("UnrealPythonREST.ResponseCacheMB"),
+	32,
+	TEXT("Memory cap in MB for memoized responses of Cached routes; least recently used entries are evicted first. 0 disables memoization."));
+
+static TAutoConsoleVariable<int32> CVarIdempotencyTTLSeconds(
+	TEXT("UnrealPythonREST.IdempotencyTTLSeconds"),
+	600,
+	TEXT("How long a response to a request sent with an Idempotency-Key is kept for replay. 0 disables Idempotency-Key handling."));
+
+namespace
+{
+	/** Upper bound on memoized entries, whatever their size */
+	constexpr int32 MaxEntries = 4096;
+
+	/** Upper bound on remembered idempotency keys */
+	constexpr int32 MaxIdempotencyKeys = 1024;
+
+	/** Bookkeeping per entry on top of its body and headers */
+	constexpr int64 EntryOverheadBytes = 256;
+
+	/** Approximate memory held by a frozen response */
+	int64 EstimateBytes(const FRESTResponse& Response)
+	{
+		int64 Bytes = EntryOverheadBytes;
+		if (Response.StreamBody.IsValid())
+		{
+			Bytes += Response.StreamBody->Bytes.Num();
+		}
+		if (Response.StreamBodyGzip.IsValid())
+		{
+			Bytes += Response.StreamBodyGzip->Bytes.Num();
+		}
+		Bytes += Response.RawBody.Len() * sizeof(TCHAR);
+		for (const TPair<FString, FString>& Header : Response.Headers)
+		{
+			Bytes += (Header.Key.Len() + Header.Value.Len()) * sizeof(TCHAR);
+		}
+		return Bytes;
+	}
+
+	void HashString(FXxHash64Builder& Builder, const FString& Value)
+	{
+		// Length first so ("ab", "c") and ("a", "bc") differ
+		const int32 Len = Value.Len();
+		Builder.Update(&Len, sizeof(Len));
+		Builder.Update(*Value, Len * sizeof(TCHAR));
+	}
+}
+
+FRESTResponseCache::FRESTResponseCache()
+	: Entries(MaxEntries)
+{
+}
+
+uint64 FRESTResponseCache::HashRequest(const FRESTRequest& Request, ERESTWireFormat Format)
+{
+	FXxHash64Builder Builder;
+
+	const uint8 Method = static_cast<uint8>(Request.Method);
+	const uint8 FormatByte = static_cast<uint8>(Format);
+	Builder.Update(&Method, sizeof(Method));
+	Builder.Update(&FormatByte, sizeof(FormatByte));
+	HashString(Builder, Request.Path);
+
+	// Query parameters arrive in client order; sort so equivalent requests share a key
+	TArray<const TPair<FString, FString>*, TInlineAllocator<8>> Params;
+	for (const TPair<FString, FString>& Param : Request.QueryParams)
+	{
+		Params.Add(&Param);
+	}
+	Params.Sort([](const TPair<FString, FString>& A, const TPair<FString, FString>& B) { return A.Key < B.Key; });
+	for (const TPair<FString, FString>* Param : Params)
+	{
+		HashString(Builder, Param->Key);
+		HashString(Builder, Param->Value);
+	}
+
+	const int32 BodyLen = Request.Body.Len();
+	Builder.Update(&BodyLen, sizeof(BodyLen));
+	Builder.Update(Request.Body.GetData(), BodyLen);
+
+	return Builder.Finalize().Hash;
+}
+
+void FRESTResponseCache::Freeze(FRESTResponse& Response, ERESTWireFormat Format)
+{
+	if (Response.StreamBody.IsValid() || !Response.JsonBody.IsValid())
+	{
+		return;
+	}
+
+	FRESTJsonWriter Writer(Format);
+	Writer.WriteJsonObject(Response.JsonBody);
+	Response.StreamBody = Writer.GetBuffer();
+	Response.StreamFormat = Format;
+	Response.JsonBody.Reset();
+}
+
+bool FRESTResponseCache::Find(uint64 Key, uint64 Version, FRESTResponse& OutResponse)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const FEntry* Entry = Entries.FindAndTouch(Key);
+	if (!Entry)
+	{
+		++Misses;
+		return false;
+	}
+
+	if (Entry->Version != Version)
+	{
+		// Something the response depended on has changed since it was stored
+		RemoveEntry(Key);
+		++Misses;
+		return false;
+	}
+
+	OutResponse = Entry->Response;
+	++Hits;
+	return true;
+}
+
+void FRESTResponseCache::Store(uint64 Key, uint64 Version, const FRESTResponse& Response)
+{
+	const int64 MaxBytes = static_cast<int64>(CVarResponseCacheMB.GetValueOnAnyThread()) * 1024 * 1024;
+	const int64 Bytes = EstimateBytes(Response);
+	if (Bytes > MaxBytes || Response.Deferred)
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+
+	RemoveEntry(Key);
+	while (Entries.Num() > 0 && (TotalBytes + Bytes > MaxBytes || Entries.Num() >= Entries.Max()))
+	{
+		TotalBytes -= Entries.RemoveLeastRecent().Bytes;
+		++Evictions;
+	}
+
+	FEntry Entry;
+	Entry.Version = Version;
+	Entry.Bytes = Bytes;
+	Entry.Response = Response;
+	Entries.Add(Key, MoveTemp(Entry));
+	TotalBytes += Bytes;
+}
+
+void FRESTResponseCache::RemoveEntry(uint64 Key)
+{
+	if (const FEntry* Entry = Entries.FindAndTouch(Key))
+	{
+		TotalBytes -= Entry->Bytes;
+		Entries.Remove(Key);
+	}
+}
+
+bool FRESTResponseCache::IsIdempotencyEnabled()
+{
+	return CVarIdempotencyTTLSeconds.GetValueOnAnyThread() > 0;
+}
+
+FRESTResponseCache::EClaim FRESTResponseCache::ClaimIdempotencyKey(const FString& Key, uint64 RequestHash, FRESTResponse& OutResponse)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	FScopeLock ScopeLock(&Lock);
+	TrimIdempotencyKeys(Now);
+
+	if (FIdempotencyEntry* Existing = IdempotencyKeys.Find(Key))
+	{
+		if (Existing->RequestHash != RequestHash)
+		{
+			return EClaim::Mismatch;
+		}
+		if (!Existing->bFinished)
+		{
+			return EClaim::InProgress;
+		}
+
+		OutResponse = Existing->Response;
+		++Replays;
+		return EClaim::Replay;
+	}
+
+	FIdempotencyEntry& Entry = IdempotencyKeys.Add(Key);
+	Entry.RequestHash = RequestHash;
+	Entry.ExpiresAt = Now + FMath::Max(1, CVarIdempotencyTTLSeconds.GetValueOnAnyThread());
+	return EClaim::Claimed;
+}
+
+void FRESTResponseCache::FinishIdempotencyKey(const FString& Key, const FRESTResponse& Response)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	FIdempotencyEntry* Entry = IdempotencyKeys.Find(Key);
+	if (!Entry)
+	{
+		return;
+	}
+
+	if (Response.StatusCode == 503 || Response.StatusCode == 429 || Response.Deferred)
+	{
+		IdempotencyKeys.Remove(Key);
+		return;
+	}
+
+	// The TTL runs from completion, so a slow mutation is still replayable for the full window
+	Entry->bFinished = true;
+	Entry->ExpiresAt = FPlatformTime::Seconds() + FMath::Max(1, CVarIdempotencyTTLSeconds.GetValueOnAnyThread());
+	Entry->Response = Response;
+}
+
+void FRESTResponseCache::TrimIdempotencyKeys(double Now)
+{
+	for (auto It = IdempotencyKeys.CreateIterator(); It; ++It)
+	{
+		if (It->Value.bFinished && It->Value.ExpiresAt <= Now)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	while (IdempotencyKeys.Num() >= MaxIdempotencyKeys)
+	{
+		const FString* Oldest = nullptr;
+		double OldestExpiry = TNumericLimits<double>::Max();
+		for (const TPair<FString, FIdempotencyEntry>& Pair : IdempotencyKeys)
+		{
+			if (Pair.Value.bFinished && Pair.Value.ExpiresAt < OldestExpiry)
+			{
+				Oldest = &Pair.Key;
+				OldestExpiry = Pair.Value.ExpiresAt;
+			}
+		}
+
+		// Every remaining key belongs to a request still running
+		if (!Oldest)
+		{
+			break;
+		}
+		IdempotencyKeys.Remove(FString(*Oldest));
+	}
+}
+
+void FRESTResponseCache::Empty()
+{
+	FScopeLock ScopeLock(&Lock);
+	Entries.Empty(MaxEntries);
+	TotalBytes = 0;
+	IdempotencyKeys.Reset();
+}
+
+FRESTResponseCache::FStats FRESTResponseCache::GetStats() const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	FStats Stats;
+	Stats.Entries = Entries.Num();
+	Stats.Bytes = TotalBytes;
+	Stats.MaxBytes = static_cast<int64>(CVarResponseCacheMB.GetValueOnAnyThread()) * 1024 * 1024;
+	Stats.Hits = Hits;
+	Stats.Misses = Misses;
+	Stats.Evictions = Evictions;
+	Stats.IdempotencyKeys = IdempotencyKeys.Num();
+	Stats.Replays = Replays;
+	return Stats;
+}
+
+void FRESTResponseCache::WriteJson(FRESTJsonWriter& Writer) const
+{
+	const FStats Stats = GetStats();
+	Writer.WriteValue(TEXT("entries"), Stats.Entries);
+	Writer.WriteValue(TEXT("bytes"), Stats.Bytes);
+	Writer.WriteValue(TEXT("max_bytes"), Stats.MaxBytes);
+	Writer.WriteValue(TEXT("hits"), static_cast<int64>(Stats.Hits));
+	Writer.WriteValue(TEXT("misses"), static_cast<int64>(Stats.Misses));
+	Writer.WriteValue(TEXT("evictions"), static_cast<int64>(Stats.Evictions));
+	Writer.WriteValue(TEXT("idempotency_keys"), Stats.IdempotencyKeys);
+	Writer.WriteValue(TEXT("idempotent_replays"), static_cast<int64>(Stats.Replays));
+}
+
+FString FRESTResponseCache::ToPrometheus() const
+{
+	const FStats Stats = GetStats();
+
+	FString Out;
+	auto Metric = [&Out](const TCHAR* Name, const TCHAR* Type, const TCHAR* Help, uint64 Value)
+	{
+		Out += FString::Printf(TEXT("# HELP %s %s\n# TYPE %s %s\n%s %llu\n"), Name, Help, Name, Type, Name, Value);
+	};
+
+	Metric(TEXT("unrealpythonrest_response_cache_entries"), TEXT("gauge"), TEXT("Memoized responses held"), Stats.Entries);
+	Metric(TEXT("unrealpythonrest_response_cache_bytes"), TEXT("gauge"), TEXT("Approximate memory held by memoized responses"), Stats.Bytes);
+	Metric(TEXT("unrealpythonrest_response_cache_hits_total"), TEXT("counter"), TEXT("Cached route requests answered from memory"), Stats.Hits);
+	Metric(TEXT("unrealpythonrest_response_cache_misses_total"), TEXT("counter"), TEXT("Cached route requests that ran the handler"), Stats.Misses);
+	Metric(TEXT("unrealpythonrest_response_cache_evictions_total"), TEXT("counter"), TEXT("Memoized responses evicted for the memory cap"), Stats.Evictions);
+	Metric(TEXT("unrealpythonrest_idempotent_replays_total"), TEXT("counter"), TEXT("Retried mutations answered with the stored response"), Stats.Replays);
+	return Out;
+}
@@ -0,0 +1,158 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RESTRouteTable.h"
+
+namespace
+{
+	/** Split off the next non-empty segment. Returns false when the path is exhausted. */
+	bool NextSegment(FStringView& Remaining, FStringView& OutSegment)
+	{
+		while (Remaining.Len() > 0 && Remaining[0] == TEXT('/'))
+		{
+			Remaining.RightChopInline(1);
+		}
+
+		if (Remaining.Len() == 0)
+		{
+			return false;
+		}
+
+		int32 SlashIndex = INDEX_NONE;
+		if (Remaining.FindChar(TEXT('/'), SlashIndex))
+		{
+			OutSegment = Remaining.Left(SlashIndex);
+			Remaining.RightChopInline(SlashIndex);
+		}
+		else
+		{
+			OutSegment = Remaining;
+			Remaining.Reset();
+		}
+		return true;
+	}
+
+	bool IsParamSegment(FStringView Segment)
+	{
+		return Segment.Len() > 2 && Segment[0] == TEXT('{') && Segment[Segment.Len() - 1] == TEXT('}');
+	}
+}
+
+int32 FRESTRouteTable::Add(ERESTMethod Method, const FString& Path, FRESTRouteHandler Handler, FRESTRouteOptions Options)
+{
+	if (Nodes.Num() == 0)
+	{
+		Nodes.AddDefaulted();
+	}
+
+	TArray<FString> ParamNames;
+	int32 NodeIndex = 0;
+
+	FStringView Remaining(Path);
+	FStringView Segment;
+	while (NextSegment(Remaining, Segment))
+	{
+		if (IsParamSegment(Segment))
+		{
+			ParamNames.Add(FString(Segment.Mid(1, Segment.Len() - 2)));
+
+			if (Nodes[NodeIndex].ParamChild == INDEX_NONE)
+			{
+				const int32 NewIndex = Nodes.AddDefaulted();
+				Nodes[NodeIndex].ParamChild = NewIndex;
+			}
+			NodeIndex = Nodes[NodeIndex].ParamChild;
+			continue;
+		}
+
+		int32 ChildIndex = INDEX_NONE;
+		for (int32 Candidate : Nodes[NodeIndex].Children)
+		{
+			if (Segment.Equals(Nodes[Candidate].Segment, ESearchCase::IgnoreCase))
+			{
+				ChildIndex = Candidate;
+				break;
+			}
+		}
+
+		if (ChildIndex == INDEX_NONE)
+		{
+			ChildIndex = Nodes.AddDefaulted();
+			Nodes[ChildIndex].Segment = FString(Segment);
+			Nodes[NodeIndex].Children.Add(ChildIndex);
+		}
+		NodeIndex = ChildIndex;
+	}
+
+	const int32 MethodIndex = static_cast<int32>(Method);
+	int32& RouteIndex = Nodes[NodeIndex].RouteIndex[MethodIndex];
+	if (RouteIndex == INDEX_NONE)
+	{
+		RouteIndex = Routes.AddDefaulted();
+	}
+
+	FRoute& Route = Routes[RouteIndex];
+	Route.Method = Method;
+	Route.Path = Path;
+	Route.ParamNames = MoveTemp(ParamNames);
+	Route.Handler = MoveTemp(Handler);
+	Route.Options = MoveTemp(Options);
+
+	return RouteIndex;
+}
+
+const FRESTRouteTable::FRoute* FRESTRouteTable::Find(ERESTMethod Method, FStringView Path, FRESTPathCaptures& OutCaptures) const
+{
+	OutCaptures.Reset();
+
+	if (Nodes.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	const int32 RouteIndex = MatchNode(0, Path, static_cast<int32>(Method), OutCaptures);
+	return RouteIndex != INDEX_NONE ? &Routes[RouteIndex] : nullptr;
+}
+
+int32 FRESTRouteTable::MatchNode(int32 NodeIndex, FStringView Remaining, int32 MethodIndex, FRESTPathCaptures& OutCaptures) const
+{
+	const FNode& Node = Nodes[NodeIndex];
+
+	FStringView Segment;
+	if (!NextSegment(Remaining, Segment))
+	{
+		return Node.RouteIndex[MethodIndex];
+	}
+
+	for (int32 ChildIndex : Node.Children)
+	{
+		const FString& ChildSegment = Nodes[ChildIndex].Segment;
+		if (ChildSegment.Len() == Segment.Len() && Segment.Equals(ChildSegment, ESearchCase::IgnoreCase))
+		{
+			const int32 RouteIndex = MatchNode(ChildIndex, Remaining, MethodIndex, OutCaptures);
+			if (RouteIndex != INDEX_NONE)
+			{
+				return RouteIndex;
+			}
+			break;
+		}
+	}
+
+	if (Node.ParamChild != INDEX_NONE)
+	{
+		OutCaptures.Add(Segment);
+		const int32 RouteIndex = MatchNode(Node.ParamChild, Remaining, MethodIndex, OutCaptures);
+		if (RouteIndex != INDEX_NONE)
+		{
+			return RouteIndex;
+		}
+		OutCaptures.Pop();
+	}
+
+	return INDEX_NONE;
+}
+
+void FRESTRouteTable::Empty()
+{
+	Nodes.Empty();
+	Routes.Empty();
+}
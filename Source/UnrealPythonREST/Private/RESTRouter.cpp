@@ -1,12 +1,246 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "RESTRouter.h"
+#include "RESTRouteTable.h"
+#include "RESTJsonWriter.h"
+#include "RESTMsgPack.h"
+#include "RESTScheduler.h"
+#include "RESTMetrics.h"
+#include "RESTResponseCache.h"
 #include "IRESTHandler.h"
 #include "HttpServerModule.h"
 #include "IHttpRouter.h"
 #include "HttpPath.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/Async.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Hash/xxhash.h"
+#include "Misc/Compression.h"
+#include "Misc/Crc.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+#include "IPAddress.h"
+
+static TAutoConsoleVariable<int32> CVarCompressionMinBytes(
+	TEXT("UnrealPythonREST.CompressionMinBytes"),
+	1024,
+	TEXT("Responses at least this large are gzip/deflate compressed when the client accepts it. 0 disables compression."));
+
+static TAutoConsoleVariable<int32> CVarWorkerDispatch(
+	TEXT("UnrealPythonREST.WorkerDispatch"),
+	1,
+	TEXT("1: parse, route and serialize requests on worker threads and schedule game-thread handlers by budget. 0: handle every request inline on the game thread."));
+
+namespace
+{
+	/** Streamed or raw bodies at least this large are serialized and compressed on a worker thread */
+	constexpr int32 MinOffloadBodyBytes = 64 * 1024;
+
+	/** Answer for routes that cannot run until the module has finished starting */
+	FRESTResponse MakeStartingResponse()
+	{
+		FRESTResponse Response = FRESTResponse::Error(503, TEXT("STARTING"), TEXT("UnrealPythonREST is still starting; retry shortly"));
+		Response.Headers.Add(TEXT("Retry-After"), TEXT("1"));
+		return Response;
+	}
+
+	double SecondsSince(uint64 StartCycles)
+	{
+		return FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+	}
+
+	/** Distinguishes ETags from different editor sessions, since generation counters restart at zero */
+	const uint32 SessionTag = static_cast<uint32>(FPlatformTime::Cycles64()) ^ FPlatformProcess::GetCurrentProcessId();
+
+	/** True if a comma-separated header (Accept-Encoding) lists Token without q=0 */
+	bool HeaderListAccepts(const FString* Header, const TCHAR* Token)
+	{
+		if (!Header)
+		{
+			return false;
+		}
+
+		TArray<FString> Entries;
+		Header->ParseIntoArray(Entries, TEXT(","));
+		for (FString& Entry : Entries)
+		{
+			FString Name = Entry;
+			FString Params;
+			Entry.Split(TEXT(";"), &Name, &Params);
+			Name.TrimStartAndEndInline();
+			if (Name.Equals(Token, ESearchCase::IgnoreCase))
+			{
+				Params.ReplaceInline(TEXT(" "), TEXT(""));
+				return !Params.StartsWith(TEXT("q=0")) || Params.StartsWith(TEXT("q=0."));
+			}
+		}
+		return false;
+	}
+
+	/** MessagePack when the Accept header lists a MessagePack media type, JSON otherwise */
+	ERESTWireFormat NegotiateWireFormat(const FRESTRequest& Request)
+	{
+		const FString* Accept = Request.Headers.Find(TEXT("Accept"));
+		return HeaderListAccepts(Accept, TEXT("application/msgpack")) || HeaderListAccepts(Accept, TEXT("application/x-msgpack"))
+			? ERESTWireFormat::MsgPack
+			: ERESTWireFormat::Json;
+	}
+
+	/** ETag of a Content-Encoding variant: strong validators must differ per content coding */
+	FString MakeEncodedETag(const FString& ETag, const FString& ContentEncoding)
+	{
+		if (ContentEncoding.IsEmpty())
+		{
+			return ETag;
+		}
+		return ETag.LeftChop(1) + (ContentEncoding == TEXT("deflate") ? TEXT("-df\"") : TEXT("-gz\""));
+	}
+
+	/**
+	 * True if If-None-Match matches ETag. Compression adds a suffix per
+	 * encoding (-gz, -df) to the tag; a compressed variant's tag only counts
+	 * when this request accepts that encoding, so a 304 never validates a
+	 * variant the client would not be sent.
+	 */
+	bool MatchesIfNoneMatch(const FRESTRequest& Request, const FString& ETag)
+	{
+		const FString* Header = Request.Headers.Find(TEXT("If-None-Match"));
+		if (!Header || ETag.Len() < 2)
+		{
+			return false;
+		}
+
+		const FString* AcceptEncoding = Request.Headers.Find(TEXT("Accept-Encoding"));
+		const FString Gzip = HeaderListAccepts(AcceptEncoding, TEXT("gzip")) ? MakeEncodedETag(ETag, TEXT("gzip")) : FString();
+		const FString Deflate = HeaderListAccepts(AcceptEncoding, TEXT("deflate")) ? MakeEncodedETag(ETag, TEXT("deflate")) : FString();
+
+		TArray<FString> Tags;
+		Header->ParseIntoArray(Tags, TEXT(","));
+		for (FString& Tag : Tags)
+		{
+			Tag.TrimStartAndEndInline();
+			Tag.RemoveFromStart(TEXT("W/"));
+			if (Tag == TEXT("*") || Tag.Equals(ETag, ESearchCase::CaseSensitive)
+				|| (!Gzip.IsEmpty() && Tag.Equals(Gzip, ESearchCase::CaseSensitive))
+				|| (!Deflate.IsEmpty() && Tag.Equals(Deflate, ESearchCase::CaseSensitive)))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/** Version-based ETag: session, route, version token, query string and wire format */
+	FString MakeVersionETag(const FRESTRouteTable::FRoute& Route, uint64 Version, const FRESTRequest& Request, ERESTWireFormat Format)
+	{
+		// Query parameters arrive in client order; sort so equivalent queries share a tag
+		TArray<const TPair<FString, FString>*, TInlineAllocator<8>> Params;
+		for (const TPair<FString, FString>& Param : Request.QueryParams)
+		{
+			Params.Add(&Param);
+		}
+		Params.Sort([](const TPair<FString, FString>& A, const TPair<FString, FString>& B) { return A.Key < B.Key; });
+
+		uint32 QueryHash = 0;
+		for (const TPair<FString, FString>* Param : Params)
+		{
+			QueryHash = FCrc::StrCrc32(*Param->Key, QueryHash);
+			QueryHash = FCrc::StrCrc32(*Param->Value, QueryHash);
+		}
+		for (const TPair<FString, FString>& Param : Request.PathParams)
+		{
+			QueryHash = FCrc::StrCrc32(*Param.Value, QueryHash);
+		}
+
+		return FString::Printf(TEXT("\"v%08x%08x-%llx-%08x%s\""), SessionTag, FCrc::StrCrc32(*Route.Path), Version, QueryHash,
+			Format == ERESTWireFormat::MsgPack ? TEXT("-m") : TEXT(""));
+	}
+
+	/** Compress Bytes in place with FormatName. Returns false (leaving Bytes alone) if it would not shrink. */
+	bool CompressBody(TArray<uint8>& Bytes, FName FormatName)
+	{
+		int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, Bytes.Num());
+		TArray<uint8> Compressed;
+		Compressed.SetNumUninitialized(CompressedSize);
+
+		if (!FCompression::CompressMemory(FormatName, Compressed.GetData(), CompressedSize, Bytes.GetData(), Bytes.Num()) ||
+			CompressedSize >= Bytes.Num())
+		{
+			return false;
+		}
+
+		Compressed.SetNum(CompressedSize);
+		Bytes = MoveTemp(Compressed);
+		return true;
+	}
+
+	/** Decode UTF-8 straight into FString storage (no null terminator needed on the source) */
+	FString DecodeUtf8(FUtf8StringView Text)
+	{
+		FString Result;
+		if (Text.IsEmpty())
+		{
+			return Result;
+		}
+
+		const int32 DestLen = FPlatformString::ConvertedLength<TCHAR>(Text.GetData(), Text.Len());
+		auto& Chars = Result.GetCharArray();
+		Chars.SetNumUninitialized(DestLen + 1);
+		FPlatformString::Convert(Chars.GetData(), DestLen, Text.GetData(), Text.Len());
+		Chars[DestLen] = TEXT('\0');
+		return Result;
+	}
+
+	TSharedPtr<FJsonObject> ParseJsonObject(FUtf8StringView Text)
+	{
+		TSharedPtr<FJsonObject> JsonObject;
+		if (!Text.IsEmpty())
+		{
+			TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(DecodeUtf8(Text));
+			FJsonSerializer::Deserialize(JsonReader, JsonObject);
+		}
+		return JsonObject;
+	}
+
+	/**
+	 * Find the route for Method + Path and add its {param} values to OutPathParams.
+	 * Every request path is matched through here; returns nullptr if no route matches.
+	 */
+	const FRESTRouteTable::FRoute* BindRoute(const FRESTRouteTable& RouteTable, ERESTMethod Method, FStringView Path, TMap<FString, FString>& OutPathParams)
+	{
+		FRESTPathCaptures Captures;
+		const FRESTRouteTable::FRoute* Route = RouteTable.Find(Method, Path, Captures);
+		if (Route)
+		{
+			for (int32 Index = 0; Index < Captures.Num(); ++Index)
+			{
+				OutPathParams.Add(Route->ParamNames[Index], FString(Captures[Index]));
+			}
+		}
+		return Route;
+	}
+}
+
+// FRESTRequest
+
+const TSharedPtr<FJsonObject>& FRESTLazyJsonBody::Get() const
+{
+	if (!bParsed)
+	{
+		Object = ParseJsonObject(Source);
+		bParsed = true;
+	}
+	return Object;
+}
+
+FString FRESTRequest::GetBodyString() const
+{
+	return DecodeUtf8(Body);
+}
 
 // Static factory methods for FRESTResponse
 
@@ -18,6 +252,40 @@ FRESTResponse FRESTResponse::Ok(TSharedPtr<FJsonObject> Json)
 	return Response;
 }
 
+FRESTResponse FRESTResponse::Stream(const FRESTJsonWriter& Writer, int32 Code)
+{
+	ensureMsgf(Writer.IsComplete(), TEXT("Streamed response has unclosed JSON containers"));
+
+	FRESTResponse Response;
+	Response.StatusCode = Code;
+	Response.StreamBody = Writer.GetBuffer();
+	Response.StreamFormat = Writer.GetFormat();
+	return Response;
+}
+
+FRESTResponse FRESTResponse::Defer(TFunction<void(FRESTResponder)> Start)
+{
+	FRESTResponse Response;
+	Response.Deferred = MoveTemp(Start);
+	return Response;
+}
+
+TSharedPtr<FJsonObject> FRESTResponse::GetJson() const
+{
+	if (JsonBody.IsValid() || !StreamBody.IsValid())
+	{
+		return JsonBody;
+	}
+
+	const TArray<uint8>& Bytes = StreamBody->Bytes;
+	if (StreamFormat == ERESTWireFormat::MsgPack)
+	{
+		FString DecodeError;
+		return RESTMsgPack::DecodeObject(Bytes, DecodeError);
+	}
+	return ParseJsonObject(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Bytes.GetData()), Bytes.Num()));
+}
+
 FRESTResponse FRESTResponse::Error(int32 Code, const FString& ErrorCode, const FString& Message)
 {
 	FRESTResponse Response;
@@ -44,10 +312,21 @@ FRESTResponse FRESTResponse::ServerError(const FString& Message)
 	return Error(500, TEXT("SERVER_ERROR"), Message);
 }
 
+FRESTResponse FRESTResponse::NotModified(const FString& ETag)
+{
+	FRESTResponse Response;
+	Response.StatusCode = 304;
+	Response.Headers.Add(TEXT("ETag"), ETag);
+	return Response;
+}
+
 // FRESTRouter implementation
 
 FRESTRouter::FRESTRouter()
-	: bIsRunning(false)
+	: RouteTable(MakeUnique<FRESTRouteTable>())
+	, Metrics(MakeUnique<FRESTMetrics>())
+	, ResponseCache(MakeUnique<FRESTResponseCache>())
+	, bIsRunning(false)
 	, CurrentPort(0)
 {
 }
@@ -92,63 +371,106 @@ bool FRESTRouter::Start(int32 Port)
 		return false;
 	}
 
-	// Register built-in endpoints
-	RegisterRoute(ERESTMethod::GET, TEXT("/health"), FRESTRouteHandler::CreateLambda(
-		[this](const FRESTRequest& Request) -> FRESTResponse
-		{
-			TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
-			Json->SetBoolField(TEXT("success"), true);
-			Json->SetStringField(TEXT("status"), TEXT("running"));
-			Json->SetNumberField(TEXT("port"), CurrentPort);
-
-			TArray<TSharedPtr<FJsonValue>> HandlersArray;
-			for (const TSharedPtr<IRESTHandler>& Handler : RegisteredHandlers)
+	// Built-in endpoints, unless a handler registered before Start() already provides them
+	FRESTPathCaptures Captures;
+	if (!RouteTable->Find(ERESTMethod::GET, TEXT("/health"), Captures))
+	{
+		RegisterRoute(ERESTMethod::GET, TEXT("/health"), FRESTRouteHandler::CreateLambda(
+			[this](const FRESTRequest& Request) -> FRESTResponse
 			{
-				if (Handler.IsValid())
+				TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+				Json->SetBoolField(TEXT("success"), true);
+				Json->SetStringField(TEXT("status"), IsReady() ? TEXT("running") : TEXT("starting"));
+				Json->SetNumberField(TEXT("port"), CurrentPort);
+
+				TArray<TSharedPtr<FJsonValue>> HandlersArray;
+				for (const TSharedPtr<IRESTHandler>& Handler : RegisteredHandlers)
 				{
-					HandlersArray.Add(MakeShared<FJsonValueString>(Handler->GetHandlerName()));
+					if (Handler.IsValid())
+					{
+						HandlersArray.Add(MakeShared<FJsonValueString>(Handler->GetHandlerName()));
+					}
 				}
-			}
-			Json->SetArrayField(TEXT("handlers"), HandlersArray);
+				Json->SetArrayField(TEXT("handlers"), HandlersArray);
 
-			return FRESTResponse::Ok(Json);
-		}
-	));
-
-	RegisterRoute(ERESTMethod::GET, TEXT("/handlers"), FRESTRouteHandler::CreateLambda(
-		[this](const FRESTRequest& Request) -> FRESTResponse
-		{
-			TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
-			Json->SetBoolField(TEXT("success"), true);
+				return FRESTResponse::Ok(Json);
+			}
+		), FRESTRouteOptions().DuringStartup());
+	}
 
-			TArray<TSharedPtr<FJsonValue>> HandlersArray;
-			for (const TSharedPtr<IRESTHandler>& Handler : RegisteredHandlers)
+	if (!RouteTable->Find(ERESTMethod::GET, TEXT("/handlers"), Captures))
+	{
+		RegisterRoute(ERESTMethod::GET, TEXT("/handlers"), FRESTRouteHandler::CreateLambda(
+			[this](const FRESTRequest& Request) -> FRESTResponse
 			{
-				if (Handler.IsValid())
+				TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+				Json->SetBoolField(TEXT("success"), true);
+
+				TArray<TSharedPtr<FJsonValue>> HandlersArray;
+				for (const TSharedPtr<IRESTHandler>& Handler : RegisteredHandlers)
 				{
-					TSharedPtr<FJsonObject> HandlerJson = MakeShared<FJsonObject>();
-					HandlerJson->SetStringField(TEXT("name"), Handler->GetHandlerName());
-					HandlerJson->SetStringField(TEXT("path"), Handler->GetBasePath());
-					HandlerJson->SetStringField(TEXT("description"), Handler->GetDescription());
-					HandlersArray.Add(MakeShared<FJsonValueObject>(HandlerJson));
+					if (Handler.IsValid())
+					{
+						TSharedPtr<FJsonObject> HandlerJson = MakeShared<FJsonObject>();
+						HandlerJson->SetStringField(TEXT("name"), Handler->GetHandlerName());
+						HandlerJson->SetStringField(TEXT("path"), Handler->GetBasePath());
+						HandlerJson->SetStringField(TEXT("description"), Handler->GetDescription());
+						HandlersArray.Add(MakeShared<FJsonValueObject>(HandlerJson));
+					}
 				}
+				Json->SetArrayField(TEXT("handlers"), HandlersArray);
+
+				return FRESTResponse::Ok(Json);
 			}
-			Json->SetArrayField(TEXT("handlers"), HandlersArray);
+		), FRESTRouteOptions().DuringStartup());
+	}
 
-			return FRESTResponse::Ok(Json);
-		}
-	));
+	Scheduler = MakeUnique<FRESTScheduler>();
+
+	FrameTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float DeltaTime)
+	{
+		Metrics->RecordFrame(DeltaTime);
+		return true;
+	}));
+
+	// Requests can arrive as soon as the listener starts, so the port is known first
+	CurrentPort = Port;
 
 	// Start the HTTP listener
 	HttpServerModule.StartAllListeners();
 
-	CurrentPort = Port;
 	bIsRunning = true;
 
 	UE_LOG(LogTemp, Log, TEXT("RESTRouter: Started on port %d"), Port);
 	return true;
 }
 
+bool FRESTRouter::IsPortAvailable(int32 Port)
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (!SocketSubsystem)
+	{
+		return true;
+	}
+
+	FSocket* Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("UnrealPythonREST port probe"), false);
+	if (!Socket)
+	{
+		return true;
+	}
+
+	// Same wildcard address the HTTP listener binds; no SO_REUSEADDR so a live listener makes this fail
+	TSharedRef<FInternetAddr> Address = SocketSubsystem->CreateInternetAddr();
+	Address->SetAnyAddress();
+	Address->SetPort(Port);
+	Socket->SetReuseAddr(false);
+	const bool bBound = Socket->Bind(*Address);
+
+	Socket->Close();
+	SocketSubsystem->DestroySocket(Socket);
+	return bBound;
+}
+
 void FRESTRouter::Stop()
 {
 	if (!bIsRunning)
@@ -156,6 +478,31 @@ void FRESTRouter::Stop()
 		return;
 	}
 
+	// Unbind the route first so no new requests arrive
+	if (HttpRouter.IsValid() && RouteHandle.IsValid())
+	{
+		HttpRouter->UnbindRoute(RouteHandle);
+	}
+
+	// Worker tasks still use the route table and ThreadSafe handlers
+	while (ActiveWorkers.load() > 0)
+	{
+		FPlatformProcess::Sleep(0.001f);
+	}
+
+	if (FrameTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(FrameTickHandle);
+		FrameTickHandle.Reset();
+	}
+
+	// Queued game-thread requests are answered 503 rather than run against handlers that are going away
+	if (Scheduler.IsValid())
+	{
+		Scheduler->Shutdown();
+		Scheduler.Reset();
+	}
+
 	// Shutdown all registered handlers
 	for (TSharedPtr<IRESTHandler>& Handler : RegisteredHandlers)
 	{
@@ -165,14 +512,8 @@ void FRESTRouter::Stop()
 		}
 	}
 
-	// Unbind the route
-	if (HttpRouter.IsValid() && RouteHandle.IsValid())
-	{
-		HttpRouter->UnbindRoute(RouteHandle);
-	}
-
 	// Clear state
-	Routes.Empty();
+	RouteTable->Empty();
 	RegisteredHandlers.Empty();
 	HttpRouter.Reset();
 	RouteHandle.Reset();
@@ -182,30 +523,12 @@ void FRESTRouter::Stop()
 	UE_LOG(LogTemp, Log, TEXT("RESTRouter: Stopped"));
 }
 
-void FRESTRouter::RegisterRoute(ERESTMethod Method, const FString& Path, FRESTRouteHandler Handler)
+void FRESTRouter::RegisterRoute(ERESTMethod Method, const FString& Path, FRESTRouteHandler Handler, FRESTRouteOptions Options)
 {
-	// Build route key as "METHOD:path"
-	FString MethodString;
-	switch (Method)
-	{
-	case ERESTMethod::GET:
-		MethodString = TEXT("GET");
-		break;
-	case ERESTMethod::POST:
-		MethodString = TEXT("POST");
-		break;
-	case ERESTMethod::PUT:
-		MethodString = TEXT("PUT");
-		break;
-	case ERESTMethod::DELETE:
-		MethodString = TEXT("DELETE");
-		break;
-	}
+	RouteTable->Add(Method, Path, MoveTemp(Handler), MoveTemp(Options));
+	RouteGeneration.fetch_add(1, std::memory_order_relaxed);
 
-	FString RouteKey = FString::Printf(TEXT("%s:%s"), *MethodString, *Path);
-	Routes.Add(RouteKey, MoveTemp(Handler));
-
-	UE_LOG(LogTemp, Verbose, TEXT("RESTRouter: Registered route %s"), *RouteKey);
+	UE_LOG(LogTemp, Verbose, TEXT("RESTRouter: Registered route %s:%s"), LexToString(Method), *Path);
 }
 
 void FRESTRouter::RegisterHandler(TSharedPtr<IRESTHandler> Handler)
@@ -218,6 +541,7 @@ void FRESTRouter::RegisterHandler(TSharedPtr<IRESTHandler> Handler)
 
 	RegisteredHandlers.Add(Handler);
 	Handler->RegisterRoutes(*this);
+	RouteGeneration.fetch_add(1, std::memory_order_relaxed);
 
 	UE_LOG(LogTemp, Log, TEXT("RESTRouter: Registered handler '%s' at '%s'"),
 		*Handler->GetHandlerName(), *Handler->GetBasePath());
@@ -225,91 +549,541 @@ void FRESTRouter::RegisterHandler(TSharedPtr<IRESTHandler> Handler)
 
 FRESTResponse FRESTRouter::DispatchInternal(const FRESTRequest& Request)
 {
-	// Build route key as "METHOD:path"
-	FString MethodStr;
-	switch (Request.Method)
+	// Callers read the result through GetJson() and embed it in their own response
+	FRESTJsonWriter::FScopedWireFormat WireFormat(ERESTWireFormat::Json);
+
+	TMap<FString, FString> PathParams;
+	const FRESTRouteTable::FRoute* Route = BindRoute(*RouteTable, Request.Method, Request.Path, PathParams);
+	if (!Route)
 	{
-	case ERESTMethod::GET:
-		MethodStr = TEXT("GET");
-		break;
-	case ERESTMethod::POST:
-		MethodStr = TEXT("POST");
-		break;
-	case ERESTMethod::PUT:
-		MethodStr = TEXT("PUT");
-		break;
-	case ERESTMethod::DELETE:
-		MethodStr = TEXT("DELETE");
-		break;
+		return FRESTResponse::NotFound(FString::Printf(TEXT("Route not found: %s:%s"), LexToString(Request.Method), *Request.Path));
 	}
 
-	FString RouteKey = FString::Printf(TEXT("%s:%s"), *MethodStr, *Request.Path);
+	if (!Route->Handler.IsBound())
+	{
+		return FRESTResponse::ServerError(TEXT("Route handler not bound"));
+	}
 
-	// Find handler
-	FRESTRouteHandler* Handler = Routes.Find(RouteKey);
-	if (!Handler)
+	if (!Route->Options.bDuringStartup && !IsReady())
 	{
-		return FRESTResponse::NotFound(FString::Printf(TEXT("Route not found: %s"), *RouteKey));
+		return MakeStartingResponse();
 	}
 
-	// Check if handler is bound
-	if (!Handler->IsBound())
+	FRESTResponse Response;
+	if (PathParams.Num() == 0)
 	{
-		return FRESTResponse::ServerError(TEXT("Route handler not bound"));
+		Response = Route->Handler.Execute(Request);
+	}
+	else
+	{
+		// Parameterized routes get their own copy so PathParams can be filled in
+		FRESTRequest ParamRequest = Request;
+		ParamRequest.PathParams.Append(MoveTemp(PathParams));
+		Response = Route->Handler.Execute(ParamRequest);
 	}
 
-	// Execute handler
-	return Handler->Execute(Request);
+	// Nothing would ever complete a deferred response here; the caller needs a result now
+	if (Response.Deferred)
+	{
+		return FRESTResponse::Error(400, TEXT("NOT_BATCHABLE"),
+			FString::Printf(TEXT("%s:%s answers asynchronously and cannot be dispatched internally"), LexToString(Request.Method), *Request.Path));
+	}
+	return Response;
+}
+
+int32 FRESTRouter::GetQueuedRequests() const
+{
+	return Scheduler.IsValid() ? Scheduler->Num() : 0;
+}
+
+bool FRESTRouter::IsThreadSafeRoute(ERESTMethod Method, const FString& Path) const
+{
+	FRESTPathCaptures Captures;
+	const FRESTRouteTable::FRoute* Route = RouteTable->Find(Method, Path, Captures);
+	return Route && Route->Options.bThreadSafe;
 }
 
+/** One HTTP request between the server callback and its response */
+struct FRESTRouter::FPendingRequest
+{
+	/** The server's request, copied so it outlives the callback; Request.Body views its body */
+	FHttpServerRequest HttpRequest;
+
+	/** Hands the response to the server. Game thread only. */
+	FHttpResultCallback OnComplete;
+
+	FRESTRequest Request;
+
+	/** Encoding streamed output should use, from the Accept header */
+	ERESTWireFormat Format = ERESTWireFormat::Json;
+
+	/** Matched route (null for 404), set by PrepareRequest. Not valid once the router has stopped. */
+	const FRESTRouteTable::FRoute* Route = nullptr;
+
+	/** Route pattern the request is counted under in FRESTMetrics */
+	FString MetricsRoute;
+
+	/** When the server handed the request over, and when it was queued for the game thread */
+	uint64 StartCycles = 0;
+	uint64 QueuedCycles = 0;
+
+	FRESTRequestTiming Timing;
+	int32 StatusCode = 200;
+
+	/** Set by AnswerFromCache for a Cached route: where RunHandler stores a 2xx response (version 0: do not store) */
+	uint64 CacheKey = 0;
+	uint64 CacheVersion = 0;
+
+	/** Claimed Idempotency-Key, scoped to the client; Complete stores the response under it */
+	FString IdempotencyKey;
+};
+
 bool FRESTRouter::HandleRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
 {
-	// Parse the incoming request
-	FRESTRequest ParsedRequest = ParseRequest(Request);
+	TSharedRef<FPendingRequest> Pending = MakeShared<FPendingRequest>();
+	Pending->StartCycles = FPlatformTime::Cycles64();
+	Pending->HttpRequest = Request;
+	Pending->OnComplete = OnComplete;
 
-	// Build route key to find handler
-	FString MethodString;
-	switch (ParsedRequest.Method)
+	if (!CVarWorkerDispatch.GetValueOnGameThread() || !Scheduler.IsValid())
 	{
-	case ERESTMethod::GET:
-		MethodString = TEXT("GET");
-		break;
-	case ERESTMethod::POST:
-		MethodString = TEXT("POST");
-		break;
-	case ERESTMethod::PUT:
-		MethodString = TEXT("PUT");
-		break;
-	case ERESTMethod::DELETE:
-		MethodString = TEXT("DELETE");
-		break;
+		if (PrepareRequest(Pending) && !AnswerFromCache(Pending))
+		{
+			RunHandler(Pending);
+		}
+		return true;
 	}
 
-	FString RouteKey = FString::Printf(TEXT("%s:%s"), *MethodString, *ParsedRequest.Path);
+	ActiveWorkers++;
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, Pending]()
+	{
+		ProcessRequest(Pending);
+		ActiveWorkers--;
+	});
+	return true;
+}
+
+bool FRESTRouter::PrepareRequest(const TSharedRef<FPendingRequest>& Pending)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(RESTRouter_Parse);
+	const uint64 ParseStart = FPlatformTime::Cycles64();
+
+	FRESTRequest& ParsedRequest = Pending->Request;
+	ParsedRequest = ParseRequest(Pending->HttpRequest);
+	Pending->Format = NegotiateWireFormat(ParsedRequest);
+
+	// Bound once here so route versions read by AnswerFromCache see PathParams too
+	Pending->Route = BindRoute(*RouteTable, ParsedRequest.Method, ParsedRequest.Path, ParsedRequest.PathParams);
+	Pending->MetricsRoute = Pending->Route ? Pending->Route->Path : FString(TEXT("unmatched"));
+
+	// MessagePack bodies are decoded up front; handlers read JsonBody either way
+	const FString* ContentType = ParsedRequest.Headers.Find(TEXT("Content-Type"));
+	if (ContentType && RESTMsgPack::IsMediaType(*ContentType) && !ParsedRequest.Body.IsEmpty())
+	{
+		FString DecodeError;
+		TSharedPtr<FJsonObject> Decoded = RESTMsgPack::DecodeObject(MakeArrayView(reinterpret_cast<const uint8*>(ParsedRequest.Body.GetData()), ParsedRequest.Body.Len()), DecodeError);
+		if (!Decoded.IsValid())
+		{
+			Pending->Timing[ERESTPhase::Parse] = SecondsSince(ParseStart);
+			Complete(Pending, FRESTResponse::BadRequest(FString::Printf(TEXT("Invalid MessagePack body: %s"), *DecodeError)));
+			return false;
+		}
+		ParsedRequest.JsonBody = Decoded;
+	}
+
+	Pending->Timing[ERESTPhase::Parse] = SecondsSince(ParseStart);
+	return true;
+}
+
+void FRESTRouter::ProcessRequest(const TSharedRef<FPendingRequest>& Pending)
+{
+	if (!PrepareRequest(Pending) || AnswerFromCache(Pending))
+	{
+		return;
+	}
 
-	// Find and execute the route handler
+	const FRESTRequest& Request = Pending->Request;
+	const FRESTRouteTable::FRoute* Route = Pending->Route;
+
+	// Registry and schema reads never need the game thread; neither does a 404
+	if (!Route || Route->Options.bThreadSafe)
+	{
+		RunHandler(Pending);
+		return;
+	}
+
+	// Parse the JSON body here rather than in the game thread's budget
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(RESTRouter_ParseBody);
+		const uint64 BodyStart = FPlatformTime::Cycles64();
+		Request.JsonBody.Get();
+		Pending->Timing[ERESTPhase::Parse] += SecondsSince(BodyStart);
+	}
+
+	ERESTPriority Priority = Route->Options.bBulk ? ERESTPriority::Bulk : ERESTPriority::Interactive;
+	if (const FString* PriorityHeader = Request.Headers.Find(TEXT("X-Priority")))
+	{
+		if (PriorityHeader->Equals(TEXT("bulk"), ESearchCase::IgnoreCase))
+		{
+			Priority = ERESTPriority::Bulk;
+		}
+		else if (PriorityHeader->Equals(TEXT("interactive"), ESearchCase::IgnoreCase))
+		{
+			Priority = ERESTPriority::Interactive;
+		}
+	}
+
+	const FString* ClientId = Request.Headers.Find(TEXT("X-Client-Id"));
+
+	FRESTScheduledWork Work = [this, Pending](bool bCancelled)
+	{
+		if (bCancelled)
+		{
+			Complete(Pending, FRESTResponse::Error(503, TEXT("SHUTTING_DOWN"), TEXT("Server stopped before the request ran")));
+			return;
+		}
+		RunHandler(Pending);
+	};
+
+	Pending->QueuedCycles = FPlatformTime::Cycles64();
+	if (!Scheduler->Enqueue(Priority, ClientId ? *ClientId : FString(), Work))
+	{
+		Complete(Pending, FRESTResponse::Error(503, TEXT("SERVER_BUSY"),
+			FString::Printf(TEXT("%d requests are already waiting for the game thread"), Scheduler->Num())));
+	}
+}
+
+bool FRESTRouter::AnswerFromCache(const TSharedRef<FPendingRequest>& Pending)
+{
+	// Unknown, unbound and not-yet-ready routes are answered by Dispatch
+	const FRESTRouteTable::FRoute* Route = Pending->Route;
+	if (!Route || !Route->Handler.IsBound() || (!Route->Options.bDuringStartup && !IsReady()))
+	{
+		return false;
+	}
+
+	const FRESTRequest& Request = Pending->Request;
+	if (Request.Method == ERESTMethod::GET)
+	{
+		if (!Route->Options.bCached || !Route->Options.Version.IsBound())
+		{
+			return false;
+		}
+
+		// Read before the handler runs, so a change made while it runs only costs a later miss
+		const uint64 Version = Route->Options.Version.Execute(Request);
+		if (Version == 0)
+		{
+			return false;
+		}
+		Pending->CacheKey = FRESTResponseCache::HashRequest(Request, Pending->Format);
+		Pending->CacheVersion = Version;
+
+		FRESTResponse Cached;
+		if (!ResponseCache->Find(Pending->CacheKey, Version, Cached))
+		{
+			return false;
+		}
+
+		const FString* ETag = Cached.Headers.Find(TEXT("ETag"));
+		if (ETag && MatchesIfNoneMatch(Request, *ETag))
+		{
+			Complete(Pending, FRESTResponse::NotModified(*ETag));
+			return true;
+		}
+
+		Cached.Headers.Add(TEXT("X-Cache"), TEXT("hit"));
+		Complete(Pending, MoveTemp(Cached));
+		return true;
+	}
+
+	// Mutations: a retry after a client timeout must not apply the change twice
+	const FString* KeyHeader = Request.Headers.Find(TEXT("Idempotency-Key"));
+	if (!KeyHeader || KeyHeader->IsEmpty() || !FRESTResponseCache::IsIdempotencyEnabled())
+	{
+		return false;
+	}
+
+	if (KeyHeader->Len() > FRESTResponseCache::MaxIdempotencyKeyLen)
+	{
+		Complete(Pending, FRESTResponse::BadRequest(FString::Printf(TEXT("Idempotency-Key is longer than %d characters"), FRESTResponseCache::MaxIdempotencyKeyLen)));
+		return true;
+	}
+
+	// Keys are per client, so two agents picking the same key do not collide
+	const FString* ClientId = Request.Headers.Find(TEXT("X-Client-Id"));
+	const FString ScopedKey = FString::Printf(TEXT("%s\n%s"), ClientId ? **ClientId : TEXT(""), **KeyHeader);
+
+	FRESTResponse Stored;
+	switch (ResponseCache->ClaimIdempotencyKey(ScopedKey, FRESTResponseCache::HashRequest(Request, Pending->Format), Stored))
+	{
+	case FRESTResponseCache::EClaim::Claimed:
+		Pending->IdempotencyKey = ScopedKey;
+		return false;
+
+	case FRESTResponseCache::EClaim::Replay:
+		Stored.Headers.Add(TEXT("Idempotent-Replayed"), TEXT("true"));
+		Complete(Pending, MoveTemp(Stored));
+		return true;
+
+	case FRESTResponseCache::EClaim::InProgress:
+	{
+		FRESTResponse Busy = FRESTResponse::Error(409, TEXT("IDEMPOTENCY_IN_PROGRESS"),
+			FString::Printf(TEXT("A request with Idempotency-Key '%s' is still running; retry to get its result"), **KeyHeader));
+		Busy.Headers.Add(TEXT("Retry-After"), TEXT("1"));
+		Complete(Pending, MoveTemp(Busy));
+		return true;
+	}
+
+	default:
+		Complete(Pending, FRESTResponse::Error(422, TEXT("IDEMPOTENCY_KEY_REUSED"),
+			FString::Printf(TEXT("Idempotency-Key '%s' was already used for a different request"), **KeyHeader)));
+		return true;
+	}
+}
+
+void FRESTRouter::RunHandler(const TSharedRef<FPendingRequest>& Pending)
+{
+	if (Pending->QueuedCycles != 0)
+	{
+		Pending->Timing[ERESTPhase::Queue] = SecondsSince(Pending->QueuedCycles);
+	}
+
+	// Find and execute the route handler; streamed output follows the negotiated format
 	FRESTResponse Response;
-	if (FRESTRouteHandler* Handler = Routes.Find(RouteKey))
 	{
-		if (Handler->IsBound())
+		TRACE_CPUPROFILER_EVENT_SCOPE(RESTRouter_Dispatch);
+		const uint64 DispatchStart = FPlatformTime::Cycles64();
+		FRESTJsonWriter::FScopedWireFormat WireFormat(Pending->Format);
+		Response = Dispatch(*Pending);
+		Pending->Timing[ERESTPhase::Dispatch] = SecondsSince(DispatchStart);
+	}
+
+	if (Response.Deferred)
+	{
+		// Responders are called on the game thread; ThreadSafe routes run on workers and cannot defer
+		if (!IsInGameThread())
+		{
+			Complete(Pending, FRESTResponse::ServerError(TEXT("Thread-safe route returned a deferred response")));
+			return;
+		}
+
+		// A responder can outlive the router (a batch finishing during editor shutdown);
+		// the connection is still owed a reply, just not one that touches the router
+		TFunction<void(FRESTResponder)> Start = MoveTemp(Response.Deferred);
+		Start([WeakRouter = TWeakPtr<FRESTRouter>(AsShared()), Pending](FRESTResponse&& DeferredResponse)
+		{
+			if (TSharedPtr<FRESTRouter> Router = WeakRouter.Pin())
+			{
+				Router->Complete(Pending, MoveTemp(DeferredResponse));
+			}
+			else
+			{
+				Pending->OnComplete(FHttpServerResponse::Create(
+					TEXT("{\"success\":false,\"error\":\"SHUTTING_DOWN\",\"message\":\"Server stopped before the request finished\"}"),
+					TEXT("application/json")));
+			}
+		});
+		return;
+	}
+
+	if (Pending->CacheVersion != 0 && Response.StatusCode >= 200 && Response.StatusCode < 300)
+	{
+		FRESTResponseCache::Freeze(Response, Pending->Format);
+		ResponseCache->Store(Pending->CacheKey, Pending->CacheVersion, Response);
+		Response.Headers.Add(TEXT("X-Cache"), TEXT("miss"));
+	}
+
+	Complete(Pending, MoveTemp(Response));
+}
+
+void FRESTRouter::Complete(const TSharedRef<FPendingRequest>& Pending, FRESTResponse&& Response)
+{
+	Pending->StatusCode = Response.StatusCode;
+
+	// Every outcome of a claimed key ends here, deferred responses included
+	if (!Pending->IdempotencyKey.IsEmpty())
+	{
+		FRESTResponseCache::Freeze(Response, Pending->Format);
+		ResponseCache->FinishIdempotencyKey(Pending->IdempotencyKey, Response);
+		Pending->IdempotencyKey.Reset();
+	}
+
+	if (IsInGameThread())
+	{
+		const int32 BodyBytes = Response.StreamBody.IsValid() ? Response.StreamBody->Bytes.Num() : Response.RawBody.Len();
+		if (BodyBytes >= MinOffloadBodyBytes && Scheduler.IsValid() && CVarWorkerDispatch.GetValueOnGameThread())
 		{
-			Response = Handler->Execute(ParsedRequest);
+			// Transcoding, hashing and compression of a large body do not need the game thread
+			ActiveWorkers++;
+			AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, Pending, Response = MoveTemp(Response)]()
+			{
+				SendOnGameThread(Pending, Serialize(Pending, Response));
+				ActiveWorkers--;
+			});
+			return;
+		}
+
+		Send(Pending, Serialize(Pending, Response));
+		return;
+	}
+
+	SendOnGameThread(Pending, Serialize(Pending, Response));
+}
+
+void FRESTRouter::SendOnGameThread(const TSharedRef<FPendingRequest>& Pending, TUniquePtr<FHttpServerResponse>&& HttpResponse)
+{
+	// The server's connections are only touched from the game thread. The router
+	// may be destroyed before the task runs (editor shutdown); the reply still goes out.
+	AsyncTask(ENamedThreads::GameThread, [WeakRouter = TWeakPtr<FRESTRouter>(AsShared()), Pending, HttpResponse = MoveTemp(HttpResponse)]() mutable
+	{
+		if (TSharedPtr<FRESTRouter> Router = WeakRouter.Pin())
+		{
+			Router->Send(Pending, MoveTemp(HttpResponse));
 		}
 		else
 		{
-			Response = FRESTResponse::ServerError(TEXT("Route handler not bound"));
+			Pending->OnComplete(MoveTemp(HttpResponse));
+		}
+	});
+}
+
+TUniquePtr<FHttpServerResponse> FRESTRouter::Serialize(const TSharedRef<FPendingRequest>& Pending, const FRESTResponse& Response)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(RESTRouter_Serialize);
+	const uint64 SerializeStart = FPlatformTime::Cycles64();
+	TUniquePtr<FHttpServerResponse> HttpResponse = BuildResponse(Pending->Request, Response);
+	Pending->Timing[ERESTPhase::Serialize] = SecondsSince(SerializeStart);
+	return HttpResponse;
+}
+
+void FRESTRouter::Send(const TSharedRef<FPendingRequest>& Pending, TUniquePtr<FHttpServerResponse>&& HttpResponse)
+{
+	Pending->Timing[ERESTPhase::Total] = SecondsSince(Pending->StartCycles);
+	Metrics->Record(
+		Pending->Request.Method,
+		Pending->MetricsRoute,
+		Pending->StatusCode,
+		Pending->HttpRequest.Body.Num(),
+		HttpResponse.IsValid() ? HttpResponse->Body.Num() : 0,
+		Pending->Timing);
+
+	Pending->OnComplete(MoveTemp(HttpResponse));
+}
+
+FRESTResponse FRESTRouter::Dispatch(const FPendingRequest& Pending)
+{
+	const FRESTRequest& Request = Pending.Request;
+	const FRESTRouteTable::FRoute* Route = Pending.Route;
+	if (!Route)
+	{
+		return FRESTResponse::NotFound(FString::Printf(TEXT("No handler for %s:%s"), LexToString(Request.Method), *Request.Path));
+	}
+
+	if (!Route->Handler.IsBound())
+	{
+		return FRESTResponse::ServerError(TEXT("Route handler not bound"));
+	}
+
+	if (!Route->Options.bDuringStartup && !IsReady())
+	{
+		return MakeStartingResponse();
+	}
+
+	// Versioned GET routes can answer 304 before doing any work
+	FString VersionETag;
+	if (Request.Method == ERESTMethod::GET && Route->Options.Version.IsBound())
+	{
+		const uint64 Version = Route->Options.Version.Execute(Request);
+		if (Version != 0)
+		{
+			VersionETag = MakeVersionETag(*Route, Version, Request, NegotiateWireFormat(Request));
+			if (MatchesIfNoneMatch(Request, VersionETag))
+			{
+				return FRESTResponse::NotModified(VersionETag);
+			}
 		}
 	}
-	else
+
+	FRESTResponse Response;
 	{
-		Response = FRESTResponse::NotFound(FString::Printf(TEXT("No handler for %s"), *RouteKey));
+		TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*Route->Path);
+		Response = Route->Handler.Execute(Request);
 	}
 
-	// Build and send HTTP response
-	TUniquePtr<FHttpServerResponse> HttpResponse = BuildResponse(Response);
-	OnComplete(MoveTemp(HttpResponse));
+	if (!VersionETag.IsEmpty() && Response.StatusCode >= 200 && Response.StatusCode < 300 && !Response.Headers.Contains(TEXT("ETag")))
+	{
+		Response.Headers.Add(TEXT("ETag"), MoveTemp(VersionETag));
+	}
 
-	return true;
+	return Response;
+}
+
+void FRESTRouter::BenchmarkDispatch(int32 Iterations) const
+{
+	const TArray<FRESTRouteTable::FRoute>& Routes = RouteTable->GetRoutes();
+	if (Routes.Num() == 0 || Iterations <= 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RESTRouter: Nothing to benchmark (%d routes, %d iterations)"), Routes.Num(), Iterations);
+		return;
+	}
+
+	// One concrete request path per route, with {param} segments filled in
+	TArray<TPair<ERESTMethod, FString>> Samples;
+	Samples.Reserve(Routes.Num());
+	for (const FRESTRouteTable::FRoute& Route : Routes)
+	{
+		FString SamplePath = Route.Path;
+		for (const FString& ParamName : Route.ParamNames)
+		{
+			SamplePath.ReplaceInline(*FString::Printf(TEXT("{%s}"), *ParamName), TEXT("0123456789abcdef"));
+		}
+		Samples.Emplace(Route.Method, MoveTemp(SamplePath));
+	}
+
+	// Route table lookup, including PathParams filling for parameterized routes
+	int32 Matched = 0;
+	TMap<FString, FString> PathParams;
+	const uint64 TrieStart = FPlatformTime::Cycles64();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (const TPair<ERESTMethod, FString>& Sample : Samples)
+		{
+			PathParams.Reset();
+			if (BindRoute(*RouteTable, Sample.Key, Sample.Value, PathParams))
+			{
+				++Matched;
+			}
+		}
+	}
+	const double TrieSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - TrieStart);
+
+	// Previous scheme for comparison: "METHOD:path" key built per request, then hashed
+	TMap<FString, int32> StringKeys;
+	for (int32 Index = 0; Index < Samples.Num(); ++Index)
+	{
+		StringKeys.Add(FString::Printf(TEXT("%s:%s"), LexToString(Samples[Index].Key), *Samples[Index].Value), Index);
+	}
+
+	int32 StringMatched = 0;
+	const uint64 StringStart = FPlatformTime::Cycles64();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (const TPair<ERESTMethod, FString>& Sample : Samples)
+		{
+			const FString RouteKey = FString::Printf(TEXT("%s:%s"), LexToString(Sample.Key), *Sample.Value);
+			if (StringKeys.Find(RouteKey))
+			{
+				++StringMatched;
+			}
+		}
+	}
+	const double StringSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StringStart);
+
+	const double Lookups = static_cast<double>(Iterations) * Samples.Num();
+	UE_LOG(LogTemp, Display, TEXT("RESTRouter: Dispatch benchmark over %d routes x %d iterations"), Samples.Num(), Iterations);
+	UE_LOG(LogTemp, Display, TEXT("RESTRouter:   route table: %.1f ns/lookup (%d matched)"), TrieSeconds * 1.0e9 / Lookups, Matched);
+	UE_LOG(LogTemp, Display, TEXT("RESTRouter:   string keys: %.1f ns/lookup (%d matched)"), StringSeconds * 1.0e9 / Lookups, StringMatched);
 }
 
 FRESTRequest FRESTRouter::ParseRequest(const FHttpServerRequest& Request)
@@ -372,50 +1146,156 @@ FRESTRequest FRESTRouter::ParseRequest(const FHttpServerRequest& Request)
 		ParsedRequest.QueryParams.Add(Param.Key, Param.Value);
 	}
 
-	// Parse body
-	if (Request.Body.Num() > 0)
+	// Parse headers
+	for (const TPair<FString, TArray<FString>>& Header : Request.Headers)
 	{
-		// Convert body bytes to string
-		ParsedRequest.Body = FString(ANSI_TO_TCHAR(reinterpret_cast<const char*>(Request.Body.GetData())));
-		ParsedRequest.Body = ParsedRequest.Body.Left(Request.Body.Num());
+		ParsedRequest.Headers.Add(Header.Key, FString::Join(Header.Value, TEXT(", ")));
+	}
 
-		// Try to deserialize as JSON
-		TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(ParsedRequest.Body);
-		TSharedPtr<FJsonObject> JsonObject;
-		if (FJsonSerializer::Deserialize(JsonReader, JsonObject) && JsonObject.IsValid())
-		{
-			ParsedRequest.JsonBody = JsonObject;
-		}
+	// Body stays a view of the copied request's UTF-8 bytes; JSON is parsed on first access
+	if (Request.Body.Num() > 0)
+	{
+		ParsedRequest.Body = FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Request.Body.GetData()), Request.Body.Num());
+		ParsedRequest.JsonBody.SetSource(ParsedRequest.Body);
 	}
 
 	return ParsedRequest;
 }
 
-TUniquePtr<FHttpServerResponse> FRESTRouter::BuildResponse(const FRESTResponse& Response)
+TUniquePtr<FHttpServerResponse> FRESTRouter::BuildResponse(const FRESTRequest& Request, const FRESTResponse& Response)
 {
-	FString ResponseBody;
+	if (Response.StatusCode == 304)
+	{
+		TUniquePtr<FHttpServerResponse> HttpResponse = MakeUnique<FHttpServerResponse>();
+		HttpResponse->Code = EHttpServerResponseCodes::NotModified;
+		for (const TPair<FString, FString>& Header : Response.Headers)
+		{
+			HttpResponse->Headers.FindOrAdd(Header.Key).Add(Header.Value);
+		}
+		return HttpResponse;
+	}
 
-	// Serialize JSON to string
-	if (Response.JsonBody.IsValid())
+	// Produce the body in the negotiated format
+	const ERESTWireFormat WireFormat = NegotiateWireFormat(Request);
+	bool bMsgPackBody = false;
+	bool bVerbatimStreamBody = false;
+	TArray<uint8> Bytes;
+	if (Response.StreamBody.IsValid())
 	{
-		TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&ResponseBody);
-		FJsonSerializer::Serialize(Response.JsonBody.ToSharedRef(), JsonWriter);
+		// JSON streamed by a writer that was pinned to JSON; re-encode unless it has its own type (NDJSON)
+		TSharedPtr<FJsonObject> Transcode;
+		if (WireFormat == ERESTWireFormat::MsgPack && Response.StreamFormat == ERESTWireFormat::Json && Response.ContentType.IsEmpty())
+		{
+			Transcode = Response.GetJson();
+		}
+
+		if (Transcode.IsValid())
+		{
+			FRESTJsonWriter Writer(ERESTWireFormat::MsgPack);
+			Writer.WriteJsonObject(Transcode);
+			Bytes = Writer.GetBuffer()->Bytes;
+			bMsgPackBody = true;
+		}
+		else
+		{
+			// Already encoded; one exact-size copy out of the pooled buffer
+			Bytes = Response.StreamBody->Bytes;
+			bMsgPackBody = Response.StreamFormat == ERESTWireFormat::MsgPack;
+			bVerbatimStreamBody = true;
+		}
+	}
+	else if (Response.JsonBody.IsValid())
+	{
+		FRESTJsonWriter Writer(WireFormat);
+		Writer.WriteJsonObject(Response.JsonBody);
+		Bytes = Writer.GetBuffer()->Bytes;
+		bMsgPackBody = Writer.IsBinary();
 	}
 	else if (!Response.RawBody.IsEmpty())
 	{
-		ResponseBody = Response.RawBody;
+		FTCHARToUTF8 Utf8(*Response.RawBody, Response.RawBody.Len());
+		Bytes.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	}
+	else if (WireFormat == ERESTWireFormat::MsgPack)
+	{
+		// Empty map
+		Bytes.Add(0x80);
+		bMsgPackBody = true;
 	}
 	else
 	{
 		// Empty response body
-		ResponseBody = TEXT("{}");
+		Bytes.Append(reinterpret_cast<const uint8*>("{}"), 2);
+	}
+
+	const TCHAR* ContentType = !Response.ContentType.IsEmpty() ? *Response.ContentType
+		: bMsgPackBody ? RESTMsgPack::ContentType
+		: TEXT("application/json");
+
+	// Strong ETag from the content when the route did not supply a version tag
+	FString ETag = Response.Headers.FindRef(TEXT("ETag"));
+	const bool bCacheable = Request.Method == ERESTMethod::GET && Response.StatusCode >= 200 && Response.StatusCode < 300;
+	if (bCacheable && ETag.IsEmpty())
+	{
+		ETag = FString::Printf(TEXT("\"%016llx\""), FXxHash64::HashBuffer(Bytes.GetData(), Bytes.Num()).Hash);
+	}
+
+	if (bCacheable && MatchesIfNoneMatch(Request, ETag))
+	{
+		return BuildResponse(Request, FRESTResponse::NotModified(ETag));
+	}
+
+	// Compress when the client accepts it and the body is worth it (encoded images are not)
+	FString ContentEncoding;
+	const int32 MinCompressBytes = CVarCompressionMinBytes.GetValueOnAnyThread();
+	if (MinCompressBytes > 0 && Bytes.Num() >= MinCompressBytes && !Response.ContentType.StartsWith(TEXT("image/")))
+	{
+		const FString* AcceptEncoding = Request.Headers.Find(TEXT("Accept-Encoding"));
+		const bool bAcceptsGzip = HeaderListAccepts(AcceptEncoding, TEXT("gzip"));
+		if (bAcceptsGzip && bVerbatimStreamBody && Response.StreamBodyGzip.IsValid())
+		{
+			// Compressed once by the handler (e.g. the cached /schema)
+			Bytes = Response.StreamBodyGzip->Bytes;
+			ContentEncoding = TEXT("gzip");
+		}
+		else if (bAcceptsGzip && CompressBody(Bytes, NAME_Gzip))
+		{
+			ContentEncoding = TEXT("gzip");
+		}
+		else if (HeaderListAccepts(AcceptEncoding, TEXT("deflate")) && CompressBody(Bytes, NAME_Zlib))
+		{
+			ContentEncoding = TEXT("deflate");
+		}
 	}
 
 	// Create HTTP response
-	TUniquePtr<FHttpServerResponse> HttpResponse = FHttpServerResponse::Create(ResponseBody, TEXT("application/json"));
+	// Note: the HTTP status stays 200 for errors; clients read "success"/"error" from the body
+	TUniquePtr<FHttpServerResponse> HttpResponse = FHttpServerResponse::Create(MoveTemp(Bytes), ContentType);
 
-	// Note: FHttpServerResponse::Create sets a 200 OK status by default
-	// The actual status code handling depends on UE version - newer versions support custom status codes
+	for (const TPair<FString, FString>& Header : Response.Headers)
+	{
+		if (!Header.Key.Equals(TEXT("ETag"), ESearchCase::IgnoreCase))
+		{
+			HttpResponse->Headers.FindOrAdd(Header.Key).Add(Header.Value);
+		}
+	}
+
+	if (!ETag.IsEmpty())
+	{
+		HttpResponse->Headers.FindOrAdd(TEXT("ETag")).Add(MakeEncodedETag(ETag, ContentEncoding));
+	}
+
+	if (!ContentEncoding.IsEmpty())
+	{
+		HttpResponse->Headers.FindOrAdd(TEXT("Content-Encoding")).Add(ContentEncoding);
+	}
+
+	TArray<FString>& Vary = HttpResponse->Headers.FindOrAdd(TEXT("Vary"));
+	Vary.Add(TEXT("Accept"));
+	if (MinCompressBytes > 0)
+	{
+		Vary.Add(TEXT("Accept-Encoding"));
+	}
 
 	return HttpResponse;
 }
@@ -0,0 +1,154 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RESTScheduler.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+static TAutoConsoleVariable<float> CVarGameThreadBudgetMs(
+	TEXT("UnrealPythonREST.GameThreadBudgetMs"),
+	8.0f,
+	TEXT("Game-thread time per tick for running queued REST requests. At least one interactive and one bulk request run each tick."));
+
+static TAutoConsoleVariable<int32> CVarMaxQueuedRequests(
+	TEXT("UnrealPythonREST.MaxQueuedRequests"),
+	512,
+	TEXT("Requests waiting for the game thread before new ones are answered with 503 SERVER_BUSY."));
+
+FRESTScheduler::FRESTScheduler()
+{
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FRESTScheduler::Tick));
+}
+
+FRESTScheduler::~FRESTScheduler()
+{
+	Shutdown();
+}
+
+bool FRESTScheduler::Enqueue(ERESTPriority Priority, const FString& ClientId, FRESTScheduledWork& Work)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (!TickHandle.IsValid() || Queues[0].Num + Queues[1].Num >= CVarMaxQueuedRequests.GetValueOnAnyThread())
+	{
+		return false;
+	}
+
+	FPriorityQueue& Queue = Queues[static_cast<int32>(Priority)];
+	FClientQueue* Client = Queue.Clients.FindByPredicate([&ClientId](const FClientQueue& Entry) { return Entry.ClientId == ClientId; });
+	if (!Client)
+	{
+		Client = &Queue.Clients.AddDefaulted_GetRef();
+		Client->ClientId = ClientId;
+	}
+	Client->Items.Add(MoveTemp(Work));
+	Queue.Num++;
+	return true;
+}
+
+void FRESTScheduler::Shutdown()
+{
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	}
+
+	TArray<FRESTScheduledWork> Cancelled;
+	{
+		FScopeLock ScopeLock(&Lock);
+		TickHandle.Reset();
+
+		for (FPriorityQueue& Queue : Queues)
+		{
+			for (FClientQueue& Client : Queue.Clients)
+			{
+				for (FRESTScheduledWork& Work : Client.Items)
+				{
+					Cancelled.Add(MoveTemp(Work));
+				}
+			}
+			Queue.Clients.Empty();
+			Queue.NextClient = 0;
+			Queue.Num = 0;
+		}
+	}
+
+	for (FRESTScheduledWork& Work : Cancelled)
+	{
+		Work(true);
+	}
+}
+
+int32 FRESTScheduler::Num() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Queues[0].Num + Queues[1].Num;
+}
+
+bool FRESTScheduler::Pop(ERESTPriority Priority, FRESTScheduledWork& OutWork)
+{
+	FPriorityQueue& Queue = Queues[static_cast<int32>(Priority)];
+	if (Queue.Clients.Num() == 0)
+	{
+		return false;
+	}
+
+	const int32 ClientIndex = Queue.NextClient % Queue.Clients.Num();
+	FClientQueue& Client = Queue.Clients[ClientIndex];
+	OutWork = MoveTemp(Client.Items[0]);
+	Client.Items.RemoveAt(0);
+	Queue.Num--;
+
+	// The next client slides into this slot when this one runs dry
+	if (Client.Items.Num() == 0)
+	{
+		Queue.Clients.RemoveAt(ClientIndex);
+		Queue.NextClient = ClientIndex;
+	}
+	else
+	{
+		Queue.NextClient = ClientIndex + 1;
+	}
+	return true;
+}
+
+bool FRESTScheduler::Tick(float DeltaTime)
+{
+	if (bTicking)
+	{
+		return true;
+	}
+	TGuardValue<bool> TickingGuard(bTicking, true);
+	TRACE_CPUPROFILER_EVENT_SCOPE(FRESTScheduler_Tick);
+
+	const double BudgetSeconds = FMath::Max(CVarGameThreadBudgetMs.GetValueOnGameThread(), 0.0f) / 1000.0;
+	const double StartTime = FPlatformTime::Seconds();
+	bool bRanInteractive = false;
+	bool bRanBulk = false;
+
+	for (;;)
+	{
+		FRESTScheduledWork Work;
+		{
+			FScopeLock ScopeLock(&Lock);
+
+			const bool bInBudget = FPlatformTime::Seconds() - StartTime < BudgetSeconds;
+			if ((bInBudget || !bRanInteractive) && Pop(ERESTPriority::Interactive, Work))
+			{
+				bRanInteractive = true;
+			}
+			else if ((bInBudget || !bRanBulk) && Pop(ERESTPriority::Bulk, Work))
+			{
+				bRanBulk = true;
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		Work(false);
+	}
+
+	return true;
+}
@@ -0,0 +1,208 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RESTSchemaCache.h"
+#include "RESTJsonWriter.h"
+#include "IRESTHandler.h"
+#include "Dom/JsonObject.h"
+#include "Hash/xxhash.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Compression.h"
+
+namespace
+{
+	/** Lookup key for an endpoint path: lowercase with a leading slash */
+	FString MakeEndpointKey(const FString& Path)
+	{
+		FString Key = Path.ToLower();
+		if (!Key.StartsWith(TEXT("/")))
+		{
+			Key.InsertAt(0, TEXT('/'));
+		}
+		return Key;
+	}
+
+	/** gzip of Bytes, or null if it would not shrink */
+	TSharedPtr<FRESTOutputBuffer> Gzip(const TArray<uint8>& Bytes)
+	{
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, Bytes.Num());
+		TSharedRef<FRESTOutputBuffer> Compressed = FRESTOutputBuffer::Acquire();
+		Compressed->Bytes.SetNumUninitialized(CompressedSize);
+
+		if (!FCompression::CompressMemory(NAME_Gzip, Compressed->Bytes.GetData(), CompressedSize, Bytes.GetData(), Bytes.Num()) ||
+			CompressedSize >= Bytes.Num())
+		{
+			return nullptr;
+		}
+
+		Compressed->Bytes.SetNum(CompressedSize);
+		return Compressed;
+	}
+
+	FRESTSchemaCache::FBody Encode(const TSharedPtr<FJsonObject>& Object)
+	{
+		FRESTSchemaCache::FBody Body;
+		for (const ERESTWireFormat Format : { ERESTWireFormat::Json, ERESTWireFormat::MsgPack })
+		{
+			FRESTJsonWriter Writer(Format);
+			Writer.WriteJsonObject(Object);
+
+			const int32 Index = static_cast<int32>(Format);
+			Body.Encoded[Index] = Writer.GetBuffer();
+			Body.Gzip[Index] = Gzip(Writer.GetBuffer()->Bytes);
+		}
+		return Body;
+	}
+
+	/** name, base_path and description of Handler */
+	TSharedRef<FJsonObject> MakeHandlerInfo(const IRESTHandler& Handler)
+	{
+		TSharedRef<FJsonObject> HandlerJson = MakeShared<FJsonObject>();
+		HandlerJson->SetStringField(TEXT("name"), Handler.GetHandlerName());
+		HandlerJson->SetStringField(TEXT("base_path"), Handler.GetBasePath());
+		HandlerJson->SetStringField(TEXT("description"), Handler.GetDescription());
+		return HandlerJson;
+	}
+}
+
+FRESTResponse FRESTSchemaCache::FBody::ToResponse(ERESTWireFormat Format) const
+{
+	const int32 Index = static_cast<int32>(Format);
+
+	FRESTResponse Response;
+	Response.StreamBody = Encoded[Index];
+	Response.StreamFormat = Format;
+	Response.StreamBodyGzip = Gzip[Index];
+	return Response;
+}
+
+const FRESTSchemaCache::FBody* FRESTSchemaCache::FSnapshot::FindHandler(const FString& Name) const
+{
+	const int32* Index = HandlerIndex.Find(Name.ToLower());
+	return Index ? &Handlers[*Index] : nullptr;
+}
+
+const FRESTSchemaCache::FBody* FRESTSchemaCache::FSnapshot::FindEndpoint(const FString& Path) const
+{
+	const int32* Index = EndpointIndex.Find(MakeEndpointKey(Path));
+	return Index ? &Endpoints[*Index] : nullptr;
+}
+
+FRESTSchemaCache::FRESTSchemaCache(const FRESTRouter& InRouter)
+	: Router(InRouter)
+{
+	ReloadHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddRaw(this, &FRESTSchemaCache::OnReloadComplete);
+}
+
+FRESTSchemaCache::~FRESTSchemaCache()
+{
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadHandle);
+}
+
+void FRESTSchemaCache::OnReloadComplete(EReloadCompleteReason Reason)
+{
+	ReloadCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+FRESTSchemaCache::FSnapshotRef FRESTSchemaCache::Get()
+{
+	const uint64 RouteGeneration = Router.GetRouteGeneration();
+	const uint32 Reloads = ReloadCount.load(std::memory_order_relaxed);
+
+	FScopeLock ScopeLock(&Lock);
+	if (!Snapshot.IsValid() || Snapshot->RouteGeneration != RouteGeneration || Snapshot->ReloadCount != Reloads)
+	{
+		Snapshot = Build(RouteGeneration, Reloads);
+	}
+	return Snapshot.ToSharedRef();
+}
+
+FRESTSchemaCache::FSnapshotRef FRESTSchemaCache::Build(uint64 RouteGeneration, uint32 Reloads) const
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	TSharedRef<FSnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FSnapshot, ESPMode::ThreadSafe>();
+	NewSnapshot->RouteGeneration = RouteGeneration;
+	NewSnapshot->ReloadCount = Reloads;
+
+	TSharedPtr<FJsonObject> Schema = MakeShared<FJsonObject>();
+	Schema->SetStringField(TEXT("api_version"), TEXT("v1"));
+	Schema->SetStringField(TEXT("base_path"), TEXT("/api/v1"));
+
+	// Document units
+	TSharedPtr<FJsonObject> Units = MakeShared<FJsonObject>();
+	Units->SetStringField(TEXT("distance"), TEXT("centimeters (100 = 1 meter)"));
+	Units->SetStringField(TEXT("rotation"), TEXT("degrees (90 = quarter turn)"));
+	Units->SetStringField(TEXT("scale"), TEXT("multiplier (1.0 = normal size)"));
+	Schema->SetObjectField(TEXT("units"), Units);
+
+	// Error codes
+	TSharedPtr<FJsonObject> ErrorCodes = MakeShared<FJsonObject>();
+	ErrorCodes->SetStringField(TEXT("INVALID_PARAMS"), TEXT("400 - Missing or malformed parameters"));
+	ErrorCodes->SetStringField(TEXT("ASSET_NOT_FOUND"), TEXT("404 - Asset path doesn't exist"));
+	ErrorCodes->SetStringField(TEXT("ACTOR_NOT_FOUND"), TEXT("404 - Actor label not in level"));
+	ErrorCodes->SetStringField(TEXT("CLASS_NOT_FOUND"), TEXT("404 - Class path invalid"));
+	ErrorCodes->SetStringField(TEXT("NO_LEVEL_LOADED"), TEXT("400 - No level currently open"));
+	ErrorCodes->SetStringField(TEXT("EXECUTION_ERROR"), TEXT("500 - Runtime error"));
+	Schema->SetObjectField(TEXT("error_codes"), ErrorCodes);
+
+	TArray<TSharedPtr<FJsonValue>> HandlersArray;
+	for (const TSharedPtr<IRESTHandler>& Handler : Router.GetHandlers())
+	{
+		if (!Handler.IsValid())
+		{
+			continue;
+		}
+
+		// The only call into the handler; every slice below is cut from these objects
+		const TArray<TSharedPtr<FJsonObject>> EndpointSchemas = Handler->GetEndpointSchemas();
+
+		TArray<TSharedPtr<FJsonValue>> EndpointsArray;
+		EndpointsArray.Reserve(EndpointSchemas.Num());
+		for (const TSharedPtr<FJsonObject>& Endpoint : EndpointSchemas)
+		{
+			EndpointsArray.Add(MakeShared<FJsonValueObject>(Endpoint));
+
+			// First handler to describe a path wins, as the old linear search did
+			FString Path;
+			if (!Endpoint->TryGetStringField(TEXT("path"), Path) || NewSnapshot->EndpointIndex.Contains(MakeEndpointKey(Path)))
+			{
+				continue;
+			}
+
+			TSharedPtr<FJsonObject> EndpointJson = MakeShared<FJsonObject>();
+			EndpointJson->SetBoolField(TEXT("success"), true);
+			EndpointJson->SetStringField(TEXT("handler"), Handler->GetHandlerName());
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Endpoint->Values)
+			{
+				EndpointJson->SetField(Field.Key, Field.Value);
+			}
+
+			NewSnapshot->EndpointIndex.Add(MakeEndpointKey(Path), NewSnapshot->Endpoints.Num());
+			NewSnapshot->EndpointPaths.Add(Path);
+			NewSnapshot->Endpoints.Add(Encode(EndpointJson));
+		}
+
+		TSharedRef<FJsonObject> HandlerJson = MakeHandlerInfo(*Handler);
+		HandlerJson->SetArrayField(TEXT("endpoints"), EndpointsArray);
+		HandlersArray.Add(MakeShared<FJsonValueObject>(HandlerJson));
+
+		TSharedRef<FJsonObject> SliceJson = MakeShared<FJsonObject>();
+		SliceJson->SetBoolField(TEXT("success"), true);
+		SliceJson->Values.Append(HandlerJson->Values);
+
+		NewSnapshot->HandlerIndex.FindOrAdd(Handler->GetHandlerName().ToLower(), NewSnapshot->Handlers.Num());
+		NewSnapshot->HandlerNames.Add(Handler->GetHandlerName());
+		NewSnapshot->Handlers.Add(Encode(SliceJson));
+	}
+	Schema->SetArrayField(TEXT("handlers"), HandlersArray);
+
+	NewSnapshot->Full = Encode(Schema);
+
+	const TArray<uint8>& FullJson = NewSnapshot->Full.Encoded[static_cast<int32>(ERESTWireFormat::Json)]->Bytes;
+	NewSnapshot->Hash = FXxHash64::HashBuffer(FullJson.GetData(), FullJson.Num()).Hash | 1;
+
+	UE_LOG(LogTemp, Log, TEXT("RESTSchemaCache: Built schema for %d handlers, %d endpoints (%d bytes) in %.1f ms"),
+		NewSnapshot->Handlers.Num(), NewSnapshot->Endpoints.Num(), FullJson.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	return NewSnapshot;
+}
@@ -3,6 +3,19 @@
 #include "UnrealPythonREST.h"
 #include "RESTRouter.h"
 #include "ConfigWriter.h"
+#include "Utils/EditorChangeTracker.h"
+#include "Utils/ActorIndex.h"
+#include "Utils/ActorSpatialIndex.h"
+#include "Utils/AssetSearchIndex.h"
+#include "Utils/EditorEventFeed.h"
+#include "Utils/BenchmarkContent.h"
+#include "Utils/MaterialGraphDiff.h"
+#include "Utils/MaterialGraphIndex.h"
+#include "Utils/BlueprintSessionCache.h"
+#include "Utils/BlueprintCompileQueue.h"
+#include "Utils/ViewportCapture.h"
+#include "Utils/AssetBulkInspector.h"
+#include "Utils/ActorUtils.h"
 #include "Handlers/InfrastructureHandler.h"
 #include "Handlers/AssetsHandler.h"
 #include "Handlers/LevelHandler.h"
@@ -12,24 +25,111 @@
 #include "Handlers/MaterialsHandler.h"
 #include "Handlers/BlueprintsHandler.h"
 #include "Modules/ModuleManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Containers/Ticker.h"
 
 #define LOCTEXT_NAMESPACE "FUnrealPythonRESTModule"
 
 DEFINE_LOG_CATEGORY_STATIC(LogUnrealPythonREST, Log, All);
 
-void FUnrealPythonRESTModule::StartupModule()
-{
-	// Create and start the REST router
-	Router = MakeShared<FRESTRouter>();
+static TAutoConsoleVariable<int32> CVarPort(
+	TEXT("UnrealPythonREST.Port"),
+	8080,
+	TEXT("Port the REST server listens on; -RESTPort=<port> on the command line takes precedence. Read at startup."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPortFallbackCount(
+	TEXT("UnrealPythonREST.PortFallbackCount"),
+	10,
+	TEXT("If the port is taken, try this many following ports before giving up (0 = requested port only). Read at startup."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarFleetHeartbeatSeconds(
+	TEXT("UnrealPythonREST.FleetHeartbeatSeconds"),
+	5.0f,
+	TEXT("Seconds between refreshes of this instance's fleet registry entry (0 = do not register). Read at startup."),
+	ECVF_Default);
 
-	if (!Router->Start())
+/** First free port in [Requested, Requested + PortFallbackCount], or Requested if none is free */
+static int32 ChooseListenPort(int32 Requested)
+{
+	const int32 Fallbacks = FMath::Max(0, CVarPortFallbackCount.GetValueOnGameThread());
+	for (int32 Offset = 0; Offset <= Fallbacks && Requested + Offset <= 65535; ++Offset)
 	{
-		UE_LOG(LogUnrealPythonREST, Error, TEXT("Failed to start REST server"));
-		return;
+		const int32 Candidate = Requested + Offset;
+		if (FRESTRouter::IsPortAvailable(Candidate))
+		{
+			if (Offset > 0)
+			{
+				UE_LOG(LogUnrealPythonREST, Warning, TEXT("Port %d is in use, falling back to %d"), Requested, Candidate);
+			}
+			return Candidate;
+		}
 	}
 
+	UE_LOG(LogUnrealPythonREST, Warning, TEXT("No free port in %d-%d"), Requested, Requested + Fallbacks);
+	return Requested;
+}
+
+static FAutoConsoleCommand BenchmarkDispatchCommand(
+	TEXT("UnrealPythonREST.BenchmarkDispatch"),
+	TEXT("Time REST route lookup across all registered routes. Usage: UnrealPythonREST.BenchmarkDispatch [Iterations=10000]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (!FUnrealPythonRESTModule::IsAvailable())
+		{
+			return;
+		}
+
+		TSharedPtr<FRESTRouter> Router = FUnrealPythonRESTModule::Get().GetRouter();
+		if (!Router.IsValid() || !Router->IsRunning())
+		{
+			UE_LOG(LogUnrealPythonREST, Warning, TEXT("REST server is not running"));
+			return;
+		}
+
+		const int32 Iterations = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10000;
+		Router->BenchmarkDispatch(Iterations);
+	}));
+
+static FAutoConsoleCommand BenchmarkGenerateCommand(
+	TEXT("UnrealPythonREST.Benchmark.Generate"),
+	TEXT("Fill the open level with synthetic benchmark content. Usage: UnrealPythonREST.Benchmark.Generate [actors=1000] [asset_folders=10] [assets_per_folder=100] [material_nodes=500] [blueprint_nodes=500] [seed=1] [save=0]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FBenchmarkContentOptions Options = FBenchmarkContentOptions::FromString(FString::Join(Args, TEXT(" ")));
+
+		FBenchmarkContentResult Result;
+		FString Error;
+		if (!FBenchmarkContent::Generate(ActorUtils::GetEditorWorld(), Options, Result, Error))
+		{
+			UE_LOG(LogUnrealPythonREST, Error, TEXT("Benchmark content generation failed: %s"), *Error);
+		}
+	}));
+
+static FAutoConsoleCommand BenchmarkClearCommand(
+	TEXT("UnrealPythonREST.Benchmark.Clear"),
+	TEXT("Remove the actors UnrealPythonREST.Benchmark.Generate spawned in the open level"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		const int32 Removed = FBenchmarkContent::ClearActors(ActorUtils::GetEditorWorld());
+		UE_LOG(LogUnrealPythonREST, Log, TEXT("Removed %d benchmark actors"), Removed);
+	}));
+
+void FUnrealPythonRESTModule::StartupModule()
+{
+	StartupCycles = FPlatformTime::Cycles64();
+
+	// Only /health, /schema and /metrics are served until CompleteStartup() runs
+	Router = MakeShared<FRESTRouter>();
+	Router->SetReady(false);
+
 	// Register Infrastructure handler first (provides /health, /schema)
 	TSharedPtr<FInfrastructureHandler> InfraHandler = MakeShared<FInfrastructureHandler>();
+	InfrastructureHandler = InfraHandler;
 	RegisterHandler(InfraHandler);
 
 	// Register Assets handler (provides /assets/*)
@@ -60,19 +160,104 @@ void FUnrealPythonRESTModule::StartupModule()
 	TSharedPtr<FBlueprintsHandler> BlueprintsHandler = MakeShared<FBlueprintsHandler>();
 	RegisterHandler(BlueprintsHandler);
 
-	// Write discovery config file for clients
+	// Routes are complete before the listener starts: worker-thread routes read the table unlocked
+	int32 RequestedPort = CVarPort.GetValueOnGameThread();
+	FParse::Value(FCommandLine::Get(), TEXT("RESTPort="), RequestedPort);
+
+	if (!Router->Start(ChooseListenPort(RequestedPort)))
+	{
+		UE_LOG(LogUnrealPythonREST, Error, TEXT("Failed to start REST server"));
+		return;
+	}
+
+	FRESTRouter::FStartupInfo& Startup = Router->GetStartupInfo();
+	Startup.RequestedPort = RequestedPort;
+	Startup.ListenSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartupCycles);
+
+	// Clients can find the port and poll /health while the rest of startup runs
 	if (!FConfigWriter::WriteConfig(*Router))
 	{
 		UE_LOG(LogUnrealPythonREST, Warning, TEXT("Failed to write discovery config file"));
 	}
 
-	UE_LOG(LogUnrealPythonREST, Log, TEXT("UnrealPythonREST started on port %d"), Router->GetPort());
+	// Fleet clients see this instance (not yet ready) and its load from here on
+	const float HeartbeatSeconds = CVarFleetHeartbeatSeconds.GetValueOnGameThread();
+	if (HeartbeatSeconds > 0.0f)
+	{
+		FConfigWriter::WriteRegistryEntry(*Router);
+		HeartbeatTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float)
+		{
+			FConfigWriter::WriteRegistryEntry(*Router);
+			return true;
+		}), HeartbeatSeconds);
+	}
+
+	UE_LOG(LogUnrealPythonREST, Log, TEXT("UnrealPythonREST listening on port %d after %.1f ms"),
+		Router->GetPort(), Startup.ListenSeconds * 1000.0);
+
+	// The first core tick is after engine init, so subsystems and the editor world exist by then
+	StartupTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float)
+	{
+		StartupTickHandle.Reset();
+		CompleteStartup();
+		return false;
+	}));
+}
+
+void FUnrealPythonRESTModule::CompleteStartup()
+{
+	// Start counting editor changes before any versioned route can be hit
+	FEditorChangeTracker::Initialize();
+	FActorIndex::Initialize();
+	FActorSpatialIndex::Initialize();
+	FAssetSearchIndex::Initialize();
+	FEditorEventFeed::Initialize();
+	FMaterialGraphIndex::Initialize();
+	FBlueprintSessionCache::Initialize();
+	FBlueprintCompileQueue::Initialize();
+	FViewportCapture::Initialize();
+	FAssetBulkInspector::Initialize();
+
+	// Every handler is in; build /schema once instead of on the first agent session
+	if (TSharedPtr<FInfrastructureHandler> InfraHandler = InfrastructureHandler.Pin())
+	{
+		InfraHandler->PrewarmSchema();
+	}
+
+	FRESTRouter::FStartupInfo& Startup = Router->GetStartupInfo();
+	Startup.ReadySeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartupCycles);
+	Router->SetReady(true);
+	bStartupComplete = true;
+
+	if (!FConfigWriter::WriteConfig(*Router))
+	{
+		UE_LOG(LogUnrealPythonREST, Warning, TEXT("Failed to write discovery config file"));
+	}
+	if (HeartbeatTickHandle.IsValid())
+	{
+		FConfigWriter::WriteRegistryEntry(*Router);
+	}
+
+	UE_LOG(LogUnrealPythonREST, Log, TEXT("UnrealPythonREST started on port %d (listening after %.1f ms, ready after %.1f ms)"),
+		Router->GetPort(), Startup.ListenSeconds * 1000.0, Startup.ReadySeconds * 1000.0);
 }
 
 void FUnrealPythonRESTModule::ShutdownModule()
 {
-	// Delete discovery config file
+	if (StartupTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(StartupTickHandle);
+		StartupTickHandle.Reset();
+	}
+
+	// Delete discovery config file and leave the fleet registry
 	FConfigWriter::DeleteConfig();
+	if (HeartbeatTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(HeartbeatTickHandle);
+		HeartbeatTickHandle.Reset();
+		FConfigWriter::DeleteRegistryEntry();
+	}
 
 	// Shutdown all handlers
 	for (const TSharedPtr<IRESTHandler>& Handler : Handlers)
@@ -84,6 +269,9 @@ void FUnrealPythonRESTModule::ShutdownModule()
 	}
 	Handlers.Empty();
 
+	// Open long polls hold responders that call back into the router, so answer them first
+	FEditorEventFeed::Shutdown();
+
 	// Stop the router
 	if (Router.IsValid())
 	{
@@ -91,6 +279,23 @@ void FUnrealPythonRESTModule::ShutdownModule()
 		Router.Reset();
 	}
 
+	FMaterialGraphDiff::Reset();
+
+	// Utilities are started by CompleteStartup(), which never ran if the module unloads before its first tick
+	if (bStartupComplete)
+	{
+		FAssetBulkInspector::Shutdown();
+		FViewportCapture::Shutdown();
+		FBlueprintCompileQueue::Shutdown();
+		FBlueprintSessionCache::Shutdown();
+		FMaterialGraphIndex::Shutdown();
+		FAssetSearchIndex::Shutdown();
+		FActorSpatialIndex::Shutdown();
+		FActorIndex::Shutdown();
+		FEditorChangeTracker::Shutdown();
+		bStartupComplete = false;
+	}
+
 	UE_LOG(LogUnrealPythonREST, Log, TEXT("UnrealPythonREST shutdown complete"));
 }
 
@@ -0,0 +1,344 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Utils/ActorIndex.h"
+#include "Utils/ActorUtils.h"
+#include "Utils/JsonHelpers.h"
+#include "Editor.h"
+#include "EngineUtils.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/ObjectKey.h"
+
+namespace
+{
+	using FActorList = TArray<TWeakObjectPtr<AActor>, TInlineAllocator<1>>;
+
+	struct FIndexState
+	{
+		TWeakObjectPtr<UWorld> World;
+		bool bValid = false;
+
+		/** Label -> actors with that label, in indexing order (FString keys hash and compare case-insensitively) */
+		TMap<FString, FActorList> ByLabel;
+		TMap<FName, FActorList> ByName;
+		TMap<FGuid, TWeakObjectPtr<AActor>> ByGuid;
+
+		/** Label each actor was indexed under, so a relabel can remove the old entry */
+		TMap<FObjectKey, FString> IndexedLabels;
+
+		/** Every label ever indexed since the last rebuild; removed labels are filtered on lookup */
+		JsonHelpers::FStringBKTree LabelTree;
+	};
+
+	struct FIndexHandles
+	{
+		FDelegateHandle ActorAdded;
+		FDelegateHandle ActorDeleted;
+		FDelegateHandle ActorLabelChanged;
+		FDelegateHandle MapChange;
+		FDelegateHandle MapOpened;
+		FDelegateHandle PostUndoRedo;
+		FDelegateHandle LevelAdded;
+		FDelegateHandle LevelRemoved;
+	};
+
+	FIndexState State;
+	FIndexHandles Handles;
+	bool bInitialized = false;
+
+	void RemoveFromList(FActorList& List, const AActor* Actor)
+	{
+		List.RemoveAll([Actor](const TWeakObjectPtr<AActor>& Entry)
+		{
+			return !Entry.IsValid() || Entry.Get() == Actor;
+		});
+	}
+
+	void IndexActor(AActor* Actor)
+	{
+		const FString Label = Actor->GetActorLabel();
+
+		State.ByLabel.FindOrAdd(Label).Add(Actor);
+		State.ByName.FindOrAdd(Actor->GetFName()).Add(Actor);
+
+		const FGuid Guid = Actor->GetActorGuid();
+		if (Guid.IsValid())
+		{
+			State.ByGuid.Add(Guid, Actor);
+		}
+
+		State.IndexedLabels.Add(FObjectKey(Actor), Label);
+
+		if (!Label.IsEmpty())
+		{
+			State.LabelTree.Add(Label);
+		}
+	}
+
+	void UnindexActor(AActor* Actor)
+	{
+		FString Label;
+		if (!State.IndexedLabels.RemoveAndCopyValue(FObjectKey(Actor), Label))
+		{
+			return;
+		}
+
+		if (FActorList* List = State.ByLabel.Find(Label))
+		{
+			RemoveFromList(*List, Actor);
+			if (List->Num() == 0)
+			{
+				State.ByLabel.Remove(Label);
+			}
+		}
+
+		if (FActorList* List = State.ByName.Find(Actor->GetFName()))
+		{
+			RemoveFromList(*List, Actor);
+			if (List->Num() == 0)
+			{
+				State.ByName.Remove(Actor->GetFName());
+			}
+		}
+
+		State.ByGuid.Remove(Actor->GetActorGuid());
+	}
+
+	bool IsIndexedWorld(const AActor* Actor)
+	{
+		return State.bValid && Actor && Actor->GetWorld() == State.World.Get();
+	}
+
+	void Rebuild(UWorld* World)
+	{
+		State = FIndexState();
+		State.World = World;
+		State.bValid = World != nullptr;
+
+		if (!World)
+		{
+			return;
+		}
+
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			if (AActor* Actor = *It)
+			{
+				IndexActor(Actor);
+			}
+		}
+
+		UE_LOG(LogTemp, Verbose, TEXT("ActorIndex: Indexed %d actors"), State.IndexedLabels.Num());
+	}
+
+	/** Rebuild if the editor world changed or the index was dropped */
+	void EnsureCurrent()
+	{
+		UWorld* World = ActorUtils::GetEditorWorld();
+		if (!State.bValid || State.World.Get() != World)
+		{
+			Rebuild(World);
+		}
+	}
+
+	/** First live actor in List that passes Matches; nullptr if none, with bOutStale set when an entry no longer matched */
+	template <typename PredicateType>
+	AActor* FirstMatch(const FActorList* List, PredicateType Matches, bool& bOutStale)
+	{
+		if (!List)
+		{
+			return nullptr;
+		}
+
+		for (const TWeakObjectPtr<AActor>& Entry : *List)
+		{
+			AActor* Actor = Entry.Get();
+			if (Actor && IsValid(Actor) && Matches(Actor))
+			{
+				return Actor;
+			}
+			bOutStale = true;
+		}
+		return nullptr;
+	}
+
+	AActor* FindInIndex(const FString& Key, bool& bOutStale)
+	{
+		// First: actor label (display name)
+		if (AActor* Actor = FirstMatch(State.ByLabel.Find(Key), [&Key](AActor* Candidate) { return Candidate->GetActorLabel() == Key; }, bOutStale))
+		{
+			return Actor;
+		}
+
+		// Second: actor name (internal unique name). No FName entry means no actor can have it.
+		const FName Name(*Key, FNAME_Find);
+		if (!Name.IsNone())
+		{
+			if (AActor* Actor = FirstMatch(State.ByName.Find(Name), [Name](AActor* Candidate) { return Candidate->GetFName() == Name; }, bOutStale))
+			{
+				return Actor;
+			}
+		}
+
+		// Third: actor GUID
+		FGuid Guid;
+		if (FGuid::Parse(Key, Guid))
+		{
+			if (const TWeakObjectPtr<AActor>* Entry = State.ByGuid.Find(Guid))
+			{
+				AActor* Actor = Entry->Get();
+				if (Actor && IsValid(Actor) && Actor->GetActorGuid() == Guid)
+				{
+					return Actor;
+				}
+				bOutStale = true;
+			}
+		}
+
+		return nullptr;
+	}
+}
+
+void FActorIndex::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	if (GEngine)
+	{
+		Handles.ActorAdded = GEngine->OnLevelActorAdded().AddLambda([](AActor* Actor)
+		{
+			if (IsIndexedWorld(Actor))
+			{
+				UnindexActor(Actor);
+				IndexActor(Actor);
+			}
+		});
+
+		Handles.ActorDeleted = GEngine->OnLevelActorDeleted().AddLambda([](AActor* Actor)
+		{
+			if (IsIndexedWorld(Actor))
+			{
+				UnindexActor(Actor);
+			}
+		});
+	}
+
+	Handles.ActorLabelChanged = FCoreDelegates::OnActorLabelChanged.AddLambda([](AActor* Actor)
+	{
+		if (IsIndexedWorld(Actor))
+		{
+			UnindexActor(Actor);
+			IndexActor(Actor);
+		}
+	});
+
+	Handles.MapChange = FEditorDelegates::MapChange.AddLambda([](uint32) { Invalidate(); });
+	Handles.MapOpened = FEditorDelegates::OnMapOpened.AddLambda([](const FString&, bool) { Invalidate(); });
+	Handles.PostUndoRedo = FEditorDelegates::PostUndoRedo.AddLambda([]() { Invalidate(); });
+	Handles.LevelAdded = FWorldDelegates::LevelAddedToWorld.AddLambda([](ULevel*, UWorld*) { Invalidate(); });
+	Handles.LevelRemoved = FWorldDelegates::LevelRemovedFromWorld.AddLambda([](ULevel*, UWorld*) { Invalidate(); });
+}
+
+void FActorIndex::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(Handles.ActorAdded);
+		GEngine->OnLevelActorDeleted().Remove(Handles.ActorDeleted);
+	}
+
+	FCoreDelegates::OnActorLabelChanged.Remove(Handles.ActorLabelChanged);
+	FEditorDelegates::MapChange.Remove(Handles.MapChange);
+	FEditorDelegates::OnMapOpened.Remove(Handles.MapOpened);
+	FEditorDelegates::PostUndoRedo.Remove(Handles.PostUndoRedo);
+	FWorldDelegates::LevelAddedToWorld.Remove(Handles.LevelAdded);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(Handles.LevelRemoved);
+
+	Handles = FIndexHandles();
+	State = FIndexState();
+}
+
+AActor* FActorIndex::Find(const FString& LabelNameOrGuid)
+{
+	check(IsInGameThread());
+
+	EnsureCurrent();
+	if (!State.bValid)
+	{
+		return nullptr;
+	}
+
+	bool bStale = false;
+	AActor* Actor = FindInIndex(LabelNameOrGuid, bStale);
+
+	// An entry no longer matched its actor, so some change went unreported; rebuild and look again
+	if (!Actor && bStale)
+	{
+		Rebuild(State.World.Get());
+		bStale = false;
+		Actor = FindInIndex(LabelNameOrGuid, bStale);
+	}
+
+	return Actor;
+}
+
+TArray<FString> FActorIndex::GetAllLabels()
+{
+	check(IsInGameThread());
+
+	EnsureCurrent();
+
+	TArray<FString> Labels;
+	Labels.Reserve(State.ByLabel.Num());
+	for (const TPair<FString, FActorList>& Pair : State.ByLabel)
+	{
+		if (!Pair.Key.IsEmpty())
+		{
+			Labels.Add(Pair.Key);
+		}
+	}
+	return Labels;
+}
+
+TArray<FString> FActorIndex::FindSimilarLabels(const FString& Label, int32 MaxResults, int32 MaxDistance)
+{
+	check(IsInGameThread());
+
+	EnsureCurrent();
+
+	// Removed labels stay in the tree until the next rebuild; rebuild once they outnumber live ones
+	if (State.LabelTree.Num() > 2 * State.ByLabel.Num() + 64)
+	{
+		Rebuild(State.World.Get());
+	}
+
+	// Ask for a few extra to cover labels that have since been removed
+	TArray<FString> Similar = State.LabelTree.FindSimilar(Label, MaxResults + 8, MaxDistance);
+	Similar.RemoveAll([](const FString& Candidate)
+	{
+		return !State.ByLabel.Contains(Candidate);
+	});
+
+	if (Similar.Num() > MaxResults)
+	{
+		Similar.SetNum(MaxResults);
+	}
+	return Similar;
+}
+
+void FActorIndex::Invalidate()
+{
+	State.bValid = false;
+}
@@ -0,0 +1,476 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Utils/ActorSpatialIndex.h"
+#include "Utils/ActorUtils.h"
+#include "Editor.h"
+#include "EngineDefines.h"
+#include "EngineUtils.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
+#include "Math/GenericOctree.h"
+#include "SceneManagement.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	struct FActorBoundsElement
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FObjectKey Key;
+		FBox Bounds;
+	};
+
+	struct FTrackedActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FOctreeElementId2 ElementId;
+		TWeakObjectPtr<USceneComponent> Root;
+		FDelegateHandle TransformHandle;
+	};
+
+	/** Actors tracked by the octree, keyed by actor; also receives element ids as the octree reorganizes */
+	TMap<FObjectKey, FTrackedActor> Tracked;
+
+	struct FActorBoundsSemantics
+	{
+		enum { MaxElementsPerLeaf = 16 };
+		enum { MinInclusiveElementsPerNode = 7 };
+		enum { MaxNodeDepth = 12 };
+
+		typedef TInlineAllocator<MaxElementsPerLeaf> ElementAllocator;
+
+		FORCEINLINE static FBoxCenterAndExtent GetBoundingBox(const FActorBoundsElement& Element)
+		{
+			return FBoxCenterAndExtent(Element.Bounds);
+		}
+
+		FORCEINLINE static bool AreElementsEqual(const FActorBoundsElement& A, const FActorBoundsElement& B)
+		{
+			return A.Key == B.Key;
+		}
+
+		FORCEINLINE static void SetElementId(const FActorBoundsElement& Element, FOctreeElementId2 Id)
+		{
+			if (FTrackedActor* Entry = Tracked.Find(Element.Key))
+			{
+				Entry->ElementId = Id;
+			}
+		}
+	};
+
+	using FActorOctree = TOctree2<FActorBoundsElement, FActorBoundsSemantics>;
+
+	struct FIndexHandles
+	{
+		FDelegateHandle ActorAdded;
+		FDelegateHandle ActorDeleted;
+		FDelegateHandle ActorMoved;
+		FDelegateHandle MapChange;
+		FDelegateHandle MapOpened;
+		FDelegateHandle PostUndoRedo;
+		FDelegateHandle LevelAdded;
+		FDelegateHandle LevelRemoved;
+		FDelegateHandle PropertyChanged;
+		FDelegateHandle ObjectsReplaced;
+	};
+
+	TUniquePtr<FActorOctree> Octree;
+	TWeakObjectPtr<UWorld> IndexedWorld;
+	bool bValid = false;
+
+	/** Actors whose bounds changed since the last query */
+	TSet<FObjectKey> DirtyActors;
+
+	FIndexHandles Handles;
+	bool bInitialized = false;
+
+	FBox GetActorBounds(const AActor* Actor)
+	{
+		// Non-colliding components count too; actors with nothing to bound (lights, volumes without shape) are a point
+		const FBox Bounds = Actor->GetComponentsBoundingBox(true);
+		if (Bounds.IsValid)
+		{
+			return Bounds;
+		}
+		const FVector Location = Actor->GetActorLocation();
+		return FBox(Location, Location);
+	}
+
+	bool IsIndexedWorld(const AActor* Actor)
+	{
+		return bValid && Actor && Actor->GetWorld() == IndexedWorld.Get();
+	}
+
+	void MarkDirty(const AActor* Actor)
+	{
+		if (IsIndexedWorld(Actor))
+		{
+			DirtyActors.Add(FObjectKey(Actor));
+		}
+	}
+
+	void RemoveActor(FObjectKey Key)
+	{
+		FTrackedActor Entry;
+		if (!Tracked.RemoveAndCopyValue(Key, Entry))
+		{
+			return;
+		}
+
+		if (USceneComponent* Root = Entry.Root.Get())
+		{
+			Root->TransformUpdated.Remove(Entry.TransformHandle);
+		}
+
+		if (Octree.IsValid() && Octree->IsValidElementId(Entry.ElementId))
+		{
+			Octree->RemoveElement(Entry.ElementId);
+		}
+	}
+
+	void AddActor(AActor* Actor)
+	{
+		const FObjectKey Key(Actor);
+		RemoveActor(Key);
+
+		if (!IsValid(Actor) || !Actor->GetRootComponent())
+		{
+			return;
+		}
+
+		FTrackedActor& Entry = Tracked.Add(Key);
+		Entry.Actor = Actor;
+		Entry.Root = Actor->GetRootComponent();
+		Entry.TransformHandle = Entry.Root->TransformUpdated.AddLambda([Key](USceneComponent*, EUpdateTransformFlags, ETeleportType)
+		{
+			DirtyActors.Add(Key);
+		});
+
+		// SetElementId fills in Entry.ElementId
+		Octree->AddElement({ Actor, Key, GetActorBounds(Actor) });
+	}
+
+	void Reset()
+	{
+		for (TPair<FObjectKey, FTrackedActor>& Pair : Tracked)
+		{
+			if (USceneComponent* Root = Pair.Value.Root.Get())
+			{
+				Root->TransformUpdated.Remove(Pair.Value.TransformHandle);
+			}
+		}
+		Tracked.Empty();
+		DirtyActors.Empty();
+		Octree.Reset();
+		IndexedWorld.Reset();
+		bValid = false;
+	}
+
+	void Rebuild(UWorld* World)
+	{
+		Reset();
+
+		if (!World)
+		{
+			return;
+		}
+
+		IndexedWorld = World;
+		bValid = true;
+		Octree = MakeUnique<FActorOctree>(FVector::ZeroVector, HALF_WORLD_MAX);
+
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			if (AActor* Actor = *It)
+			{
+				AddActor(Actor);
+			}
+		}
+
+		UE_LOG(LogTemp, Verbose, TEXT("ActorSpatialIndex: Indexed %d actors"), Tracked.Num());
+	}
+
+	/** Rebuild if the world changed; re-insert actors that moved */
+	void EnsureCurrent()
+	{
+		UWorld* World = ActorUtils::GetEditorWorld();
+		if (!bValid || IndexedWorld.Get() != World)
+		{
+			Rebuild(World);
+			return;
+		}
+
+		if (DirtyActors.Num() == 0)
+		{
+			return;
+		}
+
+		TSet<FObjectKey> Dirty = MoveTemp(DirtyActors);
+		DirtyActors.Reset();
+		for (const FObjectKey& Key : Dirty)
+		{
+			// Untracked keys are reinstanced actors taking over from the ones they replaced
+			const FTrackedActor* Entry = Tracked.Find(Key);
+			AActor* Actor = Entry ? Entry->Actor.Get() : Cast<AActor>(Key.ResolveObjectPtr());
+			if (IsIndexedWorld(Actor))
+			{
+				AddActor(Actor);
+			}
+			else
+			{
+				RemoveActor(Key);
+			}
+		}
+	}
+
+	/** Slab test; OutEntry is the distance from Start where the segment enters Box (0 if Start is inside) */
+	bool SegmentEntersBox(const FBox& Box, const FVector& Start, const FVector& Direction, double Length, double& OutEntry)
+	{
+		double Near = 0.0;
+		double Far = Length;
+
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			if (FMath::IsNearlyZero(Direction[Axis]))
+			{
+				if (Start[Axis] < Box.Min[Axis] || Start[Axis] > Box.Max[Axis])
+				{
+					return false;
+				}
+				continue;
+			}
+
+			double T0 = (Box.Min[Axis] - Start[Axis]) / Direction[Axis];
+			double T1 = (Box.Max[Axis] - Start[Axis]) / Direction[Axis];
+			if (T0 > T1)
+			{
+				Swap(T0, T1);
+			}
+
+			Near = FMath::Max(Near, T0);
+			Far = FMath::Min(Far, T1);
+			if (Near > Far)
+			{
+				return false;
+			}
+		}
+
+		OutEntry = Near;
+		return true;
+	}
+}
+
+void FActorSpatialIndex::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	if (GEngine)
+	{
+		Handles.ActorAdded = GEngine->OnLevelActorAdded().AddLambda([](AActor* Actor)
+		{
+			if (IsIndexedWorld(Actor))
+			{
+				AddActor(Actor);
+
+				// Refresh the bounds at the next query, once spawning has settled the transform and components
+				DirtyActors.Add(FObjectKey(Actor));
+			}
+		});
+
+		Handles.ActorDeleted = GEngine->OnLevelActorDeleted().AddLambda([](AActor* Actor)
+		{
+			if (IsIndexedWorld(Actor))
+			{
+				RemoveActor(FObjectKey(Actor));
+				DirtyActors.Remove(FObjectKey(Actor));
+			}
+		});
+
+		// Gizmo and details-panel moves; also covers actors whose root hook went stale between queries
+		Handles.ActorMoved = GEngine->OnActorMoved().AddLambda([](AActor* Actor) { MarkDirty(Actor); });
+	}
+
+	// Mesh, scale or component edits from the details panel change bounds without a transform update
+	Handles.PropertyChanged = FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda([](UObject* Object, FPropertyChangedEvent&)
+	{
+		if (const AActor* Actor = Cast<AActor>(Object))
+		{
+			MarkDirty(Actor);
+		}
+		else if (const UActorComponent* Component = Cast<UActorComponent>(Object))
+		{
+			MarkDirty(Component->GetOwner());
+		}
+	});
+
+	// Blueprint reinstancing swaps actors and their components for new objects, roots included
+	Handles.ObjectsReplaced = FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([](const TMap<UObject*, UObject*>& Replaced)
+	{
+		for (const TPair<UObject*, UObject*>& Pair : Replaced)
+		{
+			if (Cast<AActor>(Pair.Key))
+			{
+				RemoveActor(FObjectKey(Pair.Key));
+				MarkDirty(Cast<AActor>(Pair.Value));
+			}
+			else if (const USceneComponent* Component = Cast<USceneComponent>(Pair.Value))
+			{
+				MarkDirty(Component->GetOwner());
+			}
+		}
+	});
+
+	Handles.MapChange = FEditorDelegates::MapChange.AddLambda([](uint32) { Invalidate(); });
+	Handles.MapOpened = FEditorDelegates::OnMapOpened.AddLambda([](const FString&, bool) { Invalidate(); });
+	Handles.PostUndoRedo = FEditorDelegates::PostUndoRedo.AddLambda([]() { Invalidate(); });
+	Handles.LevelAdded = FWorldDelegates::LevelAddedToWorld.AddLambda([](ULevel*, UWorld*) { Invalidate(); });
+	Handles.LevelRemoved = FWorldDelegates::LevelRemovedFromWorld.AddLambda([](ULevel*, UWorld*) { Invalidate(); });
+}
+
+void FActorSpatialIndex::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(Handles.ActorAdded);
+		GEngine->OnLevelActorDeleted().Remove(Handles.ActorDeleted);
+		GEngine->OnActorMoved().Remove(Handles.ActorMoved);
+	}
+
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(Handles.PropertyChanged);
+	FCoreUObjectDelegates::OnObjectsReplaced.Remove(Handles.ObjectsReplaced);
+	FEditorDelegates::MapChange.Remove(Handles.MapChange);
+	FEditorDelegates::OnMapOpened.Remove(Handles.MapOpened);
+	FEditorDelegates::PostUndoRedo.Remove(Handles.PostUndoRedo);
+	FWorldDelegates::LevelAddedToWorld.Remove(Handles.LevelAdded);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(Handles.LevelRemoved);
+
+	Handles = FIndexHandles();
+	Reset();
+}
+
+TArray<FActorSpatialHit> FActorSpatialIndex::Query(const FActorSpatialQuery& InQuery)
+{
+	check(IsInGameThread());
+
+	TArray<FActorSpatialHit> Hits;
+
+	EnsureCurrent();
+	if (!bValid || !Octree.IsValid())
+	{
+		return Hits;
+	}
+
+	auto AddHit = [&Hits](const FActorBoundsElement& Element, double RayDistance)
+	{
+		AActor* Actor = Element.Actor.Get();
+		if (Actor && IsValid(Actor))
+		{
+			Hits.Add({ Actor, Element.Bounds, RayDistance });
+		}
+	};
+
+	switch (InQuery.Shape)
+	{
+	case EActorSpatialShape::Box:
+	{
+		Octree->FindElementsWithBoundsTest(FBoxCenterAndExtent(InQuery.Box), [&AddHit](const FActorBoundsElement& Element)
+		{
+			AddHit(Element, 0.0);
+		});
+		break;
+	}
+
+	case EActorSpatialShape::Sphere:
+	{
+		const FBox SphereBox = FBox::BuildAABB(InQuery.Center, FVector(InQuery.Radius));
+		const double RadiusSquared = FMath::Square(InQuery.Radius);
+		Octree->FindElementsWithBoundsTest(FBoxCenterAndExtent(SphereBox), [&AddHit, &InQuery, RadiusSquared](const FActorBoundsElement& Element)
+		{
+			if (FMath::SphereAABBIntersection(InQuery.Center, RadiusSquared, Element.Bounds))
+			{
+				AddHit(Element, 0.0);
+			}
+		});
+		break;
+	}
+
+	case EActorSpatialShape::Ray:
+	{
+		const FVector Segment = InQuery.RayEnd - InQuery.RayStart;
+		const double Length = Segment.Size();
+		const FVector Direction = Length > UE_KINDA_SMALL_NUMBER ? Segment / Length : FVector::ForwardVector;
+
+		Octree->FindElementsWithPredicate(
+			[&InQuery, &Direction, Length](FOctreeNodeIndex, FOctreeNodeIndex, const FBoxCenterAndExtent& NodeBounds)
+			{
+				double Entry = 0.0;
+				return SegmentEntersBox(NodeBounds.GetBox(), InQuery.RayStart, Direction, Length, Entry);
+			},
+			[&AddHit, &InQuery, &Direction, Length](FOctreeNodeIndex, const FActorBoundsElement& Element)
+			{
+				double Entry = 0.0;
+				if (SegmentEntersBox(Element.Bounds, InQuery.RayStart, Direction, Length, Entry))
+				{
+					AddHit(Element, Entry);
+				}
+			});
+		break;
+	}
+
+	case EActorSpatialShape::Frustum:
+	{
+		Octree->FindElementsWithPredicate(
+			[&InQuery](FOctreeNodeIndex, FOctreeNodeIndex, const FBoxCenterAndExtent& NodeBounds)
+			{
+				return InQuery.Frustum.IntersectBox(FVector(NodeBounds.Center), FVector(NodeBounds.Extent));
+			},
+			[&AddHit, &InQuery](FOctreeNodeIndex, const FActorBoundsElement& Element)
+			{
+				if (InQuery.Frustum.IntersectBox(Element.Bounds.GetCenter(), Element.Bounds.GetExtent()))
+				{
+					AddHit(Element, 0.0);
+				}
+			});
+		break;
+	}
+	}
+
+	return Hits;
+}
+
+void FActorSpatialIndex::Invalidate()
+{
+	bValid = false;
+}
+
+FConvexVolume FActorSpatialIndex::MakeFrustum(const FVector& Location, const FRotator& Rotation, float FovDegrees, float AspectRatio, float NearClip, float FarClip)
+{
+	// Same basis change the engine uses for scene views: UE X-forward/Z-up to view Z-forward/Y-up
+	const FMatrix ViewMatrix = FTranslationMatrix(-Location)
+		* FInverseRotationMatrix(Rotation)
+		* FMatrix(
+			FPlane(0, 0, 1, 0),
+			FPlane(1, 0, 0, 0),
+			FPlane(0, 1, 0, 0),
+			FPlane(0, 0, 0, 1));
+
+	const float HalfFovRadians = FMath::DegreesToRadians(FMath::Clamp(FovDegrees, 1.0f, 170.0f)) * 0.5f;
+	const FMatrix ProjectionMatrix = FPerspectiveMatrix(HalfFovRadians, FMath::Max(AspectRatio, 0.01f), 1.0f, NearClip, FarClip);
+
+	FConvexVolume Frustum;
+	GetViewFrustumBounds(Frustum, ViewMatrix * ProjectionMatrix, true, true);
+	return Frustum;
+}
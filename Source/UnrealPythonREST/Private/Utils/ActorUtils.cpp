@@ -1,6 +1,7 @@
 // ActorUtils.cpp
 #include "Utils/ActorUtils.h"
 #include "Utils/JsonHelpers.h"
+#include "Utils/ActorIndex.h"
 #include "Editor.h"
 #include "EngineUtils.h"
 #include "Engine/World.h"
@@ -22,59 +23,17 @@ UWorld* GetEditorWorld()
 
 AActor* FindActorByLabel(const FString& Label)
 {
-	UWorld* World = GetEditorWorld();
-	if (!World)
-	{
-		return nullptr;
-	}
-
-	// First pass: try to find by actor label (display name)
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		AActor* Actor = *It;
-		if (Actor && Actor->GetActorLabel() == Label)
-		{
-			return Actor;
-		}
-	}
-
-	// Second pass: try to find by actor name (internal unique name)
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		AActor* Actor = *It;
-		if (Actor && Actor->GetName() == Label)
-		{
-			return Actor;
-		}
-	}
-
-	return nullptr;
+	return FActorIndex::Find(Label);
 }
 
 TArray<FString> GetAllActorLabels()
 {
-	TArray<FString> Labels;
-
-	UWorld* World = GetEditorWorld();
-	if (!World)
-	{
-		return Labels;
-	}
-
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		AActor* Actor = *It;
-		if (Actor)
-		{
-			FString Label = Actor->GetActorLabel();
-			if (!Label.IsEmpty())
-			{
-				Labels.Add(Label);
-			}
-		}
-	}
+	return FActorIndex::GetAllLabels();
+}
 
-	return Labels;
+TArray<FString> FindSimilarActorLabels(const FString& Label, int32 MaxResults)
+{
+	return FActorIndex::FindSimilarLabels(Label, MaxResults);
 }
 
 AActor* SpawnActorFromClass(const FString& ClassPath, const FTransform& Transform, FString& OutError)
@@ -141,7 +100,7 @@ bool RaycastToSurface(const FVector& StartLocation, float MaxDistance, FVector&
 	return false;
 }
 
-TSharedPtr<FJsonObject> ActorToDetailedJson(AActor* Actor)
+TSharedPtr<FJsonObject> ActorToDetailedJson(AActor* Actor, const FRESTFieldFilter& Fields)
 {
 	TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
 
@@ -151,30 +110,54 @@ TSharedPtr<FJsonObject> ActorToDetailedJson(AActor* Actor)
 	}
 
 	// Basic info
-	Json->SetStringField(TEXT("label"), Actor->GetActorLabel());
-	Json->SetStringField(TEXT("name"), Actor->GetName());
-	Json->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
-	Json->SetStringField(TEXT("path"), Actor->GetPathName());
+	if (Fields.Wants(TEXT("label")))
+	{
+		Json->SetStringField(TEXT("label"), Actor->GetActorLabel());
+	}
+	if (Fields.Wants(TEXT("name")))
+	{
+		Json->SetStringField(TEXT("name"), Actor->GetName());
+	}
+	if (Fields.Wants(TEXT("class")))
+	{
+		Json->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
+	}
+	if (Fields.Wants(TEXT("path")))
+	{
+		Json->SetStringField(TEXT("path"), Actor->GetPathName());
+	}
 
 	// Transform (all in centimeters/degrees)
-	Json->SetObjectField(TEXT("location"), JsonHelpers::VectorToJson(Actor->GetActorLocation()));
-	Json->SetObjectField(TEXT("rotation"), JsonHelpers::RotatorToJson(Actor->GetActorRotation()));
-	Json->SetObjectField(TEXT("scale"), JsonHelpers::VectorToJson(Actor->GetActorScale3D()));
+	if (Fields.Wants(TEXT("location")))
+	{
+		Json->SetObjectField(TEXT("location"), JsonHelpers::VectorToJson(Actor->GetActorLocation()));
+	}
+	if (Fields.Wants(TEXT("rotation")))
+	{
+		Json->SetObjectField(TEXT("rotation"), JsonHelpers::RotatorToJson(Actor->GetActorRotation()));
+	}
+	if (Fields.Wants(TEXT("scale")))
+	{
+		Json->SetObjectField(TEXT("scale"), JsonHelpers::VectorToJson(Actor->GetActorScale3D()));
+	}
 
-	// Bounds
-	FBox Bounds = Actor->GetComponentsBoundingBox();
-	if (Bounds.IsValid)
+	// Bounds (walks every component, so only when asked for)
+	if (Fields.Wants(TEXT("bounds")))
 	{
-		TSharedPtr<FJsonObject> BoundsJson = MakeShared<FJsonObject>();
-		BoundsJson->SetObjectField(TEXT("min"), JsonHelpers::VectorToJson(Bounds.Min));
-		BoundsJson->SetObjectField(TEXT("max"), JsonHelpers::VectorToJson(Bounds.Max));
-		BoundsJson->SetObjectField(TEXT("center"), JsonHelpers::VectorToJson(Bounds.GetCenter()));
-		BoundsJson->SetObjectField(TEXT("extent"), JsonHelpers::VectorToJson(Bounds.GetExtent()));
-		Json->SetObjectField(TEXT("bounds"), BoundsJson);
+		FBox Bounds = Actor->GetComponentsBoundingBox();
+		if (Bounds.IsValid)
+		{
+			TSharedPtr<FJsonObject> BoundsJson = MakeShared<FJsonObject>();
+			BoundsJson->SetObjectField(TEXT("min"), JsonHelpers::VectorToJson(Bounds.Min));
+			BoundsJson->SetObjectField(TEXT("max"), JsonHelpers::VectorToJson(Bounds.Max));
+			BoundsJson->SetObjectField(TEXT("center"), JsonHelpers::VectorToJson(Bounds.GetCenter()));
+			BoundsJson->SetObjectField(TEXT("extent"), JsonHelpers::VectorToJson(Bounds.GetExtent()));
+			Json->SetObjectField(TEXT("bounds"), BoundsJson);
+		}
 	}
 
 	// Tags
-	if (Actor->Tags.Num() > 0)
+	if (Actor->Tags.Num() > 0 && Fields.Wants(TEXT("tags")))
 	{
 		TArray<TSharedPtr<FJsonValue>> TagsArray;
 		for (const FName& Tag : Actor->Tags)
@@ -186,7 +169,7 @@ TSharedPtr<FJsonObject> ActorToDetailedJson(AActor* Actor)
 
 	// Mobility
 	USceneComponent* RootComponent = Actor->GetRootComponent();
-	if (RootComponent)
+	if (RootComponent && Fields.Wants(TEXT("mobility")))
 	{
 		FString Mobility;
 		switch (RootComponent->Mobility)
@@ -205,12 +188,18 @@ TSharedPtr<FJsonObject> ActorToDetailedJson(AActor* Actor)
 	}
 
 	// Visibility
-	Json->SetBoolField(TEXT("hidden"), Actor->IsHidden());
-	Json->SetBoolField(TEXT("editor_only"), Actor->IsEditorOnly());
+	if (Fields.Wants(TEXT("hidden")))
+	{
+		Json->SetBoolField(TEXT("hidden"), Actor->IsHidden());
+	}
+	if (Fields.Wants(TEXT("editor_only")))
+	{
+		Json->SetBoolField(TEXT("editor_only"), Actor->IsEditorOnly());
+	}
 
 	// Parent (if attached)
 	AActor* Parent = Actor->GetAttachParentActor();
-	if (Parent)
+	if (Parent && Fields.Wants(TEXT("parent_label")))
 	{
 		Json->SetStringField(TEXT("parent_label"), Parent->GetActorLabel());
 	}
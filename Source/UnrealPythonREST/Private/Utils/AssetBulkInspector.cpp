@@ -0,0 +1,729 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Utils/AssetBulkInspector.h"
+#include "Utils/EditorEventFeed.h"
+#include "Utils/JsonHelpers.h"
+#include "RESTJsonWriter.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StreamableManager.h"
+#include "Exporters/Exporter.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstance.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/ObjectKey.h"
+
+namespace
+{
+	using FJob = FAssetBulkInspector::FJob;
+	using FResult = FAssetBulkInspector::FResult;
+	using EOperation = FAssetBulkInspector::EOperation;
+	using ELoadPolicy = FAssetBulkInspector::ELoadPolicy;
+
+	/** Jobs loading at once; each already bounds its own loads */
+	constexpr int32 MaxRunningJobs = 4;
+
+	/** Finished jobs kept for GET /assets/bulk/{id} */
+	constexpr int32 MaxFinishedJobs = 16;
+
+	/** Game-thread time per tick for inspecting assets, so a large job never hitches the editor */
+	constexpr double TickBudgetSeconds = 0.008;
+
+	/** Progress events at most this often per job */
+	constexpr double ProgressIntervalSeconds = 0.5;
+
+	/** A job still loading */
+	struct FRunningJob
+	{
+		TSharedRef<FJob> Job;
+
+		/** (index, path) not answered from the registry, in path order */
+		TArray<TPair<int32, FSoftObjectPath>> Queue;
+		int32 NextQueued = 0;
+
+		/** Outstanding loads by path index */
+		TMap<int32, TSharedPtr<FStreamableHandle>> InFlight;
+
+		/** Parent materials already recompiled by this job, so N instances of one parent compile it once */
+		TSet<FObjectKey> Recompiled;
+
+		double LastProgressTime = 0.0;
+
+		explicit FRunningJob(TSharedRef<FJob> InJob) : Job(MoveTemp(InJob)) {}
+
+		bool IsDrained() const { return NextQueued >= Queue.Num() && InFlight.Num() == 0; }
+	};
+
+	TArray<TSharedRef<FRunningJob>> Running;
+
+	/** Oldest first */
+	TArray<TSharedRef<FJob>> Finished;
+
+	TUniquePtr<FStreamableManager> Streamable;
+	FTSTicker::FDelegateHandle Ticker;
+	bool bInitialized = false;
+
+	/** Loads since the last garbage collection request */
+	int32 LoadsSinceCollect = 0;
+
+	void AddResult(FRunningJob& Run, FResult&& Result)
+	{
+		if (!Result.ErrorCode.IsEmpty())
+		{
+			++Run.Job->Failed;
+		}
+		Run.Job->Results.Add(MoveTemp(Result));
+	}
+
+	FResult MakeError(int32 Index, const FSoftObjectPath& Path, const TCHAR* Source, const TCHAR* Code, const FString& Message)
+	{
+		FResult Result;
+		Result.Index = Index;
+		Result.Path = Path.ToString();
+		Result.Source = Source;
+		Result.ErrorCode = Code;
+		Result.ErrorMessage = Message;
+		return Result;
+	}
+
+	void RecompileMaterial(FRunningJob& Run, UObject* Asset, FResult& Result)
+	{
+		if (UMaterial* Material = Cast<UMaterial>(Asset))
+		{
+			Material->ForceRecompileForRendering();
+			Run.Recompiled.Add(FObjectKey(Material));
+
+			Result.Data = MakeShared<FJsonObject>();
+			Result.Data->SetStringField(TEXT("material_type"), TEXT("Material"));
+			return;
+		}
+
+		UMaterialInstance* Instance = Cast<UMaterialInstance>(Asset);
+		UMaterial* Parent = Instance ? Instance->GetMaterial() : nullptr;
+		if (!Parent)
+		{
+			Result.ErrorCode = TEXT("MATERIAL_NOT_FOUND");
+			Result.ErrorMessage = FString::Printf(TEXT("Not a material or material instance: %s"), *Result.Path);
+			return;
+		}
+
+		bool bAlreadyInSet = false;
+		Run.Recompiled.Add(FObjectKey(Parent), &bAlreadyInSet);
+		if (!bAlreadyInSet)
+		{
+			Parent->ForceRecompileForRendering();
+		}
+
+		Result.Data = MakeShared<FJsonObject>();
+		Result.Data->SetStringField(TEXT("material_type"), TEXT("MaterialInstance"));
+		Result.Data->SetStringField(TEXT("parent_material"), Parent->GetPathName());
+		Result.Data->SetBoolField(TEXT("parent_already_recompiled"), bAlreadyInSet);
+	}
+
+	/** Run the job's operation on a loaded asset */
+	void Inspect(FRunningJob& Run, int32 Index, const FSoftObjectPath& Path, UObject* Asset, const TCHAR* Source)
+	{
+		if (!Asset)
+		{
+			AddResult(Run, MakeError(Index, Path, Source, TEXT("ASSET_NOT_FOUND"), FString::Printf(TEXT("Asset not found: %s"), *Path.ToString())));
+			return;
+		}
+
+		FResult Result;
+		Result.Index = Index;
+		Result.Path = Path.ToString();
+		Result.Source = Source;
+
+		switch (Run.Job->Options.Operation)
+		{
+		case EOperation::MeshDetails:
+			if (UStaticMesh* Mesh = Cast<UStaticMesh>(Asset))
+			{
+				Result.Data = FAssetBulkInspector::MeshDetailsToJson(Mesh);
+			}
+			else
+			{
+				Result.ErrorCode = TEXT("NOT_A_STATIC_MESH");
+				Result.ErrorMessage = FString::Printf(TEXT("Not a static mesh: %s"), *Result.Path);
+			}
+			break;
+		case EOperation::Validate:
+			Result.Data = FAssetBulkInspector::ValidateToJson(Asset);
+			break;
+		case EOperation::Export:
+			Result.Data = FAssetBulkInspector::ExportToJson(Asset);
+			break;
+		case EOperation::RecompileMaterial:
+			RecompileMaterial(Run, Asset, Result);
+			break;
+		}
+
+		AddResult(Run, MoveTemp(Result));
+	}
+
+	/**
+	 * Answer Path from the registry if the operation and load policy allow it.
+	 * @return false if the asset has to be loaded
+	 */
+	bool TryAnswerFromRegistry(FRunningJob& Run, int32 Index, const FSoftObjectPath& Path, IAssetRegistry& AssetRegistry)
+	{
+		const FAssetBulkInspector::FOptions& Options = Run.Job->Options;
+		if (Options.Load == ELoadPolicy::Always)
+		{
+			return false;
+		}
+
+		const FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(Path);
+		if (!AssetData.IsValid())
+		{
+			if (Options.Load == ELoadPolicy::Never)
+			{
+				AddResult(Run, MakeError(Index, Path, TEXT("registry"), TEXT("ASSET_NOT_FOUND"), FString::Printf(TEXT("Asset not found: %s"), *Path.ToString())));
+				return true;
+			}
+			return false;
+		}
+
+		FResult Result;
+		Result.Index = Index;
+		Result.Path = Path.ToString();
+		Result.Source = TEXT("registry");
+
+		switch (Options.Operation)
+		{
+		case EOperation::MeshDetails:
+			// Other classes never need a load to be rejected
+			if (AssetData.AssetClassPath != UStaticMesh::StaticClass()->GetClassPathName())
+			{
+				Result.ErrorCode = TEXT("NOT_A_STATIC_MESH");
+				Result.ErrorMessage = FString::Printf(TEXT("Not a static mesh: %s"), *Result.Path);
+				break;
+			}
+			Result.Data = FAssetBulkInspector::MeshDetailsFromRegistry(AssetData);
+			if (!Result.Data.IsValid())
+			{
+				if (Options.Load != ELoadPolicy::Never)
+				{
+					return false;
+				}
+				Result.ErrorCode = TEXT("NEEDS_LOAD");
+				Result.ErrorMessage = TEXT("The asset registry has no mesh tags for this asset; resave it or use load=auto");
+			}
+			break;
+		case EOperation::Validate:
+			if (Options.Load != ELoadPolicy::Never)
+			{
+				return false;
+			}
+			Result.Data = MakeShared<FJsonObject>();
+			Result.Data->SetBoolField(TEXT("valid"), !AssetData.IsRedirector());
+			{
+				TArray<TSharedPtr<FJsonValue>> Errors;
+				if (AssetData.IsRedirector())
+				{
+					Errors.Add(MakeShared<FJsonValueString>(TEXT("Asset is a redirector")));
+				}
+				Result.Data->SetArrayField(TEXT("errors"), Errors);
+			}
+			Result.Data->SetStringField(TEXT("class"), AssetData.AssetClassPath.GetAssetName().ToString());
+			break;
+		case EOperation::Export:
+		case EOperation::RecompileMaterial:
+			if (Options.Load != ELoadPolicy::Never)
+			{
+				return false;
+			}
+			Result.ErrorCode = TEXT("NEEDS_LOAD");
+			Result.ErrorMessage = FString::Printf(TEXT("%s needs the asset loaded; use load=auto"), FAssetBulkInspector::GetOperationName(Options.Operation));
+			break;
+		}
+
+		++Run.Job->FromRegistry;
+		AddResult(Run, MoveTemp(Result));
+		return true;
+	}
+
+	void PostProgress(FRunningJob& Run, bool bForce)
+	{
+		const double Now = FPlatformTime::Seconds();
+		if (!bForce && Now - Run.LastProgressTime < ProgressIntervalSeconds)
+		{
+			return;
+		}
+		Run.LastProgressTime = Now;
+
+		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+		Data->SetStringField(TEXT("kind"), TEXT("asset_bulk"));
+		Data->SetNumberField(TEXT("done"), Run.Job->Results.Num());
+		Data->SetNumberField(TEXT("total"), Run.Job->Total);
+		FEditorEventFeed::Post(EEditorEventTopic::Jobs, TEXT("progress"), Run.Job->JobId, Data);
+	}
+
+	void Retire(TSharedRef<FRunningJob> Run, FAssetBulkInspector::EJobStatus Status)
+	{
+		for (TPair<int32, TSharedPtr<FStreamableHandle>>& Pair : Run->InFlight)
+		{
+			if (Pair.Value.IsValid())
+			{
+				Pair.Value->CancelHandle();
+			}
+		}
+		Run->InFlight.Reset();
+
+		FJob& Job = *Run->Job;
+		Job.Status = Status;
+		Job.EndTime = FDateTime::UtcNow();
+
+		Running.Remove(Run);
+		Finished.Add(Run->Job);
+		if (Finished.Num() > MaxFinishedJobs)
+		{
+			Finished.RemoveAt(0, Finished.Num() - MaxFinishedJobs);
+		}
+
+		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+		Data->SetStringField(TEXT("kind"), TEXT("asset_bulk"));
+		Data->SetStringField(TEXT("operation"), FAssetBulkInspector::GetOperationName(Job.Options.Operation));
+		Data->SetNumberField(TEXT("total"), Job.Total);
+		Data->SetNumberField(TEXT("failed"), Job.Failed);
+		Data->SetBoolField(TEXT("cancelled"), Status == FAssetBulkInspector::EJobStatus::Cancelled);
+		FEditorEventFeed::Post(EEditorEventTopic::Jobs, TEXT("finished"), Job.JobId, Data);
+
+		UE_LOG(LogTemp, Log, TEXT("AssetBulkInspector: %s job %s finished: %d assets, %d from registry, %d loaded, %d failed"),
+			FAssetBulkInspector::GetOperationName(Job.Options.Operation), *Job.JobId, Job.Total, Job.FromRegistry, Job.Loaded, Job.Failed);
+	}
+
+	void NoteLoaded(FRunningJob& Run)
+	{
+		++Run.Job->Loaded;
+
+		// Handles are released as soon as each asset is inspected; collecting now and then keeps the loaded set bounded
+		const int32 BatchSize = Run.Job->Options.GCBatchSize;
+		if (BatchSize > 0 && ++LoadsSinceCollect >= BatchSize && GEngine)
+		{
+			LoadsSinceCollect = 0;
+			GEngine->ForceGarbageCollection();
+		}
+	}
+
+	/** Inspect finished loads and start new ones, within the tick budget. @return false once the budget is spent */
+	bool PumpJob(FRunningJob& Run, double Deadline)
+	{
+		// Finished loads first: they free in-flight slots
+		for (auto It = Run.InFlight.CreateIterator(); It; ++It)
+		{
+			if (FPlatformTime::Seconds() >= Deadline)
+			{
+				return false;
+			}
+
+			const TSharedPtr<FStreamableHandle>& Handle = It.Value();
+			if (Handle.IsValid() && !Handle->HasLoadCompleted() && !Handle->WasCanceled())
+			{
+				continue;
+			}
+
+			const int32 Index = It.Key();
+			const FSoftObjectPath& Path = Run.Queue[Index].Value;
+			UObject* Asset = Handle.IsValid() ? Handle->GetLoadedAsset() : nullptr;
+			Inspect(Run, Run.Queue[Index].Key, Path, Asset, TEXT("loaded"));
+			if (Asset)
+			{
+				NoteLoaded(Run);
+			}
+
+			if (Handle.IsValid())
+			{
+				Handle->ReleaseHandle();
+			}
+			It.RemoveCurrent();
+		}
+
+		const int32 MaxInFlight = Run.Job->Options.MaxInFlight;
+		while (Run.NextQueued < Run.Queue.Num() && Run.InFlight.Num() < MaxInFlight)
+		{
+			if (FPlatformTime::Seconds() >= Deadline)
+			{
+				return false;
+			}
+
+			const int32 QueueIndex = Run.NextQueued++;
+			const FSoftObjectPath& Path = Run.Queue[QueueIndex].Value;
+
+			// Already in memory: nothing to wait for
+			if (UObject* Existing = Path.ResolveObject())
+			{
+				Inspect(Run, Run.Queue[QueueIndex].Key, Path, Existing, TEXT("memory"));
+				continue;
+			}
+
+			TSharedPtr<FStreamableHandle> Handle = Streamable->RequestAsyncLoad(Path, FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority, false);
+			Run.InFlight.Add(QueueIndex, Handle);
+		}
+		return true;
+	}
+
+	bool Tick(float DeltaTime)
+	{
+		const double Deadline = FPlatformTime::Seconds() + TickBudgetSeconds;
+
+		// Copy: finishing a job removes it from Running
+		const TArray<TSharedRef<FRunningJob>> Jobs = Running;
+		for (const TSharedRef<FRunningJob>& Run : Jobs)
+		{
+			const bool bWithinBudget = PumpJob(*Run, Deadline);
+			if (Run->IsDrained())
+			{
+				Retire(Run, FAssetBulkInspector::EJobStatus::Completed);
+			}
+			else
+			{
+				PostProgress(*Run, false);
+			}
+
+			if (!bWithinBudget)
+			{
+				break;
+			}
+		}
+		return true;
+	}
+
+	TSharedPtr<FJsonObject> MakeVector(double X, double Y, double Z)
+	{
+		return JsonHelpers::VectorToJson(FVector(X, Y, Z));
+	}
+}
+
+void FAssetBulkInspector::FJob::WriteSummary(FRESTJsonWriter& Writer) const
+{
+	Writer.WriteValue(TEXT("job_id"), JobId);
+	Writer.WriteValue(TEXT("operation"), GetOperationName(Options.Operation));
+	Writer.WriteValue(TEXT("status"), Status == EJobStatus::Running ? TEXT("running") : Status == EJobStatus::Completed ? TEXT("completed") : TEXT("cancelled"));
+	Writer.WriteValue(TEXT("total"), Total);
+	Writer.WriteValue(TEXT("done"), Results.Num());
+	Writer.WriteValue(TEXT("from_registry"), FromRegistry);
+	Writer.WriteValue(TEXT("loaded"), Loaded);
+	Writer.WriteValue(TEXT("failed"), Failed);
+	Writer.WriteValue(TEXT("submitted_at"), SubmitTime.ToIso8601());
+	if (Status != EJobStatus::Running)
+	{
+		Writer.WriteValue(TEXT("completed_at"), EndTime.ToIso8601());
+		Writer.WriteValue(TEXT("duration_ms"), (EndTime - SubmitTime).GetTotalMilliseconds());
+	}
+}
+
+void FAssetBulkInspector::FJob::WriteResult(FRESTJsonWriter& Writer, const FResult& Result)
+{
+	Writer.WriteObjectStart();
+	Writer.WriteValue(TEXT("index"), Result.Index);
+	Writer.WriteValue(TEXT("path"), Result.Path);
+	Writer.WriteValue(TEXT("source"), Result.Source);
+	Writer.WriteValue(TEXT("success"), Result.ErrorCode.IsEmpty());
+	if (!Result.ErrorCode.IsEmpty())
+	{
+		Writer.WriteObjectStart(TEXT("error"));
+		Writer.WriteValue(TEXT("code"), Result.ErrorCode);
+		Writer.WriteValue(TEXT("message"), Result.ErrorMessage);
+		Writer.WriteObjectEnd();
+	}
+	if (Result.Data.IsValid())
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Result.Data->Values)
+		{
+			Writer.WriteJsonValue(Field.Key, Field.Value);
+		}
+	}
+	Writer.WriteObjectEnd();
+}
+
+void FAssetBulkInspector::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	Streamable = MakeUnique<FStreamableManager>();
+	Ticker = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&Tick));
+}
+
+void FAssetBulkInspector::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	FTSTicker::GetCoreTicker().RemoveTicker(Ticker);
+	Ticker.Reset();
+
+	for (const TSharedRef<FRunningJob>& Run : Running)
+	{
+		for (TPair<int32, TSharedPtr<FStreamableHandle>>& Pair : Run->InFlight)
+		{
+			if (Pair.Value.IsValid())
+			{
+				Pair.Value->CancelHandle();
+			}
+		}
+	}
+	Running.Empty();
+	Finished.Empty();
+	Streamable.Reset();
+	LoadsSinceCollect = 0;
+}
+
+TSharedPtr<const FAssetBulkInspector::FJob> FAssetBulkInspector::Start(const TArray<FSoftObjectPath>& Paths, const FOptions& Options, FString& OutError)
+{
+	check(IsInGameThread());
+
+	if (!bInitialized)
+	{
+		OutError = TEXT("Bulk inspector is not running");
+		return nullptr;
+	}
+
+	if (Running.Num() >= MaxRunningJobs)
+	{
+		OutError = FString::Printf(TEXT("%d bulk jobs are already running; wait for one to finish"), Running.Num());
+		return nullptr;
+	}
+
+	TSharedRef<FJob> Job = MakeShared<FJob>();
+	Job->JobId = FGuid::NewGuid().ToString(EGuidFormats::Digits).ToLower();
+	Job->Options = Options;
+	Job->Options.MaxInFlight = FMath::Clamp(Options.MaxInFlight, 1, 64);
+	Job->Total = Paths.Num();
+	Job->SubmitTime = FDateTime::UtcNow();
+	Job->Results.Reserve(Paths.Num());
+
+	TSharedRef<FRunningJob> Run = MakeShared<FRunningJob>(Job);
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	for (int32 Index = 0; Index < Paths.Num(); ++Index)
+	{
+		if (!Paths[Index].IsValid())
+		{
+			AddResult(*Run, MakeError(Index, Paths[Index], TEXT("none"), TEXT("INVALID_PATH"), TEXT("Not an object path")));
+			continue;
+		}
+		if (!TryAnswerFromRegistry(*Run, Index, Paths[Index], AssetRegistry))
+		{
+			Run->Queue.Emplace(Index, Paths[Index]);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("AssetBulkInspector: %s job %s: %d assets, %d answered from the registry, %d to load"),
+		GetOperationName(Options.Operation), *Job->JobId, Job->Total, Job->Results.Num(), Run->Queue.Num());
+
+	Running.Add(Run);
+	if (Run->IsDrained())
+	{
+		Retire(Run, EJobStatus::Completed);
+	}
+	else
+	{
+		PostProgress(*Run, true);
+	}
+	return Job;
+}
+
+TSharedPtr<const FAssetBulkInspector::FJob> FAssetBulkInspector::FindJob(const FString& JobId)
+{
+	for (const TSharedRef<FRunningJob>& Run : Running)
+	{
+		if (Run->Job->JobId == JobId)
+		{
+			return Run->Job;
+		}
+	}
+	for (const TSharedRef<FJob>& Job : Finished)
+	{
+		if (Job->JobId == JobId)
+		{
+			return Job;
+		}
+	}
+	return nullptr;
+}
+
+bool FAssetBulkInspector::Cancel(const FString& JobId)
+{
+	check(IsInGameThread());
+
+	for (const TSharedRef<FRunningJob>& Run : Running)
+	{
+		if (Run->Job->JobId == JobId)
+		{
+			Retire(Run, EJobStatus::Cancelled);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FAssetBulkInspector::ParseOperation(const FString& Name, EOperation& OutOperation)
+{
+	for (EOperation Operation : { EOperation::MeshDetails, EOperation::Validate, EOperation::Export, EOperation::RecompileMaterial })
+	{
+		if (Name.Equals(GetOperationName(Operation), ESearchCase::IgnoreCase))
+		{
+			OutOperation = Operation;
+			return true;
+		}
+	}
+	return false;
+}
+
+const TCHAR* FAssetBulkInspector::GetOperationName(EOperation Operation)
+{
+	switch (Operation)
+	{
+	case EOperation::MeshDetails:
+		return TEXT("mesh_details");
+	case EOperation::Validate:
+		return TEXT("validate");
+	case EOperation::Export:
+		return TEXT("export");
+	case EOperation::RecompileMaterial:
+		return TEXT("recompile_material");
+	}
+	return TEXT("unknown");
+}
+
+bool FAssetBulkInspector::ParseLoadPolicy(const FString& Name, ELoadPolicy& OutPolicy)
+{
+	if (Name.Equals(TEXT("auto"), ESearchCase::IgnoreCase))
+	{
+		OutPolicy = ELoadPolicy::Auto;
+	}
+	else if (Name.Equals(TEXT("never"), ESearchCase::IgnoreCase))
+	{
+		OutPolicy = ELoadPolicy::Never;
+	}
+	else if (Name.Equals(TEXT("always"), ESearchCase::IgnoreCase))
+	{
+		OutPolicy = ELoadPolicy::Always;
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
+TSharedPtr<FJsonObject> FAssetBulkInspector::MeshDetailsToJson(UStaticMesh* Mesh)
+{
+	TSharedPtr<FJsonObject> MeshInfo = MakeShared<FJsonObject>();
+	MeshInfo->SetNumberField(TEXT("lod_count"), Mesh->GetNumLODs());
+
+	// Bounds (in centimeters)
+	FBoxSphereBounds Bounds = Mesh->GetBounds();
+	MeshInfo->SetObjectField(TEXT("bounds_origin"), JsonHelpers::VectorToJson(Bounds.Origin));
+	MeshInfo->SetObjectField(TEXT("bounds_extent"), JsonHelpers::VectorToJson(Bounds.BoxExtent));
+	MeshInfo->SetNumberField(TEXT("bounds_radius"), Bounds.SphereRadius);
+
+	// LOD details
+	TArray<TSharedPtr<FJsonValue>> LODArray;
+	for (int32 LODIndex = 0; LODIndex < Mesh->GetNumLODs(); ++LODIndex)
+	{
+		TSharedPtr<FJsonObject> LODInfo = MakeShared<FJsonObject>();
+		LODInfo->SetNumberField(TEXT("index"), LODIndex);
+
+		if (Mesh->GetRenderData() && Mesh->GetRenderData()->LODResources.IsValidIndex(LODIndex))
+		{
+			const FStaticMeshLODResources& LODResources = Mesh->GetRenderData()->LODResources[LODIndex];
+			LODInfo->SetNumberField(TEXT("vertices"), LODResources.GetNumVertices());
+			LODInfo->SetNumberField(TEXT("triangles"), LODResources.GetNumTriangles());
+			LODInfo->SetNumberField(TEXT("sections"), LODResources.Sections.Num());
+		}
+
+		LODArray.Add(MakeShared<FJsonValueObject>(LODInfo));
+	}
+	MeshInfo->SetArrayField(TEXT("lods"), LODArray);
+
+	return MeshInfo;
+}
+
+TSharedPtr<FJsonObject> FAssetBulkInspector::MeshDetailsFromRegistry(const FAssetData& AssetData)
+{
+	// Tags written by UStaticMesh::GetAssetRegistryTags when the mesh was saved; LOD 0 only
+	auto GetIntTag = [&AssetData](const TCHAR* Tag, int64& OutValue)
+	{
+		FString Value;
+		if (AssetData.GetTagValue(FName(Tag), Value) && Value.IsNumeric())
+		{
+			OutValue = FCString::Atoi64(*Value);
+			return true;
+		}
+		return false;
+	};
+
+	int64 LODs = 0;
+	int64 Triangles = 0;
+	int64 Vertices = 0;
+	if (!GetIntTag(TEXT("LODs"), LODs) || !GetIntTag(TEXT("Triangles"), Triangles) || !GetIntTag(TEXT("Vertices"), Vertices))
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FJsonObject> MeshInfo = MakeShared<FJsonObject>();
+	MeshInfo->SetNumberField(TEXT("lod_count"), LODs);
+
+	TSharedPtr<FJsonObject> LOD0 = MakeShared<FJsonObject>();
+	LOD0->SetNumberField(TEXT("index"), 0);
+	LOD0->SetNumberField(TEXT("vertices"), Vertices);
+	LOD0->SetNumberField(TEXT("triangles"), Triangles);
+	TArray<TSharedPtr<FJsonValue>> LODArray;
+	LODArray.Add(MakeShared<FJsonValueObject>(LOD0));
+	MeshInfo->SetArrayField(TEXT("lods"), LODArray);
+
+	int64 Materials = 0;
+	if (GetIntTag(TEXT("Materials"), Materials))
+	{
+		MeshInfo->SetNumberField(TEXT("materials"), Materials);
+	}
+
+	// "XxYxZ" bounding box size, rounded to whole centimeters
+	FString ApproxSize;
+	TArray<FString> Axes;
+	if (AssetData.GetTagValue(FName(TEXT("ApproxSize")), ApproxSize) && ApproxSize.ParseIntoArray(Axes, TEXT("x")) == 3)
+	{
+		MeshInfo->SetObjectField(TEXT("approx_size"), MakeVector(FCString::Atod(*Axes[0]), FCString::Atod(*Axes[1]), FCString::Atod(*Axes[2])));
+	}
+
+	return MeshInfo;
+}
+
+TSharedPtr<FJsonObject> FAssetBulkInspector::ValidateToJson(UObject* Asset)
+{
+	TArray<FString> Errors;
+	bool bValid = Asset->IsAsset(); // Basic validation
+
+	TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+	Json->SetBoolField(TEXT("valid"), bValid && Errors.Num() == 0);
+
+	TArray<TSharedPtr<FJsonValue>> ErrorsArray;
+	for (const FString& Err : Errors)
+	{
+		ErrorsArray.Add(MakeShared<FJsonValueString>(Err));
+	}
+	Json->SetArrayField(TEXT("errors"), ErrorsArray);
+	return Json;
+}
+
+TSharedPtr<FJsonObject> FAssetBulkInspector::ExportToJson(UObject* Asset)
+{
+	// Export to text using ExportToOutputDevice
+	FStringOutputDevice Output;
+	UExporter::ExportToOutputDevice(nullptr, Asset, nullptr, Output, TEXT("copy"), 0, PPF_ExportsNotFullyQualified);
+
+	TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+	Json->SetStringField(TEXT("exported_text"), *Output);
+	return Json;
+}
@@ -0,0 +1,552 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Utils/AssetSearchIndex.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "Misc/ScopeRWLock.h"
+#include "Misc/StringBuilder.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	/** Three lowercase characters packed into one key */
+	using FTrigram = uint64;
+	using FTrigramList = TArray<FTrigram, TInlineAllocator<64>>;
+
+	/** (PackageName, AssetName) - identifies an asset without building its object path string */
+	using FAssetKey = TTuple<FName, FName>;
+
+	/** Fuzzy matches below this trigram Dice coefficient are dropped */
+	constexpr float FuzzyMinSimilarity = 0.35f;
+
+	struct FEntry
+	{
+		FName PackageName;
+		FName PackagePath;
+		FName AssetName;
+		FTopLevelAssetPath ClassPath;
+		FString LowerName;
+		uint16 TrigramCount = 0;
+		bool bAlive = true;
+	};
+
+	struct FIndexData
+	{
+		/** Append-only between compactions, so every posting list stays sorted by entry index */
+		TArray<FEntry> Entries;
+		TMap<FAssetKey, int32> ByKey;
+		TMap<FTrigram, TArray<int32>> Postings;
+		int32 NumDead = 0;
+	};
+
+	/** Registry change seen while a build was running; replayed onto the new index */
+	struct FPendingChange
+	{
+		FAssetData Asset;
+		FString OldObjectPath;
+		bool bRemoved = false;
+	};
+
+	struct FSearchState
+	{
+		FRWLock Lock;
+		TUniquePtr<FIndexData> Data;
+		TArray<FPendingChange> Pending;
+		bool bBuilding = false;
+		TFuture<void> BuildTask;
+	};
+
+	struct FSearchHandles
+	{
+		FDelegateHandle FilesLoaded;
+		FDelegateHandle AssetAdded;
+		FDelegateHandle AssetRemoved;
+		FDelegateHandle AssetRenamed;
+	};
+
+	FSearchState State;
+	FSearchHandles Handles;
+	bool bInitialized = false;
+
+	FAssetKey MakeKey(const FAssetData& Asset)
+	{
+		return FAssetKey(Asset.PackageName, Asset.AssetName);
+	}
+
+	/** Unique trigrams of an already-lowercase string */
+	void GetTrigrams(FStringView Lower, FTrigramList& OutTrigrams)
+	{
+		OutTrigrams.Reset();
+		for (int32 Index = 0; Index + 2 < Lower.Len(); ++Index)
+		{
+			OutTrigrams.Add(static_cast<FTrigram>(Lower[Index])
+				| (static_cast<FTrigram>(Lower[Index + 1]) << 21)
+				| (static_cast<FTrigram>(Lower[Index + 2]) << 42));
+		}
+
+		OutTrigrams.Sort();
+		int32 Unique = 0;
+		for (int32 Index = 0; Index < OutTrigrams.Num(); ++Index)
+		{
+			if (Index == 0 || OutTrigrams[Index] != OutTrigrams[Unique - 1])
+			{
+				OutTrigrams[Unique++] = OutTrigrams[Index];
+			}
+		}
+		OutTrigrams.SetNum(Unique);
+	}
+
+	void AddEntry(FIndexData& Data, const FAssetData& Asset)
+	{
+		const int32 EntryIndex = Data.Entries.Num();
+		FEntry& Entry = Data.Entries.AddDefaulted_GetRef();
+		Entry.PackageName = Asset.PackageName;
+		Entry.PackagePath = Asset.PackagePath;
+		Entry.AssetName = Asset.AssetName;
+		Entry.ClassPath = Asset.AssetClassPath;
+		Entry.LowerName = Asset.AssetName.ToString().ToLower();
+
+		FTrigramList Trigrams;
+		GetTrigrams(Entry.LowerName, Trigrams);
+		Entry.TrigramCount = static_cast<uint16>(FMath::Min(Trigrams.Num(), static_cast<int32>(MAX_uint16)));
+
+		for (FTrigram Trigram : Trigrams)
+		{
+			Data.Postings.FindOrAdd(Trigram).Add(EntryIndex);
+		}
+
+		Data.ByKey.Add(MakeKey(Asset), EntryIndex);
+	}
+
+	void RemoveEntry(FIndexData& Data, const FAssetKey& Key)
+	{
+		int32 EntryIndex = INDEX_NONE;
+		if (Data.ByKey.RemoveAndCopyValue(Key, EntryIndex) && Data.Entries[EntryIndex].bAlive)
+		{
+			// Tombstone only; postings are cleaned up by Compact
+			Data.Entries[EntryIndex].bAlive = false;
+			Data.Entries[EntryIndex].LowerName.Empty();
+			Data.NumDead++;
+		}
+	}
+
+	/** Drop tombstoned entries and rebuild postings once they make up a quarter of the index */
+	void CompactIfNeeded(FIndexData& Data)
+	{
+		if (Data.NumDead < 1024 || Data.NumDead * 4 < Data.Entries.Num())
+		{
+			return;
+		}
+
+		TArray<FEntry> Live;
+		Live.Reserve(Data.Entries.Num() - Data.NumDead);
+		for (FEntry& Entry : Data.Entries)
+		{
+			if (Entry.bAlive)
+			{
+				Live.Add(MoveTemp(Entry));
+			}
+		}
+
+		Data.Entries = MoveTemp(Live);
+		Data.ByKey.Reset();
+		Data.Postings.Reset();
+		Data.NumDead = 0;
+
+		FTrigramList Trigrams;
+		for (int32 EntryIndex = 0; EntryIndex < Data.Entries.Num(); ++EntryIndex)
+		{
+			const FEntry& Entry = Data.Entries[EntryIndex];
+			Data.ByKey.Add(FAssetKey(Entry.PackageName, Entry.AssetName), EntryIndex);
+
+			GetTrigrams(Entry.LowerName, Trigrams);
+			for (FTrigram Trigram : Trigrams)
+			{
+				Data.Postings.FindOrAdd(Trigram).Add(EntryIndex);
+			}
+		}
+	}
+
+	/** Add or update one asset (added events also arrive for assets already indexed) */
+	void ApplyAdded(FIndexData& Data, const FAssetData& Asset)
+	{
+		const FAssetKey Key = MakeKey(Asset);
+		if (const int32* Existing = Data.ByKey.Find(Key))
+		{
+			if (Data.Entries[*Existing].ClassPath == Asset.AssetClassPath)
+			{
+				return;
+			}
+			RemoveEntry(Data, Key);
+		}
+
+		AddEntry(Data, Asset);
+	}
+
+	void ApplyChange(FIndexData& Data, const FPendingChange& Change)
+	{
+		if (Change.bRemoved)
+		{
+			RemoveEntry(Data, MakeKey(Change.Asset));
+		}
+		else
+		{
+			if (!Change.OldObjectPath.IsEmpty())
+			{
+				const FSoftObjectPath OldPath(Change.OldObjectPath);
+				RemoveEntry(Data, FAssetKey(OldPath.GetLongPackageFName(), OldPath.GetAssetFName()));
+			}
+			ApplyAdded(Data, Change.Asset);
+		}
+
+		CompactIfNeeded(Data);
+	}
+
+	/** Apply a registry change now, queue it behind a running build, or drop it before the first build */
+	void OnRegistryChange(FPendingChange&& Change)
+	{
+		FRWScopeLock WriteLock(State.Lock, SLT_Write);
+
+		if (State.bBuilding)
+		{
+			State.Pending.Add(MoveTemp(Change));
+		}
+		else if (State.Data.IsValid())
+		{
+			ApplyChange(*State.Data, Change);
+		}
+	}
+
+	void StartBuild()
+	{
+		{
+			FRWScopeLock WriteLock(State.Lock, SLT_Write);
+			if (State.bBuilding)
+			{
+				return;
+			}
+			State.bBuilding = true;
+			State.Pending.Reset();
+		}
+
+		State.BuildTask = Async(EAsyncExecution::ThreadPool, []()
+		{
+			const double StartTime = FPlatformTime::Seconds();
+
+			// Off the game thread only on-disk state can be enumerated; unsaved assets arrive through OnAssetAdded
+			TUniquePtr<FIndexData> NewData = MakeUnique<FIndexData>();
+			if (IAssetRegistry* Registry = IAssetRegistry::Get())
+			{
+				Registry->EnumerateAllAssets([&NewData](const FAssetData& Asset)
+				{
+					if (!NewData->ByKey.Contains(MakeKey(Asset)))
+					{
+						AddEntry(*NewData, Asset);
+					}
+					return true;
+				}, true);
+			}
+
+			const int32 NumAssets = NewData->Entries.Num();
+			const int32 NumTrigrams = NewData->Postings.Num();
+
+			FRWScopeLock WriteLock(State.Lock, SLT_Write);
+			for (const FPendingChange& Change : State.Pending)
+			{
+				ApplyChange(*NewData, Change);
+			}
+			State.Pending.Empty();
+			State.Data = MoveTemp(NewData);
+			State.bBuilding = false;
+
+			UE_LOG(LogTemp, Log, TEXT("AssetSearchIndex: Indexed %d assets (%d trigrams) in %.0f ms"),
+				NumAssets, NumTrigrams, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		});
+	}
+
+	/** Package path equals Prefix or lies under it */
+	bool IsUnderPath(FName PackagePath, FStringView Prefix)
+	{
+		TStringBuilder<256> Path;
+		PackagePath.AppendString(Path);
+		const FStringView PathView = Path.ToView();
+
+		if (!PathView.StartsWith(Prefix, ESearchCase::IgnoreCase))
+		{
+			return false;
+		}
+		return PathView.Len() == Prefix.Len() || Prefix.EndsWith(TEXT('/')) || PathView[Prefix.Len()] == TEXT('/');
+	}
+
+	bool PassesFilters(const FEntry& Entry, const FAssetSearchQuery& Query, FStringView PathPrefix)
+	{
+		if (!Entry.bAlive)
+		{
+			return false;
+		}
+		if (!Query.ClassName.IsNone() && Entry.ClassPath.GetAssetName() != Query.ClassName)
+		{
+			return false;
+		}
+		if (Query.ClassPaths.Num() > 0 && !Query.ClassPaths.Contains(Entry.ClassPath))
+		{
+			return false;
+		}
+		return PathPrefix.IsEmpty() || IsUnderPath(Entry.PackagePath, PathPrefix);
+	}
+
+	FAssetData MakeAssetData(const FEntry& Entry)
+	{
+		return FAssetData(Entry.PackageName, Entry.PackagePath, Entry.AssetName, Entry.ClassPath);
+	}
+
+	/** Page over candidates in entry order */
+	template <typename CandidateRangeType>
+	void CollectPage(const FIndexData& Data, const CandidateRangeType& Candidates, const FAssetSearchQuery& Query,
+		TFunctionRef<bool(const FEntry&)> MatchesName, FAssetSearchResult& OutResult)
+	{
+		const FStringView PathPrefix = Query.PathPrefix;
+		int32 Matched = 0;
+		for (const int32 EntryIndex : Candidates)
+		{
+			const FEntry& Entry = Data.Entries[EntryIndex];
+			if (!PassesFilters(Entry, Query, PathPrefix) || !MatchesName(Entry))
+			{
+				continue;
+			}
+
+			const int32 MatchIndex = Matched++;
+			if (MatchIndex < Query.Offset)
+			{
+				continue;
+			}
+			if (MatchIndex - Query.Offset >= Query.Limit)
+			{
+				OutResult.bHasMore = true;
+				break;
+			}
+			OutResult.Assets.Add(MakeAssetData(Entry));
+		}
+	}
+
+	/** Every entry index, for queries too short to have a trigram */
+	struct FAllEntries
+	{
+		int32 Num;
+
+		struct FIterator
+		{
+			int32 Index;
+			int32 operator*() const { return Index; }
+			FIterator& operator++() { ++Index; return *this; }
+			bool operator!=(const FIterator& Other) const { return Index != Other.Index; }
+		};
+
+		FIterator begin() const { return FIterator{0}; }
+		FIterator end() const { return FIterator{Num}; }
+	};
+
+	void SearchFuzzy(const FIndexData& Data, const FTrigramList& Trigrams, const FAssetSearchQuery& Query, FAssetSearchResult& OutResult)
+	{
+		// Shared-trigram count per entry
+		TArray<uint16> Shared;
+		Shared.SetNumZeroed(Data.Entries.Num());
+		for (FTrigram Trigram : Trigrams)
+		{
+			if (const TArray<int32>* Posting = Data.Postings.Find(Trigram))
+			{
+				for (const int32 EntryIndex : *Posting)
+				{
+					Shared[EntryIndex]++;
+				}
+			}
+		}
+
+		struct FScored
+		{
+			int32 EntryIndex;
+			float Similarity;
+		};
+
+		const FStringView PathPrefix = Query.PathPrefix;
+		TArray<FScored> Scored;
+		for (int32 EntryIndex = 0; EntryIndex < Shared.Num(); ++EntryIndex)
+		{
+			if (Shared[EntryIndex] == 0)
+			{
+				continue;
+			}
+
+			const FEntry& Entry = Data.Entries[EntryIndex];
+			const float Similarity = 2.0f * Shared[EntryIndex] / static_cast<float>(Trigrams.Num() + Entry.TrigramCount);
+			if (Similarity >= FuzzyMinSimilarity && PassesFilters(Entry, Query, PathPrefix))
+			{
+				Scored.Add({EntryIndex, Similarity});
+			}
+		}
+
+		// Best first; ties by shorter name, then entry order so pages are stable
+		Scored.Sort([&Data](const FScored& A, const FScored& B)
+		{
+			if (A.Similarity != B.Similarity)
+			{
+				return A.Similarity > B.Similarity;
+			}
+			const int32 LenA = Data.Entries[A.EntryIndex].LowerName.Len();
+			const int32 LenB = Data.Entries[B.EntryIndex].LowerName.Len();
+			return LenA != LenB ? LenA < LenB : A.EntryIndex < B.EntryIndex;
+		});
+
+		const int32 End = FMath::Min(Scored.Num(), Query.Offset + Query.Limit);
+		for (int32 Index = Query.Offset; Index < End; ++Index)
+		{
+			OutResult.Assets.Add(MakeAssetData(Data.Entries[Scored[Index].EntryIndex]));
+		}
+		OutResult.bHasMore = End < Scored.Num();
+	}
+}
+
+void FAssetSearchIndex::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+
+	IAssetRegistry* Registry = IAssetRegistry::Get();
+	if (!Registry)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	Handles.AssetAdded = Registry->OnAssetAdded().AddLambda([](const FAssetData& Asset)
+	{
+		OnRegistryChange(FPendingChange{Asset});
+	});
+
+	Handles.AssetRemoved = Registry->OnAssetRemoved().AddLambda([](const FAssetData& Asset)
+	{
+		OnRegistryChange(FPendingChange{Asset, FString(), true});
+	});
+
+	Handles.AssetRenamed = Registry->OnAssetRenamed().AddLambda([](const FAssetData& Asset, const FString& OldObjectPath)
+	{
+		OnRegistryChange(FPendingChange{Asset, OldObjectPath});
+	});
+
+	// Building during the initial scan would index a partial registry and then replay every discovered asset
+	if (Registry->IsLoadingAssets())
+	{
+		Handles.FilesLoaded = Registry->OnFilesLoaded().AddLambda([]()
+		{
+			StartBuild();
+		});
+	}
+	else
+	{
+		StartBuild();
+	}
+}
+
+void FAssetSearchIndex::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	if (IAssetRegistry* Registry = IAssetRegistry::Get())
+	{
+		Registry->OnFilesLoaded().Remove(Handles.FilesLoaded);
+		Registry->OnAssetAdded().Remove(Handles.AssetAdded);
+		Registry->OnAssetRemoved().Remove(Handles.AssetRemoved);
+		Registry->OnAssetRenamed().Remove(Handles.AssetRenamed);
+	}
+	Handles = FSearchHandles();
+
+	if (State.BuildTask.IsValid())
+	{
+		State.BuildTask.Wait();
+		State.BuildTask = TFuture<void>();
+	}
+
+	FRWScopeLock WriteLock(State.Lock, SLT_Write);
+	State.Data.Reset();
+	State.Pending.Empty();
+	State.bBuilding = false;
+}
+
+bool FAssetSearchIndex::IsReady()
+{
+	FRWScopeLock ReadLock(State.Lock, SLT_ReadOnly);
+	return State.Data.IsValid();
+}
+
+int32 FAssetSearchIndex::Num()
+{
+	FRWScopeLock ReadLock(State.Lock, SLT_ReadOnly);
+	return State.Data.IsValid() ? State.Data->ByKey.Num() : 0;
+}
+
+bool FAssetSearchIndex::Search(const FAssetSearchQuery& Query, FAssetSearchResult& OutResult)
+{
+	const FString Lower = Query.Text.ToLower();
+	FTrigramList Trigrams;
+	GetTrigrams(Lower, Trigrams);
+
+	FRWScopeLock ReadLock(State.Lock, SLT_ReadOnly);
+	if (!State.Data.IsValid())
+	{
+		return false;
+	}
+
+	const FIndexData& Data = *State.Data;
+	OutResult = FAssetSearchResult();
+
+	if (Query.Mode == EAssetSearchMode::Fuzzy && Trigrams.Num() > 0)
+	{
+		SearchFuzzy(Data, Trigrams, Query, OutResult);
+		return true;
+	}
+
+	// Fuzzy text too short for a trigram degrades to a prefix match
+	const bool bPrefix = Query.Mode != EAssetSearchMode::Substring;
+	auto MatchesName = [&Lower, bPrefix](const FEntry& Entry)
+	{
+		return bPrefix ? Entry.LowerName.StartsWith(Lower, ESearchCase::CaseSensitive) : Entry.LowerName.Contains(Lower, ESearchCase::CaseSensitive);
+	};
+
+	if (Trigrams.Num() == 0)
+	{
+		CollectPage(Data, FAllEntries{Data.Entries.Num()}, Query, MatchesName, OutResult);
+		return true;
+	}
+
+	// Every match contains every query trigram, so the rarest one bounds the candidates
+	const TArray<int32>* Shortest = nullptr;
+	for (FTrigram Trigram : Trigrams)
+	{
+		const TArray<int32>* Posting = Data.Postings.Find(Trigram);
+		if (!Posting)
+		{
+			return true;
+		}
+		if (!Shortest || Posting->Num() < Shortest->Num())
+		{
+			Shortest = Posting;
+		}
+	}
+
+	CollectPage(Data, *Shortest, Query, MatchesName, OutResult);
+	return true;
+}
+
+void FAssetSearchIndex::Rebuild()
+{
+	if (bInitialized)
+	{
+		StartBuild();
+	}
+}
@@ -0,0 +1,388 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Utils/BenchmarkContent.h"
+#include "Editor.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/Blueprint.h"
+#include "Components/StaticMeshComponent.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Materials/MaterialExpressionAdd.h"
+#include "Materials/MaterialExpressionConstant.h"
+#include "MaterialEditingLibrary.h"
+#include "Factories/MaterialFactoryNew.h"
+#include "Factories/MaterialInstanceConstantFactoryNew.h"
+#include "AssetToolsModule.h"
+#include "IAssetTools.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Event.h"
+#include "EdGraphSchema_K2.h"
+#include "Math/RandomStream.h"
+#include "Misc/Parse.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+const TCHAR* const FBenchmarkContent::ActorPrefix = TEXT("RESTBench_");
+
+namespace
+{
+	/** Outliner folder generated actors are placed in */
+	const FName ActorFolder(TEXT("RESTBenchmark"));
+
+	const TCHAR* const MeshPaths[] = {
+		TEXT("/Engine/BasicShapes/Cube.Cube"),
+		TEXT("/Engine/BasicShapes/Sphere.Sphere"),
+		TEXT("/Engine/BasicShapes/Cylinder.Cylinder"),
+		TEXT("/Engine/BasicShapes/Cone.Cone"),
+	};
+
+	/** Name words of the asset tree, so /assets/search has selective and broad queries */
+	const TCHAR* const AssetWords[] = { TEXT("Rock"), TEXT("Wood"), TEXT("Metal"), TEXT("Glass"), TEXT("Fabric") };
+
+	const TCHAR* const ParentMaterialPath = TEXT("/Engine/BasicShapes/BasicShapeMaterial.BasicShapeMaterial");
+
+	/** Grid spacing of generated actors, in cm */
+	constexpr double ActorSpacing = 200.0;
+
+	bool AssetExists(const FString& PackageName)
+	{
+		return FindPackage(nullptr, *PackageName) != nullptr || FPackageName::DoesPackageExist(PackageName);
+	}
+
+	void SavePackage(UObject* Asset)
+	{
+		UPackage* Package = Asset ? Asset->GetOutermost() : nullptr;
+		if (!Package)
+		{
+			return;
+		}
+
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Standalone;
+		UPackage::Save(Package, Asset, *FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension()), SaveArgs);
+	}
+}
+
+FBenchmarkContentOptions FBenchmarkContentOptions::FromString(const FString& Args)
+{
+	FBenchmarkContentOptions Options;
+	FParse::Value(*Args, TEXT("actors="), Options.Actors);
+	FParse::Value(*Args, TEXT("asset_folders="), Options.AssetFolders);
+	FParse::Value(*Args, TEXT("assets_per_folder="), Options.AssetsPerFolder);
+	FParse::Value(*Args, TEXT("material_nodes="), Options.MaterialNodes);
+	FParse::Value(*Args, TEXT("blueprint_nodes="), Options.BlueprintNodes);
+	FParse::Value(*Args, TEXT("seed="), Options.Seed);
+	FParse::Value(*Args, TEXT("root="), Options.RootPath);
+	FParse::Bool(*Args, TEXT("save="), Options.bSave);
+
+	Options.Actors = FMath::Max(Options.Actors, 0);
+	Options.AssetFolders = FMath::Max(Options.AssetFolders, 0);
+	Options.AssetsPerFolder = FMath::Max(Options.AssetsPerFolder, 0);
+	Options.MaterialNodes = FMath::Max(Options.MaterialNodes, 0);
+	Options.BlueprintNodes = FMath::Max(Options.BlueprintNodes, 0);
+	return Options;
+}
+
+bool FBenchmarkContent::Generate(UWorld* World, const FBenchmarkContentOptions& Options, FBenchmarkContentResult& OutResult, FString& OutError)
+{
+	OutResult = FBenchmarkContentResult();
+	const double StartTime = FPlatformTime::Seconds();
+
+	if (!FPackageName::IsValidLongPackageName(Options.RootPath))
+	{
+		OutError = FString::Printf(TEXT("Invalid root path: %s"), *Options.RootPath);
+		return false;
+	}
+
+	if (!World)
+	{
+		OutError = TEXT("No world to spawn benchmark actors into");
+		return false;
+	}
+
+	ClearActors(World);
+	OutResult.ActorsSpawned = SpawnActors(World, Options);
+	OutResult.AssetsCreated = CreateAssetTree(Options);
+
+	if (Options.MaterialNodes > 0 && !CreateMaterialGraph(Options, OutResult.MaterialPath, OutError))
+	{
+		return false;
+	}
+
+	if (Options.BlueprintNodes > 0 && !CreateBlueprintGraph(Options, OutResult.BlueprintPath, OutError))
+	{
+		return false;
+	}
+
+	OutResult.Seconds = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogTemp, Log, TEXT("BenchmarkContent: %d actors, %d new assets, material '%s', blueprint '%s' in %.2fs"),
+		OutResult.ActorsSpawned, OutResult.AssetsCreated, *OutResult.MaterialPath, *OutResult.BlueprintPath, OutResult.Seconds);
+	return true;
+}
+
+int32 FBenchmarkContent::ClearActors(UWorld* World)
+{
+	if (!World)
+	{
+		return 0;
+	}
+
+	TArray<AActor*> ToDestroy;
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		if (It->GetActorLabel().StartsWith(ActorPrefix))
+		{
+			ToDestroy.Add(*It);
+		}
+	}
+
+	for (AActor* Actor : ToDestroy)
+	{
+		World->EditorDestroyActor(Actor, true);
+	}
+	return ToDestroy.Num();
+}
+
+int32 FBenchmarkContent::SpawnActors(UWorld* World, const FBenchmarkContentOptions& Options)
+{
+	if (Options.Actors <= 0)
+	{
+		return 0;
+	}
+
+	TArray<UStaticMesh*> Meshes;
+	for (const TCHAR* MeshPath : MeshPaths)
+	{
+		if (UStaticMesh* Mesh = LoadObject<UStaticMesh>(nullptr, MeshPath))
+		{
+			Meshes.Add(Mesh);
+		}
+	}
+
+	FRandomStream Random(Options.Seed);
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<double>(Options.Actors)));
+
+	// No transaction: undo history for 100k spawns costs more memory than the actors
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	int32 Spawned = 0;
+	for (int32 Index = 0; Index < Options.Actors; ++Index)
+	{
+		const FVector Location(
+			(Index % GridSize) * ActorSpacing + Random.FRandRange(-0.25f, 0.25f) * ActorSpacing,
+			(Index / GridSize) * ActorSpacing + Random.FRandRange(-0.25f, 0.25f) * ActorSpacing,
+			Random.FRandRange(0.0f, 100.0f));
+		const FRotator Rotation(0.0, Random.FRandRange(0.0f, 360.0f), 0.0);
+
+		AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), FTransform(Rotation, Location), SpawnParams);
+		if (!Actor)
+		{
+			continue;
+		}
+
+		if (Meshes.Num() > 0)
+		{
+			Actor->GetStaticMeshComponent()->SetStaticMesh(Meshes[Index % Meshes.Num()]);
+		}
+		Actor->SetActorLabel(FString::Printf(TEXT("%s%06d"), ActorPrefix, Index));
+		Actor->SetFolderPath(ActorFolder);
+		Spawned++;
+	}
+
+	if (GEditor)
+	{
+		GEditor->RedrawLevelEditingViewports();
+	}
+	return Spawned;
+}
+
+int32 FBenchmarkContent::CreateAssetTree(const FBenchmarkContentOptions& Options)
+{
+	if (Options.AssetFolders <= 0 || Options.AssetsPerFolder <= 0)
+	{
+		return 0;
+	}
+
+	IAssetTools& AssetTools = FAssetToolsModule::GetModule().Get();
+	UMaterialInterface* Parent = LoadObject<UMaterialInterface>(nullptr, ParentMaterialPath);
+
+	int32 Created = 0;
+	for (int32 Folder = 0; Folder < Options.AssetFolders; ++Folder)
+	{
+		const FString FolderPath = FString::Printf(TEXT("%s/Tree/Folder_%03d"), *Options.RootPath, Folder);
+
+		for (int32 Index = 0; Index < Options.AssetsPerFolder; ++Index)
+		{
+			const FString AssetName = FString::Printf(TEXT("MI_Bench_%s_%03d_%04d"), AssetWords[(Folder + Index) % UE_ARRAY_COUNT(AssetWords)], Folder, Index);
+			if (AssetExists(FolderPath / AssetName))
+			{
+				continue;
+			}
+
+			UMaterialInstanceConstantFactoryNew* Factory = NewObject<UMaterialInstanceConstantFactoryNew>();
+			Factory->InitialParent = Parent;
+
+			UObject* Asset = AssetTools.CreateAsset(AssetName, FolderPath, UMaterialInstanceConstant::StaticClass(), Factory);
+			if (!Asset)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("BenchmarkContent: Failed to create %s/%s"), *FolderPath, *AssetName);
+				continue;
+			}
+
+			if (Options.bSave)
+			{
+				SavePackage(Asset);
+			}
+			Created++;
+		}
+	}
+	return Created;
+}
+
+bool FBenchmarkContent::CreateMaterialGraph(const FBenchmarkContentOptions& Options, FString& OutPath, FString& OutError)
+{
+	const FString AssetName = FString::Printf(TEXT("M_BenchGraph_%d"), Options.MaterialNodes);
+	const FString PackagePath = Options.RootPath / TEXT("Graphs");
+	OutPath = PackagePath / AssetName;
+	if (AssetExists(OutPath))
+	{
+		return true;
+	}
+
+	UMaterial* Material = Cast<UMaterial>(FAssetToolsModule::GetModule().Get().CreateAsset(
+		AssetName, PackagePath, UMaterial::StaticClass(), NewObject<UMaterialFactoryNew>()));
+	if (!Material)
+	{
+		OutError = FString::Printf(TEXT("Failed to create material: %s"), *OutPath);
+		return false;
+	}
+
+	// Pairwise Add tree over Constant leaves: about MaterialNodes expressions, but
+	// only log2 deep so the HLSL translator does not recurse through all of them
+	FRandomStream Random(Options.Seed);
+	const int32 Leaves = FMath::Max(1, (Options.MaterialNodes + 1) / 2);
+	constexpr int32 ColumnWidth = 250;
+	constexpr int32 RowHeight = 100;
+
+	TArray<UMaterialExpression*> Level;
+	Level.Reserve(Leaves);
+	for (int32 Index = 0; Index < Leaves; ++Index)
+	{
+		UMaterialExpressionConstant* Constant = Cast<UMaterialExpressionConstant>(
+			UMaterialEditingLibrary::CreateMaterialExpression(Material, UMaterialExpressionConstant::StaticClass(), 0, Index * RowHeight));
+		if (Constant)
+		{
+			Constant->R = Random.FRandRange(0.0f, 1.0f / static_cast<float>(Leaves));
+			Level.Add(Constant);
+		}
+	}
+
+	int32 Depth = 1;
+	while (Level.Num() > 1)
+	{
+		TArray<UMaterialExpression*> Next;
+		Next.Reserve((Level.Num() + 1) / 2);
+		for (int32 Index = 0; Index + 1 < Level.Num(); Index += 2)
+		{
+			UMaterialExpression* Add = UMaterialEditingLibrary::CreateMaterialExpression(
+				Material, UMaterialExpressionAdd::StaticClass(), Depth * ColumnWidth, Index * (1 << (Depth - 1)) * RowHeight);
+			UMaterialEditingLibrary::ConnectMaterialExpressions(Level[Index], FString(), Add, TEXT("A"));
+			UMaterialEditingLibrary::ConnectMaterialExpressions(Level[Index + 1], FString(), Add, TEXT("B"));
+			Next.Add(Add);
+		}
+		if (Level.Num() % 2 == 1)
+		{
+			Next.Add(Level.Last());
+		}
+		Level = MoveTemp(Next);
+		Depth++;
+	}
+
+	if (Level.Num() == 1)
+	{
+		UMaterialEditingLibrary::ConnectMaterialProperty(Level[0], FString(), MP_BaseColor);
+	}
+	UMaterialEditingLibrary::RecompileMaterial(Material);
+
+	if (Options.bSave)
+	{
+		SavePackage(Material);
+	}
+	return true;
+}
+
+bool FBenchmarkContent::CreateBlueprintGraph(const FBenchmarkContentOptions& Options, FString& OutPath, FString& OutError)
+{
+	const FString AssetName = FString::Printf(TEXT("BP_BenchGraph_%d"), Options.BlueprintNodes);
+	OutPath = Options.RootPath / TEXT("Graphs") / AssetName;
+	if (AssetExists(OutPath))
+	{
+		return true;
+	}
+
+	UPackage* Package = CreatePackage(*OutPath);
+	UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(
+		AActor::StaticClass(), Package, FName(*AssetName), BPTYPE_Normal, UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+	if (!Blueprint)
+	{
+		OutError = FString::Printf(TEXT("Failed to create blueprint: %s"), *OutPath);
+		return false;
+	}
+	FAssetRegistryModule::AssetCreated(Blueprint);
+
+	UEdGraph* Graph = FBlueprintEditorUtils::FindEventGraph(Blueprint);
+	UFunction* PrintString = UKismetSystemLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, PrintString));
+	if (!Graph || !PrintString)
+	{
+		OutError = TEXT("Blueprint has no event graph to fill");
+		return false;
+	}
+
+	// One exec chain from BeginPlay, laid out in rows of NodesPerRow
+	const UEdGraphSchema* Schema = Graph->GetSchema();
+	constexpr int32 NodesPerRow = 20;
+	UEdGraphNode* Previous = FBlueprintEditorUtils::FindOverrideForFunction(Blueprint, AActor::StaticClass(), GET_FUNCTION_NAME_CHECKED(AActor, ReceiveBeginPlay));
+
+	for (int32 Index = 0; Index < Options.BlueprintNodes; ++Index)
+	{
+		UK2Node_CallFunction* Node = NewObject<UK2Node_CallFunction>(Graph);
+		Node->SetFromFunction(PrintString);
+		Node->NodePosX = 300 + (Index % NodesPerRow) * 300;
+		Node->NodePosY = 200 + (Index / NodesPerRow) * 250;
+		Node->AllocateDefaultPins();
+		Graph->AddNode(Node, true, false);
+
+		if (UEdGraphPin* InString = Node->FindPin(TEXT("InString")))
+		{
+			InString->DefaultValue = FString::Printf(TEXT("Bench %d"), Index);
+		}
+
+		if (Previous)
+		{
+			UEdGraphPin* Then = Previous->FindPin(UEdGraphSchema_K2::PN_Then);
+			UEdGraphPin* Execute = Node->FindPin(UEdGraphSchema_K2::PN_Execute);
+			if (Then && Execute)
+			{
+				Schema->TryCreateConnection(Then, Execute);
+			}
+		}
+		Previous = Node;
+	}
+
+	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+
+	if (Options.bSave)
+	{
+		SavePackage(Blueprint);
+	}
+	return true;
+}
@@ -0,0 +1,442 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Utils/BlueprintCompileQueue.h"
+#include "Utils/EditCoalescer.h"
+#include "Utils/EditorEventFeed.h"
+#include "RESTJsonWriter.h"
+#include "Editor.h"
+#include "BlueprintCompilationManager.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Algo/StableSort.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Logging/TokenizedMessage.h"
+#include "UObject/ObjectKey.h"
+
+static TAutoConsoleVariable<float> CVarBlueprintCompileIdleSeconds(
+	TEXT("UnrealPythonREST.BlueprintCompileIdleSeconds"),
+	2.0f,
+	TEXT("Compile Blueprints edited through /blueprints once no edit has arrived for this long. 0 = only compile on POST /blueprints/compile."));
+
+namespace
+{
+	using FJob = FBlueprintCompileQueue::FJob;
+
+	/** Finished jobs kept for GET /blueprints/compile/{id} */
+	constexpr int32 MaxFinishedJobs = 64;
+
+	TMap<FObjectKey, TWeakObjectPtr<UBlueprint>> Dirty;
+	double LastDirtyTime = 0.0;
+
+	/** Jobs for the next pass, with the Blueprints each asked for */
+	struct FPendingJob
+	{
+		TSharedRef<FJob> Job;
+		TArray<TWeakObjectPtr<UBlueprint>> Blueprints;
+	};
+	TArray<FPendingJob> Pending;
+
+	/** Oldest first */
+	TArray<TSharedRef<FJob>> Finished;
+
+	FTSTicker::FDelegateHandle Ticker;
+	bool bInitialized = false;
+
+	/** Guards against a pass re-entering itself (e.g. a compile pumping the ticker through a modal dialog) */
+	bool bCompiling = false;
+
+	const TCHAR* SeverityToString(int32 ErrorType)
+	{
+		switch (ErrorType)
+		{
+		case EMessageSeverity::Error:
+			return TEXT("error");
+		case EMessageSeverity::Warning:
+		case EMessageSeverity::PerformanceWarning:
+			return TEXT("warning");
+		default:
+			return TEXT("note");
+		}
+	}
+
+	/** Parent Blueprints in the chain; compiling shallower Blueprints first keeps children off stale parents */
+	int32 GetBlueprintDepth(const UBlueprint* Blueprint)
+	{
+		int32 Depth = 0;
+		for (UClass* Class = Blueprint->ParentClass; Class; Class = Class->GetSuperClass())
+		{
+			if (UBlueprint::GetBlueprintFromClass(Class))
+			{
+				++Depth;
+			}
+		}
+		return Depth;
+	}
+
+	FBlueprintCompileQueue::FBlueprintResult CollectResult(UBlueprint* Blueprint)
+	{
+		FBlueprintCompileQueue::FBlueprintResult Result;
+		Result.Path = Blueprint->GetPathName();
+
+		switch (Blueprint->Status)
+		{
+		case BS_Error:
+			Result.Status = TEXT("error");
+			break;
+		case BS_UpToDateWithWarnings:
+			Result.Status = TEXT("warnings");
+			break;
+		default:
+			Result.Status = TEXT("up_to_date");
+			break;
+		}
+
+		TArray<UEdGraph*> Graphs;
+		Blueprint->GetAllGraphs(Graphs);
+		for (UEdGraph* Graph : Graphs)
+		{
+			if (!Graph)
+			{
+				continue;
+			}
+			for (UEdGraphNode* Node : Graph->Nodes)
+			{
+				if (!Node || !Node->bHasCompilerMessage)
+				{
+					continue;
+				}
+
+				FBlueprintCompileQueue::FMessage& Message = Result.Messages.AddDefaulted_GetRef();
+				Message.Severity = SeverityToString(Node->ErrorType);
+				Message.Text = Node->ErrorMsg;
+				Message.NodeGuid = Node->NodeGuid;
+				Message.NodeTitle = Node->GetNodeTitle(ENodeTitleType::ListView).ToString();
+				Message.Graph = Graph->GetName();
+
+				if (Node->ErrorType == EMessageSeverity::Error)
+				{
+					++Result.Errors;
+				}
+				else if (Node->ErrorType == EMessageSeverity::Warning || Node->ErrorType == EMessageSeverity::PerformanceWarning)
+				{
+					++Result.Warnings;
+				}
+			}
+		}
+		return Result;
+	}
+
+	void RetireJob(const TSharedRef<FJob>& Job)
+	{
+		Finished.Add(Job);
+		if (Finished.Num() > MaxFinishedJobs)
+		{
+			Finished.RemoveAt(0, Finished.Num() - MaxFinishedJobs);
+		}
+
+		int32 Errors = 0;
+		for (const FBlueprintCompileQueue::FBlueprintResult& Result : Job->Results)
+		{
+			Errors += Result.Errors;
+		}
+
+		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+		Data->SetStringField(TEXT("kind"), TEXT("blueprint_compile"));
+		Data->SetNumberField(TEXT("blueprints"), Job->Results.Num());
+		Data->SetNumberField(TEXT("errors"), Errors);
+		FEditorEventFeed::Post(EEditorEventTopic::Jobs, TEXT("finished"), Job->JobId, Data);
+	}
+
+	TSharedRef<FJob> NewJob(bool bAutomatic)
+	{
+		TSharedRef<FJob> Job = MakeShared<FJob>();
+		Job->JobId = FGuid::NewGuid().ToString(EGuidFormats::Digits).ToLower();
+		Job->bAutomatic = bAutomatic;
+		Job->SubmitTime = FDateTime::UtcNow();
+		return Job;
+	}
+
+	/** Compile every pending job's Blueprints and everything dirty in one flush */
+	void RunPass(bool bAutomatic)
+	{
+		if (bCompiling)
+		{
+			return;
+		}
+		TGuardValue<bool> CompilingGuard(bCompiling, true);
+
+		TArray<FPendingJob> Jobs = MoveTemp(Pending);
+		Pending.Reset();
+		if (bAutomatic && Jobs.Num() == 0)
+		{
+			Jobs.Add({ NewJob(true), {} });
+		}
+
+		TArray<UBlueprint*> Blueprints;
+		for (const FPendingJob& Pass : Jobs)
+		{
+			for (const TWeakObjectPtr<UBlueprint>& WeakBlueprint : Pass.Blueprints)
+			{
+				if (UBlueprint* Blueprint = WeakBlueprint.Get())
+				{
+					Blueprints.AddUnique(Blueprint);
+				}
+			}
+		}
+
+		// Dirty Blueprints the editor has compiled since (Status no longer BS_Dirty) are skipped
+		for (const TPair<FObjectKey, TWeakObjectPtr<UBlueprint>>& Pair : Dirty)
+		{
+			UBlueprint* Blueprint = Pair.Value.Get();
+			if (Blueprint && Blueprint->Status == BS_Dirty)
+			{
+				Blueprints.AddUnique(Blueprint);
+			}
+		}
+		Dirty.Reset();
+
+		Algo::StableSortBy(Blueprints, &GetBlueprintDepth);
+
+		const double StartTime = FPlatformTime::Seconds();
+		if (Blueprints.Num() > 0)
+		{
+			for (UBlueprint* Blueprint : Blueprints)
+			{
+				FBlueprintCompilationManager::QueueForCompilation(Blueprint);
+			}
+			FBlueprintCompilationManager::FlushCompilationQueueAndReinstance();
+		}
+		const double CompileSeconds = FPlatformTime::Seconds() - StartTime;
+
+		TArray<FBlueprintCompileQueue::FBlueprintResult> Results;
+		Results.Reserve(Blueprints.Num());
+		for (UBlueprint* Blueprint : Blueprints)
+		{
+			Results.Add(CollectResult(Blueprint));
+		}
+
+		const FDateTime EndTime = FDateTime::UtcNow();
+		for (FPendingJob& Pass : Jobs)
+		{
+			Pass.Job->Results = Results;
+			for (int32 Index = 0; Index < Pass.Blueprints.Num(); ++Index)
+			{
+				if (!Pass.Blueprints[Index].IsValid())
+				{
+					FBlueprintCompileQueue::FBlueprintResult& Result = Pass.Job->Results.AddDefaulted_GetRef();
+					Result.Path = Pass.Job->Requested[Index];
+					Result.Status = TEXT("missing");
+				}
+			}
+			Pass.Job->Status = FBlueprintCompileQueue::EJobStatus::Completed;
+			Pass.Job->EndTime = EndTime;
+			Pass.Job->CompileSeconds = CompileSeconds;
+			RetireJob(Pass.Job);
+		}
+
+		if (Blueprints.Num() > 0)
+		{
+			UE_LOG(LogTemp, Log, TEXT("BlueprintCompileQueue: Compiled %d Blueprints in %.1f ms (%s)"),
+				Blueprints.Num(), CompileSeconds * 1000.0, bAutomatic ? TEXT("idle") : TEXT("requested"));
+		}
+	}
+
+	bool Tick(float DeltaTime)
+	{
+		if (Pending.Num() > 0)
+		{
+			RunPass(false);
+			return true;
+		}
+
+		const float IdleSeconds = CVarBlueprintCompileIdleSeconds.GetValueOnGameThread();
+		if (Dirty.Num() == 0 || IdleSeconds <= 0.0f || FEditCoalescer::IsCoalescing())
+		{
+			return true;
+		}
+
+		// Never recompile under a running PIE session
+		if (GEditor && GEditor->PlayWorld)
+		{
+			return true;
+		}
+
+		if (FPlatformTime::Seconds() - LastDirtyTime >= IdleSeconds)
+		{
+			RunPass(true);
+		}
+		return true;
+	}
+}
+
+void FBlueprintCompileQueue::FJob::WriteJson(FRESTJsonWriter& Writer) const
+{
+	Writer.WriteValue(TEXT("job_id"), JobId);
+	Writer.WriteValue(TEXT("status"), Status == EJobStatus::Pending ? TEXT("pending") : TEXT("completed"));
+	Writer.WriteValue(TEXT("automatic"), bAutomatic);
+
+	Writer.WriteArrayStart(TEXT("requested"));
+	for (const FString& Path : Requested)
+	{
+		Writer.WriteValue(Path);
+	}
+	Writer.WriteArrayEnd();
+
+	Writer.WriteValue(TEXT("submitted_at"), SubmitTime.ToIso8601());
+	if (Status == EJobStatus::Pending)
+	{
+		return;
+	}
+	Writer.WriteValue(TEXT("completed_at"), EndTime.ToIso8601());
+	Writer.WriteValue(TEXT("compile_ms"), CompileSeconds * 1000.0);
+
+	int32 Errors = 0;
+	int32 Warnings = 0;
+	for (const FBlueprintResult& Result : Results)
+	{
+		Errors += Result.Errors;
+		Warnings += Result.Warnings;
+	}
+	Writer.WriteValue(TEXT("errors"), Errors);
+	Writer.WriteValue(TEXT("warnings"), Warnings);
+
+	Writer.WriteArrayStart(TEXT("blueprints"));
+	for (const FBlueprintResult& Result : Results)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("path"), Result.Path);
+		Writer.WriteValue(TEXT("status"), Result.Status);
+		Writer.WriteValue(TEXT("errors"), Result.Errors);
+		Writer.WriteValue(TEXT("warnings"), Result.Warnings);
+
+		Writer.WriteArrayStart(TEXT("messages"));
+		for (const FMessage& Message : Result.Messages)
+		{
+			Writer.WriteObjectStart();
+			Writer.WriteValue(TEXT("severity"), Message.Severity);
+			Writer.WriteValue(TEXT("message"), Message.Text);
+			Writer.WriteValue(TEXT("node_id"), Message.NodeGuid.ToString());
+			Writer.WriteValue(TEXT("node_title"), Message.NodeTitle);
+			Writer.WriteValue(TEXT("graph"), Message.Graph);
+			Writer.WriteObjectEnd();
+		}
+		Writer.WriteArrayEnd();
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteArrayEnd();
+}
+
+void FBlueprintCompileQueue::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	Ticker = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&Tick));
+}
+
+void FBlueprintCompileQueue::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	FTSTicker::GetCoreTicker().RemoveTicker(Ticker);
+	Ticker.Reset();
+
+	Dirty.Empty();
+	Pending.Empty();
+	Finished.Empty();
+}
+
+void FBlueprintCompileQueue::MarkDirty(UBlueprint* Blueprint)
+{
+	check(IsInGameThread());
+
+	if (Blueprint)
+	{
+		Dirty.Add(FObjectKey(Blueprint), Blueprint);
+		LastDirtyTime = FPlatformTime::Seconds();
+	}
+}
+
+TArray<FString> FBlueprintCompileQueue::GetDirtyPaths()
+{
+	TArray<FString> Paths;
+	for (const TPair<FObjectKey, TWeakObjectPtr<UBlueprint>>& Pair : Dirty)
+	{
+		if (const UBlueprint* Blueprint = Pair.Value.Get())
+		{
+			Paths.Add(Blueprint->GetPathName());
+		}
+	}
+	Paths.Sort();
+	return Paths;
+}
+
+FString FBlueprintCompileQueue::Enqueue(const TArray<UBlueprint*>& Blueprints)
+{
+	check(IsInGameThread());
+
+	FPendingJob& Pass = Pending.Add_GetRef({ NewJob(false), {} });
+	for (UBlueprint* Blueprint : Blueprints)
+	{
+		if (Blueprint)
+		{
+			Pass.Blueprints.Add(Blueprint);
+			Pass.Job->Requested.Add(Blueprint->GetPathName());
+		}
+	}
+	return Pass.Job->JobId;
+}
+
+void FBlueprintCompileQueue::Flush()
+{
+	check(IsInGameThread());
+
+	if (Pending.Num() > 0)
+	{
+		RunPass(false);
+	}
+}
+
+TSharedPtr<const FBlueprintCompileQueue::FJob> FBlueprintCompileQueue::FindJob(const FString& JobId)
+{
+	for (const FPendingJob& Pass : Pending)
+	{
+		if (Pass.Job->JobId == JobId)
+		{
+			return Pass.Job;
+		}
+	}
+	for (const TSharedRef<FJob>& Job : Finished)
+	{
+		if (Job->JobId == JobId)
+		{
+			return Job;
+		}
+	}
+	return nullptr;
+}
+
+TArray<TSharedRef<const FBlueprintCompileQueue::FJob>> FBlueprintCompileQueue::GetJobs()
+{
+	TArray<TSharedRef<const FJob>> Jobs;
+	Jobs.Reserve(Pending.Num() + Finished.Num());
+	for (const FPendingJob& Pass : Pending)
+	{
+		Jobs.Add(Pass.Job);
+	}
+	for (int32 Index = Finished.Num() - 1; Index >= 0; --Index)
+	{
+		Jobs.Add(Finished[Index]);
+	}
+	return Jobs;
+}
@@ -0,0 +1,559 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Utils/BlueprintSessionCache.h"
+#include "Editor.h"
+#include "BlueprintEditor.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Misc/PackageName.h"
+#include "UObject/ObjectKey.h"
+
+namespace
+{
+	/** A node and the graph it was indexed in, so a hit is validated without scanning Graph->Nodes */
+	struct FIndexedNode
+	{
+		TWeakObjectPtr<UEdGraphNode> Node;
+		TWeakObjectPtr<UEdGraph> Graph;
+	};
+
+	struct FSession
+	{
+		TWeakObjectPtr<UBlueprint> Blueprint;
+
+		/** GetAllGraphs order, and graph name -> graph (FName keys compare case-insensitively) */
+		bool bGraphsValid = false;
+		TArray<TWeakObjectPtr<UEdGraph>> Graphs;
+		TMap<FName, TWeakObjectPtr<UEdGraph>> GraphsByName;
+
+		/** Node GUID -> node, kept current by the graph handlers below */
+		bool bNodesValid = false;
+		TMap<FGuid, FIndexedNode> NodesByGuid;
+
+		/** OnGraphChanged subscription of each graph indexed for nodes */
+		TArray<TPair<TWeakObjectPtr<UEdGraph>, FDelegateHandle>> GraphHandlers;
+
+		/** Blueprint->OnChanged() subscription: graphs added, removed or renamed */
+		FDelegateHandle BlueprintChanged;
+	};
+
+	struct FCacheHandles
+	{
+		FDelegateHandle PostUndoRedo;
+		FDelegateHandle AssetOpened;
+		FDelegateHandle AssetClosed;
+		TWeakObjectPtr<UAssetEditorSubsystem> Subsystem;
+	};
+
+	/** Sessions for Blueprints that are gone are pruned once the map grows past this */
+	constexpr int32 PruneThreshold = 32;
+
+	TMap<FObjectKey, FSession> Sessions;
+	TMap<FString, TWeakObjectPtr<UBlueprint>> BlueprintsByPath;
+	TWeakObjectPtr<UBlueprint> ActiveBlueprint;
+	FCacheHandles Handles;
+	bool bInitialized = false;
+
+	void UnbindGraphs(FSession& Session)
+	{
+		for (const TPair<TWeakObjectPtr<UEdGraph>, FDelegateHandle>& Handler : Session.GraphHandlers)
+		{
+			if (UEdGraph* Graph = Handler.Key.Get())
+			{
+				Graph->RemoveOnGraphChangedHandler(Handler.Value);
+			}
+		}
+		Session.GraphHandlers.Reset();
+	}
+
+	void ReleaseSession(FSession& Session)
+	{
+		UnbindGraphs(Session);
+		if (UBlueprint* Blueprint = Session.Blueprint.Get())
+		{
+			Blueprint->OnChanged().Remove(Session.BlueprintChanged);
+		}
+		Session.BlueprintChanged.Reset();
+	}
+
+	void ReleaseAll()
+	{
+		for (TPair<FObjectKey, FSession>& Pair : Sessions)
+		{
+			ReleaseSession(Pair.Value);
+		}
+		Sessions.Reset();
+	}
+
+	void OnGraphChanged(const FEdGraphEditAction& Action, FObjectKey Key)
+	{
+		FSession* Session = Sessions.Find(Key);
+		if (!Session || !Session->bNodesValid)
+		{
+			return;
+		}
+
+		// Selection and generic "something changed" notifications leave GUIDs alone
+		for (const UEdGraphNode* Node : Action.Nodes)
+		{
+			if (!Node)
+			{
+				continue;
+			}
+			if (Action.Action & GRAPHACTION_RemoveNode)
+			{
+				const FIndexedNode* Found = Session->NodesByGuid.Find(Node->NodeGuid);
+				if (Found && Found->Node.Get() == Node)
+				{
+					Session->NodesByGuid.Remove(Node->NodeGuid);
+				}
+			}
+			else if ((Action.Action & GRAPHACTION_AddNode) && Node->NodeGuid.IsValid())
+			{
+				Session->NodesByGuid.Add(Node->NodeGuid, { const_cast<UEdGraphNode*>(Node), Node->GetGraph() });
+			}
+		}
+	}
+
+	void OnBlueprintChanged(UBlueprint* Blueprint)
+	{
+		if (FSession* Session = Blueprint ? Sessions.Find(FObjectKey(Blueprint)) : nullptr)
+		{
+			Session->bGraphsValid = false;
+		}
+	}
+
+	FSession& FindOrAddSession(UBlueprint* Blueprint)
+	{
+		const FObjectKey Key(Blueprint);
+		if (FSession* Session = Sessions.Find(Key))
+		{
+			return *Session;
+		}
+
+		if (Sessions.Num() >= PruneThreshold)
+		{
+			for (auto It = Sessions.CreateIterator(); It; ++It)
+			{
+				if (!It->Value.Blueprint.IsValid())
+				{
+					ReleaseSession(It->Value);
+					It.RemoveCurrent();
+				}
+			}
+		}
+
+		FSession& Session = Sessions.Add(Key);
+		Session.Blueprint = Blueprint;
+		Session.BlueprintChanged = Blueprint->OnChanged().AddStatic(&OnBlueprintChanged);
+		return Session;
+	}
+
+	/** Add Graph's nodes to the node index and follow its node additions and removals */
+	void IndexGraphNodes(FSession& Session, UEdGraph* Graph, FObjectKey Key)
+	{
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node && Node->NodeGuid.IsValid())
+			{
+				Session.NodesByGuid.Add(Node->NodeGuid, { Node, Graph });
+			}
+		}
+		const FDelegateHandle Handle = Graph->AddOnGraphChangedHandler(
+			FOnGraphChanged::FDelegate::CreateStatic(&OnGraphChanged, Key));
+		Session.GraphHandlers.Emplace(Graph, Handle);
+	}
+
+	/** Drop the nodes indexed for GraphHandlers[Index] and its subscription */
+	void UnindexGraphNodes(FSession& Session, int32 Index)
+	{
+		const TWeakObjectPtr<UEdGraph> Graph = Session.GraphHandlers[Index].Key;
+		if (UEdGraph* Live = Graph.Get())
+		{
+			Live->RemoveOnGraphChangedHandler(Session.GraphHandlers[Index].Value);
+		}
+		Session.GraphHandlers.RemoveAtSwap(Index);
+
+		for (auto It = Session.NodesByGuid.CreateIterator(); It; ++It)
+		{
+			if (It->Value.Graph == Graph)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	void IndexGraphs(FSession& Session, UBlueprint* Blueprint)
+	{
+		TArray<UEdGraph*> AllGraphs;
+		Blueprint->GetAllGraphs(AllGraphs);
+
+		Session.Graphs.Reset(AllGraphs.Num());
+		Session.GraphsByName.Reset();
+		TSet<UEdGraph*> Current;
+		for (UEdGraph* Graph : AllGraphs)
+		{
+			if (Graph && IsValid(Graph))
+			{
+				Session.Graphs.Add(Graph);
+				Session.GraphsByName.FindOrAdd(Graph->GetFName(), Graph);
+				Current.Add(Graph);
+			}
+		}
+		Session.bGraphsValid = true;
+
+		if (!Session.bNodesValid)
+		{
+			return;
+		}
+
+		// Only graphs that came or went touch the node index; the others keep their entries
+		TSet<UEdGraph*> Indexed;
+		for (int32 Index = Session.GraphHandlers.Num() - 1; Index >= 0; --Index)
+		{
+			UEdGraph* Graph = Session.GraphHandlers[Index].Key.Get();
+			if (Graph && Current.Contains(Graph))
+			{
+				Indexed.Add(Graph);
+			}
+			else
+			{
+				UnindexGraphNodes(Session, Index);
+			}
+		}
+
+		const FObjectKey Key(Blueprint);
+		for (UEdGraph* Graph : Current)
+		{
+			if (!Indexed.Contains(Graph))
+			{
+				IndexGraphNodes(Session, Graph, Key);
+			}
+		}
+	}
+
+	void EnsureGraphs(FSession& Session, UBlueprint* Blueprint)
+	{
+		if (!Session.bGraphsValid)
+		{
+			IndexGraphs(Session, Blueprint);
+		}
+	}
+
+	void IndexNodes(FSession& Session, UBlueprint* Blueprint)
+	{
+		EnsureGraphs(Session, Blueprint);
+		UnbindGraphs(Session);
+		Session.NodesByGuid.Reset();
+
+		const FObjectKey Key(Blueprint);
+		for (const TWeakObjectPtr<UEdGraph>& WeakGraph : Session.Graphs)
+		{
+			if (UEdGraph* Graph = WeakGraph.Get())
+			{
+				IndexGraphNodes(Session, Graph, Key);
+			}
+		}
+		Session.bNodesValid = true;
+
+		UE_LOG(LogTemp, Verbose, TEXT("BlueprintSessionCache: Indexed %d nodes in %d graphs of %s"),
+			Session.NodesByGuid.Num(), Session.Graphs.Num(), *Blueprint->GetName());
+	}
+
+	/**
+	 * Live node indexed under Guid that still belongs to Blueprint. Removals are
+	 * evicted by OnGraphChanged, so a hit needs no scan of the graph's nodes.
+	 */
+	UEdGraphNode* FindInSession(const FSession& Session, UBlueprint* Blueprint, const FGuid& Guid)
+	{
+		const FIndexedNode* Found = Session.NodesByGuid.Find(Guid);
+		UEdGraphNode* Node = Found ? Found->Node.Get() : nullptr;
+		if (Node && IsValid(Node) && Node->NodeGuid == Guid)
+		{
+			UEdGraph* Graph = Found->Graph.Get();
+			if (Graph && Node->GetGraph() == Graph && Node->GetTypedOuter<UBlueprint>() == Blueprint)
+			{
+				return Node;
+			}
+		}
+		return nullptr;
+	}
+
+	bool IsBlueprintEditor(IAssetEditorInstance* Editor)
+	{
+		return Editor && Editor->GetEditorName() == TEXT("BlueprintEditor");
+	}
+
+	/** Watch editors opening and closing; the subsystem only exists once GEditor does */
+	void BindSubsystem(UAssetEditorSubsystem* Subsystem)
+	{
+		if (Handles.Subsystem.Get() == Subsystem)
+		{
+			return;
+		}
+		Handles.Subsystem = Subsystem;
+		Handles.AssetOpened = Subsystem->OnAssetOpenedInEditor().AddLambda([](UObject*, IAssetEditorInstance*)
+		{
+			ActiveBlueprint = nullptr;
+		});
+		Handles.AssetClosed = Subsystem->OnAssetClosedInEditor().AddLambda([](UObject* Asset, IAssetEditorInstance*)
+		{
+			ActiveBlueprint = nullptr;
+			if (FSession* Session = Asset ? Sessions.Find(FObjectKey(Asset)) : nullptr)
+			{
+				ReleaseSession(*Session);
+				Sessions.Remove(FObjectKey(Asset));
+			}
+		});
+	}
+
+	/** "/Game/BP/BP_Door" -> "/Game/BP/BP_Door.BP_Door"; object paths are returned unchanged */
+	FString ToObjectPath(const FString& BlueprintPath)
+	{
+		if (BlueprintPath.Contains(TEXT(".")))
+		{
+			return BlueprintPath;
+		}
+		return BlueprintPath + TEXT(".") + FPackageName::GetShortName(BlueprintPath);
+	}
+
+	UBlueprint* FindBlueprintByPath(const FString& BlueprintPath)
+	{
+		if (const TWeakObjectPtr<UBlueprint>* Cached = BlueprintsByPath.Find(BlueprintPath))
+		{
+			if (UBlueprint* Blueprint = Cached->Get())
+			{
+				return Blueprint;
+			}
+			BlueprintsByPath.Remove(BlueprintPath);
+		}
+
+		// Only loaded Blueprints can be open in an editor, so never load here
+		UBlueprint* Blueprint = FindObject<UBlueprint>(nullptr, *ToObjectPath(BlueprintPath));
+		if (Blueprint)
+		{
+			BlueprintsByPath.Add(BlueprintPath, Blueprint);
+		}
+		return Blueprint;
+	}
+}
+
+void FBlueprintSessionCache::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	// Undo can put back or take out nodes and graphs without a graph notification
+	Handles.PostUndoRedo = FEditorDelegates::PostUndoRedo.AddLambda([]() { ReleaseAll(); });
+}
+
+void FBlueprintSessionCache::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	FEditorDelegates::PostUndoRedo.Remove(Handles.PostUndoRedo);
+	if (UAssetEditorSubsystem* Subsystem = Handles.Subsystem.Get())
+	{
+		Subsystem->OnAssetOpenedInEditor().Remove(Handles.AssetOpened);
+		Subsystem->OnAssetClosedInEditor().Remove(Handles.AssetClosed);
+	}
+
+	ReleaseAll();
+	BlueprintsByPath.Empty();
+	ActiveBlueprint = nullptr;
+	Handles = FCacheHandles();
+}
+
+FBlueprintEditor* FBlueprintSessionCache::FindEditor(const FString& BlueprintPath, UBlueprint*& OutBlueprint, FString& OutErrorCode)
+{
+	check(IsInGameThread());
+	OutBlueprint = nullptr;
+
+	if (!GEditor)
+	{
+		OutErrorCode = TEXT("NO_EDITOR");
+		return nullptr;
+	}
+
+	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+	if (!AssetEditorSubsystem)
+	{
+		OutErrorCode = TEXT("NO_SUBSYSTEM");
+		return nullptr;
+	}
+	BindSubsystem(AssetEditorSubsystem);
+
+	if (!BlueprintPath.IsEmpty())
+	{
+		UBlueprint* Blueprint = FindBlueprintByPath(BlueprintPath);
+		IAssetEditorInstance* Editor = Blueprint ? AssetEditorSubsystem->FindEditorForAsset(Blueprint, false) : nullptr;
+		if (!IsBlueprintEditor(Editor))
+		{
+			OutErrorCode = TEXT("NO_BLUEPRINT_EDITOR");
+			return nullptr;
+		}
+		OutBlueprint = Blueprint;
+		return static_cast<FBlueprintEditor*>(Editor);
+	}
+
+	// Remembered until an editor opens or closes; FindEditorForAsset is a map lookup
+	if (UBlueprint* Blueprint = ActiveBlueprint.Get())
+	{
+		IAssetEditorInstance* Editor = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false);
+		if (IsBlueprintEditor(Editor))
+		{
+			OutBlueprint = Blueprint;
+			return static_cast<FBlueprintEditor*>(Editor);
+		}
+		ActiveBlueprint = nullptr;
+	}
+
+	for (UObject* Asset : AssetEditorSubsystem->GetAllEditedAssets())
+	{
+		UBlueprint* Blueprint = Cast<UBlueprint>(Asset);
+		if (!Blueprint)
+		{
+			continue;
+		}
+		IAssetEditorInstance* Editor = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false);
+		if (IsBlueprintEditor(Editor))
+		{
+			ActiveBlueprint = Blueprint;
+			OutBlueprint = Blueprint;
+			return static_cast<FBlueprintEditor*>(Editor);
+		}
+	}
+
+	OutErrorCode = TEXT("NO_BLUEPRINT_EDITOR");
+	return nullptr;
+}
+
+TArray<UEdGraph*> FBlueprintSessionCache::GetGraphs(UBlueprint* Blueprint)
+{
+	check(IsInGameThread());
+
+	TArray<UEdGraph*> Graphs;
+	if (!Blueprint)
+	{
+		return Graphs;
+	}
+
+	FSession& Session = FindOrAddSession(Blueprint);
+	EnsureGraphs(Session, Blueprint);
+
+	Graphs.Reserve(Session.Graphs.Num());
+	for (const TWeakObjectPtr<UEdGraph>& WeakGraph : Session.Graphs)
+	{
+		UEdGraph* Graph = WeakGraph.Get();
+		if (!Graph || !IsValid(Graph))
+		{
+			// Removed without a Blueprint change notification
+			Graphs.Reset();
+			IndexGraphs(Session, Blueprint);
+			for (const TWeakObjectPtr<UEdGraph>& Reindexed : Session.Graphs)
+			{
+				Graphs.Add(Reindexed.Get());
+			}
+			break;
+		}
+		Graphs.Add(Graph);
+	}
+	return Graphs;
+}
+
+UEdGraph* FBlueprintSessionCache::FindGraph(UBlueprint* Blueprint, const FString& GraphName)
+{
+	check(IsInGameThread());
+
+	if (!Blueprint)
+	{
+		return nullptr;
+	}
+
+	// No FName entry means no graph can have this name
+	const FName Key(*GraphName, FNAME_Find);
+	if (!GraphName.IsEmpty() && !Key.IsNone())
+	{
+		FSession& Session = FindOrAddSession(Blueprint);
+		const bool bFresh = !Session.bGraphsValid;
+		if (bFresh)
+		{
+			IndexGraphs(Session, Blueprint);
+		}
+
+		auto FindLive = [&Session, Key]() -> UEdGraph*
+		{
+			const TWeakObjectPtr<UEdGraph>* Found = Session.GraphsByName.Find(Key);
+			UEdGraph* Graph = Found ? Found->Get() : nullptr;
+			return Graph && IsValid(Graph) && Graph->GetFName() == Key ? Graph : nullptr;
+		};
+
+		UEdGraph* Graph = FindLive();
+
+		// Stale entry or an unreported rename: rebuild and look again
+		if (!Graph && !bFresh)
+		{
+			IndexGraphs(Session, Blueprint);
+			Graph = FindLive();
+		}
+		if (Graph)
+		{
+			return Graph;
+		}
+	}
+
+	if (GraphName.IsEmpty() || GraphName == TEXT("EventGraph"))
+	{
+		if (Blueprint->UbergraphPages.Num() > 0)
+		{
+			return Blueprint->UbergraphPages[0];
+		}
+	}
+
+	return nullptr;
+}
+
+UEdGraphNode* FBlueprintSessionCache::FindNode(UBlueprint* Blueprint, const FGuid& NodeGuid)
+{
+	check(IsInGameThread());
+
+	if (!Blueprint || !NodeGuid.IsValid())
+	{
+		return nullptr;
+	}
+
+	FSession& Session = FindOrAddSession(Blueprint);
+	const bool bFresh = !Session.bNodesValid || !Session.bGraphsValid;
+	if (bFresh)
+	{
+		IndexNodes(Session, Blueprint);
+	}
+
+	UEdGraphNode* Node = FindInSession(Session, Blueprint, NodeGuid);
+
+	// Stale entry or a change no graph reported: rebuild from scratch and look again
+	if (!Node && !bFresh)
+	{
+		IndexNodes(Session, Blueprint);
+		Node = FindInSession(Session, Blueprint, NodeGuid);
+	}
+	return Node;
+}
+
+void FBlueprintSessionCache::Invalidate(UBlueprint* Blueprint)
+{
+	if (FSession* Session = Blueprint ? Sessions.Find(FObjectKey(Blueprint)) : nullptr)
+	{
+		Session->bGraphsValid = false;
+		Session->bNodesValid = false;
+	}
+}
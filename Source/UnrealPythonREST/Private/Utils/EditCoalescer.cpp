@@ -0,0 +1,139 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Utils/EditCoalescer.h"
+#include "ScopedTransaction.h"
+#include "UObject/ObjectKey.h"
+
+namespace
+{
+	struct FDeferredEdit
+	{
+		TWeakObjectPtr<UObject> Object;
+		FEditCoalescer::EPhase Phase;
+		TFunction<void()> Action;
+	};
+
+	/** Open scopes; only touched on the game thread */
+	int32 ScopeDepth = 0;
+
+	TArray<FDeferredEdit> Pending;
+	TSet<TTuple<FObjectKey, FName>> PendingKeys;
+	TSet<FObjectKey> PreEditedObjects;
+
+	int32 FlushPending()
+	{
+		// Drain into a local so actions that edit further run immediately
+		TArray<FDeferredEdit> Edits = MoveTemp(Pending);
+		Pending.Reset();
+		PendingKeys.Reset();
+		PreEditedObjects.Reset();
+
+		Edits.StableSort([](const FDeferredEdit& A, const FDeferredEdit& B)
+		{
+			return A.Phase < B.Phase;
+		});
+
+		int32 Count = 0;
+		for (FDeferredEdit& Edit : Edits)
+		{
+			if (Edit.Object.IsValid())
+			{
+				Edit.Action();
+				Count++;
+			}
+		}
+		return Count;
+	}
+}
+
+FEditCoalescer::FScope::FScope(const FText& Description)
+{
+	check(IsInGameThread());
+
+	bOutermost = ScopeDepth == 0;
+	ScopeDepth++;
+
+	if (bOutermost)
+	{
+		Transaction = MakeUnique<FScopedTransaction>(Description);
+	}
+}
+
+FEditCoalescer::FScope::~FScope()
+{
+	Close();
+}
+
+int32 FEditCoalescer::FScope::Close()
+{
+	if (bClosed)
+	{
+		return FlushedCount;
+	}
+	bClosed = true;
+
+	ScopeDepth--;
+	if (bOutermost)
+	{
+		// Flush inside the transaction so any Modify() done by the deferred work is recorded with the batch
+		FlushedCount = FlushPending();
+		Transaction.Reset();
+
+		UE_LOG(LogTemp, Log, TEXT("EditCoalescer: Flushed %d deferred edits"), FlushedCount);
+	}
+	return FlushedCount;
+}
+
+bool FEditCoalescer::IsCoalescing()
+{
+	return ScopeDepth > 0 && IsInGameThread();
+}
+
+void FEditCoalescer::Run(UObject* Object, FName Key, EPhase Phase, TFunction<void()> Action)
+{
+	if (!Object)
+	{
+		return;
+	}
+
+	if (!IsCoalescing())
+	{
+		Action();
+		return;
+	}
+
+	bool bAlreadyPending = false;
+	PendingKeys.Add(MakeTuple(FObjectKey(Object), Key), &bAlreadyPending);
+	if (!bAlreadyPending)
+	{
+		Pending.Add({ Object, Phase, MoveTemp(Action) });
+	}
+}
+
+void FEditCoalescer::PreEditChange(UObject* Object)
+{
+	if (!Object)
+	{
+		return;
+	}
+
+	if (IsCoalescing())
+	{
+		bool bAlreadyPreEdited = false;
+		PreEditedObjects.Add(FObjectKey(Object), &bAlreadyPreEdited);
+		if (bAlreadyPreEdited)
+		{
+			return;
+		}
+	}
+
+	Object->PreEditChange(nullptr);
+}
+
+void FEditCoalescer::PostEditChange(UObject* Object)
+{
+	Run(Object, TEXT("PostEditChange"), EPhase::Update, [Object]()
+	{
+		Object->PostEditChange();
+	});
+}
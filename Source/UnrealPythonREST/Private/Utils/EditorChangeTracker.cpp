@@ -0,0 +1,195 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Utils/EditorChangeTracker.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Selection.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/Package.h"
+#include "UObject/ObjectSaveContext.h"
+#include <atomic>
+
+namespace
+{
+	constexpr int32 NumChangeKinds = 4;
+
+	std::atomic<uint64> Generations[NumChangeKinds];
+
+	struct FTrackerHandles
+	{
+		FDelegateHandle ActorAdded;
+		FDelegateHandle ActorDeleted;
+		FDelegateHandle ActorMoved;
+		FDelegateHandle ActorLabelChanged;
+		FDelegateHandle MapChange;
+		FDelegateHandle MapOpened;
+		FDelegateHandle PostUndoRedo;
+		FDelegateHandle SelectionChanged;
+		FDelegateHandle SelectObject;
+		FDelegateHandle AssetAdded;
+		FDelegateHandle AssetRemoved;
+		FDelegateHandle AssetRenamed;
+		FDelegateHandle PackageSaved;
+		FDelegateHandle PackageDirty;
+		FDelegateHandle ObjectModified;
+		FDelegateHandle ObjectPropertyChanged;
+		FDelegateHandle AssetEditorOpened;
+		FDelegateHandle AssetEditorClosed;
+	};
+
+	FTrackerHandles Handles;
+	bool bInitialized = false;
+
+	void BumpWorld() { FEditorChangeTracker::Bump(EEditorChange::World); }
+	void BumpSelection() { FEditorChangeTracker::Bump(EEditorChange::Selection); }
+	void BumpAssets() { FEditorChangeTracker::Bump(EEditorChange::Assets); }
+	void BumpObjects() { FEditorChangeTracker::Bump(EEditorChange::Objects); }
+}
+
+void FEditorChangeTracker::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	if (GEngine)
+	{
+		Handles.ActorAdded = GEngine->OnLevelActorAdded().AddLambda([](AActor*) { BumpWorld(); });
+		Handles.ActorDeleted = GEngine->OnLevelActorDeleted().AddLambda([](AActor*) { BumpWorld(); });
+		Handles.ActorMoved = GEngine->OnActorMoved().AddLambda([](AActor*) { BumpWorld(); });
+	}
+
+	Handles.ActorLabelChanged = FCoreDelegates::OnActorLabelChanged.AddLambda([](AActor*) { BumpWorld(); });
+	Handles.MapChange = FEditorDelegates::MapChange.AddLambda([](uint32) { BumpWorld(); });
+	Handles.MapOpened = FEditorDelegates::OnMapOpened.AddLambda([](const FString&, bool) { BumpWorld(); });
+	Handles.PostUndoRedo = FEditorDelegates::PostUndoRedo.AddLambda([]() { BumpWorld(); BumpObjects(); });
+
+	Handles.SelectionChanged = USelection::SelectionChangedEvent.AddLambda([](UObject*) { BumpSelection(); });
+	Handles.SelectObject = USelection::SelectObjectEvent.AddLambda([](UObject*) { BumpSelection(); });
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	Handles.AssetAdded = AssetRegistry.OnAssetAdded().AddLambda([](const FAssetData&) { BumpAssets(); });
+	Handles.AssetRemoved = AssetRegistry.OnAssetRemoved().AddLambda([](const FAssetData&) { BumpAssets(); });
+	Handles.AssetRenamed = AssetRegistry.OnAssetRenamed().AddLambda([](const FAssetData&, const FString&) { BumpAssets(); });
+
+	Handles.PackageSaved = UPackage::PackageSavedWithContextEvent.AddLambda([](const FString&, UPackage*, FObjectPostSaveContext) { BumpAssets(); });
+	Handles.PackageDirty = UPackage::PackageMarkedDirtyEvent.AddLambda([](UPackage*, bool) { BumpAssets(); });
+
+	Handles.ObjectModified = FCoreUObjectDelegates::OnObjectModified.AddLambda([](UObject*) { BumpObjects(); });
+	Handles.ObjectPropertyChanged = FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda([](UObject*, FPropertyChangedEvent&) { BumpObjects(); });
+
+	// Editor graph reads (material connections, blueprint nodes) fail once their editor closes
+	if (UAssetEditorSubsystem* AssetEditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr)
+	{
+		Handles.AssetEditorOpened = AssetEditorSubsystem->OnAssetEditorOpened().AddLambda([](UObject*) { BumpObjects(); });
+		Handles.AssetEditorClosed = AssetEditorSubsystem->OnAssetClosedInEditor().AddLambda([](UObject*, IAssetEditorInstance*) { BumpObjects(); });
+	}
+}
+
+void FEditorChangeTracker::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(Handles.ActorAdded);
+		GEngine->OnLevelActorDeleted().Remove(Handles.ActorDeleted);
+		GEngine->OnActorMoved().Remove(Handles.ActorMoved);
+	}
+
+	FCoreDelegates::OnActorLabelChanged.Remove(Handles.ActorLabelChanged);
+	FEditorDelegates::MapChange.Remove(Handles.MapChange);
+	FEditorDelegates::OnMapOpened.Remove(Handles.MapOpened);
+	FEditorDelegates::PostUndoRedo.Remove(Handles.PostUndoRedo);
+
+	USelection::SelectionChangedEvent.Remove(Handles.SelectionChanged);
+	USelection::SelectObjectEvent.Remove(Handles.SelectObject);
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(Handles.AssetAdded);
+		AssetRegistry.OnAssetRemoved().Remove(Handles.AssetRemoved);
+		AssetRegistry.OnAssetRenamed().Remove(Handles.AssetRenamed);
+	}
+
+	UPackage::PackageSavedWithContextEvent.Remove(Handles.PackageSaved);
+	UPackage::PackageMarkedDirtyEvent.Remove(Handles.PackageDirty);
+
+	FCoreUObjectDelegates::OnObjectModified.Remove(Handles.ObjectModified);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(Handles.ObjectPropertyChanged);
+
+	if (UAssetEditorSubsystem* AssetEditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr)
+	{
+		AssetEditorSubsystem->OnAssetEditorOpened().Remove(Handles.AssetEditorOpened);
+		AssetEditorSubsystem->OnAssetClosedInEditor().Remove(Handles.AssetEditorClosed);
+	}
+
+	Handles = FTrackerHandles();
+}
+
+uint64 FEditorChangeTracker::GetGeneration(EEditorChange Changes)
+{
+	// Each counter only increases, so the sum changes whenever any selected counter does
+	uint64 Sum = 0;
+	for (int32 Index = 0; Index < NumChangeKinds; ++Index)
+	{
+		if (EnumHasAnyFlags(Changes, static_cast<EEditorChange>(1 << Index)))
+		{
+			Sum += Generations[Index].load(std::memory_order_relaxed);
+		}
+	}
+	return Sum;
+}
+
+void FEditorChangeTracker::Bump(EEditorChange Changes)
+{
+	for (int32 Index = 0; Index < NumChangeKinds; ++Index)
+	{
+		if (EnumHasAnyFlags(Changes, static_cast<EEditorChange>(1 << Index)))
+		{
+			Generations[Index].fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+}
+
+FRESTRouteVersion FEditorChangeTracker::MakeRouteVersion(EEditorChange Changes)
+{
+	return FRESTRouteVersion::CreateLambda([Changes](const FRESTRequest&) -> uint64
+	{
+		// +1 keeps the token non-zero (zero means "no version") before the first change
+		return GetGeneration(Changes) + 1;
+	});
+}
+
+FRESTRouteHandler FEditorChangeTracker::BumpAfter(EEditorChange Changes, FRESTRouteHandler Handler)
+{
+	return FRESTRouteHandler::CreateLambda([Changes, Handler = MoveTemp(Handler)](const FRESTRequest& Request) -> FRESTResponse
+	{
+		FRESTResponse Response = Handler.Execute(Request);
+		if (!Response.Deferred)
+		{
+			Bump(Changes);
+			return Response;
+		}
+
+		Response.Deferred = [Changes, Start = MoveTemp(Response.Deferred)](FRESTResponder Responder)
+		{
+			Start([Changes, Responder = MoveTemp(Responder)](FRESTResponse&& Final)
+			{
+				Bump(Changes);
+				Responder(MoveTemp(Final));
+			});
+		};
+		return Response;
+	});
+}
@@ -0,0 +1,449 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Utils/EditorEventFeed.h"
+#include "Utils/ActorUtils.h"
+#include "Utils/JsonHelpers.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Selection.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Containers/Ticker.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/Package.h"
+#include "UObject/ObjectSaveContext.h"
+
+static TAutoConsoleVariable<int32> CVarEventBufferSize(
+	TEXT("UnrealPythonREST.EventBufferSize"),
+	4096,
+	TEXT("Events kept for GET /events clients. A client further behind than this gets reset=true and must re-read full state."));
+
+static TAutoConsoleVariable<int32> CVarEventMaxWaiters(
+	TEXT("UnrealPythonREST.EventMaxWaiters"),
+	32,
+	TEXT("GET /events long polls that may be open at once; further requests get 503."));
+
+namespace
+{
+	struct FEvent
+	{
+		uint64 Sequence = 0;
+		EEditorEventTopic Topic = EEditorEventTopic::None;
+		FString Type;
+		FString Key;
+		TSharedPtr<FJsonObject> Data;
+		FDateTime Time;
+
+		/** A later event with the same topic, type and key replaced this one */
+		bool bSuperseded = false;
+	};
+
+	struct FWaiter
+	{
+		EEditorEventTopic Topics = EEditorEventTopic::None;
+		uint64 Since = 0;
+		int32 MaxEvents = 0;
+		double Deadline = 0.0;
+		FRESTResponder Responder;
+
+		/** Newest sequence already scanned for this waiter, to skip idle ticks */
+		uint64 CheckedSequence = 0;
+	};
+
+	struct FFeedHandles
+	{
+		FDelegateHandle ActorAdded;
+		FDelegateHandle ActorDeleted;
+		FDelegateHandle ActorMoved;
+		FDelegateHandle ActorLabelChanged;
+		FDelegateHandle SelectionChanged;
+		FDelegateHandle SelectObject;
+		FDelegateHandle AssetAdded;
+		FDelegateHandle AssetRemoved;
+		FDelegateHandle AssetRenamed;
+		FDelegateHandle PackageSaved;
+		FTSTicker::FDelegateHandle Ticker;
+	};
+
+	/** Topic names in bit order */
+	const TCHAR* const TopicNames[] = { TEXT("actors"), TEXT("selection"), TEXT("jobs"), TEXT("live_coding"), TEXT("camera"), TEXT("assets") };
+
+	FCriticalSection Lock;
+
+	/** Retained events in sequence order; Events[I].Sequence == FirstSequence + I */
+	TArray<FEvent> Events;
+	uint64 FirstSequence = 1;
+	uint64 LastSequence = 0;
+
+	/** Coalescing key -> sequence of the newest event with it */
+	TMap<FString, uint64> LatestByKey;
+
+	/** Open long polls (game thread only) */
+	TArray<FWaiter> Waiters;
+
+	FFeedHandles Handles;
+	bool bInitialized = false;
+
+	const TCHAR* TopicName(EEditorEventTopic Topic)
+	{
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(TopicNames); ++Index)
+		{
+			if (Topic == static_cast<EEditorEventTopic>(1 << Index))
+			{
+				return TopicNames[Index];
+			}
+		}
+		return TEXT("unknown");
+	}
+
+	/** Only actors in the editor world; PIE and preview worlds are noise to clients */
+	bool IsEditorWorldActor(const AActor* Actor)
+	{
+		return Actor && Actor->GetWorld() && Actor->GetWorld() == ActorUtils::GetEditorWorld();
+	}
+
+	void PostActorEvent(const TCHAR* Type, AActor* Actor, bool bWithLocation)
+	{
+		if (!IsEditorWorldActor(Actor))
+		{
+			return;
+		}
+
+		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+		Data->SetStringField(TEXT("label"), Actor->GetActorLabel());
+		Data->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
+		if (bWithLocation)
+		{
+			Data->SetObjectField(TEXT("location"), JsonHelpers::VectorToJson(Actor->GetActorLocation()));
+		}
+		FEditorEventFeed::Post(EEditorEventTopic::Actors, Type, Actor->GetPathName(), Data);
+	}
+
+	void PostSelectionEvent()
+	{
+		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+		Data->SetNumberField(TEXT("selected_actors"), GEditor ? GEditor->GetSelectedActorCount() : 0);
+		FEditorEventFeed::Post(EEditorEventTopic::Selection, TEXT("changed"), TEXT("selection"), Data);
+	}
+
+	void PostAssetEvent(const TCHAR* Type, const FAssetData& Asset, const FString* OldPath = nullptr)
+	{
+		// The initial registry scan reports every asset in the project; clients only want changes
+		IAssetRegistry* Registry = IAssetRegistry::Get();
+		if (!Registry || Registry->IsLoadingAssets())
+		{
+			return;
+		}
+
+		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+		Data->SetStringField(TEXT("class"), Asset.AssetClassPath.GetAssetName().ToString());
+		if (OldPath)
+		{
+			Data->SetStringField(TEXT("old_path"), *OldPath);
+		}
+		FEditorEventFeed::Post(EEditorEventTopic::Assets, Type, Asset.GetObjectPathString(), Data);
+	}
+
+	/** Events for one waiter, or null while there is nothing to say yet */
+	TSharedPtr<FJsonObject> Collect(EEditorEventTopic Topics, uint64 Since, int32 MaxEvents, bool bForce)
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		// Events after Since were trimmed, or Since comes from an earlier editor session
+		const bool bReset = Since + 1 < FirstSequence || Since > LastSequence;
+
+		TArray<TSharedPtr<FJsonValue>> Found;
+		uint64 Cursor = LastSequence;
+		bool bMore = false;
+
+		if (!bReset)
+		{
+			const int32 Start = Since >= FirstSequence ? static_cast<int32>(Since - FirstSequence + 1) : 0;
+			for (int32 Index = Start; Index < Events.Num(); ++Index)
+			{
+				const FEvent& Event = Events[Index];
+				if (Event.bSuperseded || !EnumHasAnyFlags(Topics, Event.Topic))
+				{
+					continue;
+				}
+
+				if (Found.Num() == MaxEvents)
+				{
+					// Resume right after the last event sent
+					Cursor = Events[Index - 1].Sequence;
+					bMore = true;
+					break;
+				}
+
+				TSharedPtr<FJsonObject> EventJson = MakeShared<FJsonObject>();
+				EventJson->SetNumberField(TEXT("seq"), static_cast<double>(Event.Sequence));
+				EventJson->SetStringField(TEXT("topic"), TopicName(Event.Topic));
+				EventJson->SetStringField(TEXT("type"), Event.Type);
+				if (!Event.Key.IsEmpty())
+				{
+					EventJson->SetStringField(TEXT("key"), Event.Key);
+				}
+				EventJson->SetStringField(TEXT("time"), Event.Time.ToIso8601());
+				if (Event.Data.IsValid())
+				{
+					EventJson->SetObjectField(TEXT("data"), Event.Data);
+				}
+				Found.Add(MakeShared<FJsonValueObject>(EventJson));
+			}
+		}
+
+		if (!bForce && !bReset && Found.Num() == 0)
+		{
+			return nullptr;
+		}
+
+		TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetBoolField(TEXT("success"), true);
+		Result->SetNumberField(TEXT("cursor"), static_cast<double>(Cursor));
+		Result->SetBoolField(TEXT("reset"), bReset);
+		Result->SetBoolField(TEXT("more"), bMore);
+		Result->SetArrayField(TEXT("events"), Found);
+		return Result;
+	}
+
+	void Respond(FWaiter& Waiter, const TSharedPtr<FJsonObject>& Result)
+	{
+		FRESTResponse Response = FRESTResponse::Ok(Result);
+		Response.Headers.Add(TEXT("Cache-Control"), TEXT("no-store"));
+		Waiter.Responder(MoveTemp(Response));
+	}
+
+	bool Tick(float DeltaTime)
+	{
+		if (Waiters.Num() == 0)
+		{
+			return true;
+		}
+
+		const double Now = FPlatformTime::Seconds();
+		const uint64 Newest = FEditorEventFeed::GetSequence();
+
+		for (int32 Index = 0; Index < Waiters.Num(); ++Index)
+		{
+			FWaiter& Waiter = Waiters[Index];
+			const bool bTimedOut = Now >= Waiter.Deadline;
+			if (!bTimedOut && Waiter.CheckedSequence == Newest)
+			{
+				continue;
+			}
+			Waiter.CheckedSequence = Newest;
+
+			TSharedPtr<FJsonObject> Result = Collect(Waiter.Topics, Waiter.Since, Waiter.MaxEvents, bTimedOut);
+			if (Result.IsValid())
+			{
+				Respond(Waiter, Result);
+				Waiters.RemoveAtSwap(Index--);
+			}
+		}
+		return true;
+	}
+}
+
+void FEditorEventFeed::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	if (GEngine)
+	{
+		Handles.ActorAdded = GEngine->OnLevelActorAdded().AddLambda([](AActor* Actor) { PostActorEvent(TEXT("added"), Actor, true); });
+		Handles.ActorDeleted = GEngine->OnLevelActorDeleted().AddLambda([](AActor* Actor) { PostActorEvent(TEXT("deleted"), Actor, false); });
+		Handles.ActorMoved = GEngine->OnActorMoved().AddLambda([](AActor* Actor) { PostActorEvent(TEXT("moved"), Actor, true); });
+	}
+	Handles.ActorLabelChanged = FCoreDelegates::OnActorLabelChanged.AddLambda([](AActor* Actor) { PostActorEvent(TEXT("renamed"), Actor, false); });
+
+	Handles.SelectionChanged = USelection::SelectionChangedEvent.AddLambda([](UObject*) { PostSelectionEvent(); });
+	Handles.SelectObject = USelection::SelectObjectEvent.AddLambda([](UObject*) { PostSelectionEvent(); });
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	Handles.AssetAdded = AssetRegistry.OnAssetAdded().AddLambda([](const FAssetData& Asset) { PostAssetEvent(TEXT("added"), Asset); });
+	Handles.AssetRemoved = AssetRegistry.OnAssetRemoved().AddLambda([](const FAssetData& Asset) { PostAssetEvent(TEXT("removed"), Asset); });
+	Handles.AssetRenamed = AssetRegistry.OnAssetRenamed().AddLambda([](const FAssetData& Asset, const FString& OldPath) { PostAssetEvent(TEXT("renamed"), Asset, &OldPath); });
+	Handles.PackageSaved = UPackage::PackageSavedWithContextEvent.AddLambda([](const FString&, UPackage* Package, FObjectPostSaveContext)
+	{
+		if (Package)
+		{
+			Post(EEditorEventTopic::Assets, TEXT("saved"), Package->GetName());
+		}
+	});
+
+	Handles.Ticker = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&Tick));
+}
+
+void FEditorEventFeed::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(Handles.ActorAdded);
+		GEngine->OnLevelActorDeleted().Remove(Handles.ActorDeleted);
+		GEngine->OnActorMoved().Remove(Handles.ActorMoved);
+	}
+	FCoreDelegates::OnActorLabelChanged.Remove(Handles.ActorLabelChanged);
+
+	USelection::SelectionChangedEvent.Remove(Handles.SelectionChanged);
+	USelection::SelectObjectEvent.Remove(Handles.SelectObject);
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(Handles.AssetAdded);
+		AssetRegistry.OnAssetRemoved().Remove(Handles.AssetRemoved);
+		AssetRegistry.OnAssetRenamed().Remove(Handles.AssetRenamed);
+	}
+	UPackage::PackageSavedWithContextEvent.Remove(Handles.PackageSaved);
+
+	FTSTicker::GetCoreTicker().RemoveTicker(Handles.Ticker);
+	Handles = FFeedHandles();
+
+	// Every parked poll is owed a reply; the router is still running at this point
+	for (FWaiter& Waiter : Waiters)
+	{
+		Waiter.Responder(FRESTResponse::Error(503, TEXT("SHUTTING_DOWN"), TEXT("Server stopped while the poll was waiting")));
+	}
+	Waiters.Empty();
+
+	FScopeLock ScopeLock(&Lock);
+	Events.Empty();
+	LatestByKey.Empty();
+	FirstSequence = LastSequence + 1;
+}
+
+void FEditorEventFeed::Post(EEditorEventTopic Topic, const TCHAR* Type, const FString& Key, TSharedPtr<FJsonObject> Data)
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+
+	FEvent& Event = Events.AddDefaulted_GetRef();
+	Event.Sequence = ++LastSequence;
+	Event.Topic = Topic;
+	Event.Type = Type;
+	Event.Key = Key;
+	Event.Data = MoveTemp(Data);
+	Event.Time = FDateTime::UtcNow();
+
+	if (!Key.IsEmpty())
+	{
+		const FString CoalesceKey = FString::Printf(TEXT("%s|%s|%s"), TopicName(Topic), Type, *Key);
+		uint64& Latest = LatestByKey.FindOrAdd(CoalesceKey, 0);
+		if (Latest >= FirstSequence)
+		{
+			FEvent& Previous = Events[static_cast<int32>(Latest - FirstSequence)];
+			Previous.bSuperseded = true;
+			Previous.Data.Reset();
+		}
+		Latest = Event.Sequence;
+	}
+
+	// Trim in chunks so the front removal is amortized over Capacity posts
+	const int32 Capacity = FMath::Max(CVarEventBufferSize.GetValueOnAnyThread(), 16);
+	if (Events.Num() >= Capacity * 2)
+	{
+		const int32 Removed = Events.Num() - Capacity;
+		Events.RemoveAt(0, Removed);
+		FirstSequence += Removed;
+
+		for (auto It = LatestByKey.CreateIterator(); It; ++It)
+		{
+			if (It.Value() < FirstSequence)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
+
+uint64 FEditorEventFeed::GetSequence()
+{
+	FScopeLock ScopeLock(&Lock);
+	return LastSequence;
+}
+
+bool FEditorEventFeed::ParseTopics(const FString& List, EEditorEventTopic& OutTopics, FString& OutError)
+{
+	OutTopics = EEditorEventTopic::None;
+
+	TArray<FString> Names;
+	List.ParseIntoArray(Names, TEXT(","));
+	for (FString& Name : Names)
+	{
+		Name.TrimStartAndEndInline();
+		if (Name.Equals(TEXT("all"), ESearchCase::IgnoreCase))
+		{
+			OutTopics = EEditorEventTopic::All;
+			continue;
+		}
+
+		bool bFound = false;
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(TopicNames); ++Index)
+		{
+			if (Name.Equals(TopicNames[Index], ESearchCase::IgnoreCase))
+			{
+				OutTopics |= static_cast<EEditorEventTopic>(1 << Index);
+				bFound = true;
+				break;
+			}
+		}
+
+		if (!bFound)
+		{
+			OutError = FString::Printf(TEXT("Unknown topic: %s. Valid topics: %s"), *Name, *FString::Join(TArrayView<const TCHAR* const>(TopicNames), TEXT(", ")));
+			return false;
+		}
+	}
+
+	if (OutTopics == EEditorEventTopic::None)
+	{
+		OutTopics = EEditorEventTopic::All;
+	}
+	return true;
+}
+
+void FEditorEventFeed::Wait(EEditorEventTopic Topics, uint64 Since, double TimeoutSeconds, int32 MaxEvents, FRESTResponder Responder)
+{
+	check(IsInGameThread());
+
+	FWaiter Waiter;
+	Waiter.Topics = Topics;
+	Waiter.Since = Since;
+	Waiter.MaxEvents = FMath::Max(MaxEvents, 1);
+	Waiter.Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+	Waiter.Responder = MoveTemp(Responder);
+	Waiter.CheckedSequence = GetSequence();
+
+	// Anything already pending (or a zero timeout) is answered right away
+	if (TSharedPtr<FJsonObject> Result = Collect(Topics, Since, Waiter.MaxEvents, TimeoutSeconds <= 0.0 || !bInitialized))
+	{
+		Respond(Waiter, Result);
+		return;
+	}
+
+	if (Waiters.Num() >= CVarEventMaxWaiters.GetValueOnGameThread())
+	{
+		Waiter.Responder(FRESTResponse::Error(503, TEXT("TOO_MANY_WAITERS"),
+			FString::Printf(TEXT("%d event clients are already waiting (UnrealPythonREST.EventMaxWaiters)"), Waiters.Num())));
+		return;
+	}
+
+	Waiters.Add(MoveTemp(Waiter));
+}
@@ -1,6 +1,7 @@
 // JsonHelpers.cpp
 #include "Utils/JsonHelpers.h"
 #include "Dom/JsonValue.h"
+#include "RESTJsonWriter.h"
 
 namespace JsonHelpers
 {
@@ -32,6 +33,36 @@ TSharedPtr<FJsonObject> TransformToJson(const FTransform& Transform)
     return Json;
 }
 
+void WriteVector(FRESTJsonWriter& Writer, FStringView Identifier, const FVector& Vector)
+{
+    if (Writer.IsBinary())
+    {
+        Writer.WriteFloatArray(Identifier, { Vector.X, Vector.Y, Vector.Z });
+        return;
+    }
+
+    Writer.WriteObjectStart(Identifier);
+    Writer.WriteValue(TEXT("x"), Vector.X);
+    Writer.WriteValue(TEXT("y"), Vector.Y);
+    Writer.WriteValue(TEXT("z"), Vector.Z);
+    Writer.WriteObjectEnd();
+}
+
+void WriteRotator(FRESTJsonWriter& Writer, FStringView Identifier, const FRotator& Rotator)
+{
+    if (Writer.IsBinary())
+    {
+        Writer.WriteFloatArray(Identifier, { Rotator.Pitch, Rotator.Yaw, Rotator.Roll });
+        return;
+    }
+
+    Writer.WriteObjectStart(Identifier);
+    Writer.WriteValue(TEXT("pitch"), Rotator.Pitch);
+    Writer.WriteValue(TEXT("yaw"), Rotator.Yaw);
+    Writer.WriteValue(TEXT("roll"), Rotator.Roll);
+    Writer.WriteObjectEnd();
+}
+
 bool JsonToVector(const TSharedPtr<FJsonObject>& Json, FVector& OutVector)
 {
     if (!Json.IsValid()) return false;
@@ -228,4 +259,93 @@ TArray<FString> FindSimilarStrings(const FString& Input, const TArray<FString>&
     return Results;
 }
 
+void FStringBKTree::Add(const FString& Value)
+{
+    FString Key = Value.ToLower();
+
+    if (Nodes.Num() == 0)
+    {
+        Nodes.Add({ MoveTemp(Key), Value, {} });
+        return;
+    }
+
+    int32 NodeIndex = 0;
+    for (;;)
+    {
+        const int32 Distance = LevenshteinDistance(Key, Nodes[NodeIndex].Key);
+        if (Distance == 0)
+        {
+            return;
+        }
+
+        const TPair<int32, int32>* Child = Nodes[NodeIndex].Children.FindByPredicate([Distance](const TPair<int32, int32>& Edge)
+        {
+            return Edge.Key == Distance;
+        });
+
+        if (!Child)
+        {
+            const int32 NewIndex = Nodes.Add({ MoveTemp(Key), Value, {} });
+            Nodes[NodeIndex].Children.Add(TPair<int32, int32>(Distance, NewIndex));
+            return;
+        }
+
+        NodeIndex = Child->Value;
+    }
+}
+
+TArray<FString> FStringBKTree::FindSimilar(const FString& Input, int32 MaxResults, int32 MaxDistance) const
+{
+    TArray<FString> Results;
+    if (Nodes.Num() == 0 || MaxResults <= 0)
+    {
+        return Results;
+    }
+
+    const FString InputLower = Input.ToLower();
+
+    // (distance, node index) - node index breaks ties in insertion order
+    TArray<TPair<int32, int32>> Scored;
+    TArray<int32, TInlineAllocator<64>> Stack;
+    Stack.Add(0);
+
+    while (Stack.Num() > 0)
+    {
+        const int32 NodeIndex = Stack.Pop();
+        const FNode& Node = Nodes[NodeIndex];
+        const int32 Distance = LevenshteinDistance(InputLower, Node.Key);
+
+        if (Distance <= MaxDistance)
+        {
+            Scored.Add(TPair<int32, int32>(Distance, NodeIndex));
+        }
+
+        // Only children whose edge is within MaxDistance of this node's distance can match
+        for (const TPair<int32, int32>& Edge : Node.Children)
+        {
+            if (FMath::Abs(Edge.Key - Distance) <= MaxDistance)
+            {
+                Stack.Add(Edge.Value);
+            }
+        }
+    }
+
+    Scored.Sort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B)
+    {
+        return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value;
+    });
+
+    for (int32 i = 0; i < FMath::Min(MaxResults, Scored.Num()); ++i)
+    {
+        Results.Add(Nodes[Scored[i].Value].Value);
+    }
+
+    return Results;
+}
+
+void FStringBKTree::Empty()
+{
+    Nodes.Empty();
+}
+
 } // namespace JsonHelpers
@@ -0,0 +1,668 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Utils/MaterialGraphDiff.h"
+#include "Utils/MaterialGraphIndex.h"
+#include "RESTJsonWriter.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialFunction.h"
+#include "Materials/MaterialExpression.h"
+#include "MaterialEditingLibrary.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Dom/JsonObject.h"
+#include "Hash/CityHash.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+	/** Revisions remembered per graph; older ones answer with a full graph */
+	constexpr int32 MaxSnapshotsPerAsset = 8;
+
+	FCriticalSection CacheLock;
+	TMap<FString, TArray<TSharedRef<const FMaterialGraphSnapshot>>> Cache;
+
+	/** Inputs are links, reported as connections rather than properties */
+	bool IsExpressionInputProperty(const FProperty* Property)
+	{
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		for (const UStruct* Struct = StructProperty ? StructProperty->Struct : nullptr; Struct; Struct = Struct->GetSuperStruct())
+		{
+			if (Struct->GetFName() == TEXT("ExpressionInput"))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool IsSnapshotProperty(const FProperty* Property)
+	{
+		return Property->HasAnyPropertyFlags(CPF_Edit)
+			&& !Property->HasAnyPropertyFlags(CPF_EditConst | CPF_Transient | CPF_Deprecated)
+			&& Property->ArrayDim == 1
+			&& !IsExpressionInputProperty(Property);
+	}
+
+	/** "BaseColor" for MP_BaseColor */
+	FString MaterialPropertyName(int32 Property)
+	{
+		FString Name = StaticEnum<EMaterialProperty>()->GetNameStringByValue(Property);
+		Name.RemoveFromStart(TEXT("MP_"));
+		return Name;
+	}
+
+	EMaterialProperty ParseMaterialProperty(const FString& Name)
+	{
+		const int64 Value = StaticEnum<EMaterialProperty>()->GetValueByNameString(TEXT("MP_") + Name);
+		return Value == INDEX_NONE ? MP_MAX : static_cast<EMaterialProperty>(Value);
+	}
+
+	TConstArrayView<TObjectPtr<UMaterialExpression>> GetExpressions(UMaterial* Material, UMaterialFunction* Function)
+	{
+		if (Material)
+		{
+			return Material->GetExpressions();
+		}
+		return Function ? Function->GetExpressions() : TConstArrayView<TObjectPtr<UMaterialExpression>>();
+	}
+
+	void WriteNode(FRESTJsonWriter& Writer, const FString& Id, const FMaterialGraphSnapshot::FNode& Node)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("id"), Id);
+		Writer.WriteValue(TEXT("class"), Node.Class);
+		Writer.WriteValue(TEXT("x"), Node.X);
+		Writer.WriteValue(TEXT("y"), Node.Y);
+		Writer.WriteObjectStart(TEXT("properties"));
+		for (const TPair<FString, FString>& Property : Node.Properties)
+		{
+			Writer.WriteValue(Property.Key, Property.Value);
+		}
+		Writer.WriteObjectEnd();
+		Writer.WriteObjectEnd();
+	}
+
+	/** Target half of a connection, from its "Target:Input" or "@Property" key */
+	void WriteConnectionTarget(FRESTJsonWriter& Writer, const FString& Key)
+	{
+		if (Key.StartsWith(TEXT("@")))
+		{
+			Writer.WriteValue(TEXT("property"), Key.RightChop(1));
+			return;
+		}
+
+		FString Target;
+		FString Input;
+		Key.Split(TEXT(":"), &Target, &Input, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+		Writer.WriteValue(TEXT("target"), Target);
+		Writer.WriteValue(TEXT("input"), FCString::Atoi(*Input));
+	}
+
+	void WriteConnection(FRESTJsonWriter& Writer, const FString& Key, const FMaterialGraphSnapshot::FConnection& Connection)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("source"), Connection.Source);
+		Writer.WriteValue(TEXT("output"), Connection.Output);
+		WriteConnectionTarget(Writer, Key);
+		Writer.WriteObjectEnd();
+	}
+
+	template <typename ValueType>
+	TArray<FString> SortedKeys(const TMap<FString, ValueType>& Map)
+	{
+		TArray<FString> Keys;
+		Map.GenerateKeyArray(Keys);
+		Keys.Sort();
+		return Keys;
+	}
+
+	/** Patch property values are text; numbers and bools are converted */
+	FString JsonValueToPropertyText(const TSharedPtr<FJsonValue>& Value)
+	{
+		if (!Value.IsValid())
+		{
+			return FString();
+		}
+		switch (Value->Type)
+		{
+		case EJson::Number:
+			return FString::SanitizeFloat(Value->AsNumber());
+		case EJson::Boolean:
+			return Value->AsBool() ? TEXT("True") : TEXT("False");
+		default:
+			return Value->AsString();
+		}
+	}
+
+	bool SetProperties(UMaterialExpression* Expression, const TSharedPtr<FJsonObject>& Properties, FString& OutError)
+	{
+		if (!Properties.IsValid())
+		{
+			return true;
+		}
+
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Properties->Values)
+		{
+			FProperty* Property = FindFProperty<FProperty>(Expression->GetClass(), *Pair.Key);
+			if (!Property || !IsSnapshotProperty(Property))
+			{
+				OutError = FString::Printf(TEXT("'%s' is not an editable property of %s"), *Pair.Key, *Expression->GetClass()->GetName());
+				return false;
+			}
+
+			const FString Text = JsonValueToPropertyText(Pair.Value);
+			Expression->Modify();
+			if (!Property->ImportText_Direct(*Text, Property->ContainerPtrToValuePtr<void>(Expression), Expression, PPF_None))
+			{
+				OutError = FString::Printf(TEXT("Invalid value '%s' for %s.%s"), *Text, *Expression->GetName(), *Pair.Key);
+				return false;
+			}
+
+			FPropertyChangedEvent ChangedEvent(Property);
+			Expression->PostEditChangeProperty(ChangedEvent);
+		}
+		return true;
+	}
+
+	UClass* FindExpressionClass(const FString& ClassName)
+	{
+		UClass* Class = nullptr;
+		if (ClassName.Contains(TEXT("/")))
+		{
+			Class = LoadObject<UClass>(nullptr, *ClassName);
+		}
+		else
+		{
+			const FString Name = ClassName.StartsWith(TEXT("MaterialExpression")) ? ClassName : TEXT("MaterialExpression") + ClassName;
+			Class = FindObject<UClass>(nullptr, *FString::Printf(TEXT("/Script/Engine.%s"), *Name));
+		}
+		return Class && Class->IsChildOf(UMaterialExpression::StaticClass()) && !Class->HasAnyClassFlags(CLASS_Abstract) ? Class : nullptr;
+	}
+}
+
+TSharedRef<const FMaterialGraphSnapshot> FMaterialGraphSnapshot::Capture(UMaterial* Material, UMaterialFunction* Function)
+{
+	TSharedRef<FMaterialGraphSnapshot> Snapshot = MakeShared<FMaterialGraphSnapshot>();
+	const TConstArrayView<TObjectPtr<UMaterialExpression>> Expressions = GetExpressions(Material, Function);
+	Snapshot->Nodes.Reserve(Expressions.Num());
+
+	FString ValueText;
+	for (UMaterialExpression* Expression : Expressions)
+	{
+		if (!Expression)
+		{
+			continue;
+		}
+
+		const FString Name = Expression->GetName();
+		FNode& Node = Snapshot->Nodes.Add(Name);
+		Node.Class = Expression->GetClass()->GetName();
+		Node.X = Expression->MaterialExpressionEditorX;
+		Node.Y = Expression->MaterialExpressionEditorY;
+
+		for (TFieldIterator<FProperty> It(Expression->GetClass()); It; ++It)
+		{
+			if (IsSnapshotProperty(*It))
+			{
+				ValueText.Reset();
+				It->ExportTextItem_Direct(ValueText, It->ContainerPtrToValuePtr<void>(Expression), nullptr, Expression, PPF_None);
+				Node.Properties.Add(It->GetName(), ValueText);
+			}
+		}
+
+		for (int32 InputIndex = 0; FExpressionInput* Input = Expression->GetInput(InputIndex); ++InputIndex)
+		{
+			if (Input->Expression)
+			{
+				Snapshot->Connections.Add(FString::Printf(TEXT("%s:%d"), *Name, InputIndex), { Input->Expression->GetName(), Input->OutputIndex });
+			}
+		}
+	}
+
+	if (Material)
+	{
+		for (int32 Property = 0; Property < MP_MAX; ++Property)
+		{
+			FExpressionInput* Input = Material->GetExpressionInputForProperty(static_cast<EMaterialProperty>(Property));
+			if (Input && Input->Expression)
+			{
+				Snapshot->Connections.Add(TEXT("@") + MaterialPropertyName(Property), { Input->Expression->GetName(), Input->OutputIndex });
+			}
+		}
+	}
+
+	// Hash in sorted order so the revision does not depend on expression order
+	uint64 Hash = 0;
+	FString Line;
+	for (const FString& Id : SortedKeys(Snapshot->Nodes))
+	{
+		const FNode& Node = Snapshot->Nodes[Id];
+		Line = FString::Printf(TEXT("%s|%s|%d|%d"), *Id, *Node.Class, Node.X, Node.Y);
+		for (const FString& Key : SortedKeys(Node.Properties))
+		{
+			Line += TEXT("|") + Key + TEXT("=") + Node.Properties[Key];
+		}
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(*Line), Line.Len() * sizeof(TCHAR), Hash);
+	}
+	for (const FString& Key : SortedKeys(Snapshot->Connections))
+	{
+		const FConnection& Connection = Snapshot->Connections[Key];
+		Line = FString::Printf(TEXT("%s<%s:%d"), *Key, *Connection.Source, Connection.Output);
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(*Line), Line.Len() * sizeof(TCHAR), Hash);
+	}
+	Snapshot->Revision = FString::Printf(TEXT("%016llx"), Hash);
+
+	return Snapshot;
+}
+
+void FMaterialGraphSnapshot::WriteJson(FRESTJsonWriter& Writer) const
+{
+	Writer.WriteArrayStart(TEXT("nodes"));
+	for (const FString& Id : SortedKeys(Nodes))
+	{
+		WriteNode(Writer, Id, Nodes[Id]);
+	}
+	Writer.WriteArrayEnd();
+
+	Writer.WriteArrayStart(TEXT("connections"));
+	for (const FString& Key : SortedKeys(Connections))
+	{
+		WriteConnection(Writer, Key, Connections[Key]);
+	}
+	Writer.WriteArrayEnd();
+}
+
+void FMaterialGraphSnapshot::WriteDiffJson(FRESTJsonWriter& Writer, const FMaterialGraphSnapshot& Base) const
+{
+	const TArray<FString> Ids = SortedKeys(Nodes);
+
+	// A node whose class changed under the same name is reported as removed and added
+	auto IsNew = [&Base](const FString& Id, const FNode& Node)
+	{
+		const FNode* Old = Base.Nodes.Find(Id);
+		return !Old || Old->Class != Node.Class;
+	};
+
+	Writer.WriteArrayStart(TEXT("added"));
+	for (const FString& Id : Ids)
+	{
+		if (IsNew(Id, Nodes[Id]))
+		{
+			WriteNode(Writer, Id, Nodes[Id]);
+		}
+	}
+	Writer.WriteArrayEnd();
+
+	Writer.WriteArrayStart(TEXT("removed"));
+	for (const FString& Id : SortedKeys(Base.Nodes))
+	{
+		const FNode* Current = Nodes.Find(Id);
+		if (!Current || Current->Class != Base.Nodes[Id].Class)
+		{
+			Writer.WriteValue(Id);
+		}
+	}
+	Writer.WriteArrayEnd();
+
+	Writer.WriteArrayStart(TEXT("changed"));
+	for (const FString& Id : Ids)
+	{
+		const FNode& Node = Nodes[Id];
+		if (IsNew(Id, Node))
+		{
+			continue;
+		}
+
+		const FNode& Old = Base.Nodes[Id];
+		const bool bMoved = Node.X != Old.X || Node.Y != Old.Y;
+
+		TArray<FString> ChangedProperties;
+		for (const TPair<FString, FString>& Property : Node.Properties)
+		{
+			const FString* OldValue = Old.Properties.Find(Property.Key);
+			if (!OldValue || *OldValue != Property.Value)
+			{
+				ChangedProperties.Add(Property.Key);
+			}
+		}
+		if (!bMoved && ChangedProperties.Num() == 0)
+		{
+			continue;
+		}
+		ChangedProperties.Sort();
+
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("id"), Id);
+		if (bMoved)
+		{
+			Writer.WriteValue(TEXT("x"), Node.X);
+			Writer.WriteValue(TEXT("y"), Node.Y);
+		}
+		if (ChangedProperties.Num() > 0)
+		{
+			Writer.WriteObjectStart(TEXT("properties"));
+			for (const FString& Key : ChangedProperties)
+			{
+				Writer.WriteValue(Key, Node.Properties[Key]);
+			}
+			Writer.WriteObjectEnd();
+		}
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteArrayEnd();
+
+	// A relinked input appears in connections_added only; it replaces the old link
+	Writer.WriteArrayStart(TEXT("connections_added"));
+	for (const FString& Key : SortedKeys(Connections))
+	{
+		const FConnection& Connection = Connections[Key];
+		const FConnection* Old = Base.Connections.Find(Key);
+		if (!Old || Old->Source != Connection.Source || Old->Output != Connection.Output)
+		{
+			WriteConnection(Writer, Key, Connection);
+		}
+	}
+	Writer.WriteArrayEnd();
+
+	Writer.WriteArrayStart(TEXT("connections_removed"));
+	for (const FString& Key : SortedKeys(Base.Connections))
+	{
+		if (!Connections.Contains(Key))
+		{
+			Writer.WriteObjectStart();
+			WriteConnectionTarget(Writer, Key);
+			Writer.WriteObjectEnd();
+		}
+	}
+	Writer.WriteArrayEnd();
+}
+
+int32 FMaterialGraphSnapshot::CountChanges(const FMaterialGraphSnapshot& Base) const
+{
+	int32 Count = 0;
+	for (const TPair<FString, FNode>& Pair : Nodes)
+	{
+		const FNode* Old = Base.Nodes.Find(Pair.Key);
+		if (!Old || Old->Class != Pair.Value.Class)
+		{
+			Count++;
+		}
+		else if (Old->X != Pair.Value.X || Old->Y != Pair.Value.Y || !Old->Properties.OrderIndependentCompareEqual(Pair.Value.Properties))
+		{
+			Count++;
+		}
+	}
+	for (const TPair<FString, FNode>& Pair : Base.Nodes)
+	{
+		const FNode* Current = Nodes.Find(Pair.Key);
+		if (!Current || Current->Class != Pair.Value.Class)
+		{
+			Count++;
+		}
+	}
+	for (const TPair<FString, FConnection>& Pair : Connections)
+	{
+		const FConnection* Old = Base.Connections.Find(Pair.Key);
+		if (!Old || Old->Source != Pair.Value.Source || Old->Output != Pair.Value.Output)
+		{
+			Count++;
+		}
+	}
+	for (const TPair<FString, FConnection>& Pair : Base.Connections)
+	{
+		if (!Connections.Contains(Pair.Key))
+		{
+			Count++;
+		}
+	}
+	return Count;
+}
+
+TSharedRef<const FMaterialGraphSnapshot> FMaterialGraphDiff::Capture(const FString& AssetPath, UMaterial* Material, UMaterialFunction* Function)
+{
+	TSharedRef<const FMaterialGraphSnapshot> Snapshot = FMaterialGraphSnapshot::Capture(Material, Function);
+
+	FScopeLock ScopeLock(&CacheLock);
+	TArray<TSharedRef<const FMaterialGraphSnapshot>>& Snapshots = Cache.FindOrAdd(AssetPath);
+
+	// Most recent last; an unchanged graph keeps its one entry
+	Snapshots.RemoveAll([&Snapshot](const TSharedRef<const FMaterialGraphSnapshot>& Entry) { return Entry->Revision == Snapshot->Revision; });
+	Snapshots.Add(Snapshot);
+	if (Snapshots.Num() > MaxSnapshotsPerAsset)
+	{
+		Snapshots.RemoveAt(0, Snapshots.Num() - MaxSnapshotsPerAsset);
+	}
+	return Snapshot;
+}
+
+TSharedPtr<const FMaterialGraphSnapshot> FMaterialGraphDiff::Find(const FString& AssetPath, const FString& Revision)
+{
+	FScopeLock ScopeLock(&CacheLock);
+	if (const TArray<TSharedRef<const FMaterialGraphSnapshot>>* Snapshots = Cache.Find(AssetPath))
+	{
+		for (const TSharedRef<const FMaterialGraphSnapshot>& Snapshot : *Snapshots)
+		{
+			if (Snapshot->Revision == Revision)
+			{
+				return Snapshot;
+			}
+		}
+	}
+	return nullptr;
+}
+
+void FMaterialGraphDiff::Reset()
+{
+	FScopeLock ScopeLock(&CacheLock);
+	Cache.Empty();
+}
+
+FMaterialGraphDiff::FPatchResult FMaterialGraphDiff::Apply(UMaterial* Material, UMaterialFunction* Function, const TArray<TSharedPtr<FJsonValue>>& Operations)
+{
+	FPatchResult Result;
+
+	// Expressions created by "add", by client id
+	TMap<FString, UMaterialExpression*> Created;
+
+	auto Resolve = [&](const FString& Ref) -> UMaterialExpression*
+	{
+		if (UMaterialExpression** Found = Created.Find(Ref))
+		{
+			return *Found;
+		}
+		return FMaterialGraphIndex::FindExpression(Material ? static_cast<UObject*>(Material) : Function, Ref);
+	};
+
+	// Target input of a connect/disconnect: an expression input or (materials only) a material property
+	auto ResolveInput = [&](const TSharedPtr<FJsonObject>& Op, UMaterialExpression*& OutTarget, FString& OutError) -> FExpressionInput*
+	{
+		OutTarget = nullptr;
+		FString PropertyName;
+		if (Op->TryGetStringField(TEXT("property"), PropertyName))
+		{
+			const EMaterialProperty Property = ParseMaterialProperty(PropertyName);
+			FExpressionInput* Input = Material && Property != MP_MAX ? Material->GetExpressionInputForProperty(Property) : nullptr;
+			if (!Input)
+			{
+				OutError = Material
+					? FString::Printf(TEXT("Unknown material property: %s"), *PropertyName)
+					: TEXT("Material functions have no property inputs; connect to a FunctionOutput node");
+			}
+			return Input;
+		}
+
+		const FString TargetName = Op->GetStringField(TEXT("target"));
+		OutTarget = Resolve(TargetName);
+		if (!OutTarget)
+		{
+			OutError = FString::Printf(TEXT("Target node not found: %s"), *TargetName);
+			return nullptr;
+		}
+
+		const int32 InputIndex = static_cast<int32>(Op->GetNumberField(TEXT("input")));
+		FExpressionInput* Input = OutTarget->GetInput(InputIndex);
+		if (!Input)
+		{
+			OutError = FString::Printf(TEXT("%s has no input %d"), *TargetName, InputIndex);
+		}
+		return Input;
+	};
+
+	UObject* Owner = Material ? static_cast<UObject*>(Material) : static_cast<UObject*>(Function);
+
+	for (int32 Index = 0; Index < Operations.Num(); ++Index)
+	{
+		const TSharedPtr<FJsonObject> Op = Operations[Index].IsValid() ? Operations[Index]->AsObject() : nullptr;
+		const FString OpName = Op.IsValid() ? Op->GetStringField(TEXT("op")) : FString();
+		FString Error;
+
+		if (OpName == TEXT("add"))
+		{
+			const FString ClassName = Op->GetStringField(TEXT("class"));
+			UClass* ExpressionClass = FindExpressionClass(ClassName);
+			if (!ExpressionClass)
+			{
+				Error = FString::Printf(TEXT("Unknown expression class: %s"), *ClassName);
+			}
+			else
+			{
+				UMaterialExpression* Expression = UMaterialEditingLibrary::CreateMaterialExpressionEx(
+					Material, Function, ExpressionClass, nullptr,
+					static_cast<int32>(Op->GetNumberField(TEXT("x"))), static_cast<int32>(Op->GetNumberField(TEXT("y"))));
+
+				const TSharedPtr<FJsonObject>* Properties = nullptr;
+				Op->TryGetObjectField(TEXT("properties"), Properties);
+
+				if (!Expression)
+				{
+					Error = FString::Printf(TEXT("Failed to create %s"), *ClassName);
+				}
+				else if (SetProperties(Expression, Properties ? *Properties : nullptr, Error))
+				{
+					const FString Id = Op->HasField(TEXT("id")) ? Op->GetStringField(TEXT("id")) : Expression->GetName();
+					Created.Add(Id, Expression);
+					Result.CreatedNames.Add(Id, Expression->GetName());
+				}
+			}
+		}
+		else if (OpName == TEXT("remove"))
+		{
+			const FString NodeName = Op->GetStringField(TEXT("node"));
+			if (UMaterialExpression* Expression = Resolve(NodeName))
+			{
+				for (auto It = Created.CreateIterator(); It; ++It)
+				{
+					if (It->Value == Expression)
+					{
+						It.RemoveCurrent();
+					}
+				}
+
+				if (Material)
+				{
+					UMaterialEditingLibrary::DeleteMaterialExpression(Material, Expression);
+				}
+				else
+				{
+					UMaterialEditingLibrary::DeleteMaterialExpressionInFunction(Function, Expression);
+				}
+			}
+			else
+			{
+				Error = FString::Printf(TEXT("Node not found: %s"), *NodeName);
+			}
+		}
+		else if (OpName == TEXT("move"))
+		{
+			const FString NodeName = Op->GetStringField(TEXT("node"));
+			if (UMaterialExpression* Expression = Resolve(NodeName))
+			{
+				Expression->Modify();
+				Expression->MaterialExpressionEditorX = static_cast<int32>(Op->GetNumberField(TEXT("x")));
+				Expression->MaterialExpressionEditorY = static_cast<int32>(Op->GetNumberField(TEXT("y")));
+				if (Expression->GraphNode)
+				{
+					Expression->GraphNode->NodePosX = Expression->MaterialExpressionEditorX;
+					Expression->GraphNode->NodePosY = Expression->MaterialExpressionEditorY;
+				}
+			}
+			else
+			{
+				Error = FString::Printf(TEXT("Node not found: %s"), *NodeName);
+			}
+		}
+		else if (OpName == TEXT("set"))
+		{
+			const FString NodeName = Op->GetStringField(TEXT("node"));
+			const TSharedPtr<FJsonObject>* Properties = nullptr;
+			if (UMaterialExpression* Expression = Resolve(NodeName))
+			{
+				if (!Op->TryGetObjectField(TEXT("properties"), Properties))
+				{
+					Error = TEXT("'set' needs a properties object");
+				}
+				else
+				{
+					SetProperties(Expression, *Properties, Error);
+				}
+			}
+			else
+			{
+				Error = FString::Printf(TEXT("Node not found: %s"), *NodeName);
+			}
+		}
+		else if (OpName == TEXT("connect"))
+		{
+			const FString SourceName = Op->GetStringField(TEXT("source"));
+			const int32 OutputIndex = Op->HasField(TEXT("output")) ? static_cast<int32>(Op->GetNumberField(TEXT("output"))) : 0;
+			UMaterialExpression* Source = Resolve(SourceName);
+			UMaterialExpression* Target = nullptr;
+
+			if (!Source)
+			{
+				Error = FString::Printf(TEXT("Source node not found: %s"), *SourceName);
+			}
+			else if (!Source->GetOutputs().IsValidIndex(OutputIndex))
+			{
+				Error = FString::Printf(TEXT("%s has no output %d"), *SourceName, OutputIndex);
+			}
+			else if (FExpressionInput* Input = ResolveInput(Op, Target, Error))
+			{
+				if (Target)
+				{
+					Target->Modify();
+				}
+				Input->Connect(OutputIndex, Source);
+			}
+		}
+		else if (OpName == TEXT("disconnect"))
+		{
+			UMaterialExpression* Target = nullptr;
+			if (FExpressionInput* Input = ResolveInput(Op, Target, Error))
+			{
+				if (Target)
+				{
+					Target->Modify();
+				}
+				Input->Expression = nullptr;
+				Input->OutputIndex = 0;
+			}
+		}
+		else
+		{
+			Error = FString::Printf(TEXT("Unknown op '%s'. Valid: add, remove, move, set, connect, disconnect"), *OpName);
+		}
+
+		if (!Error.IsEmpty())
+		{
+			Result.FailedIndex = Index;
+			Result.Error = MoveTemp(Error);
+			UE_LOG(LogTemp, Warning, TEXT("MaterialGraphDiff: Patch of %s stopped at op %d: %s"), *Owner->GetName(), Index, *Result.Error);
+			break;
+		}
+		Result.Applied++;
+	}
+
+	// Links were written straight into expression inputs
+	FMaterialGraphIndex::Invalidate(Owner);
+	return Result;
+}
@@ -0,0 +1,304 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Utils/MaterialGraphIndex.h"
+#include "Editor.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialFunction.h"
+#include "Materials/MaterialExpression.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	struct FGraphEntry
+	{
+		TWeakObjectPtr<UObject> Owner;
+
+		/** Expression name -> expression (FName keys compare case-insensitively) */
+		TMap<FName, TWeakObjectPtr<UMaterialExpression>> ByName;
+
+		/** Expressions indexed so far, and the last of them, so appended expressions can be indexed alone */
+		int32 IndexedCount = 0;
+		TWeakObjectPtr<UMaterialExpression> LastIndexed;
+
+		/** Null until requested and after any change to the graph */
+		TSharedPtr<const FMaterialGraphIndex::FConnections> Connections;
+		int32 ConnectionsExpressionCount = 0;
+	};
+
+	struct FIndexHandles
+	{
+		FDelegateHandle ObjectModified;
+		FDelegateHandle ObjectPropertyChanged;
+		FDelegateHandle PostUndoRedo;
+	};
+
+	/** Graph node and pin edits modify objects up to two outers below the material (node -> graph -> material) */
+	constexpr int32 MaxOuterDepth = 3;
+
+	/** Entries for owners that are gone are pruned once the map grows past this */
+	constexpr int32 PruneThreshold = 64;
+
+	TMap<FObjectKey, FGraphEntry> Entries;
+	FIndexHandles Handles;
+	bool bInitialized = false;
+
+	TConstArrayView<TObjectPtr<UMaterialExpression>> GetExpressions(UObject* Owner)
+	{
+		if (UMaterial* Material = Cast<UMaterial>(Owner))
+		{
+			return Material->GetExpressions();
+		}
+		if (UMaterialFunction* Function = Cast<UMaterialFunction>(Owner))
+		{
+			return Function->GetExpressions();
+		}
+		return TConstArrayView<TObjectPtr<UMaterialExpression>>();
+	}
+
+	FGraphEntry& FindOrAddEntry(UObject* Owner)
+	{
+		const FObjectKey Key(Owner);
+		if (FGraphEntry* Entry = Entries.Find(Key))
+		{
+			return *Entry;
+		}
+
+		if (Entries.Num() >= PruneThreshold)
+		{
+			for (auto It = Entries.CreateIterator(); It; ++It)
+			{
+				if (!It->Value.Owner.IsValid())
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
+
+		FGraphEntry& Entry = Entries.Add(Key);
+		Entry.Owner = Owner;
+		return Entry;
+	}
+
+	/** Index expressions appended since the last call; everything if the array was reordered or shrank */
+	void IndexNames(FGraphEntry& Entry, TConstArrayView<TObjectPtr<UMaterialExpression>> Expressions, bool bFull)
+	{
+		if (bFull
+			|| Entry.IndexedCount > Expressions.Num()
+			|| (Entry.IndexedCount > 0 && Expressions[Entry.IndexedCount - 1] != Entry.LastIndexed.Get()))
+		{
+			Entry.ByName.Reset();
+			Entry.IndexedCount = 0;
+			Entry.LastIndexed = nullptr;
+		}
+
+		for (int32 Index = Entry.IndexedCount; Index < Expressions.Num(); ++Index)
+		{
+			if (UMaterialExpression* Expression = Expressions[Index])
+			{
+				Entry.ByName.Add(Expression->GetFName(), Expression);
+			}
+		}
+		Entry.IndexedCount = Expressions.Num();
+		Entry.LastIndexed = Expressions.Num() > 0 ? Expressions.Last().Get() : nullptr;
+	}
+
+	/** Live expression indexed under Name; bOutStale set if the entry no longer matches its expression */
+	UMaterialExpression* FindInEntry(const FGraphEntry& Entry, UObject* Owner, FName Name, bool& bOutStale)
+	{
+		const TWeakObjectPtr<UMaterialExpression>* Found = Entry.ByName.Find(Name);
+		if (!Found)
+		{
+			return nullptr;
+		}
+
+		UMaterialExpression* Expression = Found->Get();
+		if (Expression && IsValid(Expression) && Expression->GetFName() == Name && Expression->GetOuter() == Owner)
+		{
+			return Expression;
+		}
+		bOutStale = true;
+		return nullptr;
+	}
+
+	void InvalidateConnections(UObject* Object)
+	{
+		if (Entries.Num() == 0)
+		{
+			return;
+		}
+
+		for (int32 Depth = 0; Object && Depth < MaxOuterDepth; ++Depth, Object = Object->GetOuter())
+		{
+			if (FGraphEntry* Entry = Entries.Find(FObjectKey(Object)))
+			{
+				Entry->Connections.Reset();
+				return;
+			}
+		}
+	}
+}
+
+void FMaterialGraphIndex::FConnections::GetConsumers(const UMaterialExpression* Source, TArray<const FLink*>& OutLinks) const
+{
+	TArray<int32, TInlineAllocator<8>> Indices;
+	BySource.MultiFind(Source, Indices, true);
+	for (int32 Index : Indices)
+	{
+		OutLinks.Add(&Links[Index]);
+	}
+}
+
+void FMaterialGraphIndex::FConnections::GetInputs(const UMaterialExpression* Target, TArray<const FLink*>& OutLinks) const
+{
+	TArray<int32, TInlineAllocator<8>> Indices;
+	ByTarget.MultiFind(Target, Indices, true);
+	for (int32 Index : Indices)
+	{
+		OutLinks.Add(&Links[Index]);
+	}
+}
+
+const FMaterialGraphIndex::FLink* FMaterialGraphIndex::FConnections::FindPropertyLink(EMaterialProperty Property) const
+{
+	const int32* Index = ByProperty.Find(Property);
+	return Index ? &Links[*Index] : nullptr;
+}
+
+void FMaterialGraphIndex::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	Handles.ObjectModified = FCoreUObjectDelegates::OnObjectModified.AddLambda([](UObject* Object)
+	{
+		InvalidateConnections(Object);
+	});
+	Handles.ObjectPropertyChanged = FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda([](UObject* Object, FPropertyChangedEvent&)
+	{
+		InvalidateConnections(Object);
+	});
+
+	// Undo can put back or take out expressions without marking them garbage
+	Handles.PostUndoRedo = FEditorDelegates::PostUndoRedo.AddLambda([]() { Entries.Reset(); });
+}
+
+void FMaterialGraphIndex::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	FCoreUObjectDelegates::OnObjectModified.Remove(Handles.ObjectModified);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(Handles.ObjectPropertyChanged);
+	FEditorDelegates::PostUndoRedo.Remove(Handles.PostUndoRedo);
+
+	Handles = FIndexHandles();
+	Entries.Empty();
+}
+
+UMaterialExpression* FMaterialGraphIndex::FindExpression(UObject* Owner, const FString& Name)
+{
+	check(IsInGameThread());
+
+	// No FName entry means no object can have this name
+	const FName Key(*Name, FNAME_Find);
+	if (!Owner || Key.IsNone())
+	{
+		return nullptr;
+	}
+
+	FGraphEntry& Entry = FindOrAddEntry(Owner);
+	const TConstArrayView<TObjectPtr<UMaterialExpression>> Expressions = GetExpressions(Owner);
+
+	bool bStale = false;
+	IndexNames(Entry, Expressions, false);
+	UMaterialExpression* Expression = FindInEntry(Entry, Owner, Key, bStale);
+
+	// Stale entry or an unreported rename: rebuild from scratch and look again
+	if (!Expression)
+	{
+		IndexNames(Entry, Expressions, true);
+		Expression = FindInEntry(Entry, Owner, Key, bStale);
+	}
+	return Expression;
+}
+
+TSharedRef<const FMaterialGraphIndex::FConnections> FMaterialGraphIndex::GetConnections(UObject* Owner)
+{
+	check(IsInGameThread());
+
+	if (!Owner)
+	{
+		return MakeShared<FConnections>();
+	}
+
+	FGraphEntry& Entry = FindOrAddEntry(Owner);
+	const TConstArrayView<TObjectPtr<UMaterialExpression>> Expressions = GetExpressions(Owner);
+	if (Entry.Connections.IsValid() && Entry.ConnectionsExpressionCount == Expressions.Num())
+	{
+		return Entry.Connections.ToSharedRef();
+	}
+
+	TSharedRef<FConnections> Connections = MakeShared<FConnections>();
+
+	auto AddLink = [&Connections](const FExpressionInput& Input, UMaterialExpression* Target, int32 InputIndex, EMaterialProperty Property)
+	{
+		const int32 Index = Connections->Links.Add({ Input.Expression, Input.OutputIndex, Target, InputIndex, Property });
+		Connections->BySource.Add(Input.Expression, Index);
+		if (Target)
+		{
+			Connections->ByTarget.Add(Target, Index);
+		}
+		else
+		{
+			Connections->ByProperty.Add(Property, Index);
+		}
+	};
+
+	if (UMaterial* Material = Cast<UMaterial>(Owner))
+	{
+		for (int32 Property = 0; Property < MP_MAX; ++Property)
+		{
+			const FExpressionInput* Input = Material->GetExpressionInputForProperty(static_cast<EMaterialProperty>(Property));
+			if (Input && Input->Expression)
+			{
+				AddLink(*Input, nullptr, INDEX_NONE, static_cast<EMaterialProperty>(Property));
+			}
+		}
+	}
+
+	for (UMaterialExpression* Expression : Expressions)
+	{
+		if (!Expression)
+		{
+			continue;
+		}
+		for (int32 InputIndex = 0; const FExpressionInput* Input = Expression->GetInput(InputIndex); ++InputIndex)
+		{
+			if (Input->Expression)
+			{
+				AddLink(*Input, Expression, InputIndex, MP_MAX);
+			}
+		}
+	}
+
+	Entry.Connections = Connections;
+	Entry.ConnectionsExpressionCount = Expressions.Num();
+
+	UE_LOG(LogTemp, Verbose, TEXT("MaterialGraphIndex: Indexed %d links in %s"), Connections->Links.Num(), *Owner->GetName());
+	return Connections;
+}
+
+void FMaterialGraphIndex::Invalidate(UObject* Owner)
+{
+	if (FGraphEntry* Entry = Owner ? Entries.Find(FObjectKey(Owner)) : nullptr)
+	{
+		Entry->Connections.Reset();
+	}
+}
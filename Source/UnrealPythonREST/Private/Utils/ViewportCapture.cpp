@@ -0,0 +1,400 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Utils/ViewportCapture.h"
+#include "UnrealClient.h"
+#include "RenderingThread.h"
+#include "RHICommandList.h"
+#include "RHIGPUReadback.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "ImageUtils.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Modules/ModuleManager.h"
+#include <atomic>
+
+static TAutoConsoleVariable<int32> CVarCaptureMaxInFlight(
+	TEXT("UnrealPythonREST.CaptureMaxInFlight"),
+	8,
+	TEXT("Viewport captures that may wait for the GPU or an encoder at once; further requests get 503."));
+
+static TAutoConsoleVariable<float> CVarCaptureTimeoutSeconds(
+	TEXT("UnrealPythonREST.CaptureTimeoutSeconds"),
+	5.0f,
+	TEXT("Fail a viewport capture whose GPU readback has not completed after this long."));
+
+namespace
+{
+	/** Largest output side accepted */
+	constexpr int32 MaxOutputSize = 8192;
+
+	/** Shared by the game thread (bookkeeping), the render thread (readback) and a worker (encode) */
+	struct FCaptureState
+	{
+		int32 Id = 0;
+		FViewportCapture::FSettings Settings;
+		FIntPoint Size = FIntPoint::ZeroValue;
+		FVector Location = FVector::ZeroVector;
+		FRotator Rotation = FRotator::ZeroRotator;
+		double StartTime = 0.0;
+
+		/** Render thread only */
+		TUniquePtr<FRHIGPUTextureReadback> Readback;
+		EPixelFormat PixelFormat = PF_Unknown;
+
+		/** True until the render thread has taken the pixels (or failed) */
+		std::atomic<bool> bWaitingForGPU { true };
+
+		/** A poll command is queued on the render thread */
+		std::atomic<bool> bPollQueued { false };
+
+		/** Set by the render thread or the encoder before completing */
+		TSharedPtr<FViewportCapture::FFrame> Frame;
+		FString Error;
+	};
+	using FCaptureStateRef = TSharedRef<FCaptureState, ESPMode::ThreadSafe>;
+
+	/** Game-thread record of a capture until its callback runs */
+	struct FInFlight
+	{
+		FCaptureStateRef State;
+		FViewportCapture::FOnCaptured OnCaptured;
+	};
+
+	TArray<FInFlight> InFlight;
+	FTSTicker::FDelegateHandle Ticker;
+	IImageWrapperModule* ImageWrapperModule = nullptr;
+	int32 NextId = 1;
+	bool bInitialized = false;
+
+	/** Game thread: remove State's record and return its callback; unbound if it timed out or the module shut down */
+	FViewportCapture::FOnCaptured TakeCallback(const FCaptureStateRef& State)
+	{
+		const int32 Index = InFlight.IndexOfByPredicate([&State](const FInFlight& Entry) { return Entry.State == State; });
+		if (Index == INDEX_NONE)
+		{
+			return FViewportCapture::FOnCaptured();
+		}
+
+		FViewportCapture::FOnCaptured OnCaptured = MoveTemp(InFlight[Index].OnCaptured);
+		InFlight.RemoveAt(Index);
+		return OnCaptured;
+	}
+
+	/** Game thread: hand State's result to its callback */
+	void Complete(const FCaptureStateRef& State)
+	{
+		FViewportCapture::FOnCaptured OnCaptured = TakeCallback(State);
+		if (!OnCaptured)
+		{
+			return;
+		}
+
+		if (State->Frame.IsValid())
+		{
+			OnCaptured(State->Frame, FString());
+		}
+		else
+		{
+			OnCaptured(nullptr, State->Error);
+		}
+	}
+
+	void CompleteOnGameThread(const FCaptureStateRef& State)
+	{
+		AsyncTask(ENamedThreads::GameThread, [State]() { Complete(State); });
+	}
+
+	/** Output size for Settings from a Width x Height source */
+	FIntPoint GetOutputSize(const FViewportCapture::FSettings& Settings, int32 Width, int32 Height)
+	{
+		int32 OutWidth = Settings.Width;
+		int32 OutHeight = Settings.Height;
+		if (OutWidth <= 0 && OutHeight <= 0)
+		{
+			return FIntPoint(Width, Height);
+		}
+		if (OutWidth <= 0)
+		{
+			OutWidth = FMath::RoundToInt(static_cast<double>(Width) * OutHeight / Height);
+		}
+		else if (OutHeight <= 0)
+		{
+			OutHeight = FMath::RoundToInt(static_cast<double>(Height) * OutWidth / Width);
+		}
+		return FIntPoint(FMath::Clamp(OutWidth, 1, MaxOutputSize), FMath::Clamp(OutHeight, 1, MaxOutputSize));
+	}
+
+	/** Worker: resize and encode Pixels, then complete on the game thread */
+	void Encode(const FCaptureStateRef& State, TArray<FColor>&& Pixels, int32 Width, int32 Height, double ReadbackMs)
+	{
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [State, Pixels = MoveTemp(Pixels), Width, Height, ReadbackMs]() mutable
+		{
+			const double EncodeStart = FPlatformTime::Seconds();
+			const FIntPoint OutSize = GetOutputSize(State->Settings, Width, Height);
+
+			if (OutSize.X != Width || OutSize.Y != Height)
+			{
+				TArray<FColor> Resized;
+				FImageUtils::ImageResize(Width, Height, Pixels, OutSize.X, OutSize.Y, Resized, false);
+				Pixels = MoveTemp(Resized);
+			}
+
+			const bool bJpeg = State->Settings.Format == FViewportCapture::EFormat::Jpeg;
+			TSharedPtr<IImageWrapper> Wrapper = ImageWrapperModule->CreateImageWrapper(bJpeg ? EImageFormat::JPEG : EImageFormat::PNG);
+			if (!Wrapper.IsValid() || !Wrapper->SetRaw(Pixels.GetData(), Pixels.Num() * sizeof(FColor), OutSize.X, OutSize.Y, ERGBFormat::BGRA, 8))
+			{
+				State->Error = TEXT("ENCODE_FAILED: Image encoder rejected the frame");
+				CompleteOnGameThread(State);
+				return;
+			}
+
+			TSharedPtr<FViewportCapture::FFrame> Frame = MakeShared<FViewportCapture::FFrame>();
+			Frame->Bytes = Wrapper->GetCompressed(bJpeg ? State->Settings.Quality : static_cast<int32>(EImageCompressionQuality::Default));
+			Frame->Format = State->Settings.Format;
+			Frame->Width = OutSize.X;
+			Frame->Height = OutSize.Y;
+			Frame->Location = State->Location;
+			Frame->Rotation = State->Rotation;
+			Frame->ReadbackMs = ReadbackMs;
+			Frame->EncodeMs = (FPlatformTime::Seconds() - EncodeStart) * 1000.0;
+
+			State->Frame = Frame;
+			CompleteOnGameThread(State);
+		});
+	}
+
+	/** Render thread: BGRA8 pixels from the locked readback, or false for a format we cannot convert */
+	bool ConvertPixels(const void* Data, int32 RowPitchInPixels, EPixelFormat Format, int32 Width, int32 Height, TArray<FColor>& OutPixels)
+	{
+		OutPixels.SetNumUninitialized(Width * Height);
+
+		switch (Format)
+		{
+		case PF_B8G8R8A8:
+			for (int32 Y = 0; Y < Height; ++Y)
+			{
+				FMemory::Memcpy(&OutPixels[Y * Width], static_cast<const FColor*>(Data) + Y * RowPitchInPixels, Width * sizeof(FColor));
+			}
+
+			// Viewport alpha is not coverage; encode opaque
+			for (FColor& Pixel : OutPixels)
+			{
+				Pixel.A = 255;
+			}
+			return true;
+
+		case PF_R8G8B8A8:
+			for (int32 Y = 0; Y < Height; ++Y)
+			{
+				const uint8* Row = static_cast<const uint8*>(Data) + Y * RowPitchInPixels * 4;
+				for (int32 X = 0; X < Width; ++X)
+				{
+					OutPixels[Y * Width + X] = FColor(Row[X * 4 + 0], Row[X * 4 + 1], Row[X * 4 + 2]);
+				}
+			}
+			return true;
+
+		case PF_A2B10G10R10:
+			for (int32 Y = 0; Y < Height; ++Y)
+			{
+				const uint32* Row = static_cast<const uint32*>(Data) + Y * RowPitchInPixels;
+				for (int32 X = 0; X < Width; ++X)
+				{
+					const uint32 Packed = Row[X];
+					OutPixels[Y * Width + X] = FColor((Packed >> 2) & 0xFF, (Packed >> 12) & 0xFF, (Packed >> 22) & 0xFF);
+				}
+			}
+			return true;
+
+		default:
+			return false;
+		}
+	}
+
+	/** Render thread: take the pixels once the GPU copy has landed */
+	void PollReadback(const FCaptureStateRef& State)
+	{
+		State->bPollQueued = false;
+		if (!State->bWaitingForGPU || !State->Readback.IsValid() || !State->Readback->IsReady())
+		{
+			return;
+		}
+
+		int32 RowPitchInPixels = 0;
+		const void* Data = State->Readback->Lock(RowPitchInPixels);
+
+		TArray<FColor> Pixels;
+		const bool bConverted = Data && ConvertPixels(Data, RowPitchInPixels, State->PixelFormat, State->Size.X, State->Size.Y, Pixels);
+		State->Readback->Unlock();
+		State->Readback.Reset();
+		State->bWaitingForGPU = false;
+
+		if (!bConverted)
+		{
+			State->Error = FString::Printf(TEXT("UNSUPPORTED_PIXEL_FORMAT: Viewport render target format %s cannot be captured"),
+				GetPixelFormatString(State->PixelFormat));
+			CompleteOnGameThread(State);
+			return;
+		}
+
+		const double ReadbackMs = (FPlatformTime::Seconds() - State->StartTime) * 1000.0;
+		Encode(State, MoveTemp(Pixels), State->Size.X, State->Size.Y, ReadbackMs);
+	}
+
+	bool Tick(float DeltaTime)
+	{
+		const double Now = FPlatformTime::Seconds();
+		const double Timeout = FMath::Max(CVarCaptureTimeoutSeconds.GetValueOnGameThread(), 0.1f);
+
+		for (int32 Index = InFlight.Num() - 1; Index >= 0; --Index)
+		{
+			FCaptureStateRef State = InFlight[Index].State;
+			if (!State->bWaitingForGPU)
+			{
+				continue;
+			}
+
+			// The render thread may still finish later; its result is dropped because the record is gone
+			if (Now - State->StartTime > Timeout)
+			{
+				if (FViewportCapture::FOnCaptured OnCaptured = TakeCallback(State))
+				{
+					OnCaptured(nullptr, TEXT("READBACK_TIMEOUT: GPU readback did not complete"));
+				}
+				continue;
+			}
+
+			// One outstanding poll per capture; the render thread clears the flag
+			if (!State->bPollQueued.exchange(true))
+			{
+				ENQUEUE_RENDER_COMMAND(UnrealPythonRESTCapturePoll)([State](FRHICommandListImmediate&)
+				{
+					PollReadback(State);
+				});
+			}
+		}
+		return true;
+	}
+}
+
+void FViewportCapture::Initialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	// Loaded here because workers cannot load modules
+	ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+	Ticker = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&Tick));
+}
+
+void FViewportCapture::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	FTSTicker::GetCoreTicker().RemoveTicker(Ticker);
+	Ticker.Reset();
+
+	// Readbacks still referenced by render commands or workers are released with their last reference;
+	// their callbacks are answered now, since nothing will complete them later
+	TArray<FInFlight> Pending = MoveTemp(InFlight);
+	InFlight.Reset();
+	for (FInFlight& Entry : Pending)
+	{
+		if (Entry.OnCaptured)
+		{
+			Entry.OnCaptured(nullptr, TEXT("SHUTTING_DOWN: Viewport capture stopped before the readback finished"));
+		}
+	}
+}
+
+bool FViewportCapture::Capture(FViewport* Viewport, const FSettings& Settings, const FVector& Location, const FRotator& Rotation,
+	FOnCaptured OnCaptured, FString& OutError)
+{
+	check(IsInGameThread());
+
+	if (!bInitialized)
+	{
+		OutError = TEXT("Viewport capture is not running");
+		return false;
+	}
+
+	const FIntPoint Size = Viewport ? Viewport->GetSizeXY() : FIntPoint::ZeroValue;
+	if (Size.X <= 0 || Size.Y <= 0)
+	{
+		OutError = TEXT("Viewport has no size (minimized or not yet drawn)");
+		return false;
+	}
+
+	if (InFlight.Num() >= FMath::Max(CVarCaptureMaxInFlight.GetValueOnGameThread(), 1))
+	{
+		OutError = FString::Printf(TEXT("%d captures already in flight"), InFlight.Num());
+		return false;
+	}
+
+	FCaptureStateRef State = MakeShared<FCaptureState, ESPMode::ThreadSafe>();
+	State->Id = NextId++;
+	State->Settings = Settings;
+	State->Size = Size;
+	State->Location = Location;
+	State->Rotation = Rotation;
+	State->StartTime = FPlatformTime::Seconds();
+	InFlight.Add({ State, MoveTemp(OnCaptured) });
+
+	// Copy whatever the viewport last rendered; the copy runs after that frame's draw on the GPU timeline
+	ENQUEUE_RENDER_COMMAND(UnrealPythonRESTCaptureCopy)([State, Viewport](FRHICommandListImmediate& RHICmdList)
+	{
+		FRHITexture* Texture = Viewport->GetRenderTargetTexture();
+		if (!Texture)
+		{
+			State->bWaitingForGPU = false;
+			State->Error = TEXT("NO_RENDER_TARGET: Viewport has no render target to read back");
+			CompleteOnGameThread(State);
+			return;
+		}
+
+		const FIntVector TextureSize = Texture->GetSizeXYZ();
+		State->Size.X = FMath::Min(State->Size.X, TextureSize.X);
+		State->Size.Y = FMath::Min(State->Size.Y, TextureSize.Y);
+		State->PixelFormat = Texture->GetFormat();
+
+		State->Readback = MakeUnique<FRHIGPUTextureReadback>(TEXT("UnrealPythonRESTCapture"));
+		State->Readback->EnqueueCopy(RHICmdList, Texture);
+	});
+
+	return true;
+}
+
+bool FViewportCapture::ParseFormat(const FString& Name, EFormat& OutFormat)
+{
+	if (Name.Equals(TEXT("jpeg"), ESearchCase::IgnoreCase) || Name.Equals(TEXT("jpg"), ESearchCase::IgnoreCase))
+	{
+		OutFormat = EFormat::Jpeg;
+		return true;
+	}
+	if (Name.Equals(TEXT("png"), ESearchCase::IgnoreCase))
+	{
+		OutFormat = EFormat::Png;
+		return true;
+	}
+	return false;
+}
+
+const TCHAR* FViewportCapture::GetMimeType(EFormat Format)
+{
+	return Format == EFormat::Png ? TEXT("image/png") : TEXT("image/jpeg");
+}
+
+int32 FViewportCapture::NumInFlight()
+{
+	return InFlight.Num();
+}
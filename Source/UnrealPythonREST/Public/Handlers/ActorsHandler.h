@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "IRESTHandler.h"
 #include "RESTRouter.h"
+#include "ConvexVolume.h"
+
+class FEditorViewportClient;
 
 /**
  * Actor management endpoints.
@@ -18,7 +21,11 @@
  *   POST /actors/duplicate     - Clone actor with offset
  *   POST /actors/transform     - Set location/rotation/scale by label
  *   POST /actors/delete        - Remove actor by label
+ *   POST /actors/spawn/bulk     - Spawn many actors from columnar arrays, one transaction
+ *   POST /actors/transform/bulk - Move many actors from columnar arrays, one transaction
+ *   POST /actors/delete/bulk    - Remove many actors by label, one transaction
  *   GET  /actors/in_view       - Actors in viewport frustum
+ *   POST /actors/query         - Frustum/box/sphere/ray query via FActorSpatialIndex
  */
 class FActorsHandler : public IRESTHandler
 {
@@ -52,6 +59,24 @@ private:
 	/** POST /actors/delete - Remove actor from level */
 	FRESTResponse HandleDelete(const FRESTRequest& Request);
 
+	/** POST /actors/spawn/bulk - Spawn actors from flat location/rotation/scale arrays */
+	FRESTResponse HandleSpawnBulk(const FRESTRequest& Request);
+
+	/** POST /actors/transform/bulk - Apply flat location/rotation/scale arrays to labelled actors */
+	FRESTResponse HandleTransformBulk(const FRESTRequest& Request);
+
+	/** POST /actors/delete/bulk - Remove labelled actors */
+	FRESTResponse HandleDeleteBulk(const FRESTRequest& Request);
+
 	/** GET /actors/in_view - List actors visible in editor viewport frustum */
 	FRESTResponse HandleInView(const FRESTRequest& Request);
+
+	/** POST /actors/query - Spatial query with limit and sort by distance */
+	FRESTResponse HandleQuery(const FRESTRequest& Request);
+
+	/** The active level editor viewport client, or nullptr */
+	static FEditorViewportClient* GetActiveViewportClient();
+
+	/** Frustum of a viewport's camera, cut off at MaxDistance */
+	static FConvexVolume MakeViewportFrustum(FEditorViewportClient* ViewportClient, float MaxDistance);
 };
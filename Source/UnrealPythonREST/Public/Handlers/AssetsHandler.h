@@ -6,6 +6,9 @@
 #include "IRESTHandler.h"
 #include "RESTRouter.h"
 
+class FRESTJsonWriter;
+class FRESTFieldFilter;
+
 /**
  * Asset management endpoints.
  *
@@ -17,9 +20,13 @@
  *   POST /assets/search       - Search assets by name pattern
  *   GET  /assets/info         - Get detailed asset information
  *   GET  /assets/refs         - Get asset references and dependencies
+ *   POST /assets/refs/graph   - Walk the reference graph from many roots
  *   POST /assets/export       - Export asset to text format
  *   POST /assets/validate     - Validate asset integrity
  *   GET  /assets/mesh_details - Get static mesh geometry details
+ *   POST /assets/bulk         - Bulk mesh_details/validate/export/recompile job
+ *   GET  /assets/bulk/{id}    - Bulk job status and incremental results
+ *   DELETE /assets/bulk/{id}  - Cancel a bulk job
  */
 class FAssetsHandler : public IRESTHandler
 {
@@ -44,6 +51,9 @@ private:
 	/** GET /assets/refs - Get asset references and dependencies */
 	FRESTResponse HandleRefs(const FRESTRequest& Request);
 
+	/** POST /assets/refs/graph - Breadth-first walk of dependencies and/or referencers from many roots */
+	FRESTResponse HandleRefsGraph(const FRESTRequest& Request);
+
 	/** POST /assets/export - Export asset to text format */
 	FRESTResponse HandleExport(const FRESTRequest& Request);
 
@@ -53,6 +63,18 @@ private:
 	/** GET /assets/mesh_details - Get static mesh geometry details */
 	FRESTResponse HandleMeshDetails(const FRESTRequest& Request);
 
+	/** POST /assets/bulk - Start an FAssetBulkInspector job over paths or a registry filter */
+	FRESTResponse HandleBulk(const FRESTRequest& Request);
+
+	/** GET /assets/bulk/{id} - Job summary and results from ?since= */
+	FRESTResponse HandleGetBulkJob(const FRESTRequest& Request, const FString& JobId);
+
+	/** DELETE /assets/bulk/{id} - Cancel a running job */
+	FRESTResponse HandleCancelBulkJob(const FRESTRequest& Request, const FString& JobId);
+
 	/** Convert FAssetData to JSON representation */
 	TSharedPtr<FJsonObject> AssetDataToJson(const FAssetData& AssetData);
+
+	/** Stream FAssetData fields (same as AssetDataToJson) into an already-open object */
+	void WriteAssetData(FRESTJsonWriter& Writer, const FAssetData& AssetData, const FRESTFieldFilter& Fields);
 };
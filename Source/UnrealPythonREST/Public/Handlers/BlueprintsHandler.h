@@ -5,12 +5,15 @@
 #include "CoreMinimal.h"
 #include "IRESTHandler.h"
 #include "RESTRouter.h"
+#include "RESTListQuery.h"
 
 /**
  * Blueprint Editor node manipulation endpoints.
  *
  * Provides full access to Blueprint Editor for node inspection and editing.
- * Requires an open Blueprint Editor with an active graph.
+ * Requires an open Blueprint Editor with an active graph. Every endpoint
+ * targets the first open Blueprint Editor, or the Blueprint named by the
+ * optional blueprint_path parameter (query string or JSON body).
  *
  * Endpoints:
  *   GET  /blueprints/selection      - Get selected nodes in Blueprint Editor
@@ -22,6 +25,12 @@
  *   POST /blueprints/connect        - Connect two pins
  *   POST /blueprints/disconnect     - Break pin connections
  *   POST /blueprints/pin/default    - Set pin default value
+ *   POST /blueprints/compile        - Queue a compile pass (returns a job)
+ *   GET  /blueprints/compile        - Dirty Blueprints and recent compile jobs
+ *   GET  /blueprints/compile/{id}   - Compile job result
+ *
+ * Edits never compile: they mark the Blueprint dirty in FBlueprintCompileQueue,
+ * which compiles once edits go idle or when asked to.
  */
 class FBlueprintsHandler : public IRESTHandler
 {
@@ -61,16 +70,26 @@ private:
 	/** POST /blueprints/pin/default - Set pin default value */
 	FRESTResponse HandleSetPinDefault(const FRESTRequest& Request);
 
+	/** POST /blueprints/compile - Queue a compile of dirty and named Blueprints */
+	FRESTResponse HandleCompile(const FRESTRequest& Request);
+
+	/** GET /blueprints/compile - Dirty Blueprints and recent compile jobs */
+	FRESTResponse HandleCompileStatus(const FRESTRequest& Request);
+
+	/** GET /blueprints/compile/{id} - Compile job result */
+	FRESTResponse HandleGetCompileJob(const FRESTRequest& Request, const FString& JobId);
+
 	/**
-	 * Find the active Blueprint Editor and its edited Blueprint.
-	 * @param OutBlueprint - The currently edited Blueprint (if found)
-	 * @param OutError - Error message if editor not found
-	 * @return The active FBlueprintEditor or nullptr
+	 * Find the Blueprint Editor and its edited Blueprint.
+	 * @param OutBlueprint - The edited Blueprint (if found)
+	 * @param OutError - Error code if editor not found
+	 * @param BlueprintPath - Blueprint to target; empty for the first open Blueprint Editor
+	 * @return The FBlueprintEditor or nullptr
 	 */
-	class FBlueprintEditor* FindActiveBlueprintEditor(class UBlueprint*& OutBlueprint, FString& OutError);
+	class FBlueprintEditor* FindActiveBlueprintEditor(class UBlueprint*& OutBlueprint, FString& OutError, const FString& BlueprintPath = TEXT(""));
 
-	/** Convert UEdGraphNode to JSON representation */
-	TSharedPtr<FJsonObject> NodeToJson(class UEdGraphNode* Node);
+	/** Convert UEdGraphNode to JSON representation (only Fields, if any are given) */
+	TSharedPtr<FJsonObject> NodeToJson(class UEdGraphNode* Node, const FRESTFieldFilter& Fields = FRESTFieldFilter());
 
 	/** Convert UEdGraphPin to JSON representation */
 	TSharedPtr<FJsonObject> PinToJson(class UEdGraphPin* Pin);
@@ -6,6 +6,10 @@
 #include "IRESTHandler.h"
 #include "RESTRouter.h"
 #include "Containers/Ticker.h"
+#include "Utils/ViewportCapture.h"
+
+class AActor;
+class FEditorViewportClient;
 
 /**
  * Camera animation state for smooth movement
@@ -41,6 +45,54 @@ struct FCameraAnimation
 	{}
 };
 
+/**
+ * One POST /editor/capture request: a single frame, or a sequence of frames
+ * taken at evenly spaced points along a camera animation path.
+ */
+struct FCaptureRun
+{
+	enum class EDelivery : uint8
+	{
+		/** JSON with base64 frames, answered when the run finishes */
+		Inline,
+		/** Raw image bytes, answered when the run finishes (single frame only) */
+		Binary,
+		/** 202 with a job ID; frames are fetched from /editor/capture/{id} */
+		Job
+	};
+
+	/** Empty unless delivered as a job */
+	FString JobId;
+	EDelivery Delivery = EDelivery::Inline;
+	FViewportCapture::FSettings Settings;
+
+	/** Editor frames to let render after moving the camera before reading back */
+	int32 SettleFrames = 1;
+
+	/** Sequence mode: Path is sampled at NumFrames eased points from its start to its end */
+	bool bSequence = false;
+	FCameraAnimation Path;
+	int32 NumFrames = 1;
+
+	/** Set for Inline and Binary runs until they answer */
+	FRESTResponder Responder;
+
+	/** Progress */
+	TArray<TSharedPtr<const FViewportCapture::FFrame>> Frames;
+	bool bPosed = false;
+	bool bCapturing = false;
+	uint64 SettleUntilFrame = 0;
+
+	/** Empty while running; "completed" or "failed" */
+	FString Status;
+	FString Error;
+	int32 ErrorStatusCode = 500;
+	FDateTime SubmitTime;
+	FDateTime EndTime;
+
+	bool IsFinished() const { return !Status.IsEmpty(); }
+};
+
 /**
  * Editor utility endpoints.
  * Provides screenshot, camera, selection, and console command features.
@@ -48,6 +100,9 @@ struct FCameraAnimation
  * Endpoints:
  *   GET  /editor/project       - Project metadata (name, path, engine version)
  *   POST /editor/screenshot    - Capture viewport to file
+ *   POST /editor/capture       - Capture viewport frames in memory (inline, binary or job)
+ *   GET  /editor/capture/{id}  - Capture job status and frames
+ *   GET  /editor/capture/{id}/frame/{index} - One captured frame as raw image bytes
  *   POST /editor/camera        - Move viewport camera (instant or animated)
  *   GET  /editor/selection     - Get selected actors
  *   POST /editor/selection     - Set selected actors
@@ -66,10 +121,13 @@ public:
 	// IRESTHandler interface
 	virtual FString GetBasePath() const override { return TEXT("/editor"); }
 	virtual FString GetHandlerName() const override { return TEXT("Editor"); }
-	virtual FString GetDescription() const override { return TEXT("Editor utilities: screenshot, camera, selection, console"); }
+	virtual FString GetDescription() const override { return TEXT("Editor utilities: screenshot, capture, camera, selection, console"); }
 	virtual void RegisterRoutes(FRESTRouter& Router) override;
 	virtual TArray<TSharedPtr<FJsonObject>> GetEndpointSchemas() const override;
 
+	/** Fail unfinished captures with 503 SHUTTING_DOWN so waiting clients get a reply */
+	virtual void Shutdown() override;
+
 private:
 	/** Camera animation state */
 	FCameraAnimation CameraAnim;
@@ -78,6 +136,44 @@ private:
 	/** Tick function for camera animation */
 	bool TickCameraAnimation(float DeltaTime);
 
+	/** Cancel a running camera animation, if any */
+	void StopCameraAnimation();
+
+	/** Camera pose along Anim at an already-eased alpha */
+	static void EvaluateCameraAnimation(const FCameraAnimation& Anim, float EasedAlpha, FVector& OutLocation, FRotator& OutRotation);
+
+	/**
+	 * Parse a /editor/camera style body (location, rotation, orbit, focus_actor) into an
+	 * animation starting from the viewport's current pose; EndLocation/EndRotation hold the
+	 * final pose in both modes. Without bAnimate a found focus actor is returned in
+	 * OutInstantFocusActor for the caller to frame instead.
+	 */
+	static void BuildCameraAnimation(const TSharedPtr<FJsonObject>& Body, const FEditorViewportClient& ViewportClient, bool bAnimate,
+		FCameraAnimation& OutAnim, AActor*& OutInstantFocusActor, FString& OutFocusWarning);
+
+	/** Capture runs oldest first; runs take the viewport one at a time. Finished job runs are kept for polling. */
+	TArray<TSharedRef<FCaptureRun>> CaptureRuns;
+	FTSTicker::FDelegateHandle CaptureTickHandle;
+
+	/** Drives the oldest unfinished capture run: pose, settle, read back, repeat */
+	bool TickCapture(float DeltaTime);
+
+	/** Queue Run and start the capture ticker */
+	void StartCaptureRun(const TSharedRef<FCaptureRun>& Run);
+
+	/** Mark Run finished, answer its responder or post its job event, and trim old jobs */
+	void FinishCaptureRun(const TSharedRef<FCaptureRun>& Run, const FString& Error = FString(), int32 ErrorStatusCode = 500);
+
+	/** Response for a finished Inline or Binary run */
+	static FRESTResponse MakeCaptureResponse(const FCaptureRun& Run);
+
+	/** A job run by ID, or null */
+	TSharedPtr<FCaptureRun> FindCaptureJob(const FString& JobId) const;
+
+	/** Polls a background Live Coding compile and posts compile_finished when it ends */
+	FTSTicker::FDelegateHandle LiveCodingTickHandle;
+	bool TickLiveCodingWatch(float DeltaTime);
+
 	/** Ease in-out interpolation */
 	static float EaseInOut(float T);
 
@@ -88,6 +184,15 @@ private:
 	/** POST /editor/screenshot - Capture viewport to file */
 	FRESTResponse HandleScreenshot(const FRESTRequest& Request);
 
+	/** POST /editor/capture - Capture one frame or a camera-path sequence in memory */
+	FRESTResponse HandleCapture(const FRESTRequest& Request);
+
+	/** GET /editor/capture/{id} - Capture job status and frames */
+	FRESTResponse HandleGetCaptureJob(const FRESTRequest& Request, const FString& JobId);
+
+	/** GET /editor/capture/{id}/frame/{index} - One frame of a capture job as image bytes */
+	FRESTResponse HandleGetCaptureFrame(const FRESTRequest& Request, const FString& JobId, const FString& FrameIndex);
+
 	/** POST /editor/camera - Move viewport camera to location/rotation or focus on actor */
 	FRESTResponse HandleCamera(const FRESTRequest& Request);
 
@@ -5,14 +5,22 @@
 #include "CoreMinimal.h"
 #include "IRESTHandler.h"
 #include "RESTRouter.h"
+#include "RESTSchemaCache.h"
 
 /**
  * Infrastructure endpoints for server health and API discovery.
  *
  * Endpoints:
  *   GET  /health  - Server health check
- *   GET  /schema  - Self-documenting API specification
+ *   GET  /schema  - Self-documenting API specification (cached; see FRESTSchemaCache)
  *   POST /batch   - Execute multiple requests in a single call
+ *   GET  /events  - Long-poll the editor change feed
+ *   GET  /metrics - Per-route request metrics (Prometheus text or JSON)
+ *   DELETE /metrics - Reset request metrics
+ *
+ * Batch sub-requests to ThreadSafe routes with no $N dependency between
+ * them run concurrently on worker threads; everything else runs in order
+ * on the game thread and acts as a barrier.
  */
 class FInfrastructureHandler : public IRESTHandler
 {
@@ -23,6 +31,9 @@ public:
 	virtual FString GetDescription() const override { return TEXT("Server health and API discovery"); }
 	virtual void RegisterRoutes(FRESTRouter& Router) override;
 
+	/** Build the /schema cache now (after all handlers are registered) so the first request does not pay for it */
+	void PrewarmSchema();
+
 private:
 	/** GET /health - Health check */
 	FRESTResponse HandleHealth(const FRESTRequest& Request);
@@ -33,39 +44,101 @@ private:
 	/** POST /batch - Execute multiple requests */
 	FRESTResponse HandleBatch(const FRESTRequest& Request);
 
-	/** Build schema from registered handlers */
-	TSharedPtr<FJsonObject> BuildSchema(const TArray<TSharedPtr<IRESTHandler>>& Handlers);
-
-	/** Build full schema with all handlers and endpoint details */
-	TSharedPtr<FJsonObject> BuildFullSchema();
+	/** GET /events - Wait for editor change events */
+	FRESTResponse HandleEvents(const FRESTRequest& Request);
 
-	/** Build schema for a specific handler by name */
-	TSharedPtr<FJsonObject> BuildHandlerSchema(const FString& HandlerName);
+	/** GET /metrics - Request counts, bytes and latency percentiles */
+	FRESTResponse HandleMetrics(const FRESTRequest& Request);
 
-	/** Build schema for a specific endpoint path */
-	TSharedPtr<FJsonObject> BuildEndpointSchema(const FString& EndpointPath);
+	/** DELETE /metrics - Clear recorded metrics */
+	FRESTResponse HandleResetMetrics(const FRESTRequest& Request);
 
-	/** Find handler by name (case-insensitive) */
-	TSharedPtr<IRESTHandler> FindHandlerByName(const FString& Name);
-
-	/** Find handler whose base_path matches endpoint prefix */
-	TSharedPtr<IRESTHandler> FindHandlerByEndpoint(const FString& EndpointPath);
+	/** Success-false body listing what ?handler= or ?endpoint= could have named */
+	static FRESTResponse SchemaNotFound(const FString& Error, const TCHAR* ListField, const TArray<FString>& Available);
 
 	/** Reference to router for schema generation */
 	FRESTRouter* RouterRef = nullptr;
 
+	/** Pre-encoded /schema bodies, created with the routes */
+	TUniquePtr<FRESTSchemaCache> SchemaCache;
+
+	/** A $N.path reference inside a string field of a batch sub-request body */
+	struct FBatchReference
+	{
+		/** Character range of the reference in the original string */
+		int32 Start = 0;
+		int32 Length = 0;
+
+		/** Index of the referenced request (always earlier than the referencing one) */
+		int32 ResultIndex = 0;
+
+		/** Dot-separated path into that request's result, pre-split */
+		TArray<FString> JsonPath;
+	};
+
+	/** String field value plus the references found in it */
+	struct FBatchStringTemplate
+	{
+		FString Original;
+		TArray<FBatchReference> References;
+	};
+
+	/** The fields of a body object that contain references; all other fields are passed through */
+	struct FBatchBodyTemplate
+	{
+		TArray<TPair<FString, FBatchStringTemplate>> Strings;
+		TArray<TPair<FString, TSharedRef<FBatchBodyTemplate>>> Objects;
+
+		bool IsEmpty() const { return Strings.Num() == 0 && Objects.Num() == 0; }
+	};
+
+	/** A parsed /batch sub-request */
+	struct FBatchEntry
+	{
+		int32 Index = 0;
+		bool bValid = false;
+		ERESTMethod Method = ERESTMethod::GET;
+		FString MethodStr;
+		FString Path;
+		TSharedPtr<FJsonObject> Body;
+		FBatchBodyTemplate BodyTemplate;
+
+		/** Indices of earlier requests this one references */
+		TArray<int32> Dependencies;
+
+		/** Route is registered as ThreadSafe and may run on a worker thread */
+		bool bThreadSafe = false;
+	};
+
+	/** Parse one sub-request, its references and its route's thread safety */
+	void ParseBatchEntry(const TSharedPtr<FJsonValue>& Value, int32 Index, FBatchEntry& OutEntry) const;
+
+	/** Resolve, dispatch and record one sub-request. Safe to call concurrently for different entries. */
+	void RunBatchEntry(const FBatchEntry& Entry, TArray<TSharedPtr<FJsonObject>>& Results, TArray<bool>& Succeeded) const;
+
+	/** Collect the references in a request body */
+	static void ParseBodyReferences(
+		const TSharedPtr<FJsonObject>& Body,
+		int32 EntryIndex,
+		FBatchBodyTemplate& OutTemplate,
+		TArray<int32>& OutDependencies);
+
+	/** Find $N.path references to requests before EntryIndex */
+	static void ParseStringReferences(const FString& Value, int32 EntryIndex, TArray<FBatchReference>& OutReferences);
+
 	/** Resolve variable references like $0.node.id in request body */
-	TSharedPtr<FJsonObject> ResolveVariableReferences(
-		TSharedPtr<FJsonObject> Body,
+	static TSharedPtr<FJsonObject> ResolveVariableReferences(
+		const TSharedPtr<FJsonObject>& Body,
+		const FBatchBodyTemplate& Template,
 		const TArray<TSharedPtr<FJsonObject>>& PreviousResults);
 
 	/** Resolve variable patterns in a string value */
-	FString ResolveStringVariables(
-		const FString& Value,
+	static FString ResolveStringVariables(
+		const FBatchStringTemplate& Template,
 		const TArray<TSharedPtr<FJsonObject>>& PreviousResults);
 
-	/** Extract value from JSON object using dot-separated path */
-	TSharedPtr<FJsonValue> ExtractJsonPath(
-		TSharedPtr<FJsonObject> Root,
-		const FString& Path);
+	/** Extract value from JSON object using a pre-split dot path */
+	static TSharedPtr<FJsonValue> ExtractJsonPath(
+		const TSharedPtr<FJsonObject>& Root,
+		const TArray<FString>& Parts);
 };
@@ -6,6 +6,9 @@
 #include "IRESTHandler.h"
 #include "RESTRouter.h"
 
+class FRESTJsonWriter;
+class FRESTFieldFilter;
+
 /**
  * Level/world management endpoints.
  *
@@ -37,6 +40,6 @@ private:
 	/** POST /level/load - Load a level by path */
 	FRESTResponse HandleLoad(const FRESTRequest& Request);
 
-	/** Recursively build outliner tree from actor hierarchy */
-	TSharedPtr<FJsonObject> ActorToOutlinerJson(AActor* Actor, bool bIncludeChildren);
+	/** Recursively stream one actor's outliner fields (inside an already-open object) */
+	void WriteOutlinerActor(FRESTJsonWriter& Writer, AActor* Actor, bool bIncludeChildren, const FRESTFieldFilter& Fields);
 };
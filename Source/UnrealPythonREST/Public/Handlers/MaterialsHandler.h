@@ -32,6 +32,10 @@
  *   DELETE /materials/editor/node            - Delete expression and all its connections
  *   GET  /materials/editor/export            - Export material graph as XML
  *   POST /materials/editor/import            - Import material graph from XML
+ *   GET  /materials/editor/diff              - Graph changes since a revision (query: material_path, since?)
+ *   POST /materials/editor/patch             - Apply node/connection edits in place (body: material_path, ops, base_revision?)
+ *   GET  /materials/function/editor/diff     - Function graph changes since a revision (query: function_path, since?)
+ *   POST /materials/function/editor/patch    - Apply edits to a function in place (body: function_path, ops, base_revision?)
  */
 class FMaterialsHandler : public IRESTHandler
 {
@@ -107,6 +111,12 @@ private:
 	/** Import material graph from XML */
 	FRESTResponse HandleImportGraph(const FRESTRequest& Request);
 
+	/** GET /materials/editor/diff - Graph changes since a revision, or the full graph */
+	FRESTResponse HandleGraphDiff(const FRESTRequest& Request);
+
+	/** POST /materials/editor/patch - Apply patch operations in place with one recompile */
+	FRESTResponse HandleGraphPatch(const FRESTRequest& Request);
+
 	// Material Function endpoints
 	/** POST /materials/function/create - Create new material function asset */
 	FRESTResponse HandleCreateMaterialFunction(const FRESTRequest& Request);
@@ -141,6 +151,12 @@ private:
 	/** POST /materials/function/editor/import - Import function graph from XML */
 	FRESTResponse HandleImportMaterialFunctionGraph(const FRESTRequest& Request);
 
+	/** GET /materials/function/editor/diff - Function graph changes since a revision */
+	FRESTResponse HandleMaterialFunctionGraphDiff(const FRESTRequest& Request);
+
+	/** POST /materials/function/editor/patch - Apply patch operations to a function in place */
+	FRESTResponse HandleMaterialFunctionGraphPatch(const FRESTRequest& Request);
+
 	/**
 	 * Find the active Material Editor and its edited Material.
 	 * @param OutMaterial - The currently edited Material (if found)
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "IRESTHandler.h"
 #include "HAL/CriticalSection.h"
+#include "Containers/Ticker.h"
 
 // Forward declarations
 class FRESTRouter;
@@ -24,31 +25,52 @@ enum class EPythonJobStatus : uint8
 	Cancelled
 };
 
+/** Level of a captured Python log line */
+enum class EPythonJobLogLevel : uint8
+{
+	Info,
+	Warning,
+	Error
+};
+
+/** One captured Python log line */
+struct FPythonJobLogEntry
+{
+	EPythonJobLogLevel Level = EPythonJobLogLevel::Info;
+	FString Text;
+};
+
 /**
  * Represents an async Python execution job.
  * Tracks the state, output, and timing of Python code execution.
  */
 struct FPythonJob
 {
-	/** Unique identifier for this job */
+	/** Unique identifier for this job (its FPythonJobStore handle) */
 	FString JobId;
 
-	/** Python code to execute */
+	/** Python code to execute; only kept while the job is pending */
 	FString Code;
 
 	/** Current status of the job */
 	EPythonJobStatus Status = EPythonJobStatus::Pending;
 
-	/** Standard output from Python execution */
-	FString Output;
+	/**
+	 * Captured output, stored once: info entries form the "output" text and
+	 * every entry appears in "logs". Capped at UnrealPythonREST.PythonMaxOutputKB.
+	 */
+	TArray<FPythonJobLogEntry> LogEntries;
+
+	/** Full capture on disk when LogEntries was truncated (empty otherwise) */
+	FString OutputFile;
 
 	/** Error message if execution failed */
 	FString Error;
 
-	/** Log messages collected during execution */
-	TArray<FString> Logs;
-
 	/** When the job was submitted */
+	FDateTime SubmitTime;
+
+	/** When the job started running (the submit time while still pending) */
 	FDateTime StartTime;
 
 	/** When the job completed (or failed/cancelled) */
@@ -57,6 +79,9 @@ struct FPythonJob
 	/** Maximum execution time in seconds (0 = no timeout) */
 	int32 TimeoutSeconds = 0;
 
+	/** True if execution was stopped because it ran past TimeoutSeconds */
+	bool bTimedOut = false;
+
 	/** Check if job is in a terminal state */
 	bool IsFinished() const
 	{
@@ -71,6 +96,105 @@ struct FPythonJob
 		FDateTime End = IsFinished() ? EndTime : FDateTime::UtcNow();
 		return (End - StartTime).GetTotalSeconds();
 	}
+
+	/** Info-level lines joined with newlines */
+	FString GetOutput() const;
+};
+
+/**
+ * Result of one Python execution.
+ */
+struct FPythonExecutionResult
+{
+	bool bSuccess = false;
+	bool bTimedOut = false;
+
+	/** Exception text when execution failed */
+	FString Error;
+
+	/** Captured output and log lines, in order */
+	TArray<FPythonJobLogEntry> LogEntries;
+};
+
+/**
+ * Fixed-capacity ring of job slots.
+ *
+ * Job IDs encode a slot index and that slot's generation, so lookups are a
+ * bounds check and a generation compare rather than a map search. New jobs
+ * take the next slot in ring order, skipping slots still pending or running; finished
+ * jobs there are simply overwritten. Age-based expiry checks a few slots per
+ * call, so adds, lookups and expiry are O(1) amortized.
+ *
+ * Not thread-safe; FPythonHandler guards it with JobsLock.
+ */
+class FPythonJobStore
+{
+public:
+	explicit FPythonJobStore(int32 InCapacity);
+
+	/**
+	 * Take a slot for a new job, evicting the oldest finished job if needed.
+	 * @return The new job (JobId set), or nullptr if every slot holds an unfinished job
+	 */
+	FPythonJob* Add();
+
+	/** Find a live job by ID */
+	FPythonJob* Find(const FString& JobId);
+
+	/** Release finished jobs older than MaxAge, checking a bounded number of slots */
+	void ExpireSome(FTimespan MaxAge);
+
+	/** Number of live jobs */
+	int32 Num() const { return Count; }
+
+	/**
+	 * Visit live jobs newest first by submit time. O(live jobs log live jobs).
+	 * @param Offset Number of matching jobs to skip
+	 * @param Limit Maximum number of jobs to visit
+	 * @return Total number of live jobs
+	 */
+	int32 ListNewestFirst(int32 Offset, int32 Limit, TFunctionRef<void(const FPythonJob&)> Visitor) const;
+
+	/** Drop all jobs */
+	void Empty();
+
+private:
+	struct FSlot
+	{
+		uint32 Generation = 0;
+		bool bOccupied = false;
+		FPythonJob Job;
+	};
+
+	/** Reset a slot's job, keeping small string allocations for reuse */
+	void ReleaseSlot(FSlot& Slot);
+
+	TArray<FSlot> Slots;
+
+	/** Next slot to hand out; the slot after the newest job */
+	int32 Head = 0;
+
+	/** Where ExpireSome resumes */
+	int32 ExpireCursor = 0;
+
+	int32 Count = 0;
+
+	/** Random per-session prefix so IDs from an earlier editor session never match */
+	uint32 SessionTag = 0;
+};
+
+/** A snippet compiled by POST /python/register */
+struct FPythonSnippet
+{
+	/** SHA-1 of the source; the Python-side code object is tagged with the same value */
+	FString Hash;
+
+	/** Kept so a call can recompile the snippet if the Python side lost it */
+	FString Source;
+
+	FDateTime RegisteredAt;
+
+	int32 CallCount = 0;
 };
 
 /**
@@ -79,17 +203,26 @@ struct FPythonJob
  * Provides endpoints for executing Python code synchronously or asynchronously
  * via Unreal's IPythonScriptPlugin.
  *
+ * Async jobs go into a bounded FIFO queue that a core ticker drains on the
+ * game thread, running jobs until the per-tick budget
+ * (UnrealPythonREST.PythonJobBudgetMs) is used up. Output and log lines are
+ * captured from ExecPythonCommandEx. Timeouts are enforced by a Python-side
+ * watchdog timer that raises TimeoutError in the running script.
+ *
  * Endpoints:
  *   POST /python/execute - Execute Python code synchronously
  *   POST /python/jobs - Submit async job (returns job ID)
  *   GET  /python/jobs - List all jobs
  *   GET  /python/jobs/{id} - Get job status and result
  *   DELETE /python/jobs/{id} - Cancel a pending/running job
+ *   POST /python/register - Compile a named snippet once
+ *   POST /python/call - Run a registered snippet with JSON arguments
+ *   GET  /python/snippets - List registered snippets
  */
 class FPythonHandler : public IRESTHandler
 {
 public:
-	FPythonHandler() = default;
+	FPythonHandler();
 	virtual ~FPythonHandler() = default;
 
 	//~ Begin IRESTHandler Interface
@@ -109,8 +242,14 @@ private:
 	FRESTResponse HandleExecute(const FRESTRequest& Request);
 
 	/**
-	 * Handle GET /python/jobs - List all jobs.
-	 * Returns list of job IDs with their current status.
+	 * Handle POST /python/jobs - Asynchronous submission.
+	 * Queues the code and returns the job ID immediately.
+	 */
+	FRESTResponse HandleSubmitJob(const FRESTRequest& Request);
+
+	/**
+	 * Handle GET /python/jobs - List jobs, newest first.
+	 * Paginated with offset/limit query parameters.
 	 */
 	FRESTResponse HandleListJobs(const FRESTRequest& Request);
 
@@ -127,33 +266,72 @@ private:
 	FRESTResponse HandleCancelJob(const FRESTRequest& Request, const FString& JobId);
 
 	/**
-	 * Execute Python code via IPythonScriptPlugin.
-	 * @param Code The Python code to execute
-	 * @return Output from Python execution
+	 * Handle POST /python/register - Compile a named snippet.
+	 * The compiled code object is kept on the Python side and reused until the source hash changes.
 	 */
-	FString ExecutePythonCode(const FString& Code);
+	FRESTResponse HandleRegisterSnippet(const FRESTRequest& Request);
 
 	/**
-	 * Generate a unique job ID.
-	 * @return New UUID-based job identifier
+	 * Handle POST /python/call - Run a registered snippet.
+	 * Arguments arrive as a JSON dict bound to `args`; `result` is returned as JSON.
 	 */
-	FString GenerateJobId();
+	FRESTResponse HandleCallSnippet(const FRESTRequest& Request);
+
+	/** Handle GET /python/snippets - List registered snippets */
+	FRESTResponse HandleListSnippets(const FRESTRequest& Request);
 
 	/**
-	 * Clean up expired jobs to prevent memory leaks.
-	 * Removes jobs older than JobExpirationHours.
+	 * Read code and timeout from a request body.
+	 * @return false (with OutError set) if the body or code is missing
+	 */
+	bool ParseCodeRequest(const FRESTRequest& Request, FString& OutCode, int32& OutTimeoutSeconds, FString& OutError) const;
+
+	/** Add a pending job to the queue. Returns false if the queue is full. */
+	bool EnqueueJob(const FString& Code, int32 TimeoutSeconds, FString& OutJobId);
+
+	/**
+	 * Execute Python code via IPythonScriptPlugin, capturing its output.
+	 * @param Code The Python code to execute
+	 * @param TimeoutSeconds Raise TimeoutError in the script after this long (0 = no limit)
 	 */
-	void CleanupOldJobs();
+	FPythonExecutionResult ExecutePythonCode(const FString& Code, int32 TimeoutSeconds);
+
+	/** Install the snippet runtime if needed and compile Code under Name; false with the Python error on failure */
+	bool CompileSnippet(const FString& Name, const FString& Hash, const FString& Code, FString& OutError);
+
+	/** Core ticker callback: run queued jobs within the per-tick budget */
+	bool TickJobQueue(float DeltaTime);
+
+	/** Run one queued job to completion on the game thread */
+	void RunJob(const FString& JobId);
+
+	/** Write a job's output/logs fields */
+	static void WriteJobOutput(const FPythonJob& Job, TSharedPtr<FJsonObject>& JobJson);
 
 private:
 	/** Active and completed jobs */
-	TMap<FString, FPythonJob> Jobs;
+	FPythonJobStore Jobs;
+
+	/** Registered snippets by name (game thread only) */
+	TMap<FString, FPythonSnippet> Snippets;
+
+	/** IDs of pending jobs, oldest first */
+	TArray<FString> PendingJobs;
 
 	/** Lock for thread-safe job access */
 	FCriticalSection JobsLock;
 
+	/** Ticker that drains PendingJobs */
+	FTSTicker::FDelegateHandle TickHandle;
+
+	/** Guards against a job re-entering the queue drain (e.g. via a modal loop) */
+	bool bRunningJob = false;
+
 	/** Maximum number of jobs to keep in memory */
-	static constexpr int32 MaxJobs = 100;
+	static constexpr int32 MaxJobs = 256;
+
+	/** Maximum number of jobs waiting to run */
+	static constexpr int32 MaxQueuedJobs = 32;
 
 	/** How long to keep completed jobs before cleanup (in hours) */
 	static constexpr int32 JobExpirationHours = 1;
@@ -0,0 +1,192 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+/**
+ * UTF-8 byte buffer for streamed responses.
+ *
+ * Buffers come from a small process-wide pool and go back to it when the
+ * last reference is released, so large list responses reuse capacity that
+ * earlier requests already grew instead of reallocating on every request.
+ */
+class UNREALPYTHONREST_API FRESTOutputBuffer
+{
+public:
+	/** Take a buffer from the pool (or allocate one). The buffer is empty. */
+	static TSharedRef<FRESTOutputBuffer> Acquire();
+
+	TArray<uint8> Bytes;
+
+private:
+	static void Release(FRESTOutputBuffer* Buffer);
+};
+
+/** Encoding produced by FRESTJsonWriter */
+enum class ERESTWireFormat : uint8
+{
+	/** UTF-8 JSON text */
+	Json,
+	/** MessagePack (application/msgpack) */
+	MsgPack
+};
+
+/**
+ * Streaming JSON writer that appends UTF-8 directly to an FRESTOutputBuffer.
+ *
+ * Mirrors the TJsonWriter call pattern (WriteObjectStart / WriteValue /
+ * WriteArrayEnd ...) but never builds an FJsonObject tree or an
+ * intermediate UTF-16 string. Output is condensed.
+ *
+ * Usage:
+ *   FRESTJsonWriter Writer;
+ *   Writer.WriteObjectStart();
+ *   Writer.WriteValue(TEXT("success"), true);
+ *   Writer.WriteArrayStart(TEXT("actors"));
+ *   ...
+ *   Writer.WriteArrayEnd();
+ *   Writer.WriteObjectEnd();
+ *   return FRESTResponse::Stream(Writer);
+ *
+ * The same calls can produce MessagePack instead. A default-constructed
+ * writer uses the format of the innermost FScopedWireFormat on this thread,
+ * which the router sets from the request's Accept header, so handlers get
+ * binary output without knowing about it.
+ */
+class UNREALPYTHONREST_API FRESTJsonWriter
+{
+public:
+	/** Sets the format default-constructed writers use on this thread */
+	class UNREALPYTHONREST_API FScopedWireFormat
+	{
+	public:
+		explicit FScopedWireFormat(ERESTWireFormat Format);
+		~FScopedWireFormat();
+
+	private:
+		ERESTWireFormat Previous;
+	};
+
+	/** Format default-constructed writers use on this thread */
+	static ERESTWireFormat GetThreadFormat();
+
+	/** Writer in the current thread's wire format (JSON unless a FScopedWireFormat says otherwise) */
+	FRESTJsonWriter();
+	explicit FRESTJsonWriter(ERESTWireFormat InFormat);
+
+	ERESTWireFormat GetFormat() const { return Format; }
+	bool IsBinary() const { return Format == ERESTWireFormat::MsgPack; }
+
+	/** Switch format before anything has been written (e.g. NDJSON output is always text) */
+	void SetFormat(ERESTWireFormat InFormat);
+
+	// Containers
+	void WriteObjectStart();
+	void WriteObjectStart(FStringView Identifier);
+	void WriteObjectEnd();
+	void WriteArrayStart();
+	void WriteArrayStart(FStringView Identifier);
+	void WriteArrayEnd();
+
+	// Object members
+	void WriteValue(FStringView Identifier, FStringView Value);
+	void WriteValue(FStringView Identifier, const FString& Value) { WriteValue(Identifier, FStringView(Value)); }
+	void WriteValue(FStringView Identifier, const TCHAR* Value) { WriteValue(Identifier, FStringView(Value)); }
+	void WriteValue(FStringView Identifier, FName Value);
+	void WriteValue(FStringView Identifier, bool Value);
+	void WriteValue(FStringView Identifier, int32 Value) { WriteValue(Identifier, static_cast<int64>(Value)); }
+	void WriteValue(FStringView Identifier, int64 Value);
+	void WriteValue(FStringView Identifier, double Value);
+	void WriteNull(FStringView Identifier);
+
+	// Array elements
+	void WriteValue(FStringView Value);
+	void WriteValue(const FString& Value) { WriteValue(FStringView(Value)); }
+	void WriteValue(const TCHAR* Value) { WriteValue(FStringView(Value)); }
+	void WriteValue(FName Value);
+	void WriteValue(bool Value);
+	void WriteValue(int32 Value) { WriteValue(static_cast<int64>(Value)); }
+	void WriteValue(int64 Value);
+	void WriteValue(double Value);
+	void WriteNull();
+
+	/**
+	 * Fixed-size numeric array (vectors, rotators, matrices). JSON writes plain
+	 * numbers; MessagePack packs float32 values, 5 bytes each.
+	 */
+	void WriteFloatArray(FStringView Identifier, TConstArrayView<double> Values);
+	void WriteFloatArray(TConstArrayView<double> Values);
+
+	/** Write an existing DOM value (for handlers that mix streamed and FJsonObject output) */
+	void WriteJsonValue(FStringView Identifier, const TSharedPtr<FJsonValue>& Value);
+	void WriteJsonValue(const TSharedPtr<FJsonValue>& Value);
+	void WriteJsonObject(FStringView Identifier, const TSharedPtr<FJsonObject>& Object);
+	void WriteJsonObject(const TSharedPtr<FJsonObject>& Object);
+
+	/**
+	 * Finish the current root value with a newline so another can follow
+	 * (newline-delimited JSON; MessagePack values simply follow each other).
+	 * The root value must be closed.
+	 */
+	void EndRecord();
+
+	/** True once the root value has been closed */
+	bool IsComplete() const { return bRootWritten && Scopes.Num() == 0; }
+
+	/** Bytes written so far */
+	int32 GetSize() const { return Buffer->Bytes.Num(); }
+
+	/** The buffer being written to */
+	const TSharedRef<FRESTOutputBuffer>& GetBuffer() const { return Buffer; }
+
+private:
+	/** One open container */
+	struct FScope
+	{
+		/** Values (arrays) or members (objects) written so far */
+		uint32 Count = 0;
+
+		/** MessagePack: offset of the container header, patched with Count on close */
+		int32 HeaderOffset = 0;
+	};
+
+	/** Emit a separator if needed and count the value in the current scope */
+	void BeginValue();
+
+	void BeginContainer(bool bObject);
+	void EndContainer(bool bObject);
+
+	// MessagePack encoding
+	void PackString(FStringView Text);
+	void PackInteger(int64 Value);
+	void PackDouble(double Value);
+	void PackFloat(float Value);
+	void PackBigEndian(uint64 Value, int32 NumBytes);
+
+	/** BeginValue, then "Identifier": */
+	void BeginMember(FStringView Identifier);
+
+	void AppendRaw(const ANSICHAR* Text, int32 Length);
+	void AppendByte(uint8 Byte) { Buffer->Bytes.Add(Byte); }
+	void AppendQuoted(FStringView Text);
+
+	/** String, bool or null in the current format */
+	void AppendString(FStringView Text);
+	void AppendBool(bool Value);
+	void AppendNull();
+	void AppendNumber(int64 Value);
+	void AppendNumber(double Value);
+	void AppendName(FName Value);
+
+	TSharedRef<FRESTOutputBuffer> Buffer;
+
+	/** One entry per open container */
+	TArray<FScope, TInlineAllocator<16>> Scopes;
+
+	ERESTWireFormat Format = ERESTWireFormat::Json;
+
+	bool bRootWritten = false;
+};
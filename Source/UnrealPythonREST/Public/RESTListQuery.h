@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RESTRouter.h"
+
+class FRESTJsonWriter;
+
+/**
+ * Field projection for item serializers.
+ *
+ * Built from a comma-separated `fields` list (e.g. "label,class"). An empty
+ * filter wants every field. Serializers check Wants() before computing a
+ * field, so expensive data (bounds, tags, pins) is never built unless asked
+ * for.
+ */
+class UNREALPYTHONREST_API FRESTFieldFilter
+{
+public:
+	FRESTFieldFilter() = default;
+
+	/** Parse "a,b,c"; whitespace around names is ignored */
+	explicit FRESTFieldFilter(FStringView FieldList);
+
+	/** True if Field should be written (always true for an empty filter) */
+	bool Wants(FStringView Field) const;
+
+	/** True if at least one field was requested */
+	bool IsProjected() const { return Fields.Num() > 0; }
+
+private:
+	TArray<FString, TInlineAllocator<8>> Fields;
+};
+
+/**
+ * Shared options for list endpoints: field projection, cursor pagination and
+ * NDJSON output.
+ *
+ * Read from query parameters (GET) or body fields (POST):
+ *   fields=label,class  Only these fields per item
+ *   limit=<n>           Page size (clamped to the endpoint's maximum)
+ *   cursor=<token>      Continue from a previous page's next_cursor
+ *   format=ndjson       One item per line instead of a JSON envelope
+ *
+ * Handlers enumerate as before, skip items before GetOffset(), write at most
+ * GetLimit() items between BeginItem/EndItem, and call Finish(). In JSON
+ * format the envelope gains "next_cursor" (null on the last page); in NDJSON
+ * format the envelope is dropped and the cursor is sent in the X-Next-Cursor
+ * header instead.
+ *
+ * Usage:
+ *   FRESTListQuery Query;
+ *   if (!FRESTListQuery::Parse(Request, 100, 10000, Query, Error)) { return FRESTResponse::BadRequest(Error); }
+ *   FRESTJsonWriter Writer;
+ *   Query.BeginList(Writer, TEXT("actors"));
+ *   for (...) { if (Query.IsBeforePage(Index)) continue; if (Query.IsAfterPage(Index)) { bMore = true; break; } Query.BeginItem(Writer); ...; Query.EndItem(Writer); }
+ *   return Query.Finish(Writer, bMore);
+ */
+class UNREALPYTHONREST_API FRESTListQuery
+{
+public:
+	/**
+	 * Read list options from a request.
+	 * @param DefaultLimit Page size when the client sends no limit
+	 * @param MaxLimit Largest page size accepted
+	 * @return false (with OutError set) for a malformed cursor or unknown format
+	 */
+	static bool Parse(const FRESTRequest& Request, int32 DefaultLimit, int32 MaxLimit, FRESTListQuery& OutQuery, FString& OutError);
+
+	const FRESTFieldFilter& GetFields() const { return Fields; }
+	bool Wants(FStringView Field) const { return Fields.Wants(Field); }
+
+	/** Index of the first item on this page */
+	int32 GetOffset() const { return Offset; }
+
+	/** Items per page */
+	int32 GetLimit() const { return Limit; }
+
+	bool IsNdjson() const { return bNdjson; }
+
+	/** Item at Index (in enumeration order) comes before this page */
+	bool IsBeforePage(int32 Index) const { return Index < Offset; }
+
+	/** Item at Index comes after this page */
+	bool IsAfterPage(int32 Index) const { return Index - Offset >= Limit; }
+
+	/**
+	 * Open the list. In JSON format writes {"success": true, <header>, "<ArrayName>": [
+	 * @param WriteHeader Extra envelope fields before the array (skipped for NDJSON)
+	 */
+	void BeginList(FRESTJsonWriter& Writer, FStringView ArrayName, TFunctionRef<void(FRESTJsonWriter&)> WriteHeader) const;
+	void BeginList(FRESTJsonWriter& Writer, FStringView ArrayName) const;
+
+	/** Open / close one item object */
+	void BeginItem(FRESTJsonWriter& Writer) const;
+	void EndItem(FRESTJsonWriter& Writer) const;
+
+	/** Write one already-built item (for serializers that return FJsonObject) */
+	void WriteItem(FRESTJsonWriter& Writer, const TSharedPtr<FJsonObject>& Item) const;
+
+	/**
+	 * Close the list and build the response.
+	 * @param bHasMore More items follow this page
+	 * @param WriteTrailer Extra envelope fields after the array, e.g. count (skipped for NDJSON)
+	 */
+	FRESTResponse Finish(FRESTJsonWriter& Writer, bool bHasMore, TFunctionRef<void(FRESTJsonWriter&)> WriteTrailer) const;
+	FRESTResponse Finish(FRESTJsonWriter& Writer, bool bHasMore) const;
+
+	/** Opaque token that continues a listing at Offset */
+	static FString MakeCursor(int32 Offset);
+
+	/** Add the fields/cursor/format parameter schemas to an endpoint's "parameters" object */
+	static void DescribeParameters(const TSharedPtr<FJsonObject>& Params);
+
+private:
+	FRESTFieldFilter Fields;
+	int32 Offset = 0;
+	int32 Limit = MAX_int32;
+	bool bNdjson = false;
+};
@@ -0,0 +1,140 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RESTRouter.h"
+#include <atomic>
+
+/** Phases of one request, as timed by the router */
+enum class ERESTPhase : uint8
+{
+	/** Server callback to response handed back to the server */
+	Total,
+	/** ParseRequest, body decoding and route lookup */
+	Parse,
+	/** Waiting in the FRESTScheduler for the game thread */
+	Queue,
+	/** Route handler (and version check) */
+	Dispatch,
+	/** BuildResponse: encoding, ETag and compression */
+	Serialize,
+
+	Num
+};
+
+/** Timings of one request; phases that did not happen stay negative */
+struct FRESTRequestTiming
+{
+	double Seconds[static_cast<int32>(ERESTPhase::Num)] = { -1.0, -1.0, -1.0, -1.0, -1.0 };
+
+	double& operator[](ERESTPhase Phase) { return Seconds[static_cast<int32>(Phase)]; }
+	double operator[](ERESTPhase Phase) const { return Seconds[static_cast<int32>(Phase)]; }
+};
+
+/**
+ * Log-linear latency histogram in the style of HdrHistogram.
+ *
+ * Values are microseconds, bucketed with 8 sub-buckets per power of two, so
+ * quantiles are within about 6% from 1 us up to roughly 70 minutes. Recording
+ * is a few relaxed atomic adds and never allocates.
+ */
+class UNREALPYTHONREST_API FRESTLatencyHistogram
+{
+public:
+	FRESTLatencyHistogram();
+
+	/** Safe from any thread */
+	void Record(double Seconds);
+
+	/** Clear all counts. Not atomic as a whole: concurrent Records may be partly kept. */
+	void Reset();
+
+	/** Value at quantile Q (0..1), in seconds; 0 when empty */
+	double GetQuantile(double Q) const;
+
+	double GetMaxSeconds() const { return static_cast<double>(MaxMicros.load(std::memory_order_relaxed)) / 1e6; }
+	double GetSumSeconds() const { return static_cast<double>(SumMicros.load(std::memory_order_relaxed)) / 1e6; }
+	uint64 GetCount() const { return Count.load(std::memory_order_relaxed); }
+
+private:
+	static constexpr int32 SubBucketBits = 3;
+	static constexpr int32 SubBuckets = 1 << SubBucketBits;
+
+	/** Exact buckets below SubBuckets us, then SubBuckets per power of two up to 2^32 us */
+	static constexpr int32 NumBuckets = (32 - SubBucketBits + 1) * SubBuckets;
+
+	static int32 BucketIndex(uint64 Micros);
+
+	/** Middle of a bucket's range, in microseconds */
+	static uint64 BucketValue(int32 Index);
+
+	std::atomic<uint64> Buckets[NumBuckets];
+	std::atomic<uint64> Count{0};
+	std::atomic<uint64> SumMicros{0};
+	std::atomic<uint64> MaxMicros{0};
+};
+
+/**
+ * Per-route request metrics: counts by status class, request and response
+ * bytes, and a latency histogram per phase.
+ *
+ * Routes are keyed by their registered pattern (/python/jobs/{id}), so
+ * parameterized paths share one entry. Requests that match no route are
+ * counted under "unmatched". Editor frame times and process memory are
+ * reported alongside, so load tests can see what serving costs the editor.
+ * Exposed by GET /metrics.
+ */
+class UNREALPYTHONREST_API FRESTMetrics
+{
+public:
+	/** Record one finished request. Safe from any thread. */
+	void Record(ERESTMethod Method, const FString& Route, int32 StatusCode, int64 RequestBytes, int64 ResponseBytes, const FRESTRequestTiming& Timing);
+
+	/** Prometheus text exposition format (version 0.0.4) */
+	FString ToPrometheus(int32 QueuedRequests) const;
+
+	/** Same data as one JSON object, latencies in milliseconds */
+	void WriteJson(FRESTJsonWriter& Writer, int32 QueuedRequests) const;
+
+	/** Record one editor frame. Game thread. */
+	void RecordFrame(double DeltaSeconds);
+
+	/** Core ticker delta times since start or reset */
+	const FRESTLatencyHistogram& GetFrameTime() const { return FrameTime; }
+
+	/** Drop all recorded data, including frame times and the peak memory mark */
+	void Reset();
+
+private:
+	/** Status classes counted per route */
+	static constexpr int32 NumStatusClasses = 4;
+
+	struct FRouteMetrics
+	{
+		ERESTMethod Method = ERESTMethod::GET;
+		FString Route;
+
+		/** 2xx (and anything below 300), 3xx, 4xx, 5xx */
+		std::atomic<uint64> Status[NumStatusClasses] = {};
+		std::atomic<uint64> RequestBytes{0};
+		std::atomic<uint64> ResponseBytes{0};
+		FRESTLatencyHistogram Latency[static_cast<int32>(ERESTPhase::Num)];
+
+		uint64 GetRequests() const;
+	};
+
+	/** Entries sorted by route then method, for stable output */
+	TArray<const FRouteMetrics*> GetSortedRoutes() const;
+
+	mutable FRWLock Lock;
+
+	/** Keyed by "METHOD route" */
+	TMap<FString, TUniquePtr<FRouteMetrics>> Routes;
+
+	/** Core ticker delta times since start or reset */
+	FRESTLatencyHistogram FrameTime;
+
+	/** Highest used physical memory seen by RecordFrame since start or reset */
+	std::atomic<uint64> PeakUsedPhysical{0};
+};
@@ -0,0 +1,37 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+/**
+ * MessagePack support for the REST wire format.
+ *
+ * Encoding is done by FRESTJsonWriter in ERESTWireFormat::MsgPack mode; this
+ * is the other half, turning a MessagePack body into the same FJsonValue DOM
+ * the JSON parser produces so handlers read request fields the same way
+ * whatever the client sent.
+ *
+ * Mapping: nil -> null, integers and floats -> number, str -> string,
+ * bin -> base64 string, array -> array, map -> object (integer keys become
+ * their decimal string). Extension types are rejected.
+ */
+namespace RESTMsgPack
+{
+	/** Canonical media type, sent in Content-Type */
+	UNREALPYTHONREST_API extern const TCHAR* const ContentType;
+
+	/** True for application/msgpack or application/x-msgpack (parameters ignored) */
+	UNREALPYTHONREST_API bool IsMediaType(FStringView MediaType);
+
+	/**
+	 * Decode exactly one value.
+	 * @return null pointer (with OutError set) for truncated, trailing or unsupported data
+	 */
+	UNREALPYTHONREST_API TSharedPtr<FJsonValue> Decode(TConstArrayView<uint8> Bytes, FString& OutError);
+
+	/** Decode a body that must be a map */
+	UNREALPYTHONREST_API TSharedPtr<FJsonObject> DecodeObject(TConstArrayView<uint8> Bytes, FString& OutError);
+}
@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RESTRouter.h"
+#include "Containers/LruCache.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * Memoized responses for Cached routes, and the outcomes of mutations sent
+ * with an Idempotency-Key header.
+ *
+ * Memoized entries are keyed by a hash of the method, path, sorted query,
+ * body and wire format, and tagged with the route's version token (editor
+ * change generations). A lookup only hits while that token is unchanged, so
+ * the editor delegates feeding FEditorChangeTracker invalidate entries
+ * without the cache subscribing to anything; stale entries are dropped when
+ * next looked up or evicted. Memory is capped by UnrealPythonREST.ResponseCacheMB,
+ * least recently used entries first.
+ *
+ * An Idempotency-Key is claimed before its request is queued and holds the
+ * response once the handler finishes, for UnrealPythonREST.IdempotencyTTLSeconds.
+ * A retry with the same key replays that response instead of applying the
+ * mutation again.
+ *
+ * Safe to call from any thread.
+ */
+class UNREALPYTHONREST_API FRESTResponseCache
+{
+public:
+	/** Outcome of ClaimIdempotencyKey */
+	enum class EClaim : uint8
+	{
+		/** First use: run the request, then call FinishIdempotencyKey */
+		Claimed,
+		/** Already answered; OutResponse holds the stored response */
+		Replay,
+		/** The first request with this key has not finished yet */
+		InProgress,
+		/** The key was used for a different request */
+		Mismatch
+	};
+
+	struct FStats
+	{
+		int32 Entries = 0;
+		int64 Bytes = 0;
+		int64 MaxBytes = 0;
+		uint64 Hits = 0;
+		uint64 Misses = 0;
+		uint64 Evictions = 0;
+		int32 IdempotencyKeys = 0;
+		uint64 Replays = 0;
+	};
+
+	FRESTResponseCache();
+
+	/** Canonical request hash: method, path, query parameters in key order, body and wire format */
+	static uint64 HashRequest(const FRESTRequest& Request, ERESTWireFormat Format);
+
+	/**
+	 * Encode a JsonBody response into StreamBody in Format, so stored copies
+	 * share one encoded body and replays skip the JSON build.
+	 */
+	static void Freeze(FRESTResponse& Response, ERESTWireFormat Format);
+
+	/** The stored response for Key if it was stored at Version. Drops an entry stored at another version. */
+	bool Find(uint64 Key, uint64 Version, FRESTResponse& OutResponse);
+
+	/** Store a frozen 2xx response; ignored when the cache is disabled or the response exceeds the memory cap */
+	void Store(uint64 Key, uint64 Version, const FRESTResponse& Response);
+
+	/** False when UnrealPythonREST.IdempotencyTTLSeconds is 0 */
+	static bool IsIdempotencyEnabled();
+
+	/**
+	 * Claim Key (already scoped to the client) for a request hashing to RequestHash.
+	 * Expired keys are forgotten first.
+	 */
+	EClaim ClaimIdempotencyKey(const FString& Key, uint64 RequestHash, FRESTResponse& OutResponse);
+
+	/**
+	 * Store the response to a claimed key. Responses that mean the request never
+	 * ran (503, 429) release the key instead so a retry executes it.
+	 */
+	void FinishIdempotencyKey(const FString& Key, const FRESTResponse& Response);
+
+	/** Drop every memoized response and idempotency key */
+	void Empty();
+
+	FStats GetStats() const;
+
+	/** Stats as members of the current object */
+	void WriteJson(FRESTJsonWriter& Writer) const;
+
+	/** Stats in Prometheus text exposition format */
+	FString ToPrometheus() const;
+
+	/** Longest Idempotency-Key accepted */
+	static constexpr int32 MaxIdempotencyKeyLen = 255;
+
+private:
+	struct FEntry
+	{
+		uint64 Version = 0;
+		int64 Bytes = 0;
+		FRESTResponse Response;
+	};
+
+	struct FIdempotencyEntry
+	{
+		uint64 RequestHash = 0;
+		bool bFinished = false;
+		double ExpiresAt = 0.0;
+		FRESTResponse Response;
+	};
+
+	/** Remove Key from Entries and its bytes from TotalBytes. Lock held. */
+	void RemoveEntry(uint64 Key);
+
+	/** Forget expired keys, then the oldest finished ones while over the key cap. Lock held. */
+	void TrimIdempotencyKeys(double Now);
+
+	mutable FCriticalSection Lock;
+
+	TLruCache<uint64, FEntry> Entries;
+	int64 TotalBytes = 0;
+	uint64 Hits = 0;
+	uint64 Misses = 0;
+	uint64 Evictions = 0;
+
+	TMap<FString, FIdempotencyEntry> IdempotencyKeys;
+	uint64 Replays = 0;
+};
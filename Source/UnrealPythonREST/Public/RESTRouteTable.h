@@ -0,0 +1,85 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RESTRouter.h"
+
+/** Path parameter values captured during a route lookup (views into the request path) */
+using FRESTPathCaptures = TArray<FStringView, TInlineAllocator<4>>;
+
+/**
+ * Route table - segment trie built at registration time.
+ *
+ * Paths are split on '/' once when a route is registered. A segment written
+ * as {name} matches any single segment and is reported as a path parameter.
+ * Static segments are compared case-insensitively and always win over a parameter segment at the same depth.
+ *
+ * Lookups walk the request path in place and do not allocate; captured
+ * parameter values are returned as views into the caller's path.
+ */
+class UNREALPYTHONREST_API FRESTRouteTable
+{
+public:
+	/** A registered route */
+	struct FRoute
+	{
+		ERESTMethod Method = ERESTMethod::GET;
+
+		/** Path as registered, e.g. /python/jobs/{id} */
+		FString Path;
+
+		/** Names of {param} segments, in path order */
+		TArray<FString> ParamNames;
+
+		FRESTRouteHandler Handler;
+
+		FRESTRouteOptions Options;
+	};
+
+	/** Add (or replace) the route for Method + Path. Returns the route index. */
+	int32 Add(ERESTMethod Method, const FString& Path, FRESTRouteHandler Handler, FRESTRouteOptions Options = FRESTRouteOptions());
+
+	/**
+	 * Find the route for Method + Path.
+	 * @param OutCaptures Receives one view per {param} segment of the matched route
+	 * @return The matched route, or nullptr
+	 */
+	const FRoute* Find(ERESTMethod Method, FStringView Path, FRESTPathCaptures& OutCaptures) const;
+
+	/** Remove all routes */
+	void Empty();
+
+	/** Number of registered routes */
+	int32 Num() const { return Routes.Num(); }
+
+	/** All registered routes, in registration order */
+	const TArray<FRoute>& GetRoutes() const { return Routes; }
+
+private:
+	static constexpr int32 NumMethods = 4;
+
+	struct FNode
+	{
+		/** Static segment text (empty for a parameter node) */
+		FString Segment;
+
+		/** Static children */
+		TArray<int32, TInlineAllocator<4>> Children;
+
+		/** Child matching any segment, if a {param} was registered at this depth */
+		int32 ParamChild = INDEX_NONE;
+
+		/** Route index per method for paths ending at this node */
+		int32 RouteIndex[NumMethods] = { INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE };
+	};
+
+	/** Recursive matcher; static children first, then the parameter child */
+	int32 MatchNode(int32 NodeIndex, FStringView Remaining, int32 MethodIndex, FRESTPathCaptures& OutCaptures) const;
+
+	/** Trie nodes; index 0 is the root */
+	TArray<FNode> Nodes;
+
+	/** Routes, indexed by FNode::RouteIndex */
+	TArray<FRoute> Routes;
+};
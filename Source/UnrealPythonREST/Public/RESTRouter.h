@@ -6,8 +6,17 @@
 #include "HttpServerModule.h"
 #include "IHttpRouter.h"
 #include "HttpServerResponse.h"
+#include "Containers/Ticker.h"
+#include <atomic>
 
 class IRESTHandler;
+class FRESTRouteTable;
+class FRESTOutputBuffer;
+class FRESTJsonWriter;
+class FRESTScheduler;
+class FRESTMetrics;
+class FRESTResponseCache;
+enum class ERESTWireFormat : uint8;
 
 /** HTTP method types */
 enum class ERESTMethod : uint8
@@ -18,17 +27,91 @@ enum class ERESTMethod : uint8
     DELETE
 };
 
+/** Method name as used in logs and error messages */
+inline const TCHAR* LexToString(ERESTMethod Method)
+{
+    switch (Method)
+    {
+    case ERESTMethod::POST:
+        return TEXT("POST");
+    case ERESTMethod::PUT:
+        return TEXT("PUT");
+    case ERESTMethod::DELETE:
+        return TEXT("DELETE");
+    default:
+        return TEXT("GET");
+    }
+}
+
+/**
+ * JSON request body that is parsed on first access.
+ *
+ * Behaves like the TSharedPtr<FJsonObject> it replaces (->, IsValid(),
+ * implicit conversion), so handlers that never look at the body - GET
+ * routes and raw-body routes - never pay for deserialization.
+ */
+class UNREALPYTHONREST_API FRESTLazyJsonBody
+{
+public:
+    FRESTLazyJsonBody() = default;
+
+    /** Use an already-built object (e.g. /batch sub-requests) */
+    FRESTLazyJsonBody& operator=(TSharedPtr<FJsonObject> InObject)
+    {
+        Object = MoveTemp(InObject);
+        Source.Reset();
+        bParsed = true;
+        return *this;
+    }
+
+    /** Parse from this UTF-8 text on first access. The text must outlive the request. */
+    void SetSource(FUtf8StringView InSource)
+    {
+        Source = InSource;
+        Object.Reset();
+        bParsed = InSource.IsEmpty();
+    }
+
+    /** The parsed object, or null if the body is empty or not a JSON object */
+    const TSharedPtr<FJsonObject>& Get() const;
+
+    operator const TSharedPtr<FJsonObject>&() const { return Get(); }
+    FJsonObject* operator->() const { return Get().Get(); }
+    bool IsValid() const { return Get().IsValid(); }
+
+private:
+    FUtf8StringView Source;
+    mutable TSharedPtr<FJsonObject> Object;
+    mutable bool bParsed = true;
+};
+
 /** Request context passed to route handlers */
 struct FRESTRequest
 {
     FString Path;
     ERESTMethod Method;
     TMap<FString, FString> QueryParams;
+    /** Values of {param} segments in the matched route, keyed by parameter name */
     TMap<FString, FString> PathParams;
-    FString Body;
-    TSharedPtr<FJsonObject> JsonBody;
+
+    /** Raw UTF-8 body. Views the router's copy of the request and is only valid until the response is sent. */
+    FUtf8StringView Body;
+
+    /** Body as JSON, parsed lazily from Body */
+    FRESTLazyJsonBody JsonBody;
+
+    /** Request headers (case-insensitive names; repeated headers joined with ", ") */
+    TMap<FString, FString> Headers;
+
+    /** Decode Body to a TCHAR string (for handlers that take raw text rather than JSON) */
+    FString GetBodyString() const;
 };
 
+struct FRESTResponse;
+
+/** Completes a deferred response. Call it once, on the game thread. */
+using FRESTResponder = TFunction<void(FRESTResponse&&)>;
+
 /** Response builder */
 struct FRESTResponse
 {
@@ -36,22 +119,131 @@ struct FRESTResponse
     TSharedPtr<FJsonObject> JsonBody;
     FString RawBody;
 
+    /** Pre-encoded body written by FRESTJsonWriter; takes precedence over JsonBody/RawBody */
+    TSharedPtr<FRESTOutputBuffer> StreamBody;
+
+    /** Encoding of StreamBody, copied from the writer (value-initialized: Json) */
+    ERESTWireFormat StreamFormat{};
+
+    /** Optional gzip encoding of StreamBody, sent as-is to clients that accept gzip instead of compressing per request */
+    TSharedPtr<FRESTOutputBuffer> StreamBodyGzip;
+
+    /** Extra HTTP response headers */
+    TMap<FString, FString> Headers;
+
+    /** Content-Type of the body; empty means application/json */
+    FString ContentType;
+
+    /**
+     * Set by Defer(): the router calls this with a responder instead of
+     * sending the response, and the connection stays open until the
+     * responder runs. Not supported inside /batch.
+     */
+    TFunction<void(FRESTResponder)> Deferred;
+
+    /**
+     * Get the body as a JSON object.
+     * Streamed bodies are parsed on demand, so this is only for callers that
+     * need the DOM (e.g. /batch results), not for the HTTP response path.
+     */
+    TSharedPtr<FJsonObject> GetJson() const;
+
     static FRESTResponse Ok(TSharedPtr<FJsonObject> Json);
+    static FRESTResponse Stream(const FRESTJsonWriter& Writer, int32 Code = 200);
+    static FRESTResponse Defer(TFunction<void(FRESTResponder)> Start);
     static FRESTResponse Error(int32 Code, const FString& ErrorCode, const FString& Message);
     static FRESTResponse NotFound(const FString& Message = TEXT("Not found"));
     static FRESTResponse BadRequest(const FString& Message);
     static FRESTResponse ServerError(const FString& Message);
+    static FRESTResponse NotModified(const FString& ETag);
 };
 
 /** Route handler callback */
 DECLARE_DELEGATE_RetVal_OneParam(FRESTResponse, FRESTRouteHandler, const FRESTRequest&);
 
+/**
+ * Version token callback for a GET route.
+ * Must be much cheaper than the handler and change whenever its output would
+ * change (e.g. an FEditorChangeTracker generation). Return 0 for "unversioned".
+ */
+DECLARE_DELEGATE_RetVal_OneParam(uint64, FRESTRouteVersion, const FRESTRequest&);
+
+/** Optional per-route behaviour */
+struct FRESTRouteOptions
+{
+    /** When bound, the router answers If-None-Match with 304 without running the handler */
+    FRESTRouteVersion Version;
+
+    /**
+     * Handler only reads thread-safe state (schema, server stats) and may run
+     * off the game thread, e.g. alongside other /batch sub-requests.
+     */
+    bool bThreadSafe = false;
+
+    /**
+     * Long-running or throughput work (level loads, recompiles, exports, bulk
+     * edits). Scheduled behind interactive requests on the game thread; a
+     * client can override this per request with "X-Priority: bulk|interactive".
+     */
+    bool bBulk = false;
+
+    /**
+     * Served while the module is still starting (see FRESTRouter::SetReady).
+     * Other routes answer 503 STARTING until then.
+     */
+    bool bDuringStartup = false;
+
+    /**
+     * Memoize 2xx responses of this GET route under its Version token (see
+     * FRESTResponseCache). Repeats of the same request are answered from
+     * memory - before being queued for the game thread - until the token
+     * changes. Requires a Version that is safe to call from any thread.
+     */
+    bool bCached = false;
+
+    static FRESTRouteOptions Versioned(FRESTRouteVersion InVersion)
+    {
+        FRESTRouteOptions Options;
+        Options.Version = MoveTemp(InVersion);
+        return Options;
+    }
+
+    FRESTRouteOptions& ThreadSafe()
+    {
+        bThreadSafe = true;
+        return *this;
+    }
+
+    FRESTRouteOptions& Bulk()
+    {
+        bBulk = true;
+        return *this;
+    }
+
+    FRESTRouteOptions& DuringStartup()
+    {
+        bDuringStartup = true;
+        return *this;
+    }
+
+    FRESTRouteOptions& Cached()
+    {
+        bCached = true;
+        return *this;
+    }
+};
+
 /**
  * REST Router - manages HTTP server and route dispatching.
  *
  * Handles incoming HTTP requests, parses them into FRESTRequest objects,
  * dispatches to registered route handlers, and converts responses back
  * to HTTP format.
+ *
+ * Parsing, routing and large-response serialization run on worker threads.
+ * ThreadSafe routes run there entirely; every other handler is queued on
+ * the FRESTScheduler and runs on the game thread within a per-frame budget.
+ * UnrealPythonREST.WorkerDispatch 0 handles everything inline on the game thread.
  */
 class UNREALPYTHONREST_API FRESTRouter : public TSharedFromThis<FRESTRouter>
 {
@@ -59,9 +251,40 @@ public:
     FRESTRouter();
     ~FRESTRouter();
 
-    /** Start the HTTP server on specified port */
+    /**
+     * Start the HTTP server on specified port.
+     * Register handlers first: the listener accepts requests as soon as this returns.
+     */
     bool Start(int32 Port = 8080);
 
+    /**
+     * True if nothing is bound to Port, probed with a throwaway socket.
+     * Answers true if the socket subsystem cannot tell, leaving the listener to fail.
+     */
+    static bool IsPortAvailable(int32 Port);
+
+    /**
+     * Until ready, only DuringStartup routes are served and every other route
+     * answers 503 STARTING with Retry-After. Routers start ready.
+     */
+    void SetReady(bool bInReady) { bReady.store(bInReady, std::memory_order_release); }
+    bool IsReady() const { return bReady.load(std::memory_order_acquire); }
+
+    /** Startup timings reported by /health; written on the game thread before SetReady(true) */
+    struct FStartupInfo
+    {
+        /** Port asked for; differs from GetPort() after a fallback */
+        int32 RequestedPort = 0;
+
+        /** Module startup to listener accepting requests */
+        double ListenSeconds = 0.0;
+
+        /** Module startup to every handler ready */
+        double ReadySeconds = 0.0;
+    };
+    FStartupInfo& GetStartupInfo() { return StartupInfo; }
+    const FStartupInfo& GetStartupInfo() const { return StartupInfo; }
+
     /** Stop the HTTP server */
     void Stop();
 
@@ -71,8 +294,12 @@ public:
     /** Get the current port */
     int32 GetPort() const { return CurrentPort; }
 
-    /** Register a route with a handler callback */
-    void RegisterRoute(ERESTMethod Method, const FString& Path, FRESTRouteHandler Handler);
+    /**
+     * Register a route with a handler callback.
+     * Path segments written as {name} match any single segment; the matched
+     * value is passed to the handler in FRESTRequest::PathParams.
+     */
+    void RegisterRoute(ERESTMethod Method, const FString& Path, FRESTRouteHandler Handler, FRESTRouteOptions Options = FRESTRouteOptions());
 
     /** Register a handler (calls handler's RegisterRoutes) */
     void RegisterHandler(TSharedPtr<IRESTHandler> Handler);
@@ -80,25 +307,106 @@ public:
     /** Get list of registered handlers */
     const TArray<TSharedPtr<IRESTHandler>>& GetHandlers() const { return RegisteredHandlers; }
 
-    /** Dispatch a request internally (for batch operations) */
+    /**
+     * Incremented whenever a route or handler is registered.
+     * Caches derived from the route set (e.g. /schema) compare it to know when to rebuild.
+     */
+    uint64 GetRouteGeneration() const { return RouteGeneration.load(std::memory_order_relaxed); }
+
+    /**
+     * Dispatch a request internally (for batch operations).
+     * May be called from worker threads for routes registered as ThreadSafe.
+     * Streamed responses are always JSON, whatever the outer request negotiated.
+     */
     FRESTResponse DispatchInternal(const FRESTRequest& Request);
 
+    /** True if Method + Path resolves to a route registered as ThreadSafe */
+    bool IsThreadSafeRoute(ERESTMethod Method, const FString& Path) const;
+
+    /** Get the route table */
+    const FRESTRouteTable& GetRouteTable() const { return *RouteTable; }
+
+    /** Per-route counts, bytes and latency histograms of requests served over HTTP */
+    FRESTMetrics& GetMetrics() const { return *Metrics; }
+
+    /** Memoized responses of Cached routes and stored Idempotency-Key outcomes */
+    FRESTResponseCache& GetResponseCache() const { return *ResponseCache; }
+
+    /** Requests waiting for the game thread */
+    int32 GetQueuedRequests() const;
+
+    /**
+     * Time route lookup over every registered route.
+     * Handlers are not executed; only path matching and PathParams filling are measured.
+     * Results are written to the log.
+     */
+    void BenchmarkDispatch(int32 Iterations) const;
+
 private:
-    /** Handle incoming HTTP request */
+    /** A request between the server callback and its response */
+    struct FPendingRequest;
+
+    /** Handle incoming HTTP request (game thread); the response is sent later */
     bool HandleRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
 
     /** Parse request into FRESTRequest */
     FRESTRequest ParseRequest(const FHttpServerRequest& Request);
 
-    /** Convert response to HTTP response */
-    TUniquePtr<FHttpServerResponse> BuildResponse(const FRESTResponse& Response);
+    /** Parse the request, match its route and decode its body. Answers 400 and returns false if the body cannot be decoded. */
+    bool PrepareRequest(const TSharedRef<FPendingRequest>& Pending);
+
+    /** Worker thread: run ThreadSafe routes here, queue the rest for the game thread */
+    void ProcessRequest(const TSharedRef<FPendingRequest>& Pending);
+
+    /**
+     * Answer a repeated request without running its handler: a memoized
+     * response of a Cached route, or the stored outcome of an Idempotency-Key
+     * (or 409/422 while that key is busy or was used for another request).
+     * Otherwise records what RunHandler and Complete need to store the
+     * response, and returns false.
+     */
+    bool AnswerFromCache(const TSharedRef<FPendingRequest>& Pending);
+
+    /** Run the handler in the negotiated format and complete (or defer) the response */
+    void RunHandler(const TSharedRef<FPendingRequest>& Pending);
+
+    /** Build the HTTP response (on a worker if it is large) and hand it to the server on the game thread */
+    void Complete(const TSharedRef<FPendingRequest>& Pending, FRESTResponse&& Response);
+
+    /** BuildResponse, timed */
+    TUniquePtr<FHttpServerResponse> Serialize(const TSharedRef<FPendingRequest>& Pending, const FRESTResponse& Response);
+
+    /** Send() from a game-thread task; safe after the router is destroyed */
+    void SendOnGameThread(const TSharedRef<FPendingRequest>& Pending, TUniquePtr<FHttpServerResponse>&& HttpResponse);
+
+    /** Record metrics and hand the response to the server. Game thread. */
+    void Send(const TSharedRef<FPendingRequest>& Pending, TUniquePtr<FHttpServerResponse>&& HttpResponse);
 
-    /** Route table: Method+Path -> Handler */
-    TMap<FString, FRESTRouteHandler> Routes;
+    /** Run the handler of the route PrepareRequest matched (404 if none) */
+    FRESTResponse Dispatch(const FPendingRequest& Pending);
+
+    /**
+     * Convert response to HTTP response.
+     * Encodes the body as MessagePack when the client's Accept header asks for
+     * it, adds a content ETag to GET responses that have none, answers a
+     * matching If-None-Match with 304, and compresses large bodies the client
+     * accepts.
+     */
+    TUniquePtr<FHttpServerResponse> BuildResponse(const FRESTRequest& Request, const FRESTResponse& Response);
+
+    /** Route table: (Method, path segments) -> Handler */
+    TUniquePtr<FRESTRouteTable> RouteTable;
 
     /** Registered handlers */
     TArray<TSharedPtr<IRESTHandler>> RegisteredHandlers;
 
+    /** See GetRouteGeneration() */
+    std::atomic<uint64> RouteGeneration { 0 };
+
+    /** See SetReady() */
+    std::atomic<bool> bReady { true };
+    FStartupInfo StartupInfo;
+
     /** HTTP router from engine */
     TSharedPtr<IHttpRouter> HttpRouter;
 
@@ -108,4 +416,19 @@ private:
 
     /** Route handle for cleanup */
     FHttpRouteHandle RouteHandle;
+
+    /** Request metrics; lives as long as the router so counts survive a restart of the listener */
+    TUniquePtr<FRESTMetrics> Metrics;
+
+    /** See GetResponseCache() */
+    TUniquePtr<FRESTResponseCache> ResponseCache;
+
+    /** Game-thread queue for handlers that are not ThreadSafe */
+    TUniquePtr<FRESTScheduler> Scheduler;
+
+    /** Feeds editor frame times into Metrics while the server runs */
+    FTSTicker::FDelegateHandle FrameTickHandle;
+
+    /** Worker tasks that still use the route table or handlers; Stop() waits for them */
+    std::atomic<int32> ActiveWorkers{0};
 };
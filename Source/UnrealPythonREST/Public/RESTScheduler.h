@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+/** Scheduling class of a request that runs on the game thread */
+enum class ERESTPriority : uint8
+{
+	/** A user or tool is waiting on the answer (default) */
+	Interactive,
+	/** Throughput work: level loads, recompiles, exports, bulk edits */
+	Bulk
+};
+
+/**
+ * Queued game-thread work. Called once on the game thread; bCancelled is
+ * true when the scheduler shuts down before the work ran.
+ */
+using FRESTScheduledWork = TUniqueFunction<void(bool bCancelled)>;
+
+/**
+ * Game-thread scheduler for router requests.
+ *
+ * Requests whose handlers touch UObjects are parsed and routed on worker
+ * threads and queued here. A core ticker runs queued work until
+ * UnrealPythonREST.GameThreadBudgetMs is spent, interactive work first.
+ * Every tick still runs at least one interactive and one bulk item when
+ * any are queued, so neither priority stalls, and a single slow request
+ * only delays the ones behind it until the next frame.
+ *
+ * Within a priority, clients (X-Client-Id header) take turns one item at a
+ * time, so a client sending a burst does not starve the others.
+ *
+ * Enqueue() may be called from any thread.
+ */
+class UNREALPYTHONREST_API FRESTScheduler
+{
+public:
+	FRESTScheduler();
+	~FRESTScheduler();
+
+	/**
+	 * Queue work for the game thread.
+	 * @return false (Work not taken) if UnrealPythonREST.MaxQueuedRequests items are already queued
+	 */
+	bool Enqueue(ERESTPriority Priority, const FString& ClientId, FRESTScheduledWork& Work);
+
+	/** Stop ticking and call every queued item with bCancelled = true. Game thread. */
+	void Shutdown();
+
+	/** Items waiting for the game thread */
+	int32 Num() const;
+
+private:
+	/** One client's FIFO within a priority */
+	struct FClientQueue
+	{
+		FString ClientId;
+		TArray<FRESTScheduledWork> Items;
+	};
+
+	/** Round-robin over the clients that have work at one priority */
+	struct FPriorityQueue
+	{
+		TArray<FClientQueue> Clients;
+		int32 NextClient = 0;
+		int32 Num = 0;
+	};
+
+	bool Tick(float DeltaTime);
+
+	/** Take the next item of a priority in client rotation. Lock must be held. */
+	bool Pop(ERESTPriority Priority, FRESTScheduledWork& OutWork);
+
+	mutable FCriticalSection Lock;
+	FPriorityQueue Queues[2];
+
+	FTSTicker::FDelegateHandle TickHandle;
+
+	/** Set while Tick runs work, so a handler that pumps the engine loop does not re-enter it */
+	bool bTicking = false;
+};
@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RESTRouter.h"
+#include "UObject/UObjectGlobals.h"
+#include <atomic>
+
+/**
+ * Pre-encoded /schema responses.
+ *
+ * The full schema, every handler slice (?handler=) and every endpoint slice
+ * (?endpoint=) are built from one GetEndpointSchemas() call per handler,
+ * encoded as JSON and MessagePack, and gzip-compressed once. Slices are
+ * looked up by name in an index. The snapshot is rebuilt on the next Get()
+ * after a route or handler is registered or code is reloaded (Live Coding),
+ * so an unchanged route set never rebuilds.
+ *
+ * Safe to call from any thread.
+ */
+class UNREALPYTHONREST_API FRESTSchemaCache
+{
+public:
+	/** One response body in both wire formats */
+	struct FBody
+	{
+		/** Indexed by ERESTWireFormat */
+		TSharedPtr<FRESTOutputBuffer> Encoded[2];
+
+		/** gzip of Encoded, or null where compression did not shrink it */
+		TSharedPtr<FRESTOutputBuffer> Gzip[2];
+
+		/** 200 response carrying the pre-encoded body in Format */
+		FRESTResponse ToResponse(ERESTWireFormat Format) const;
+	};
+
+	struct FSnapshot
+	{
+		uint64 RouteGeneration = 0;
+		uint32 ReloadCount = 0;
+
+		/** Hash of the full schema; never 0, so it can serve as a route version */
+		uint64 Hash = 0;
+
+		/** GET /schema */
+		FBody Full;
+
+		/** GET /schema?handler=, in registration order */
+		TArray<FString> HandlerNames;
+		TArray<FBody> Handlers;
+
+		/** GET /schema?endpoint=, in schema order */
+		TArray<FString> EndpointPaths;
+		TArray<FBody> Endpoints;
+
+		/** The slice for a handler name (case-insensitive) or endpoint path (case-insensitive, leading slash optional), or null */
+		const FBody* FindHandler(const FString& Name) const;
+		const FBody* FindEndpoint(const FString& Path) const;
+
+	private:
+		friend class FRESTSchemaCache;
+
+		/** Lowercased keys into Handlers / Endpoints */
+		TMap<FString, int32> HandlerIndex;
+		TMap<FString, int32> EndpointIndex;
+	};
+
+	using FSnapshotRef = TSharedRef<const FSnapshot, ESPMode::ThreadSafe>;
+
+	explicit FRESTSchemaCache(const FRESTRouter& InRouter);
+	~FRESTSchemaCache();
+
+	/** The current snapshot, rebuilt first if the routes or code changed since it was built */
+	FSnapshotRef Get();
+
+private:
+	/** Call GetEndpointSchemas() on every handler and encode the results */
+	FSnapshotRef Build(uint64 RouteGeneration, uint32 Reloads) const;
+
+	void OnReloadComplete(EReloadCompleteReason Reason);
+
+	const FRESTRouter& Router;
+
+	FCriticalSection Lock;
+	TSharedPtr<const FSnapshot, ESPMode::ThreadSafe> Snapshot;
+
+	/** Bumped by code reloads, which can change what handlers describe without registering routes */
+	std::atomic<uint32> ReloadCount { 0 };
+	FDelegateHandle ReloadHandle;
+};
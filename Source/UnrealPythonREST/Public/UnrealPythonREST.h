@@ -2,9 +2,11 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "Containers/Ticker.h"
 
 class FRESTRouter;
 class IRESTHandler;
+class FInfrastructureHandler;
 
 class FUnrealPythonRESTModule : public IModuleInterface
 {
@@ -19,6 +21,17 @@ public:
     void RegisterHandler(TSharedPtr<IRESTHandler> Handler);
 
 private:
+    /** Second startup phase, run on the first core tick once the listener is up */
+    void CompleteStartup();
+
     TSharedPtr<FRESTRouter> Router;
     TArray<TSharedPtr<IRESTHandler>> Handlers;
+    TWeakPtr<FInfrastructureHandler> InfrastructureHandler;
+
+    uint64 StartupCycles = 0;
+    FTSTicker::FDelegateHandle StartupTickHandle;
+
+    /** Refreshes the fleet registry entry; invalid when registration is disabled */
+    FTSTicker::FDelegateHandle HeartbeatTickHandle;
+    bool bStartupComplete = false;
 };
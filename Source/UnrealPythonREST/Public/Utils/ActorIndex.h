@@ -0,0 +1,48 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+
+/**
+ * Actor index - label, name and GUID lookup for the editor world.
+ *
+ * Built once per editor world on first use and kept current through the
+ * level-actor added/deleted, actor label and map change delegates, so
+ * handlers resolve an actor with a hash lookup instead of iterating the
+ * world. Label suggestions for "not found" errors come from a BK-tree over
+ * the indexed labels.
+ *
+ * Changes no delegate reports (undo/redo, streaming levels in or out) drop
+ * the index and it is rebuilt on the next lookup. Hits are always checked
+ * against the live actor, so a missed change costs a rebuild, never a
+ * wrong actor.
+ *
+ * Game thread only.
+ */
+class UNREALPYTHONREST_API FActorIndex
+{
+public:
+	/** Subscribe to engine/editor delegates. Called once at module startup. */
+	static void Initialize();
+
+	/** Unsubscribe and drop the index */
+	static void Shutdown();
+
+	/**
+	 * Find an actor in the editor world by label, then by object name, then by actor GUID.
+	 * Label and name comparisons ignore case. With duplicate labels the first actor indexed wins.
+	 */
+	static AActor* Find(const FString& LabelNameOrGuid);
+
+	/** Unique, non-empty actor labels in the editor world */
+	static TArray<FString> GetAllLabels();
+
+	/** Closest existing labels to Label, best first */
+	static TArray<FString> FindSimilarLabels(const FString& Label, int32 MaxResults = 3, int32 MaxDistance = 5);
+
+	/** Drop the index; it is rebuilt on the next lookup */
+	static void Invalidate();
+};
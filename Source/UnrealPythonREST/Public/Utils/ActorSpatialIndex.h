@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ConvexVolume.h"
+
+class AActor;
+
+/** Shape tested by an actor spatial query */
+enum class EActorSpatialShape : uint8
+{
+	Box,
+	Sphere,
+	Ray,
+	Frustum
+};
+
+/** One actor spatial query */
+struct FActorSpatialQuery
+{
+	EActorSpatialShape Shape = EActorSpatialShape::Box;
+
+	/** Box: world-space bounds */
+	FBox Box = FBox(ForceInit);
+
+	/** Sphere: center and radius */
+	FVector Center = FVector::ZeroVector;
+	double Radius = 0.0;
+
+	/** Ray: segment from RayStart to RayEnd */
+	FVector RayStart = FVector::ZeroVector;
+	FVector RayEnd = FVector::ZeroVector;
+
+	/** Frustum: planes, e.g. from MakeFrustum */
+	FConvexVolume Frustum;
+};
+
+/** An actor whose bounds pass a query */
+struct FActorSpatialHit
+{
+	AActor* Actor = nullptr;
+
+	/** Component bounds the actor was indexed with */
+	FBox Bounds = FBox(ForceInit);
+
+	/** Ray queries: distance along the ray to where it enters Bounds */
+	double RayDistance = 0.0;
+};
+
+/**
+ * Actor spatial index - octree of actor component bounds for the editor world.
+ *
+ * Built once per editor world on first query. Actors are added and removed
+ * from the level-actor delegates; moves are picked up through OnActorMoved
+ * and each actor's root component TransformUpdated event (so scripted moves
+ * count too), and property edits through OnObjectPropertyChanged. Re-adding
+ * an actor re-reads its root, so a root swapped by a construction script
+ * rerun (which follows an edit or move) is re-hooked; actors and components
+ * swapped by Blueprint reinstancing arrive through OnObjectsReplaced. Changed actors are only
+ * marked dirty and re-inserted at the start of the next query, so dragging
+ * thousands of actors costs nothing until someone asks.
+ *
+ * A query walks only the octree nodes the shape touches: O(log n + k).
+ * Game thread only.
+ */
+class UNREALPYTHONREST_API FActorSpatialIndex
+{
+public:
+	/** Subscribe to engine/editor delegates. Called once at module startup. */
+	static void Initialize();
+
+	/** Unsubscribe and drop the index */
+	static void Shutdown();
+
+	/** Actors in the editor world whose bounds intersect the query shape (unordered) */
+	static TArray<FActorSpatialHit> Query(const FActorSpatialQuery& Query);
+
+	/** Drop the index; it is rebuilt on the next query */
+	static void Invalidate();
+
+	/**
+	 * Build view frustum planes for a camera.
+	 * @param FovDegrees Horizontal field of view
+	 * @param AspectRatio Width / height
+	 */
+	static FConvexVolume MakeFrustum(const FVector& Location, const FRotator& Rotation, float FovDegrees, float AspectRatio, float NearClip, float FarClip);
+};
@@ -3,6 +3,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "RESTListQuery.h"
 
 /**
  * Utility functions for actor operations.
@@ -12,6 +13,7 @@ namespace ActorUtils
 {
 	/**
 	 * Find an actor by its label in the current editor world.
+	 * Falls back to the actor's object name, then its actor GUID. Uses FActorIndex.
 	 * @param Label The actor label to search for
 	 * @return The actor if found, nullptr otherwise
 	 */
@@ -19,11 +21,18 @@ namespace ActorUtils
 
 	/**
 	 * Get all actor labels in the current editor world.
-	 * Used for smart error suggestions.
-	 * @return Array of all actor labels
+	 * @return Array of unique actor labels
 	 */
 	TArray<FString> GetAllActorLabels();
 
+	/**
+	 * Labels closest to one that was not found, for smart error suggestions.
+	 * @param Label The label that was searched for
+	 * @param MaxResults Maximum number of suggestions
+	 * @return Similar labels, best first
+	 */
+	TArray<FString> FindSimilarActorLabels(const FString& Label, int32 MaxResults = 3);
+
 	/**
 	 * Spawn an actor from a class path.
 	 * @param ClassPath Full path to the actor class (e.g., "/Game/Blueprints/BP_Tree.BP_Tree_C")
@@ -52,7 +61,8 @@ namespace ActorUtils
 	/**
 	 * Convert actor to detailed JSON representation.
 	 * @param Actor The actor to convert
+	 * @param Fields Fields to include; empty includes all
 	 * @return JSON object with actor details
 	 */
-	TSharedPtr<FJsonObject> ActorToDetailedJson(AActor* Actor);
+	TSharedPtr<FJsonObject> ActorToDetailedJson(AActor* Actor, const FRESTFieldFilter& Fields = FRESTFieldFilter());
 }
@@ -0,0 +1,151 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+class FRESTJsonWriter;
+class UObject;
+class UStaticMesh;
+struct FAssetData;
+
+/**
+ * Asset bulk inspector - mesh stats, validation, export and material
+ * recompiles over thousands of assets without one blocking load per asset.
+ *
+ * A job takes a list of object paths. Answers that the asset registry
+ * already holds (mesh LOD, triangle and vertex counts, approximate size,
+ * existence) are produced at once without loading. Everything else is
+ * loaded with FStreamableManager, at most MaxInFlight requests at a time.
+ * Each asset is inspected as its load completes, and its handle is then
+ * released so garbage collection can reclaim it. A collection is requested
+ * after every GCBatchSize loads. Assets already in memory skip the load and
+ * are processed within a per-tick time budget.
+ *
+ * Results are appended as they finish, so clients read them incrementally
+ * with a cursor while the job runs. Progress and completion are also posted
+ * to the event feed (jobs topic). Game thread only.
+ */
+class UNREALPYTHONREST_API FAssetBulkInspector
+{
+public:
+	enum class EOperation : uint8
+	{
+		/** Static mesh LODs, triangles, vertices and bounds (as GET /assets/mesh_details) */
+		MeshDetails,
+		/** Asset integrity (as POST /assets/validate) */
+		Validate,
+		/** T3D text export (as POST /assets/export) */
+		Export,
+		/** Material, or a material instance's parent, recompiled for rendering (as POST /materials/recompile) */
+		RecompileMaterial
+	};
+
+	enum class ELoadPolicy : uint8
+	{
+		/** Answer from registry tags when they suffice, otherwise load */
+		Auto,
+		/** Registry only; assets the registry cannot answer for get NEEDS_LOAD */
+		Never,
+		/** Always load, ignoring registry tags */
+		Always
+	};
+
+	struct FOptions
+	{
+		EOperation Operation = EOperation::MeshDetails;
+		ELoadPolicy Load = ELoadPolicy::Auto;
+
+		/** Async loads outstanding at once */
+		int32 MaxInFlight = 16;
+
+		/** Loads between garbage collection requests; 0 never requests one */
+		int32 GCBatchSize = 256;
+	};
+
+	/** Outcome for one asset */
+	struct FResult
+	{
+		/** Position in the job's path list */
+		int32 Index = 0;
+		FString Path;
+
+		/** "registry" (no load), "memory" (already loaded), "loaded" (loaded for this job) or "none" on early errors */
+		const TCHAR* Source = TEXT("none");
+
+		/** Empty on success, else an UPPER_SNAKE code and message */
+		FString ErrorCode;
+		FString ErrorMessage;
+
+		/** Operation-specific fields */
+		TSharedPtr<FJsonObject> Data;
+	};
+
+	enum class EJobStatus : uint8
+	{
+		Running,
+		Completed,
+		Cancelled
+	};
+
+	struct FJob
+	{
+		FString JobId;
+		FOptions Options;
+		EJobStatus Status = EJobStatus::Running;
+		int32 Total = 0;
+
+		/** In completion order, not path order; FResult::Index maps back */
+		TArray<FResult> Results;
+
+		int32 FromRegistry = 0;
+		int32 Loaded = 0;
+		int32 Failed = 0;
+
+		FDateTime SubmitTime;
+		FDateTime EndTime;
+
+		/** job_id, operation, status, counts and timing; no results */
+		void WriteSummary(FRESTJsonWriter& Writer) const;
+
+		/** One result object */
+		static void WriteResult(FRESTJsonWriter& Writer, const FResult& Result);
+	};
+
+	/** Create the streamable manager and start the pump ticker. Called once at module startup. */
+	static void Initialize();
+
+	/** Cancel outstanding loads and drop all jobs */
+	static void Shutdown();
+
+	/**
+	 * Start a job over Paths. Registry answers are already in the returned job's results.
+	 * @return null (with OutError set) if too many jobs are running
+	 */
+	static TSharedPtr<const FJob> Start(const TArray<FSoftObjectPath>& Paths, const FOptions& Options, FString& OutError);
+
+	/** A running or recent job, or null if JobId is unknown or has been evicted */
+	static TSharedPtr<const FJob> FindJob(const FString& JobId);
+
+	/** Stop a running job; results so far are kept. False if JobId is not running. */
+	static bool Cancel(const FString& JobId);
+
+	/** Parse "mesh_details", "validate", "export" or "recompile_material" */
+	static bool ParseOperation(const FString& Name, EOperation& OutOperation);
+	static const TCHAR* GetOperationName(EOperation Operation);
+
+	/** Parse "auto", "never" or "always" */
+	static bool ParseLoadPolicy(const FString& Name, ELoadPolicy& OutPolicy);
+
+	/** Fields shared by the single-asset endpoints and bulk jobs */
+	static TSharedPtr<FJsonObject> MeshDetailsToJson(UStaticMesh* Mesh);
+	static TSharedPtr<FJsonObject> ValidateToJson(UObject* Asset);
+	static TSharedPtr<FJsonObject> ExportToJson(UObject* Asset);
+
+	/** Registry-tag mesh details, or null if the registry has no mesh tags for the asset */
+	static TSharedPtr<FJsonObject> MeshDetailsFromRegistry(const FAssetData& AssetData);
+
+	/** Largest path list one job accepts */
+	static constexpr int32 MaxPathsPerJob = 100000;
+};
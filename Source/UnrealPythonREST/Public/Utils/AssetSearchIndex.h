@@ -0,0 +1,85 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+/** How FAssetSearchIndex matches query text against asset names */
+enum class EAssetSearchMode : uint8
+{
+	/** Name contains the text (case-insensitive) */
+	Substring,
+	/** Name starts with the text (case-insensitive) */
+	Prefix,
+	/** Name shares enough trigrams with the text; results ranked by similarity */
+	Fuzzy
+};
+
+/** One asset search */
+struct FAssetSearchQuery
+{
+	FString Text;
+	EAssetSearchMode Mode = EAssetSearchMode::Substring;
+
+	/** Only assets whose class asset name is this (e.g. "Material"); None for any */
+	FName ClassName;
+
+	/** Only assets of these classes (from a compiled FARFilter); empty for any */
+	TSet<FTopLevelAssetPath> ClassPaths;
+
+	/** Only assets under this package path (e.g. "/Game/Props"); empty for any */
+	FString PathPrefix;
+
+	/** Matches to skip, then the most to return */
+	int32 Offset = 0;
+	int32 Limit = 100;
+};
+
+/** One page of search results */
+struct FAssetSearchResult
+{
+	TArray<FAssetData> Assets;
+
+	/** More matches follow this page */
+	bool bHasMore = false;
+};
+
+/**
+ * Asset search index - trigram index over asset names from the asset registry.
+ *
+ * Built on a worker thread once the registry finishes its initial scan, then
+ * kept current from OnAssetAdded / OnAssetRemoved / OnAssetRenamed. A query
+ * walks the shortest posting list among its trigrams and verifies each
+ * candidate against the lowercase name, so search cost follows the number of
+ * candidates rather than the size of the registry.
+ *
+ * Removed assets are tombstoned and compacted away once they make up a
+ * quarter of the entries, which keeps posting lists sorted by entry index.
+ *
+ * Safe to query from any thread.
+ */
+class UNREALPYTHONREST_API FAssetSearchIndex
+{
+public:
+	/** Subscribe to asset registry delegates and start the build when the registry is ready */
+	static void Initialize();
+
+	/** Unsubscribe, wait for a running build and drop the index */
+	static void Shutdown();
+
+	/** True once the initial build finished */
+	static bool IsReady();
+
+	/** Number of live assets in the index */
+	static int32 Num();
+
+	/**
+	 * Run a query.
+	 * @return false if the index is not built yet (OutResult untouched)
+	 */
+	static bool Search(const FAssetSearchQuery& Query, FAssetSearchResult& OutResult);
+
+	/** Rebuild the index in the background; the current one keeps answering until the new one is ready */
+	static void Rebuild();
+};
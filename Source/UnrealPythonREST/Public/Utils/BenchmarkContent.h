@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+/** What FBenchmarkContent::Generate creates; every count may be 0 to skip that part */
+struct FBenchmarkContentOptions
+{
+	/** Static mesh actors placed on a jittered grid in the target world */
+	int32 Actors = 1000;
+
+	/** Material instance asset tree: AssetFolders folders of AssetsPerFolder assets */
+	int32 AssetFolders = 10;
+	int32 AssetsPerFolder = 100;
+
+	/** Expression nodes in one generated material graph */
+	int32 MaterialNodes = 500;
+
+	/** Function call nodes in one generated Blueprint event graph */
+	int32 BlueprintNodes = 500;
+
+	/** Layout seed; the same options always give the same content */
+	int32 Seed = 1;
+
+	/** Content path everything is created under */
+	FString RootPath = TEXT("/Game/RESTBenchmark");
+
+	/** Save generated assets to disk (the commandlet always does) */
+	bool bSave = false;
+
+	/**
+	 * Parse "actors=10000 asset_folders=20 material_nodes=2000 seed=3 save=1".
+	 * Unknown keys are ignored; missing keys keep their defaults.
+	 */
+	static FBenchmarkContentOptions FromString(const FString& Args);
+};
+
+/** Counts and timings of one Generate call */
+struct FBenchmarkContentResult
+{
+	int32 ActorsSpawned = 0;
+	int32 AssetsCreated = 0;
+	FString MaterialPath;
+	FString BlueprintPath;
+	double Seconds = 0.0;
+};
+
+/**
+ * Synthetic content for load-testing the REST API.
+ *
+ * Actors are labelled RESTBench_000000.. in the RESTBenchmark outliner
+ * folder and are replaced on every run, so a level can be regenerated at a
+ * different size. Assets are created once and reused when they already
+ * exist. Used by the RESTBenchmark commandlet and the
+ * UnrealPythonREST.Benchmark.Generate console command. Game thread only.
+ */
+class UNREALPYTHONREST_API FBenchmarkContent
+{
+public:
+	/** Label prefix of generated actors */
+	static const TCHAR* const ActorPrefix;
+
+	/** @return false with OutError set if a part could not be generated */
+	static bool Generate(UWorld* World, const FBenchmarkContentOptions& Options, FBenchmarkContentResult& OutResult, FString& OutError);
+
+	/** Destroy the actors a previous Generate spawned. @return how many were removed */
+	static int32 ClearActors(UWorld* World);
+
+private:
+	static int32 SpawnActors(UWorld* World, const FBenchmarkContentOptions& Options);
+	static int32 CreateAssetTree(const FBenchmarkContentOptions& Options);
+	static bool CreateMaterialGraph(const FBenchmarkContentOptions& Options, FString& OutPath, FString& OutError);
+	static bool CreateBlueprintGraph(const FBenchmarkContentOptions& Options, FString& OutPath, FString& OutError);
+};
@@ -0,0 +1,103 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FRESTJsonWriter;
+class UBlueprint;
+
+/**
+ * Blueprint compile queue - deferred, batched Blueprint compilation.
+ *
+ * Graph edits only mark their Blueprint dirty here. Dirty Blueprints are
+ * compiled together once no edit has arrived for
+ * UnrealPythonREST.BlueprintCompileIdleSeconds, or when a client asks for a
+ * compile (POST /blueprints/compile). Each pass queues every Blueprint,
+ * parents first, and compiles them in one compilation-manager flush, so
+ * generating 500 nodes costs one compile per Blueprint instead of 500.
+ *
+ * Every pass is a job whose per-Blueprint status and per-node errors and
+ * warnings can be fetched later by ID. Game thread only.
+ */
+class UNREALPYTHONREST_API FBlueprintCompileQueue
+{
+public:
+	/** One compiler message attached to a node */
+	struct FMessage
+	{
+		/** "error", "warning" or "note" */
+		FString Severity;
+		FString Text;
+		FGuid NodeGuid;
+		FString NodeTitle;
+		FString Graph;
+	};
+
+	/** Outcome for one Blueprint */
+	struct FBlueprintResult
+	{
+		FString Path;
+
+		/** "up_to_date", "warnings", "error", or "missing" if it was unloaded before the pass */
+		FString Status;
+		int32 Errors = 0;
+		int32 Warnings = 0;
+		TArray<FMessage> Messages;
+	};
+
+	enum class EJobStatus : uint8
+	{
+		Pending,
+		Completed
+	};
+
+	struct FJob
+	{
+		FString JobId;
+		EJobStatus Status = EJobStatus::Pending;
+
+		/** True for passes started by the idle timer rather than a request */
+		bool bAutomatic = false;
+
+		/** Requested Blueprints (object paths); the pass also compiles whatever else was dirty */
+		TArray<FString> Requested;
+
+		/** Every Blueprint compiled in the pass, in compile order (empty while pending) */
+		TArray<FBlueprintResult> Results;
+
+		FDateTime SubmitTime;
+		FDateTime EndTime;
+		double CompileSeconds = 0.0;
+
+		/** job_id, status, automatic, requested, timing, error/warning totals and "blueprints" */
+		void WriteJson(FRESTJsonWriter& Writer) const;
+	};
+
+	/** Start the idle ticker. Called once at module startup. */
+	static void Initialize();
+
+	/** Stop ticking and drop dirty Blueprints and jobs without compiling */
+	static void Shutdown();
+
+	/** Remember Blueprint as needing a compile and restart the idle timer */
+	static void MarkDirty(UBlueprint* Blueprint);
+
+	/** Object paths of dirty Blueprints still waiting for a pass */
+	static TArray<FString> GetDirtyPaths();
+
+	/**
+	 * Queue a compile of Blueprints (and everything dirty) for the next tick.
+	 * @return The job ID
+	 */
+	static FString Enqueue(const TArray<UBlueprint*>& Blueprints);
+
+	/** Run the pending pass now instead of on the next tick */
+	static void Flush();
+
+	/** A pending or recent job, or null if JobId is unknown or has been evicted */
+	static TSharedPtr<const FJob> FindJob(const FString& JobId);
+
+	/** Pending jobs, then recent jobs newest first */
+	static TArray<TSharedRef<const FJob>> GetJobs();
+};
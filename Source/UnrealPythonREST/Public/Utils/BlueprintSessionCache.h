@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FBlueprintEditor;
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+
+/**
+ * Blueprint session cache - editor, graph and node lookup for the
+ * Blueprints handler.
+ *
+ * The active editor is remembered until an asset editor opens or closes.
+ * Per Blueprint, graphs are indexed by name until the Blueprint reports a
+ * change, and nodes are indexed by GUID and kept current through each
+ * graph's add/remove node notifications. A Blueprint change re-lists its
+ * graphs and only reindexes nodes of graphs that were added or removed.
+ * Hits are checked in O(1) against the live node (valid, same GUID, still
+ * in the graph it was indexed from), so a missed change costs a rebuild,
+ * never a wrong node.
+ * Undo/redo drops everything.
+ *
+ * Game thread only.
+ */
+class UNREALPYTHONREST_API FBlueprintSessionCache
+{
+public:
+	/** Subscribe to editor delegates. Called once at module startup. */
+	static void Initialize();
+
+	/** Unsubscribe and drop every session */
+	static void Shutdown();
+
+	/**
+	 * Blueprint editor for the Blueprint at BlueprintPath ("/Game/BP/BP_Door" or
+	 * its object path), or the first open Blueprint editor when BlueprintPath is empty.
+	 * @param OutErrorCode NO_EDITOR, NO_SUBSYSTEM or NO_BLUEPRINT_EDITOR when null is returned
+	 */
+	static FBlueprintEditor* FindEditor(const FString& BlueprintPath, UBlueprint*& OutBlueprint, FString& OutErrorCode);
+
+	/** Every graph of Blueprint, in UBlueprint::GetAllGraphs order */
+	static TArray<UEdGraph*> GetGraphs(UBlueprint* Blueprint);
+
+	/** Graph named GraphName; an empty name or "EventGraph" falls back to the first event graph page */
+	static UEdGraph* FindGraph(UBlueprint* Blueprint, const FString& GraphName);
+
+	/** Node with NodeGuid in any graph of Blueprint */
+	static UEdGraphNode* FindNode(UBlueprint* Blueprint, const FGuid& NodeGuid);
+
+	/** Drop everything cached for Blueprint */
+	static void Invalidate(UBlueprint* Blueprint);
+};
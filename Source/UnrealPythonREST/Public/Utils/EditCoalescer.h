@@ -0,0 +1,80 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class FScopedTransaction;
+
+/**
+ * Edit coalescer - defers expensive post-edit work while a batch of graph
+ * mutations runs.
+ *
+ * Handlers route PostEditChange, material recompiles, editor graph refreshes,
+ * Blueprint modified notifications and package saves through Run(). Outside a
+ * scope the action runs immediately, exactly as before. Inside a scope (POST
+ * /batch with "coalesce": true) each (object, key) pair is queued once and the
+ * queue is flushed when the outermost scope closes, so 200 node creations cost
+ * one recompile and one save per asset instead of 200.
+ *
+ * Game thread only; calls from other threads always run immediately.
+ */
+class UNREALPYTHONREST_API FEditCoalescer
+{
+public:
+	/** Order in which deferred work is flushed */
+	enum class EPhase : uint8
+	{
+		/** Data model updates and recompiles (PostEditChange, RecompileMaterial, MarkBlueprintAsModified) */
+		Update,
+
+		/** Editor UI refreshes (graph relink, UpdateMaterialAfterGraphChange, NotifyGraphChanged) */
+		Refresh,
+
+		/** Package saves */
+		Save
+	};
+
+	/**
+	 * Opens a coalescing scope and one editor transaction for everything inside it.
+	 * Nested scopes join the outermost one.
+	 */
+	class UNREALPYTHONREST_API FScope
+	{
+	public:
+		explicit FScope(const FText& Description);
+		~FScope();
+
+		FScope(const FScope&) = delete;
+		FScope& operator=(const FScope&) = delete;
+
+		/** Deferred actions run when this scope closed (0 for nested scopes or until then) */
+		int32 GetFlushedCount() const { return FlushedCount; }
+
+		/** Flush now instead of at destruction. Returns the number of actions run. */
+		int32 Close();
+
+	private:
+		TUniquePtr<FScopedTransaction> Transaction;
+		bool bOutermost = false;
+		bool bClosed = false;
+		int32 FlushedCount = 0;
+	};
+
+	/** True while a scope is open on the game thread */
+	static bool IsCoalescing();
+
+	/**
+	 * Run Action now, or - while coalescing - once per (Object, Key) when the
+	 * outermost scope closes. Later requests for the same pair are dropped.
+	 * Actions for objects that were destroyed in the meantime are skipped.
+	 */
+	static void Run(UObject* Object, FName Key, EPhase Phase, TFunction<void()> Action);
+
+	/** PreEditChange(nullptr): always immediate, but only once per object while coalescing */
+	static void PreEditChange(UObject* Object);
+
+	/** PostEditChange(), deferred while coalescing */
+	static void PostEditChange(UObject* Object);
+};
@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RESTRouter.h"
+
+/** Kinds of editor state whose changes are counted */
+enum class EEditorChange : uint8
+{
+	None = 0,
+
+	/** Actors added, deleted, moved or relabelled; map loads; undo/redo */
+	World = 1 << 0,
+
+	/** Editor selection */
+	Selection = 1 << 1,
+
+	/** Asset registry adds/removes/renames and package saves */
+	Assets = 1 << 2,
+
+	/** Any UObject Modify() or property change (material graphs, actor properties, ...); asset editors opened or closed */
+	Objects = 1 << 3,
+
+	All = World | Selection | Assets | Objects
+};
+ENUM_CLASS_FLAGS(EEditorChange);
+
+/**
+ * Editor change tracker - monotonically increasing "dirty generation"
+ * counters fed by engine and editor delegates.
+ *
+ * A generation only ever goes up, so a handler can use it as a cheap
+ * version token for its output: if the generation a client saw is still
+ * current, nothing it depends on has changed. Counters are atomic and may
+ * be read from any thread.
+ */
+class UNREALPYTHONREST_API FEditorChangeTracker
+{
+public:
+	/** Subscribe to engine/editor delegates. Called once at module startup. */
+	static void Initialize();
+
+	/** Unsubscribe from all delegates */
+	static void Shutdown();
+
+	/** Current generation for one or more kinds of change */
+	static uint64 GetGeneration(EEditorChange Changes);
+
+	/** Record a change that no engine delegate reports */
+	static void Bump(EEditorChange Changes);
+
+	/** Route version provider that returns GetGeneration(Changes) */
+	static FRESTRouteVersion MakeRouteVersion(EEditorChange Changes);
+
+	/**
+	 * Route handler that runs Handler and then records Changes, whatever the
+	 * outcome (a failed bulk edit may have applied part of its work). For
+	 * mutation routes: many edits (SetActorLocation, graph edits without a
+	 * transaction) fire no engine delegate, and versioned reads must not
+	 * keep answering 304 or from the response cache after them. Deferred
+	 * responses record the change when they complete.
+	 */
+	static FRESTRouteHandler BumpAfter(EEditorChange Changes, FRESTRouteHandler Handler);
+};
@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RESTRouter.h"
+
+/** Event topics a GET /events client can subscribe to */
+enum class EEditorEventTopic : uint8
+{
+	None = 0,
+
+	/** Level actors added, deleted, moved or relabelled (editor world only) */
+	Actors = 1 << 0,
+
+	/** Editor selection changed */
+	Selection = 1 << 1,
+
+	/** Async Python jobs started or finished */
+	Jobs = 1 << 2,
+
+	/** Live Coding compiles started or finished */
+	LiveCoding = 1 << 3,
+
+	/** Editor camera animations started or finished */
+	Camera = 1 << 4,
+
+	/** Assets added, removed, renamed or saved */
+	Assets = 1 << 5,
+
+	All = Actors | Selection | Jobs | LiveCoding | Camera | Assets
+};
+ENUM_CLASS_FLAGS(EEditorEventTopic);
+
+/**
+ * Editor event feed - a bounded, sequence-numbered log of small change
+ * events, served to clients by long polling (GET /events).
+ *
+ * Engine and editor delegates post actor, selection and asset events;
+ * handlers post their own (jobs, live coding, camera). Each event carries a
+ * key, and a new event with the same topic, type and key supersedes the
+ * older one, so an actor dragged across the viewport yields one "moved"
+ * event per poll rather than one per frame.
+ *
+ * Waiting clients are answered from a core ticker at most once per editor
+ * frame, which batches bursts. A client that falls behind the retained
+ * window gets "reset": true and should re-read full state.
+ *
+ * Post() may be called from any thread; Wait() and delivery run on the game thread.
+ */
+class UNREALPYTHONREST_API FEditorEventFeed
+{
+public:
+	/** Subscribe to engine/editor delegates and start the delivery ticker */
+	static void Initialize();
+
+	/** Unsubscribe and answer waiting clients with 503 SHUTTING_DOWN */
+	static void Shutdown();
+
+	/**
+	 * Record an event.
+	 * @param Type Short verb, e.g. "moved" or "finished"
+	 * @param Key What the event is about (actor path, job id ...); empty events are never coalesced
+	 * @param Data Small payload; must not be modified after posting
+	 */
+	static void Post(EEditorEventTopic Topic, const TCHAR* Type, const FString& Key, TSharedPtr<FJsonObject> Data = nullptr);
+
+	/** Sequence number of the newest event (0 before the first) */
+	static uint64 GetSequence();
+
+	/**
+	 * Parse a comma-separated topic list ("actors,jobs"); empty or "all" selects every topic.
+	 * @return false (with OutError set) for an unknown topic name
+	 */
+	static bool ParseTopics(const FString& List, EEditorEventTopic& OutTopics, FString& OutError);
+
+	/**
+	 * Answer Responder with Topics events newer than Since, as soon as there
+	 * is at least one or TimeoutSeconds have passed (then with none). Answers
+	 * 503 TOO_MANY_WAITERS at once if UnrealPythonREST.EventMaxWaiters polls are open.
+	 */
+	static void Wait(EEditorEventTopic Topics, uint64 Since, double TimeoutSeconds, int32 MaxEvents, FRESTResponder Responder);
+};
@@ -4,6 +4,8 @@
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
 
+class FRESTJsonWriter;
+
 /**
  * JSON utility functions for REST handlers.
  * Provides consistent serialization of UE types to JSON.
@@ -19,6 +21,18 @@ namespace JsonHelpers
     /** Convert FTransform to JSON object {location, rotation, scale} */
     TSharedPtr<FJsonObject> TransformToJson(const FTransform& Transform);
 
+    /**
+     * Stream FVector as "Identifier": {x, y, z} (same shape as VectorToJson).
+     * MessagePack writers pack it as a fixed [x, y, z] float32 array instead.
+     */
+    void WriteVector(FRESTJsonWriter& Writer, FStringView Identifier, const FVector& Vector);
+
+    /**
+     * Stream FRotator as "Identifier": {pitch, yaw, roll} (same shape as RotatorToJson).
+     * MessagePack writers pack it as a fixed [pitch, yaw, roll] float32 array instead.
+     */
+    void WriteRotator(FRESTJsonWriter& Writer, FStringView Identifier, const FRotator& Rotator);
+
     /** Parse FVector from JSON object */
     bool JsonToVector(const TSharedPtr<FJsonObject>& Json, FVector& OutVector);
 
@@ -52,4 +66,42 @@ namespace JsonHelpers
 
     /** Find similar strings using Levenshtein distance */
     TArray<FString> FindSimilarStrings(const FString& Input, const TArray<FString>& Candidates, int32 MaxResults = 3, int32 MaxDistance = 5);
+
+    /**
+     * BK-tree over strings for "did you mean" suggestions.
+     *
+     * Built incrementally with Add(); lookups use the triangle inequality on
+     * Levenshtein distance to skip whole subtrees, so a query against tens of
+     * thousands of labels only computes a small fraction of the distances.
+     * Comparison is case-insensitive, like FindSimilarStrings.
+     */
+    class FStringBKTree
+    {
+    public:
+        /** Add a string (no-op if it is already present, ignoring case) */
+        void Add(const FString& Value);
+
+        /** Same results as FindSimilarStrings over every added string */
+        TArray<FString> FindSimilar(const FString& Input, int32 MaxResults = 3, int32 MaxDistance = 5) const;
+
+        void Empty();
+
+        int32 Num() const { return Nodes.Num(); }
+
+    private:
+        struct FNode
+        {
+            /** Lowercased value, used for distances */
+            FString Key;
+
+            /** Value as added */
+            FString Value;
+
+            /** (distance to this node, child node index) */
+            TArray<TPair<int32, int32>, TInlineAllocator<4>> Children;
+        };
+
+        /** Index 0 is the root */
+        TArray<FNode> Nodes;
+    };
 }
@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonValue.h"
+
+class FRESTJsonWriter;
+class UMaterial;
+class UMaterialFunction;
+class UMaterialExpression;
+
+/**
+ * Comparable state of one material or material function graph.
+ *
+ * Nodes are keyed by expression name and carry their class, position and
+ * every editable property as exported text. Connections are keyed by their
+ * target input, since an input holds at most one link. The revision is a
+ * hash of all of it, so equal graphs have equal revisions across editor
+ * sessions.
+ */
+struct UNREALPYTHONREST_API FMaterialGraphSnapshot
+{
+	struct FNode
+	{
+		FString Class;
+		int32 X = 0;
+		int32 Y = 0;
+		TMap<FString, FString> Properties;
+	};
+
+	struct FConnection
+	{
+		FString Source;
+		int32 Output = 0;
+	};
+
+	/** Expression name -> node */
+	TMap<FString, FNode> Nodes;
+
+	/** "Target:Input" or "@Property" -> source */
+	TMap<FString, FConnection> Connections;
+
+	/** Hex content hash */
+	FString Revision;
+
+	/** Snapshot a material (Function null) or a material function (Material null) */
+	static TSharedRef<const FMaterialGraphSnapshot> Capture(UMaterial* Material, UMaterialFunction* Function);
+
+	/** Full graph: "nodes" and "connections" arrays */
+	void WriteJson(FRESTJsonWriter& Writer) const;
+
+	/** Changes from Base to this: "added", "removed", "changed", "connections_added", "connections_removed" */
+	void WriteDiffJson(FRESTJsonWriter& Writer, const FMaterialGraphSnapshot& Base) const;
+
+	/** Number of changes WriteDiffJson would report */
+	int32 CountChanges(const FMaterialGraphSnapshot& Base) const;
+};
+
+/**
+ * Material graph diff and patch support for /materials/editor/diff and
+ * /materials/editor/patch (and the /materials/function/editor equivalents).
+ *
+ * Recent snapshots of each graph are kept so a client that names a revision
+ * it saw earlier gets only what changed since. Game thread only.
+ */
+class UNREALPYTHONREST_API FMaterialGraphDiff
+{
+public:
+	/** Snapshot the graph now and remember it under its revision */
+	static TSharedRef<const FMaterialGraphSnapshot> Capture(const FString& AssetPath, UMaterial* Material, UMaterialFunction* Function);
+
+	/** A remembered snapshot, or null if Revision is unknown or has been evicted */
+	static TSharedPtr<const FMaterialGraphSnapshot> Find(const FString& AssetPath, const FString& Revision);
+
+	/** Result of Apply */
+	struct FPatchResult
+	{
+		/** Operations applied, in order; fewer than requested if one failed */
+		int32 Applied = 0;
+
+		/** Client id of each "add" -> name of the expression created for it */
+		TMap<FString, FString> CreatedNames;
+
+		/** Index of the failed operation, or INDEX_NONE */
+		int32 FailedIndex = INDEX_NONE;
+		FString Error;
+	};
+
+	/**
+	 * Apply patch operations in order to a material or function in place.
+	 *
+	 * Operations (node references may name an expression or the id of an
+	 * earlier "add" in the same patch):
+	 *   {"op":"add", "id":"n1", "class":"MaterialExpressionConstant", "x":0, "y":0, "properties":{"R":"0.5"}}
+	 *   {"op":"remove", "node":"MaterialExpressionConstant_3"}
+	 *   {"op":"move", "node":"...", "x":-400, "y":120}
+	 *   {"op":"set", "node":"...", "properties":{"ParameterName":"Roughness", "DefaultValue":"0.4"}}
+	 *   {"op":"connect", "source":"...", "output":0, "target":"...", "input":1}   (or "property":"BaseColor")
+	 *   {"op":"disconnect", "target":"...", "input":1}                           (or "property":"BaseColor")
+	 *
+	 * Property values use Unreal's text import format; JSON numbers and bools
+	 * are accepted. Stops at the first failing operation. Recompiling and
+	 * refreshing the editor are left to the caller.
+	 */
+	static FPatchResult Apply(UMaterial* Material, UMaterialFunction* Function, const TArray<TSharedPtr<FJsonValue>>& Operations);
+
+	/** Drop remembered snapshots (module shutdown) */
+	static void Reset();
+};
@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SceneTypes.h"
+
+class UMaterial;
+class UMaterialFunction;
+class UMaterialExpression;
+
+/**
+ * Material graph index - expression name lookup and a forward/reverse
+ * connection index per material or material function.
+ *
+ * The name map is built on first lookup and extended as expressions are
+ * appended; hits are checked against the live expression, and a stale hit
+ * or a miss rebuilds it, so a missed change costs a rebuild, never a wrong
+ * expression. The connection index is built on demand and dropped whenever
+ * the owner or one of its expressions is modified (OnObjectModified,
+ * OnObjectPropertyChanged), on undo/redo, and by Invalidate() from handlers
+ * that relink the graph without touching the expressions.
+ *
+ * Owners are a UMaterial or a UMaterialFunction. Game thread only.
+ */
+class UNREALPYTHONREST_API FMaterialGraphIndex
+{
+public:
+	/** One link into an expression input or a material property */
+	struct FLink
+	{
+		UMaterialExpression* Source = nullptr;
+		int32 OutputIndex = 0;
+
+		/** Null for a material property link */
+		UMaterialExpression* Target = nullptr;
+		int32 InputIndex = INDEX_NONE;
+
+		/** MP_MAX for an expression link */
+		EMaterialProperty Property = MP_MAX;
+
+		bool IsProperty() const { return Target == nullptr; }
+	};
+
+	/** Snapshot of every link in one graph. Pointers are valid until the next graph edit. */
+	class UNREALPYTHONREST_API FConnections
+	{
+	public:
+		/** Property links in EMaterialProperty order, then expression links in expression and input order */
+		const TArray<FLink>& GetLinks() const { return Links; }
+
+		/** Links fed by Source's outputs, in GetLinks() order */
+		void GetConsumers(const UMaterialExpression* Source, TArray<const FLink*>& OutLinks) const;
+
+		/** True if any input or property is fed by Source */
+		bool HasConsumers(const UMaterialExpression* Source) const { return BySource.Contains(Source); }
+
+		/** Links into Target's inputs, in input order */
+		void GetInputs(const UMaterialExpression* Target, TArray<const FLink*>& OutLinks) const;
+
+		/** Link into a material property, or null if it is not connected */
+		const FLink* FindPropertyLink(EMaterialProperty Property) const;
+
+	private:
+		friend class FMaterialGraphIndex;
+
+		TArray<FLink> Links;
+		TMultiMap<const UMaterialExpression*, int32> BySource;
+		TMultiMap<const UMaterialExpression*, int32> ByTarget;
+		TMap<EMaterialProperty, int32> ByProperty;
+	};
+
+	/** Subscribe to engine/editor delegates. Called once at module startup. */
+	static void Initialize();
+
+	/** Unsubscribe and drop every index */
+	static void Shutdown();
+
+	/** Expression of Owner named Name (case-insensitive, like GetName() comparison), or null */
+	static UMaterialExpression* FindExpression(UObject* Owner, const FString& Name);
+
+	/** Connection index of Owner, built on demand */
+	static TSharedRef<const FConnections> GetConnections(UObject* Owner);
+
+	/** Drop Owner's connection index after edits no delegate reports (graph relinks, direct input writes) */
+	static void Invalidate(UObject* Owner);
+};
@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FViewport;
+
+/**
+ * Viewport capture - in-memory frame grabs without stalling the game thread.
+ *
+ * Capture() copies the viewport's current render target into a GPU readback
+ * buffer on the render thread. A ticker polls the readback from the render
+ * thread until the GPU has finished, the pixels are copied out, and a worker
+ * thread resizes and encodes them. The callback then runs on the game thread
+ * with the encoded bytes. Nothing is written to disk and no frame waits for
+ * the GPU.
+ *
+ * Game thread only.
+ */
+class UNREALPYTHONREST_API FViewportCapture
+{
+public:
+	enum class EFormat : uint8
+	{
+		Jpeg,
+		Png
+	};
+
+	struct FSettings
+	{
+		EFormat Format = EFormat::Jpeg;
+
+		/** JPEG quality 1-100 */
+		int32 Quality = 85;
+
+		/** Output size; 0 keeps the viewport size, or keeps its aspect when the other side is set */
+		int32 Width = 0;
+		int32 Height = 0;
+	};
+
+	/** One encoded frame */
+	struct FFrame
+	{
+		TArray64<uint8> Bytes;
+		EFormat Format = EFormat::Jpeg;
+		int32 Width = 0;
+		int32 Height = 0;
+
+		/** Camera when the frame was requested */
+		FVector Location = FVector::ZeroVector;
+		FRotator Rotation = FRotator::ZeroRotator;
+
+		/** Request to pixels on the CPU, and resize + encode */
+		double ReadbackMs = 0.0;
+		double EncodeMs = 0.0;
+	};
+
+	/** Called on the game thread with the frame, or with null and an error code (Error is "CODE: message") */
+	using FOnCaptured = TUniqueFunction<void(TSharedPtr<const FFrame> Frame, const FString& Error)>;
+
+	/** Load the image encoders and start the readback ticker. Called once at module startup. */
+	static void Initialize();
+
+	/** Stop polling; pending captures are called back with a SHUTTING_DOWN error */
+	static void Shutdown();
+
+	/**
+	 * Start an asynchronous capture of Viewport's last rendered frame.
+	 * @return false (OnCaptured not called) if the viewport has no size or too many captures are in flight
+	 */
+	static bool Capture(FViewport* Viewport, const FSettings& Settings, const FVector& Location, const FRotator& Rotation,
+		FOnCaptured OnCaptured, FString& OutError);
+
+	/** Parse "jpeg"/"jpg"/"png" */
+	static bool ParseFormat(const FString& Name, EFormat& OutFormat);
+
+	/** "image/jpeg" or "image/png" */
+	static const TCHAR* GetMimeType(EFormat Format);
+
+	/** Captures waiting for the GPU or an encoder */
+	static int32 NumInFlight();
+};
@@ -25,7 +25,10 @@ public class UnrealPythonREST : ModuleRules
             "Slate",
             "SlateCore",
             "DeveloperSettings",
-            "AssetRegistry"
+            "AssetRegistry",
+            "RenderCore",
+            "ImageWrapper",
+            "Sockets"
         });
 
         // Editor-only dependencies for InfrastructureHandler and future handlers
@@ -0,0 +1,419 @@
+#!/usr/bin/env python3
+"""
+Load benchmark for the UnrealPythonREST plugin.
+
+Drives a running editor with a fixed set of scenarios at a configurable
+concurrency and writes one JSON report per run: client-side throughput and
+latency percentiles, plus the server's own per-route histograms, editor
+frame times and peak memory from GET /metrics. Reports from two plugin
+versions can be diffed with --compare.
+
+Content comes from the RESTBenchmark commandlet or from --generate, which
+runs UnrealPythonREST.Benchmark.Generate in the open level.
+
+Usage:
+    uv run benchmark_rest.py <project_dir>
+    uv run benchmark_rest.py <project_dir> --generate actors=10000 --output bench_10k.json
+    uv run benchmark_rest.py <project_dir> --scenario actors_list --scenario batch_1k --concurrency 8
+    uv run benchmark_rest.py <project_dir> --output new.json --compare bench_10k.json
+
+Example:
+    uv run benchmark_rest.py "G:/UE_Projects/MyProject" --requests 500 --concurrency 4
+"""
+
+from __future__ import annotations
+
+import argparse
+import http.client
+import io
+import json
+import math
+import platform
+import sys
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from datetime import datetime, timezone
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Optional, Tuple
+
+# Force UTF-8 output on Windows to handle Unicode symbols
+if sys.platform == "win32":
+    sys.stdout = io.TextIOWrapper(sys.stdout.buffer, encoding='utf-8', errors='replace')
+    sys.stderr = io.TextIOWrapper(sys.stderr.buffer, encoding='utf-8', errors='replace')
+
+CONFIG_FILENAME = "UnrealPythonREST.json"
+API_PREFIX = "/api/v1"
+REPORT_SCHEMA = 1
+
+DEFAULT_ROOT = "/Game/RESTBenchmark"
+SEARCH_WORDS = ["Rock", "Wood", "Metal", "Glass", "Fabric", "Bench"]
+
+# (report key, lower is better) pairs shown by --compare
+COMPARED_METRICS: List[Tuple[str, bool]] = [
+    ("rps", False),
+    ("latency_ms.p50", True),
+    ("latency_ms.p99", True),
+    ("server.frame_ms.p99", True),
+    ("server.frame_ms.max", True),
+    ("server.memory.peak_used_physical_bytes", True),
+]
+
+
+# ============================================================================
+# Statistics
+# ============================================================================
+
+def percentile(sorted_values: List[float], q: float) -> float:
+    """Nearest-rank percentile of an ascending list; 0 when empty."""
+    if not sorted_values:
+        return 0.0
+    rank = max(1, min(len(sorted_values), math.ceil(q * len(sorted_values))))
+    return sorted_values[rank - 1]
+
+
+def summarize_latencies(seconds: List[float]) -> Dict[str, float]:
+    """p50/p90/p99/max/mean in milliseconds, matching the /metrics JSON layout."""
+    values = sorted(s * 1000.0 for s in seconds)
+    return {
+        "count": len(values),
+        "mean": sum(values) / len(values) if values else 0.0,
+        "p50": percentile(values, 0.50),
+        "p90": percentile(values, 0.90),
+        "p99": percentile(values, 0.99),
+        "max": values[-1] if values else 0.0,
+    }
+
+
+def lookup(report: Dict[str, Any], dotted_key: str) -> Optional[float]:
+    """Read "a.b.c" from nested dicts; None if any part is missing."""
+    node: Any = report
+    for part in dotted_key.split("."):
+        if not isinstance(node, dict) or part not in node:
+            return None
+        node = node[part]
+    return node if isinstance(node, (int, float)) else None
+
+
+def compare_reports(baseline: Dict[str, Any], current: Dict[str, Any], threshold: float) -> Tuple[List[Dict[str, Any]], bool]:
+    """
+    Diff the scenario metrics of two reports.
+
+    Returns:
+        (rows, regressed): one row per scenario and metric present in both
+        reports; regressed is True when any metric got worse by more than
+        threshold (a fraction, 0.1 = 10%).
+    """
+    rows: List[Dict[str, Any]] = []
+    regressed = False
+    base_scenarios = baseline.get("scenarios", {})
+    for name, scenario in current.get("scenarios", {}).items():
+        base = base_scenarios.get(name)
+        if base is None:
+            continue
+        for key, lower_is_better in COMPARED_METRICS:
+            old = lookup(base, key)
+            new = lookup(scenario, key)
+            if old is None or new is None:
+                continue
+            change = (new - old) / old if old else 0.0
+            worse = change > threshold if lower_is_better else change < -threshold
+            regressed = regressed or worse
+            rows.append({"scenario": name, "metric": key, "baseline": old, "current": new,
+                         "change": change, "regression": worse})
+    return rows, regressed
+
+
+# ============================================================================
+# HTTP
+# ============================================================================
+
+class BenchClient:
+    """Keep-alive HTTP connections, one per worker thread."""
+
+    def __init__(self, host: str, port: int, timeout: float, client_id: str):
+        self.host = host
+        self.port = port
+        self.timeout = timeout
+        self.client_id = client_id
+        self._local = threading.local()
+
+    def _connection(self) -> http.client.HTTPConnection:
+        conn = getattr(self._local, "conn", None)
+        if conn is None:
+            conn = http.client.HTTPConnection(self.host, self.port, timeout=self.timeout)
+            self._local.conn = conn
+        return conn
+
+    def request(self, method: str, path: str, body: Optional[Dict[str, Any]] = None) -> Tuple[int, bytes]:
+        """Send one request; reconnects once if the server closed the connection."""
+        payload = json.dumps(body).encode("utf-8") if body is not None else None
+        headers = {"X-Client-Id": self.client_id, "Accept-Encoding": "identity"}
+        if payload is not None:
+            headers["Content-Type"] = "application/json"
+
+        for attempt in range(2):
+            conn = self._connection()
+            try:
+                conn.request(method, API_PREFIX + path, body=payload, headers=headers)
+                response = conn.getresponse()
+                return response.status, response.read()
+            except (http.client.HTTPException, ConnectionError, OSError):
+                conn.close()
+                self._local.conn = None
+                if attempt == 1:
+                    raise
+        raise RuntimeError("unreachable")
+
+    def json(self, method: str, path: str, body: Optional[Dict[str, Any]] = None) -> Dict[str, Any]:
+        """Request that must succeed with a JSON object body."""
+        status, data = self.request(method, path, body)
+        if status >= 400:
+            raise RuntimeError(f"{method} {path} returned {status}: {data[:200]!r}")
+        return json.loads(data.decode("utf-8")) if data else {}
+
+
+def discover_port(project_dir: Optional[str]) -> int:
+    """Port from <project>/Saved/UnrealPythonREST.json, as written by the plugin."""
+    if project_dir:
+        config_path = Path(project_dir) / "Saved" / CONFIG_FILENAME
+        try:
+            with open(config_path, "r", encoding="utf-8") as f:
+                return int(json.load(f).get("port", 8080))
+        except (OSError, ValueError, json.JSONDecodeError):
+            pass
+    return 8080
+
+
+# ============================================================================
+# Scenarios
+# ============================================================================
+
+# A scenario is one operation: a list of (method, path, body) requests that
+# run back to back and are timed together, built from the iteration index.
+Operation = List[Tuple[str, str, Optional[Dict[str, Any]]]]
+
+
+def build_scenarios(args: argparse.Namespace) -> Dict[str, Callable[[int], Operation]]:
+    root = args.root
+    material = f"{root}/Graphs/M_BenchGraph_{args.material_nodes}"
+
+    def batch(i: int) -> Operation:
+        requests_ = [
+            {"method": "POST", "path": "/assets/search",
+             "body": {"query": SEARCH_WORDS[(i + n) % len(SEARCH_WORDS)], "path": root, "limit": 10}}
+            for n in range(args.batch_size)
+        ]
+        return [("POST", "/batch", {"requests": requests_, "options": {"stop_on_error": False, "parallel": True}})]
+
+    def material_roundtrip(i: int) -> Operation:
+        # Import needs the exported xml, so the body is filled in by run_operation
+        return [
+            ("GET", f"/materials/editor/export?material_path={material}", None),
+            ("POST", "/materials/editor/import",
+             {"xml": None, "path": f"{root}/RoundTrip", "name": f"M_RoundTrip_{i:05d}", "save": False}),
+        ]
+
+    return {
+        "actors_list": lambda i: [("GET", "/actors/list?fields=label,class,location", None)],
+        "actors_list_page": lambda i: [("GET", "/actors/list?fields=label&limit=500", None)],
+        "actors_in_view": lambda i: [("GET", "/actors/in_view", None)],
+        "assets_search": lambda i: [("POST", "/assets/search",
+                                     {"query": SEARCH_WORDS[i % len(SEARCH_WORDS)], "path": root, "limit": 100})],
+        "assets_search_fuzzy": lambda i: [("POST", "/assets/search",
+                                           {"query": "MI_Bnch_Rok", "mode": "fuzzy", "path": root, "limit": 20})],
+        "batch_1k": batch,
+        "material_roundtrip": material_roundtrip,
+        "python_execute": lambda i: [("POST", "/python/execute",
+                                      {"code": f"import unreal\nresult = sum(range({1000 + i}))\nprint(result)"})],
+    }
+
+
+DEFAULT_SCENARIOS = ["actors_list", "actors_in_view", "assets_search", "batch_1k", "material_roundtrip", "python_execute"]
+
+
+def run_operation(client: BenchClient, operation: Operation) -> Tuple[float, bool]:
+    """Run one operation; returns (seconds, ok)."""
+    start = time.perf_counter()
+    previous: Optional[Dict[str, Any]] = None
+    for method, path, body in operation:
+        if body is not None and "xml" in body and body["xml"] is None:
+            body = dict(body, xml=(previous or {}).get("xml", ""))
+        status, data = client.request(method, path, body)
+        if status >= 400:
+            return time.perf_counter() - start, False
+        try:
+            previous = json.loads(data.decode("utf-8")) if data else {}
+        except (UnicodeDecodeError, json.JSONDecodeError):
+            previous = {}
+        if previous.get("success") is False:
+            return time.perf_counter() - start, False
+    return time.perf_counter() - start, True
+
+
+def run_scenario(client: BenchClient, name: str, build: Callable[[int], Operation], args: argparse.Namespace) -> Dict[str, Any]:
+    """Warm up, reset server metrics, run, and collect client and server numbers."""
+    requests_count = args.requests
+    if name in ("batch_1k", "material_roundtrip"):
+        requests_count = max(1, requests_count // 10)
+
+    for i in range(args.warmup):
+        run_operation(client, build(i))
+
+    client.request("DELETE", "/metrics")
+
+    latencies: List[float] = []
+    errors = 0
+    lock = threading.Lock()
+
+    def worker(i: int) -> None:
+        nonlocal errors
+        try:
+            seconds, ok = run_operation(client, build(args.warmup + i))
+        except (OSError, http.client.HTTPException):
+            seconds, ok = 0.0, False
+        with lock:
+            if ok:
+                latencies.append(seconds)
+            else:
+                errors += 1
+
+    start = time.perf_counter()
+    with ThreadPoolExecutor(max_workers=args.concurrency) as pool:
+        list(pool.map(worker, range(requests_count)))
+    elapsed = time.perf_counter() - start
+
+    server = client.json("GET", "/metrics?format=json")
+    return {
+        "operations": requests_count,
+        "errors": errors,
+        "concurrency": args.concurrency,
+        "duration_s": elapsed,
+        "rps": len(latencies) / elapsed if elapsed > 0 else 0.0,
+        "latency_ms": summarize_latencies(latencies),
+        "server": {
+            "frame_ms": server.get("frame_ms", {}),
+            "memory": server.get("memory", {}),
+            "routes": server.get("routes", []),
+        },
+    }
+
+
+# ============================================================================
+# CLI
+# ============================================================================
+
+def print_summary(report: Dict[str, Any]) -> None:
+    print(f"{'scenario':<22}{'rps':>10}{'p50 ms':>10}{'p99 ms':>10}{'max ms':>10}{'frame p99':>11}{'errors':>8}")
+    for name, scenario in report["scenarios"].items():
+        latency = scenario["latency_ms"]
+        frame = scenario["server"]["frame_ms"].get("p99", 0.0)
+        print(f"{name:<22}{scenario['rps']:>10.1f}{latency['p50']:>10.2f}{latency['p99']:>10.2f}"
+              f"{latency['max']:>10.2f}{frame:>11.2f}{scenario['errors']:>8}")
+
+
+def print_comparison(rows: List[Dict[str, Any]]) -> None:
+    print(f"\n{'scenario':<22}{'metric':<42}{'baseline':>14}{'current':>14}{'change':>9}")
+    for row in rows:
+        flag = "  REGRESSION" if row["regression"] else ""
+        print(f"{row['scenario']:<22}{row['metric']:<42}{row['baseline']:>14.2f}{row['current']:>14.2f}"
+              f"{row['change'] * 100:>8.1f}%{flag}")
+
+
+def main() -> int:
+    """Main entry point."""
+    parser = argparse.ArgumentParser(
+        description="Benchmark the UnrealPythonREST API",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog=__doc__,
+    )
+    parser.add_argument("project_dir", nargs="?", help="Unreal project directory (reads Saved/UnrealPythonREST.json)")
+    parser.add_argument("--host", default="localhost")
+    parser.add_argument("--port", type=int, help="Server port (default: from the project config, else 8080)")
+    parser.add_argument("--scenario", action="append", help="Scenario to run; repeatable (default: the standard set)")
+    parser.add_argument("--list", action="store_true", help="List scenarios and exit")
+    parser.add_argument("--concurrency", type=int, default=4, help="Concurrent clients (default: 4)")
+    parser.add_argument("--requests", type=int, default=200,
+                        help="Operations per scenario; batch and round-trip scenarios run a tenth (default: 200)")
+    parser.add_argument("--warmup", type=int, default=5, help="Untimed operations before each scenario (default: 5)")
+    parser.add_argument("--batch-size", type=int, default=1000, help="Sub-requests per /batch call (default: 1000)")
+    parser.add_argument("--root", default=DEFAULT_ROOT, help=f"Benchmark content root (default: {DEFAULT_ROOT})")
+    parser.add_argument("--material-nodes", type=int, default=500, help="Node count of the generated material to round-trip")
+    parser.add_argument("--generate", metavar="ARGS",
+                        help="Generate content in the open level first, e.g. \"actors=10000 material_nodes=2000\"")
+    parser.add_argument("--timeout", type=float, default=300.0, help="Per-request timeout in seconds")
+    parser.add_argument("--output", help="Write the JSON report here (default: stdout)")
+    parser.add_argument("--compare", metavar="BASELINE", help="Diff against an earlier report")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="Regression threshold for --compare, as a fraction (default: 0.10)")
+
+    args = parser.parse_args()
+    scenarios = build_scenarios(args)
+
+    if args.list:
+        for name in scenarios:
+            print(name)
+        return 0
+
+    selected = args.scenario or DEFAULT_SCENARIOS
+    unknown = [name for name in selected if name not in scenarios]
+    if unknown:
+        print(f"Unknown scenario(s): {', '.join(unknown)}", file=sys.stderr)
+        return 2
+
+    port = args.port or discover_port(args.project_dir)
+    client = BenchClient(args.host, port, args.timeout, client_id=f"benchmark-{platform.node()}")
+
+    try:
+        health = client.json("GET", "/health")
+    except (OSError, RuntimeError, http.client.HTTPException) as e:
+        print(f"REST server not reachable on {args.host}:{port}: {e}", file=sys.stderr)
+        return 1
+
+    if args.generate:
+        if "material_nodes=" in args.generate:
+            args.material_nodes = int(args.generate.split("material_nodes=")[1].split()[0])
+            scenarios = build_scenarios(args)
+        print(f"Generating content: {args.generate}", file=sys.stderr)
+        client.json("POST", "/editor/console", {"command": f"UnrealPythonREST.Benchmark.Generate {args.generate}"})
+
+    report: Dict[str, Any] = {
+        "schema": REPORT_SCHEMA,
+        "timestamp": datetime.now(timezone.utc).isoformat(),
+        "server": {"host": args.host, "port": port, "handlers": health.get("handlers", [])},
+        "client": {"python": platform.python_version(), "platform": platform.platform()},
+        "config": {
+            "concurrency": args.concurrency,
+            "requests": args.requests,
+            "warmup": args.warmup,
+            "batch_size": args.batch_size,
+            "root": args.root,
+            "generate": args.generate,
+        },
+        "scenarios": {},
+    }
+
+    for name in selected:
+        print(f"Running {name}...", file=sys.stderr)
+        report["scenarios"][name] = run_scenario(client, name, scenarios[name], args)
+
+    text = json.dumps(report, indent=2, sort_keys=True)
+    if args.output:
+        Path(args.output).write_text(text + "\n", encoding="utf-8")
+        print_summary(report)
+    else:
+        print(text)
+
+    if args.compare:
+        with open(args.compare, "r", encoding="utf-8") as f:
+            baseline = json.load(f)
+        rows, regressed = compare_reports(baseline, report, args.threshold)
+        print_comparison(rows)
+        if regressed:
+            return 3
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -632,6 +632,115 @@ def test_client(ctx: TestContext, results: TestResult) -> None:
 # Main Entry Point
 # =============================================================================
 
+# =============================================================================
+# Freshness Tests
+# =============================================================================
+
+def test_freshness(ctx: TestContext, results: TestResult) -> None:
+    """Test that versioned reads see edits made through REST and Python."""
+    print("\n[Freshness Tests]")
+
+    skip_reason = None
+    if not HAS_REQUESTS:
+        skip_reason = "requires requests library"
+    elif not ctx.base_url:
+        skip_reason = "no valid config file"
+
+    # Check if server is running
+    if not skip_reason:
+        try:
+            response = requests.get(f"{ctx.base_url}/health", timeout=2)
+            if response.status_code != 200:
+                skip_reason = "server not responding"
+        except requests.RequestException:
+            skip_reason = "server not responding"
+
+    # Scratch actor shared by the tests below, deleted at the end
+    actor = {"label": None}
+
+    def revalidate(path: str) -> Tuple[str, int]:
+        """GET path, then send its ETag back; returns the ETag and the revalidation status."""
+        first = requests.get(f"{ctx.base_url}{path}", timeout=10)
+        etag = first.headers.get("ETag", "")
+        again = requests.get(f"{ctx.base_url}{path}", headers={"If-None-Match": etag}, timeout=10)
+        return etag, again.status_code
+
+    def move_actor(z: float) -> None:
+        requests.post(
+            f"{ctx.base_url}/actors/transform",
+            json={"label": actor["label"], "location": {"x": 0, "y": 0, "z": z}},
+            timeout=10
+        )
+
+    # Test: Spawn the scratch actor
+    def test_spawn_scratch_actor() -> Tuple[bool, str]:
+        response = requests.post(
+            f"{ctx.base_url}/actors/spawn",
+            json={"class_path": "/Script/Engine.PointLight", "location": {"x": 0, "y": 0, "z": 100}},
+            timeout=10
+        )
+        data = response.json()
+        actor["label"] = data.get("actor_label")
+        return bool(data.get("success") and actor["label"]), f"Label: {actor['label']}"
+
+    run_test("test_spawn_scratch_actor", test_spawn_scratch_actor, results, ctx.verbose, skip_reason)
+    if not skip_reason and not actor["label"]:
+        skip_reason = "no scratch actor"
+
+    # Test: A transform invalidates the /actors/list ETag
+    def test_list_revalidates_after_transform() -> Tuple[bool, str]:
+        _, status = revalidate("/actors/list")
+        if status != 304:
+            return False, f"Unchanged list revalidated with {status}, expected 304"
+        first = requests.get(f"{ctx.base_url}/actors/list", timeout=10)
+        move_actor(300)
+        again = requests.get(f"{ctx.base_url}/actors/list",
+                             headers={"If-None-Match": first.headers.get("ETag", "")}, timeout=10)
+        return again.status_code == 200, f"Status after transform: {again.status_code}"
+
+    run_test("test_list_revalidates_after_transform", test_list_revalidates_after_transform, results, ctx.verbose, skip_reason)
+
+    # Test: A Python edit invalidates the /level/outliner ETag
+    def test_outliner_revalidates_after_python() -> Tuple[bool, str]:
+        first = requests.get(f"{ctx.base_url}/level/outliner", timeout=10)
+        code = (
+            "import unreal\n"
+            "for a in unreal.get_editor_subsystem(unreal.EditorActorSubsystem).get_all_level_actors():\n"
+            f"    if a.get_actor_label() == {actor['label']!r}:\n"
+            "        a.set_actor_location(unreal.Vector(0, 0, 500), False, False)\n"
+        )
+        requests.post(f"{ctx.base_url}/python/execute", json={"code": code}, timeout=10)
+        again = requests.get(f"{ctx.base_url}/level/outliner",
+                             headers={"If-None-Match": first.headers.get("ETag", "")}, timeout=10)
+        return again.status_code == 200, f"Status after Python edit: {again.status_code}"
+
+    run_test("test_outliner_revalidates_after_python", test_outliner_revalidates_after_python, results, ctx.verbose, skip_reason)
+
+    # Test: A transform is not hidden by the memoized /actors/details response
+    def test_details_not_replayed_after_transform() -> Tuple[bool, str]:
+        url = f"{ctx.base_url}/actors/details"
+        params = {"label": actor["label"]}
+        requests.get(url, params=params, timeout=10)
+        cached = requests.get(url, params=params, timeout=10)
+        if cached.headers.get("X-Cache") != "hit":
+            return False, f"Repeat read X-Cache: {cached.headers.get('X-Cache')}, expected hit"
+        move_actor(700)
+        after = requests.get(url, params=params, timeout=10)
+        z = after.json().get("actor", {}).get("location", {}).get("z")
+        return after.headers.get("X-Cache") == "miss" and z == 700, \
+            f"X-Cache after transform: {after.headers.get('X-Cache')}, z: {z}"
+
+    run_test("test_details_not_replayed_after_transform", test_details_not_replayed_after_transform, results, ctx.verbose, skip_reason)
+
+    # Test: Delete the scratch actor
+    def test_delete_scratch_actor() -> Tuple[bool, str]:
+        response = requests.post(f"{ctx.base_url}/actors/delete", json={"label": actor["label"]}, timeout=10)
+        data = response.json()
+        return bool(data.get("success")), f"Response: {data}"
+
+    run_test("test_delete_scratch_actor", test_delete_scratch_actor, results, ctx.verbose, skip_reason)
+
+
 def main() -> int:
     """Main entry point."""
     parser = argparse.ArgumentParser(
@@ -650,6 +759,7 @@ Categories:
     execution   - Python execution tests
     jobs        - Job management tests
     client      - UnrealExecutor client tests
+    freshness   - ETag revalidation after REST and Python edits
     all         - Run all test categories (default)
 """
     )
@@ -657,7 +767,7 @@ Categories:
     parser.add_argument("--verbose", "-v", action="store_true", help="Verbose output")
     parser.add_argument(
         "--category", "-c",
-        choices=["discovery", "api", "execution", "jobs", "client", "all"],
+        choices=["discovery", "api", "execution", "jobs", "client", "freshness", "all"],
         default="all",
         help="Test category to run (default: all)"
     )
@@ -707,6 +817,9 @@ Categories:
     if category in ("client", "all"):
         test_client(ctx, results)
 
+    if category in ("freshness", "all"):
+        test_freshness(ctx, results)
+
     # Print summary
     print()
     print("=" * 60)
@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""Tests for benchmark_rest.py"""
+
+import json
+from pathlib import Path
+import sys
+import pytest
+
+# Add parent directory to path for imports
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from benchmark_rest import (
+    compare_reports,
+    discover_port,
+    percentile,
+    summarize_latencies,
+)
+
+
+def make_report(rps, p50, p99):
+    return {"scenarios": {"actors_list": {"rps": rps, "latency_ms": {"p50": p50, "p99": p99}}}}
+
+
+class TestPercentile:
+    """Tests for percentile()"""
+
+    def test_nearest_rank(self):
+        """Should pick the nearest-rank value, not interpolate"""
+        values = [float(v) for v in range(1, 11)]
+        assert percentile(values, 0.5) == 5.0
+        assert percentile(values, 0.9) == 9.0
+        assert percentile(values, 0.99) == 10.0
+
+    def test_empty_is_zero(self):
+        """Should return 0 for no samples"""
+        assert percentile([], 0.5) == 0.0
+
+    def test_summary_in_milliseconds(self):
+        """Should convert seconds to milliseconds"""
+        summary = summarize_latencies([0.002, 0.001, 0.003])
+        assert summary["count"] == 3
+        assert summary["p50"] == pytest.approx(2.0)
+        assert summary["max"] == pytest.approx(3.0)
+        assert summary["mean"] == pytest.approx(2.0)
+
+
+class TestCompareReports:
+    """Tests for compare_reports()"""
+
+    def test_flags_throughput_drop(self):
+        """Should flag lower req/s beyond the threshold"""
+        rows, regressed = compare_reports(make_report(100, 1, 2), make_report(80, 1, 2), 0.1)
+        assert regressed
+        assert [row["metric"] for row in rows if row["regression"]] == ["rps"]
+
+    def test_flags_latency_increase(self):
+        """Should flag higher latency beyond the threshold"""
+        _, regressed = compare_reports(make_report(100, 1, 2), make_report(100, 1, 3), 0.1)
+        assert regressed
+
+    def test_ignores_changes_within_threshold(self):
+        """Should not flag small changes or improvements"""
+        _, regressed = compare_reports(make_report(100, 1, 2), make_report(150, 1.05, 1.5), 0.1)
+        assert not regressed
+
+    def test_skips_scenarios_missing_from_baseline(self):
+        """Should only compare scenarios present in both reports"""
+        rows, regressed = compare_reports({"scenarios": {}}, make_report(1, 1, 1), 0.1)
+        assert rows == []
+        assert not regressed
+
+
+class TestDiscoverPort:
+    """Tests for discover_port()"""
+
+    def test_reads_project_config(self, tmp_path):
+        """Should read the port the plugin wrote to Saved/"""
+        (tmp_path / "Saved").mkdir()
+        (tmp_path / "Saved" / "UnrealPythonREST.json").write_text(json.dumps({"port": 8091}))
+        assert discover_port(str(tmp_path)) == 8091
+
+    def test_defaults_without_config(self, tmp_path):
+        """Should fall back to 8080"""
+        assert discover_port(str(tmp_path)) == 8080
+        assert discover_port(None) == 8080
@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+"""Tests for ue_fleet.py"""
+
+import json
+from datetime import datetime, timedelta, timezone
+from pathlib import Path
+import sys
+import pytest
+
+# Add parent directory to path for imports
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from ue_fleet import (
+    FleetClient,
+    FleetError,
+    FleetInstance,
+    pick_sticky,
+    read_registry,
+)
+
+
+NOW = datetime(2026, 1, 1, 12, 0, 0, tzinfo=timezone.utc)
+
+
+def write_entry(directory, instance_id, port, age_seconds=0.0, **fields):
+    entry = {
+        "version": 1,
+        "instance_id": instance_id,
+        "port": port,
+        "pid": 1000 + port,
+        "project": "MyProject",
+        "ready": True,
+        "updated_at": (NOW - timedelta(seconds=age_seconds)).strftime("%Y-%m-%dT%H:%M:%S.000Z"),
+        "capabilities": {"handlers": ["assets", "materials"]},
+        "load": {"queued_requests": 0},
+    }
+    entry.update(fields)
+    (directory / f"{instance_id}.json").write_text(json.dumps(entry), encoding="utf-8")
+
+
+def make_instances(count):
+    return [FleetInstance(instance_id=f"id-{n}", port=8080 + n, ready=True) for n in range(count)]
+
+
+class FakeFleet(FleetClient):
+    """FleetClient whose HTTP goes to a table of per-port answers."""
+
+    def __init__(self, instances, answers):
+        super().__init__(instances=instances)
+        self.answers = answers
+        self.sent = []
+
+    def _send(self, instance, method, path, body):
+        self.sent.append((instance.port, method, path))
+        answer = self.answers.get(instance.port, (200, b'{"success": true}'))
+        if isinstance(answer, Exception):
+            raise answer
+        return answer
+
+
+class TestReadRegistry:
+    """Tests for read_registry()"""
+
+    def test_reads_live_entries_sorted(self, tmp_path):
+        """Should return every fresh entry, sorted by instance ID"""
+        write_entry(tmp_path, "b", 8081)
+        write_entry(tmp_path, "a", 8080)
+        instances = read_registry(tmp_path, now=NOW)
+        assert [i.instance_id for i in instances] == ["a", "b"]
+        assert instances[0].port == 8080
+        assert instances[0].has_handler("materials")
+
+    def test_skips_stale_and_partial(self, tmp_path):
+        """Should drop entries past the heartbeat window and unreadable files"""
+        write_entry(tmp_path, "fresh", 8080, age_seconds=5)
+        write_entry(tmp_path, "stale", 8081, age_seconds=60)
+        (tmp_path / "partial.json").write_text('{"instance_id": ', encoding="utf-8")
+        (tmp_path / "fresh.json.tmp").write_text("{}", encoding="utf-8")
+        instances = read_registry(tmp_path, now=NOW)
+        assert [i.instance_id for i in instances] == ["fresh"]
+
+    def test_filters_project_and_handler(self, tmp_path):
+        """Should keep only matching projects and capabilities"""
+        write_entry(tmp_path, "a", 8080)
+        write_entry(tmp_path, "b", 8081, project="Other")
+        write_entry(tmp_path, "c", 8082, capabilities={"handlers": ["assets"]})
+        assert [i.instance_id for i in read_registry(tmp_path, project="MyProject", now=NOW)] == ["a", "c"]
+        assert [i.instance_id for i in read_registry(tmp_path, require_handler="materials", now=NOW)] == ["a", "b"]
+
+    def test_missing_directory_is_empty(self, tmp_path):
+        """Should return no instances when nothing has registered yet"""
+        assert read_registry(tmp_path / "missing", now=NOW) == []
+
+
+class TestPickSticky:
+    """Tests for pick_sticky()"""
+
+    def test_same_session_same_instance(self):
+        """Should map a session to one instance regardless of list order"""
+        instances = make_instances(4)
+        first = pick_sticky(instances, "agent-1")
+        assert pick_sticky(list(reversed(instances)), "agent-1") is first
+
+    def test_only_lost_sessions_move(self):
+        """Should keep sessions on surviving instances when one leaves"""
+        instances = make_instances(4)
+        sessions = [f"session-{n}" for n in range(64)]
+        before = {s: pick_sticky(instances, s).instance_id for s in sessions}
+        survivors = [i for i in instances if i.instance_id != "id-2"]
+        for s in sessions:
+            if before[s] != "id-2":
+                assert pick_sticky(survivors, s).instance_id == before[s]
+
+    def test_empty_raises(self):
+        """Should fail when there is nothing to route to"""
+        with pytest.raises(FleetError):
+            pick_sticky([], "agent-1")
+
+
+class TestRouting:
+    """Tests for FleetClient request routing"""
+
+    def test_prefers_least_loaded(self):
+        """Should pick the ready instance with the lowest reported queue"""
+        instances = make_instances(3)
+        instances[0].load = {"queued_requests": 5}
+        instances[1].load = {"queued_requests": 1}
+        instances[2].ready = False
+        fleet = FakeFleet(instances, {})
+        assert fleet.choose().instance_id == "id-1"
+
+    def test_fails_over_on_connection_error_and_starting(self):
+        """Should move an independent request past dead and starting instances"""
+        instances = make_instances(3)
+        starting = b'{"success": false, "error": "STARTING", "message": "Editor is still loading"}'
+        fleet = FakeFleet(instances, {8080: ConnectionRefusedError(), 8081: (200, starting)})
+        status, data, instance = fleet.request("GET", "/health")
+        assert status == 200
+        assert json.loads(data)["success"] is True
+        assert instance.port == 8082
+        assert [port for port, _, _ in fleet.sent] == [8080, 8081, 8082]
+
+    def test_keeps_errors_the_handler_returned(self):
+        """Should not retry a request the editor ran and rejected"""
+        instances = make_instances(2)
+        not_found = b'{"success": false, "error": "NOT_FOUND", "message": "No such asset"}'
+        fleet = FakeFleet(instances, {8080: (200, not_found), 8081: (200, not_found)})
+        _, data, _ = fleet.request("GET", "/assets/info?path=/Game/Missing")
+        assert json.loads(data)["error"] == "NOT_FOUND"
+        assert len(fleet.sent) == 1
+
+    def test_json_raises_on_error_body(self):
+        """Should raise when the body reports failure despite HTTP 200"""
+        instances = make_instances(1)
+        not_found = b'{"success": false, "error": "NOT_FOUND", "message": "No such asset"}'
+        fleet = FakeFleet(instances, {8080: (200, not_found)})
+        with pytest.raises(RuntimeError, match="NOT_FOUND"):
+            fleet.json("GET", "/assets/info?path=/Game/Missing")
+
+    def test_every_instance_failing_raises(self):
+        """Should report a request no instance could serve"""
+        fleet = FakeFleet(make_instances(2), {8080: ConnectionRefusedError(), 8081: ConnectionRefusedError()})
+        with pytest.raises(FleetError):
+            fleet.request("GET", "/health")
+
+    def test_session_does_not_fail_over(self):
+        """Should never move a session to another editor"""
+        instances = make_instances(3)
+        target = pick_sticky(instances, "agent-1")
+        fleet = FakeFleet(instances, {target.port: ConnectionRefusedError()})
+        with pytest.raises(FleetError):
+            fleet.request("POST", "/materials/editor/open", {}, session="agent-1")
+        assert [port for port, _, _ in fleet.sent] == [target.port]
+
+    def test_map_keeps_item_order(self):
+        """Should return one result per item, in item order"""
+        fleet = FakeFleet(make_instances(2), {})
+        results = fleet.map("POST", "/assets/validate", ["/Game/A", "/Game/B", "/Game/C"],
+                            lambda p: (None, {"path": p}))
+        assert [r["item"] for r in results] == ["/Game/A", "/Game/B", "/Game/C"]
+        assert all(r["status"] == 200 and r["success"] for r in results)
+        assert len(fleet.sent) == 3
+
+    def test_map_reports_error_bodies(self):
+        """Should mark items whose body reports failure as unsuccessful"""
+        instances = make_instances(1)
+        invalid = b'{"success": false, "error": "VALIDATION_FAILED", "message": "Bad asset"}'
+        fleet = FakeFleet(instances, {8080: (200, invalid)})
+        results = fleet.map("POST", "/assets/validate", ["/Game/A"], lambda p: (None, {"path": p}))
+        assert results[0]["status"] == 200
+        assert results[0]["success"] is False
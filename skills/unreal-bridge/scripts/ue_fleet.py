@@ -0,0 +1,463 @@
+#!/usr/bin/env python3
+"""
+Fleet client for several UnrealPythonREST editor instances.
+
+Every editor running the plugin registers in a shared registry directory,
+one <instance_id>.json per process, refreshed by a heartbeat: port, pid,
+project, capabilities and load. FleetClient reads the registry and routes
+requests across the live instances:
+
+- Independent requests go to the least loaded instance, and move to another
+  instance if one is unreachable or answers that it did not run the request
+  (STARTING, SERVER_BUSY, SHUTTING_DOWN).
+- Requests with a session key always go to the same instance (rendezvous
+  hashing), so stateful editor work such as an open material or Blueprint
+  session stays in one process. Losing an instance only moves its sessions.
+- map() fans a list of independent items out across the fleet, e.g. asset
+  validation or mesh stats, and returns results in item order.
+
+The registry is UNREALPYTHONREST_REGISTRY if set, else
+<user settings dir>/UnrealPythonREST/Instances, matching the plugin.
+
+Usage:
+    uv run ue_fleet.py list
+    uv run ue_fleet.py list --project MyProject
+    uv run ue_fleet.py validate /Game/Materials/M_Base.M_Base /Game/Meshes/SM_Rock.SM_Rock
+    uv run ue_fleet.py mesh-stats /Game/Meshes/SM_Rock.SM_Rock --workers-per-instance 2
+
+Example:
+    fleet = FleetClient(project="MyProject")
+    results = fleet.map("POST", "/assets/validate", paths, lambda p: (None, {"path": p}))
+    fleet.json("POST", "/materials/editor/open", {"material_path": m}, session="agent-1")
+"""
+
+from __future__ import annotations
+
+import argparse
+import hashlib
+import http.client
+import io
+import json
+import os
+import platform
+import sys
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from dataclasses import dataclass, field
+from datetime import datetime, timezone
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Optional, Sequence, Tuple
+from urllib.parse import quote
+
+# Force UTF-8 output on Windows to handle Unicode symbols
+if sys.platform == "win32":
+    sys.stdout = io.TextIOWrapper(sys.stdout.buffer, encoding='utf-8', errors='replace')
+    sys.stderr = io.TextIOWrapper(sys.stderr.buffer, encoding='utf-8', errors='replace')
+
+API_PREFIX = "/api/v1"
+REGISTRY_ENV = "UNREALPYTHONREST_REGISTRY"
+
+# Entries not refreshed for this long belong to editors that hung or crashed
+# (the plugin's heartbeat is UnrealPythonREST.FleetHeartbeatSeconds, default 5)
+DEFAULT_STALE_SECONDS = 20.0
+
+# Unreachable or starting instances are skipped for this long before a retry
+DOWN_SECONDS = 5.0
+
+# Error codes an editor answers without running the request, so another may take it.
+# The HTTP status is always 200; the outcome is the body's "success" and "error".
+FAILOVER_ERRORS = {"STARTING", "SERVER_BUSY", "SHUTTING_DOWN"}
+
+
+class FleetError(RuntimeError):
+    """No instance could serve a request."""
+
+
+def parse_body(data: bytes) -> Dict[str, Any]:
+    """Decode a JSON object response body; {} if empty or not a JSON object."""
+    try:
+        body = json.loads(data.decode("utf-8")) if data else {}
+    except (UnicodeDecodeError, json.JSONDecodeError):
+        return {}
+    return body if isinstance(body, dict) else {}
+
+
+def body_error(data: bytes) -> Optional[str]:
+    """The error code of a {"success": false, "error": ...} body, else None."""
+    body = parse_body(data)
+    if body.get("success") is False:
+        return str(body.get("error") or "UNKNOWN_ERROR")
+    return None
+
+
+# ============================================================================
+# Registry
+# ============================================================================
+
+def default_registry_dir() -> Path:
+    """Same directory FConfigWriter::GetRegistryDir() uses."""
+    override = os.environ.get(REGISTRY_ENV)
+    if override:
+        return Path(override)
+
+    # FPlatformProcess::UserSettingsDir()
+    if sys.platform == "win32":
+        base = Path(os.environ.get("LOCALAPPDATA", Path.home() / "AppData" / "Local"))
+    elif sys.platform == "darwin":
+        base = Path.home() / "Library" / "Application Support"
+    else:
+        base = Path(os.environ.get("XDG_CONFIG_HOME", Path.home() / ".config"))
+    return base / "UnrealPythonREST" / "Instances"
+
+
+def parse_timestamp(value: str) -> Optional[datetime]:
+    """ISO 8601 as written by FDateTime::ToIso8601() (UTC, trailing Z)."""
+    try:
+        parsed = datetime.fromisoformat(value.replace("Z", "+00:00"))
+    except (AttributeError, ValueError):
+        return None
+    return parsed if parsed.tzinfo else parsed.replace(tzinfo=timezone.utc)
+
+
+@dataclass
+class FleetInstance:
+    """One registered editor."""
+
+    instance_id: str
+    port: int
+    host: str = "localhost"
+    pid: int = 0
+    project: str = ""
+    project_dir: str = ""
+    ready: bool = False
+    capabilities: Dict[str, Any] = field(default_factory=dict)
+    load: Dict[str, Any] = field(default_factory=dict)
+    updated_at: Optional[datetime] = None
+
+    @classmethod
+    def from_entry(cls, entry: Dict[str, Any]) -> "FleetInstance":
+        return cls(
+            instance_id=str(entry["instance_id"]),
+            port=int(entry["port"]),
+            pid=int(entry.get("pid", 0)),
+            project=entry.get("project", ""),
+            project_dir=entry.get("project_dir", ""),
+            ready=bool(entry.get("ready", False)),
+            capabilities=entry.get("capabilities") or {},
+            load=entry.get("load") or {},
+            updated_at=parse_timestamp(entry.get("updated_at", "")),
+        )
+
+    @property
+    def address(self) -> str:
+        return f"{self.host}:{self.port}"
+
+    def has_handler(self, name: str) -> bool:
+        return name in self.capabilities.get("handlers", [])
+
+
+def read_registry(registry_dir: Optional[Path] = None, project: Optional[str] = None,
+                  require_handler: Optional[str] = None, stale_seconds: float = DEFAULT_STALE_SECONDS,
+                  now: Optional[datetime] = None) -> List[FleetInstance]:
+    """Live instances in the registry, sorted by instance ID.
+
+    Skips partial or unreadable files, entries whose heartbeat is older than
+    stale_seconds, and instances of other projects or without require_handler.
+    """
+    directory = registry_dir or default_registry_dir()
+    now = now or datetime.now(timezone.utc)
+
+    instances: List[FleetInstance] = []
+    try:
+        paths = sorted(directory.glob("*.json"))
+    except OSError:
+        return instances
+
+    for path in paths:
+        try:
+            with open(path, "r", encoding="utf-8") as f:
+                instance = FleetInstance.from_entry(json.load(f))
+        except (OSError, ValueError, KeyError, TypeError, json.JSONDecodeError):
+            continue
+
+        if instance.updated_at is None or (now - instance.updated_at).total_seconds() > stale_seconds:
+            continue
+        if project and instance.project != project:
+            continue
+        if require_handler and not instance.has_handler(require_handler):
+            continue
+        instances.append(instance)
+
+    instances.sort(key=lambda i: i.instance_id)
+    return instances
+
+
+def pick_sticky(instances: Sequence[FleetInstance], session: str) -> FleetInstance:
+    """Rendezvous hashing: the same session maps to the same instance while it is
+    live, and only that instance's sessions move when one leaves."""
+    if not instances:
+        raise FleetError("No instances")
+
+    def weight(instance: FleetInstance) -> bytes:
+        return hashlib.sha1(f"{session}\0{instance.instance_id}".encode("utf-8")).digest()
+
+    return max(instances, key=weight)
+
+
+# ============================================================================
+# Routing
+# ============================================================================
+
+class FleetClient:
+    """Routes REST requests across the live instances in the registry."""
+
+    def __init__(self, instances: Optional[Sequence[FleetInstance]] = None, registry_dir: Optional[Path] = None,
+                 project: Optional[str] = None, require_handler: Optional[str] = None,
+                 timeout: float = 300.0, client_id: Optional[str] = None):
+        """
+        Args:
+            instances: Fixed instance list; read from the registry when omitted
+            registry_dir: Registry to read (default: default_registry_dir())
+            project: Only use editors of this project
+            require_handler: Only use editors exposing this handler (e.g. "materials")
+            timeout: Per-request timeout in seconds
+            client_id: X-Client-Id sent with every request, for the server's fair scheduling
+        """
+        self.registry_dir = registry_dir
+        self.project = project
+        self.require_handler = require_handler
+        self.timeout = timeout
+        self.client_id = client_id or f"fleet-{platform.node()}-{os.getpid()}"
+
+        self._lock = threading.Lock()
+        self._fixed = instances is not None
+        self._instances: List[FleetInstance] = list(instances or [])
+        self._in_flight: Dict[str, int] = {}
+        self._down_until: Dict[str, float] = {}
+        self._local = threading.local()
+
+        if not self._fixed:
+            self.refresh()
+
+    # -- Instances -----------------------------------------------------------
+
+    def refresh(self) -> List[FleetInstance]:
+        """Re-read the registry (no-op for a fixed instance list)."""
+        if not self._fixed:
+            instances = read_registry(self.registry_dir, self.project, self.require_handler)
+            with self._lock:
+                self._instances = instances
+        return self.instances
+
+    @property
+    def instances(self) -> List[FleetInstance]:
+        with self._lock:
+            return list(self._instances)
+
+    def _available(self) -> List[FleetInstance]:
+        now = time.monotonic()
+        with self._lock:
+            return [i for i in self._instances if self._down_until.get(i.instance_id, 0.0) <= now]
+
+    def _mark_down(self, instance: FleetInstance) -> None:
+        with self._lock:
+            self._down_until[instance.instance_id] = time.monotonic() + DOWN_SECONDS
+
+    def _score(self, instance: FleetInstance) -> Tuple[int, float, int, str]:
+        """Lower is better: our own in-flight requests, then the server's reported load."""
+        return (
+            0 if instance.ready else 1,
+            self._in_flight.get(instance.instance_id, 0) + float(instance.load.get("queued_requests", 0)),
+            self._in_flight.get(instance.instance_id, 0),
+            instance.instance_id,
+        )
+
+    def choose(self, session: Optional[str] = None, exclude: Sequence[str] = ()) -> FleetInstance:
+        """Instance for the next request: sticky for a session, else least loaded."""
+        if session is not None:
+            # Sessions ignore load and down marks: moving would lose the editor state
+            return pick_sticky(self.instances, session)
+
+        candidates = [i for i in self._available() if i.instance_id not in exclude]
+        if not candidates:
+            raise FleetError("No available instances" if not exclude else "Every instance failed")
+        with self._lock:
+            return min(candidates, key=self._score)
+
+    # -- HTTP ----------------------------------------------------------------
+
+    def _connection(self, instance: FleetInstance) -> http.client.HTTPConnection:
+        """Keep-alive connection per thread and instance."""
+        connections = getattr(self._local, "connections", None)
+        if connections is None:
+            connections = self._local.connections = {}
+        conn = connections.get(instance.instance_id)
+        if conn is None:
+            conn = http.client.HTTPConnection(instance.host, instance.port, timeout=self.timeout)
+            connections[instance.instance_id] = conn
+        return conn
+
+    def _send(self, instance: FleetInstance, method: str, path: str, body: Optional[Dict[str, Any]]) -> Tuple[int, bytes]:
+        """One request to one instance; reconnects once if the server closed the connection."""
+        payload = json.dumps(body).encode("utf-8") if body is not None else None
+        headers = {"X-Client-Id": self.client_id}
+        if payload is not None:
+            headers["Content-Type"] = "application/json"
+
+        for attempt in range(2):
+            conn = self._connection(instance)
+            try:
+                conn.request(method, API_PREFIX + path, body=payload, headers=headers)
+                response = conn.getresponse()
+                return response.status, response.read()
+            except (http.client.HTTPException, ConnectionError, OSError):
+                conn.close()
+                self._local.connections.pop(instance.instance_id, None)
+                if attempt == 1:
+                    raise
+        raise RuntimeError("unreachable")
+
+    def request(self, method: str, path: str, body: Optional[Dict[str, Any]] = None,
+                session: Optional[str] = None) -> Tuple[int, bytes, FleetInstance]:
+        """Send one request.
+
+        Without a session, a connection failure or an error in FAILOVER_ERRORS
+        moves the request to the next best instance. With a session the request only ever goes to that
+        session's instance, and a failure raises FleetError.
+
+        Returns:
+            (status, body, instance that answered)
+        """
+        tried: List[str] = []
+        while True:
+            try:
+                instance = self.choose(session, exclude=tried)
+            except FleetError:
+                if tried:
+                    raise FleetError(f"{method} {path} failed on every instance ({', '.join(tried)})")
+                raise
+
+            with self._lock:
+                self._in_flight[instance.instance_id] = self._in_flight.get(instance.instance_id, 0) + 1
+            try:
+                status, data = self._send(instance, method, path, body)
+            except (http.client.HTTPException, OSError) as e:
+                self._mark_down(instance)
+                if session is not None:
+                    raise FleetError(f"Session '{session}' instance {instance.address} is unreachable: {e}") from e
+                tried.append(instance.instance_id)
+                continue
+            finally:
+                with self._lock:
+                    self._in_flight[instance.instance_id] -= 1
+
+            if session is None and body_error(data) in FAILOVER_ERRORS:
+                # Still starting, queue full, or shutting down: let another instance take it
+                self._mark_down(instance)
+                tried.append(instance.instance_id)
+                continue
+            return status, data, instance
+
+    def json(self, method: str, path: str, body: Optional[Dict[str, Any]] = None,
+             session: Optional[str] = None) -> Dict[str, Any]:
+        """Request that must succeed with a JSON object body."""
+        status, data, instance = self.request(method, path, body, session)
+        if status >= 400:
+            raise RuntimeError(f"{method} {path} on {instance.address} returned {status}: {data[:200]!r}")
+        result = parse_body(data)
+        if result.get("success") is False:
+            raise RuntimeError(f"{method} {path} on {instance.address} failed: "
+                               f"{result.get('error')}: {result.get('message', '')}")
+        return result
+
+    def map(self, method: str, path: str, items: Sequence[Any],
+            build: Callable[[Any], Tuple[Optional[str], Optional[Dict[str, Any]]]],
+            workers_per_instance: int = 1) -> List[Dict[str, Any]]:
+        """Fan independent items out across the fleet.
+
+        Args:
+            method: HTTP method for every item
+            path: Route, e.g. "/assets/validate"
+            items: Work items
+            build: item -> (query string or None, JSON body or None)
+            workers_per_instance: Concurrent requests per editor; each editor's
+                game thread serves them one at a time, so 1-2 is usually enough
+
+        Returns:
+            One dict per item, in item order: {"item", "status", "success", "instance_id", "response"}
+            or {"item", "status": 0, "success": False, "error"} when no instance could serve it.
+            "success" is the response body's, since errors arrive with HTTP 200.
+        """
+        def run(item: Any) -> Dict[str, Any]:
+            query, body = build(item)
+            full_path = f"{path}?{query}" if query else path
+            try:
+                status, data, instance = self.request(method, full_path, body)
+            except FleetError as e:
+                return {"item": item, "status": 0, "success": False, "error": str(e)}
+            response = parse_body(data)
+            if not response and data:
+                response = {"raw": data[:200].decode("utf-8", errors="replace")}
+            success = 200 <= status < 300 and response.get("success") is not False
+            return {"item": item, "status": status, "success": success,
+                    "instance_id": instance.instance_id, "response": response}
+
+        workers = max(1, len(self._available()) * max(1, workers_per_instance))
+        with ThreadPoolExecutor(max_workers=workers) as pool:
+            return list(pool.map(run, items))
+
+
+# ============================================================================
+# CLI
+# ============================================================================
+
+def print_instances(instances: Sequence[FleetInstance]) -> None:
+    if not instances:
+        print("No live instances registered")
+        return
+    for i in instances:
+        state = "ready" if i.ready else "starting"
+        print(f"{i.instance_id}  {i.address:<16} pid {i.pid:<7} {state:<9} "
+              f"queued {i.load.get('queued_requests', 0):<4} {i.project}")
+
+
+def main() -> int:
+    """Main entry point."""
+    parser = argparse.ArgumentParser(
+        description="List and drive several UnrealPythonREST editors",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog=__doc__,
+    )
+    parser.add_argument("command", choices=["list", "validate", "mesh-stats"])
+    parser.add_argument("paths", nargs="*", help="Asset paths for validate / mesh-stats")
+    parser.add_argument("--registry", help=f"Registry directory (default: ${REGISTRY_ENV} or the user settings dir)")
+    parser.add_argument("--project", help="Only use editors of this project")
+    parser.add_argument("--workers-per-instance", type=int, default=1)
+    parser.add_argument("--timeout", type=float, default=300.0, help="Per-request timeout in seconds")
+    args = parser.parse_args()
+
+    fleet = FleetClient(registry_dir=Path(args.registry) if args.registry else None,
+                        project=args.project, timeout=args.timeout)
+
+    if args.command == "list":
+        print_instances(fleet.instances)
+        return 0
+
+    if not fleet.instances:
+        print("No live instances registered", file=sys.stderr)
+        return 1
+
+    if args.command == "validate":
+        results = fleet.map("POST", "/assets/validate", args.paths,
+                            lambda p: (None, {"path": p}), args.workers_per_instance)
+    else:
+        results = fleet.map("GET", "/assets/mesh_details", args.paths,
+                            lambda p: (f"path={quote(p, safe='/')}", None), args.workers_per_instance)
+
+    print(json.dumps(results, indent=2))
+    return 0 if all(r["success"] for r in results) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())